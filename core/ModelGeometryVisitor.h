@@ -0,0 +1,387 @@
+#pragma once
+// clang-format off
+#include "UnifiedModel.h"
+#include <memory>
+#include <unordered_set>
+// clang-format on
+
+namespace CADExchange {
+
+/**
+ * @brief 特征几何字段遍历器的默认实现（所有回调均为空操作）。
+ *
+ * VisitFeatureGeometry / VisitRefGeometry 会按字段语义回调 Visitor：
+ *   - Point(CPoint3D&)      世界坐标下的位置（平移 + 旋转 + 缩放）
+ *   - LocalPoint(CPoint3D&) 草图局部坐标下的位置（随 CSys 移动，仅受缩放影响）
+ *   - Direction(CVector3D&) 方向向量（只旋转）
+ *   - Length(double&)       线性长度（只受缩放影响；角度、比值不会回调）
+ *   - Ref(shared_ptr<R>&)   进入引用实体前调用，返回 false 则跳过
+ *   - Segment(shared_ptr<CSketchSeg>&) 进入草图段前调用，返回 false 则跳过
+ *
+ * Ref/Segment 允许 Visitor 替换槽位中的指针（例如深拷贝）。默认实现按
+ * 对象地址去重，保证被多个特征共享的引用只处理一次。
+ *
+ * 派生 Visitor 只需声明需要的回调即可（按名称隐藏基类版本）。
+ */
+class GeometryVisitorBase {
+public:
+  void Point(CPoint3D &) {}
+  void LocalPoint(CPoint3D &) {}
+  void Direction(CVector3D &) {}
+  void Length(double &) {}
+
+  template <typename R> bool Ref(std::shared_ptr<R> &slot) {
+    return slot && m_visited.insert(slot.get()).second;
+  }
+
+  bool Segment(std::shared_ptr<CSketchSeg> &slot) {
+    return slot && m_visited.insert(slot.get()).second;
+  }
+
+protected:
+  std::unordered_set<const void *> m_visited;
+};
+
+namespace GeometryVisit {
+
+template <typename Visitor>
+void RefBody(CRefEntityBase &ref, Visitor &visitor) {
+  if (auto *plane = dynamic_cast<CRefPlane *>(&ref)) {
+    visitor.Point(plane->origin);
+    visitor.Direction(plane->xDir);
+    visitor.Direction(plane->yDir);
+    visitor.Direction(plane->normal);
+    return;
+  }
+  if (auto *face = dynamic_cast<CRefFace *>(&ref)) {
+    visitor.Point(face->centroid);
+    visitor.Direction(face->normal);
+    visitor.Direction(face->uDir);
+    visitor.Direction(face->vDir);
+    return;
+  }
+  if (auto *edge = dynamic_cast<CRefEdge *>(&ref)) {
+    visitor.Point(edge->startPoint);
+    visitor.Point(edge->endPoint);
+    visitor.Point(edge->midPoint);
+    return;
+  }
+  if (auto *vertex = dynamic_cast<CRefVertex *>(&ref)) {
+    visitor.Point(vertex->pos);
+    return;
+  }
+  if (auto *axis = dynamic_cast<CRefAxis *>(&ref)) {
+    visitor.Point(axis->origin);
+    visitor.Direction(axis->direction);
+    return;
+  }
+  if (auto *point = dynamic_cast<CRefPoint *>(&ref)) {
+    visitor.Point(point->position);
+    return;
+  }
+}
+
+template <typename R, typename Visitor>
+void Ref(std::shared_ptr<R> &slot, Visitor &visitor) {
+  if (!slot || !visitor.Ref(slot)) {
+    return;
+  }
+  RefBody(*slot, visitor);
+}
+
+template <typename R, typename Visitor>
+void Refs(std::vector<std::shared_ptr<R>> &slots, Visitor &visitor) {
+  for (auto &slot : slots) {
+    Ref(slot, visitor);
+  }
+}
+
+template <typename Visitor>
+void OptionalPoint(std::optional<CPoint3D> &point, Visitor &visitor) {
+  if (point.has_value()) {
+    visitor.Point(*point);
+  }
+}
+
+template <typename Visitor>
+void OptionalLength(std::optional<double> &value, Visitor &visitor) {
+  if (value.has_value()) {
+    visitor.Length(*value);
+  }
+}
+
+template <typename Visitor>
+void OptionalDirection(std::optional<CVector3D> &dir, Visitor &visitor) {
+  if (dir.has_value()) {
+    visitor.Direction(*dir);
+  }
+}
+
+template <typename Visitor> void Sketch(CSketch &sketch, Visitor &visitor) {
+  Ref(sketch.referencePlane, visitor);
+  visitor.Point(sketch.sketchCSys.origin);
+  visitor.Direction(sketch.sketchCSys.xDir);
+  visitor.Direction(sketch.sketchCSys.yDir);
+  visitor.Direction(sketch.sketchCSys.zDir);
+
+  for (auto &seg : sketch.segments) {
+    if (!seg || !visitor.Segment(seg)) {
+      continue;
+    }
+    switch (seg->type) {
+    case CSketchSeg::SegType::LINE:
+      if (auto *line = dynamic_cast<CSketchLine *>(seg.get())) {
+        visitor.LocalPoint(line->startPos);
+        visitor.LocalPoint(line->endPos);
+      }
+      break;
+    case CSketchSeg::SegType::CIRCLE:
+      if (auto *circle = dynamic_cast<CSketchCircle *>(seg.get())) {
+        visitor.LocalPoint(circle->center);
+        visitor.Length(circle->radius);
+      }
+      break;
+    case CSketchSeg::SegType::ARC:
+      if (auto *arc = dynamic_cast<CSketchArc *>(seg.get())) {
+        visitor.LocalPoint(arc->center);
+        visitor.Length(arc->radius);
+      }
+      break;
+    case CSketchSeg::SegType::POINT:
+      if (auto *point = dynamic_cast<CSketchPoint *>(seg.get())) {
+        visitor.LocalPoint(point->position);
+      }
+      break;
+    default:
+      break;
+    }
+  }
+
+  for (auto &constraint : sketch.constraints) {
+    for (auto &ref : constraint.refs) {
+      if (ref.kind == SketchConstraintRefKind::ExternalReference) {
+        Ref(ref.refEntity, visitor);
+      }
+    }
+    if (!constraint.value.has_value()) {
+      continue;
+    }
+    switch (constraint.type) {
+    case CSketchConstraint::ConstraintType::DISTANCE:
+    case CSketchConstraint::ConstraintType::RADIUS:
+    case CSketchConstraint::ConstraintType::DIAMETER:
+      visitor.Length(*constraint.value);
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+template <typename Visitor>
+void Extent(SweepExtent &extent, Visitor &visitor, bool valueIsLength) {
+  if (valueIsLength) {
+    visitor.Length(extent.value);
+  }
+  visitor.Length(extent.offset);
+  Ref(extent.referenceEntity, visitor);
+  OptionalPoint(extent.helperPoint, visitor);
+}
+
+template <typename Visitor>
+void ThinWall(std::optional<ThinWallOption> &thinWall, Visitor &visitor) {
+  if (thinWall.has_value()) {
+    visitor.Length(thinWall->startOffset);
+    visitor.Length(thinWall->endOffset);
+  }
+}
+
+template <typename Visitor> void Path(CSweepPath &path, Visitor &visitor) {
+  Refs(path.references, visitor);
+  OptionalPoint(path.startPoint, visitor);
+  OptionalPoint(path.endPoint, visitor);
+}
+
+template <typename Visitor>
+void LinearDir(CLinearPatternDir &dir, Visitor &visitor) {
+  Ref(dir.directionRef, visitor);
+  visitor.Direction(dir.direction);
+  visitor.Length(dir.spacing);
+}
+
+} // namespace GeometryVisit
+
+/**
+ * @brief 遍历单个引用实体的几何字段（不经过 Ref 去重回调）。
+ */
+template <typename Visitor>
+void VisitRefGeometry(CRefEntityBase &ref, Visitor &visitor) {
+  GeometryVisit::RefBody(ref, visitor);
+}
+
+/**
+ * @brief 遍历单个特征的全部几何字段，字段语义见 GeometryVisitorBase。
+ */
+template <typename Visitor>
+void VisitFeatureGeometry(CFeatureBase &feature, Visitor &visitor) {
+  namespace V = GeometryVisit;
+  switch (feature.featureType) {
+  case FeatureType::Sketch:
+    V::Sketch(static_cast<CSketch &>(feature), visitor);
+    break;
+  case FeatureType::Extrude: {
+    auto &extrude = static_cast<CExtrude &>(feature);
+    visitor.Direction(extrude.direction);
+    V::Extent(extrude.extent1, visitor, true);
+    if (extrude.extent2.has_value()) {
+      V::Extent(*extrude.extent2, visitor, true);
+    }
+    V::ThinWall(extrude.thinWall, visitor);
+    break;
+  }
+  case FeatureType::Revolve: {
+    auto &revolve = static_cast<CRevolve &>(feature);
+    visitor.Point(revolve.axis.origin);
+    visitor.Direction(revolve.axis.direction);
+    V::Ref(revolve.axis.referenceEntity, visitor);
+    // Revolve extent.value 表示角度，不属于长度。
+    V::Extent(revolve.extent1, visitor, false);
+    if (revolve.extent2.has_value()) {
+      V::Extent(*revolve.extent2, visitor, false);
+    }
+    V::ThinWall(revolve.thinWall, visitor);
+    break;
+  }
+  case FeatureType::Sweep: {
+    auto &sweep = static_cast<CSweep &>(feature);
+    if (sweep.profile.embedded.has_value()) {
+      V::Sketch(sweep.profile.embedded->sketch, visitor);
+    }
+    if (sweep.profile.circular.has_value()) {
+      visitor.Length(sweep.profile.circular->outerRadius);
+      visitor.Length(sweep.profile.circular->innerRadius);
+    }
+    V::Path(sweep.path, visitor);
+    for (auto &guidePath : sweep.guidePaths) {
+      V::Path(guidePath, visitor);
+    }
+    V::ThinWall(sweep.thinWall, visitor);
+    break;
+  }
+  case FeatureType::Fillet: {
+    auto &fillet = static_cast<CFillet &>(feature);
+    V::OptionalLength(fillet.params.primaryValue, visitor);
+    V::OptionalLength(fillet.params.secondValue, visitor);
+    if (fillet.params.conicValueMode != FilletConicValueMode::RHO &&
+        fillet.params.conicValueMode != FilletConicValueMode::GENERIC_VALUE) {
+      V::OptionalLength(fillet.params.conicValue, visitor);
+    }
+    V::OptionalPoint(fillet.firstEndFaceMarker, visitor);
+    for (auto &point : fillet.params.radiusPoints) {
+      V::OptionalLength(point.primaryValue, visitor);
+      V::OptionalLength(point.secondValue, visitor);
+      V::OptionalPoint(point.edgeMidPoint, visitor);
+    }
+    V::Refs(fillet.references, visitor);
+    V::Refs(fillet.side1Faces, visitor);
+    V::Refs(fillet.side2Faces, visitor);
+    V::Refs(fillet.centerFaces, visitor);
+    break;
+  }
+  case FeatureType::Chamfer: {
+    auto &chamfer = static_cast<CChamfer &>(feature);
+    V::OptionalLength(chamfer.params.distance1, visitor);
+    V::OptionalLength(chamfer.params.distance2, visitor);
+    V::OptionalLength(chamfer.params.distance3, visitor);
+    V::OptionalLength(chamfer.params.offset1, visitor);
+    V::OptionalLength(chamfer.params.offset2, visitor);
+    V::OptionalPoint(chamfer.firstEndFaceMarker, visitor);
+    V::Refs(chamfer.references, visitor);
+    break;
+  }
+  case FeatureType::DatumPlane: {
+    auto &datumPlane = static_cast<CDatumPlane &>(feature);
+    V::Refs(datumPlane.referenceEntities, visitor);
+    for (auto &constraint : datumPlane.constraints) {
+      if (constraint.type == PlaneConstraintType::DISTANCE) {
+        visitor.Length(constraint.value);
+      }
+      V::OptionalDirection(constraint.defaultDir, visitor);
+    }
+    V::OptionalPoint(datumPlane.projectedOrigin, visitor);
+    V::OptionalDirection(datumPlane.normal, visitor);
+    break;
+  }
+  case FeatureType::Rib: {
+    auto &rib = static_cast<CRib &>(feature);
+    visitor.Length(rib.thicknessOption.thickness);
+    V::OptionalDirection(rib.thicknessOption.direction, visitor);
+    visitor.Direction(rib.materialOption.direction);
+    visitor.Point(rib.materialOption.referencePoint);
+    break;
+  }
+  case FeatureType::Shell: {
+    auto &shell = static_cast<CShell &>(feature);
+    visitor.Length(shell.thickness);
+    V::Refs(shell.facesToRemove, visitor);
+    for (auto &item : shell.thicknessFaces) {
+      visitor.Length(item.thickness);
+      V::Ref(item.face, visitor);
+    }
+    V::Ref(shell.targetBody, visitor);
+    V::Refs(shell.excludedFaces, visitor);
+    break;
+  }
+  case FeatureType::Draft: {
+    auto &draft = static_cast<CDraft &>(feature);
+    V::Ref(draft.pullDirectionRef, visitor);
+    V::Refs(draft.draftFaces, visitor);
+    V::Ref(draft.neutralPlaneRef, visitor);
+    V::Refs(draft.partingLines, visitor);
+    V::Ref(draft.partingSplitSketchRef, visitor);
+    V::Refs(draft.partingSplitTargetFaces, visitor);
+    break;
+  }
+  case FeatureType::LinearPattern: {
+    auto &pattern = static_cast<CLinearPattern &>(feature);
+    V::LinearDir(pattern.dir1, visitor);
+    if (pattern.dir2) {
+      V::LinearDir(*pattern.dir2, visitor);
+    }
+    V::Refs(pattern.seedObjects, visitor);
+    break;
+  }
+  case FeatureType::CircularPattern: {
+    auto &pattern = static_cast<CCircularPattern &>(feature);
+    V::Ref(pattern.dir1.axisRef, visitor);
+    visitor.Direction(pattern.dir1.direction);
+    if (pattern.dir2) {
+      V::LinearDir(*pattern.dir2, visitor);
+    }
+    V::Refs(pattern.seedObjects, visitor);
+    break;
+  }
+  case FeatureType::MirrorPattern: {
+    auto &pattern = static_cast<CMirrorPattern &>(feature);
+    V::Ref(pattern.mirrorPlaneRef, visitor);
+    V::Refs(pattern.seedObjects, visitor);
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+/**
+ * @brief 遍历模型中所有特征的几何字段。
+ */
+template <typename Visitor>
+void VisitModelGeometry(UnifiedModel &model, Visitor &visitor) {
+  model.ForEachMutable([&](std::shared_ptr<CFeatureBase> &feature) {
+    if (feature) {
+      VisitFeatureGeometry(*feature, visitor);
+    }
+  });
+}
+
+} // namespace CADExchange
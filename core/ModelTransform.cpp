@@ -0,0 +1,651 @@
+#include "ModelTransform.h"
+#include "ModelGeometryVisitor.h"
+#include "detail/IoHelpers.h"
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+
+namespace CADExchange {
+
+namespace {
+
+/// 相似变换校验的相对容差。
+constexpr double kSimilarityTolerance = 1e-9;
+
+/// SoA 批处理的分块大小：三个分量各占 2 KB，块内循环可被编译器自动向量化。
+constexpr std::size_t kBatchSize = 256;
+
+using detail::Fail;
+
+/**
+ * @brief 3x4 仿射系数（线性部分 + 平移），供 SoA 内核使用。
+ */
+struct AffineCoefficients {
+  double a[3][3];
+  double t[3];
+
+  static AffineCoefficients Full(const CMatrix4 &matrix) {
+    AffineCoefficients c{};
+    for (int r = 0; r < 3; ++r) {
+      for (int k = 0; k < 3; ++k) {
+        c.a[r][k] = matrix.m[r][k];
+      }
+      c.t[r] = matrix.m[r][3];
+    }
+    return c;
+  }
+
+  /// 纯旋转：线性部分除以缩放因子，不含平移。
+  static AffineCoefficients Rotation(const CMatrix4 &matrix, double scale) {
+    AffineCoefficients c = Full(matrix);
+    for (int r = 0; r < 3; ++r) {
+      for (int k = 0; k < 3; ++k) {
+        c.a[r][k] /= scale;
+      }
+      c.t[r] = 0.0;
+    }
+    return c;
+  }
+
+  /// 纯等比缩放。
+  static AffineCoefficients Scale(double scale) {
+    AffineCoefficients c{};
+    c.a[0][0] = c.a[1][1] = c.a[2][2] = scale;
+    return c;
+  }
+};
+
+/**
+ * @brief 对一组 xyz 字段指针做分块 SoA 仿射变换。
+ *
+ * 每块先 gather 到连续数组，在无别名的紧循环中计算，再 scatter 回原字段。
+ */
+template <typename T>
+void TransformBatch(const std::vector<T *> &items,
+                    const AffineCoefficients &c) {
+  alignas(64) double xs[kBatchSize];
+  alignas(64) double ys[kBatchSize];
+  alignas(64) double zs[kBatchSize];
+  alignas(64) double ox[kBatchSize];
+  alignas(64) double oy[kBatchSize];
+  alignas(64) double oz[kBatchSize];
+
+  for (std::size_t start = 0; start < items.size(); start += kBatchSize) {
+    const std::size_t count = std::min(kBatchSize, items.size() - start);
+    for (std::size_t i = 0; i < count; ++i) {
+      const T &item = *items[start + i];
+      xs[i] = item.x;
+      ys[i] = item.y;
+      zs[i] = item.z;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      ox[i] = c.a[0][0] * xs[i] + c.a[0][1] * ys[i] + c.a[0][2] * zs[i] + c.t[0];
+      oy[i] = c.a[1][0] * xs[i] + c.a[1][1] * ys[i] + c.a[1][2] * zs[i] + c.t[1];
+      oz[i] = c.a[2][0] * xs[i] + c.a[2][1] * ys[i] + c.a[2][2] * zs[i] + c.t[2];
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      T &item = *items[start + i];
+      item.x = ox[i];
+      item.y = oy[i];
+      item.z = oz[i];
+    }
+  }
+}
+
+/**
+ * @brief 收集几何字段地址，随后按类别批量变换。
+ */
+class TransformCollector : public GeometryVisitorBase {
+public:
+  void Point(CPoint3D &p) { m_points.push_back(&p); }
+  void LocalPoint(CPoint3D &p) { m_localPoints.push_back(&p); }
+  void Direction(CVector3D &v) { m_directions.push_back(&v); }
+  void Length(double &value) { m_lengths.push_back(&value); }
+
+  /**
+   * @brief 收集一个特征；基准面的垂足修正信息在变换前记录。
+   *
+   * visitor 为实际遍历使用的对象，派生类可借此替换 Ref/Segment 回调。
+   */
+  template <typename Visitor>
+  void CollectFeature(CFeatureBase &feature, Visitor &visitor) {
+    if (feature.featureType == FeatureType::DatumPlane) {
+      auto &plane = static_cast<CDatumPlane &>(feature);
+      if (plane.projectedOrigin.has_value()) {
+        DatumFixup fixup{&plane, std::nullopt};
+        if (!plane.normal.has_value()) {
+          // 垂足本身就是平面法向（平面过原点时无法推断，保持变换后的点）。
+          const CVector3D foot{plane.projectedOrigin->x,
+                               plane.projectedOrigin->y,
+                               plane.projectedOrigin->z};
+          if (std::sqrt(foot.Dot(foot)) > GeoUtils::EPSILON) {
+            fixup.fallbackNormal = foot;
+          }
+        }
+        m_datumFixups.push_back(fixup);
+      }
+    }
+    VisitFeatureGeometry(feature, visitor);
+  }
+
+  void Apply(const CMatrix4 &matrix, double scale) {
+    TransformBatch(m_points, AffineCoefficients::Full(matrix));
+    TransformBatch(m_directions, AffineCoefficients::Rotation(matrix, scale));
+    if (std::abs(scale - 1.0) > kSimilarityTolerance) {
+      TransformBatch(m_localPoints, AffineCoefficients::Scale(scale));
+      for (double *value : m_lengths) {
+        *value *= scale;
+      }
+    }
+
+    for (const auto &fixup : m_datumFixups) {
+      CDatumPlane &plane = *fixup.plane;
+      std::optional<CVector3D> normal = plane.normal;
+      if (!normal.has_value() && fixup.fallbackNormal.has_value()) {
+        normal = matrix.TransformVector(*fixup.fallbackNormal);
+      }
+      if (!normal.has_value()) {
+        continue;
+      }
+      if (auto foot = ProjectPointToPlaneOrigin(*plane.projectedOrigin, *normal)) {
+        plane.projectedOrigin = *foot;
+      }
+    }
+
+    m_points.clear();
+    m_localPoints.clear();
+    m_directions.clear();
+    m_lengths.clear();
+    m_datumFixups.clear();
+  }
+
+private:
+  struct DatumFixup {
+    CDatumPlane *plane = nullptr;
+    std::optional<CVector3D> fallbackNormal;
+  };
+
+  std::vector<CPoint3D *> m_points;
+  std::vector<CPoint3D *> m_localPoints;
+  std::vector<CVector3D *> m_directions;
+  std::vector<double *> m_lengths;
+  std::vector<DatumFixup> m_datumFixups;
+};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Clone helpers
+// ---------------------------------------------------------------------------
+
+std::shared_ptr<CRefEntityBase> CloneRefEntity(const CRefEntityBase &ref) {
+  if (auto *plane = dynamic_cast<const CRefPlane *>(&ref)) {
+    return std::make_shared<CRefPlane>(*plane);
+  }
+  if (auto *axis = dynamic_cast<const CRefAxis *>(&ref)) {
+    return std::make_shared<CRefAxis>(*axis);
+  }
+  if (auto *point = dynamic_cast<const CRefPoint *>(&ref)) {
+    return std::make_shared<CRefPoint>(*point);
+  }
+  if (auto *sketch = dynamic_cast<const CRefSketch *>(&ref)) {
+    return std::make_shared<CRefSketch>(*sketch);
+  }
+  if (auto *feature = dynamic_cast<const CRefFeature *>(&ref)) {
+    return std::make_shared<CRefFeature>(*feature);
+  }
+  if (auto *face = dynamic_cast<const CRefFace *>(&ref)) {
+    return std::make_shared<CRefFace>(*face);
+  }
+  if (auto *edge = dynamic_cast<const CRefEdge *>(&ref)) {
+    return std::make_shared<CRefEdge>(*edge);
+  }
+  if (auto *vertex = dynamic_cast<const CRefVertex *>(&ref)) {
+    return std::make_shared<CRefVertex>(*vertex);
+  }
+  if (auto *seg = dynamic_cast<const CRefSketchSeg *>(&ref)) {
+    return std::make_shared<CRefSketchSeg>(*seg);
+  }
+  if (auto *subTopo = dynamic_cast<const CRefSubTopo *>(&ref)) {
+    return std::make_shared<CRefSubTopo>(*subTopo);
+  }
+  return std::make_shared<CRefEntityBase>(ref);
+}
+
+std::shared_ptr<CSketchSeg> CloneSketchSegment(const CSketchSeg &seg) {
+  switch (seg.type) {
+  case CSketchSeg::SegType::LINE:
+    if (auto *line = dynamic_cast<const CSketchLine *>(&seg)) {
+      return std::make_shared<CSketchLine>(*line);
+    }
+    break;
+  case CSketchSeg::SegType::CIRCLE:
+    if (auto *circle = dynamic_cast<const CSketchCircle *>(&seg)) {
+      return std::make_shared<CSketchCircle>(*circle);
+    }
+    break;
+  case CSketchSeg::SegType::ARC:
+    if (auto *arc = dynamic_cast<const CSketchArc *>(&seg)) {
+      return std::make_shared<CSketchArc>(*arc);
+    }
+    break;
+  case CSketchSeg::SegType::POINT:
+    if (auto *point = dynamic_cast<const CSketchPoint *>(&seg)) {
+      return std::make_shared<CSketchPoint>(*point);
+    }
+    break;
+  default:
+    break;
+  }
+  return nullptr;
+}
+
+std::shared_ptr<CFeatureBase> CloneFeature(const CFeatureBase &feature) {
+  switch (feature.featureType) {
+  case FeatureType::Sketch:
+    return std::make_shared<CSketch>(static_cast<const CSketch &>(feature));
+  case FeatureType::Extrude:
+    return std::make_shared<CExtrude>(static_cast<const CExtrude &>(feature));
+  case FeatureType::Revolve:
+    return std::make_shared<CRevolve>(static_cast<const CRevolve &>(feature));
+  case FeatureType::Sweep:
+    return std::make_shared<CSweep>(static_cast<const CSweep &>(feature));
+  case FeatureType::Fillet:
+    return std::make_shared<CFillet>(static_cast<const CFillet &>(feature));
+  case FeatureType::Chamfer:
+    return std::make_shared<CChamfer>(static_cast<const CChamfer &>(feature));
+  case FeatureType::Rib:
+    return std::make_shared<CRib>(static_cast<const CRib &>(feature));
+  case FeatureType::Shell:
+    return std::make_shared<CShell>(static_cast<const CShell &>(feature));
+  case FeatureType::DatumPlane:
+    return std::make_shared<CDatumPlane>(
+        static_cast<const CDatumPlane &>(feature));
+  case FeatureType::Draft:
+    return std::make_shared<CDraft>(static_cast<const CDraft &>(feature));
+  case FeatureType::LinearPattern:
+    return std::make_shared<CLinearPattern>(
+        static_cast<const CLinearPattern &>(feature));
+  case FeatureType::CircularPattern:
+    return std::make_shared<CCircularPattern>(
+        static_cast<const CCircularPattern &>(feature));
+  case FeatureType::MirrorPattern:
+    return std::make_shared<CMirrorPattern>(
+        static_cast<const CMirrorPattern &>(feature));
+  default:
+    return std::make_shared<CFeatureBase>(feature);
+  }
+}
+
+namespace {
+
+/// 把引用/草图段槽位替换为拷贝；按原对象地址记录，保持拷贝之间的共享。
+class DeepCloneVisitor : public GeometryVisitorBase {
+public:
+  template <typename R> bool Ref(std::shared_ptr<R> &slot) {
+    if (!slot) {
+      return false;
+    }
+    auto &clone = m_refs[slot.get()];
+    if (!clone) {
+      clone = CloneRefEntity(*slot);
+    }
+    slot = std::static_pointer_cast<R>(clone);
+    return false;
+  }
+
+  bool Segment(std::shared_ptr<CSketchSeg> &slot) {
+    if (!slot) {
+      return false;
+    }
+    auto &clone = m_segments[slot.get()];
+    if (!clone) {
+      // 未识别的段类型保留原对象（没有可修改的几何字段）。
+      clone = CloneSketchSegment(*slot);
+      if (!clone) {
+        clone = slot;
+      }
+    }
+    slot = clone;
+    return false;
+  }
+
+private:
+  std::unordered_map<const void *, std::shared_ptr<CRefEntityBase>> m_refs;
+  std::unordered_map<const void *, std::shared_ptr<CSketchSeg>> m_segments;
+};
+
+} // namespace
+
+UnifiedModel CloneModelDeep(const UnifiedModel &model) {
+  UnifiedModel result(model.unit, model.modelName);
+  DeepCloneVisitor visitor;
+  std::vector<std::shared_ptr<CFeatureBase>> features;
+  features.reserve(model.GetFeatures().size());
+  for (const auto &feature : model.GetFeatures()) {
+    if (!feature) {
+      continue;
+    }
+    auto clone = CloneFeature(*feature);
+    VisitFeatureGeometry(*clone, visitor);
+    features.push_back(std::move(clone));
+  }
+  result.AddFeatures(features);
+  return result;
+}
+
+// ---------------------------------------------------------------------------
+// CMatrix4
+// ---------------------------------------------------------------------------
+
+CMatrix4 CMatrix4::Translation(const CVector3D &offset) {
+  CMatrix4 result;
+  result.m[0][3] = offset.x;
+  result.m[1][3] = offset.y;
+  result.m[2][3] = offset.z;
+  return result;
+}
+
+CMatrix4 CMatrix4::Rotation(const CVector3D &axis, double angle,
+                            const CPoint3D &pivot) {
+  CVector3D u = axis;
+  u.Normalize();
+  const double c = std::cos(angle);
+  const double s = std::sin(angle);
+  const double t = 1.0 - c;
+
+  CMatrix4 rotation;
+  rotation.m[0][0] = t * u.x * u.x + c;
+  rotation.m[0][1] = t * u.x * u.y - s * u.z;
+  rotation.m[0][2] = t * u.x * u.z + s * u.y;
+  rotation.m[1][0] = t * u.x * u.y + s * u.z;
+  rotation.m[1][1] = t * u.y * u.y + c;
+  rotation.m[1][2] = t * u.y * u.z - s * u.x;
+  rotation.m[2][0] = t * u.x * u.z - s * u.y;
+  rotation.m[2][1] = t * u.y * u.z + s * u.x;
+  rotation.m[2][2] = t * u.z * u.z + c;
+
+  return Translation({pivot.x, pivot.y, pivot.z}) * rotation *
+         Translation({-pivot.x, -pivot.y, -pivot.z});
+}
+
+CMatrix4 CMatrix4::UniformScale(double factor, const CPoint3D &center) {
+  CMatrix4 scale;
+  scale.m[0][0] = scale.m[1][1] = scale.m[2][2] = factor;
+  return Translation({center.x, center.y, center.z}) * scale *
+         Translation({-center.x, -center.y, -center.z});
+}
+
+CMatrix4 CMatrix4::operator*(const CMatrix4 &other) const {
+  CMatrix4 result;
+  for (int r = 0; r < 4; ++r) {
+    for (int c = 0; c < 4; ++c) {
+      double sum = 0.0;
+      for (int k = 0; k < 4; ++k) {
+        sum += m[r][k] * other.m[k][c];
+      }
+      result.m[r][c] = sum;
+    }
+  }
+  return result;
+}
+
+CPoint3D CMatrix4::TransformPoint(const CPoint3D &p) const {
+  return {m[0][0] * p.x + m[0][1] * p.y + m[0][2] * p.z + m[0][3],
+          m[1][0] * p.x + m[1][1] * p.y + m[1][2] * p.z + m[1][3],
+          m[2][0] * p.x + m[2][1] * p.y + m[2][2] * p.z + m[2][3]};
+}
+
+CVector3D CMatrix4::TransformVector(const CVector3D &v) const {
+  return {m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
+          m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
+          m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z};
+}
+
+namespace {
+
+void TransformBlock(const CMatrix4 &matrix, const CPointBlock &in,
+                    CPointBlock &out, std::size_t outOffset, bool translate) {
+  const std::size_t count = in.Size();
+  const auto &m = matrix.m;
+  const double a00 = m[0][0], a01 = m[0][1], a02 = m[0][2];
+  const double a10 = m[1][0], a11 = m[1][1], a12 = m[1][2];
+  const double a20 = m[2][0], a21 = m[2][1], a22 = m[2][2];
+  const double t0 = translate ? m[0][3] : 0.0;
+  const double t1 = translate ? m[1][3] : 0.0;
+  const double t2 = translate ? m[2][3] : 0.0;
+
+  // 原地变换时先取出输入再写回，逐元素无跨下标依赖。
+  const double *ix = in.x.data();
+  const double *iy = in.y.data();
+  const double *iz = in.z.data();
+  double *ox = out.x.data() + outOffset;
+  double *oy = out.y.data() + outOffset;
+  double *oz = out.z.data() + outOffset;
+  for (std::size_t i = 0; i < count; ++i) {
+    const double px = ix[i];
+    const double py = iy[i];
+    const double pz = iz[i];
+    ox[i] = a00 * px + a01 * py + a02 * pz + t0;
+    oy[i] = a10 * px + a11 * py + a12 * pz + t1;
+    oz[i] = a20 * px + a21 * py + a22 * pz + t2;
+  }
+}
+
+} // namespace
+
+void TransformPointBlock(const CMatrix4 &matrix, const CPointBlock &in,
+                         CPointBlock &out, std::size_t outOffset) {
+  TransformBlock(matrix, in, out, outOffset, true);
+}
+
+void TransformVectorBlock(const CMatrix4 &matrix, const CPointBlock &in,
+                          CPointBlock &out, std::size_t outOffset) {
+  TransformBlock(matrix, in, out, outOffset, false);
+}
+
+bool TryGetSimilarityScale(const CMatrix4 &matrix, double &scale,
+                           std::string *errorMessage) {
+  const auto &m = matrix.m;
+  for (int r = 0; r < 4; ++r) {
+    for (int c = 0; c < 4; ++c) {
+      if (!std::isfinite(m[r][c])) {
+        return Fail(errorMessage, "Transform matrix contains non-finite values.");
+      }
+    }
+  }
+  if (std::abs(m[3][0]) > kSimilarityTolerance ||
+      std::abs(m[3][1]) > kSimilarityTolerance ||
+      std::abs(m[3][2]) > kSimilarityTolerance ||
+      std::abs(m[3][3] - 1.0) > kSimilarityTolerance) {
+    return Fail(errorMessage,
+                "Transform matrix must be affine (last row 0, 0, 0, 1).");
+  }
+
+  const double det = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+                     m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+                     m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+  if (det <= GeoUtils::EPSILON) {
+    return Fail(errorMessage, "Transform matrix must preserve orientation "
+                              "(reflections and degenerate scales are not "
+                              "supported).");
+  }
+
+  const double s = std::cbrt(det);
+  const double s2 = s * s;
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      const double dot =
+          m[0][i] * m[0][j] + m[1][i] * m[1][j] + m[2][i] * m[2][j];
+      const double expected = (i == j) ? s2 : 0.0;
+      if (std::abs(dot - expected) > 1e-6 * s2) {
+        return Fail(errorMessage, "Transform matrix must be a rigid or "
+                                  "uniform-scale transform (shear or "
+                                  "non-uniform scale detected).");
+      }
+    }
+  }
+
+  scale = s;
+  if (errorMessage) {
+    errorMessage->clear();
+  }
+  return true;
+}
+
+bool TransformModel(UnifiedModel &model, const CMatrix4 &matrix,
+                    std::string *errorMessage) {
+  double scale = 1.0;
+  if (!TryGetSimilarityScale(matrix, scale, errorMessage)) {
+    return false;
+  }
+
+  TransformCollector collector;
+  model.ForEachMutable([&](std::shared_ptr<CFeatureBase> &feature) {
+    if (feature) {
+      collector.CollectFeature(*feature, collector);
+    }
+  });
+  collector.Apply(matrix, scale);
+
+  if (errorMessage) {
+    errorMessage->clear();
+  }
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// TransformedModelView
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief 视图内的拷贝表：原对象地址 -> 已变换的拷贝。
+ *
+ * 作为 Visitor 使用时，Ref/Segment 回调把槽位替换为拷贝；已拷贝过的
+ * 对象直接复用且不再变换。
+ */
+struct TransformedModelView::CloneState : public TransformCollector {
+  std::unordered_map<const CRefEntityBase *, std::shared_ptr<CRefEntityBase>>
+      refs;
+  std::unordered_map<const CSketchSeg *, std::shared_ptr<CSketchSeg>> segments;
+
+  template <typename R> bool Ref(std::shared_ptr<R> &slot) {
+    if (!slot) {
+      return false;
+    }
+    auto it = refs.find(slot.get());
+    if (it != refs.end()) {
+      slot = std::static_pointer_cast<R>(it->second);
+      return false;
+    }
+    auto clone = CloneRefEntity(*slot);
+    refs.emplace(slot.get(), clone);
+    // 拷贝自身也登记，防止同一特征内再次遇到拷贝时重复变换。
+    refs.emplace(clone.get(), clone);
+    slot = std::static_pointer_cast<R>(clone);
+    return true;
+  }
+
+  bool Segment(std::shared_ptr<CSketchSeg> &slot) {
+    if (!slot) {
+      return false;
+    }
+    auto it = segments.find(slot.get());
+    if (it != segments.end()) {
+      slot = it->second;
+      return false;
+    }
+    auto clone = CloneSketchSegment(*slot);
+    if (!clone) {
+      // 未识别的段类型没有可变换字段，保留共享的只读原对象。
+      return false;
+    }
+    segments.emplace(slot.get(), clone);
+    segments.emplace(clone.get(), clone);
+    slot = clone;
+    return true;
+  }
+};
+
+TransformedModelView::TransformedModelView(
+    std::shared_ptr<const UnifiedModel> source, const CMatrix4 &matrix)
+    : m_source(std::move(source)), m_matrix(matrix),
+      m_clones(std::make_unique<CloneState>()) {
+  if (!m_source) {
+    throw std::invalid_argument("TransformedModelView requires a source model.");
+  }
+  std::string error;
+  if (!TryGetSimilarityScale(m_matrix, m_scale, &error)) {
+    throw std::invalid_argument(error);
+  }
+  const auto &features = m_source->GetFeatures();
+  m_cache.resize(features.size());
+  m_indexByID.reserve(features.size());
+  for (std::size_t i = 0; i < features.size(); ++i) {
+    if (features[i]) {
+      m_indexByID.emplace(features[i]->featureID, i);
+    }
+  }
+}
+
+TransformedModelView::~TransformedModelView() = default;
+
+std::shared_ptr<const CFeatureBase>
+TransformedModelView::GetFeature(const std::string &featureID) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_indexByID.find(featureID);
+  if (it == m_indexByID.end()) {
+    return nullptr;
+  }
+  return MaterializeLocked(it->second);
+}
+
+std::shared_ptr<const CFeatureBase>
+TransformedModelView::GetFeatureAt(std::size_t index) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (index >= m_cache.size()) {
+    return nullptr;
+  }
+  return MaterializeLocked(index);
+}
+
+std::size_t TransformedModelView::MaterializedCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return static_cast<std::size_t>(
+      std::count_if(m_cache.begin(), m_cache.end(),
+                    [](const auto &feature) { return feature != nullptr; }));
+}
+
+UnifiedModel TransformedModelView::Materialize() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  UnifiedModel result(m_source->unit, m_source->modelName);
+  std::vector<std::shared_ptr<CFeatureBase>> features;
+  features.reserve(m_cache.size());
+  for (std::size_t i = 0; i < m_cache.size(); ++i) {
+    if (auto feature = MaterializeLocked(i)) {
+      features.push_back(std::move(feature));
+    }
+  }
+  result.AddFeatures(features);
+  return result;
+}
+
+std::shared_ptr<CFeatureBase>
+TransformedModelView::MaterializeLocked(std::size_t index) {
+  if (m_cache[index]) {
+    return m_cache[index];
+  }
+  const auto &original = m_source->GetFeatures()[index];
+  if (!original) {
+    return nullptr;
+  }
+
+  auto clone = CloneFeature(*original);
+  m_clones->CollectFeature(*clone, *m_clones);
+  m_clones->Apply(m_matrix, m_scale);
+  m_cache[index] = clone;
+  return clone;
+}
+
+} // namespace CADExchange
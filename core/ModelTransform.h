@@ -0,0 +1,207 @@
+#pragma once
+// clang-format off
+#include "UnifiedModel.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+// clang-format on
+
+namespace CADExchange {
+
+/**
+ * @brief 4x4 齐次变换矩阵（行主序，作用于列向量）。
+ *
+ * TransformModel 只接受刚体变换或等比相似变换：左上 3x3 块必须是
+ * s·R（R 为正交旋转，s > 0），末行必须为 (0, 0, 0, 1)。
+ */
+struct CMatrix4 {
+  double m[4][4] = {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}};
+
+  static CMatrix4 Identity() { return {}; }
+
+  static CMatrix4 Translation(const CVector3D &offset);
+
+  /**
+   * @brief 绕经过 pivot、方向为 axis 的轴旋转 angle（弧度，右手定则）。
+   */
+  static CMatrix4 Rotation(const CVector3D &axis, double angle,
+                           const CPoint3D &pivot = {});
+
+  static CMatrix4 UniformScale(double factor, const CPoint3D &center = {});
+
+  /**
+   * @brief 矩阵乘法：(A * B) 表示先应用 B 再应用 A。
+   */
+  CMatrix4 operator*(const CMatrix4 &other) const;
+
+  CPoint3D TransformPoint(const CPoint3D &p) const;
+
+  /**
+   * @brief 只应用线性部分（不含平移）。
+   */
+  CVector3D TransformVector(const CVector3D &v) const;
+};
+
+/**
+ * @brief SoA 布局的点/向量集合，供批量变换内核使用。
+ */
+struct CPointBlock {
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> z;
+
+  std::size_t Size() const { return x.size(); }
+
+  void Reserve(std::size_t count) {
+    x.reserve(count);
+    y.reserve(count);
+    z.reserve(count);
+  }
+
+  void Resize(std::size_t count) {
+    x.resize(count);
+    y.resize(count);
+    z.resize(count);
+  }
+
+  void Push(double px, double py, double pz) {
+    x.push_back(px);
+    y.push_back(py);
+    z.push_back(pz);
+  }
+
+  void Push(const CPoint3D &p) { Push(p.x, p.y, p.z); }
+  void Push(const CVector3D &v) { Push(v.x, v.y, v.z); }
+
+  CPoint3D PointAt(std::size_t i) const { return {x[i], y[i], z[i]}; }
+  CVector3D VectorAt(std::size_t i) const { return {x[i], y[i], z[i]}; }
+};
+
+/**
+ * @brief 对 SoA 点集做仿射变换，结果写入 out[outOffset, outOffset + in.Size())。
+ *
+ * out 的大小必须足够；in 与 out 可以是同一对象（outOffset 为 0 时）。
+ */
+void TransformPointBlock(const CMatrix4 &matrix, const CPointBlock &in,
+                         CPointBlock &out, std::size_t outOffset = 0);
+
+/**
+ * @brief 同 TransformPointBlock，但只应用线性部分（方向/法向）。
+ */
+void TransformVectorBlock(const CMatrix4 &matrix, const CPointBlock &in,
+                          CPointBlock &out, std::size_t outOffset = 0);
+
+/**
+ * @brief 将矩阵分解为等比缩放因子与旋转。
+ *
+ * @param matrix 待检查矩阵。
+ * @param scale 输出缩放因子 s（刚体变换为 1）。
+ * @param errorMessage 可选的错误输出（含剪切、镜像、非等比缩放等原因）。
+ * @return 矩阵为刚体或等比相似变换时返回 true。
+ */
+bool TryGetSimilarityScale(const CMatrix4 &matrix, double &scale,
+                           std::string *errorMessage = nullptr);
+
+/**
+ * @brief 按动态类型浅层复制一个引用实体（字段逐一拷贝，新对象不与原对象共享）。
+ */
+std::shared_ptr<CRefEntityBase> CloneRefEntity(const CRefEntityBase &ref);
+
+/**
+ * @brief 按段类型复制草图段；未识别的段类型返回空指针。
+ */
+std::shared_ptr<CSketchSeg> CloneSketchSegment(const CSketchSeg &seg);
+
+/**
+ * @brief 按 featureType 复制特征。引用实体与草图段仍与原特征共享，
+ *        需要独立修改时由调用方逐个替换。
+ */
+std::shared_ptr<CFeatureBase> CloneFeature(const CFeatureBase &feature);
+
+/**
+ * @brief 深拷贝整个模型：特征、引用实体与草图段均为新对象。
+ *
+ * 源模型中被多个特征共享的引用实体/草图段在拷贝中仍然共享同一个新对象。
+ * 单位与名称随之复制。
+ */
+UnifiedModel CloneModelDeep(const UnifiedModel &model);
+
+/**
+ * @brief 对模型中所有几何字段原地应用刚体/相似变换。
+ *
+ * 世界坐标点做完整仿射变换；方向只旋转（保持长度）；草图局部坐标、
+ * 半径、距离等长度量只乘以缩放因子，角度与比值保持不变。
+ * 被多个特征共享的引用实体只变换一次。基准面 projectedOrigin 会按
+ * 变换后的平面重新投影，保持“原点在平面上的垂足”语义。
+ *
+ * 变换按字段类别批量收集后以 SoA 方式分块计算。
+ *
+ * @return 矩阵不合法时返回 false 且模型保持不变。
+ */
+bool TransformModel(UnifiedModel &model, const CMatrix4 &matrix,
+                    std::string *errorMessage = nullptr);
+
+/**
+ * @brief 模型的惰性变换视图。
+ *
+ * 不修改源模型：首次访问某个特征时才深拷贝并变换该特征，结果缓存。
+ * 多个特征共享的引用实体在视图内只拷贝、变换一次，拷贝之间保持共享。
+ *
+ * 适用于只需要少量特征变换结果的场景（如对齐预览、局部比对）。
+ * 源模型在视图存活期间不得修改。本类线程安全。
+ */
+class TransformedModelView {
+public:
+  /**
+   * @throws std::invalid_argument 当 source 为空或矩阵不是相似变换时。
+   */
+  TransformedModelView(std::shared_ptr<const UnifiedModel> source,
+                       const CMatrix4 &matrix);
+
+  ~TransformedModelView();
+
+  TransformedModelView(const TransformedModelView &) = delete;
+  TransformedModelView &operator=(const TransformedModelView &) = delete;
+
+  const UnifiedModel &GetSource() const { return *m_source; }
+  const CMatrix4 &GetMatrix() const { return m_matrix; }
+
+  std::size_t FeatureCount() const { return m_source->GetFeatures().size(); }
+
+  /**
+   * @brief 获取变换后的特征；ID 不存在时返回空指针。
+   */
+  std::shared_ptr<const CFeatureBase> GetFeature(const std::string &featureID);
+
+  /**
+   * @brief 按源模型中的顺序获取变换后的特征；越界时返回空指针。
+   */
+  std::shared_ptr<const CFeatureBase> GetFeatureAt(std::size_t index);
+
+  /**
+   * @brief 已完成变换的特征数。
+   */
+  std::size_t MaterializedCount() const;
+
+  /**
+   * @brief 变换全部特征并生成独立的新模型（单位、名称与源模型一致）。
+   */
+  UnifiedModel Materialize();
+
+private:
+  struct CloneState;
+
+  std::shared_ptr<CFeatureBase> MaterializeLocked(std::size_t index);
+
+  std::shared_ptr<const UnifiedModel> m_source;
+  CMatrix4 m_matrix;
+  double m_scale = 1.0;
+  mutable std::mutex m_mutex;
+  std::vector<std::shared_ptr<CFeatureBase>> m_cache;
+  std::unordered_map<std::string, std::size_t> m_indexByID;
+  std::unique_ptr<CloneState> m_clones;
+};
+
+} // namespace CADExchange
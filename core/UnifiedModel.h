@@ -1,6 +1,7 @@
 #pragma once
 // clang-format off
 #include "UnifiedFeatures.h"
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -53,8 +54,40 @@ public:
     }
     m_features.push_back(feature);
     m_index[feature->featureID] = feature;
+    ++m_revision;
   }
 
+  /**
+   * @brief 批量注册特征：一次预留容量、按给定顺序追加并同步索引。
+   *
+   * 与逐个调用 AddFeature 结果一致，但 revision 只递增一次。
+   * 空指针会被跳过。
+   *
+   * @param features 按最终顺序排列的特征列表。
+   */
+  void AddFeatures(const std::vector<std::shared_ptr<CFeatureBase>> &features) {
+    if (features.empty()) {
+      return;
+    }
+    m_features.reserve(m_features.size() + features.size());
+    m_index.reserve(m_index.size() + features.size());
+    for (const auto &feature : features) {
+      if (!feature) {
+        continue;
+      }
+      m_features.push_back(feature);
+      m_index[feature->featureID] = feature;
+    }
+    ++m_revision;
+  }
+
+  /**
+   * @brief 模型结构修订号，每次增删特征（AddFeature/AddFeatures/Clear）后递增。
+   *
+   * 可供缓存判断模型是否发生结构变化；原地修改字段不会改变修订号。
+   */
+  std::uint64_t GetRevision() const { return m_revision; }
+
   /**
    * @brief 根据标识符获取对应的特征对象。
    *
@@ -150,6 +183,7 @@ public:
   void Clear() {
     m_features.clear();
     m_index.clear();
+    ++m_revision;
   }
 
   /**
@@ -168,11 +202,35 @@ private:
   std::vector<std::shared_ptr<CFeatureBase>> m_features; ///< 特征列表
   std::unordered_map<std::string, std::shared_ptr<CFeatureBase>>
       m_index; ///< ID 索引
+  std::uint64_t m_revision = 0; ///< 结构修订号
 };
 
 bool ConvertModelUnit(UnifiedModel &model, UnitType targetUnit,
                       std::string *errorMessage = nullptr);
 
+/// Incremental form of ConvertModelUnit's scaling, fed one feature at a time.
+/// Points and lengths are multiplied by `factor` (directions are unchanged).
+/// Reference entities are scaled once even when several features share them,
+/// and only in Flush(), so features added later still see them in the source
+/// unit. The result after Flush() equals ConvertModelUnit over the same features.
+class FeatureUnitScaler {
+public:
+  explicit FeatureUnitScaler(double factor);
+  ~FeatureUnitScaler();
+
+  FeatureUnitScaler(const FeatureUnitScaler &) = delete;
+  FeatureUnitScaler &operator=(const FeatureUnitScaler &) = delete;
+
+  /// Scale the feature's own fields now; queue its references for Flush().
+  void Scale(CFeatureBase &feature);
+  /// Scale every queued reference entity.
+  void Flush();
+
+private:
+  struct State;
+  std::unique_ptr<State> m_state;
+};
+
 /// Parse a unit string (e.g. "mm", "inch") into the UnitType enum.
 /// Returns false if the string is unrecognised.
 bool TryParseUnitType(const std::string &unitStr, UnitType &out);
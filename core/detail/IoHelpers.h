@@ -0,0 +1,111 @@
+#pragma once
+// clang-format off
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+// clang-format on
+
+/**
+ * @file IoHelpers.h
+ * @brief 库内部共用的小工具：错误输出、FNV-1a 哈希、小端编解码与整文件读取。
+ *
+ * 仅供 .cpp 实现文件使用，不属于公开接口。
+ */
+
+namespace CADExchange {
+namespace detail {
+
+/**
+ * @brief 写入可选的错误信息并返回 false，便于 `return Fail(...)`。
+ */
+inline bool Fail(std::string *errorMessage, const std::string &message) {
+  if (errorMessage) {
+    *errorMessage = message;
+  }
+  return false;
+}
+
+/**
+ * @brief 增量 64 位 FNV-1a 哈希器。
+ *
+ * MixValue 按本机字节序写入平凡可复制值，结果只适合进程内的缓存键；
+ * 需要落盘的摘要请先用 PutLE 编码再 Mix。
+ */
+class Fnv1aHasher {
+public:
+  static constexpr std::uint64_t kOffsetBasis = 14695981039346656037ULL;
+  static constexpr std::uint64_t kPrime = 1099511628211ULL;
+
+  explicit Fnv1aHasher(std::uint64_t seed = kOffsetBasis) : m_hash(seed) {}
+
+  void Mix(const void *data, std::size_t size) {
+    const auto *bytes = static_cast<const unsigned char *>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+      m_hash ^= bytes[i];
+      m_hash *= kPrime;
+    }
+  }
+
+  void Mix(std::string_view bytes) { Mix(bytes.data(), bytes.size()); }
+
+  template <typename T> void MixValue(const T &value) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "MixValue 只接受平凡可复制类型");
+    Mix(&value, sizeof(T));
+  }
+
+  std::uint64_t Value() const { return m_hash; }
+
+private:
+  std::uint64_t m_hash;
+};
+
+/**
+ * @brief 64 位 FNV-1a 哈希。
+ */
+inline std::uint64_t Fnv1a(std::string_view bytes) {
+  Fnv1aHasher hasher;
+  hasher.Mix(bytes);
+  return hasher.Value();
+}
+
+/**
+ * @brief 以小端字节序追加无符号整数。
+ */
+template <typename T> void PutLE(std::string &out, T value) {
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+/**
+ * @brief 从 data 读取小端无符号整数；调用方保证至少有 sizeof(T) 字节。
+ */
+template <typename T> T GetLE(const char *data) {
+  T value = 0;
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    value |= static_cast<T>(static_cast<unsigned char>(data[i])) << (8 * i);
+  }
+  return value;
+}
+
+/**
+ * @brief 把整个文件读入 out；打开或读取失败时返回 false。
+ */
+inline bool ReadFile(const std::filesystem::path &path, std::string &out) {
+  std::ifstream input(path, std::ios::binary | std::ios::ate);
+  if (!input) {
+    return false;
+  }
+  out.resize(static_cast<std::size_t>(input.tellg()));
+  input.seekg(0);
+  return static_cast<bool>(
+      input.read(out.data(), static_cast<std::streamsize>(out.size())));
+}
+
+} // namespace detail
+} // namespace CADExchange
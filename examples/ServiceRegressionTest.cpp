@@ -0,0 +1,2434 @@
+#include "../service/serialization/CerealPrelude.h"
+#include "../core/ModelTransform.h"
+#include "../core/UnifiedModel.h"
+#include "../service/builders/DatumPlaneBuilder.h"
+#include "../service/builders/ExtrudeBuilder.h"
+#include "../service/builders/IdGenerator.h"
+#include "../service/builders/ModelTransaction.h"
+#include "../service/builders/ReferenceBuilder.h"
+#include "../service/builders/SketchBuilder.h"
+#include "../service/geometry/DatumPlaneEvaluator.h"
+#include "../service/geometry/EdgeChainBuilder.h"
+#include "../service/geometry/FeatureBoundsTree.h"
+#include "../service/geometry/GeometryCollectorBase.h"
+#include "../service/geometry/ModelMatcher.h"
+#include "../service/geometry/PatternExpander.h"
+#include "../service/geometry/ReferenceResolver.h"
+#include "../service/geometry/ReferenceSpatialIndex.h"
+#include "../service/geometry/SketchLoopExtractor.h"
+#include "../service/geometry/SketchProjection.h"
+#include "../service/serialization/AsyncSerializer.h"
+#include "../service/serialization/CADSerializer.h"
+#include "../service/serialization/JsonStreamArchive.h"
+#include "../service/serialization/ModelCache.h"
+#include "../service/serialization/ModelImage.h"
+#include "../service/serialization/ModelJournal.h"
+#include "../service/serialization/ModelWorkspace.h"
+#include "../service/serialization/NameTable.h"
+#include "../service/server/ModelClient.h"
+#include "../service/server/ModelServer.h"
+#include "../service/server/SharedModelChannel.h"
+#include "../service/validation/ConstraintChecker.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace CADExchange;
+using namespace CADExchange::Builder;
+
+namespace {
+
+void Fail(const std::string &message) {
+  std::cerr << "[FAIL] " << message << std::endl;
+  std::exit(1);
+}
+
+void Expect(bool condition, const std::string &message) {
+  if (!condition) {
+    Fail(message);
+  }
+}
+
+void TestIdGeneratorDeterministicSequence() {
+  IdGenerator::Reset(1);
+  Expect(IdGenerator::NextFeatureID() == "FB-1",
+         "First ID after Reset(1) should be FB-1.");
+  Expect(IdGenerator::NextFeatureID() == "FB-2",
+         "IDs should increase sequentially within a thread.");
+
+  IdGenerator::Reset(1);
+  UnifiedModel model(UnitType::MILLIMETER, "id-determinism");
+  SketchBuilder sketch(model, "Sketch1");
+  const std::string line = sketch.AddLine(CPoint3D{0, 0, 0}, CPoint3D{1, 0, 0});
+  const std::string circle = sketch.AddCircle(CPoint3D{0, 0, 0}, 2.0);
+  Expect(sketch.Build() == "FB-1",
+         "Builder IDs should be reproducible after Reset.");
+  Expect(line == "L_1" && circle == "C_2",
+         "Sketch local IDs should keep the <prefix>_<n> format.");
+
+  Expect(IdGenerator::Format("FB-", 123456789012ULL) == "FB-123456789012",
+         "Format should print the full serial.");
+  Expect(IdGenerator::Format("FB-", 18446744073709551615ULL) ==
+             "FB-18446744073709551615",
+         "Format should print serials longer than 12 digits.");
+
+  bool rejected = false;
+  try {
+    IdGenerator::Format("PREFIX-TOO-LONG-", 1);
+  } catch (const std::invalid_argument &) {
+    rejected = true;
+  }
+  Expect(rejected, "Format should reject prefixes instead of truncating.");
+}
+
+void TestIdGeneratorUniqueAcrossThreads() {
+  constexpr int kThreads = 8;
+  constexpr int kPerThread = 5000;
+  std::vector<std::vector<std::string>> ids(kThreads);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < kThreads; ++t) {
+    workers.emplace_back([&ids, t]() {
+      ids[t].reserve(kPerThread);
+      for (int i = 0; i < kPerThread; ++i) {
+        ids[t].push_back(StringHelper::GenerateUUID());
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  std::set<std::string> unique;
+  for (const auto &list : ids) {
+    unique.insert(list.begin(), list.end());
+  }
+  Expect(unique.size() == static_cast<size_t>(kThreads * kPerThread),
+         "IDs generated on different threads must not collide.");
+}
+
+void TestModelTransactionCommitsLanesInOrder() {
+  UnifiedModel model(UnitType::MILLIMETER, "transaction");
+  ModelTransaction tx(model);
+  const std::uint64_t revisionBefore = model.GetRevision();
+
+  constexpr int kLanes = 4;
+  constexpr int kPerLane = 50;
+  std::vector<std::thread> workers;
+  for (int lane = 0; lane < kLanes; ++lane) {
+    TransactionLane &staging = tx.Lane(lane);
+    workers.emplace_back([&staging, lane]() {
+      for (int i = 0; i < kPerLane; ++i) {
+        const std::string tag = std::to_string(lane) + "_" + std::to_string(i);
+        SketchBuilder sketch(staging, "Sketch_" + tag);
+        sketch.SetCSys(CPoint3D{0, 0, 0}, CVector3D{1, 0, 0},
+                       CVector3D{0, 1, 0}, CVector3D{0, 0, 1});
+        sketch.AddCircle(CPoint3D{0, 0, 0}, 1.0);
+        sketch.Build();
+        ExtrudeBuilder(staging, "Extrude_" + tag)
+            .SetProfileByName("Sketch_" + tag)
+            .SetEndCondition1(EndCondition::Blind(5.0))
+            .Build();
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  Expect(model.GetFeatures().empty(),
+         "Staged features must not reach the model before Commit.");
+  Expect(tx.StagedCount() == kLanes * kPerLane * 2,
+         "Transaction should report every staged feature.");
+
+  std::string error;
+  Expect(tx.Commit(&error), "Transaction commit should succeed: " + error);
+  Expect(model.GetFeatures().size() == kLanes * kPerLane * 2,
+         "Commit should insert all staged features.");
+  Expect(model.GetRevision() == revisionBefore + 1,
+         "Commit should bump the model revision exactly once.");
+  Expect(model.GetFeatures().front()->featureName == "Sketch_0_0" &&
+             model.GetFeatures().back()->featureName == "Extrude_3_49",
+         "Commit order should follow lane index then staging order.");
+  Expect(tx.StagedCount() == 0, "Commit should clear staged features.");
+}
+
+void TestModelTransactionDefersCrossLaneReferences() {
+  UnifiedModel model(UnitType::MILLIMETER, "transaction-refs");
+  ModelTransaction tx(model);
+
+  // Lane 0 references a datum plane that only lane 1 stages.
+  const std::string planeID = "DATUM-LATE";
+  SketchBuilder sketch(tx.Lane(0), "SketchOnDatum");
+  sketch.SetReferencePlane(Ref::Plane(planeID));
+  sketch.Build();
+
+  std::string error;
+  Expect(!tx.Commit(&error),
+         "Commit must fail while a referenced feature is missing.");
+  Expect(error.find(planeID) != std::string::npos,
+         "Commit error should name the missing reference.");
+  Expect(model.GetFeatures().empty(),
+         "A failed commit must leave the model untouched.");
+
+  DatumPlaneBuilder plane(tx.Lane(1), "LateDatum");
+  plane.GetFeature()->featureID = planeID;
+  plane.Build();
+  Expect(tx.Commit(&error),
+         "Commit should succeed once the reference is staged: " + error);
+  Expect(model.GetFeatures().size() == 2 && model.GetFeature(planeID),
+         "Both lanes should be committed.");
+
+  SketchBuilder direct(model, "DirectSketch");
+  bool threw = false;
+  try {
+    direct.SetReferencePlane(Ref::Plane("DATUM-MISSING"));
+  } catch (const std::runtime_error &) {
+    threw = true;
+  }
+  Expect(threw, "Direct builders must still validate references eagerly.");
+}
+
+bool Near(double a, double b, double tol = 1e-9) {
+  return std::abs(a - b) <= tol;
+}
+
+bool NearPoint(const CPoint3D &p, double x, double y, double z) {
+  return Near(p.x, x) && Near(p.y, y) && Near(p.z, z);
+}
+
+bool NearVector(const CVector3D &v, double x, double y, double z) {
+  return Near(v.x, x) && Near(v.y, y) && Near(v.z, z);
+}
+
+/// 两个草图共享同一个参考平面，另有带垂足的基准面与拉伸。
+std::shared_ptr<UnifiedModel> MakeTransformFixture() {
+  auto model = std::make_shared<UnifiedModel>(UnitType::MILLIMETER, "xform");
+
+  auto sharedPlane = std::make_shared<CRefPlane>();
+  sharedPlane->targetFeatureID = "DATUM-A";
+  sharedPlane->origin = {1, 2, 3};
+  sharedPlane->normal = {0, 0, 1};
+
+  for (int i = 0; i < 2; ++i) {
+    auto sketch = std::make_shared<CSketch>();
+    sketch->featureID = "SK-" + std::to_string(i);
+    sketch->referencePlane = sharedPlane;
+    sketch->sketchCSys = {{1, 2, 3}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}, true};
+    auto circle = std::make_shared<CSketchCircle>();
+    circle->localID = "C_1";
+    circle->center = {4, 0, 0};
+    circle->radius = 2.0;
+    sketch->segments.push_back(circle);
+    model->AddFeature(sketch);
+  }
+
+  auto extrude = std::make_shared<CExtrude>();
+  extrude->featureID = "EX-1";
+  extrude->profileSketchID = "SK-0";
+  extrude->direction = {0, 0, 1};
+  extrude->extent1.type = SweepExtent::Type::VALUE;
+  extrude->extent1.value = 10.0;
+  model->AddFeature(extrude);
+
+  auto datum = std::make_shared<CDatumPlane>();
+  datum->featureID = "DATUM-A";
+  datum->method = PlaneMethod::OFFSET;
+  datum->projectedOrigin = CPoint3D{0, 0, 5};
+  datum->normal = CVector3D{0, 0, 1};
+  model->AddFeature(datum);
+
+  auto bareDatum = std::make_shared<CDatumPlane>();
+  bareDatum->featureID = "DATUM-B";
+  bareDatum->method = PlaneMethod::OFFSET;
+  bareDatum->projectedOrigin = CPoint3D{0, 0, 5};
+  model->AddFeature(bareDatum);
+  return model;
+}
+
+/// 绕 X 轴旋转 90°，再平移 (3, 4, 0)。
+CMatrix4 FixtureMatrix() {
+  return CMatrix4::Translation({3, 4, 0}) *
+         CMatrix4::Rotation({1, 0, 0}, std::acos(-1.0) / 2.0);
+}
+
+void ExpectFixtureTransformed(const CSketch &sketch, const CExtrude &extrude,
+                              const CDatumPlane &datum,
+                              const CDatumPlane &bareDatum,
+                              const std::string &label) {
+  Expect(NearPoint(sketch.sketchCSys.origin, 4, 1, 2),
+         label + ": sketch origin should be rotated then translated.");
+  Expect(NearVector(sketch.sketchCSys.yDir, 0, 0, 1) &&
+             NearVector(sketch.sketchCSys.zDir, 0, -1, 0),
+         label + ": CSys axes should only be rotated.");
+  auto circle = std::static_pointer_cast<CSketchCircle>(sketch.segments[0]);
+  Expect(NearPoint(circle->center, 4, 0, 0) && Near(circle->radius, 2.0),
+         label + ": sketch-local geometry must not move under a rigid motion.");
+  auto plane = std::static_pointer_cast<CRefPlane>(sketch.referencePlane);
+  Expect(NearPoint(plane->origin, 4, 1, 2),
+         label + ": shared reference plane should be transformed exactly once.");
+  Expect(NearVector(extrude.direction, 0, -1, 0) &&
+             Near(extrude.extent1.value, 10.0),
+         label + ": extrude direction should rotate, depth should not change.");
+  Expect(NearPoint(*datum.projectedOrigin, 0, -1, 0) &&
+             NearVector(*datum.normal, 0, -1, 0),
+         label + ": datum projected origin should be re-projected.");
+  Expect(NearPoint(*bareDatum.projectedOrigin, 0, -1, 0),
+         label + ": datum without normal should infer it from the foot point.");
+}
+
+void TestTransformModelRigidMotion() {
+  auto model = MakeTransformFixture();
+  std::string error;
+  Expect(TransformModel(*model, FixtureMatrix(), &error),
+         "Rigid transform should be accepted.");
+  ExpectFixtureTransformed(*model->GetFeatureAs<CSketch>("SK-1"),
+                           *model->GetFeatureAs<CExtrude>("EX-1"),
+                           *model->GetFeatureAs<CDatumPlane>("DATUM-A"),
+                           *model->GetFeatureAs<CDatumPlane>("DATUM-B"),
+                           "TransformModel");
+
+  Expect(TransformModel(*model, CMatrix4::UniformScale(2.0), &error),
+         "Uniform scale should be accepted.");
+  auto sketch = model->GetFeatureAs<CSketch>("SK-0");
+  auto circle = std::static_pointer_cast<CSketchCircle>(sketch->segments[0]);
+  Expect(NearPoint(sketch->sketchCSys.origin, 8, 2, 4) &&
+             NearPoint(circle->center, 8, 0, 0) && Near(circle->radius, 4.0) &&
+             NearVector(sketch->sketchCSys.zDir, 0, -1, 0),
+         "Uniform scale should scale points and lengths, not directions.");
+
+  CMatrix4 shear;
+  shear.m[0][1] = 0.5;
+  CMatrix4 mirror;
+  mirror.m[0][0] = -1.0;
+  Expect(!TransformModel(*model, shear, &error) && !error.empty(),
+         "Shear transforms must be rejected.");
+  Expect(!TransformModel(*model, mirror, &error),
+         "Reflections must be rejected.");
+  Expect(NearPoint(sketch->sketchCSys.origin, 8, 2, 4),
+         "Rejected transforms must leave the model untouched.");
+}
+
+void TestTransformedModelViewIsLazy() {
+  auto source = MakeTransformFixture();
+  TransformedModelView view(source, FixtureMatrix());
+  Expect(view.MaterializedCount() == 0, "The view should not transform eagerly.");
+
+  auto sketch0 = std::static_pointer_cast<const CSketch>(view.GetFeature("SK-0"));
+  Expect(sketch0 && view.MaterializedCount() == 1,
+         "Accessing one feature should only materialize that feature.");
+  Expect(NearPoint(source->GetFeatureAs<CSketch>("SK-0")->sketchCSys.origin, 1,
+                   2, 3),
+         "The source model must stay untouched.");
+
+  auto sketch1 = std::static_pointer_cast<const CSketch>(view.GetFeatureAt(1));
+  Expect(sketch0->referencePlane == sketch1->referencePlane &&
+             sketch0->referencePlane !=
+                 source->GetFeatureAs<CSketch>("SK-0")->referencePlane,
+         "Shared references should be cloned once and stay shared in the view.");
+  Expect(view.GetFeature("MISSING") == nullptr,
+         "Unknown IDs should return null.");
+
+  UnifiedModel materialized = view.Materialize();
+  Expect(materialized.GetFeatures().size() == source->GetFeatures().size() &&
+             view.MaterializedCount() == source->GetFeatures().size(),
+         "Materialize should produce every feature.");
+  ExpectFixtureTransformed(*materialized.GetFeatureAs<CSketch>("SK-1"),
+                           *materialized.GetFeatureAs<CExtrude>("EX-1"),
+                           *materialized.GetFeatureAs<CDatumPlane>("DATUM-A"),
+                           *materialized.GetFeatureAs<CDatumPlane>("DATUM-B"),
+                           "TransformedModelView");
+}
+
+void TestConvertModelUnitUsesSharedVisitor() {
+  auto model = MakeTransformFixture();
+  std::string error;
+  Expect(ConvertModelUnit(*model, UnitType::METER, &error),
+         "mm -> m conversion should succeed.");
+  auto sketch = model->GetFeatureAs<CSketch>("SK-0");
+  auto circle = std::static_pointer_cast<CSketchCircle>(sketch->segments[0]);
+  auto plane = std::static_pointer_cast<CRefPlane>(sketch->referencePlane);
+  Expect(NearPoint(sketch->sketchCSys.origin, 0.001, 0.002, 0.003) &&
+             Near(circle->radius, 0.002) &&
+             NearPoint(plane->origin, 0.001, 0.002, 0.003),
+         "Points, radii and shared references should be scaled once.");
+  Expect(NearVector(sketch->sketchCSys.zDir, 0, 0, 1) &&
+             Near(model->GetFeatureAs<CExtrude>("EX-1")->extent1.value, 0.01),
+         "Directions must not be scaled; lengths must.");
+}
+
+void TestPatternExpanderLinearGrid() {
+  CLinearPattern pattern;
+  pattern.featureID = "LP-1";
+  pattern.dir1.direction = {2, 0, 0};
+  pattern.dir1.spacing = 10.0;
+  pattern.dir1.count = 3;
+  CLinearPatternDir dir2;
+  dir2.direction = {0, 1, 0};
+  dir2.spacingType = PatternSpacingType::SPAN_AND_COUNT;
+  dir2.spacing = 8.0;
+  dir2.count = 2;
+  pattern.dir2 = dir2;
+  pattern.skippedInstances = {{1, 1}, {0, 0}};
+
+  Geometry::PatternExpander expander;
+  std::string error;
+  auto instances = expander.Expand(pattern, &error);
+  Expect(instances != nullptr, "Linear pattern should expand: " + error);
+  Expect(instances->Size() == 5 && instances->IsSkipped(1, 1) &&
+             !instances->HasInstance(1, 1) && instances->HasInstance(0, 0),
+         "Skipped cells should be excluded; the seed can never be skipped.");
+  Expect(instances->indices.back().dir1Index == 2 &&
+             instances->indices.back().dir2Index == 1,
+         "Instances should be ordered by dir2 then dir1.");
+  const CPoint3D last =
+      instances->transforms.back().TransformPoint(CPoint3D{1, 1, 1});
+  Expect(NearPoint(last, 21, 9, 1),
+         "Instance (2,1) should translate by 2*pitch and one full span.");
+
+  Expect(expander.Expand(pattern) == instances && expander.CacheSize() == 1,
+         "Identical parameters should hit the cache.");
+  CLinearPattern renamed = pattern;
+  renamed.featureID = "LP-2";
+  Expect(Geometry::PatternExpander::ContentHash(renamed) ==
+             Geometry::PatternExpander::ContentHash(pattern),
+         "Feature identity must not affect the content hash.");
+  renamed.dir1.spacing = 11.0;
+  Expect(expander.Expand(renamed) != instances && expander.CacheSize() == 2,
+         "Changed parameters should produce a new expansion.");
+
+  pattern.patternSeedOnly = true;
+  pattern.skippedInstances.clear();
+  Expect(expander.Expand(pattern)->Size() == 4,
+         "Seed-only patterns should only copy the seed along dir2.");
+
+  CLinearPattern panel;
+  panel.dir1.direction = {1, 0, 0};
+  panel.dir1.spacing = 1.0;
+  panel.dir1.count = 100;
+  CLinearPatternDir panelDir2;
+  panelDir2.direction = {0, 1, 0};
+  panelDir2.spacing = 1.0;
+  panelDir2.count = 100;
+  panel.dir2 = panelDir2;
+  auto holes = expander.Expand(panel);
+  CPointBlock seeds;
+  seeds.Push(CPoint3D{0.5, 0.5, 0});
+  seeds.Push(CPoint3D{0.5, 0.5, -1});
+  CPointBlock placed = Geometry::PatternExpander::TransformPoints(*holes, seeds);
+  Expect(placed.Size() == 20000 &&
+             NearPoint(placed.PointAt(19999), 99.5, 99.5, -1),
+         "Batched point expansion should lay out instance-major blocks.");
+}
+
+void TestPatternExpanderCircularAndMirror() {
+  CCircularPattern circular;
+  auto axis = std::make_shared<CRefAxis>();
+  axis->origin = {10, 0, 0};
+  axis->direction = {0, 0, 1};
+  circular.dir1.axisRef = axis;
+  circular.dir1.direction = {0, 0, 1};
+  circular.dir1.spacingType = PatternSpacingType::SPAN_AND_COUNT;
+  circular.dir1.angle = 2.0 * std::acos(-1.0);
+  circular.dir1.count = 4;
+
+  Geometry::PatternExpander expander;
+  auto ring = expander.Expand(circular);
+  Expect(ring && ring->Size() == 4, "Circular pattern should expand.");
+  Expect(NearPoint(ring->transforms[1].TransformPoint(CPoint3D{11, 0, 0}), 10,
+                   1, 0),
+         "A full-circle span should divide 360 degrees by the count.");
+
+  auto face = std::make_shared<CRefFace>();
+  face->centroid = {12, 0, 3};
+  face->normal = {1, 0, 0};
+  auto instancesRefs = Geometry::PatternExpander::InstantiateReferences(
+      *ring, {face, face});
+  Expect(instancesRefs.size() == 8 && instancesRefs[2] == instancesRefs[3] &&
+             instancesRefs[0] != face,
+         "Each instance should clone shared seeds once.");
+  auto rotated = std::static_pointer_cast<CRefFace>(instancesRefs[4]);
+  Expect(NearPoint(rotated->centroid, 8, 0, 3) &&
+             NearVector(rotated->normal, -1, 0, 0) &&
+             NearPoint(face->centroid, 12, 0, 3),
+         "Reference fingerprints should follow the instance transform.");
+
+  CMirrorPattern mirror;
+  auto plane = std::make_shared<CRefPlane>();
+  plane->origin = {5, 0, 0};
+  plane->normal = {1, 0, 0};
+  mirror.mirrorPlaneRef = plane;
+  auto mirrored = expander.Expand(mirror);
+  Expect(mirrored && mirrored->Size() == 2, "Mirror pattern should expand.");
+
+  CSketch seed;
+  seed.sketchCSys = {{1, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}, true};
+  seed.referencePlane = plane;
+  auto sketches = Geometry::PatternExpander::InstantiateSketch(*mirrored, seed);
+  const CSketchCSys &csys = sketches[1]->sketchCSys;
+  Expect(NearPoint(csys.origin, 9, 0, 0) && NearVector(csys.xDir, -1, 0, 0) &&
+             NearVector(csys.zDir, 0, 0, -1) && csys.IsValid(),
+         "Mirrored sketch CSys should stay right-handed.");
+  Expect(sketches[1]->referencePlane != plane &&
+             NearPoint(plane->origin, 5, 0, 0),
+         "Instantiated sketches must not modify the seed.");
+
+  CMirrorPattern unresolved;
+  std::string error;
+  Expect(!expander.Expand(unresolved, &error) && !error.empty(),
+         "Mirror without a plane should report an error.");
+}
+
+/// 20x20 的面指纹网格（间距 1，z=0，法向 +Z；x 为偶数的面法向 +X）。
+std::shared_ptr<CFillet> MakeFaceGridFeature(const std::string &id) {
+  auto fillet = std::make_shared<CFillet>();
+  fillet->featureID = id;
+  for (int i = 0; i < 20; ++i) {
+    for (int j = 0; j < 20; ++j) {
+      auto face = std::make_shared<CRefFace>();
+      face->parentFeatureID = "BODY";
+      face->centroid = {static_cast<double>(i), static_cast<double>(j), 0};
+      face->normal = (i % 2 == 0) ? CVector3D{1, 0, 0} : CVector3D{0, 0, 1};
+      fillet->side1Faces.push_back(face);
+    }
+  }
+  return fillet;
+}
+
+void TestReferenceSpatialIndexQueries() {
+  UnifiedModel model(UnitType::MILLIMETER, "spatial");
+  model.AddFeature(MakeFaceGridFeature("FILLET-1"));
+  auto chamfer = std::make_shared<CChamfer>();
+  chamfer->featureID = "CHAMFER-1";
+  auto edge = std::make_shared<CRefEdge>();
+  edge->startPoint = {0, 30, 5};
+  edge->midPoint = {5, 30, 5};
+  edge->endPoint = {10, 30, 5};
+  edge->curveType = CGeoCurveType::LINE;
+  chamfer->references.push_back(edge);
+  model.AddFeature(chamfer);
+
+  Geometry::ReferenceSpatialIndex index(model);
+  Expect(index.SlotCount() == 401, "Every fingerprinted reference is a slot.");
+
+  auto near = index.QueryRadius(CPoint3D{7.1, 3.0, 0.2}, 0.5);
+  Expect(near.size() == 1 && near[0].slot.featureID == "FILLET-1" &&
+             near[0].slot.slotIndex == 7 * 20 + 3,
+         "Radius query should return the owning feature and slot.");
+
+  auto nearest = index.QueryNearest(CPoint3D{7.4, 30.2, 5}, 3);
+  Expect(nearest.size() == 3 && nearest[0].slot.featureID == "CHAMFER-1" &&
+             Near(nearest[0].distance, 0.2) &&
+             nearest[1].distance <= nearest[2].distance,
+         "kNN should measure distance to edge segments and sort ascending.");
+
+  auto ray = index.QueryRay(CPoint3D{5, 5, 10}, CVector3D{0, 0, -3}, 0.1);
+  Expect(ray.size() == 1 && ray[0].slot.slotIndex == 5 * 20 + 5 &&
+             Near(ray[0].rayParameter, 10.0),
+         "Ray proximity should find the face fingerprint under the ray.");
+  auto rayEdge = index.QueryRay(CPoint3D{3, 40, 5}, CVector3D{0, -1, 0}, 0.1);
+  Expect(!rayEdge.empty() && rayEdge[0].slot.featureID == "CHAMFER-1" &&
+             Near(rayEdge[0].rayParameter, 10.0),
+         "A ray crossing an edge segment should hit the edge.");
+
+  Geometry::ReferenceQueryFilter upFacing;
+  upFacing.normal = CVector3D{0, 0, 1};
+  upFacing.maxNormalAngle = 0.1;
+  auto filtered = index.QueryRadius(CPoint3D{6.5, 0, 0}, 0.6, upFacing);
+  Expect(filtered.size() == 1 && filtered[0].slot.slotIndex == 7 * 20,
+         "Normal filters should drop faces facing elsewhere.");
+  Expect(index.QueryNormal(CVector3D{1, 0, 0.05}, 0.1).size() == 200,
+         "Normal binning should find every +X face.");
+
+  auto extra = MakeFaceGridFeature("FILLET-2");
+  model.AddFeature(extra);
+  Expect(index.Update(model) && index.SlotCount() == 801,
+         "Appending features should update the index incrementally.");
+  Expect(index.QueryRadius(CPoint3D{7, 3, 0}, 0.01).size() == 2,
+         "Incrementally added slots should be queryable.");
+  index.RemoveFeature("FILLET-1");
+  auto afterRemove = index.QueryRadius(CPoint3D{7, 3, 0}, 0.01);
+  Expect(afterRemove.size() == 1 &&
+             afterRemove[0].slot.featureID == "FILLET-2",
+         "Removed features must disappear from queries.");
+  Expect(!index.Update(model) && index.SlotCount() == 801,
+         "A non-append change should trigger a full rebuild.");
+
+  // Clear 后重新加入特征：旧特征已释放，即使分配器复用地址也必须重建。
+  extra.reset();
+  chamfer.reset();
+  model.Clear();
+  model.AddFeature(MakeFaceGridFeature("FILLET-3"));
+  model.AddFeature(MakeFaceGridFeature("FILLET-4"));
+  Expect(!index.Update(model) && index.SlotCount() == 800,
+         "Released features must not be mistaken for unchanged ones.");
+  auto rebuilt = index.QueryRadius(CPoint3D{7, 3, 0}, 0.01);
+  Expect(rebuilt.size() == 2 && rebuilt[0].slot.featureID != "FILLET-2",
+         "Queries after Clear should only see the re-added features.");
+}
+
+
+/// 合成拓扑采集器：10x10x10 立方体的 12 条直线边。
+class BoxEdgeCollector
+    : public Geometry::GeometryCollectorBase<BoxEdgeCollector> {
+public:
+  bool CollectImpl() {
+    const double c[8][3] = {{0, 0, 0},  {10, 0, 0},  {10, 10, 0},
+                            {0, 10, 0}, {0, 0, 10},  {10, 0, 10},
+                            {10, 10, 10}, {0, 10, 10}};
+    const int pairs[12][2] = {{0, 1}, {1, 2}, {2, 3}, {3, 0}, {4, 5}, {5, 6},
+                              {6, 7}, {7, 4}, {0, 4}, {1, 5}, {2, 6}, {3, 7}};
+    for (const auto &pair : pairs) {
+      CRefEdge edge;
+      const double *a = c[pair[0]];
+      const double *b = c[pair[1]];
+      edge.startPoint = {a[0], a[1], a[2]};
+      edge.endPoint = {b[0], b[1], b[2]};
+      edge.midPoint = {(a[0] + b[0]) / 2, (a[1] + b[1]) / 2,
+                       (a[2] + b[2]) / 2};
+      edge.curveType = CGeoCurveType::LINE;
+      AddEdge(edge);
+    }
+    return true;
+  }
+};
+
+std::vector<Geometry::CandidateFace> BoxFaces() {
+  auto face = [](CPoint3D c, CVector3D n) {
+    Geometry::CandidateFace f;
+    f.centroid = c;
+    f.normal = n;
+    f.surfaceType = CGeoSurfaceType::PLANE;
+    return f;
+  };
+  return {face({5, 5, 0}, {0, 0, -1}),  face({5, 5, 10}, {0, 0, 1}),
+          face({5, 0, 5}, {0, -1, 0}),  face({5, 10, 5}, {0, 1, 0}),
+          face({0, 5, 5}, {-1, 0, 0}), face({10, 5, 5}, {1, 0, 0})};
+}
+
+void TestReferenceResolverMatchesTopology() {
+  BoxEdgeCollector collector;
+  collector.Collect();
+  Geometry::ReferenceResolver resolver(collector, BoxFaces(),
+                                       UnitType::MILLIMETER);
+  Expect(Near(resolver.GetTolerance(), 0.02) &&
+             resolver.GetTopology().vertices.size() == 8,
+         "Resolver should use the shared tolerance and derive box vertices.");
+
+  auto fillet = std::make_shared<CFillet>();
+  fillet->featureID = "FILLET-1";
+  auto top = std::make_shared<CRefFace>();
+  top->centroid = {5.005, 5, 10};
+  top->normal = {0, 0, 2};
+  fillet->side1Faces.push_back(top);
+  auto flipped = std::make_shared<CRefFace>();
+  flipped->centroid = {5, 5, 10};
+  flipped->normal = {0, 0, -1};
+  fillet->side1Faces.push_back(flipped);
+  auto reversedEdge = std::make_shared<CRefEdge>();
+  reversedEdge->startPoint = {10, 10, 10.01};
+  reversedEdge->midPoint = {5, 10, 10};
+  reversedEdge->endPoint = {0, 10, 10};
+  fillet->references.push_back(reversedEdge);
+  auto corner = std::make_shared<CRefVertex>();
+  corner->pos = {10, 0, 0};
+  fillet->references.push_back(corner);
+  fillet->references.push_back(corner);
+
+  auto results = resolver.ResolveFeature(*fillet);
+  Expect(results.size() == 5, "Every topology slot should get a result.");
+  Expect(results[0].status == Geometry::ResolveStatus::Resolved &&
+             results[0].candidate == 6 && Near(results[0].deviation, 0.01),
+         "Edges should match in either direction.");
+  Expect(results[1].status == Geometry::ResolveStatus::Resolved &&
+             resolver.GetTopology().vertices[results[1].candidate] ==
+                 CPoint3D{10, 0, 0} &&
+             Near(results[1].confidence, 1.0) &&
+             results[2].candidate == results[1].candidate,
+         "Vertices should resolve against derived box corners.");
+  Expect(results[3].status == Geometry::ResolveStatus::Resolved &&
+             results[3].candidate == 1 && results[3].slot.slotIndex == 3 &&
+             results[3].confidence > 0.5 && results[3].confidence < 1.0,
+         "Face should resolve by centroid and normal.");
+  Expect(results[4].status == Geometry::ResolveStatus::Unresolved,
+         "A face with an opposite normal must not resolve.");
+
+  auto ambiguous = std::make_shared<CRefEdge>();
+  ambiguous->startPoint = {0, 0, 0};
+  ambiguous->midPoint = {5, 0, 0};
+  ambiguous->endPoint = {10, 0, 0};
+  Geometry::CandidateTopology duplicated;
+  duplicated.edges = collector.GetEdges();
+  duplicated.edges.push_back(collector.GetEdges()[0]);
+  Geometry::ReferenceResolver dupResolver(std::move(duplicated),
+                                          UnitType::MILLIMETER);
+  auto dup = dupResolver.Resolve(ambiguous);
+  Expect(dup.status == Geometry::ResolveStatus::Ambiguous &&
+             dup.candidate == 0 && dup.ambiguities == std::vector<int>{12} &&
+             Near(dup.confidence, 0.0),
+         "Identical candidates should be reported as ambiguous.");
+  auto arc = std::make_shared<CRefEdge>(*ambiguous);
+  arc->curveType = CGeoCurveType::CIRCLE;
+  Expect(resolver.Resolve(arc).status == Geometry::ResolveStatus::Unresolved,
+         "Curve type mismatches must not resolve.");
+
+  Geometry::ResolveOptions loose;
+  loose.tolerance = 0.5;
+  Geometry::ReferenceResolver looseResolver(collector, {}, UnitType::METER,
+                                            loose);
+  arc->curveType = CGeoCurveType::LINE;
+  arc->midPoint = {5, 0.3, 0};
+  auto looseMatch = looseResolver.Resolve(arc);
+  Expect(Near(looseResolver.GetTolerance(), 0.5) &&
+             looseMatch.status == Geometry::ResolveStatus::Resolved &&
+             Near(looseMatch.confidence, 0.7),
+         "A tolerance override should replace the unit tolerance.");
+}
+
+void TestReferenceResolverParallelBatch() {
+  Geometry::CandidateTopology grid;
+  for (int i = 0; i < 20; ++i) {
+    for (int j = 0; j < 20; ++j) {
+      Geometry::CandidateFace face;
+      face.centroid = {i + 0.001, j - 0.001, 0};
+      face.normal = (i % 2 == 0) ? CVector3D{1, 0, 0} : CVector3D{0, 0, 1};
+      grid.faces.push_back(face);
+    }
+  }
+  Geometry::ResolveOptions options;
+  options.threadCount = 4;
+  Geometry::ReferenceResolver resolver(std::move(grid), UnitType::MILLIMETER,
+                                       options);
+
+  auto first = MakeFaceGridFeature("FILLET-1");
+  auto second = MakeFaceGridFeature("FILLET-2");
+  second->side2Faces.push_back(first->side1Faces[42]);
+  auto results = resolver.ResolveFeatures({first, second});
+  Expect(results.size() == 801, "Batch results should cover every slot.");
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const auto &r = results[i];
+    const int expected = static_cast<int>(i < 800 ? i % 400 : 42);
+    if (r.status != Geometry::ResolveStatus::Resolved ||
+        r.candidate != expected) {
+      Fail("Batch slot " + std::to_string(i) + " resolved incorrectly.");
+    }
+  }
+  Expect(results[400].slot.featureID == "FILLET-2" &&
+             results[800].slot.slotIndex == 400,
+         "Batch results should follow feature and slot order.");
+}
+
+
+/// 单边等半径圆角（EDGE_CHAIN），边沿 X 轴自 x 起长 5，长度均乘以 scale。
+std::shared_ptr<CFillet> MakeEdgeFillet(const std::string &id, double radius,
+                                        double x, double scale) {
+  auto fillet = std::make_shared<CFillet>();
+  fillet->featureID = id;
+  fillet->mode = FilletMode::CONSTANT_RADIUS;
+  fillet->referenceMode = FilletReferenceMode::EDGE_CHAIN;
+  fillet->params.primaryValue = radius * scale;
+  auto edge = std::make_shared<CRefEdge>();
+  edge->startPoint = {x * scale, 0, 0};
+  edge->midPoint = {(x + 2.5) * scale, 0, 0};
+  edge->endPoint = {(x + 5) * scale, 0, 0};
+  fillet->references.push_back(edge);
+  return fillet;
+}
+
+/// 追加 count 个圆角：ID 为 prefix + 序号，半径 radius + i，边起点 x = spacing * i。
+void AddEdgeFillets(UnifiedModel &model, int count, const std::string &prefix = "F-",
+                    double radius = 1.0, double spacing = 10.0) {
+  for (int i = 0; i < count; ++i) {
+    model.AddFeature(MakeEdgeFillet(prefix + std::to_string(i), radius + i,
+                                    spacing * i, 1.0));
+  }
+}
+
+void TestMatchModelsPairsReexports() {
+  constexpr int kCount = 200;
+  UnifiedModel sw(UnitType::MILLIMETER, "sw");
+  UnifiedModel creo(UnitType::METER, "creo");
+  for (int i = 0; i < kCount; ++i) {
+    sw.AddFeature(MakeEdgeFillet("SW-" + std::to_string(i), 1 + 0.5 * i,
+                                 10.0 * i, 1.0));
+  }
+  for (int i = kCount - 1; i >= 0; --i) {
+    creo.AddFeature(MakeEdgeFillet("CREO-" + std::to_string(i), 1 + 0.5 * i,
+                                   10.0 * i, 1e-3));
+  }
+
+  auto chamfer = [](const std::string &id, double distance, double scale) {
+    auto feature = std::make_shared<CChamfer>();
+    feature->featureID = id;
+    feature->mode = ChamferMode::EQUAL_DISTANCE;
+    feature->params.distance1 = distance * scale;
+    auto face = std::make_shared<CRefFace>();
+    face->centroid = {0, 50 * scale, 0};
+    face->normal = {0, 1, 0};
+    feature->references.push_back(face);
+    return feature;
+  };
+  sw.AddFeature(chamfer("SW-CHAMFER", 5.0, 1.0));
+  creo.AddFeature(chamfer("CREO-CHAMFER", 5.3, 1e-3));
+  auto shell = std::make_shared<CShell>();
+  shell->featureID = "SW-SHELL";
+  shell->thickness = 2.0;
+  sw.AddFeature(shell);
+
+  Geometry::ModelCorrespondence map;
+  std::string error;
+  Expect(Geometry::MatchModels(sw, creo, map, {}, &error), error);
+  Expect(map.matches.size() == kCount + 1 && map.unmatchedA.size() == 1 &&
+             map.unmatchedA[0] == "SW-SHELL" && map.unmatchedB.empty(),
+         "Every re-exported feature should be paired exactly once.");
+  for (int i = 0; i < kCount; ++i) {
+    const auto *match = map.FindByA("SW-" + std::to_string(i));
+    if (!match || match->featureB != "CREO-" + std::to_string(i) ||
+        match->stage != Geometry::MatchStage::ExactSignature ||
+        match->confidence < 0.9) {
+      Fail("Fillet SW-" + std::to_string(i) + " paired incorrectly.");
+    }
+  }
+  const auto *perturbed = map.FindByB("CREO-CHAMFER");
+  Expect(perturbed && perturbed->featureA == "SW-CHAMFER" &&
+             perturbed->stage == Geometry::MatchStage::Proximity &&
+             perturbed->score < 0.9 && perturbed->score > 0.5,
+         "Perturbed parameters should fall back to scored proximity.");
+  Expect(map.matches.front().featureA == "SW-0",
+         "Matches should follow model A order.");
+}
+
+
+void AddLine(CSketch &sketch, double x0, double y0, double x1, double y1,
+             bool construction = false) {
+  auto line = std::make_shared<CSketchLine>();
+  line->localID = "L_" + std::to_string(sketch.segments.size());
+  line->startPos = {x0, y0, 0};
+  line->endPos = {x1, y1, 0};
+  line->isConstruction = construction;
+  sketch.segments.push_back(line);
+}
+
+void AddArc(CSketch &sketch, double cx, double cy, double r, double a0,
+            double a1) {
+  auto arc = std::make_shared<CSketchArc>();
+  arc->localID = "A_" + std::to_string(sketch.segments.size());
+  arc->center = {cx, cy, 0};
+  arc->radius = r;
+  arc->startAngle = a0;
+  arc->endAngle = a1;
+  sketch.segments.push_back(arc);
+}
+
+void AddCircle(CSketch &sketch, double cx, double cy, double r) {
+  auto circle = std::make_shared<CSketchCircle>();
+  circle->localID = "C_" + std::to_string(sketch.segments.size());
+  circle->center = {cx, cy, 0};
+  circle->radius = r;
+  sketch.segments.push_back(circle);
+}
+
+void TestSketchLoopExtractorNesting() {
+  CSketch sketch;
+  AddLine(sketch, 0, 0, 100, 0);
+  AddLine(sketch, 100, 60, 100.0001, 0.0001); // 反向且带容差内偏差
+  AddLine(sketch, 100, 60, 0, 60);
+  AddLine(sketch, 0, 60, 0, 0);
+  AddCircle(sketch, 20, 20, 5);
+  AddLine(sketch, 50, 26, 60, 26);           // 长圆孔
+  AddArc(sketch, 60, 30, 4, -GeoUtils::PI / 2, GeoUtils::PI / 2);
+  AddLine(sketch, 60, 34, 50, 34);
+  AddArc(sketch, 50, 30, 4, GeoUtils::PI / 2, 3 * GeoUtils::PI / 2);
+  AddCircle(sketch, 75, 30, 10);
+  AddCircle(sketch, 75, 30, 3);              // 孔中岛
+  AddLine(sketch, -20, 30, 120, 30, true);   // 构造线
+  AddLine(sketch, 0, 0, -10, -10);           // 悬挂段
+  auto point = std::make_shared<CSketchPoint>();
+  sketch.segments.push_back(point);
+
+  Geometry::SketchLoopExtractor extractor(UnitType::MILLIMETER);
+  auto result = extractor.Extract(sketch);
+  Expect(result->loops.size() == 5, "Expected outer, three holes and an island.");
+  Expect(result->danglingSegments == std::vector<std::size_t>{12},
+         "Only the open segment should be dangling.");
+
+  const auto &outer = result->loops[0];
+  Expect(outer.depth == 0 && outer.parent == -1 && outer.edges.size() == 4 &&
+             Near(outer.signedArea, 6000.0, 1e-2) &&
+             NearPoint(outer.boxMax, 100.0001, 60, 0),
+         "The rectangle should be the counter-clockwise outer loop.");
+  int holes = 0;
+  for (std::size_t i = 1; i < result->loops.size(); ++i) {
+    const auto &loop = result->loops[i];
+    if (loop.depth == 1) {
+      ++holes;
+      Expect(loop.parent == 0 && !loop.IsCounterClockwise(),
+             "Holes should be clockwise children of the outer loop.");
+    }
+    if (loop.edges.size() == 4) {
+      Expect(Near(loop.signedArea, -(80 + 16 * GeoUtils::PI), 1e-6),
+             "Slot area should include both arc segments.");
+    }
+  }
+  const auto &island = result->loops.back();
+  Expect(holes == 3 && island.depth == 2 && island.IsOuter() &&
+             island.IsCounterClockwise() &&
+             result->loops[island.parent].edges[0].segment == 9,
+         "The island should nest inside the large hole.");
+
+  Expect(extractor.Extract(sketch) == result && extractor.CacheSize() == 1,
+         "Repeated extraction should hit the cache.");
+  static_cast<CSketchCircle &>(*sketch.segments[10]).radius = 2;
+  Expect(extractor.Extract(sketch) != result && extractor.CacheSize() == 2,
+         "Editing a segment should invalidate the cached loops.");
+
+  CSketch split;
+  AddLine(split, 0, 0, 5, 0);
+  AddLine(split, 5, 0, 10, 0);
+  AddLine(split, 10, 0, 10, 10);
+  AddLine(split, 10, 10, 5, 10);
+  AddLine(split, 5, 10, 0, 10);
+  AddLine(split, 0, 10, 0, 0);
+  AddLine(split, 5, 0, 5, 10);
+  auto regions = Geometry::SketchLoopExtractor::Compute(split, 1e-6);
+  Expect(regions.loops.size() == 2 && regions.danglingSegments.empty(),
+         "A dividing line should produce two regions.");
+  for (const auto &loop : regions.loops) {
+    Expect(loop.depth == 0 && Near(loop.signedArea, 50.0) &&
+               loop.edges.size() == 4,
+           "Both regions should be counter-clockwise outer loops.");
+    for (std::size_t k = 0; k < loop.edges.size(); ++k) {
+      const auto &a = static_cast<const CSketchLine &>(
+          *split.segments[loop.edges[k].segment]);
+      const auto &b = static_cast<const CSketchLine &>(
+          *split.segments[loop.edges[(k + 1) % loop.edges.size()].segment]);
+      const CPoint3D tail = loop.edges[k].reversed ? a.startPos : a.endPos;
+      const CPoint3D next = loop.edges[(k + 1) % loop.edges.size()].reversed
+                                ? b.endPos
+                                : b.startPos;
+      Expect(tail == next, "Loop edges should connect head to tail.");
+    }
+  }
+}
+
+void AddConstraint(CSketch &sketch, CSketchConstraint::ConstraintType type,
+                   std::vector<SketchConstraintRef> refs,
+                   std::optional<double> value = std::nullopt) {
+  CSketchConstraint constraint;
+  constraint.type = type;
+  constraint.refs = std::move(refs);
+  constraint.value = value;
+  sketch.constraints.push_back(std::move(constraint));
+}
+
+void TestConstraintCheckerResiduals() {
+  using Type = CSketchConstraint::ConstraintType;
+  using Sub = SketchConstraintSubEntity;
+  auto ref = [](const std::string &id, Sub sub = Sub::Whole) {
+    return SketchConstraintRef::ForSketchEntity(id, sub);
+  };
+
+  auto sketch = std::make_shared<CSketch>();
+  sketch->featureID = "SKETCH-CC";
+  AddLine(*sketch, 0, 0, 10, 0);                // L_0
+  AddLine(*sketch, 10, 0, 10, 5);               // L_1
+  AddArc(*sketch, 10, 8, 3, -GeoUtils::PI / 2, GeoUtils::PI / 2); // A_2：起点 (10,5)
+  AddCircle(*sketch, 30, 4, 4);                 // C_3
+  AddLine(*sketch, 0, 4, 20, 4.5);              // L_4：略微倾斜
+
+  AddConstraint(*sketch, Type::COINCIDENT,
+                {ref("L_0", Sub::End), ref("L_1", Sub::Start)});
+  AddConstraint(*sketch, Type::COINCIDENT,
+                {ref("L_1", Sub::End), ref("A_2", Sub::Start)});
+  AddConstraint(*sketch, Type::HORIZONTAL, {ref("L_0")});
+  AddConstraint(*sketch, Type::PERPENDICULAR, {ref("L_0"), ref("L_1")});
+  AddConstraint(*sketch, Type::TANGENT, {ref("L_0"), ref("C_3")});
+  AddConstraint(*sketch, Type::DISTANCE, {ref("L_0")}, 10.0);
+  AddConstraint(*sketch, Type::RADIUS, {ref("A_2")}, 3.0);
+  AddConstraint(*sketch, Type::MIDPOINT,
+                {ref("L_0", Sub::Midpoint), ref("L_0")});
+  // 以下三条违反约束
+  AddConstraint(*sketch, Type::PARALLEL, {ref("L_0"), ref("L_4")}); // [8]
+  AddConstraint(*sketch, Type::DIAMETER, {ref("C_3")}, 9.0);        // [9]
+  AddConstraint(*sketch, Type::EQUAL, {ref("L_1"), ref("L_0")});    // [10]
+  // 无法解析与不检查
+  AddConstraint(*sketch, Type::VERTICAL, {ref("L_99")});            // [11]
+  AddConstraint(*sketch, Type::COINCIDENT,
+                {ref("L_0", Sub::Start),
+                 SketchConstraintRef::ForExternalReference(
+                     std::make_shared<CRefVertex>())});
+  AddConstraint(*sketch, Type::FIXED, {ref("L_0")});
+
+  UnifiedModel model(UnitType::MILLIMETER, "constraints");
+  model.AddFeature(sketch);
+  ConstraintCheckReport report;
+  std::string error;
+  Expect(ConstraintChecker::Check(model, report, {}, &error),
+         "Constraint check should succeed: " + error);
+  Expect(report.checkedCount == 11 && report.satisfiedCount == 8 &&
+             report.uncheckedCount == 2,
+         "Eleven constraints should be evaluated and eight satisfied.");
+  Expect(report.ViolationCount() == 3 && report.diagnostics.size() == 4,
+         "Three violations and one unresolved constraint expected.");
+
+  std::set<std::size_t> violated;
+  for (const auto &d : report.diagnostics) {
+    Expect(d.sketchID == "SKETCH-CC", "Diagnostics should name the sketch.");
+    if (d.status == ConstraintCheckStatus::Violated) {
+      violated.insert(d.constraintIndex);
+    } else {
+      Expect(d.status == ConstraintCheckStatus::Unresolved &&
+                 d.constraintIndex == 11,
+             "A missing localID should be reported as unresolved.");
+    }
+    if (d.constraintIndex == 8) {
+      Expect(d.angular && Near(d.residual, std::atan2(0.5, 20.0), 1e-9),
+             "PARALLEL residual should be the angle between the lines.");
+    } else if (d.constraintIndex == 9) {
+      Expect(!d.angular && Near(d.residual, 1.0) && Near(d.tolerance, 0.02),
+             "DIAMETER residual should use the millimetre tolerance.");
+    }
+  }
+  Expect(violated == std::set<std::size_t>{8, 9, 10},
+         "PARALLEL, DIAMETER and EQUAL should be violated.");
+
+  ValidationReport validation;
+  report.AppendTo(validation);
+  Expect(validation.warnings.size() == 4 &&
+             validation.warnings.front().rfind("[SKETCH_009]", 0) == 0,
+         "AppendTo should emit SKETCH_008/SKETCH_009 warnings.");
+
+  ConstraintCheckOptions options;
+  options.reportUnchecked = true;
+  options.angleTolerance = 0.1;
+  const auto loose = ConstraintChecker::Check(*sketch, options);
+  Expect(loose.ViolationCount() == 2 && loose.diagnostics.size() == 5,
+         "Looser angle tolerance should accept PARALLEL and list unchecked.");
+}
+
+std::shared_ptr<CDatumPlane>
+MakeDatumPlane(const std::string &id, PlaneMethod method,
+               std::vector<std::shared_ptr<CRefEntityBase>> refs,
+               std::vector<PlaneConstraint> constraints) {
+  auto plane = std::make_shared<CDatumPlane>();
+  plane->featureID = id;
+  plane->method = method;
+  plane->referenceEntities = std::move(refs);
+  plane->constraints = std::move(constraints);
+  return plane;
+}
+
+void TestDatumPlaneEvaluatorChain() {
+  using Builder::PlaneConstraintBuilder;
+  using Builder::Ref;
+  constexpr double kPi = 3.14159265358979323846;
+
+  auto axis = std::make_shared<CRefEdge>();
+  axis->parentFeatureID = "BODY";
+  axis->startPoint = {0, 0, 15};
+  axis->endPoint = {10, 0, 15};
+  auto vertex = [](double x, double y, double z) {
+    auto v = std::make_shared<CRefVertex>();
+    v->parentFeatureID = "BODY";
+    v->pos = {x, y, z};
+    return std::shared_ptr<CRefEntityBase>(v);
+  };
+
+  UnifiedModel model(UnitType::MILLIMETER, "datums");
+  auto p1 = MakeDatumPlane("P1", PlaneMethod::OFFSET, {Ref::XY().Build()},
+                           {PlaneConstraintBuilder::Distance(0, 10.0)});
+  auto p2 = MakeDatumPlane("P2", PlaneMethod::OFFSET, {Ref::Plane("P1").Build()},
+                           {PlaneConstraintBuilder::Distance(0, 5.0)});
+  p2->normal = CVector3D{0, 0, 1};
+  p2->projectedOrigin = CPoint3D{0, 0, 15};
+  auto p3 = MakeDatumPlane("P3", PlaneMethod::ANGLE,
+                           {Ref::Plane("P2").Build(), axis},
+                           {PlaneConstraintBuilder::Angle(0, kPi / 2),
+                            PlaneConstraintBuilder::Coincident(1)});
+  p3->normal = CVector3D{0, 1, 0}; // 同一平面，朝向相反
+  p3->projectedOrigin = CPoint3D{0, 0, 0};
+  auto p4 = MakeDatumPlane("P4", PlaneMethod::MID_PLANE,
+                           {Ref::Plane("P1").Build(), Ref::Plane("P2").Build()},
+                           {PlaneConstraintBuilder::Symmetric(0),
+                            PlaneConstraintBuilder::Symmetric(1)});
+  p4->normal = CVector3D{0, 0, 1};
+  p4->projectedOrigin = CPoint3D{0, 0, 12.0}; // 实际为 12.5
+  auto p5 = MakeDatumPlane(
+      "P5", PlaneMethod::THREE_POINTS,
+      {vertex(0, 0, 3), vertex(1, 0, 3), vertex(0, 1, 3)},
+      {PlaneConstraintBuilder::Coincident(0), PlaneConstraintBuilder::Coincident(1),
+       PlaneConstraintBuilder::Coincident(2)});
+  auto fixed = MakeDatumPlane("FIXED", PlaneMethod::FIXED, {Ref::XY().Build()},
+                              {PlaneConstraintBuilder::Coincident(0)});
+  fixed->normal = CVector3D{1, 0, 0};
+  fixed->projectedOrigin = CPoint3D{7, 0, 0};
+  model.AddFeatures({p1, p2, p3, p4, p5, fixed});
+
+  Geometry::DatumPlaneEvaluator evaluator(model);
+  const auto results = evaluator.EvaluateAll();
+  Expect(results.size() == 6 && evaluator.ComputeCount() == 6,
+         "Each datum plane should be computed exactly once.");
+  Expect(results[1].status == Geometry::DatumPlaneStatus::Evaluated &&
+             NearPoint(results[1].csys.origin, 0, 0, 15) &&
+             NearVector(results[1].csys.zDir, 0, 0, 1) &&
+             results[1].hasStored && results[1].agreesWithStored,
+         "Offset-of-offset should land at z=15 and agree with stored values.");
+  Expect(NearVector(results[2].csys.zDir, 0, -1, 0) &&
+             NearPoint(results[2].csys.origin, 0, 0, 0) &&
+             NearVector(results[2].csys.xDir, 1, 0, 0) &&
+             results[2].agreesWithStored && results[2].normalFlipped,
+         "Angle plane should rotate the upstream normal about the axis.");
+  Expect(NearPoint(results[3].csys.origin, 0, 0, 12.5) &&
+             !results[3].agreesWithStored &&
+             Near(results[3].originDeviation, 0.5),
+         "Mid plane should be flagged against its stale stored origin.");
+  Expect(NearPoint(results[4].csys.origin, 0, 0, 3) && !results[4].hasStored,
+         "Three-point plane should pass through its vertices.");
+  Expect(results[5].status == Geometry::DatumPlaneStatus::FromStored &&
+             NearPoint(results[5].csys.origin, 7, 0, 0),
+         "FIXED plane should fall back to stored values.");
+  const auto disagreements = evaluator.Disagreements();
+  Expect(disagreements.size() == 1 && disagreements[0].featureID == "P4" &&
+             evaluator.ComputeCount() == 6,
+         "Disagreements should reuse memoised results.");
+
+  // 上游原地修改：只重算其下游。
+  p1->constraints[0].value = 20.0;
+  Expect(evaluator.Invalidate("P1") == 4 && evaluator.IsCached("P5") &&
+             evaluator.IsCached("FIXED") && !evaluator.IsCached("P3"),
+         "Invalidate should clear the plane and its dependents only.");
+  const auto p2Again = evaluator.Evaluate("P2");
+  Expect(NearPoint(p2Again.csys.origin, 0, 0, 25) && !p2Again.agreesWithStored &&
+             evaluator.ComputeCount() == 8,
+         "Recomputing P2 should reevaluate P1 once and flag the stale value.");
+  evaluator.EvaluateAll();
+  Expect(evaluator.ComputeCount() == 10,
+         "Remaining dependents should be recomputed on the next pass.");
+
+  UnifiedModel cyclic(UnitType::MILLIMETER, "cycle");
+  cyclic.AddFeatures(
+      {MakeDatumPlane("C1", PlaneMethod::OFFSET, {Ref::Plane("C2").Build()},
+                      {PlaneConstraintBuilder::Distance(0, 1.0)}),
+       MakeDatumPlane("C2", PlaneMethod::OFFSET, {Ref::Plane("C1").Build()},
+                      {PlaneConstraintBuilder::Distance(0, 1.0)})});
+  Geometry::DatumPlaneEvaluator cycleEvaluator(cyclic);
+  for (const auto &result : cycleEvaluator.EvaluateAll()) {
+    Expect(result.status == Geometry::DatumPlaneStatus::Cyclic,
+           "Mutually dependent planes should be reported as cyclic.");
+  }
+}
+
+void TestFeatureBoundsTreeQueries() {
+  using Geometry::BoundingBox;
+  constexpr double kPi = 3.14159265358979323846;
+  auto nearBox = [](const BoundingBox &box, CPoint3D min, CPoint3D max) {
+    return NearPoint(box.min, min.x, min.y, min.z) &&
+           NearPoint(box.max, max.x, max.y, max.z);
+  };
+
+  auto rect = std::make_shared<CSketch>();
+  rect->featureID = "S-RECT";
+  rect->sketchCSys = {{0, 0, 10}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}, true};
+  AddLine(*rect, 0, 0, 4, 0);
+  AddLine(*rect, 4, 0, 4, 2);
+  AddLine(*rect, 4, 2, 0, 2);
+  AddLine(*rect, 0, 2, 0, 0);
+  AddLine(*rect, -50, -50, 50, 50, true); // 构造线不计入
+
+  auto extrude = std::make_shared<CExtrude>();
+  extrude->featureID = "E-RECT";
+  extrude->profileSketchID = "S-RECT";
+  extrude->extent1.type = SweepExtent::Type::VALUE;
+  extrude->extent1.value = 5.0;
+
+  auto circle = std::make_shared<CSketch>();
+  circle->featureID = "S-CIRCLE";
+  circle->sketchCSys = {{100, 0, 0}, {0, 1, 0}, {0, 0, 1}, {1, 0, 0}, true};
+  AddCircle(*circle, 0, 0, 3);
+
+  auto arc = std::make_shared<CSketch>();
+  arc->featureID = "S-ARC";
+  AddArc(*arc, 0, 0, 1, -kPi / 4, kPi / 4);
+
+  auto pattern = std::make_shared<CLinearPattern>();
+  pattern->featureID = "LP-RECT";
+  pattern->dir1.direction = {1, 0, 0};
+  pattern->dir1.spacing = 10.0;
+  pattern->dir1.count = 3;
+  auto seed = std::make_shared<CRefFeature>();
+  seed->targetFeatureID = "E-RECT";
+  pattern->seedObjects.push_back(seed);
+
+  UnifiedModel model(UnitType::MILLIMETER, "bounds");
+  model.AddFeatures({rect, extrude, circle, arc, pattern});
+  Geometry::FeatureBoundsTree tree(model);
+  Expect(tree.FeatureCount() == 5 && tree.ComputeCount() == 5,
+         "Every feature should be bounded in one pass.");
+  Expect(nearBox(*tree.GetBounds("S-RECT"), {0, 0, 10}, {4, 2, 10}),
+         "Sketch bounds should map segments through the sketch CSys.");
+  Expect(nearBox(*tree.GetBounds("E-RECT"), {0, 0, 10}, {4, 2, 15}),
+         "Extrude bounds should sweep the profile by its depth.");
+  Expect(nearBox(*tree.GetBounds("S-CIRCLE"), {100, -3, -3}, {100, 3, 3}),
+         "Circle bounds should use exact axis extremes in the YZ plane.");
+  const double h = std::sqrt(0.5);
+  Expect(nearBox(*tree.GetBounds("S-ARC"), {h, -h, 0}, {1, h, 0}),
+         "Arc bounds should include the in-sweep extreme at angle 0.");
+  Expect(nearBox(*tree.GetBounds("LP-RECT"), {0, 0, 10}, {24, 2, 15}),
+         "Pattern bounds should cover every instance of the seed.");
+
+  BoundingBox region;
+  region.Expand(CPoint3D{-1, -1, 9});
+  region.Expand(CPoint3D{5, 3, 16});
+  const auto contained = tree.QueryContained(region);
+  Expect(contained.size() == 2 && contained[0].featureID == "S-RECT" &&
+             contained[1].featureID == "E-RECT",
+         "Containment should return the sketch and its extrude in model order.");
+  Expect(tree.QueryOverlap(region).size() == 3,
+         "Overlap should also report the pattern.");
+  const auto containing = tree.QueryContaining(CPoint3D{100, 0, 2});
+  Expect(containing.size() == 1 && containing[0].featureID == "S-CIRCLE",
+         "Point containment should find the circle sketch.");
+  const auto nearby = tree.QueryNear(CPoint3D{0, 0, 0}, 10.5);
+  Expect(nearby.size() == 4 && nearby[0].featureID == "S-ARC" &&
+             Near(nearby[0].distance, h) && Near(nearby.back().distance, 10.0),
+         "Near queries should sort by box distance.");
+
+  // 原地修改拉伸深度：只重算拉伸与依赖它的阵列。
+  extrude->extent1.value = 8.0;
+  Expect(tree.Update(model) == 2 && tree.ComputeCount() == 7,
+         "Only the changed extrude and its pattern should be recomputed.");
+  Expect(nearBox(*tree.GetBounds("LP-RECT"), {0, 0, 10}, {24, 2, 18}) &&
+             tree.QueryContained(region).size() == 1,
+         "Updated bounds should be visible to queries.");
+  Expect(tree.Update(model) == 0, "An unchanged model should not recompute.");
+
+  model.AddFeature(MakeFaceGridFeature("F-GRID"));
+  Expect(tree.Update(model) == 1 && tree.FeatureCount() == 6,
+         "Appended features should be bounded incrementally.");
+  model.Clear();
+  model.AddFeatures({rect, circle});
+  Expect(tree.Update(model) == 0 && tree.FeatureCount() == 2 &&
+             !tree.GetBounds("E-RECT") && tree.QueryOverlap(region).size() == 1,
+         "Removed features should drop out of queries.");
+}
+
+void TestSketchProjectionRoundTrip() {
+  using Role = SketchConstraintSubEntity;
+  constexpr double kPi = 3.14159265358979323846;
+  CSketch sketch;
+  sketch.sketchCSys = {{10, 20, 30}, {0, 2, 0}, {0, 0, 1}, {1, 0, 0}, true};
+  AddLine(sketch, 1, 2, 3, 4);
+  AddArc(sketch, 0, 0, 2, 0, kPi / 2);
+  AddCircle(sketch, 5, 0, 1);
+  auto point = std::make_shared<CSketchPoint>();
+  point->position = {0, -1, 0};
+  sketch.segments.push_back(point);
+
+  Geometry::SketchWorldPoints world;
+  Geometry::ProjectSketchToWorld(sketch, world);
+  Expect(world.Size() == 7, "sketch projection should emit 2 + 3 + 1 + 1 points");
+  Expect(world.segmentOffsets == std::vector<std::uint32_t>{0, 2, 5, 6, 7},
+         "sketch projection should record per-segment offsets");
+  Expect(world.roles[2] == Role::Center && world.roles[3] == Role::Start &&
+             world.roles[4] == Role::End && world.roles[6] == Role::Whole,
+         "sketch projection should tag arc center/start/end and point roles");
+  Expect(world.segmentIndex[5] == 2, "circle center should belong to segment 2");
+  Expect(NearPoint(world.points.PointAt(0), 10, 21, 32) &&
+             NearPoint(world.points.PointAt(1), 10, 23, 34),
+         "line endpoints should map through the normalised sketch CSys");
+  Expect(NearPoint(world.points.PointAt(2), 10, 20, 30) &&
+             NearPoint(world.points.PointAt(3), 10, 22, 30) &&
+             NearPoint(world.points.PointAt(4), 10, 20, 32),
+         "arc center and angle endpoints should map to world");
+  Expect(NearPoint(world.points.PointAt(5), 10, 25, 30) &&
+             NearPoint(world.points.PointAt(6), 10, 20, 29),
+         "circle center and sketch point should map to world");
+  Expect(!world.chiralityFlipped, "right-handed sketch CSys should keep chirality");
+
+  CPointBlock local;
+  Geometry::ProjectWorldToSketch(sketch.sketchCSys, world.points, local);
+  Expect(local.Size() == world.Size() && NearPoint(local.PointAt(0), 1, 2, 0) &&
+             NearPoint(local.PointAt(3), 2, 0, 0) &&
+             NearPoint(local.PointAt(6), 0, -1, 0),
+         "inverse projection should recover sketch-local coordinates");
+
+  sketch.sketchCSys.zDir = {-1, 0, 0};
+  Geometry::ProjectSketchToWorld(sketch, world);
+  Expect(world.Size() == 7 && world.chiralityFlipped &&
+             NearPoint(world.points.PointAt(3), 10, 22, 30),
+         "left-handed sketch CSys should flag chirality without moving in-plane points");
+
+  sketch.sketchCSys.valid = false;
+  Geometry::ProjectSketchToWorld(sketch, world);
+  Expect(NearPoint(world.points.PointAt(1), 3, 4, 0),
+         "invalid sketch CSys should project as identity");
+}
+
+std::shared_ptr<CRefEdge> MakeRefEdge(CPoint3D start, CPoint3D mid, CPoint3D end,
+                                      CGeoCurveType type = CGeoCurveType::LINE) {
+  auto edge = std::make_shared<CRefEdge>();
+  edge->startPoint = start;
+  edge->midPoint = mid;
+  edge->endPoint = end;
+  edge->curveType = type;
+  return edge;
+}
+
+void TestEdgeChainBuilderOrdering() {
+  using Geometry::EdgeChainBuilder;
+  const double s = std::sqrt(0.5);
+
+  // 扫掠路径：直线 → 相切四分之一圆弧 → 直线（乱序且末段反向给出）。
+  CSweep sweep;
+  sweep.featureID = "SW-CHAIN";
+  sweep.path.references = {
+      MakeRefEdge({15, 20, 0}, {15, 12.5, 0}, {15, 5, 0}),
+      MakeRefEdge({0, 0, 0}, {5, 0, 0}, {10, 0, 0}),
+      MakeRefEdge({10, 0, 0}, {10 + 5 * s, 5 - 5 * s, 0}, {15, 5, 0},
+                  CGeoCurveType::CIRCLE)};
+
+  const auto unordered =
+      EdgeChainBuilder::Compute(sweep.path.references, 1e-6, 1e-3);
+  Expect(unordered.IsSingleChain() && unordered.chains[0].edges.size() == 3,
+         "tangent path should link into one chain");
+  Expect(NearPoint(unordered.chains[0].start, 15, 20, 0),
+         "chain should start at the first free end encountered");
+
+  sweep.path.startPoint = CPoint3D{0, 0, 0};
+  EdgeChainBuilder builder(1e-6, 1e-3, 0.5);
+  const auto path = builder.Build(sweep);
+  const auto &chain = path->chains.at(0);
+  Expect(chain.edges[0].reference == 1 && !chain.edges[0].reversed &&
+             chain.edges[1].reference == 2 && !chain.edges[1].reversed &&
+             chain.edges[2].reference == 0 && chain.edges[2].reversed,
+         "sweep path should be oriented from path.startPoint");
+  Expect(NearPoint(chain.start, 0, 0, 0) && NearPoint(chain.end, 15, 20, 0) &&
+             !chain.closed,
+         "oriented chain should report its endpoints");
+  Expect(chain.joints.size() == 2 && chain.tangentContinuous &&
+             chain.maxTurnAngle < 1e-6,
+         "line/arc/line joints should be tangent continuous");
+  Expect(builder.Build(sweep) == path && builder.CacheSize() == 1,
+         "unchanged sweep path should hit the per-feature cache");
+
+  std::static_pointer_cast<CRefEdge>(sweep.path.references[0])->startPoint = {20, 20, 0};
+  const auto bent = builder.Build(sweep);
+  Expect(bent != path && !bent->chains[0].tangentContinuous &&
+             Near(bent->chains[0].joints[1], std::atan2(5.0, 15.0), 1e-9),
+         "edited edge geometry should recompute and expose the corner angle");
+
+  // 圆角边集：闭合方框、T 形分叉、带缝隙的两段与非边引用。
+  CFillet fillet;
+  fillet.featureID = "F-CHAIN";
+  auto line = [](double x0, double y0, double x1, double y1) {
+    return MakeRefEdge({x0, y0, 0}, {(x0 + x1) / 2, (y0 + y1) / 2, 0},
+                       {x1, y1, 0});
+  };
+  fillet.references = {line(0, 0, 10, 0),   line(10, 0, 10, 10),
+                       line(0, 10, 10, 10), line(0, 0, 0, 10),
+                       line(50, 0, 60, 0),  line(60, 0, 70, 0),
+                       line(60, 0, 60, 10), line(100, 0, 110, 0),
+                       line(110.1, 0, 120, 0),
+                       std::make_shared<CRefVertex>()};
+  const auto edges = builder.Build(fillet);
+  Expect(edges->skippedReferences == std::vector<std::size_t>{9},
+         "non-edge references should be skipped");
+  Expect(edges->branches.size() == 1 && edges->branches[0].edgeCount == 3 &&
+             NearPoint(edges->branches[0].point, 60, 0, 0),
+         "T junction should be reported as a branch");
+  Expect(edges->chains.size() == 6, "box + three T arms + two gapped segments");
+  std::size_t closedCount = 0;
+  for (const auto &c : edges->chains) {
+    if (c.closed) {
+      ++closedCount;
+      Expect(c.edges.size() == 4 && c.joints.size() == 4 &&
+                 Near(c.maxTurnAngle, std::acos(0.0), 1e-9) &&
+                 !c.tangentContinuous,
+             "closed box chain should report four right-angle joints");
+    }
+  }
+  Expect(closedCount == 1, "only the box should form a closed chain");
+  Expect(edges->gaps.size() == 1 && Near(edges->gaps[0].distance, 0.1, 1e-9),
+         "near-miss segment ends should be reported as a gap");
+  Expect(builder.CacheSize() == 2, "fillet should get its own cache entry");
+}
+
+void TestCerealJsonStreamingRoundTrip() {
+  UnifiedModel model(UnitType::MILLIMETER, "json-roundtrip");
+  auto sketch = std::make_shared<CSketch>();
+  sketch->featureID = "SK-1";
+  sketch->featureName = "Sketch1";
+  sketch->sketchCSys = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}, true};
+  AddLine(*sketch, 0, 0, 10, 0);
+  AddCircle(*sketch, 5, 5, 2);
+  model.AddFeature(sketch);
+  AddEdgeFillets(model, 8);
+
+  const auto dir = std::filesystem::path("tmp");
+  std::filesystem::create_directories(dir);
+  const auto first = dir / "cadexchange_stream_first.json";
+  const auto second = dir / "cadexchange_stream_second.json";
+  std::string error;
+  const bool saved =
+      SaveModel(model, first, &error, SerializationFormat::CEREAL_JSON);
+  Expect(saved, "Saving CEREAL_JSON should succeed: " + error);
+
+  UnifiedModel loaded;
+  const bool reloaded =
+      LoadModel(loaded, first, &error, SerializationFormat::CEREAL_JSON);
+  Expect(reloaded, "Loading CEREAL_JSON should succeed: " + error);
+  Expect(loaded.GetFeatures().size() == model.GetFeatures().size() &&
+             loaded.unit == UnitType::MILLIMETER,
+         "Streaming load should restore every feature and the unit.");
+  const bool resaved =
+      SaveModel(loaded, second, &error, SerializationFormat::CEREAL_JSON);
+  Expect(resaved, "Re-saving CEREAL_JSON should succeed: " + error);
+
+  auto slurp = [](const std::filesystem::path &path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), {});
+  };
+  const std::string json = slurp(first);
+  Expect(json == slurp(second), "Streaming load should round-trip byte-for-byte.");
+
+  // 多态类型名每个文件只解析一次：9 个特征只涉及 CSketch/CFillet 等少数类型。
+  {
+    std::istringstream in(json);
+    JsonStreamInputArchive archive(in);
+    UnifiedModel direct;
+    load(archive, direct);
+    Expect(direct.GetFeatures().size() == 9 && archive.ResolvedTypeCount() > 0 &&
+               archive.ResolvedTypeCount() < 9,
+           "Polymorphic bindings should be resolved once per type, not per object.");
+  }
+
+  // 未知成员被跳过，保持向前兼容。
+  std::string extended = json;
+  extended.insert(extended.find('{', 1) + 1,
+                  "\"futureField\":{\"nested\":[1,2,{\"x\":true}]},");
+  {
+    std::istringstream in(extended);
+    JsonStreamInputArchive archive(in);
+    UnifiedModel tolerant;
+    load(archive, tolerant);
+    Expect(tolerant.GetFeatures().size() == 9,
+           "Unknown JSON members should be skipped by the streaming reader.");
+  }
+
+  {
+    std::ofstream out(first, std::ios::binary | std::ios::trunc);
+    out << json.substr(0, json.size() / 2);
+  }
+  UnifiedModel truncated;
+  error.clear();
+  Expect(!LoadModel(truncated, first, &error, SerializationFormat::CEREAL_JSON) &&
+             !error.empty(),
+         "Truncated JSON should fail with an error message.");
+  std::filesystem::remove(first);
+  std::filesystem::remove(second);
+}
+
+void TestInMemorySerializationBuffers() {
+  UnifiedModel model(UnitType::MILLIMETER, "buffer-roundtrip");
+  AddEdgeFillets(model, 4);
+
+  const auto dir = std::filesystem::path("tmp");
+  std::filesystem::create_directories(dir);
+  const auto xmlPath = dir / "cadexchange_buffer.xml";
+  std::string error;
+  const bool savedFile =
+      SaveModel(model, xmlPath, &error, SerializationFormat::TINYXML);
+  Expect(savedFile, "Saving TINYXML file should succeed: " + error);
+  std::ifstream fileIn(xmlPath, std::ios::binary);
+  const std::string fromFile{std::istreambuf_iterator<char>(fileIn), {}};
+  fileIn.close();
+  std::filesystem::remove(xmlPath);
+
+  std::string buffer;
+  const bool savedBuffer =
+      SaveModelToBuffer(model, buffer, &error, SerializationFormat::TINYXML);
+  Expect(savedBuffer && buffer == fromFile,
+         "SaveModelToBuffer should produce the same XML as the file path.");
+  std::ostringstream streamed;
+  const bool savedStream =
+      SaveModel(model, streamed, &error, SerializationFormat::TINYXML);
+  Expect(savedStream && streamed.str() == fromFile,
+         "SaveModel(ostream) should produce the same XML as the file path.");
+
+  const auto capacity = buffer.capacity();
+  const char *storage = buffer.data();
+  const bool resaved =
+      SaveModelToBuffer(model, buffer, &error, SerializationFormat::TINYXML);
+  Expect(resaved && buffer.capacity() == capacity && buffer.data() == storage &&
+             buffer == fromFile,
+         "SaveModelToBuffer should reuse the caller's buffer capacity.");
+
+  UnifiedModel fromBuffer;
+  const bool loadedBuffer = LoadModelFromBuffer(fromBuffer, buffer, &error,
+                                                SerializationFormat::TINYXML);
+  Expect(loadedBuffer && fromBuffer.GetFeatures().size() == 4 &&
+             fromBuffer.modelName == "buffer-roundtrip",
+         "LoadModelFromBuffer should parse XML from memory: " + error);
+  std::istringstream xmlIn(fromFile);
+  UnifiedModel fromStream;
+  const bool loadedStream =
+      LoadModel(fromStream, xmlIn, &error, SerializationFormat::TINYXML);
+  Expect(loadedStream && fromStream.GetFeatures().size() == 4,
+         "LoadModel(istream) should parse XML: " + error);
+
+  std::string json;
+  const bool savedJson =
+      SaveModelToBuffer(model, json, &error, SerializationFormat::CEREAL_JSON);
+  Expect(savedJson && !json.empty() && json.front() == '{',
+         "SaveModelToBuffer should write CEREAL_JSON: " + error);
+  std::vector<std::byte> bytes(json.size());
+  std::memcpy(bytes.data(), json.data(), json.size());
+  UnifiedModel fromBytes;
+  const bool loadedBytes =
+      LoadModelFromBuffer(fromBytes, bytes.data(), bytes.size(), &error,
+                          SerializationFormat::CEREAL_JSON);
+  std::string jsonAgain;
+  const bool resavedJson = SaveModelToBuffer(fromBytes, jsonAgain, &error,
+                                             SerializationFormat::CEREAL_JSON);
+  Expect(loadedBytes && resavedJson && jsonAgain == json,
+         "CEREAL_JSON should round-trip through raw byte buffers: " + error);
+
+  UnifiedModel broken;
+  error.clear();
+  Expect(!LoadModelFromBuffer(broken, std::string_view("<UnifiedModel"), &error,
+                              SerializationFormat::TINYXML) &&
+             !error.empty(),
+         "Malformed in-memory XML should fail with an error message.");
+
+  Geometry::GeometrySet geometry;
+  geometry.length_unit = "mm";
+  std::vector<CRefEdge> edges(1);
+  edges[0].startPoint = {0, 0, 0};
+  edges[0].endPoint = {10, 0, 0};
+  edges[0].midPoint = {5, 0, 0};
+  geometry.features["F-0"].LoadFromJsonValue(Geometry::detail::GeometryToJson(edges, {}));
+  std::stringstream geometryJson;
+  Expect(geometry.SaveToJson(geometryJson, &error),
+         "GeometrySet should save to a stream.");
+  Geometry::GeometrySet reloaded;
+  const bool loadedGeometry =
+      reloaded.LoadFromJsonBuffer(geometryJson.str(), &error, "m");
+  Expect(loadedGeometry && reloaded.TotalEdgeCount() == 1 &&
+             reloaded.length_unit == "m" &&
+             NearPoint(reloaded.features["F-0"].GetEdges()[0].endPoint, 0.01, 0, 0),
+         "GeometrySet should load from memory and convert units: " + error);
+}
+
+void TestAsyncSaveAndPrefetch() {
+  auto model = std::make_shared<UnifiedModel>(UnitType::MILLIMETER, "async");
+  auto addFillet = [&](int i) {
+    model->AddFeature(
+        MakeEdgeFillet("F-" + std::to_string(i), 1 + i, 10.0 * i, 1.0));
+  };
+  for (int i = 0; i < 3; ++i) {
+    addFillet(i);
+  }
+
+  const auto dir = std::filesystem::path("tmp");
+  std::filesystem::create_directories(dir);
+  const auto path = dir / "cadexchange_async.xml";
+  std::filesystem::remove(path);
+
+  // 提交后继续修改模型：快照只包含提交时的特征。
+  auto first = SaveModelAsync(model, path);
+  addFillet(3);
+  std::string expected;
+  std::string error;
+  const bool rendered =
+      SaveModelToBuffer(*model, expected, &error, SerializationFormat::TINYXML);
+  Expect(rendered, "SaveModelToBuffer should succeed: " + error);
+  AsyncSaveOptions fast;
+  fast.syncToDisk = false;
+  auto second = SaveModelAsync(model, path, fast);
+
+  const AsyncSaveResult firstResult = first.get();
+  const AsyncSaveResult secondResult = second.get();
+  Expect(firstResult.ok && secondResult.ok,
+         "Async saves should succeed: " + firstResult.errorMessage +
+             secondResult.errorMessage);
+  Expect(secondResult.bytesWritten == expected.size() &&
+             firstResult.bytesWritten < secondResult.bytesWritten,
+         "Snapshots should capture the feature list at submission time.");
+  std::ifstream in(path, std::ios::binary);
+  const std::string onDisk{std::istreambuf_iterator<char>(in), {}};
+  in.close();
+  Expect(onDisk == expected,
+         "Later saves to the same path should land last, matching SaveModel output.");
+  std::filesystem::path temp = path;
+  temp += ".tmp";
+  Expect(!std::filesystem::exists(temp), "Atomic save should not leave temp files.");
+
+  auto invalid = std::make_shared<UnifiedModel>(UnitType::MILLIMETER, "invalid");
+  auto bad = MakeEdgeFillet("BAD", 1, 0, 1.0);
+  bad->mode = FilletMode::UNKNOWN; // 未知圆角模式无法通过保存前校验
+  invalid->AddFeature(bad);
+  const AsyncSaveResult rejected = SaveModelAsync(invalid, path).get();
+  Expect(!rejected.ok && !rejected.errorMessage.empty() &&
+             std::filesystem::file_size(path) == expected.size(),
+         "Validation failures should leave the existing file untouched.");
+  const AsyncSaveResult missingDir =
+      SaveModelAsync(model, dir / "no-such-dir" / "x.xml").get();
+  Expect(!missingDir.ok && !missingDir.errorMessage.empty(),
+         "Write failures should be reported through the future.");
+  Expect(!SaveModelAsync(nullptr, path).get().ok, "Null models should fail.");
+
+  // 提交后原地修改特征与引用：快照是深拷贝，保存结果不受影响。
+  const auto editedPath = dir / "cadexchange_async_edited.xml";
+  std::string beforeEdit;
+  Expect(SaveModelToBuffer(*model, beforeEdit, &error,
+                           SerializationFormat::TINYXML),
+         "SaveModelToBuffer should succeed: " + error);
+  auto edited = SaveModelAsync(model, editedPath, fast);
+  model->ForEachMutable([](std::shared_ptr<CFeatureBase> &feature) {
+    auto fillet = std::static_pointer_cast<CFillet>(feature);
+    fillet->params.primaryValue = 42.0;
+    std::static_pointer_cast<CRefEdge>(fillet->references[0])->startPoint.x =
+        -1.0;
+  });
+  Expect(edited.get().ok, "Async save before an in-place edit should succeed.");
+  std::ifstream editedIn(editedPath, std::ios::binary);
+  const std::string editedOnDisk{std::istreambuf_iterator<char>(editedIn), {}};
+  editedIn.close();
+  Expect(editedOnDisk == beforeEdit,
+         "In-place edits after submission must not reach the saved file.");
+  std::filesystem::remove(editedPath);
+
+  auto prefetch = LoadModelAsync(path);
+  const AsyncLoadResult loaded = prefetch.get();
+  Expect(loaded.ok && loaded.model && loaded.model->GetFeatures().size() == 4,
+         "LoadModelAsync should prefetch the saved model: " + loaded.errorMessage);
+  const AsyncLoadResult missing = LoadModelAsync(dir / "missing.xml").get();
+  Expect(!missing.ok && !missing.model, "Missing files should fail to prefetch.");
+  std::filesystem::remove(path);
+}
+
+void TestModelJournalReplayAndCompaction() {
+  auto fillet = [](const std::string &id, double radius) {
+    return MakeEdgeFillet(id, radius, 0.0, 1.0);
+  };
+  const auto dir = std::filesystem::path("tmp");
+  std::filesystem::create_directories(dir);
+  const auto snapshot = dir / "cadexchange_journal.xml";
+  const auto journalPath = ModelJournal::JournalPathFor(snapshot);
+  std::filesystem::remove(snapshot);
+  std::filesystem::remove(journalPath);
+
+  ModelJournalOptions options;
+  options.minCompactionBytes = 0;
+  options.compactionRatio = 0.01;
+  std::string error;
+  UnifiedModel model(UnitType::MILLIMETER, "journal");
+  {
+    ModelJournal journal(snapshot, options);
+    const bool opened = journal.Open(model, &error);
+    Expect(opened && model.GetFeatures().empty() &&
+               std::filesystem::exists(journalPath),
+           "Opening without a snapshot should start empty: " + error);
+    for (int i = 0; i < 40; ++i) {
+      model.AddFeature(fillet("F-" + std::to_string(i), 1.0 + i));
+    }
+    const bool compacted = journal.Compact(model, &error);
+    Expect(compacted && std::filesystem::exists(snapshot) &&
+               !journal.NeedsCompaction(),
+           "Compact should write the snapshot and reset the journal: " + error);
+
+    // 单个特征变更只追加一条记录。
+    const auto before = journal.JournalBytes();
+    Expect(journal.RecordUpsert(fillet("F-1", 9.0), &error) &&
+               journal.RecordUpsert(fillet("F-40", 4.0), &error) &&
+               journal.RecordRemove("F-0", &error),
+           "Journal records should append: " + error);
+    Expect(journal.JournalBytes() > before &&
+               journal.JournalBytes() - before < journal.SnapshotBytes(),
+           "Journal growth should be proportional to the change, not the model.");
+  }
+
+  const auto journalBytes = std::filesystem::file_size(journalPath);
+  {
+    std::ofstream torn(journalPath, std::ios::binary | std::ios::app);
+    torn.write("\x40\x00\x00\x00garbage", 11);
+  }
+  UnifiedModel replayed;
+  ModelJournal journal(snapshot, options);
+  const bool reopened = journal.Open(replayed, &error);
+  Expect(reopened, "Reopening should replay the journal: " + error);
+  const auto &features = replayed.GetFeatures();
+  Expect(journal.ReplayedRecords() == 3 && features.size() == 40 &&
+             features.front()->featureID == "F-1" && features.back()->featureID == "F-40",
+         "Replay should apply upserts in place, append new IDs and drop removes.");
+  auto radius = replayed.GetFeatureAs<CFillet>("F-1");
+  Expect(radius && radius->params.primaryValue &&
+             Near(*radius->params.primaryValue, 9.0),
+         "Replayed upserts should carry the latest feature state.");
+  Expect(journal.DiscardedBytes() == 11 &&
+             std::filesystem::file_size(journalPath) == journalBytes,
+         "A torn tail record should be truncated on open.");
+
+  Expect(journal.NeedsCompaction(), "Journal past the size ratio should request compaction.");
+  const auto staleCopy = dir / "cadexchange_journal.stale";
+  std::filesystem::copy_file(journalPath, staleCopy,
+                             std::filesystem::copy_options::overwrite_existing);
+  const bool folded = journal.CompactIfNeeded(replayed, &error);
+  Expect(folded && !journal.NeedsCompaction(),
+         "CompactIfNeeded should fold the journal: " + error);
+  Expect(journal.RecordUpsert(fillet("F-41", 5.0), &error),
+         "Journal should accept records after compaction: " + error);
+
+  UnifiedModel afterCompaction;
+  ModelJournal reader(snapshot, options);
+  const bool readBack = reader.Open(afterCompaction, &error);
+  Expect(readBack && reader.ReplayedRecords() == 1 &&
+             afterCompaction.GetFeatures().size() == 41,
+         "Post-compaction journal should replay over the new snapshot: " + error);
+
+  // 压缩后残留的旧日志（快照指纹不同）必须被忽略。
+  std::filesystem::copy_file(staleCopy, journalPath,
+                             std::filesystem::copy_options::overwrite_existing);
+  UnifiedModel ignored;
+  ModelJournal staleReader(snapshot, options);
+  const bool staleOpened = staleReader.Open(ignored, &error);
+  Expect(staleOpened && staleReader.ReplayedRecords() == 0 &&
+             ignored.GetFeatures().size() == 40,
+         "A journal from an older snapshot should be discarded: " + error);
+
+  std::filesystem::remove(snapshot);
+  std::filesystem::remove(journalPath);
+  std::filesystem::remove(staleCopy);
+}
+
+void TestModelWorkspaceDedup() {
+  using Builder::PlaneConstraintBuilder;
+  using Builder::Ref;
+  auto fillet = [](const std::string &id, double radius) {
+    auto feature = MakeEdgeFillet(id, radius, 0.0, 1.0);
+    feature->params.driveType = FilletDriveType::SINGLE_DISTANCE;
+    return feature;
+  };
+  auto part = [&](const std::string &name, const std::string &planeID) {
+    UnifiedModel model(UnitType::MILLIMETER, name);
+    model.AddFeature(MakeDatumPlane(planeID, PlaneMethod::OFFSET,
+                                    {Ref::XY().Build()},
+                                    {PlaneConstraintBuilder::Distance(0, 10.0)}));
+    for (int i = 0; i < 4; ++i) {
+      auto feature = fillet("F-" + std::to_string(i), 1.0 + i);
+      feature->featureName = "Fillet" + std::to_string(i);
+      model.AddFeature(feature);
+    }
+    return model;
+  };
+
+  ModelWorkspace workspace;
+  auto a = workspace.AddPart("bracket", part("bracket", "PA"));
+  auto b = workspace.AddPart("cover", part("cover", "PB"));
+  auto planeA = a->GetFeatureAs<CDatumPlane>("PA");
+  auto planeB = b->GetFeatureAs<CDatumPlane>("PB");
+  Expect(planeA && planeB && planeA != planeB &&
+             planeA->referenceEntities[0] == planeB->referenceEntities[0],
+         "Standard datum references should collapse to one pooled instance.");
+  Expect(a->GetFeature("F-2") == b->GetFeature("F-2") &&
+             a->GetFeature("F-2") != a->GetFeature("F-3"),
+         "Identical features should be shared across parts, distinct ones kept.");
+  Expect(a->modelName == "bracket" && b->unit == UnitType::MILLIMETER,
+         "Deduplication should keep model metadata.");
+
+  auto stats = workspace.GetStats();
+  Expect(stats.parts == 2 && stats.features == 10 && stats.uniqueFeatures == 6,
+         "Stats should count feature slots and unique features.");
+  Expect(stats.uniqueReferences < stats.references,
+         "Stats should report pooled references.");
+  auto hits = workspace.FindFeaturesByName("Fillet1");
+  Expect(hits.size() == 2 && hits[0].first == "bracket" && hits[1].second == "F-1",
+         "Feature names should be indexed per part.");
+
+  // 调用方在 AddPart 之后原地修改自己的模型，不得影响工作区中的零件。
+  UnifiedModel spare = part("spare", "PS");
+  auto c = workspace.AddPart("spare", spare);
+  Expect(c->GetFeature("F-2") == a->GetFeature("F-2"),
+         "A third identical part should share the pooled features.");
+  std::string convertError;
+  Expect(ConvertModelUnit(spare, UnitType::METER, &convertError),
+         "ConvertModelUnit should succeed: " + convertError);
+  auto pooledFillet = a->GetFeatureAs<CFillet>("F-2");
+  auto pooledEdge =
+      std::static_pointer_cast<CRefEdge>(pooledFillet->references[0]);
+  auto pooledPlane = a->GetFeatureAs<CDatumPlane>("PA");
+  Expect(Near(*pooledFillet->params.primaryValue, 3.0) &&
+             Near(pooledEdge->endPoint.x, 5.0) &&
+             Near(pooledPlane->constraints[0].value, 10.0) &&
+             c->GetFeature("F-2") == pooledFillet,
+         "Editing the caller's model after AddPart must not change shared parts.");
+  Expect(workspace.RemovePart("spare"), "RemovePart should drop the spare part.");
+
+  // 并行加载：文件中的同一零件应与内存中的零件共享特征。
+  const auto dir = std::filesystem::path("tmp");
+  std::filesystem::create_directories(dir);
+  std::vector<ModelWorkspace::PartSource> sources;
+  for (int i = 0; i < 4; ++i) {
+    UnifiedModel model(UnitType::MILLIMETER, "lib");
+    for (int j = 0; j < 4; ++j) {
+      auto feature = fillet("F-" + std::to_string(j), 1.0 + j);
+      feature->featureName = "Fillet" + std::to_string(j);
+      model.AddFeature(feature);
+    }
+    const auto path = dir / ("cadexchange_workspace_" + std::to_string(i) + ".xml");
+    std::string error;
+    const bool saved =
+        SaveModel(model, path, &error, SerializationFormat::TINYXML);
+    Expect(saved, "Workspace fixture should save: " + error);
+    sources.push_back({"lib" + std::to_string(i), path});
+  }
+  sources.push_back({"missing", dir / "cadexchange_workspace_missing.xml"});
+  std::vector<std::string> errors;
+  const auto loadedCount =
+      workspace.LoadParts(sources, SerializationFormat::TINYXML, 3, &errors);
+  Expect(loadedCount == 4 && errors.size() == 5 && errors[0].empty() &&
+             !errors[4].empty() && workspace.PartCount() == 6,
+         "LoadParts should load in parallel and report per-source errors.");
+  Expect(workspace.GetPart("lib0")->GetFeature("F-1") ==
+             workspace.GetPart("lib3")->GetFeature("F-1"),
+         "Parts loaded in parallel should share identical features.");
+  Expect(workspace.GetPart("lib2")->GetFeature("F-1") == a->GetFeature("F-1"),
+         "Loaded parts should share features with existing parts.");
+
+  Expect(workspace.RemovePart("lib0") && !workspace.GetPart("lib0") &&
+             workspace.PartCount() == 5,
+         "RemovePart should drop the part.");
+  for (int i = 0; i < 4; ++i) {
+    std::filesystem::remove(dir / ("cadexchange_workspace_" + std::to_string(i) + ".xml"));
+  }
+}
+
+void TestModelCacheInvalidation() {
+  auto fillets = [](int count) {
+    UnifiedModel model(UnitType::MILLIMETER, "cached");
+    AddEdgeFillets(model, count, "F-", 1.0, 0.0);
+    return model;
+  };
+  const auto dir = std::filesystem::path("tmp");
+  std::filesystem::create_directories(dir);
+  const auto path = dir / "cadexchange_cache.xml";
+  const auto other = dir / "cadexchange_cache_other.xml";
+  const auto snapshot = ModelCache::SnapshotPathFor(path);
+  std::filesystem::remove(snapshot);
+  std::string error;
+  const bool saved =
+      SaveModel(fillets(3), path, &error, SerializationFormat::TINYXML) &&
+      SaveModel(fillets(5), other, &error, SerializationFormat::TINYXML);
+  Expect(saved, "Cache fixtures should save: " + error);
+  // 文件系统时间戳粒度可能较粗，显式推进修改时间。
+  auto bumpTime = [](const std::filesystem::path &file) {
+    std::filesystem::last_write_time(
+        file, std::filesystem::last_write_time(file) + std::chrono::seconds(2));
+  };
+
+  ModelCacheOptions options;
+  options.useSnapshots = true;
+  options.verifyContentHash = true;
+  {
+    ModelCache cache(options);
+    auto first = cache.Load(path, &error);
+    auto second = cache.Load(dir / "." / "cadexchange_cache.xml", &error);
+    Expect(first && first == second && first->GetFeatures().size() == 3,
+           "Repeat loads should return the shared cached model: " + error);
+    Expect(std::filesystem::exists(snapshot),
+           "A binary snapshot should be written next to the source.");
+
+    bumpTime(path); // 只改时间不改内容
+    Expect(cache.Load(path, &error) == first,
+           "A touched but unchanged file should keep the cached model.");
+
+    const bool rewritten =
+        SaveModel(fillets(4), path, &error, SerializationFormat::TINYXML);
+    bumpTime(path);
+    auto changed = cache.Load(path, &error);
+    Expect(rewritten && changed && changed != first &&
+               changed->GetFeatures().size() == 4,
+           "A changed file should be reparsed: " + error);
+    auto stats = cache.GetStats();
+    Expect(stats.hits == 2 && stats.misses == 2 && stats.invalidations == 1,
+           "Stats should count hits, misses and invalidations.");
+  }
+  {
+    ModelCache cold(options);
+    auto model = cold.Load(path, &error);
+    Expect(model && model->GetFeatures().size() == 4 &&
+               cold.GetStats().snapshotLoads == 1,
+           "A cold cache should load from a matching snapshot: " + error);
+    auto fillet = model->GetFeatureAs<CFillet>("F-3");
+    Expect(fillet && fillet->params.primaryValue &&
+               Near(*fillet->params.primaryValue, 4.0) &&
+               fillet->references.size() == 1,
+           "Snapshot loads should restore full feature content.");
+  }
+  {
+    ModelCacheOptions small;
+    small.byteBudget = std::filesystem::file_size(other) +
+                       std::filesystem::file_size(path) / 2;
+    ModelCache cache(small);
+    cache.Load(path, &error);
+    cache.Load(other, &error);
+    auto stats = cache.GetStats();
+    Expect(stats.entries == 1 && stats.evictions == 1 &&
+               stats.bytes == std::filesystem::file_size(other),
+           "The byte budget should evict the least recently used entry.");
+    Expect(!cache.Load(dir / "cadexchange_cache_missing.xml", &error) &&
+               !error.empty(),
+           "Missing files should fail with a message.");
+  }
+  {
+    ModelCacheOptions watching;
+    watching.watchFiles = true;
+    ModelCache cache(watching);
+    auto before = cache.Load(other, &error);
+    const bool rewritten =
+        SaveModel(fillets(2), other, &error, SerializationFormat::TINYXML);
+    auto after = cache.Load(other, &error);
+    Expect(rewritten && before && after && after->GetFeatures().size() == 2,
+           "Watched files should be reloaded after they change: " + error);
+  }
+#ifndef _WIN32
+  {
+    // 条目作废后路径映射随之丢弃：改指向的符号链接会重新规范化。
+    const auto link = dir / "cadexchange_cache_link.xml";
+    std::filesystem::remove(link);
+    std::filesystem::create_symlink(path.filename(), link);
+    ModelCache cache;
+    auto viaLink = cache.Load(link, &error);
+    cache.Invalidate(link);
+    std::filesystem::remove(link);
+    std::filesystem::create_symlink(other.filename(), link);
+    auto retargeted = cache.Load(link, &error);
+    Expect(viaLink && retargeted && viaLink->GetFeatures().size() == 4 &&
+               retargeted->GetFeatures().size() == 2,
+           "Invalidated symlinks should resolve to their new target: " + error);
+    std::filesystem::remove(link);
+  }
+#endif
+  std::filesystem::remove(path);
+  std::filesystem::remove(other);
+  std::filesystem::remove(snapshot);
+}
+
+#ifndef _WIN32
+void TestModelServerRequests() {
+  using namespace CADExchange::Server;
+  const auto dir = std::filesystem::absolute("tmp");
+  std::filesystem::create_directories(dir);
+  const auto modelPath = dir / "cadexchange_served.xml";
+  const auto convertedPath = dir / "cadexchange_served_m.xml";
+  const auto jsonPath = dir / "cadexchange_served.json";
+  UnifiedModel model(UnitType::MILLIMETER, "served");
+  for (int i = 0; i < 3; ++i) {
+    auto feature = MakeEdgeFillet("F-" + std::to_string(i), 1.0 + i, 10.0 * i, 1.0);
+    feature->featureName = "Fillet" + std::to_string(i);
+    model.AddFeature(feature);
+  }
+  std::string error;
+  const bool saved = SaveModel(model, modelPath, &error, SerializationFormat::TINYXML);
+  Expect(saved, "Server fixture should save: " + error);
+
+  ModelCache cache;
+  ModelServerOptions options;
+  options.socketPath = std::filesystem::path("tmp") / "cadex_served.sock";
+  options.workerThreads = 2;
+  options.cache = &cache;
+  ModelServer server(options);
+  const bool started = server.Start(&error);
+  Expect(started, "ModelServer should start: " + error);
+  ModelServer second(options);
+  Expect(!second.Start(&error), "A second server on the same socket should fail.");
+
+  ModelClient client;
+  const bool connected = client.Connect(options.socketPath, &error) && client.Ping(&error);
+  Expect(connected, "Client should connect and ping: " + error);
+
+  ModelSummary summary;
+  const bool loaded = client.Load(modelPath, summary, &error);
+  Expect(loaded && summary.featureCount == 3 && summary.unit == UnitType::MILLIMETER &&
+             summary.modelName == "served",
+         "Load should report the model summary: " + error);
+  std::vector<FeatureSummary> features;
+  const bool listed = client.ListFeatures(modelPath, features, &error);
+  Expect(listed && features.size() == 3 && features[1].featureName == "Fillet1" &&
+             features[1].featureType == FeatureType::Fillet,
+         "ListFeatures should return id, name and type: " + error);
+  std::shared_ptr<CFeatureBase> feature;
+  const bool fetched = client.GetFeature(modelPath, "F-2", feature, &error);
+  auto fillet = std::dynamic_pointer_cast<CFillet>(feature);
+  Expect(fetched && fillet && fillet->params.primaryValue &&
+             Near(*fillet->params.primaryValue, 3.0) && fillet->references.size() == 1,
+         "GetFeature should transfer full feature content: " + error);
+  Expect(!client.GetFeature(modelPath, "NOPE", feature, &error) && !error.empty() &&
+             client.IsConnected(),
+         "Server-side failures should keep the connection open.");
+  ValidationReport report;
+  const bool validated = client.Validate(modelPath, report, &error);
+  Expect(validated && report.isValid, "Validate should report a valid model: " + error);
+
+  const bool converted =
+      client.ConvertUnit(modelPath, UnitType::METER, convertedPath, &error);
+  UnifiedModel meters;
+  const bool reloaded =
+      converted && LoadModel(meters, convertedPath, &error, SerializationFormat::TINYXML);
+  auto convertedFillet = meters.GetFeatureAs<CFillet>("F-1");
+  Expect(reloaded && meters.unit == UnitType::METER && convertedFillet &&
+             Near(*convertedFillet->params.primaryValue, 0.002),
+         "ConvertUnit should write a converted copy: " + error);
+  auto cached = cache.Load(modelPath, &error);
+  auto cachedFillet = cached ? cached->GetFeatureAs<CFillet>("F-1") : nullptr;
+  Expect(cachedFillet && Near(*cachedFillet->params.primaryValue, 2.0),
+         "ConvertUnit must not modify the cached model.");
+  Expect(client.Save(modelPath, jsonPath, &error, SerializationFormat::TINYXML,
+                     SerializationFormat::CEREAL_JSON) &&
+             std::filesystem::exists(jsonPath),
+         "Save should write the requested format: " + error);
+
+  Geometry::GeometrySet geometry;
+  geometry.length_unit = "mm";
+  std::vector<CRefEdge> edges(1);
+  edges[0].startPoint = {0, 0, 0};
+  edges[0].endPoint = {10, 0, 0};
+  edges[0].midPoint = {5, 0, 0};
+  geometry.features["F-0"].LoadFromJsonValue(Geometry::detail::GeometryToJson(edges, {}));
+  const auto srcGeometry = dir / "cadexchange_served_src.json";
+  const auto dstGeometry = dir / "cadexchange_served_dst.json";
+  geometry.SaveToJson(srcGeometry, &error);
+  geometry.features["F-1"] = geometry.features["F-0"];
+  geometry.SaveToJson(dstGeometry, &error);
+  GeometryCompareSummary same;
+  GeometryCompareSummary different;
+  const bool compared = client.CompareGeometry(srcGeometry, srcGeometry, same, &error) &&
+                        client.CompareGeometry(srcGeometry, dstGeometry, different, &error);
+  Expect(compared && same.equivalent && !different.equivalent &&
+             !different.diagnostics.empty(),
+         "CompareGeometry should report equivalence and extra features: " + error);
+
+  // 多个客户端并发请求。
+  std::vector<std::thread> clients;
+  std::atomic<int> successes{0};
+  for (int t = 0; t < 6; ++t) {
+    clients.emplace_back([&] {
+      ModelClient worker;
+      if (!worker.Connect(options.socketPath)) {
+        return;
+      }
+      for (int i = 0; i < 20; ++i) {
+        ModelSummary s;
+        if (!worker.Load(modelPath, s) || s.featureCount != 3) {
+          return;
+        }
+      }
+      ++successes;
+    });
+  }
+  for (auto &thread : clients) {
+    thread.join();
+  }
+  Expect(successes == 6, "Concurrent clients should all be served.");
+
+  server.Stop();
+  Expect(!client.Ping(&error) && !std::filesystem::exists(options.socketPath),
+         "Stopping the server should close connections and remove the socket.");
+  for (const auto &path : {modelPath, convertedPath, jsonPath, srcGeometry, dstGeometry}) {
+    std::filesystem::remove(path);
+  }
+}
+#endif
+
+void TestModelImageView() {
+  UnifiedModel model(UnitType::INCH, "imaged");
+  for (int i = 0; i < 5; ++i) {
+    auto fillet = MakeEdgeFillet("FI-" + std::to_string(4 - i), 1.0 + i, 5.0 * i, 1.0);
+    fillet->featureName = "Fillet" + std::to_string(i);
+    fillet->isSuppressed = i == 2;
+    model.AddFeature(fillet);
+  }
+  std::string image;
+  std::string error;
+  Expect(BuildModelImage(model, image, &error), "Model image should build: " + error);
+
+  // 镜像只含相对偏移：复制到未对齐的地址后照常可读。
+  std::string moved = "x" + image;
+  auto view = ModelImageView::Open(std::string_view(moved).substr(1), &error);
+  Expect(view && view->Unit() == UnitType::INCH && view->ModelName() == "imaged" &&
+             view->GetFeatureCount() == 5,
+         "Image view should expose model metadata: " + error);
+  Expect(view->FeatureID(0) == "FI-4" && view->FeatureName(3) == "Fillet3" &&
+             view->GetFeatureType(1) == FeatureType::Fillet && view->IsSuppressed(2) &&
+             !view->IsSuppressed(1),
+         "Image view should expose per-feature metadata without decoding.");
+  Expect(view->FindFeature("FI-1") == 3 && view->FindFeature("FI-9") == -1,
+         "Image view should find features by ID.");
+  auto accessor = view->GetFeatureByID("FI-0");
+  auto fillet = accessor ? std::dynamic_pointer_cast<const CFillet>(
+                               view->DecodeFeature(view->FindFeature("FI-0")))
+                         : nullptr;
+  Expect(accessor && accessor->GetName() == "Fillet4" && fillet &&
+             Near(*fillet->params.primaryValue, 5.0) &&
+             view->DecodeFeature(4) == view->DecodeFeature(4),
+         "Decoded features should carry full content and be cached.");
+  UnifiedModel copy;
+  Expect(view->ToModel(copy, &error) && copy.GetFeatures().size() == 5 &&
+             copy.unit == UnitType::INCH && copy.GetFeature("FI-3"),
+         "Image view should convert back to a model: " + error);
+
+  Expect(!ModelImageView::Open(std::string_view(image).substr(0, image.size() - 1)) &&
+             !ModelImageView::Open("not an image"),
+         "Truncated or foreign images must be rejected.");
+}
+
+#ifndef _WIN32
+void TestSharedModelChannel() {
+  using namespace CADExchange::Server;
+  const std::string name = "/cadex_test_" + std::to_string(::getpid());
+  UnifiedModel model(UnitType::MILLIMETER, "shared");
+  for (int i = 0; i < 20; ++i) {
+    model.AddFeature(MakeEdgeFillet("S-" + std::to_string(i), 1.0 + i, 2.0 * i, 1.0));
+  }
+
+  std::string error;
+  SharedModelChannel producer;
+  SharedModelChannelOptions options;
+  options.slotCount = 2;
+  options.slotBytes = 1u << 20;
+  Expect(producer.Create(name, options, &error), "Channel should be created: " + error);
+  SharedModelChannel consumer;
+  Expect(consumer.Open(name, &error), "Channel should open: " + error);
+  Expect(!consumer.Acquire(&error) && consumer.LatestGeneration() == 0,
+         "Acquire before any publish should fail.");
+
+  std::uint64_t generation = 0;
+  Expect(producer.Publish(model, &error, &generation) && generation == 1,
+         "First publish should succeed: " + error);
+  std::uint64_t acquired = 0;
+  auto first = consumer.Acquire(&error, &acquired);
+  Expect(first && acquired == 1 && first->GetFeatureCount() == 20 &&
+             first->FeatureID(7) == "S-7",
+         "Consumer should see the published model: " + error);
+
+  // 两个槽：一个被读者固定、另一个是最新槽，此时第三次发布必须失败。
+  model.modelName = "shared-2";
+  Expect(producer.Publish(model, &error, &generation) && generation == 2,
+         "Second publish should use the free slot: " + error);
+  Expect(!producer.Publish(model, &error),
+         "Publishing must not overwrite a slot pinned by a reader.");
+  Expect(first->ModelName() == "shared" && first->GetFeatureByID("S-19"),
+         "A pinned view should stay intact while newer models are published.");
+  first.reset();
+  Expect(producer.Publish(model, &error, &generation) && generation > 2,
+         "Publishing should resume once the reader releases its view: " + error);
+
+  const pid_t child = ::fork();
+  if (child == 0) {
+    SharedModelChannel remote;
+    std::uint64_t seen = 0;
+    auto view = remote.Open(name) ? remote.Acquire(nullptr, &seen) : nullptr;
+    auto remoteFillet =
+        view ? std::dynamic_pointer_cast<const CFillet>(view->DecodeFeature(3)) : nullptr;
+    const bool ok = view && seen == generation && view->ModelName() == "shared-2" &&
+                    remoteFillet && Near(*remoteFillet->params.primaryValue, 4.0);
+    ::_exit(ok ? 0 : 1);
+  }
+  int status = -1;
+  ::waitpid(child, &status, 0);
+  Expect(child > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0,
+         "Another process should read the model from shared memory.");
+
+  SharedModelChannel tiny;
+  options.slotBytes = 256;
+  Expect(tiny.Create(name + "_tiny", options, &error) && !tiny.Publish(model, &error),
+         "Images larger than a slot must be rejected.");
+  Expect(SharedModelChannel::Remove(name) && SharedModelChannel::Remove(name + "_tiny") &&
+             !consumer.Open(name),
+         "Removed channels should no longer open.");
+}
+#endif
+
+void TestTinyXmlNameTables() {
+  constexpr auto names = MakeNameTable<int>({{"Alpha", 1}, {"Beta", 2}, {"A", 1}});
+  static_assert(*names.Find("ALPHA") == 1 && *names.Find("beta") == 2 &&
+                    names.Find("Gamma") == nullptr,
+                "Name tables should resolve at compile time.");
+  Expect(std::string(names.NameOf(1, "?")) == "Alpha" &&
+             std::string(names.NameOf(3, "?")) == "?",
+         "NameOf should return the canonical name or the fallback.");
+
+  UnifiedModel model(UnitType::INCH, "names");
+  auto fillet = MakeEdgeFillet("N-1", 2.0, 0.0, 1.0);
+  model.AddFeature(fillet);
+  std::string xml;
+  std::string error;
+  const bool saved =
+      SaveModelToBuffer(model, xml, &error, SerializationFormat::TINYXML, true);
+  Expect(saved && xml.find("UnitSystem=\"Inch\"") != std::string::npos &&
+             xml.find(" Mode=\"Constant\"") != std::string::npos,
+         "Canonical enum names should be written: " + error);
+
+  // 历史文件：枚举文本大小写混用并使用别名；Feature 的 Type 仍大小写敏感。
+  auto replace = [&](const std::string &from, const std::string &to) {
+    const auto pos = xml.find(from);
+    Expect(pos != std::string::npos, "Fixture should contain " + from);
+    xml.replace(pos, from.size(), to);
+  };
+  replace("UnitSystem=\"Inch\"", "UnitSystem=\"INCH\"");
+  replace(" Mode=\"Constant\"", " Mode=\"constantRADIUS\"");
+  UnifiedModel legacy;
+  Expect(LoadModelFromBuffer(legacy, xml, &error, SerializationFormat::TINYXML),
+         "Legacy-cased XML should load: " + error);
+  auto loaded = legacy.GetFeatureAs<CFillet>("N-1");
+  Expect(legacy.unit == UnitType::INCH && loaded &&
+             loaded->mode == FilletMode::CONSTANT_RADIUS,
+         "Enum text should resolve case-insensitively, including aliases.");
+
+  replace("Type=\"Fillet\"", "Type=\"fillet\"");
+  UnifiedModel skipped;
+  LoadModelFromBuffer(skipped, xml, &error, SerializationFormat::TINYXML);
+  Expect(skipped.GetFeatures().empty(), "Feature types should stay case-sensitive.");
+}
+
+void TestTinyXmlAttributeScan() {
+  // 历史写法：属性顺序任意，参数使用 Default* 别名，半径点使用 RadiusItem。
+  const std::string xml =
+      "<UnifiedModel UnitSystem=\"Millimeter\" ModelName=\"scan\" SchemaVersion=\"1\">"
+      "<Feature Suppressed=\"true\" Mode=\"Constant\" Type=\"Fillet\" Name=\"round\" ID=\"S-1\">"
+      "<Parameters TangentPropagation=\"true\" DefaultDistance=\"1.5\" DefaultRadius=\"2\"/>"
+      "<RadiusItems><RadiusItem Distance=\"9\" Radius=\"3\" Position=\"0.5\"/></RadiusItems>"
+      "<References><ReferenceEntity Type=\"Edge\" CurveType=\"Line\" MidPoint=\"(2.5,0,0)\""
+      " TopologyIndex=\"7\" StartPoint=\"(0,0,0)\" EndPoint=\"(5,0,0)\"/></References>"
+      "</Feature></UnifiedModel>";
+  UnifiedModel model;
+  std::string error;
+  Expect(LoadModelFromBuffer(model, xml, &error, SerializationFormat::TINYXML),
+         "Legacy fillet XML should load: " + error);
+  auto fillet = model.GetFeatureAs<CFillet>("S-1");
+  Expect(fillet && fillet->featureName == "round" && fillet->isSuppressed &&
+             fillet->mode == FilletMode::CONSTANT_RADIUS,
+         "Feature header attributes should be read in any order.");
+  Expect(fillet->params.tangentPropagation && fillet->params.primaryValue &&
+             Near(*fillet->params.primaryValue, 2.0) &&
+             !fillet->params.secondValue &&
+             fillet->params.driveType == FilletDriveType::SINGLE_DISTANCE &&
+             fillet->referenceMode == FilletReferenceMode::EDGE_CHAIN,
+         "DefaultRadius should take precedence over DefaultDistance.");
+  Expect(fillet->params.radiusPoints.size() == 1 &&
+             Near(fillet->params.radiusPoints[0].position, 0.5) &&
+             fillet->params.radiusPoints[0].primaryValue &&
+             Near(*fillet->params.radiusPoints[0].primaryValue, 3.0),
+         "RadiusItem aliases should resolve as before.");
+  auto edge = fillet->references.empty()
+                  ? nullptr
+                  : std::dynamic_pointer_cast<CRefEdge>(fillet->references[0]);
+  Expect(edge && Near(edge->midPoint.x, 2.5) && Near(edge->endPoint.x, 5.0) &&
+             edge->curveType == CGeoCurveType::LINE,
+         "Edge reference attributes should be scanned in one pass.");
+}
+
+void TestFusedLoadPipeline() {
+  // 被后续特征引用的空草图：SKETCH_001/GEOM_003 必须落在草图自己的位置。
+  UnifiedModel invalid(UnitType::MILLIMETER, "fused-invalid");
+  auto emptySketch = std::make_shared<CSketch>();
+  emptySketch->featureID = "SK-E";
+  emptySketch->sketchCSys = {{0, 0, 0}, {1, 0, 0}, {1, 0, 0}, {0, 0, 1}, true};
+  invalid.AddFeature(emptySketch);
+  auto badExtrude = std::make_shared<CExtrude>();
+  badExtrude->featureID = "EX-E";
+  badExtrude->profileSketchID = "SK-E";
+  badExtrude->direction = {0, 0, 0};
+  badExtrude->extent1.type = SweepExtent::Type::VALUE;
+  badExtrude->extent1.value = 10.0;
+  invalid.AddFeature(badExtrude);
+  const auto report = invalid.Validate();
+  Expect(!report.isValid && report.errors.size() >= 2 &&
+             report.errors[0].rfind("[GEOM_003] Sketch 'SK-E'", 0) == 0 &&
+             report.errors[1].rfind("[GEOM_001] Extrude 'EX-E'", 0) == 0 &&
+             !report.warnings.empty() &&
+             report.warnings[0].rfind("[SKETCH_001] Sketch 'SK-E'", 0) == 0,
+         "Deferred sketch rules should keep their original report position.");
+
+  UnifiedModel valid(UnitType::MILLIMETER, "fused-valid");
+  AddEdgeFillets(valid, 3, "FL-", 2.0);
+  // cereal 格式保留 shared_ptr 共享：两个特征共用的引用只能换算一次。
+  auto sharedA = valid.GetFeatureAs<CFillet>("FL-0");
+  auto sharedB = valid.GetFeatureAs<CFillet>("FL-1");
+  sharedB->references[0] = sharedA->references[0];
+
+  std::vector<SerializationFormat> formats = {SerializationFormat::TINYXML,
+                                              SerializationFormat::CEREAL_JSON};
+#ifdef ENABLE_CEREAL_SERIALIZATION
+  formats.push_back(SerializationFormat::CEREAL);
+#endif
+  for (SerializationFormat format : formats) {
+    for (UnifiedModel *source : {&valid, &invalid}) {
+      std::string data;
+      std::string error;
+      Expect(SaveModelToBuffer(*source, data, &error, format, true),
+             "Fixture should save: " + error);
+
+      UnifiedModel separate;
+      std::string separateError;
+      bool separateOk =
+          LoadModelFromBuffer(separate, data, &separateError, format);
+      if (separateOk) {
+        separateOk = ConvertModelUnit(separate, UnitType::METER, &separateError);
+      }
+
+      UnifiedModel fused;
+      std::string fusedError;
+      LoadOptions options;
+      options.targetUnit = UnitType::METER;
+      const bool fusedOk =
+          LoadModelFromBuffer(fused, data, options, &fusedError, format);
+      Expect(fusedOk == separateOk && fusedError == separateError &&
+                 fusedOk == (source == &valid),
+             "Fused load should report exactly like load + convert: " +
+                 fusedError);
+      if (fusedOk) {
+        std::string separateXml;
+        std::string fusedXml;
+        SaveModelToBuffer(separate, separateXml, nullptr,
+                          SerializationFormat::TINYXML, true);
+        SaveModelToBuffer(fused, fusedXml, nullptr, SerializationFormat::TINYXML,
+                          true);
+        Expect(fused.unit == UnitType::METER && fusedXml == separateXml,
+               "Fused load should produce the converted model.");
+        auto edge = std::static_pointer_cast<CRefEdge>(
+            fused.GetFeatureAs<CFillet>("FL-1")->references[0]);
+        Expect(Near(edge->endPoint.x, 0.005),
+               "Shared references should be scaled exactly once.");
+      }
+    }
+  }
+}
+
+void TestSerializerContextReuse() {
+  UnifiedModel model(UnitType::MILLIMETER, "context-reuse");
+  AddEdgeFillets(model, 4, "FL-", 1.5, 5.0);
+  std::string expected;
+  Expect(SaveModelToBuffer(model, expected, nullptr, SerializationFormat::TINYXML, true),
+         "Context fixture should save.");
+  UnifiedModel reference;
+  std::string expectedReload;
+  Expect(LoadModelFromBuffer(reference, expected, nullptr, SerializationFormat::TINYXML) &&
+             SaveModelToBuffer(reference, expectedReload, nullptr,
+                               SerializationFormat::TINYXML, true),
+         "Context fixture should load without a context.");
+
+  SerializerContext context;
+  LoadOptions options;
+  options.context = &context;
+  for (int round = 0; round < 3; ++round) {
+    std::string xml;
+    Expect(SaveModelToBuffer(model, xml, nullptr, SerializationFormat::TINYXML, true,
+                             &context) &&
+               xml == expected,
+           "Saving through a reused context should match the context-free output.");
+
+    std::ostringstream streamed;
+    Expect(SaveModel(model, streamed, nullptr, SerializationFormat::TINYXML, true,
+                     &context) &&
+               streamed.str() == expected,
+           "Streaming save through a reused context should match.");
+
+    UnifiedModel loaded;
+    std::string error;
+    std::istringstream input(expected);
+    Expect(LoadModel(loaded, input, options, &error, SerializationFormat::TINYXML) &&
+               loaded.GetFeatures().size() == model.GetFeatures().size(),
+           "Loading through a reused context should succeed: " + error);
+    std::string reloaded;
+    SaveModelToBuffer(loaded, reloaded, nullptr, SerializationFormat::TINYXML, true);
+    Expect(reloaded == expectedReload,
+           "Loading through a context should match the context-free load.");
+  }
+
+  // 解析失败不应污染上下文，下一次加载照常成功。
+  UnifiedModel broken;
+  std::string error;
+  Expect(!LoadModelFromBuffer(broken, "<UnifiedModel", options, &error,
+                              SerializationFormat::TINYXML) &&
+             !error.empty(),
+         "Malformed XML should fail through a context.");
+  UnifiedModel recovered;
+  error.clear();
+  Expect(LoadModelFromBuffer(recovered, expected, options, &error,
+                             SerializationFormat::TINYXML) &&
+             recovered.GetFeatures().size() == model.GetFeatures().size(),
+         "A context should recover after a parse error: " + error);
+
+  // 超过保留上限的缓冲区在 Reset 时释放。
+  SerializerContext small(256);
+  std::istringstream input(expected);
+  UnifiedModel capped;
+  Expect(expected.size() > 256 &&
+             TinyXMLSerializer::Load(capped, input, nullptr, nullptr, &small) &&
+             small.RetainedBufferBytes() >= expected.size(),
+         "Stream load should keep its read buffer until the next reset.");
+  small.Reset();
+  Expect(small.RetainedBufferBytes() <= small.RetainLimit(),
+         "Reset should drop buffers above the retain limit.");
+  context.Reset();
+  Expect(context.RetainedBufferBytes() >= expected.size(),
+         "Reset should keep buffers within the retain limit.");
+}
+
+} // namespace
+
+int main() {
+  TestIdGeneratorDeterministicSequence();
+  TestIdGeneratorUniqueAcrossThreads();
+  TestModelTransactionCommitsLanesInOrder();
+  TestModelTransactionDefersCrossLaneReferences();
+  TestTransformModelRigidMotion();
+  TestTransformedModelViewIsLazy();
+  TestConvertModelUnitUsesSharedVisitor();
+  TestPatternExpanderLinearGrid();
+  TestPatternExpanderCircularAndMirror();
+  TestReferenceSpatialIndexQueries();
+  TestReferenceResolverMatchesTopology();
+  TestReferenceResolverParallelBatch();
+  TestMatchModelsPairsReexports();
+  TestSketchLoopExtractorNesting();
+  TestConstraintCheckerResiduals();
+  TestDatumPlaneEvaluatorChain();
+  TestFeatureBoundsTreeQueries();
+  TestSketchProjectionRoundTrip();
+  TestEdgeChainBuilderOrdering();
+  TestCerealJsonStreamingRoundTrip();
+  TestInMemorySerializationBuffers();
+  TestAsyncSaveAndPrefetch();
+  TestModelJournalReplayAndCompaction();
+  TestModelWorkspaceDedup();
+  TestModelCacheInvalidation();
+#ifndef _WIN32
+  TestModelServerRequests();
+#endif
+  TestModelImageView();
+#ifndef _WIN32
+  TestSharedModelChannel();
+#endif
+  TestTinyXmlNameTables();
+  TestTinyXmlAttributeScan();
+  TestFusedLoadPipeline();
+  TestSerializerContextReuse();
+  std::cout << "[PASS] ServiceRegressionTest" << std::endl;
+  return 0;
+}
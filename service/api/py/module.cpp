@@ -324,6 +324,7 @@ PYBIND11_MODULE(cadexchange_py, m) {
       .def_property_readonly("x_axis", &GetSketchXAxis)
       .def_property_readonly("y_axis", &GetSketchYAxis)
       .def_property_readonly("z_axis", &GetSketchZAxis)
+      .def_property_readonly("world_points", &GetSketchWorldPoints)
       .def_property_readonly("segment_count", &SketchAccessor::GetSegmentCount)
       .def("get_segment", &SketchAccessor::GetSegment)
       .def("get_segment_by_local_id", &SketchAccessor::GetSegmentByLocalID)
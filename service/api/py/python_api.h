@@ -8,7 +8,9 @@
 #include "../../accessors/ReferenceAccessor.h"
 #include "../../accessors/RevolveAccessor.h"
 #include "../../accessors/SketchAccessor.h"
+#include "../../geometry/SketchProjection.h"
 #include "../../serialization/CADSerializer.h"
+#include "../../serialization/ModelCache.h"
 
 #include <stdexcept>
 #include <string>
@@ -16,14 +18,16 @@
 
 namespace CADExchange::PythonApi {
 
+// 经进程级 ModelCache 加载：文件未变化时直接复用已解析的模型。
+// ModelAccessor 只读，SetModel 浅拷贝特征指针即可。
 inline Accessor::ModelAccessor LoadModelAccessor(const std::string &path) {
-  UnifiedModel model;
   std::string error;
-  if (!LoadModel(model, path, &error, SerializationFormat::TINYXML)) {
+  auto model = ModelCache::Instance().Load(path, &error, SerializationFormat::TINYXML);
+  if (!model) {
     throw std::runtime_error(error.empty() ? "Failed to load model." : error);
   }
   Accessor::ModelAccessor accessor;
-  accessor.SetModel(model);
+  accessor.SetModel(*model);
   return accessor;
 }
 
@@ -59,48 +63,43 @@ inline std::vector<double> VectorToVector(const CVector3D &vector) {
   return {vector.x, vector.y, vector.z};
 }
 
+inline const CSketchCSys *FindSketchCSys(const Accessor::SketchAccessor &sketch) {
+  return sketch.IsValid() ? &sketch.Data()->sketchCSys : nullptr;
+}
+
 inline std::vector<double> GetSketchOrigin(const Accessor::SketchAccessor &sketch) {
-  CPoint3D origin;
-  CVector3D xDir;
-  CVector3D yDir;
-  CVector3D zDir;
-  if (!sketch.GetCSys(origin, xDir, yDir, zDir)) {
-    return {};
-  }
-  return PointToVector(origin);
+  const CSketchCSys *csys = FindSketchCSys(sketch);
+  return csys ? PointToVector(csys->origin) : std::vector<double>{};
 }
 
 inline std::vector<double> GetSketchXAxis(const Accessor::SketchAccessor &sketch) {
-  CPoint3D origin;
-  CVector3D xDir;
-  CVector3D yDir;
-  CVector3D zDir;
-  if (!sketch.GetCSys(origin, xDir, yDir, zDir)) {
-    return {};
-  }
-  return VectorToVector(xDir);
+  const CSketchCSys *csys = FindSketchCSys(sketch);
+  return csys ? VectorToVector(csys->xDir) : std::vector<double>{};
 }
 
 inline std::vector<double> GetSketchYAxis(const Accessor::SketchAccessor &sketch) {
-  CPoint3D origin;
-  CVector3D xDir;
-  CVector3D yDir;
-  CVector3D zDir;
-  if (!sketch.GetCSys(origin, xDir, yDir, zDir)) {
-    return {};
-  }
-  return VectorToVector(yDir);
+  const CSketchCSys *csys = FindSketchCSys(sketch);
+  return csys ? VectorToVector(csys->yDir) : std::vector<double>{};
 }
 
 inline std::vector<double> GetSketchZAxis(const Accessor::SketchAccessor &sketch) {
-  CPoint3D origin;
-  CVector3D xDir;
-  CVector3D yDir;
-  CVector3D zDir;
-  if (!sketch.GetCSys(origin, xDir, yDir, zDir)) {
-    return {};
+  const CSketchCSys *csys = FindSketchCSys(sketch);
+  return csys ? VectorToVector(csys->zDir) : std::vector<double>{};
+}
+
+inline std::vector<std::vector<double>>
+GetSketchWorldPoints(const Accessor::SketchAccessor &sketch) {
+  std::vector<std::vector<double>> points;
+  if (!sketch.IsValid()) {
+    return points;
+  }
+  Geometry::SketchWorldPoints world;
+  Geometry::ProjectSketchToWorld(*sketch.Data(), world);
+  points.reserve(world.Size());
+  for (std::size_t i = 0; i < world.Size(); ++i) {
+    points.push_back({world.points.x[i], world.points.y[i], world.points.z[i]});
   }
-  return VectorToVector(zDir);
+  return points;
 }
 
 inline std::vector<double>
@@ -16,6 +16,9 @@ public:
   ChamferBuilder(UnifiedModel &model, const std::string &name)
       : FeatureBuilderBase(model, name) {}
 
+  ChamferBuilder(TransactionLane &lane, const std::string &name)
+      : FeatureBuilderBase(lane, name) {}
+
   /**
    * @brief Set chamfer parameter mode.
    */
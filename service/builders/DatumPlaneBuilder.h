@@ -97,6 +97,9 @@ public:
   DatumPlaneBuilder(UnifiedModel &model, const std::string &name)
       : FeatureBuilderBase(model, name) {}
 
+  DatumPlaneBuilder(TransactionLane &lane, const std::string &name)
+      : FeatureBuilderBase(lane, name) {}
+
   DatumPlaneBuilder &SetNormal(const CVector3D &normal) {
     m_feature->normal = normal;
     return *this;
@@ -16,6 +16,9 @@ public:
   DraftBuilder(UnifiedModel &model, const std::string &name)
       : FeatureBuilderBase(model, name) {}
 
+  DraftBuilder(TransactionLane &lane, const std::string &name)
+      : FeatureBuilderBase(lane, name) {}
+
   DraftBuilder &SetDraftType(DraftType type) {
     if (type == DraftType::Unknown) {
       throw std::runtime_error("Draft type must not be Unknown.");
@@ -28,6 +28,9 @@ public:
   ExtrudeBuilder(UnifiedModel &model, const std::string &name)
       : FeatureBuilderBase(model, name) {}
 
+  ExtrudeBuilder(TransactionLane &lane, const std::string &name)
+      : FeatureBuilderBase(lane, name) {}
+
   /**
    * @brief 通过 sketch ID 设置草图轮廓。
    *
@@ -36,9 +39,8 @@ public:
    * @throws std::runtime_error 当草图不存在时抛出
    */
   ExtrudeBuilder &SetProfile(const std::string &sketchID) {
-    if (!m_model.GetFeatureAs<CSketch>(sketchID)) {
-      throw std::runtime_error("Sketch profile not found: " + sketchID);
-    }
+    RequireFeature(sketchID, FeatureType::Sketch,
+                   "Sketch profile not found: " + sketchID);
     m_feature->profileSketchID = sketchID;
     return *this;
   }
@@ -54,7 +56,7 @@ public:
    * @throws std::runtime_error 当草图不存在时抛出
    */
   ExtrudeBuilder &SetProfileByName(const std::string &sketchName) {
-    auto sketchId = m_model.GetFeatureIdByName(sketchName);
+    auto sketchId = FindFeatureIdByName(sketchName);
     if (sketchId.empty() || sketchId == "UnknownSketchId") {
       throw std::runtime_error("Sketch not found by name: " + sketchName);
     }
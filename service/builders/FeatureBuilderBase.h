@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "../../core/UnifiedModel.h"
+#include "ModelTransaction.h"
 #include "StringHelper.h"
 #include <atomic>
 #include <memory>
@@ -36,6 +37,21 @@ public:
     m_feature->featureID = StringHelper::GenerateUUID();
   }
 
+  /**
+   * @brief 事务模式构造器：Build() 只暂存到通道，由 ModelTransaction 统一提交。
+   *
+   * 引用存在性检查会延迟到 Commit() 时针对最终 ID 集合执行。
+   *
+   * @param lane 当前线程使用的事务通道。
+   * @param name 赋予特征的可读名称。
+   */
+  FeatureBuilderBase(TransactionLane &lane, const std::string &name)
+      : m_model(lane.GetModel()), m_lane(&lane) {
+    m_feature = std::make_shared<T>();
+    m_feature->featureName = name;
+    m_feature->featureID = StringHelper::GenerateUUID();
+  }
+
   /**
    * @brief 默认虚析构函数，确保派生类析构行为正确。
    */
@@ -63,7 +79,11 @@ public:
    * @brief 将构建完成的特征写入模型并返回其标识符。
    */
   std::string Build() {
-    m_model.AddFeature(m_feature);
+    if (m_lane) {
+      m_lane->Stage(m_feature);
+    } else {
+      m_model.AddFeature(m_feature);
+    }
     return m_feature->featureID;
   }
 
@@ -84,11 +104,9 @@ protected:
     if (ref->refType == RefType::FEATURE_DATUM_PLANE) {
       if (auto plane = std::dynamic_pointer_cast<const CRefPlane>(ref)) {
         if (!StandardID::IsStandardPlane(plane->targetFeatureID)) {
-          if (!m_model.GetFeature(plane->targetFeatureID)) {
-            throw std::runtime_error(
-                "Reference plane feature not found in model: " +
-                plane->targetFeatureID);
-          }
+          RequireFeature(plane->targetFeatureID, FeatureType::Unknown,
+                         "Reference plane feature not found in model: " +
+                             plane->targetFeatureID);
         }
       }
     }
@@ -96,11 +114,9 @@ protected:
     else if (ref->refType == RefType::FEATURE_DATUM_AXIS) {
       if (auto axis = std::dynamic_pointer_cast<const CRefAxis>(ref)) {
         if (!StandardID::IsStandardAxis(axis->targetFeatureID)) {
-          if (!m_model.GetFeature(axis->targetFeatureID)) {
-            throw std::runtime_error(
-                "Reference axis feature not found in model: " +
-                axis->targetFeatureID);
-          }
+          RequireFeature(axis->targetFeatureID, FeatureType::Unknown,
+                         "Reference axis feature not found in model: " +
+                             axis->targetFeatureID);
         }
       }
     }
@@ -108,18 +124,49 @@ protected:
     else if (ref->refType == RefType::FEATURE_DATUM_POINT) {
       if (auto pnt = std::dynamic_pointer_cast<const CRefPoint>(ref)) {
         if (!StandardID::IsStandardPoint(pnt->targetFeatureID)) {
-          if (!m_model.GetFeature(pnt->targetFeatureID)) {
-            throw std::runtime_error(
-                "Reference point feature not found in model: " +
-                pnt->targetFeatureID);
-          }
+          RequireFeature(pnt->targetFeatureID, FeatureType::Unknown,
+                         "Reference point feature not found in model: " +
+                             pnt->targetFeatureID);
         }
       }
     }
   }
 
+  /**
+   * @brief 检查被引用特征存在且类型匹配。
+   *
+   * 直接模式下立即查询模型，不满足时抛出；事务模式下登记到通道，
+   * 由 ModelTransaction::Commit() 统一校验。
+   *
+   * @param featureID 被引用特征 ID。
+   * @param expectedType 期望类型，FeatureType::Unknown 表示不限类型。
+   * @param message 校验失败时的错误文本。
+   * @throws std::runtime_error 直接模式下校验失败时抛出
+   */
+  void RequireFeature(const std::string &featureID, FeatureType expectedType,
+                      const std::string &message) const {
+    if (m_lane) {
+      m_lane->RequireFeature(featureID, expectedType, message);
+      return;
+    }
+    auto feature = m_model.GetFeature(featureID);
+    if (!feature || (expectedType != FeatureType::Unknown &&
+                     feature->featureType != expectedType)) {
+      throw std::runtime_error(message);
+    }
+  }
+
+  /**
+   * @brief 按名称查找特征 ID（事务模式下同时查找本通道已暂存的特征）。
+   */
+  std::string FindFeatureIdByName(const std::string &name) const {
+    return m_lane ? m_lane->FindFeatureIdByName(name)
+                  : m_model.GetFeatureIdByName(name);
+  }
+
   std::shared_ptr<T> m_feature;
   UnifiedModel &m_model;
+  TransactionLane *m_lane = nullptr; ///< 非空表示事务模式
 };
 
 } // namespace Builder
@@ -2,6 +2,7 @@
 // clang-format off
 #include "BuilderMacros.h"
 #include "StringHelper.h"
+#include "ModelTransaction.h"
 #include "FeatureBuilderBase.h"
 #include "ReferenceBuilder.h"
 #include "SketchBuilder.h"
@@ -13,6 +13,9 @@ public:
   FilletBuilder(UnifiedModel &model, const std::string &name)
       : FeatureBuilderBase(model, name) {}
 
+  FilletBuilder(TransactionLane &lane, const std::string &name)
+      : FeatureBuilderBase(lane, name) {}
+
   FilletBuilder &SetMode(FilletMode mode) {
     if (mode == FilletMode::UNKNOWN) {
       throw std::runtime_error("Fillet mode must not be UNKNOWN.");
@@ -0,0 +1,107 @@
+#pragma once
+// clang-format off
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+// clang-format on
+
+namespace CADExchange {
+
+/**
+ * @brief Builder 使用的特征 ID 分配器。
+ *
+ * 全局只维护一个块游标：每个线程一次性领取 kBlockSize 个连续序号，
+ * 之后在 thread_local 缓存中递增分配，热路径上不再写共享缓存行。
+ *
+ * 生成的 ID 保持 "FB-<n>" 形式，格式化通过 std::to_chars 在栈缓冲内完成。
+ * 序号不超过 12 位时 ID 不超过 15 个字符，通常落在 std::string 的小字符串
+ * 缓冲内；更长的序号仍然正确，只是可能产生一次堆分配。
+ *
+ * 确定性模式：调用 Reset(seed) 后，单线程下的 ID 序列从 seed 开始
+ * 严格递增，便于回归测试得到可复现的输出。
+ */
+class IdGenerator {
+public:
+  /// 每个线程单次领取的序号块大小。
+  static constexpr std::uint64_t kBlockSize = 1024;
+
+  /// Format 接受的最长前缀；余下空间足以容纳任意 uint64 序号。
+  static constexpr std::size_t kMaxPrefixLength = 12;
+
+  /**
+   * @brief 分配下一个序号（从 1 开始）。
+   */
+  static std::uint64_t NextSerial() {
+    LocalBlock &block = Local();
+    const std::uint64_t epoch = Epoch().load(std::memory_order_acquire);
+    if (block.epoch != epoch || block.next == block.end) {
+      block.next = Cursor().fetch_add(kBlockSize, std::memory_order_relaxed);
+      block.end = block.next + kBlockSize;
+      block.epoch = epoch;
+    }
+    return block.next++;
+  }
+
+  /**
+   * @brief 分配下一个特征 ID，形如 "FB-1"。
+   */
+  static std::string NextFeatureID() { return Format("FB-", NextSerial()); }
+
+  /**
+   * @brief 重置分配器，进入确定性序列。
+   *
+   * 所有线程已领取但未用完的序号块都会在下一次分配时作废。
+   * 应在没有其他线程正在构建特征时调用。
+   *
+   * @param firstSerial 下一次分配返回的序号。
+   */
+  static void Reset(std::uint64_t firstSerial = 1) {
+    Cursor().store(firstSerial, std::memory_order_relaxed);
+    Epoch().fetch_add(1, std::memory_order_release);
+  }
+
+  /**
+   * @brief 将前缀与序号格式化为 ID 字符串。
+   *
+   * 前缀超过 kMaxPrefixLength 时抛出 std::invalid_argument，而不是截断，
+   * 以免不同前缀生成相同 ID。
+   */
+  static std::string Format(std::string_view prefix, std::uint64_t serial) {
+    if (prefix.size() > kMaxPrefixLength) {
+      throw std::invalid_argument("ID prefix too long: " +
+                                  std::string(prefix));
+    }
+    char buffer[kMaxPrefixLength + 20];
+    prefix.copy(buffer, prefix.size());
+    const auto result = std::to_chars(buffer + prefix.size(),
+                                      buffer + sizeof(buffer), serial);
+    return std::string(buffer, static_cast<std::size_t>(result.ptr - buffer));
+  }
+
+private:
+  struct LocalBlock {
+    std::uint64_t next = 0;
+    std::uint64_t end = 0;
+    std::uint64_t epoch = ~std::uint64_t{0};
+  };
+
+  static LocalBlock &Local() {
+    thread_local LocalBlock block;
+    return block;
+  }
+
+  static std::atomic<std::uint64_t> &Cursor() {
+    alignas(64) static std::atomic<std::uint64_t> cursor{1};
+    return cursor;
+  }
+
+  static std::atomic<std::uint64_t> &Epoch() {
+    alignas(64) static std::atomic<std::uint64_t> epoch{0};
+    return epoch;
+  }
+};
+
+} // namespace CADExchange
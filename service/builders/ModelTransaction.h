@@ -0,0 +1,247 @@
+#pragma once
+// clang-format off
+#include "../../core/UnifiedModel.h"
+#include "../../core/detail/IoHelpers.h"
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+// clang-format on
+
+namespace CADExchange {
+namespace Builder {
+
+class ModelTransaction;
+
+/**
+ * @brief 事务中的单条暂存通道。
+ *
+ * 每个通道只允许一个线程使用：Builder 在通道上 Build() 时只追加到通道
+ * 自己的缓冲区，不触碰模型也不加锁。对其他通道或尚未提交特征的引用
+ * 校验会记录下来，延迟到 ModelTransaction::Commit() 统一执行。
+ */
+class TransactionLane {
+public:
+  TransactionLane(const TransactionLane &) = delete;
+  TransactionLane &operator=(const TransactionLane &) = delete;
+
+  /**
+   * @brief 获取事务的目标模型（暂存期间只读）。
+   */
+  UnifiedModel &GetModel() const { return m_model; }
+
+  /**
+   * @brief 暂存一个特征，提交时按暂存顺序写入模型。
+   */
+  void Stage(std::shared_ptr<CFeatureBase> feature) {
+    if (!feature) {
+      return;
+    }
+    m_localIndex[feature->featureID] = feature.get();
+    m_staged.push_back(std::move(feature));
+  }
+
+  /**
+   * @brief 登记一个引用检查：featureID 必须在提交后的模型中存在。
+   *
+   * 若目标已在模型或本通道中且类型匹配则立即通过，否则延迟到提交时检查。
+   *
+   * @param featureID 被引用特征 ID。
+   * @param expectedType 期望类型，FeatureType::Unknown 表示不限类型。
+   * @param message 检查失败时报告的错误文本。
+   */
+  void RequireFeature(const std::string &featureID, FeatureType expectedType,
+                      const std::string &message) {
+    if (const CFeatureBase *found = FindLocal(featureID)) {
+      if (MatchesType(*found, expectedType)) {
+        return;
+      }
+    }
+    m_pending.push_back({featureID, expectedType, message});
+  }
+
+  /**
+   * @brief 在模型与本通道已暂存的特征中按名称查找 ID。
+   *
+   * @return 找到返回特征 ID，否则返回空字符串。
+   */
+  std::string FindFeatureIdByName(const std::string &name) const {
+    for (const auto &feature : m_staged) {
+      if (feature->featureName == name) {
+        return feature->featureID;
+      }
+    }
+    return m_model.GetFeatureIdByName(name);
+  }
+
+  /**
+   * @brief 当前通道已暂存的特征数。
+   */
+  std::size_t StagedCount() const { return m_staged.size(); }
+
+private:
+  friend class ModelTransaction;
+
+  struct PendingCheck {
+    std::string featureID;
+    FeatureType expectedType = FeatureType::Unknown;
+    std::string message;
+  };
+
+  explicit TransactionLane(UnifiedModel &model) : m_model(model) {}
+
+  static bool MatchesType(const CFeatureBase &feature, FeatureType type) {
+    return type == FeatureType::Unknown || feature.featureType == type;
+  }
+
+  const CFeatureBase *FindLocal(const std::string &featureID) const {
+    if (auto it = m_localIndex.find(featureID); it != m_localIndex.end()) {
+      return it->second;
+    }
+    return m_model.GetFeature(featureID).get();
+  }
+
+  void Clear() {
+    m_staged.clear();
+    m_localIndex.clear();
+    m_pending.clear();
+  }
+
+  UnifiedModel &m_model;
+  std::vector<std::shared_ptr<CFeatureBase>> m_staged;
+  std::unordered_map<std::string, const CFeatureBase *> m_localIndex;
+  std::vector<PendingCheck> m_pending;
+};
+
+/**
+ * @brief 批量构建事务：多个 Builder（可跨线程）先暂存特征，再一次性提交。
+ *
+ * 用法：
+ * @code
+ *   ModelTransaction tx(model);
+ *   // 每个工作线程使用各自编号的通道
+ *   SketchBuilder sketch(tx.Lane(0), "Sketch1");
+ *   ...
+ *   std::string error;
+ *   if (!tx.Commit(&error)) { ... }
+ * @endcode
+ *
+ * 提交顺序是确定的：按通道编号升序，同一通道内按暂存顺序。
+ * 暂存期间不得直接修改目标模型；Commit() 需在所有工作线程结束后调用。
+ */
+class ModelTransaction {
+public:
+  explicit ModelTransaction(UnifiedModel &model) : m_model(model) {}
+
+  ModelTransaction(const ModelTransaction &) = delete;
+  ModelTransaction &operator=(const ModelTransaction &) = delete;
+
+  /**
+   * @brief 获取（必要时创建）指定编号的暂存通道。
+   *
+   * 本函数线程安全；返回的引用在事务生命周期内有效。
+   */
+  TransactionLane &Lane(std::size_t index) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto &lane = m_lanes[index];
+    if (!lane) {
+      lane.reset(new TransactionLane(m_model));
+    }
+    return *lane;
+  }
+
+  /**
+   * @brief 所有通道已暂存的特征总数。
+   */
+  std::size_t StagedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::size_t total = 0;
+    for (const auto &entry : m_lanes) {
+      total += entry.second->StagedCount();
+    }
+    return total;
+  }
+
+  /**
+   * @brief 校验并提交所有暂存特征。
+   *
+   * 先检查特征 ID 是否与模型或其他暂存特征重复，再针对最终 ID 集合统一
+   * 执行延迟的引用检查。任何一项失败都不会修改模型，暂存内容保留，
+   * 可由调用方 Rollback()。成功后模型 revision 只递增一次，事务清空。
+   *
+   * @param errorMessage 可选的错误输出。
+   * @return 提交成功返回 true。
+   */
+  bool Commit(std::string *errorMessage = nullptr) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::size_t total = 0;
+    for (const auto &entry : m_lanes) {
+      total += entry.second->m_staged.size();
+    }
+
+    std::vector<std::shared_ptr<CFeatureBase>> batch;
+    batch.reserve(total);
+    std::unordered_map<std::string, const CFeatureBase *> stagedIndex;
+    stagedIndex.reserve(total);
+    for (const auto &entry : m_lanes) {
+      for (const auto &feature : entry.second->m_staged) {
+        if (m_model.GetFeature(feature->featureID) ||
+            !stagedIndex.emplace(feature->featureID, feature.get()).second) {
+          return CADExchange::detail::Fail(
+              errorMessage,
+              "Duplicate feature ID in transaction: " + feature->featureID);
+        }
+        batch.push_back(feature);
+      }
+    }
+
+    for (const auto &entry : m_lanes) {
+      for (const auto &check : entry.second->m_pending) {
+        const CFeatureBase *target = nullptr;
+        if (auto it = stagedIndex.find(check.featureID);
+            it != stagedIndex.end()) {
+          target = it->second;
+        } else {
+          target = m_model.GetFeature(check.featureID).get();
+        }
+        if (!target ||
+            !TransactionLane::MatchesType(*target, check.expectedType)) {
+          return CADExchange::detail::Fail(errorMessage, check.message);
+        }
+      }
+    }
+
+    m_model.AddFeatures(batch);
+    ClearLanes();
+    if (errorMessage) {
+      errorMessage->clear();
+    }
+    return true;
+  }
+
+  /**
+   * @brief 丢弃所有暂存内容，模型保持不变。
+   */
+  void Rollback() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ClearLanes();
+  }
+
+private:
+  void ClearLanes() {
+    for (auto &entry : m_lanes) {
+      entry.second->Clear();
+    }
+  }
+
+  UnifiedModel &m_model;
+  mutable std::mutex m_mutex;
+  std::map<std::size_t, std::unique_ptr<TransactionLane>> m_lanes;
+};
+
+} // namespace Builder
+} // namespace CADExchange
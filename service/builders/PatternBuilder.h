@@ -16,6 +16,9 @@ public:
   LinearPatternBuilder(UnifiedModel &model, const std::string &name)
       : FeatureBuilderBase(model, name) {}
 
+  LinearPatternBuilder(TransactionLane &lane, const std::string &name)
+      : FeatureBuilderBase(lane, name) {}
+
   LinearPatternBuilder &SetDir1(const CLinearPatternDir &dir) {
     m_feature->dir1 = dir;
     return *this;
@@ -60,6 +63,9 @@ public:
   CircularPatternBuilder(UnifiedModel &model, const std::string &name)
       : FeatureBuilderBase(model, name) {}
 
+  CircularPatternBuilder(TransactionLane &lane, const std::string &name)
+      : FeatureBuilderBase(lane, name) {}
+
   CircularPatternBuilder &SetDir1(const CCircularPatternDir &dir) {
     m_feature->dir1 = dir;
     return *this;
@@ -104,6 +110,9 @@ public:
   MirrorPatternBuilder(UnifiedModel &model, const std::string &name)
       : FeatureBuilderBase(model, name) {}
 
+  MirrorPatternBuilder(TransactionLane &lane, const std::string &name)
+      : FeatureBuilderBase(lane, name) {}
+
   MirrorPatternBuilder &SetMirrorPlane(const std::shared_ptr<CRefEntityBase> &planeRef) {
     m_feature->mirrorPlaneRef = planeRef;
     return *this;
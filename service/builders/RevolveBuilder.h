@@ -16,12 +16,13 @@ class RevolveBuilder : public FeatureBuilderBase<CRevolve> {
 public:
   RevolveBuilder(UnifiedModel &model, const std::string &name)
       : FeatureBuilderBase(model, name) {}
+
+  RevolveBuilder(TransactionLane &lane, const std::string &name)
+      : FeatureBuilderBase(lane, name) {}
 
   RevolveBuilder &SetProfile(const std::string &sketchID) {
-    auto sketch = m_model.GetFeatureAs<CSketch>(sketchID);
-    if (!sketch) {
-      throw std::runtime_error("Sketch profile not found: " + sketchID);
-    }
+    RequireFeature(sketchID, FeatureType::Sketch,
+                   "Sketch profile not found: " + sketchID);
     m_feature->profileSketchID = sketchID;
     return *this;
   }
@@ -10,10 +10,12 @@ public:
   RibBuilder(UnifiedModel &model, const std::string &name)
       : FeatureBuilderBase(model, name) {}
 
+  RibBuilder(TransactionLane &lane, const std::string &name)
+      : FeatureBuilderBase(lane, name) {}
+
   RibBuilder &SetSectionSketch(const std::string &sketchID) {
-    if (!m_model.GetFeatureAs<CSketch>(sketchID)) {
-      throw std::runtime_error("Sketch profile not found: " + sketchID);
-    }
+    RequireFeature(sketchID, FeatureType::Sketch,
+                   "Sketch profile not found: " + sketchID);
     m_feature->sketchID = sketchID;
     return *this;
   }
@@ -19,6 +19,9 @@ public:
   ShellBuilder(UnifiedModel &model, const std::string &name)
       : FeatureBuilderBase(model, name) {}
 
+  ShellBuilder(TransactionLane &lane, const std::string &name)
+      : FeatureBuilderBase(lane, name) {}
+
   /**
    * @brief 设置默认壳壁厚度。
    * @param thickness 厚度值，必须 > 0。
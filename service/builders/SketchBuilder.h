@@ -6,6 +6,7 @@
 #include <initializer_list>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 // clang-format on
 namespace CADExchange {
 namespace Builder {
@@ -18,6 +19,9 @@ public:
   SketchBuilder(UnifiedModel &model, const std::string &name)
       : FeatureBuilderBase(model, name) {}
 
+  SketchBuilder(TransactionLane &lane, const std::string &name)
+      : FeatureBuilderBase(lane, name) {}
+
   /**
    * @brief 设置草图的参考面。
    *
@@ -69,7 +73,7 @@ public:
     auto line = std::make_shared<CSketchLine>();
     line->startPos = PointAdapter<PointT>::Convert(start);
     line->endPos = PointAdapter<PointT>::Convert(end);
-    line->localID = GenerateLocalID("L");
+    line->localID = GenerateLocalID("L_");
     line->isConstruction = isConstruction;
     m_feature->segments.push_back(line);
     return line->localID;
@@ -87,7 +91,7 @@ public:
     auto circle = std::make_shared<CSketchCircle>();
     circle->center = PointAdapter<PointT>::Convert(center);
     circle->radius = radius;
-    circle->localID = GenerateLocalID("C");
+    circle->localID = GenerateLocalID("C_");
     circle->isConstruction = isConstruction;
     m_feature->segments.push_back(circle);
     return circle->localID;
@@ -110,7 +114,7 @@ public:
     arc->endAngle = endAngle;
     arc->isClockwise = isClockwise;
     arc->isConstruction = isConstruction;
-    arc->localID = GenerateLocalID("A");
+    arc->localID = GenerateLocalID("A_");
     m_feature->segments.push_back(arc);
     return arc->localID;
   }
@@ -121,7 +125,7 @@ public:
   template <typename PointT> std::string AddPoint(const PointT &pos) {
     auto point = std::make_shared<CSketchPoint>();
     point->position = PointAdapter<PointT>::Convert(pos);
-    point->localID = GenerateLocalID("P");
+    point->localID = GenerateLocalID("P_");
     m_feature->segments.push_back(point);
     return point->localID;
   }
@@ -222,8 +226,8 @@ public:
 private:
   int m_localCounter = 0;
 
-  std::string GenerateLocalID(const std::string &prefix) {
-    return prefix + "_" + std::to_string(++m_localCounter);
+  std::string GenerateLocalID(std::string_view prefix) {
+    return IdGenerator::Format(prefix, ++m_localCounter);
   }
 
   SketchBuilder &AddConstraint(CSketchConstraint::ConstraintType type,
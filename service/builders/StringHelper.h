@@ -1,9 +1,12 @@
 ﻿#pragma once
 // clang-format off
-#include <atomic>
+#include "IdGenerator.h"
+#include <cstdint>
 #include <memory>
 #include <string>
+#ifdef _WIN32
 #include <windows.h> // 使用 Windows API 进行转换，稳定且支持中文
+#endif
 // clang-format on
 
 namespace CADExchange {
@@ -13,13 +16,11 @@ public:
   /**
    * @brief 生成简单的递增 UUID，用于测试和占位符。
    *
+   * 委托给 IdGenerator，多线程构建时按线程分块分配，不争用同一计数器。
+   *
    * @return 形如 "FB-1", "FB-2", ... 的字符串。
    */
-  static std::string GenerateUUID() {
-    static std::atomic<int> counter{0};
-    return "FB-" +
-           std::to_string(counter.fetch_add(1, std::memory_order_relaxed) + 1);
-  }
+  static std::string GenerateUUID() { return IdGenerator::NextFeatureID(); }
 
   /**
    * @brief 将宽字符串转换为 UTF-8 编码的字符串。
@@ -32,6 +33,7 @@ public:
       return std::string();
     }
 
+#ifdef _WIN32
     // 计算需要的缓冲区长度
     int size_needed = WideCharToMultiByte(
         CP_UTF8, 0, wstr.data(), (int)wstr.size(), NULL, 0, NULL, NULL);
@@ -41,6 +43,30 @@ public:
                         size_needed, NULL, NULL);
 
     return strTo;
+#else
+    // 非 Windows 平台 wchar_t 为 UTF-32，逐码点编码。
+    std::string strTo;
+    strTo.reserve(wstr.size());
+    for (wchar_t wc : wstr) {
+      const auto cp = static_cast<std::uint32_t>(wc);
+      if (cp < 0x80) {
+        strTo.push_back(static_cast<char>(cp));
+      } else if (cp < 0x800) {
+        strTo.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        strTo.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+      } else if (cp < 0x10000) {
+        strTo.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        strTo.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        strTo.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+      } else if (cp < 0x110000) {
+        strTo.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        strTo.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        strTo.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        strTo.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+      }
+    }
+    return strTo;
+#endif
   }
 
   /**
@@ -98,6 +124,7 @@ public:
       return std::wstring();
     }
 
+#ifdef _WIN32
     int size_needed =
         MultiByteToWideChar(CP_UTF8, 0, str.data(), (int)str.size(), NULL, 0);
 
@@ -105,6 +132,40 @@ public:
     MultiByteToWideChar(CP_UTF8, 0, &str[0], (int)str.size(), &wstrTo[0],
                         size_needed);
     return wstrTo;
+#else
+    // 非 Windows 平台逐码点解码，非法字节按 U+FFFD 处理。
+    std::wstring wstrTo;
+    wstrTo.reserve(str.size());
+    std::size_t i = 0;
+    while (i < str.size()) {
+      const auto lead = static_cast<unsigned char>(str[i]);
+      std::uint32_t cp = 0xFFFD;
+      std::size_t extra = 0;
+      if (lead < 0x80) {
+        cp = lead;
+      } else if ((lead & 0xE0) == 0xC0) {
+        cp = lead & 0x1F;
+        extra = 1;
+      } else if ((lead & 0xF0) == 0xE0) {
+        cp = lead & 0x0F;
+        extra = 2;
+      } else if ((lead & 0xF8) == 0xF0) {
+        cp = lead & 0x07;
+        extra = 3;
+      }
+      ++i;
+      for (std::size_t k = 0; k < extra; ++k, ++i) {
+        if (i >= str.size() ||
+            (static_cast<unsigned char>(str[i]) & 0xC0) != 0x80) {
+          cp = 0xFFFD;
+          break;
+        }
+        cp = (cp << 6) | (static_cast<unsigned char>(str[i]) & 0x3F);
+      }
+      wstrTo.push_back(static_cast<wchar_t>(cp));
+    }
+    return wstrTo;
+#endif
   }
 };
 } // namespace CADExchange
\ No newline at end of file
@@ -15,13 +15,15 @@ public:
   SweepBuilder(UnifiedModel &model, const std::string &name)
       : FeatureBuilderBase(model, name) {}
 
+  SweepBuilder(TransactionLane &lane, const std::string &name)
+      : FeatureBuilderBase(lane, name) {}
+
   /**
    * @brief Set the sweep profile by sketch feature ID.
    */
   SweepBuilder &SetProfile(const std::string &sketchID) {
-    if (!m_model.GetFeatureAs<CSketch>(sketchID)) {
-      throw std::runtime_error("Sketch profile not found: " + sketchID);
-    }
+    RequireFeature(sketchID, FeatureType::Sketch,
+                   "Sketch profile not found: " + sketchID);
     m_feature->profileSketchID = sketchID;
     m_feature->profile.kind = SweepProfileKind::SketchReference;
     m_feature->profile.sketchID = sketchID;
@@ -34,7 +36,7 @@ public:
    * @brief Set the sweep profile by sketch feature name.
    */
   SweepBuilder &SetProfileByName(const std::string &sketchName) {
-    auto sketchId = m_model.GetFeatureIdByName(sketchName);
+    auto sketchId = FindFeatureIdByName(sketchName);
     if (sketchId.empty() || sketchId == "UnknownSketchId") {
       throw std::runtime_error("Sketch not found by name: " + sketchName);
     }
@@ -226,19 +228,15 @@ private:
     ValidateReference(ref);
 
     if (auto sketch = std::dynamic_pointer_cast<CRefSketch>(ref)) {
-      if (!m_model.GetFeatureAs<CSketch>(sketch->targetFeatureID)) {
-        throw std::runtime_error("Sweep path sketch not found: " +
-                                 sketch->targetFeatureID);
-      }
+      RequireFeature(sketch->targetFeatureID, FeatureType::Sketch,
+                     "Sweep path sketch not found: " + sketch->targetFeatureID);
       return;
     }
 
     if (auto seg = std::dynamic_pointer_cast<CRefSketchSeg>(ref)) {
-      auto sketch = m_model.GetFeatureAs<CSketch>(seg->parentFeatureID);
-      if (!sketch) {
-        throw std::runtime_error("Sweep path sketch segment parent not found: " +
-                                 seg->parentFeatureID);
-      }
+      RequireFeature(seg->parentFeatureID, FeatureType::Sketch,
+                     "Sweep path sketch segment parent not found: " +
+                         seg->parentFeatureID);
       if (seg->segmentLocalID.empty()) {
         throw std::runtime_error(
             "Sweep path sketch segment local ID must not be empty.");
@@ -247,10 +245,10 @@ private:
     }
 
     if (auto subTopo = std::dynamic_pointer_cast<CRefSubTopo>(ref)) {
-      if (!subTopo->parentFeatureID.empty() &&
-          !m_model.GetFeature(subTopo->parentFeatureID)) {
-        throw std::runtime_error("Sweep path parent feature not found: " +
-                                 subTopo->parentFeatureID);
+      if (!subTopo->parentFeatureID.empty()) {
+        RequireFeature(subTopo->parentFeatureID, FeatureType::Unknown,
+                       "Sweep path parent feature not found: " +
+                           subTopo->parentFeatureID);
       }
     }
   }
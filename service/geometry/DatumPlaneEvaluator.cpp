@@ -0,0 +1,601 @@
+#include "DatumPlaneEvaluator.h"
+#include "VectorMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace CADExchange {
+namespace Geometry {
+
+namespace {
+
+/**
+ * @brief 引用解析后的几何：平面（点 + 法向 + X 方向）、直线或点。
+ */
+struct RefGeom {
+  enum class Kind { None, Plane, Line, Point } kind = Kind::None;
+  CPoint3D origin;
+  CVector3D dir;  ///< 平面法向或直线方向（单位向量）
+  CVector3D xDir; ///< 仅平面：X 方向提示，可为零
+  bool cyclic = false;
+  std::string message; ///< kind == None 时的原因
+};
+
+struct PlaneGeom {
+  CPoint3D origin;
+  CVector3D normal;
+  CVector3D xHint;
+};
+
+using Kind = RefGeom::Kind;
+using detail::Length;
+using detail::Normalized;
+using detail::Scaled;
+
+CVector3D Add(const CVector3D &a, const CVector3D &b) {
+  return {a.x + b.x, a.y + b.y, a.z + b.z};
+}
+
+/// 原地单位化；长度不足 EPSILON 时返回 false。
+bool Unit(CVector3D &v) { return Normalized(v, v); }
+
+/// 向量 v 绕单位轴 k 旋转 angle（Rodrigues）。
+CVector3D Rotate(const CVector3D &v, const CVector3D &k, double angle) {
+  const double c = std::cos(angle);
+  const double s = std::sin(angle);
+  return Add(Add(Scaled(v, c), Scaled(Cross(k, v), s)),
+             Scaled(k, Dot(k, v) * (1.0 - c)));
+}
+
+RefGeom MakePlane(const CPoint3D &origin, CVector3D normal, const CVector3D &xDir,
+                  const char *what) {
+  RefGeom geom;
+  if (!Unit(normal)) {
+    geom.message = std::string(what) + " normal is zero";
+    return geom;
+  }
+  geom.kind = Kind::Plane;
+  geom.origin = origin;
+  geom.dir = normal;
+  geom.xDir = xDir;
+  return geom;
+}
+
+RefGeom MakeLine(const CPoint3D &origin, CVector3D dir, const char *what) {
+  RefGeom geom;
+  if (!Unit(dir)) {
+    geom.message = std::string(what) + " direction is degenerate";
+    return geom;
+  }
+  geom.kind = Kind::Line;
+  geom.origin = origin;
+  geom.dir = dir;
+  return geom;
+}
+
+RefGeom MakePoint(const CPoint3D &position) {
+  RefGeom geom;
+  geom.kind = Kind::Point;
+  geom.origin = position;
+  return geom;
+}
+
+/**
+ * @brief 标准基准面，X 方向与 Ref::XY()/YZ()/ZX() 一致。
+ */
+RefGeom StandardPlane(const std::string &id) {
+  if (id == StandardID::PLANE_XY) {
+    return MakePlane(StandardID::kOrigin, StandardID::kPlaneXYNormal,
+                     StandardID::kAxisX, "plane");
+  }
+  if (id == StandardID::PLANE_YZ) {
+    return MakePlane(StandardID::kOrigin, StandardID::kPlaneYZNormal,
+                     StandardID::kAxisY, "plane");
+  }
+  return MakePlane(StandardID::kOrigin, StandardID::kPlaneZXNormal,
+                   StandardID::kAxisZ, "plane");
+}
+
+RefGeom StandardAxis(const std::string &id) {
+  if (id == StandardID::AXIS_X) {
+    return MakeLine(StandardID::kOrigin, StandardID::kAxisX, "axis");
+  }
+  if (id == StandardID::AXIS_Y) {
+    return MakeLine(StandardID::kOrigin, StandardID::kAxisY, "axis");
+  }
+  return MakeLine(StandardID::kOrigin, StandardID::kAxisZ, "axis");
+}
+
+/**
+ * @brief 非上游基准面的引用：面取采样点与法向，边取起止点连线。
+ */
+RefGeom ResolveLeaf(const CRefEntityBase &ref) {
+  if (const auto *plane = dynamic_cast<const CRefPlane *>(&ref)) {
+    return MakePlane(plane->origin, plane->normal, plane->xDir,
+                     "plane reference");
+  }
+  if (const auto *face = dynamic_cast<const CRefFace *>(&ref)) {
+    return MakePlane(face->centroid, face->normal, face->uDir, "face reference");
+  }
+  if (const auto *edge = dynamic_cast<const CRefEdge *>(&ref)) {
+    return MakeLine(edge->startPoint, edge->endPoint - edge->startPoint,
+                    "edge reference");
+  }
+  if (const auto *axis = dynamic_cast<const CRefAxis *>(&ref)) {
+    if (StandardID::IsStandardAxis(axis->targetFeatureID) &&
+        Length(axis->direction) < GeoUtils::EPSILON) {
+      return StandardAxis(axis->targetFeatureID);
+    }
+    return MakeLine(axis->origin, axis->direction, "axis reference");
+  }
+  if (const auto *vertex = dynamic_cast<const CRefVertex *>(&ref)) {
+    return MakePoint(vertex->pos);
+  }
+  if (const auto *point = dynamic_cast<const CRefPoint *>(&ref)) {
+    return MakePoint(point->position);
+  }
+  RefGeom geom;
+  geom.message = "reference type is not supported";
+  return geom;
+}
+
+/**
+ * @brief 约束与其引用几何的配对。
+ */
+struct Operand {
+  const PlaneConstraint *constraint = nullptr;
+  const RefGeom *geom = nullptr;
+};
+
+class Operands {
+public:
+  Operands(const CDatumPlane &plane, const std::vector<RefGeom> &refs) {
+    for (const auto &constraint : plane.constraints) {
+      if (constraint.ref >= 0 &&
+          constraint.ref < static_cast<int>(refs.size())) {
+        m_items.push_back({&constraint, &refs[constraint.ref]});
+      }
+    }
+  }
+
+  /// 第一个类型属于 types 且几何为 kind 的操作数；types 为空表示任意类型。
+  const Operand *Find(std::initializer_list<PlaneConstraintType> types,
+                      Kind kind) const {
+    for (const auto &item : m_items) {
+      if (item.geom->kind == kind &&
+          (types.size() == 0 ||
+           std::find(types.begin(), types.end(), item.constraint->type) !=
+               types.end())) {
+        return &item;
+      }
+    }
+    return nullptr;
+  }
+
+  std::vector<const Operand *> All(Kind kind) const {
+    std::vector<const Operand *> out;
+    for (const auto &item : m_items) {
+      if (item.geom->kind == kind) {
+        out.push_back(&item);
+      }
+    }
+    return out;
+  }
+
+private:
+  std::vector<Operand> m_items;
+};
+
+enum class SolveStatus { Ok, Unresolved, Unsupported };
+
+struct Solution {
+  SolveStatus status = SolveStatus::Unsupported;
+  PlaneGeom plane;
+  std::string message;
+};
+
+Solution Ok(const CPoint3D &origin, CVector3D normal, const CVector3D &xHint) {
+  Solution s;
+  if (!Unit(normal)) {
+    s.status = SolveStatus::Unresolved;
+    s.message = "references do not define a unique plane";
+    return s;
+  }
+  s.status = SolveStatus::Ok;
+  s.plane = {origin, normal, xHint};
+  return s;
+}
+
+Solution Unsupported(const char *message) {
+  Solution s;
+  s.status = SolveStatus::Unsupported;
+  s.message = message;
+  return s;
+}
+
+Solution SolveOffset(const Operands &ops) {
+  using T = PlaneConstraintType;
+  if (const Operand *dist = ops.Find({T::DISTANCE}, Kind::Plane)) {
+    const RefGeom &base = *dist->geom;
+    double sign = dist->constraint->reversed ? -1.0 : 1.0;
+    if (dist->constraint->defaultDir &&
+        Dot(*dist->constraint->defaultDir, base.dir) < 0.0) {
+      sign = -sign;
+    }
+    return Ok(base.origin + Scaled(base.dir, sign * dist->constraint->value),
+              base.dir, base.xDir);
+  }
+  const Operand *base = ops.Find({T::PARALLEL, T::COINCIDENT}, Kind::Plane);
+  if (!base) {
+    return Unsupported("needs a plane reference with DISTANCE or PARALLEL");
+  }
+  const Operand *through = ops.Find({T::COINCIDENT}, Kind::Point);
+  if (!through) {
+    through = ops.Find({T::COINCIDENT}, Kind::Line);
+  }
+  if (through) {
+    return Ok(through->geom->origin, base->geom->dir, base->geom->xDir);
+  }
+  if (base->constraint->type == T::COINCIDENT) {
+    return Ok(base->geom->origin, base->geom->dir, base->geom->xDir);
+  }
+  return Unsupported("PARALLEL plane needs a DISTANCE or a point to pass through");
+}
+
+Solution SolveAngle(const Operands &ops) {
+  using T = PlaneConstraintType;
+  const Operand *base = ops.Find({T::ANGLE}, Kind::Plane);
+  const Operand *axis = ops.Find({}, Kind::Line);
+  if (!base || !axis) {
+    return Unsupported("ANGLE plane needs an ANGLE plane reference and an axis");
+  }
+  const double angle =
+      base->constraint->reversed ? -base->constraint->value : base->constraint->value;
+  return Ok(axis->geom->origin, Rotate(base->geom->dir, axis->geom->dir, angle),
+            axis->geom->dir);
+}
+
+Solution SolvePerpendicular(const Operands &ops) {
+  using T = PlaneConstraintType;
+  if (const Operand *line = ops.Find({T::PERPENDICULAR}, Kind::Line)) {
+    const Operand *through = ops.Find({T::COINCIDENT}, Kind::Point);
+    return Ok(through ? through->geom->origin : line->geom->origin,
+              line->geom->dir, {});
+  }
+  const Operand *plane = ops.Find({T::PERPENDICULAR}, Kind::Plane);
+  const Operand *line = ops.Find({T::COINCIDENT}, Kind::Line);
+  if (!plane || !line) {
+    return Unsupported("PERPENDICULAR plane needs a line, or a plane and a line");
+  }
+  return Ok(line->geom->origin, Cross(line->geom->dir, plane->geom->dir),
+            line->geom->dir);
+}
+
+Solution SolveMidPlane(const Operands &ops, double angleTolerance) {
+  const auto planes = ops.All(Kind::Plane);
+  if (planes.size() < 2) {
+    return Unsupported("MID_PLANE needs two plane references");
+  }
+  const RefGeom &a = *planes[0]->geom;
+  const RefGeom &b = *planes[1]->geom;
+  const CVector3D nb = Dot(a.dir, b.dir) < 0.0 ? Scaled(b.dir, -1.0) : b.dir;
+  const CVector3D lineDir = Cross(a.dir, nb);
+  const double sinAngle = Length(lineDir);
+  if (sinAngle <= angleTolerance) {
+    const CPoint3D mid{(a.origin.x + b.origin.x) * 0.5,
+                       (a.origin.y + b.origin.y) * 0.5,
+                       (a.origin.z + b.origin.z) * 0.5};
+    return Ok(mid, a.dir, a.xDir);
+  }
+  // 交线上一点：p = (d1 (n2 × l) + d2 (l × n1)) / |l|²
+  const double d1 = Dot(a.dir, a.origin - CPoint3D{});
+  const double d2 = Dot(nb, b.origin - CPoint3D{});
+  const CVector3D p = Scaled(
+      Add(Scaled(Cross(nb, lineDir), d1), Scaled(Cross(lineDir, a.dir), d2)),
+      1.0 / (sinAngle * sinAngle));
+  return Ok(CPoint3D{} + p, Add(a.dir, nb), lineDir);
+}
+
+Solution SolveThreePoints(const Operands &ops) {
+  const auto points = ops.All(Kind::Point);
+  if (points.size() < 3) {
+    return Unsupported("THREE_POINTS needs three point references");
+  }
+  const CPoint3D &p0 = points[0]->geom->origin;
+  const CVector3D u = points[1]->geom->origin - p0;
+  const CVector3D v = points[2]->geom->origin - p0;
+  return Ok(p0, Cross(u, v), u);
+}
+
+Solution SolveLine(const Operands &ops) {
+  using T = PlaneConstraintType;
+  const auto lines = ops.All(Kind::Line);
+  if (lines.empty()) {
+    return Unsupported("LINE plane needs a line reference");
+  }
+  const RefGeom &l1 = *lines[0]->geom;
+  if (lines.size() >= 2) {
+    const RefGeom &l2 = *lines[1]->geom;
+    CVector3D normal = Cross(l1.dir, l2.dir);
+    if (Length(normal) < GeoUtils::EPSILON) {
+      normal = Cross(l1.dir, l2.origin - l1.origin);
+    }
+    return Ok(l1.origin, normal, l1.dir);
+  }
+  if (const Operand *point = ops.Find({}, Kind::Point)) {
+    return Ok(l1.origin, Cross(l1.dir, point->geom->origin - l1.origin), l1.dir);
+  }
+  if (const Operand *plane = ops.Find({T::PERPENDICULAR}, Kind::Plane)) {
+    return Ok(l1.origin, Cross(l1.dir, plane->geom->dir), l1.dir);
+  }
+  if (const Operand *plane = ops.Find({T::PARALLEL}, Kind::Plane)) {
+    return Ok(l1.origin, plane->geom->dir, l1.dir);
+  }
+  return Unsupported("LINE plane needs a second line, a point or a plane");
+}
+
+Solution SolveTangent(const Operands &ops) {
+  const Operand *face = ops.Find({PlaneConstraintType::TANGENT}, Kind::Plane);
+  if (!face) {
+    return Unsupported("TANGENT plane needs a TANGENT face reference");
+  }
+  return Ok(face->geom->origin, face->geom->dir, face->geom->xDir);
+}
+
+/**
+ * @brief 平面 → 坐标系：原点取离全局原点最近的点，X 方向取提示在平面内的
+ *        投影（退化时取与法向最不平行的坐标轴）。
+ */
+CSketchCSys ToCSys(const CPoint3D &anyPoint, const CVector3D &normal,
+                   const CVector3D &xHint) {
+  CSketchCSys csys;
+  csys.zDir = normal;
+  csys.origin = ProjectPointToPlaneOrigin(anyPoint, normal).value_or(anyPoint);
+  CVector3D x = Add(xHint, Scaled(normal, -Dot(xHint, normal)));
+  if (!Unit(x)) {
+    const double ax = std::abs(normal.x);
+    const double ay = std::abs(normal.y);
+    const double az = std::abs(normal.z);
+    const CVector3D axis = ax <= ay && ax <= az   ? CVector3D{1, 0, 0}
+                           : ay <= az             ? CVector3D{0, 1, 0}
+                                                  : CVector3D{0, 0, 1};
+    x = Add(axis, Scaled(normal, -Dot(axis, normal)));
+    Unit(x);
+  }
+  csys.xDir = x;
+  csys.yDir = Cross(normal, x);
+  csys.valid = true;
+  return csys;
+}
+
+} // namespace
+
+DatumPlaneEvaluator::DatumPlaneEvaluator(const UnifiedModel &model,
+                                         double lengthTolerance,
+                                         double angleTolerance)
+    : m_model(model), m_lengthTolerance(lengthTolerance),
+      m_angleTolerance(angleTolerance), m_revision(model.GetRevision()) {
+  if (m_lengthTolerance <= 0.0 &&
+      !TryGetGeometryCompareTolerance(model.unit, m_lengthTolerance)) {
+    throw std::invalid_argument("DatumPlaneEvaluator: unsupported model unit");
+  }
+}
+
+void DatumPlaneEvaluator::SyncRevision() {
+  if (m_model.GetRevision() != m_revision) {
+    InvalidateAll();
+    m_revision = m_model.GetRevision();
+  }
+}
+
+DatumPlaneResult DatumPlaneEvaluator::Evaluate(const std::string &featureID) {
+  SyncRevision();
+  if (auto it = m_cache.find(featureID); it != m_cache.end()) {
+    return it->second;
+  }
+  DatumPlaneResult result;
+  result.featureID = featureID;
+  auto plane = m_model.GetFeatureAs<CDatumPlane>(featureID);
+  if (!plane) {
+    result.message = "'" + featureID + "' is not a datum plane";
+    return result;
+  }
+  if (m_inProgress.count(featureID)) {
+    result.status = DatumPlaneStatus::Cyclic;
+    result.message = "dependency cycle through '" + featureID + "'";
+    return result;
+  }
+  m_inProgress.insert(featureID);
+  result = Compute(*plane);
+  m_inProgress.erase(featureID);
+  m_cache[featureID] = result;
+  return result;
+}
+
+DatumPlaneResult DatumPlaneEvaluator::Compute(const CDatumPlane &plane) {
+  ++m_computeCount;
+  DatumPlaneResult result;
+  result.featureID = plane.featureID;
+
+  // 1. 解析引用；上游基准面递归求值（记忆化）并登记反向依赖。
+  std::vector<RefGeom> refs(plane.referenceEntities.size());
+  for (std::size_t i = 0; i < refs.size(); ++i) {
+    const auto &ref = plane.referenceEntities[i];
+    if (!ref) {
+      refs[i].message = "reference is null";
+      continue;
+    }
+    const auto *planeRef = dynamic_cast<const CRefPlane *>(ref.get());
+    if (planeRef && StandardID::IsStandardPlane(planeRef->targetFeatureID)) {
+      refs[i] = StandardPlane(planeRef->targetFeatureID);
+      continue;
+    }
+    if (planeRef && planeRef->targetFeatureID != plane.featureID &&
+        m_model.GetFeatureAs<CDatumPlane>(planeRef->targetFeatureID)) {
+      auto &dependents = m_dependents[planeRef->targetFeatureID];
+      if (std::find(dependents.begin(), dependents.end(), plane.featureID) ==
+          dependents.end()) {
+        dependents.push_back(plane.featureID);
+      }
+      const DatumPlaneResult upstream = Evaluate(planeRef->targetFeatureID);
+      if (upstream.HasPlane()) {
+        refs[i] = MakePlane(upstream.csys.origin, upstream.csys.zDir,
+                            upstream.csys.xDir, "upstream plane");
+        continue;
+      }
+      refs[i] = ResolveLeaf(*ref);
+      refs[i].cyclic = upstream.status == DatumPlaneStatus::Cyclic;
+      if (refs[i].kind == Kind::None || refs[i].cyclic) {
+        refs[i].kind = Kind::None;
+        refs[i].message = "upstream '" + planeRef->targetFeatureID +
+                          "': " + upstream.message;
+      }
+      continue;
+    }
+    refs[i] = ResolveLeaf(*ref);
+  }
+
+  // 2. 按方法求解。
+  Solution solution;
+  const RefGeom *failed = nullptr;
+  for (const auto &constraint : plane.constraints) {
+    if (constraint.ref >= 0 && constraint.ref < static_cast<int>(refs.size()) &&
+        refs[constraint.ref].kind == Kind::None) {
+      failed = &refs[constraint.ref];
+      break;
+    }
+  }
+  if (failed) {
+    solution.status = SolveStatus::Unresolved;
+    solution.message = "reference " + failed->message;
+  } else {
+    const Operands ops(plane, refs);
+    switch (plane.method) {
+    case PlaneMethod::OFFSET:
+    case PlaneMethod::PARALLEL:
+      solution = SolveOffset(ops);
+      break;
+    case PlaneMethod::ANGLE:
+      solution = SolveAngle(ops);
+      break;
+    case PlaneMethod::PERPENDICULAR:
+      solution = SolvePerpendicular(ops);
+      break;
+    case PlaneMethod::MID_PLANE:
+      solution = SolveMidPlane(ops, m_angleTolerance);
+      break;
+    case PlaneMethod::THREE_POINTS:
+      solution = SolveThreePoints(ops);
+      break;
+    case PlaneMethod::LINE:
+      solution = SolveLine(ops);
+      break;
+    case PlaneMethod::TANGENT:
+      solution = SolveTangent(ops);
+      break;
+    default:
+      solution = Unsupported("method is not evaluated from its definition");
+      break;
+    }
+  }
+
+  // 3. 成功则与存储值比对；失败则回退到存储值。
+  CVector3D storedNormal = plane.normal.value_or(CVector3D{});
+  const bool hasStoredNormal = plane.normal && Unit(storedNormal);
+  if (solution.status == SolveStatus::Ok) {
+    result.status = DatumPlaneStatus::Evaluated;
+    result.csys = ToCSys(solution.plane.origin, solution.plane.normal,
+                         solution.plane.xHint);
+    if (hasStoredNormal) {
+      result.hasStored = true;
+      const double dot = Dot(result.csys.zDir, storedNormal);
+      result.normalFlipped = dot < 0.0;
+      result.normalDeviation = std::acos(std::min(1.0, std::abs(dot)));
+      if (plane.projectedOrigin) {
+        result.originDeviation = std::abs(
+            Dot(result.csys.zDir, *plane.projectedOrigin - result.csys.origin));
+      }
+      result.agreesWithStored = result.normalDeviation <= m_angleTolerance &&
+                                result.originDeviation <= m_lengthTolerance;
+      if (!result.agreesWithStored) {
+        result.message = "evaluated plane deviates from stored values (normal " +
+                         std::to_string(result.normalDeviation) +
+                         " rad, origin " +
+                         std::to_string(result.originDeviation) + ")";
+      }
+    }
+    return result;
+  }
+
+  bool cyclic = false;
+  for (const auto &ref : refs) {
+    cyclic = cyclic || ref.cyclic;
+  }
+  if (cyclic) {
+    result.status = DatumPlaneStatus::Cyclic;
+    result.message = solution.message;
+  } else if (hasStoredNormal && plane.projectedOrigin) {
+    result.status = DatumPlaneStatus::FromStored;
+    result.csys = ToCSys(*plane.projectedOrigin, storedNormal, {});
+    result.message = solution.message;
+  } else {
+    result.status = solution.status == SolveStatus::Unresolved
+                        ? DatumPlaneStatus::Unresolved
+                        : DatumPlaneStatus::Unsupported;
+    result.message = solution.message;
+  }
+  return result;
+}
+
+std::vector<DatumPlaneResult> DatumPlaneEvaluator::EvaluateAll() {
+  SyncRevision();
+  std::vector<DatumPlaneResult> results;
+  for (const auto &feature : m_model.GetFeatures()) {
+    if (feature && feature->featureType == FeatureType::DatumPlane) {
+      results.push_back(Evaluate(feature->featureID));
+    }
+  }
+  return results;
+}
+
+std::vector<DatumPlaneResult> DatumPlaneEvaluator::Disagreements() {
+  std::vector<DatumPlaneResult> results = EvaluateAll();
+  results.erase(std::remove_if(results.begin(), results.end(),
+                               [](const DatumPlaneResult &r) {
+                                 return r.agreesWithStored;
+                               }),
+                results.end());
+  return results;
+}
+
+std::size_t DatumPlaneEvaluator::Invalidate(const std::string &featureID) {
+  std::size_t erased = 0;
+  std::vector<std::string> pending{featureID};
+  while (!pending.empty()) {
+    const std::string id = std::move(pending.back());
+    pending.pop_back();
+    erased += m_cache.erase(id);
+    // 下游重新求值时会重新登记依赖，这里直接摘除整条边表。
+    auto it = m_dependents.find(id);
+    if (it == m_dependents.end()) {
+      continue;
+    }
+    std::vector<std::string> dependents = std::move(it->second);
+    m_dependents.erase(it);
+    pending.insert(pending.end(), dependents.begin(), dependents.end());
+  }
+  return erased;
+}
+
+void DatumPlaneEvaluator::InvalidateAll() {
+  m_cache.clear();
+  m_dependents.clear();
+}
+
+bool DatumPlaneEvaluator::IsCached(const std::string &featureID) const {
+  return m_cache.count(featureID) != 0;
+}
+
+} // namespace Geometry
+} // namespace CADExchange
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "../../core/UnifiedModel.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace CADExchange {
+namespace Geometry {
+
+enum class DatumPlaneStatus {
+  Evaluated,   ///< 由定义（方法 + 约束 + 引用）求得
+  FromStored,  ///< 定义无法求值，回退到存储的 projectedOrigin/normal
+  Unresolved,  ///< 引用几何缺失/退化，且无存储值可回退
+  Unsupported, ///< 方法或约束组合不受支持，且无存储值可回退
+  Cyclic       ///< 依赖链成环
+};
+
+/**
+ * @brief 单个基准面的求值结果。
+ *
+ * csys.origin 为平面上离全局原点最近的点（与 projectedOrigin 同口径），
+ * zDir 为单位法向，xDir/yDir 沿上游平面的 X 方向投影得到。
+ */
+struct DatumPlaneResult {
+  std::string featureID;
+  DatumPlaneStatus status = DatumPlaneStatus::Unresolved;
+  CSketchCSys csys; ///< status 为 Evaluated/FromStored 时 valid
+  std::string message;
+
+  /// 与存储值的比对（仅 status == Evaluated 且存在存储 normal 时有效）。
+  bool hasStored = false;
+  bool agreesWithStored = true;
+  bool normalFlipped = false;   ///< 法向与存储值反向（同一平面，朝向不同）
+  double normalDeviation = 0.0; ///< 法向夹角（弧度，不计朝向）
+  double originDeviation = 0.0; ///< 存储 projectedOrigin 到求得平面的距离
+
+  bool HasPlane() const {
+    return status == DatumPlaneStatus::Evaluated ||
+           status == DatumPlaneStatus::FromStored;
+  }
+};
+
+/**
+ * @brief 基准面求值器：按定义计算基准面坐标系，沿依赖链记忆化。
+ *
+ * 支持的方法与约束组合：
+ *   - OFFSET / PARALLEL：平面引用 + DISTANCE（沿法向偏置；defaultDir 与
+ *     法向反向或 reversed 时反向偏置），或平面 + COINCIDENT 点/线；
+ *   - ANGLE：平面引用 + ANGLE（弧度）+ COINCIDENT 线（旋转轴）；
+ *   - PERPENDICULAR：垂直于线（过 COINCIDENT 点，缺省过线起点），或垂直
+ *     于平面且过线；
+ *   - MID_PLANE：两个平面引用的中面（平行时取等距面，否则取角平分面）；
+ *   - THREE_POINTS：三个点（顶点/基准点）；
+ *   - LINE：线 + 线 / 线 + 点 / 线 + 平面（PARALLEL 或 PERPENDICULAR）；
+ *   - TANGENT：与面引用相切（取面采样点与法向）；
+ *   - FIXED：直接采用存储值。
+ *
+ * 平面引用指向模型内另一基准面时递归求值并记忆化，标准基准面使用
+ * StandardID 常量，其余采用 CRefPlane 上的几何快照。面引用取采样点与
+ * 法向，边引用取起止点连线。
+ *
+ * 结果按特征 ID 缓存；原地修改某个基准面后调用 Invalidate()，只清除它
+ * 与其下游依赖的缓存。模型增删特征（revision 变化）时清空全部缓存。
+ * 本类不是线程安全的。
+ */
+class DatumPlaneEvaluator {
+public:
+  /**
+   * @param lengthTolerance 与存储值比对的距离容差；<= 0 时取
+   *        TryGetGeometryCompareTolerance(model.unit)。
+   * @throws std::invalid_argument 当需要单位容差而单位不受支持时。
+   */
+  explicit DatumPlaneEvaluator(const UnifiedModel &model,
+                               double lengthTolerance = 0.0,
+                               double angleTolerance = 1e-6);
+
+  DatumPlaneEvaluator(const DatumPlaneEvaluator &) = delete;
+  DatumPlaneEvaluator &operator=(const DatumPlaneEvaluator &) = delete;
+
+  /**
+   * @brief 求值一个基准面（命中缓存时直接返回）。
+   *
+   * featureID 不是基准面时返回 Unresolved。
+   */
+  DatumPlaneResult Evaluate(const std::string &featureID);
+
+  /**
+   * @brief 按特征顺序求值模型中全部基准面，一次遍历完成整条依赖链。
+   */
+  std::vector<DatumPlaneResult> EvaluateAll();
+
+  /**
+   * @brief 求值全部基准面（命中缓存）并返回与存储值不一致者。
+   */
+  std::vector<DatumPlaneResult> Disagreements();
+
+  /**
+   * @brief 清除 featureID 及其全部下游基准面的缓存。
+   * @return 被清除的缓存条目数。
+   */
+  std::size_t Invalidate(const std::string &featureID);
+  void InvalidateAll();
+
+  bool IsCached(const std::string &featureID) const;
+  std::size_t CacheSize() const { return m_cache.size(); }
+  /// 实际执行的求值次数（不含缓存命中），用于确认记忆化效果。
+  std::size_t ComputeCount() const { return m_computeCount; }
+
+  double GetLengthTolerance() const { return m_lengthTolerance; }
+
+private:
+  void SyncRevision();
+  DatumPlaneResult Compute(const CDatumPlane &plane);
+
+  const UnifiedModel &m_model;
+  double m_lengthTolerance;
+  double m_angleTolerance;
+  std::uint64_t m_revision;
+  std::size_t m_computeCount = 0;
+  std::unordered_map<std::string, DatumPlaneResult> m_cache;
+  std::unordered_set<std::string> m_inProgress;
+  /// 上游基准面 ID -> 直接引用它的基准面 ID。
+  std::unordered_map<std::string, std::vector<std::string>> m_dependents;
+};
+
+} // namespace Geometry
+} // namespace CADExchange
@@ -0,0 +1,513 @@
+#include "EdgeChainBuilder.h"
+#include "../../core/detail/IoHelpers.h"
+#include "VectorMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+
+namespace CADExchange {
+namespace Geometry {
+
+namespace {
+
+using CADExchange::detail::Fnv1aHasher;
+using detail::Distance;
+using detail::Normalized;
+using detail::Scaled;
+
+// 切向求值只排除退化的零长弦/法向，阈值远小于几何容差。
+constexpr double kMinDirectionLength = 1e-12;
+
+/**
+ * @brief 三维均匀哈希网格，邻域查询遍历相邻 27 个单元。
+ */
+class PointGrid {
+public:
+  explicit PointGrid(double cellSize) : m_inverseCell(1.0 / cellSize) {}
+
+  template <typename Fn> void ForNeighbours(const CPoint3D &p, Fn &&fn) const {
+    const std::int64_t cx = Cell(p.x);
+    const std::int64_t cy = Cell(p.y);
+    const std::int64_t cz = Cell(p.z);
+    for (std::int64_t dx = -1; dx <= 1; ++dx) {
+      for (std::int64_t dy = -1; dy <= 1; ++dy) {
+        for (std::int64_t dz = -1; dz <= 1; ++dz) {
+          auto it = m_cells.find(KeyOf(cx + dx, cy + dy, cz + dz));
+          if (it == m_cells.end()) {
+            continue;
+          }
+          for (int index : it->second) {
+            fn(index);
+          }
+        }
+      }
+    }
+  }
+
+  void Insert(const CPoint3D &p, int index) {
+    m_cells[KeyOf(Cell(p.x), Cell(p.y), Cell(p.z))].push_back(index);
+  }
+
+private:
+  std::int64_t Cell(double v) const {
+    return static_cast<std::int64_t>(std::floor(v * m_inverseCell));
+  }
+
+  // 不同网格单元的键可能碰撞，调用方逐点比较距离，碰撞只影响桶大小。
+  static std::uint64_t KeyOf(std::int64_t x, std::int64_t y, std::int64_t z) {
+    return static_cast<std::uint64_t>(x) * 73856093ull ^
+           static_cast<std::uint64_t>(y) * 19349663ull ^
+           static_cast<std::uint64_t>(z) * 83492791ull;
+  }
+
+  double m_inverseCell;
+  std::unordered_map<std::uint64_t, std::vector<int>> m_cells;
+};
+
+/**
+ * @brief 哈希网格顶点吸附：容差内的端点合并为同一顶点。
+ */
+class VertexSnapper {
+public:
+  explicit VertexSnapper(double tolerance)
+      : m_tolerance(tolerance), m_grid(tolerance) {}
+
+  int Snap(const CPoint3D &p) {
+    int best = -1;
+    double bestDistance = m_tolerance;
+    m_grid.ForNeighbours(p, [&](int index) {
+      const double d = Distance(vertices[index], p);
+      if (d <= bestDistance) {
+        best = index;
+        bestDistance = d;
+      }
+    });
+    if (best >= 0) {
+      return best;
+    }
+    const int index = static_cast<int>(vertices.size());
+    vertices.push_back(p);
+    m_grid.Insert(p, index);
+    return index;
+  }
+
+  std::vector<CPoint3D> vertices;
+
+private:
+  double m_tolerance;
+  PointGrid m_grid;
+};
+
+/**
+ * @brief 吸附后的边：两端顶点与沿 start→end 方向的端点单位切向。
+ */
+struct GraphEdge {
+  std::size_t reference = 0;
+  int v0 = 0;
+  int v1 = 0;
+  CVector3D tangentStart;
+  CVector3D tangentEnd;
+  bool hasTangent = false;
+};
+
+/**
+ * @brief 由 start/mid/end 求端点切向：三点共线（或 mid 退化）按直线，
+ *        否则按过三点的圆弧。
+ */
+void ComputeTangents(const CRefEdge &edge, double tolerance, GraphEdge &out) {
+  const CPoint3D &s = edge.startPoint;
+  const CPoint3D &m = edge.midPoint;
+  const CPoint3D &e = edge.endPoint;
+  CVector3D chord;
+  if (!Normalized(e - s, chord, kMinDirectionLength) ||
+      Distance(s, e) <= tolerance) {
+    return; // 闭合或零长边
+  }
+  out.hasTangent = true;
+  out.tangentStart = chord;
+  out.tangentEnd = chord;
+
+  const CVector3D a = m - s;
+  const CVector3D b = e - m;
+  const CVector3D n = a.Cross(b);
+  const double la = std::sqrt(a.Dot(a));
+  const double lb = std::sqrt(b.Dot(b));
+  if (edge.curveType == CGeoCurveType::LINE || la <= tolerance ||
+      lb <= tolerance || std::sqrt(n.Dot(n)) <= 1e-9 * la * lb) {
+    return;
+  }
+
+  // 外接圆圆心：s + (|w|²(u×w)×u + |u|² w×(u×w)) / (2|u×w|²)，u = m-s，w = e-s。
+  const CVector3D u = a;
+  const CVector3D w = e - s;
+  const CVector3D uw = u.Cross(w);
+  const double denom = 2.0 * uw.Dot(uw);
+  const CVector3D t1 = Scaled(uw.Cross(u), w.Dot(w));
+  const CVector3D t2 = Scaled(w.Cross(uw), u.Dot(u));
+  const CPoint3D center =
+      s + CVector3D{(t1.x + t2.x) / denom, (t1.y + t2.y) / denom,
+                    (t1.z + t2.z) / denom};
+  CVector3D ts, te;
+  if (Normalized(n.Cross(s - center), ts, kMinDirectionLength) &&
+      Normalized(n.Cross(e - center), te, kMinDirectionLength)) {
+    out.tangentStart = ts;
+    out.tangentEnd = te;
+  }
+}
+
+double TurnAngle(const CVector3D &incoming, const CVector3D &outgoing) {
+  const double c = std::max(-1.0, std::min(1.0, incoming.Dot(outgoing)));
+  return std::acos(c);
+}
+
+void ReverseChain(EdgeChainResult &result, std::size_t index) {
+  EdgeChain &chain = result.chains[index];
+  std::reverse(chain.edges.begin(), chain.edges.end());
+  for (auto &edge : chain.edges) {
+    edge.reversed = !edge.reversed;
+  }
+  if (chain.closed && !chain.joints.empty()) {
+    std::reverse(chain.joints.begin(), chain.joints.end() - 1);
+  } else {
+    std::reverse(chain.joints.begin(), chain.joints.end());
+  }
+  std::swap(chain.start, chain.end);
+  for (auto &gap : result.gaps) {
+    if (gap.chainA == index) {
+      gap.atEndA = !gap.atEndA;
+    }
+    if (gap.chainB == index) {
+      gap.atEndB = !gap.atEndB;
+    }
+  }
+}
+
+class ContentHasher {
+public:
+  void Bytes(const void *data, std::size_t size) { m_hasher.Mix(data, size); }
+
+  void Double(double value) {
+    if (value == 0.0) {
+      value = 0.0; // 归一化 -0.0
+    }
+    Bytes(&value, sizeof(value));
+  }
+
+  void Point(const CPoint3D &p) {
+    Double(p.x);
+    Double(p.y);
+    Double(p.z);
+  }
+
+  void Int(std::uint64_t value) { Bytes(&value, sizeof(value)); }
+
+  void References(const std::vector<std::shared_ptr<CRefEntityBase>> &refs) {
+    Int(refs.size());
+    for (const auto &ref : refs) {
+      const auto *edge = dynamic_cast<const CRefEdge *>(ref.get());
+      if (!edge) {
+        Int(~0ull);
+        continue;
+      }
+      Int(static_cast<std::uint64_t>(edge->curveType));
+      Point(edge->startPoint);
+      Point(edge->midPoint);
+      Point(edge->endPoint);
+    }
+  }
+
+  void OptionalPoint(const std::optional<CPoint3D> &p) {
+    Int(p ? 1 : 0);
+    if (p) {
+      Point(*p);
+    }
+  }
+
+  std::uint64_t Value() const { return m_hasher.Value(); }
+
+private:
+  Fnv1aHasher m_hasher;
+};
+
+} // namespace
+
+EdgeChainResult EdgeChainBuilder::Compute(
+    const std::vector<std::shared_ptr<CRefEntityBase>> &references,
+    double tolerance, double angleTolerance, double gapTolerance) {
+  EdgeChainResult result;
+  VertexSnapper snapper(tolerance);
+  std::vector<GraphEdge> edges;
+  edges.reserve(references.size());
+  for (std::size_t i = 0; i < references.size(); ++i) {
+    const auto *edge = dynamic_cast<const CRefEdge *>(references[i].get());
+    if (!edge) {
+      result.skippedReferences.push_back(i);
+      continue;
+    }
+    GraphEdge graphEdge;
+    graphEdge.reference = i;
+    graphEdge.v0 = snapper.Snap(edge->startPoint);
+    graphEdge.v1 = snapper.Snap(edge->endPoint);
+    ComputeTangents(*edge, tolerance, graphEdge);
+    edges.push_back(graphEdge);
+  }
+
+  // 压缩邻接表（CSR）；闭合边单独成链，不计入顶点度数。
+  const std::size_t vertexCount = snapper.vertices.size();
+  std::vector<std::uint32_t> offsets(vertexCount + 1, 0);
+  for (const auto &edge : edges) {
+    if (edge.v0 != edge.v1) {
+      ++offsets[edge.v0 + 1];
+      ++offsets[edge.v1 + 1];
+    }
+  }
+  for (std::size_t v = 0; v < vertexCount; ++v) {
+    offsets[v + 1] += offsets[v];
+  }
+  std::vector<std::uint32_t> incident(offsets.back());
+  {
+    std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (std::size_t e = 0; e < edges.size(); ++e) {
+      if (edges[e].v0 != edges[e].v1) {
+        incident[cursor[edges[e].v0]++] = static_cast<std::uint32_t>(e);
+        incident[cursor[edges[e].v1]++] = static_cast<std::uint32_t>(e);
+      }
+    }
+  }
+  auto degree = [&](int v) { return offsets[v + 1] - offsets[v]; };
+
+  std::vector<char> visited(edges.size(), 0);
+  auto travelStart = [&](const ChainEdge &ce, const GraphEdge &e) {
+    return ce.reversed ? Scaled(e.tangentEnd, -1.0) : e.tangentStart;
+  };
+  auto travelEnd = [&](const ChainEdge &ce, const GraphEdge &e) {
+    return ce.reversed ? Scaled(e.tangentStart, -1.0) : e.tangentEnd;
+  };
+  // edges 下标 -> 链内 GraphEdge，供转角计算。
+  std::vector<std::uint32_t> chainEdgeIndex;
+
+  auto finishChain = [&](EdgeChain &chain, bool closed) {
+    chain.closed = closed;
+    const std::size_t count = chain.edges.size();
+    const std::size_t joints = closed ? count : count - 1;
+    for (std::size_t j = 0; j < joints; ++j) {
+      const GraphEdge &a = edges[chainEdgeIndex[j]];
+      const GraphEdge &b = edges[chainEdgeIndex[(j + 1) % count]];
+      double angle = 0.0;
+      if (a.hasTangent && b.hasTangent && count > 1) {
+        angle = TurnAngle(travelEnd(chain.edges[j], a),
+                          travelStart(chain.edges[(j + 1) % count], b));
+      }
+      chain.joints.push_back(angle);
+      chain.maxTurnAngle = std::max(chain.maxTurnAngle, angle);
+    }
+    chain.tangentContinuous = chain.maxTurnAngle <= angleTolerance;
+    result.chains.push_back(std::move(chain));
+  };
+
+  auto walk = [&](int startVertex, std::uint32_t firstEdge) {
+    EdgeChain chain;
+    chainEdgeIndex.clear();
+    chain.start = snapper.vertices[startVertex];
+    int vertex = startVertex;
+    std::uint32_t e = firstEdge;
+    bool closed = false;
+    while (true) {
+      visited[e] = 1;
+      const GraphEdge &edge = edges[e];
+      const bool reversed = edge.v0 != vertex;
+      chain.edges.push_back({edge.reference, reversed});
+      chainEdgeIndex.push_back(e);
+      vertex = reversed ? edge.v0 : edge.v1;
+      if (degree(vertex) != 2) {
+        break;
+      }
+      const std::uint32_t *adj = &incident[offsets[vertex]];
+      const std::uint32_t next = adj[0] == e ? adj[1] : adj[0];
+      if (visited[next]) {
+        closed = vertex == startVertex;
+        break;
+      }
+      e = next;
+    }
+    chain.end = snapper.vertices[vertex];
+    finishChain(chain, closed);
+  };
+
+  // 1) 从自由端与分叉点出发的开链。
+  for (std::size_t v = 0; v < vertexCount; ++v) {
+    const auto d = degree(static_cast<int>(v));
+    if (d == 2 || d == 0) {
+      continue;
+    }
+    if (d > 2) {
+      result.branches.push_back({snapper.vertices[v], d});
+    }
+    for (std::uint32_t k = offsets[v]; k < offsets[v + 1]; ++k) {
+      if (!visited[incident[k]]) {
+        walk(static_cast<int>(v), incident[k]);
+      }
+    }
+  }
+  // 2) 剩余边：闭合边与全部顶点度数为 2 的环。
+  for (std::size_t e = 0; e < edges.size(); ++e) {
+    if (visited[e]) {
+      continue;
+    }
+    if (edges[e].v0 == edges[e].v1) {
+      visited[e] = 1;
+      EdgeChain chain;
+      chainEdgeIndex.assign(1, static_cast<std::uint32_t>(e));
+      chain.edges.push_back({edges[e].reference, false});
+      chain.start = chain.end = snapper.vertices[edges[e].v0];
+      finishChain(chain, true);
+      continue;
+    }
+    walk(edges[e].v0, static_cast<std::uint32_t>(e));
+  }
+
+  // 3) 开链端点缝隙。
+  if (gapTolerance > tolerance) {
+    struct End {
+      std::size_t chain;
+      bool atEnd;
+      CPoint3D point;
+    };
+    std::vector<End> ends;
+    PointGrid grid(gapTolerance);
+    for (std::size_t c = 0; c < result.chains.size(); ++c) {
+      const EdgeChain &chain = result.chains[c];
+      if (chain.closed) {
+        continue;
+      }
+      for (bool atEnd : {false, true}) {
+        const End end{c, atEnd, atEnd ? chain.end : chain.start};
+        grid.ForNeighbours(end.point, [&](int other) {
+          const double d = Distance(ends[other].point, end.point);
+          if (d > tolerance && d <= gapTolerance) {
+            result.gaps.push_back(
+                {ends[other].chain, ends[other].atEnd, c, atEnd, d});
+          }
+        });
+        grid.Insert(end.point, static_cast<int>(ends.size()));
+        ends.push_back(end);
+      }
+    }
+  }
+  return result;
+}
+
+EdgeChainResult EdgeChainBuilder::ComputePath(const CSweepPath &path,
+                                              double tolerance,
+                                              double angleTolerance,
+                                              double gapTolerance) {
+  EdgeChainResult result =
+      Compute(path.references, tolerance, angleTolerance, gapTolerance);
+  if (!path.startPoint && !path.endPoint) {
+    return result;
+  }
+  const CPoint3D anchor = path.startPoint ? *path.startPoint : *path.endPoint;
+  std::size_t best = result.chains.size();
+  bool bestAtEnd = false;
+  double bestDistance = 0.0;
+  for (std::size_t c = 0; c < result.chains.size(); ++c) {
+    const EdgeChain &chain = result.chains[c];
+    if (chain.closed) {
+      continue;
+    }
+    for (bool atEnd : {false, true}) {
+      const double d = Distance(atEnd ? chain.end : chain.start, anchor);
+      if (best == result.chains.size() || d < bestDistance) {
+        best = c;
+        bestAtEnd = atEnd;
+        bestDistance = d;
+      }
+    }
+  }
+  // startPoint 应位于链首，endPoint 应位于链尾。
+  if (best < result.chains.size() && bestAtEnd == path.startPoint.has_value()) {
+    ReverseChain(result, best);
+  }
+  return result;
+}
+
+// ---------------------------------------------------------------------------
+// 缓存
+// ---------------------------------------------------------------------------
+
+EdgeChainBuilder::EdgeChainBuilder(UnitType unit, double angleTolerance,
+                                   std::size_t maxCacheEntries)
+    : m_tolerance(0.0), m_angleTolerance(angleTolerance),
+      m_gapTolerance(0.0), m_maxCacheEntries(maxCacheEntries) {
+  if (!TryGetGeometryCompareTolerance(unit, m_tolerance)) {
+    throw std::invalid_argument(
+        "EdgeChainBuilder: unsupported unit for geometry compare tolerance");
+  }
+  m_gapTolerance = 10.0 * m_tolerance;
+}
+
+std::shared_ptr<const EdgeChainResult>
+EdgeChainBuilder::Build(const CFeatureBase &feature) {
+  const CSweepPath *path = nullptr;
+  const std::vector<std::shared_ptr<CRefEntityBase>> *references = nullptr;
+  if (const auto *sweep = dynamic_cast<const CSweep *>(&feature)) {
+    path = &sweep->path;
+    references = &sweep->path.references;
+  } else if (const auto *fillet = dynamic_cast<const CFillet *>(&feature)) {
+    references = &fillet->references;
+  } else if (const auto *chamfer = dynamic_cast<const CChamfer *>(&feature)) {
+    references = &chamfer->references;
+  } else {
+    return std::make_shared<const EdgeChainResult>();
+  }
+
+  ContentHasher hasher;
+  hasher.Int(static_cast<std::uint64_t>(feature.featureType));
+  hasher.Double(m_tolerance);
+  hasher.Double(m_angleTolerance);
+  hasher.Double(m_gapTolerance);
+  hasher.References(*references);
+  if (path) {
+    hasher.OptionalPoint(path->startPoint);
+    hasher.OptionalPoint(path->endPoint);
+  }
+  const std::uint64_t hash = hasher.Value();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_cache.find(feature.featureID);
+    if (it != m_cache.end() && it->second.hash == hash) {
+      return it->second.result;
+    }
+  }
+
+  auto result = std::make_shared<const EdgeChainResult>(
+      path ? ComputePath(*path, m_tolerance, m_angleTolerance, m_gapTolerance)
+           : Compute(*references, m_tolerance, m_angleTolerance,
+                     m_gapTolerance));
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_cache.size() >= m_maxCacheEntries &&
+        m_cache.find(feature.featureID) == m_cache.end()) {
+      m_cache.clear();
+    }
+    if (m_maxCacheEntries > 0) {
+      m_cache[feature.featureID] = CacheEntry{hash, result};
+    }
+  }
+  return result;
+}
+
+std::size_t EdgeChainBuilder::CacheSize() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_cache.size();
+}
+
+void EdgeChainBuilder::ClearCache() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_cache.clear();
+}
+
+} // namespace Geometry
+} // namespace CADExchange
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "../../core/UnifiedModel.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CADExchange {
+namespace Geometry {
+
+/**
+ * @brief 链上的一条边：引用下标（输入 references）与走向。
+ */
+struct ChainEdge {
+  std::size_t reference = 0;
+  bool reversed = false; ///< true 表示从 endPoint 走向 startPoint
+};
+
+/**
+ * @brief 首尾相接的一条有序边链。
+ *
+ * 开链两端为端点度数不等于 2 的顶点（自由端或分叉点）；所有顶点度数
+ * 均为 2 的连通分量形成闭链。joints[i] 为 edges[i] 与 edges[i + 1] 之间
+ * 的转角（弧度），闭链额外包含末边回到首边的转角。
+ */
+struct EdgeChain {
+  std::vector<ChainEdge> edges;
+  std::vector<double> joints;
+  CPoint3D start;
+  CPoint3D end;
+  bool closed = false;
+  bool tangentContinuous = true; ///< 全部转角均不超过角度容差
+  double maxTurnAngle = 0.0;
+};
+
+/**
+ * @brief 度数大于 2 的顶点（多条边在此汇合，链在此断开）。
+ */
+struct EdgeChainBranch {
+  CPoint3D point;
+  std::size_t edgeCount = 0;
+};
+
+/**
+ * @brief 两条开链端点之间的缝隙：距离超过吸附容差但不超过缝隙容差。
+ */
+struct EdgeChainGap {
+  std::size_t chainA = 0;
+  bool atEndA = false; ///< false 为 chainA 的 start，true 为 end
+  std::size_t chainB = 0;
+  bool atEndB = false;
+  double distance = 0.0;
+};
+
+/**
+ * @brief 一组边引用的成链结果。
+ */
+struct EdgeChainResult {
+  std::vector<EdgeChain> chains;
+  std::vector<EdgeChainBranch> branches;
+  std::vector<EdgeChainGap> gaps;
+  /// 不是 CRefEdge（或为空指针）的引用下标，不参与成链。
+  std::vector<std::size_t> skippedReferences;
+
+  bool IsSingleChain() const {
+    return chains.size() == 1 && branches.empty();
+  }
+};
+
+/**
+ * @brief 边链构建器：把 CRefEdge 集合排成连通、带切向连续性的有序链。
+ *
+ * 端点按容差哈希网格吸附为顶点（期望线性），按顶点邻接表从自由端/分叉点
+ * 出发逐边追踪，剩余边组成闭链，整体与边数成线性。各边的端点切向由
+ * start/mid/end 三点确定：三点共线按直线，否则按过三点的圆弧；闭合边
+ * （起终点重合）不参与转角计算。开链端点在 gapTolerance 内相邻时记为
+ * 缝隙。
+ *
+ * Build(feature) 面向扫掠路径（path.references，给定 startPoint 时开链朝
+ * 其定向）与圆角/倒角边集，结果按特征 ID 缓存，内容哈希变化（原地修改
+ * 引用几何或容差不同）时自动重算。本类线程安全。
+ */
+class EdgeChainBuilder {
+public:
+  /**
+   * @param tolerance 端点吸附容差。
+   * @param angleTolerance 切向连续判定的转角上限（弧度）。
+   * @param gapTolerance 缝隙检测距离上限；<= tolerance 时不检测缝隙。
+   */
+  explicit EdgeChainBuilder(double tolerance, double angleTolerance = 1e-2,
+                            double gapTolerance = 0.0,
+                            std::size_t maxCacheEntries = 1024)
+      : m_tolerance(tolerance), m_angleTolerance(angleTolerance),
+        m_gapTolerance(gapTolerance), m_maxCacheEntries(maxCacheEntries) {}
+
+  /**
+   * @brief 以 TryGetGeometryCompareTolerance(unit) 为吸附容差，缝隙容差取
+   *        其 10 倍。
+   *
+   * @throws std::invalid_argument 当单位不受支持时。
+   */
+  explicit EdgeChainBuilder(UnitType unit, double angleTolerance = 1e-2,
+                            std::size_t maxCacheEntries = 1024);
+
+  EdgeChainBuilder(const EdgeChainBuilder &) = delete;
+  EdgeChainBuilder &operator=(const EdgeChainBuilder &) = delete;
+
+  double GetTolerance() const { return m_tolerance; }
+
+  /**
+   * @brief 获取扫掠路径、圆角或倒角特征的边链（按特征缓存）。
+   *
+   * 其他特征类型返回空结果。
+   */
+  std::shared_ptr<const EdgeChainResult> Build(const CFeatureBase &feature);
+
+  /**
+   * @brief 不经缓存直接计算。
+   */
+  static EdgeChainResult
+  Compute(const std::vector<std::shared_ptr<CRefEntityBase>> &references,
+          double tolerance, double angleTolerance, double gapTolerance = 0.0);
+
+  /**
+   * @brief 同 Compute，开链朝 path.startPoint（或远离 path.endPoint）定向；
+   *        isClosed 为 true 而未闭合时不修改结果，由调用方判定。
+   */
+  static EdgeChainResult ComputePath(const CSweepPath &path, double tolerance,
+                                     double angleTolerance,
+                                     double gapTolerance = 0.0);
+
+  std::size_t CacheSize() const;
+  void ClearCache();
+
+private:
+  struct CacheEntry {
+    std::uint64_t hash = 0;
+    std::shared_ptr<const EdgeChainResult> result;
+  };
+
+  double m_tolerance;
+  double m_angleTolerance;
+  double m_gapTolerance;
+  std::size_t m_maxCacheEntries;
+  mutable std::mutex m_mutex;
+  std::unordered_map<std::string, CacheEntry> m_cache;
+};
+
+} // namespace Geometry
+} // namespace CADExchange
@@ -0,0 +1,873 @@
+#include "FeatureBoundsTree.h"
+#include "../../core/ModelGeometryVisitor.h"
+#include "../../core/detail/IoHelpers.h"
+#include "VectorMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace CADExchange {
+namespace Geometry {
+
+// ---------------------------------------------------------------------------
+// BoundingBox
+// ---------------------------------------------------------------------------
+
+void BoundingBox::Expand(const CPoint3D &p) {
+  min = {std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z)};
+  max = {std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z)};
+}
+
+void BoundingBox::Expand(const BoundingBox &other) {
+  if (!other.IsEmpty()) {
+    Expand(other.min);
+    Expand(other.max);
+  }
+}
+
+BoundingBox BoundingBox::Inflated(double margin) const {
+  if (IsEmpty()) {
+    return *this;
+  }
+  BoundingBox box;
+  box.min = {min.x - margin, min.y - margin, min.z - margin};
+  box.max = {max.x + margin, max.y + margin, max.z + margin};
+  return box;
+}
+
+BoundingBox BoundingBox::Translated(const CVector3D &offset) const {
+  if (IsEmpty()) {
+    return *this;
+  }
+  BoundingBox box;
+  box.min = min + offset;
+  box.max = max + offset;
+  return box;
+}
+
+bool BoundingBox::Overlaps(const BoundingBox &other) const {
+  return !IsEmpty() && !other.IsEmpty() && min.x <= other.max.x &&
+         other.min.x <= max.x && min.y <= other.max.y &&
+         other.min.y <= max.y && min.z <= other.max.z && other.min.z <= max.z;
+}
+
+bool BoundingBox::Contains(const BoundingBox &other) const {
+  return !IsEmpty() && !other.IsEmpty() && min.x <= other.min.x &&
+         min.y <= other.min.y && min.z <= other.min.z &&
+         other.max.x <= max.x && other.max.y <= max.y && other.max.z <= max.z;
+}
+
+bool BoundingBox::Contains(const CPoint3D &p) const {
+  return min.x <= p.x && p.x <= max.x && min.y <= p.y && p.y <= max.y &&
+         min.z <= p.z && p.z <= max.z;
+}
+
+double BoundingBox::Distance(const CPoint3D &p) const {
+  if (IsEmpty()) {
+    return std::numeric_limits<double>::infinity();
+  }
+  const double dx = std::max({min.x - p.x, 0.0, p.x - max.x});
+  const double dy = std::max({min.y - p.y, 0.0, p.y - max.y});
+  const double dz = std::max({min.z - p.z, 0.0, p.z - max.z});
+  return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+CPoint3D BoundingBox::Center() const {
+  return {(min.x + max.x) * 0.5, (min.y + max.y) * 0.5, (min.z + max.z) * 0.5};
+}
+
+double BoundingBox::Radius() const {
+  if (IsEmpty()) {
+    return 0.0;
+  }
+  const CVector3D d = max - min;
+  return 0.5 * std::sqrt(d.Dot(d));
+}
+
+namespace {
+
+using CADExchange::detail::Fnv1aHasher;
+using detail::Normalized;
+using detail::Scaled;
+
+constexpr double kTwoPi = 2.0 * GeoUtils::PI;
+
+/**
+ * @brief 只读采集世界坐标点与最大长度参数（不进入草图段）。
+ */
+class PointCollector : public GeometryVisitorBase {
+public:
+  void Point(CPoint3D &p) { box.Expand(p); }
+  void Length(double &value) { maxLength = std::max(maxLength, std::abs(value)); }
+  bool Segment(std::shared_ptr<CSketchSeg> &) { return false; }
+
+  BoundingBox box;
+  double maxLength = 0.0;
+};
+
+BoundingBox RefPoints(const std::shared_ptr<CRefEntityBase> &ref) {
+  PointCollector collector;
+  if (ref) {
+    VisitRefGeometry(*ref, collector);
+  }
+  return collector.box;
+}
+
+/// 引用指向的整个特征（特征引用的目标或子拓扑的父特征）。
+std::string OwnerFeatureID(const std::shared_ptr<CRefEntityBase> &ref) {
+  if (auto feature = std::dynamic_pointer_cast<CRefFeature>(ref)) {
+    return feature->targetFeatureID;
+  }
+  if (auto segment = std::dynamic_pointer_cast<CRefSketchSeg>(ref)) {
+    return segment->parentFeatureID;
+  }
+  return {};
+}
+
+/**
+ * @brief 阵列种子引用列表；非阵列特征返回空指针。
+ */
+const std::vector<std::shared_ptr<CRefEntityBase>> *
+PatternSeeds(const CFeatureBase &feature) {
+  switch (feature.featureType) {
+  case FeatureType::LinearPattern:
+    return &static_cast<const CLinearPattern &>(feature).seedObjects;
+  case FeatureType::CircularPattern:
+    return &static_cast<const CCircularPattern &>(feature).seedObjects;
+  case FeatureType::MirrorPattern:
+    return &static_cast<const CMirrorPattern &>(feature).seedObjects;
+  default:
+    return nullptr;
+  }
+}
+
+/**
+ * @brief 包围盒依赖的其他特征 ID（轮廓草图、扫掠路径草图、阵列种子）。
+ */
+std::vector<std::string> Dependencies(const CFeatureBase &feature) {
+  std::vector<std::string> ids;
+  if (auto *profiled = dynamic_cast<const CProfiledFeatureBase *>(&feature)) {
+    if (!profiled->profileSketchID.empty()) {
+      ids.push_back(profiled->profileSketchID);
+    }
+  }
+  if (feature.featureType == FeatureType::Sweep) {
+    const auto &sweep = static_cast<const CSweep &>(feature);
+    if (!sweep.profile.sketchID.empty()) {
+      ids.push_back(sweep.profile.sketchID);
+    }
+    for (const auto &ref : sweep.path.references) {
+      ids.push_back(OwnerFeatureID(ref));
+    }
+  }
+  if (const auto *seeds = PatternSeeds(feature)) {
+    for (const auto &seed : *seeds) {
+      if (std::dynamic_pointer_cast<CRefFeature>(seed)) {
+        ids.push_back(OwnerFeatureID(seed));
+      }
+    }
+  }
+  ids.erase(std::remove(ids.begin(), ids.end(), std::string()), ids.end());
+  return ids;
+}
+
+/**
+ * @brief FNV-1a 内容哈希：全部几何字段 + 访问器不覆盖的角度/标志位。
+ */
+class HashVisitor : public GeometryVisitorBase {
+public:
+  void Point(CPoint3D &p) { Vec(p.x, p.y, p.z); }
+  void LocalPoint(CPoint3D &p) { Vec(p.x, p.y, p.z); }
+  void Direction(CVector3D &v) { Vec(v.x, v.y, v.z); }
+  void Length(double &value) { Double(value); }
+
+  void Double(double value) {
+    if (value == 0.0) {
+      value = 0.0; // 归一化 -0.0
+    }
+    Bytes(&value, sizeof(value));
+  }
+
+  void Int(std::uint64_t value) { Bytes(&value, sizeof(value)); }
+
+  void Text(const std::string &text) {
+    Int(text.size());
+    Bytes(text.data(), text.size());
+  }
+
+  std::uint64_t Value() const { return m_hasher.Value(); }
+
+private:
+  void Vec(double x, double y, double z) {
+    Double(x);
+    Double(y);
+    Double(z);
+  }
+
+  void Bytes(const void *data, std::size_t size) { m_hasher.Mix(data, size); }
+
+  Fnv1aHasher m_hasher;
+};
+
+void HashSketchExtras(const CSketch &sketch, HashVisitor &hasher) {
+  hasher.Int(sketch.sketchCSys.valid ? 1 : 0);
+  for (const auto &seg : sketch.segments) {
+    if (!seg) {
+      continue;
+    }
+    hasher.Int(static_cast<std::uint64_t>(seg->type));
+    hasher.Int(seg->isConstruction ? 1 : 0);
+    if (auto *arc = dynamic_cast<const CSketchArc *>(seg.get())) {
+      hasher.Double(arc->startAngle);
+      hasher.Double(arc->endAngle);
+      hasher.Int(arc->isClockwise ? 1 : 0);
+    }
+  }
+}
+
+void HashExtent(const SweepExtent &extent, HashVisitor &hasher) {
+  hasher.Int(static_cast<std::uint64_t>(extent.type));
+  hasher.Double(extent.value);
+  hasher.Int(extent.isFlip ? 1 : 0);
+}
+
+std::uint64_t
+HashFeature(const CFeatureBase &feature,
+            const std::unordered_map<std::string, std::uint64_t> &known) {
+  HashVisitor hasher;
+  hasher.Int(static_cast<std::uint64_t>(feature.featureType));
+  // 访问器只读取字段，不修改特征。
+  VisitFeatureGeometry(const_cast<CFeatureBase &>(feature), hasher);
+  switch (feature.featureType) {
+  case FeatureType::Sketch:
+    HashSketchExtras(static_cast<const CSketch &>(feature), hasher);
+    break;
+  case FeatureType::Extrude: {
+    const auto &extrude = static_cast<const CExtrude &>(feature);
+    HashExtent(extrude.extent1, hasher);
+    if (extrude.extent2) {
+      HashExtent(*extrude.extent2, hasher);
+    }
+    hasher.Double(extrude.draft ? extrude.draft->angle : 0.0);
+    break;
+  }
+  case FeatureType::Revolve: {
+    const auto &revolve = static_cast<const CRevolve &>(feature);
+    HashExtent(revolve.extent1, hasher);
+    if (revolve.extent2) {
+      HashExtent(*revolve.extent2, hasher);
+    }
+    break;
+  }
+  case FeatureType::Sweep: {
+    const auto &sweep = static_cast<const CSweep &>(feature);
+    if (sweep.profile.embedded) {
+      HashSketchExtras(sweep.profile.embedded->sketch, hasher);
+    }
+    break;
+  }
+  default:
+    hasher.Int(PatternExpander::ContentHash(feature));
+    break;
+  }
+  for (const auto &id : Dependencies(feature)) {
+    hasher.Text(id);
+    auto it = known.find(id);
+    hasher.Int(it == known.end() ? 0 : it->second);
+  }
+  return hasher.Value();
+}
+
+// ---------------------------------------------------------------------------
+// 单特征包围盒
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief 草图局部 → 世界映射。
+ */
+struct SketchFrame {
+  CPoint3D origin;
+  CVector3D x{1, 0, 0};
+  CVector3D y{0, 1, 0};
+
+  explicit SketchFrame(const CSketchCSys &csys) {
+    CVector3D xDir, yDir;
+    if (csys.valid && Normalized(csys.xDir, xDir) &&
+        Normalized(csys.yDir, yDir)) {
+      origin = csys.origin;
+      x = xDir;
+      y = yDir;
+    }
+  }
+
+  CPoint3D ToWorld(double u, double v) const {
+    return origin + CVector3D{u * x.x + v * y.x, u * x.y + v * y.y,
+                              u * x.z + v * y.z};
+  }
+};
+
+void ExpandCircle(BoundingBox &box, const SketchFrame &frame,
+                  const CPoint3D &center, double radius) {
+  const CPoint3D c = frame.ToWorld(center.x, center.y);
+  const CVector3D extent{radius * std::hypot(frame.x.x, frame.y.x),
+                         radius * std::hypot(frame.x.y, frame.y.y),
+                         radius * std::hypot(frame.x.z, frame.y.z)};
+  box.Expand(c + extent);
+  box.Expand(c + Scaled(extent, -1.0));
+}
+
+/**
+ * @brief 圆弧：端点 + 落在弧内的各世界轴向极值点。
+ */
+void ExpandArc(BoundingBox &box, const SketchFrame &frame,
+               const CSketchArc &arc) {
+  double start = arc.isClockwise ? arc.endAngle : arc.startAngle;
+  double sweep = arc.isClockwise ? arc.startAngle - arc.endAngle
+                                 : arc.endAngle - arc.startAngle;
+  sweep = std::fmod(sweep, kTwoPi);
+  if (sweep <= 1e-12) {
+    sweep += kTwoPi;
+  }
+  auto at = [&](double angle) {
+    return frame.ToWorld(arc.center.x + arc.radius * std::cos(angle),
+                         arc.center.y + arc.radius * std::sin(angle));
+  };
+  box.Expand(at(start));
+  box.Expand(at(start + sweep));
+  const double xs[3] = {frame.x.x, frame.x.y, frame.x.z};
+  const double ys[3] = {frame.y.x, frame.y.y, frame.y.z};
+  for (int axis = 0; axis < 3; ++axis) {
+    if (std::hypot(xs[axis], ys[axis]) < GeoUtils::EPSILON) {
+      continue;
+    }
+    const double phi = std::atan2(ys[axis], xs[axis]);
+    for (double extreme : {phi, phi + GeoUtils::PI}) {
+      double offset = std::fmod(extreme - start, kTwoPi);
+      if (offset < 0.0) {
+        offset += kTwoPi;
+      }
+      if (offset <= sweep) {
+        box.Expand(at(extreme));
+      }
+    }
+  }
+}
+
+/// 单位向量 dir 的轴向圆盘半宽：sqrt(1 - dir_i²)。
+CVector3D DiskExtent(const CVector3D &dir, double radius) {
+  auto half = [&](double c) { return radius * std::sqrt(std::max(0.0, 1.0 - c * c)); };
+  return {half(dir.x), half(dir.y), half(dir.z)};
+}
+
+void Corners(const BoundingBox &box, CPoint3D (&out)[8]) {
+  for (int i = 0; i < 8; ++i) {
+    out[i] = {(i & 1) ? box.max.x : box.min.x, (i & 2) ? box.max.y : box.min.y,
+              (i & 4) ? box.max.z : box.min.z};
+  }
+}
+
+double ThinWallMargin(const std::optional<ThinWallOption> &thinWall) {
+  return thinWall ? std::max(std::abs(thinWall->startOffset),
+                             std::abs(thinWall->endOffset))
+                  : 0.0;
+}
+
+/**
+ * @brief 拉伸单侧深度：数值型取 value，其余取目标指纹在方向上的最远投影。
+ */
+double ExtentDepth(const SweepExtent &extent, const BoundingBox &profile,
+                   const CVector3D &dir) {
+  if (extent.type == SweepExtent::Type::VALUE ||
+      extent.type == SweepExtent::Type::SYMMETRIC) {
+    return std::abs(extent.value);
+  }
+  BoundingBox targets = RefPoints(extent.referenceEntity);
+  if (extent.helperPoint) {
+    targets.Expand(*extent.helperPoint);
+  }
+  if (targets.IsEmpty() || profile.IsEmpty()) {
+    return 0.0;
+  }
+  CPoint3D corners[8];
+  Corners(targets, corners);
+  const CPoint3D center = profile.Center();
+  double depth = 0.0;
+  for (const auto &corner : corners) {
+    depth = std::max(depth, Dot(corner - center, dir));
+  }
+  return depth + profile.Radius();
+}
+
+BoundingBox ExtrudeBounds(const CExtrude &extrude, const BoundingBox &profile) {
+  CVector3D dir;
+  if (profile.IsEmpty() || !Normalized(extrude.direction, dir)) {
+    return profile;
+  }
+  BoundingBox box = profile;
+  double maxDepth = 0.0;
+  auto sweepSide = [&](const SweepExtent &extent, double sign) {
+    const double s = extent.isFlip ? -sign : sign;
+    if (extent.type == SweepExtent::Type::SYMMETRIC) {
+      const double half = 0.5 * std::abs(extent.value);
+      box.Expand(profile.Translated(Scaled(dir, half)));
+      box.Expand(profile.Translated(Scaled(dir, -half)));
+      maxDepth = std::max(maxDepth, half);
+      return;
+    }
+    const double depth = ExtentDepth(extent, profile, Scaled(dir, s));
+    box.Expand(profile.Translated(Scaled(dir, s * depth)));
+    maxDepth = std::max(maxDepth, depth);
+  };
+  sweepSide(extrude.extent1, 1.0);
+  if (extrude.extent2) {
+    sweepSide(*extrude.extent2, -1.0);
+  }
+  double margin = ThinWallMargin(extrude.thinWall);
+  if (extrude.draft) {
+    margin += maxDepth * std::abs(std::tan(extrude.draft->angle));
+  }
+  return box.Inflated(margin);
+}
+
+BoundingBox RevolveBounds(const CRevolve &revolve, const BoundingBox &profile) {
+  CVector3D axis;
+  if (profile.IsEmpty() || !Normalized(revolve.axis.direction, axis)) {
+    return profile;
+  }
+  CPoint3D corners[8];
+  Corners(profile, corners);
+  double tmin = std::numeric_limits<double>::infinity();
+  double tmax = -tmin;
+  double radius = 0.0;
+  for (const auto &corner : corners) {
+    const CVector3D rel = corner - revolve.axis.origin;
+    const double t = Dot(rel, axis);
+    const CVector3D radial{rel.x - axis.x * t, rel.y - axis.y * t,
+                           rel.z - axis.z * t};
+    tmin = std::min(tmin, t);
+    tmax = std::max(tmax, t);
+    radius = std::max(radius, std::sqrt(radial.Dot(radial)));
+  }
+  const CVector3D disk = DiskExtent(axis, radius);
+  BoundingBox box;
+  for (double t : {tmin, tmax}) {
+    const CPoint3D c = revolve.axis.origin + Scaled(axis, t);
+    box.Expand(c + disk);
+    box.Expand(c + Scaled(disk, -1.0));
+  }
+  return box.Inflated(ThinWallMargin(revolve.thinWall));
+}
+
+BoundingBox PathBounds(const CSweepPath &path,
+                       const std::function<BoundingBox(const std::string &)> &lookup) {
+  BoundingBox box;
+  for (const auto &ref : path.references) {
+    BoundingBox refBox = RefPoints(ref);
+    if (refBox.IsEmpty()) {
+      const std::string owner = OwnerFeatureID(ref);
+      if (!owner.empty()) {
+        refBox = lookup(owner);
+      }
+    }
+    box.Expand(refBox);
+  }
+  if (path.startPoint) {
+    box.Expand(*path.startPoint);
+  }
+  if (path.endPoint) {
+    box.Expand(*path.endPoint);
+  }
+  return box;
+}
+
+BoundingBox SweepBounds(const CSweep &sweep,
+                        const std::function<BoundingBox(const std::string &)> &lookup) {
+  BoundingBox profile;
+  double radius = 0.0;
+  if (sweep.profile.embedded) {
+    profile = FeatureBoundsTree::SketchBounds(sweep.profile.embedded->sketch);
+  } else if (!sweep.profile.sketchID.empty()) {
+    profile = lookup(sweep.profile.sketchID);
+  }
+  if (sweep.profile.circular) {
+    radius = std::abs(sweep.profile.circular->outerRadius);
+  }
+  radius = std::max(radius, 2.0 * profile.Radius());
+  radius += ThinWallMargin(sweep.thinWall);
+
+  BoundingBox box = profile;
+  box.Expand(PathBounds(sweep.path, lookup).Inflated(radius));
+  for (const auto &guide : sweep.guidePaths) {
+    box.Expand(PathBounds(guide, lookup));
+  }
+  return box;
+}
+
+BoundingBox PatternBounds(const CFeatureBase &pattern,
+                          const std::vector<std::shared_ptr<CRefEntityBase>> &seeds,
+                          const std::function<BoundingBox(const std::string &)> &lookup,
+                          PatternExpander *patterns) {
+  BoundingBox seedBox;
+  for (const auto &seed : seeds) {
+    if (std::dynamic_pointer_cast<CRefFeature>(seed)) {
+      seedBox.Expand(lookup(OwnerFeatureID(seed)));
+    } else {
+      seedBox.Expand(RefPoints(seed));
+    }
+  }
+  if (seedBox.IsEmpty() || !patterns) {
+    return seedBox;
+  }
+  const auto instances = patterns->Expand(pattern);
+  if (!instances) {
+    return seedBox;
+  }
+  CPoint3D corners[8];
+  Corners(seedBox, corners);
+  BoundingBox box;
+  for (const auto &transform : instances->transforms) {
+    for (const auto &corner : corners) {
+      box.Expand(transform.TransformPoint(corner));
+    }
+  }
+  return box;
+}
+
+} // namespace
+
+BoundingBox FeatureBoundsTree::SketchBounds(const CSketch &sketch) {
+  const SketchFrame frame(sketch.sketchCSys);
+  auto collect = [&](bool includeConstruction) {
+    BoundingBox box;
+    for (const auto &seg : sketch.segments) {
+      if (!seg || (seg->isConstruction && !includeConstruction)) {
+        continue;
+      }
+      if (auto *line = dynamic_cast<const CSketchLine *>(seg.get())) {
+        box.Expand(frame.ToWorld(line->startPos.x, line->startPos.y));
+        box.Expand(frame.ToWorld(line->endPos.x, line->endPos.y));
+      } else if (auto *arc = dynamic_cast<const CSketchArc *>(seg.get())) {
+        ExpandArc(box, frame, *arc);
+      } else if (auto *circle = dynamic_cast<const CSketchCircle *>(seg.get())) {
+        ExpandCircle(box, frame, circle->center, circle->radius);
+      } else if (auto *point = dynamic_cast<const CSketchPoint *>(seg.get())) {
+        box.Expand(frame.ToWorld(point->position.x, point->position.y));
+      }
+    }
+    return box;
+  };
+  BoundingBox box = collect(false);
+  if (box.IsEmpty()) {
+    box = collect(true); // 纯构造草图仍给出位置
+  }
+  return box;
+}
+
+BoundingBox FeatureBoundsTree::ComputeBounds(
+    const CFeatureBase &feature,
+    const std::function<BoundingBox(const std::string &)> &lookup,
+    PatternExpander *patterns) {
+  switch (feature.featureType) {
+  case FeatureType::Sketch:
+    return SketchBounds(static_cast<const CSketch &>(feature));
+  case FeatureType::Extrude: {
+    const auto &extrude = static_cast<const CExtrude &>(feature);
+    return ExtrudeBounds(extrude, lookup(extrude.profileSketchID));
+  }
+  case FeatureType::Revolve: {
+    const auto &revolve = static_cast<const CRevolve &>(feature);
+    return RevolveBounds(revolve, lookup(revolve.profileSketchID));
+  }
+  case FeatureType::Sweep:
+    return SweepBounds(static_cast<const CSweep &>(feature), lookup);
+  default:
+    break;
+  }
+  if (const auto *seeds = PatternSeeds(feature)) {
+    return PatternBounds(feature, *seeds, lookup, patterns);
+  }
+
+  PointCollector collector;
+  VisitFeatureGeometry(const_cast<CFeatureBase &>(feature), collector);
+  switch (feature.featureType) {
+  case FeatureType::Fillet:
+  case FeatureType::Chamfer:
+  case FeatureType::Shell:
+  case FeatureType::Rib:
+  case FeatureType::Draft:
+    return collector.box.Inflated(collector.maxLength);
+  default:
+    return collector.box;
+  }
+}
+
+// ---------------------------------------------------------------------------
+// 构建与维护
+// ---------------------------------------------------------------------------
+
+void FeatureBoundsTree::Build(const UnifiedModel &model) {
+  m_records.clear();
+  m_byID.clear();
+  m_bvhOrder.clear();
+  m_nodes.clear();
+  m_pending.clear();
+  m_deadRecords = 0;
+  std::size_t recomputed = 0;
+  Sync(model, true, recomputed);
+}
+
+std::size_t FeatureBoundsTree::Update(const UnifiedModel &model) {
+  std::size_t recomputed = 0;
+  Sync(model, false, recomputed);
+  return recomputed;
+}
+
+void FeatureBoundsTree::Sync(const UnifiedModel &model, bool rebuild,
+                             std::size_t &recomputed) {
+  std::unordered_map<std::string, std::uint64_t> hashes;
+  const auto lookup = [&](const std::string &id) {
+    auto it = m_byID.find(id);
+    return it == m_byID.end() ? BoundingBox{} : m_records[it->second].box;
+  };
+
+  // 按特征顺序一次遍历：轮廓/种子总在引用它的特征之前完成。
+  const auto &features = model.GetFeatures();
+  for (std::size_t order = 0; order < features.size(); ++order) {
+    const auto &feature = features[order];
+    if (!feature) {
+      continue;
+    }
+    const std::uint64_t hash = HashFeature(*feature, hashes);
+    hashes[feature->featureID] = hash;
+
+    auto existing = m_byID.find(feature->featureID);
+    if (existing != m_byID.end() && m_records[existing->second].hash == hash) {
+      m_records[existing->second].order = order;
+      continue;
+    }
+    ++recomputed;
+    BoundingBox box;
+    if (auto cached = m_cache.find(hash); cached != m_cache.end()) {
+      box = cached->second;
+    } else {
+      ++m_computeCount;
+      box = ComputeBounds(*feature, lookup, &m_patterns);
+      if (m_cache.size() >= m_maxCacheEntries) {
+        m_cache.clear();
+      }
+      m_cache.emplace(hash, box);
+    }
+    if (existing != m_byID.end()) {
+      m_records[existing->second].alive = false;
+      ++m_deadRecords;
+    }
+    const auto index = static_cast<std::uint32_t>(m_records.size());
+    m_records.push_back({feature->featureID, hash, order, box, true});
+    m_byID[feature->featureID] = index;
+    m_pending.push_back(index);
+  }
+
+  // 模型中已不存在的特征。
+  for (auto it = m_byID.begin(); it != m_byID.end();) {
+    if (hashes.count(it->first) == 0) {
+      m_records[it->second].alive = false;
+      ++m_deadRecords;
+      it = m_byID.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  if (rebuild) {
+    RebuildTree();
+  } else {
+    MaybeRebuild();
+  }
+}
+
+void FeatureBoundsTree::MaybeRebuild() {
+  const std::size_t inTree = m_bvhOrder.size();
+  const bool tooManyPending =
+      m_pending.size() > 32 && m_pending.size() * 4 > inTree;
+  const bool tooManyDead =
+      m_deadRecords > 0 && m_deadRecords * 2 > m_records.size();
+  if (tooManyPending || tooManyDead) {
+    RebuildTree();
+  }
+}
+
+void FeatureBoundsTree::RebuildTree() {
+  if (m_deadRecords > 0) {
+    std::vector<Record> records;
+    records.reserve(m_records.size() - m_deadRecords);
+    for (auto &record : m_records) {
+      if (record.alive) {
+        records.push_back(std::move(record));
+      }
+    }
+    m_records = std::move(records);
+    m_deadRecords = 0;
+    m_byID.clear();
+    for (std::size_t i = 0; i < m_records.size(); ++i) {
+      m_byID[m_records[i].featureID] = static_cast<std::uint32_t>(i);
+    }
+  }
+
+  m_pending.clear();
+  m_nodes.clear();
+  m_bvhOrder.clear();
+  for (std::size_t i = 0; i < m_records.size(); ++i) {
+    if (!m_records[i].box.IsEmpty()) {
+      m_bvhOrder.push_back(static_cast<std::uint32_t>(i));
+    }
+  }
+  if (!m_bvhOrder.empty()) {
+    m_nodes.reserve(2 * m_bvhOrder.size() / kLeafSize + 1);
+    BuildNode(0, static_cast<std::uint32_t>(m_bvhOrder.size()));
+  }
+}
+
+std::uint32_t FeatureBoundsTree::BuildNode(std::uint32_t begin,
+                                           std::uint32_t end) {
+  const auto index = static_cast<std::uint32_t>(m_nodes.size());
+  m_nodes.emplace_back();
+
+  Node node;
+  BoundingBox centers;
+  for (std::uint32_t i = begin; i < end; ++i) {
+    const BoundingBox &box = m_records[m_bvhOrder[i]].box;
+    node.box.Expand(box);
+    centers.Expand(box.Center());
+  }
+
+  if (end - begin <= kLeafSize) {
+    node.first = begin;
+    node.count = end - begin;
+    m_nodes[index] = node;
+    return index;
+  }
+
+  const CVector3D spread = centers.max - centers.min;
+  const int splitAxis = spread.x >= spread.y && spread.x >= spread.z ? 0
+                        : spread.y >= spread.z                     ? 1
+                                                                   : 2;
+  auto key = [&](std::uint32_t record) {
+    const CPoint3D c = m_records[record].box.Center();
+    return splitAxis == 0 ? c.x : splitAxis == 1 ? c.y : c.z;
+  };
+  const std::uint32_t mid = begin + (end - begin) / 2;
+  std::nth_element(m_bvhOrder.begin() + begin, m_bvhOrder.begin() + mid,
+                   m_bvhOrder.begin() + end,
+                   [&](std::uint32_t lhs, std::uint32_t rhs) {
+                     return key(lhs) < key(rhs);
+                   });
+
+  node.left = BuildNode(begin, mid);
+  node.right = BuildNode(mid, end);
+  m_nodes[index] = node;
+  return index;
+}
+
+// ---------------------------------------------------------------------------
+// 查询
+// ---------------------------------------------------------------------------
+
+template <typename NodeFn, typename RecordFn>
+void FeatureBoundsTree::Traverse(NodeFn &&nodeAccepts, RecordFn &&visit) const {
+  if (!m_nodes.empty()) {
+    std::vector<std::uint32_t> stack{0};
+    while (!stack.empty()) {
+      const Node &node = m_nodes[stack.back()];
+      stack.pop_back();
+      if (!nodeAccepts(node.box)) {
+        continue;
+      }
+      if (node.count > 0) {
+        for (std::uint32_t i = node.first; i < node.first + node.count; ++i) {
+          visit(m_records[m_bvhOrder[i]]);
+        }
+      } else {
+        stack.push_back(node.left);
+        stack.push_back(node.right);
+      }
+    }
+  }
+  for (std::uint32_t record : m_pending) {
+    visit(m_records[record]);
+  }
+}
+
+std::vector<FeatureBoundsHit> FeatureBoundsTree::Collect(
+    const std::function<bool(const BoundingBox &)> &nodeAccepts,
+    const std::function<bool(const BoundingBox &)> &recordAccepts) const {
+  std::vector<std::pair<std::size_t, FeatureBoundsHit>> hits;
+  Traverse(nodeAccepts, [&](const Record &record) {
+    if (record.alive && !record.box.IsEmpty() && recordAccepts(record.box)) {
+      hits.push_back({record.order, {record.featureID, record.box, 0.0}});
+    }
+  });
+  std::sort(hits.begin(), hits.end(),
+            [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+  std::vector<FeatureBoundsHit> out;
+  out.reserve(hits.size());
+  for (auto &hit : hits) {
+    out.push_back(std::move(hit.second));
+  }
+  return out;
+}
+
+std::optional<BoundingBox>
+FeatureBoundsTree::GetBounds(const std::string &featureID) const {
+  auto it = m_byID.find(featureID);
+  if (it == m_byID.end()) {
+    return std::nullopt;
+  }
+  return m_records[it->second].box;
+}
+
+BoundingBox FeatureBoundsTree::ModelBounds() const {
+  BoundingBox box;
+  for (const auto &record : m_records) {
+    if (record.alive) {
+      box.Expand(record.box);
+    }
+  }
+  return box;
+}
+
+std::vector<FeatureBoundsHit>
+FeatureBoundsTree::QueryOverlap(const BoundingBox &box) const {
+  const auto overlaps = [&](const BoundingBox &b) { return b.Overlaps(box); };
+  return Collect(overlaps, overlaps);
+}
+
+std::vector<FeatureBoundsHit>
+FeatureBoundsTree::QueryContained(const BoundingBox &box) const {
+  return Collect([&](const BoundingBox &b) { return b.Overlaps(box); },
+                 [&](const BoundingBox &b) { return box.Contains(b); });
+}
+
+std::vector<FeatureBoundsHit>
+FeatureBoundsTree::QueryContaining(const CPoint3D &p) const {
+  const auto contains = [&](const BoundingBox &b) { return b.Contains(p); };
+  return Collect(contains, contains);
+}
+
+std::vector<FeatureBoundsHit>
+FeatureBoundsTree::QueryNear(const CPoint3D &center, double radius) const {
+  const auto within = [&](const BoundingBox &b) {
+    return b.Distance(center) <= radius;
+  };
+  std::vector<FeatureBoundsHit> hits = Collect(within, within);
+  for (auto &hit : hits) {
+    hit.distance = hit.box.Distance(center);
+  }
+  std::stable_sort(hits.begin(), hits.end(), [](const auto &lhs, const auto &rhs) {
+    return lhs.distance < rhs.distance;
+  });
+  return hits;
+}
+
+} // namespace Geometry
+} // namespace CADExchange
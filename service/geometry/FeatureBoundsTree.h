@@ -0,0 +1,179 @@
+#pragma once
+
+#include "../../core/UnifiedModel.h"
+#include "PatternExpander.h"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace CADExchange {
+namespace Geometry {
+
+/**
+ * @brief 世界坐标轴对齐包围盒。默认构造为空盒（IsEmpty() 为 true）。
+ */
+struct BoundingBox {
+  CPoint3D min{1e300, 1e300, 1e300};
+  CPoint3D max{-1e300, -1e300, -1e300};
+
+  bool IsEmpty() const {
+    return min.x > max.x || min.y > max.y || min.z > max.z;
+  }
+
+  void Expand(const CPoint3D &p);
+  void Expand(const BoundingBox &other);
+
+  /// 各方向外扩 margin（空盒保持为空）。
+  BoundingBox Inflated(double margin) const;
+  BoundingBox Translated(const CVector3D &offset) const;
+
+  bool Overlaps(const BoundingBox &other) const;
+  /// other 完全位于本盒内。
+  bool Contains(const BoundingBox &other) const;
+  bool Contains(const CPoint3D &p) const;
+  /// 点到盒的最短距离（点在盒内为 0）。空盒返回 +inf。
+  double Distance(const CPoint3D &p) const;
+
+  CPoint3D Center() const;
+  /// 半对角线长度。
+  double Radius() const;
+};
+
+/**
+ * @brief 查询结果。
+ */
+struct FeatureBoundsHit {
+  std::string featureID;
+  BoundingBox box;
+  double distance = 0.0; ///< 仅 QueryNear：查询点到包围盒的距离
+};
+
+/**
+ * @brief 特征包围盒与模型级 AABB 树。
+ *
+ * 单个特征的包围盒：
+ *   - 草图：非构造段经 sketchCSys 映射到世界坐标，圆与圆弧取精确轴向极值；
+ *   - 拉伸：轮廓草图包围盒沿方向按 extent 深度扫掠（VALUE/SYMMETRIC 取
+ *     数值，其余类型取参考实体与 helperPoint 在方向上的投影），薄壁外扩；
+ *   - 旋转：轮廓绕轴整周旋转的圆柱包络（保守）；
+ *   - 扫掠：路径指纹按轮廓半径外扩，并入轮廓本身；
+ *   - 阵列：种子特征（或种子引用指纹）包围盒经 PatternExpander 实例变换；
+ *   - 其余特征：引用指纹与标记点，圆角/倒角/抽壳/筋按其长度参数外扩。
+ *
+ * 建立时按特征顺序一次批量计算，后序特征直接使用已算出的轮廓/种子包围盒。
+ * 每个特征的内容哈希（几何字段 + 轮廓/种子哈希）同时作为包围盒缓存键，
+ * Update() 只重算哈希变化的特征：旧条目做墓碑标记，新条目进入待合并列表
+ * （查询时线性扫描），两者超过阈值时重建 BVH，维护策略与
+ * ReferenceSpatialIndex 一致。
+ *
+ * const 查询可并发执行；修改操作需由调用方串行化。
+ */
+class FeatureBoundsTree {
+public:
+  explicit FeatureBoundsTree(std::size_t maxCacheEntries = 4096)
+      : m_maxCacheEntries(maxCacheEntries) {}
+  explicit FeatureBoundsTree(const UnifiedModel &model,
+                             std::size_t maxCacheEntries = 4096)
+      : m_maxCacheEntries(maxCacheEntries) {
+    Build(model);
+  }
+
+  FeatureBoundsTree(const FeatureBoundsTree &) = delete;
+  FeatureBoundsTree &operator=(const FeatureBoundsTree &) = delete;
+
+  /**
+   * @brief 丢弃现有条目（保留包围盒缓存）并按模型重新建立。
+   */
+  void Build(const UnifiedModel &model);
+
+  /**
+   * @brief 与模型同步（增删特征、原地修改几何后调用）。
+   *
+   * @return 本次重新计算包围盒的特征数。
+   */
+  std::size_t Update(const UnifiedModel &model);
+
+  std::optional<BoundingBox> GetBounds(const std::string &featureID) const;
+  BoundingBox ModelBounds() const;
+  std::size_t FeatureCount() const { return m_byID.size(); }
+
+  /// 与 box 相交的特征，按模型特征顺序。
+  std::vector<FeatureBoundsHit> QueryOverlap(const BoundingBox &box) const;
+  /// 完全位于 box 内的特征，按模型特征顺序。
+  std::vector<FeatureBoundsHit> QueryContained(const BoundingBox &box) const;
+  /// 包围盒包含点 p 的特征，按模型特征顺序。
+  std::vector<FeatureBoundsHit> QueryContaining(const CPoint3D &p) const;
+  /// 包围盒距 center 不超过 radius 的特征，按距离升序。
+  std::vector<FeatureBoundsHit> QueryNear(const CPoint3D &center,
+                                          double radius) const;
+
+  /// 实际计算包围盒的次数（缓存命中不计），用于确认增量效果。
+  std::size_t ComputeCount() const { return m_computeCount; }
+  std::size_t CacheSize() const { return m_cache.size(); }
+
+  /**
+   * @brief 草图段在世界坐标下的包围盒（sketchCSys 无效时按局部即世界）。
+   */
+  static BoundingBox SketchBounds(const CSketch &sketch);
+
+  /**
+   * @brief 不经缓存计算单个特征的包围盒。
+   *
+   * @param lookup 按特征 ID 取轮廓草图/阵列种子的包围盒，未知时返回空盒。
+   */
+  static BoundingBox
+  ComputeBounds(const CFeatureBase &feature,
+                const std::function<BoundingBox(const std::string &)> &lookup,
+                PatternExpander *patterns = nullptr);
+
+private:
+  struct Record {
+    std::string featureID;
+    std::uint64_t hash = 0;
+    std::size_t order = 0; ///< 模型中的特征序号
+    BoundingBox box;
+    bool alive = true;
+  };
+
+  struct Node {
+    BoundingBox box;
+    std::uint32_t left = 0;
+    std::uint32_t right = 0;
+    std::uint32_t first = 0;
+    std::uint32_t count = 0; ///< 叶节点记录数，0 表示内部节点
+  };
+
+  static constexpr std::uint32_t kLeafSize = 4;
+
+  void Sync(const UnifiedModel &model, bool rebuild, std::size_t &recomputed);
+  void MaybeRebuild();
+  void RebuildTree();
+  std::uint32_t BuildNode(std::uint32_t begin, std::uint32_t end);
+
+  template <typename NodeFn, typename RecordFn>
+  void Traverse(NodeFn &&nodeAccepts, RecordFn &&visit) const;
+
+  std::vector<FeatureBoundsHit>
+  Collect(const std::function<bool(const BoundingBox &)> &nodeAccepts,
+          const std::function<bool(const BoundingBox &)> &recordAccepts) const;
+
+  std::size_t m_maxCacheEntries;
+  std::size_t m_computeCount = 0;
+  std::unordered_map<std::uint64_t, BoundingBox> m_cache;
+  PatternExpander m_patterns;
+
+  std::vector<Record> m_records;
+  std::unordered_map<std::string, std::uint32_t> m_byID;
+  std::vector<std::uint32_t> m_bvhOrder;
+  std::vector<Node> m_nodes;
+  std::vector<std::uint32_t> m_pending;
+  std::size_t m_deadRecords = 0;
+};
+
+} // namespace Geometry
+} // namespace CADExchange
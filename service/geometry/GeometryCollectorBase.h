@@ -8,6 +8,7 @@
 #include <filesystem>
 #include <map>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <iostream>
@@ -48,6 +49,12 @@ public:
     return detail::SaveGeometryToJson(filePath, m_edges, m_datumPlanes, errorMessage, lengthUnit);
   }
 
+  bool SaveEdgesToJson(std::ostream &out,
+                       std::string *errorMessage = nullptr,
+                       const std::string &lengthUnit = "") const {
+    return detail::SaveGeometryToJson(out, m_edges, m_datumPlanes, errorMessage, lengthUnit);
+  }
+
   detail::json ToJsonValue() const {
     return detail::GeometryToJson(m_edges, m_datumPlanes);
   }
@@ -114,11 +121,11 @@ public:
 
   bool SaveToJson(const std::filesystem::path &filePath,
                   std::string *errorMessage = nullptr) const {
-    std::vector<std::pair<std::string, detail::json>> featureList;
-    for (const auto &[featureId, collector] : features) {
-      featureList.emplace_back(featureId, collector.ToJsonValue());
-    }
-    return detail::SaveModelGeometryToJson(filePath, featureList, length_unit, errorMessage);
+    return detail::SaveModelGeometryToJson(filePath, ToFeatureList(), length_unit, errorMessage);
+  }
+
+  bool SaveToJson(std::ostream &out, std::string *errorMessage = nullptr) const {
+    return detail::SaveModelGeometryToJson(out, ToFeatureList(), length_unit, errorMessage);
   }
 
   bool LoadFromJson(const std::filesystem::path &filePath,
@@ -129,6 +136,57 @@ public:
     if (!detail::LoadModelGeometryFromJson(filePath, featureList, file_unit, errorMessage)) {
       return false;
     }
+    return ApplyFeatureList(featureList, file_unit, errorMessage, target_unit);
+  }
+
+  bool LoadFromJson(std::istream &in,
+                    std::string *errorMessage = nullptr,
+                    const std::string &target_unit = "") {
+    std::vector<std::pair<std::string, detail::json>> featureList;
+    std::string file_unit;
+    if (!detail::LoadModelGeometryFromJson(in, featureList, file_unit, errorMessage)) {
+      return false;
+    }
+    return ApplyFeatureList(featureList, file_unit, errorMessage, target_unit);
+  }
+
+  bool LoadFromJsonBuffer(std::string_view text,
+                          std::string *errorMessage = nullptr,
+                          const std::string &target_unit = "") {
+    std::vector<std::pair<std::string, detail::json>> featureList;
+    std::string file_unit;
+    if (!detail::LoadModelGeometryFromJsonBuffer(text, featureList, file_unit, errorMessage)) {
+      return false;
+    }
+    return ApplyFeatureList(featureList, file_unit, errorMessage, target_unit);
+  }
+
+  std::size_t TotalEdgeCount() const {
+    std::size_t total = 0;
+    for (const auto& pair : features) total += pair.second.EdgeCount();
+    return total;
+  }
+
+  std::size_t TotalDatumPlaneCount() const {
+    std::size_t total = 0;
+    for (const auto& pair : features) total += pair.second.DatumPlaneCount();
+    return total;
+  }
+
+private:
+  std::vector<std::pair<std::string, detail::json>> ToFeatureList() const {
+    std::vector<std::pair<std::string, detail::json>> featureList;
+    featureList.reserve(features.size());
+    for (const auto &[featureId, collector] : features) {
+      featureList.emplace_back(featureId, collector.ToJsonValue());
+    }
+    return featureList;
+  }
+
+  bool ApplyFeatureList(std::vector<std::pair<std::string, detail::json>> &featureList,
+                        const std::string &file_unit,
+                        std::string *errorMessage,
+                        const std::string &target_unit) {
     features.clear();
     for (auto &[featureId, entryJson] : featureList) {
       CollectorT collector;
@@ -159,18 +217,6 @@ public:
     length_unit = target_unit.empty() ? file_unit : target_unit;
     return true;
   }
-
-  std::size_t TotalEdgeCount() const {
-    std::size_t total = 0;
-    for (const auto& pair : features) total += pair.second.EdgeCount();
-    return total;
-  }
-
-  std::size_t TotalDatumPlaneCount() const {
-    std::size_t total = 0;
-    for (const auto& pair : features) total += pair.second.DatumPlaneCount();
-    return total;
-  }
 };
 
 using GeometrySet = ModelGeometrySet<GeometryCollectorBaseDummyDerived>;
@@ -7,6 +7,7 @@
 #include <iomanip>
 #include <fstream>
 #include <iostream>
+#include <string_view>
 
 namespace CADExchange {
 namespace Geometry {
@@ -635,6 +636,21 @@ bool SaveGeometryToJson(const std::filesystem::path &filePath,
                         const std::vector<CGeoDatumPlane>& datumPlanes,
                         std::string *errorMessage,
                         const std::string &lengthUnit) {
+  std::ofstream out(filePath, std::ios::trunc);
+  if (!out.is_open()) {
+    if (errorMessage) {
+      *errorMessage = "Unable to open geometry json output: " + filePath.string();
+    }
+    return false;
+  }
+  return SaveGeometryToJson(out, edges, datumPlanes, errorMessage, lengthUnit);
+}
+
+bool SaveGeometryToJson(std::ostream &out,
+                        const std::vector<CRefEdge>& edges,
+                        const std::vector<CGeoDatumPlane>& datumPlanes,
+                        std::string *errorMessage,
+                        const std::string &lengthUnit) {
   try {
     json fileRoot;
     fileRoot["schema_version"] = 1;
@@ -663,14 +679,13 @@ bool SaveGeometryToJson(const std::filesystem::path &filePath,
                                                {"normal", VectorToJson(plane.localCSys.zDir)}});
     }
 
-    std::ofstream out(filePath, std::ios::trunc);
-    if (!out.is_open()) {
+    out << fileRoot.dump(2) << '\n';
+    if (!out) {
       if (errorMessage) {
-        *errorMessage = "Unable to open geometry json output: " + filePath.string();
+        *errorMessage = "Failed to write geometry json: output stream error";
       }
       return false;
     }
-    out << fileRoot.dump(2) << '\n';
     return true;
   } catch (const std::exception &e) {
     if (errorMessage) {
@@ -1014,6 +1029,18 @@ bool SaveModelGeometryToJson(const std::filesystem::path &filePath,
                              const std::vector<std::pair<std::string, json>>& featureList,
                              const std::string &length_unit,
                              std::string *errorMessage) {
+  std::ofstream out(filePath, std::ios::trunc);
+  if (!out.is_open()) {
+    if (errorMessage) *errorMessage = "Unable to open geometry json output: " + filePath.string();
+    return false;
+  }
+  return SaveModelGeometryToJson(out, featureList, length_unit, errorMessage);
+}
+
+bool SaveModelGeometryToJson(std::ostream &out,
+                             const std::vector<std::pair<std::string, json>>& featureList,
+                             const std::string &length_unit,
+                             std::string *errorMessage) {
   try {
     json featuresJson = json::array();
     for (const auto &[featureId, collectorJson] : featureList) {
@@ -1023,12 +1050,11 @@ bool SaveModelGeometryToJson(const std::filesystem::path &filePath,
     if (!length_unit.empty()) {
       root["length_unit"] = length_unit;
     }
-    std::ofstream out(filePath, std::ios::trunc);
-    if (!out.is_open()) {
-      if (errorMessage) *errorMessage = "Unable to open geometry json output: " + filePath.string();
+    out << root.dump(2) << '\n';
+    if (!out) {
+      if (errorMessage) *errorMessage = "Failed to write geometry json: output stream error";
       return false;
     }
-    out << root.dump(2) << '\n';
     return true;
   } catch (const std::exception &e) {
     if (errorMessage) *errorMessage = "Failed to write geometry json: " + std::string(e.what());
@@ -1036,45 +1062,74 @@ bool SaveModelGeometryToJson(const std::filesystem::path &filePath,
   }
 }
 
+namespace {
+
+bool ReadModelGeometryRoot(const json &root,
+                           std::vector<std::pair<std::string, json>>& featureList,
+                           std::string &file_unit,
+                           std::string *errorMessage) {
+  // Parse length_unit if present
+  if (root.contains("length_unit")) {
+    const auto &unitNode = root.at("length_unit");
+    if (unitNode.is_string()) {
+      file_unit = unitNode.get<std::string>();
+    }
+  }
+
+  const auto modelIt = root.find("ModelGeometry");
+  if (modelIt == root.end() || !modelIt->is_object()) {
+    if (errorMessage) *errorMessage = "geometry json missing ModelGeometry object";
+    return false;
+  }
+  const auto featuresIt = modelIt->find("features");
+  if (featuresIt == modelIt->end() || !featuresIt->is_array()) {
+    if (errorMessage) *errorMessage = "geometry json missing features array";
+    return false;
+  }
+  featureList.clear();
+  for (const auto &entry : *featuresIt) {
+    if (!entry.is_object() || !entry.contains("key") || !entry.contains("value")) {
+      if (errorMessage) *errorMessage = "geometry json contains malformed feature entry";
+      return false;
+    }
+    featureList.emplace_back(entry.at("key").get<std::string>(), entry.at("value"));
+  }
+  return true;
+}
+
+} // namespace
+
 bool LoadModelGeometryFromJson(const std::filesystem::path &filePath,
                                std::vector<std::pair<std::string, json>>& featureList,
                                std::string &file_unit,
                                std::string *errorMessage) {
-  try {
-    std::ifstream in(filePath);
-    if (!in.is_open()) {
-      if (errorMessage) *errorMessage = "Unable to open geometry json input: " + filePath.string();
-      return false;
-    }
-    json root = json::parse(in);
+  std::ifstream in(filePath);
+  if (!in.is_open()) {
+    if (errorMessage) *errorMessage = "Unable to open geometry json input: " + filePath.string();
+    return false;
+  }
+  return LoadModelGeometryFromJson(in, featureList, file_unit, errorMessage);
+}
 
-    // Parse length_unit if present
-    if (root.contains("length_unit")) {
-      const auto &unitNode = root.at("length_unit");
-      if (unitNode.is_string()) {
-        file_unit = unitNode.get<std::string>();
-      }
-    }
+bool LoadModelGeometryFromJson(std::istream &in,
+                               std::vector<std::pair<std::string, json>>& featureList,
+                               std::string &file_unit,
+                               std::string *errorMessage) {
+  try {
+    return ReadModelGeometryRoot(json::parse(in), featureList, file_unit, errorMessage);
+  } catch (const std::exception &e) {
+    if (errorMessage) *errorMessage = "Failed to parse geometry json: " + std::string(e.what());
+    return false;
+  }
+}
 
-    const auto modelIt = root.find("ModelGeometry");
-    if (modelIt == root.end() || !modelIt->is_object()) {
-      if (errorMessage) *errorMessage = "geometry json missing ModelGeometry object";
-      return false;
-    }
-    const auto featuresIt = modelIt->find("features");
-    if (featuresIt == modelIt->end() || !featuresIt->is_array()) {
-      if (errorMessage) *errorMessage = "geometry json missing features array";
-      return false;
-    }
-    featureList.clear();
-    for (const auto &entry : *featuresIt) {
-      if (!entry.is_object() || !entry.contains("key") || !entry.contains("value")) {
-        if (errorMessage) *errorMessage = "geometry json contains malformed feature entry";
-        return false;
-      }
-      featureList.emplace_back(entry.at("key").get<std::string>(), entry.at("value"));
-    }
-    return true;
+bool LoadModelGeometryFromJsonBuffer(std::string_view text,
+                                     std::vector<std::pair<std::string, json>>& featureList,
+                                     std::string &file_unit,
+                                     std::string *errorMessage) {
+  try {
+    return ReadModelGeometryRoot(json::parse(text.begin(), text.end()), featureList,
+                                 file_unit, errorMessage);
   } catch (const std::exception &e) {
     if (errorMessage) *errorMessage = "Failed to parse geometry json: " + std::string(e.what());
     return false;
@@ -3,7 +3,9 @@
 #include "GeometryTypes.h"
 #include <vector>
 #include <string>
+#include <string_view>
 #include <filesystem>
+#include <iosfwd>
 
 namespace CADExchange {
 namespace Geometry {
@@ -87,6 +89,14 @@ namespace detail {
                           const std::vector<CGeoDatumPlane>& datumPlanes,
                           std::string *errorMessage,
                           const std::string &lengthUnit);
+
+  // Stream overloads write/read the same JSON as the path versions without
+  // touching the filesystem.
+  bool SaveGeometryToJson(std::ostream &out,
+                          const std::vector<CRefEdge>& edges,
+                          const std::vector<CGeoDatumPlane>& datumPlanes,
+                          std::string *errorMessage,
+                          const std::string &lengthUnit);
                           
   json GeometryToJson(const std::vector<CRefEdge>& edges,
                       const std::vector<CGeoDatumPlane>& datumPlanes);
@@ -115,6 +125,22 @@ namespace detail {
                                  std::vector<std::pair<std::string, json>>& featureList,
                                  std::string &file_unit,
                                  std::string *errorMessage);
+
+  bool SaveModelGeometryToJson(std::ostream &out,
+                               const std::vector<std::pair<std::string, json>>& featureList,
+                               const std::string &length_unit,
+                               std::string *errorMessage);
+
+  bool LoadModelGeometryFromJson(std::istream &in,
+                                 std::vector<std::pair<std::string, json>>& featureList,
+                                 std::string &file_unit,
+                                 std::string *errorMessage);
+
+  // Parses directly from an in-memory JSON document.
+  bool LoadModelGeometryFromJsonBuffer(std::string_view text,
+                                       std::vector<std::pair<std::string, json>>& featureList,
+                                       std::string &file_unit,
+                                       std::string *errorMessage);
 } // namespace detail
 
 } // namespace Geometry
@@ -0,0 +1,613 @@
+#include "ModelMatcher.h"
+#include "../../core/ModelGeometryVisitor.h"
+#include "../../core/detail/IoHelpers.h"
+#include "VectorMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+
+namespace CADExchange {
+namespace Geometry {
+
+namespace {
+
+using CADExchange::detail::Fail;
+using CADExchange::detail::Fnv1aHasher;
+using detail::Distance;
+
+std::int64_t Quantize(double value, double quantum) {
+  return static_cast<std::int64_t>(std::llround(value / quantum));
+}
+
+/**
+ * @brief 与顺序无关的点集摘要：数量、质心与包围盒。
+ */
+struct PointSummary {
+  std::size_t count = 0;
+  CPoint3D centroid;
+  CPoint3D min;
+  CPoint3D max;
+
+  void Add(const CPoint3D &p) {
+    if (count == 0) {
+      min = max = p;
+    } else {
+      min = {std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z)};
+      max = {std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z)};
+    }
+    centroid.x += p.x;
+    centroid.y += p.y;
+    centroid.z += p.z;
+    ++count;
+  }
+
+  void Finish() {
+    if (count > 0) {
+      centroid.x /= static_cast<double>(count);
+      centroid.y /= static_cast<double>(count);
+      centroid.z /= static_cast<double>(count);
+    }
+  }
+
+  void Hash(Fnv1aHasher &hasher, double quantum) const {
+    hasher.MixValue(static_cast<std::int64_t>(count));
+    for (const CPoint3D *p : {&centroid, &min, &max}) {
+      hasher.MixValue(Quantize(p->x, quantum));
+      hasher.MixValue(Quantize(p->y, quantum));
+      hasher.MixValue(Quantize(p->z, quantum));
+    }
+  }
+};
+
+/**
+ * @brief 特征的 ID 无关签名。长度与坐标已换算到模型 A 的单位。
+ */
+struct Signature {
+  const CFeatureBase *feature = nullptr;
+  double rank = 0.0; ///< 特征在模型中的相对位置 [0, 1]
+  std::vector<double> lengths;
+  std::vector<double> angles;
+  std::vector<std::int64_t> integers;
+  std::vector<CVector3D> directions;
+  PointSummary points;
+  PointSummary localPoints;
+  std::uint64_t paramKey = 0;
+  std::uint64_t fullKey = 0;
+
+  const CPoint3D &Anchor() const {
+    return points.count > 0 ? points.centroid : localPoints.centroid;
+  }
+};
+
+class SignatureCollector : public GeometryVisitorBase {
+public:
+  SignatureCollector(Signature &signature, double scale)
+      : m_signature(signature), m_scale(scale) {}
+
+  void Point(CPoint3D &p) { m_signature.points.Add(Scaled(p)); }
+  void LocalPoint(CPoint3D &p) { m_signature.localPoints.Add(Scaled(p)); }
+  void Length(double &value) { m_signature.lengths.push_back(value * m_scale); }
+
+  void Direction(CVector3D &dir) {
+    CVector3D unit = dir;
+    unit.Normalize();
+    m_signature.directions.push_back(unit);
+  }
+
+private:
+  CPoint3D Scaled(const CPoint3D &p) const {
+    return {p.x * m_scale, p.y * m_scale, p.z * m_scale};
+  }
+
+  Signature &m_signature;
+  double m_scale;
+};
+
+template <typename E> std::int64_t Enum(E value) {
+  return static_cast<std::int64_t>(value);
+}
+
+/**
+ * @brief 补充访问器不报告的角度、计数与模式枚举。
+ */
+void AppendScalars(const CFeatureBase &feature, Signature &sig) {
+  auto &ints = sig.integers;
+  auto &angles = sig.angles;
+  switch (feature.featureType) {
+  case FeatureType::Sketch: {
+    const auto &sketch = static_cast<const CSketch &>(feature);
+    std::int64_t counts[5] = {0, 0, 0, 0, 0};
+    for (const auto &seg : sketch.segments) {
+      if (!seg) {
+        continue;
+      }
+      switch (seg->type) {
+      case CSketchSeg::SegType::LINE:
+        ++counts[0];
+        break;
+      case CSketchSeg::SegType::CIRCLE:
+        ++counts[1];
+        break;
+      case CSketchSeg::SegType::ARC:
+        ++counts[2];
+        if (auto *arc = dynamic_cast<const CSketchArc *>(seg.get())) {
+          angles.push_back(std::abs(arc->endAngle - arc->startAngle));
+        }
+        break;
+      case CSketchSeg::SegType::POINT:
+        ++counts[3];
+        break;
+      default:
+        ++counts[4];
+        break;
+      }
+    }
+    ints.insert(ints.end(), std::begin(counts), std::end(counts));
+    ints.push_back(static_cast<std::int64_t>(sketch.constraints.size()));
+    for (const auto &constraint : sketch.constraints) {
+      if (constraint.type == CSketchConstraint::ConstraintType::ANGLE &&
+          constraint.value.has_value()) {
+        angles.push_back(*constraint.value);
+      }
+    }
+    break;
+  }
+  case FeatureType::Extrude: {
+    const auto &extrude = static_cast<const CExtrude &>(feature);
+    ints.push_back(Enum(extrude.extent1.type));
+    ints.push_back(extrude.extent2 ? Enum(extrude.extent2->type) : -1);
+    ints.push_back(extrude.thinWall.has_value() ? 1 : 0);
+    if (extrude.draft) {
+      angles.push_back(extrude.draft->angle);
+    }
+    break;
+  }
+  case FeatureType::Revolve: {
+    const auto &revolve = static_cast<const CRevolve &>(feature);
+    ints.push_back(Enum(revolve.extent1.type));
+    ints.push_back(revolve.extent2 ? Enum(revolve.extent2->type) : -1);
+    ints.push_back(revolve.thinWall.has_value() ? 1 : 0);
+    angles.push_back(revolve.extent1.value);
+    if (revolve.extent2) {
+      angles.push_back(revolve.extent2->value);
+    }
+    break;
+  }
+  case FeatureType::Sweep: {
+    const auto &sweep = static_cast<const CSweep &>(feature);
+    ints.push_back(static_cast<std::int64_t>(sweep.guidePaths.size()));
+    ints.push_back(sweep.thinWall.has_value() ? 1 : 0);
+    break;
+  }
+  case FeatureType::Fillet: {
+    const auto &fillet = static_cast<const CFillet &>(feature);
+    ints.push_back(Enum(fillet.mode));
+    ints.push_back(static_cast<std::int64_t>(fillet.references.size()));
+    ints.push_back(static_cast<std::int64_t>(fillet.side1Faces.size()));
+    ints.push_back(static_cast<std::int64_t>(fillet.side2Faces.size()));
+    break;
+  }
+  case FeatureType::Chamfer: {
+    const auto &chamfer = static_cast<const CChamfer &>(feature);
+    ints.push_back(Enum(chamfer.mode));
+    ints.push_back(static_cast<std::int64_t>(chamfer.references.size()));
+    if (chamfer.params.angle) {
+      angles.push_back(*chamfer.params.angle);
+    }
+    break;
+  }
+  case FeatureType::DatumPlane: {
+    const auto &plane = static_cast<const CDatumPlane &>(feature);
+    for (const auto &constraint : plane.constraints) {
+      ints.push_back(Enum(constraint.type));
+      if (constraint.type == PlaneConstraintType::ANGLE) {
+        angles.push_back(constraint.value);
+      }
+    }
+    break;
+  }
+  case FeatureType::Shell: {
+    const auto &shell = static_cast<const CShell &>(feature);
+    ints.push_back(Enum(shell.direction));
+    ints.push_back(static_cast<std::int64_t>(shell.facesToRemove.size()));
+    break;
+  }
+  case FeatureType::Draft: {
+    const auto &draft = static_cast<const CDraft &>(feature);
+    ints.push_back(Enum(draft.draftType));
+    ints.push_back(draft.isTwoSided ? 1 : 0);
+    ints.push_back(static_cast<std::int64_t>(draft.draftFaces.size()));
+    angles.push_back(draft.draftAngle);
+    if (draft.isTwoSided) {
+      angles.push_back(draft.draftAngleSide2);
+    }
+    break;
+  }
+  case FeatureType::LinearPattern: {
+    const auto &pattern = static_cast<const CLinearPattern &>(feature);
+    ints.push_back(pattern.dir1.count);
+    ints.push_back(pattern.dir2 ? pattern.dir2->count : 0);
+    ints.push_back(static_cast<std::int64_t>(pattern.skippedInstances.size()));
+    ints.push_back(static_cast<std::int64_t>(pattern.seedObjects.size()));
+    break;
+  }
+  case FeatureType::CircularPattern: {
+    const auto &pattern = static_cast<const CCircularPattern &>(feature);
+    ints.push_back(pattern.dir1.count);
+    ints.push_back(pattern.dir2 ? pattern.dir2->count : 0);
+    ints.push_back(static_cast<std::int64_t>(pattern.skippedInstances.size()));
+    ints.push_back(static_cast<std::int64_t>(pattern.seedObjects.size()));
+    angles.push_back(pattern.dir1.angle);
+    break;
+  }
+  case FeatureType::MirrorPattern: {
+    const auto &pattern = static_cast<const CMirrorPattern &>(feature);
+    ints.push_back(static_cast<std::int64_t>(pattern.seedObjects.size()));
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+std::vector<Signature> BuildSignatures(const UnifiedModel &model, double scale,
+                                       double lengthQuantum,
+                                       double angleQuantum) {
+  const auto &features = model.GetFeatures();
+  std::vector<Signature> signatures;
+  signatures.reserve(features.size());
+  const double denominator =
+      features.size() > 1 ? static_cast<double>(features.size() - 1) : 1.0;
+  for (std::size_t i = 0; i < features.size(); ++i) {
+    if (!features[i]) {
+      continue;
+    }
+    Signature sig;
+    sig.feature = features[i].get();
+    sig.rank = static_cast<double>(i) / denominator;
+    // 采集器只读取字段，不修改特征。
+    SignatureCollector collector(sig, scale);
+    VisitFeatureGeometry(const_cast<CFeatureBase &>(*features[i]), collector);
+    AppendScalars(*features[i], sig);
+    sig.points.Finish();
+    sig.localPoints.Finish();
+
+    Fnv1aHasher hasher;
+    hasher.MixValue(Enum(sig.feature->featureType));
+    hasher.MixValue(static_cast<std::int64_t>(sig.lengths.size()));
+    for (double v : sig.lengths) {
+      hasher.MixValue(Quantize(v, lengthQuantum));
+    }
+    hasher.MixValue(static_cast<std::int64_t>(sig.angles.size()));
+    for (double v : sig.angles) {
+      hasher.MixValue(Quantize(v, angleQuantum));
+    }
+    hasher.MixValue(static_cast<std::int64_t>(sig.integers.size()));
+    for (std::int64_t v : sig.integers) {
+      hasher.MixValue(v);
+    }
+    sig.paramKey = hasher.Value();
+
+    hasher.MixValue(static_cast<std::int64_t>(sig.directions.size()));
+    for (const auto &dir : sig.directions) {
+      hasher.MixValue(Quantize(dir.x, angleQuantum));
+      hasher.MixValue(Quantize(dir.y, angleQuantum));
+      hasher.MixValue(Quantize(dir.z, angleQuantum));
+    }
+    sig.points.Hash(hasher, lengthQuantum);
+    sig.localPoints.Hash(hasher, lengthQuantum);
+    sig.fullKey = hasher.Value();
+    signatures.push_back(std::move(sig));
+  }
+  return signatures;
+}
+
+// ---------------------------------------------------------------------------
+// 打分
+// ---------------------------------------------------------------------------
+
+/// 偏差 d（按量化步长归一化）到相似度的映射：d = 0 → 1，d = 1 → 0.5。
+double Similarity(double normalizedDeviation) {
+  return 1.0 / (1.0 + normalizedDeviation);
+}
+
+double CountRatio(std::size_t a, std::size_t b) {
+  return static_cast<double>(std::min(a, b)) /
+         static_cast<double>(std::max(a, b));
+}
+
+double ScalarSimilarity(const std::vector<double> &a,
+                        const std::vector<double> &b, double quantum) {
+  if (a.size() != b.size()) {
+    return 0.0;
+  }
+  double worst = 0.0;
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    worst = std::max(worst, std::abs(a[i] - b[i]));
+  }
+  return Similarity(worst / quantum);
+}
+
+double SummarySimilarity(const PointSummary &a, const PointSummary &b,
+                         double quantum) {
+  const double worst = std::max({Distance(a.centroid, b.centroid),
+                                 Distance(a.min, b.min),
+                                 Distance(a.max, b.max)});
+  return CountRatio(a.count, b.count) * Similarity(worst / quantum);
+}
+
+double DirectionSimilarity(const std::vector<CVector3D> &a,
+                           const std::vector<CVector3D> &b, double quantum) {
+  if (a.size() != b.size()) {
+    return CountRatio(a.size(), b.size()) * 0.5;
+  }
+  double worst = 0.0;
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    const double cosine = std::clamp(a[i].Dot(b[i]), -1.0, 1.0);
+    worst = std::max(worst, std::acos(cosine));
+  }
+  return Similarity(worst / quantum);
+}
+
+/**
+ * @brief 两个同类型特征签名的相似度：各分量加权平均，缺失分量不计入。
+ */
+double Score(const Signature &a, const Signature &b, double lengthQuantum,
+             double angleQuantum) {
+  double sum = 0.0;
+  double weight = 0.0;
+  auto add = [&](double value, double w) {
+    sum += value * w;
+    weight += w;
+  };
+  if (!a.lengths.empty() || !b.lengths.empty()) {
+    add(ScalarSimilarity(a.lengths, b.lengths, lengthQuantum), 1.0);
+  }
+  if (!a.angles.empty() || !b.angles.empty()) {
+    add(ScalarSimilarity(a.angles, b.angles, angleQuantum), 1.0);
+  }
+  if (!a.integers.empty() || !b.integers.empty()) {
+    double equal = 0.0;
+    if (a.integers.size() == b.integers.size()) {
+      for (std::size_t i = 0; i < a.integers.size(); ++i) {
+        equal += a.integers[i] == b.integers[i] ? 1.0 : 0.0;
+      }
+      equal /= static_cast<double>(a.integers.size());
+    }
+    add(equal, 1.0);
+  }
+  if (!a.directions.empty() || !b.directions.empty()) {
+    add(DirectionSimilarity(a.directions, b.directions, angleQuantum), 1.0);
+  }
+  if (a.points.count > 0 || b.points.count > 0) {
+    add(SummarySimilarity(a.points, b.points, lengthQuantum), 1.0);
+  }
+  if (a.localPoints.count > 0 || b.localPoints.count > 0) {
+    add(SummarySimilarity(a.localPoints, b.localPoints, lengthQuantum), 1.0);
+  }
+  // 导出顺序通常一致，只作为弱的并列决胜项。
+  add(1.0 - std::abs(a.rank - b.rank), 0.25);
+  return sum / weight;
+}
+
+struct Candidate {
+  std::size_t a = 0;
+  std::size_t b = 0;
+  double score = 0.0;
+};
+
+/**
+ * @brief 对候选对按得分贪心一对一分配，并计算置信度。
+ *
+ * 置信度 = score × 区分度，区分度取 A 侧（以及 B 侧）最优与次优候选
+ * 得分之差相对最优得分的比例；只有一个候选时为 1。
+ */
+class Assigner {
+public:
+  Assigner(std::vector<Signature> &sigA, std::vector<Signature> &sigB,
+           std::vector<bool> &usedA, std::vector<bool> &usedB,
+           std::vector<FeatureMatch> &matches, std::vector<std::size_t> &matchA,
+           double minScore)
+      : m_sigA(sigA), m_sigB(sigB), m_usedA(usedA), m_usedB(usedB),
+        m_matches(matches), m_matchA(matchA), m_minScore(minScore) {}
+
+  void Assign(std::vector<Candidate> &candidates, MatchStage stage) {
+    std::unordered_map<std::size_t, std::pair<double, double>> topA;
+    std::unordered_map<std::size_t, std::pair<double, double>> topB;
+    for (const auto &c : candidates) {
+      Push(topA[c.a], c.score);
+      Push(topB[c.b], c.score);
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate &x, const Candidate &y) {
+                if (x.score != y.score) {
+                  return x.score > y.score;
+                }
+                return x.a != y.a ? x.a < y.a : x.b < y.b;
+              });
+    for (const auto &c : candidates) {
+      if (c.score < m_minScore) {
+        break;
+      }
+      if (m_usedA[c.a] || m_usedB[c.b]) {
+        continue;
+      }
+      m_usedA[c.a] = true;
+      m_usedB[c.b] = true;
+      FeatureMatch match;
+      match.featureA = m_sigA[c.a].feature->featureID;
+      match.featureB = m_sigB[c.b].feature->featureID;
+      match.featureType = m_sigA[c.a].feature->featureType;
+      match.score = c.score;
+      match.confidence = c.score * std::min(Separation(topA[c.a], c.score),
+                                            Separation(topB[c.b], c.score));
+      match.stage = stage;
+      m_matchA.push_back(c.a);
+      m_matches.push_back(std::move(match));
+    }
+  }
+
+private:
+  static void Push(std::pair<double, double> &top, double score) {
+    if (score > top.first) {
+      top.second = top.first;
+      top.first = score;
+    } else if (score > top.second) {
+      top.second = score;
+    }
+  }
+
+  static double Separation(const std::pair<double, double> &top, double score) {
+    // 本候选不是最优时，最优者即为它的次优对手。
+    const double runnerUp = score < top.first ? top.first : top.second;
+    if (runnerUp <= 0.0) {
+      return 1.0;
+    }
+    return std::clamp(1.0 - runnerUp / score, 0.0, 1.0);
+  }
+
+  std::vector<Signature> &m_sigA;
+  std::vector<Signature> &m_sigB;
+  std::vector<bool> &m_usedA;
+  std::vector<bool> &m_usedB;
+  std::vector<FeatureMatch> &m_matches;
+  std::vector<std::size_t> &m_matchA;
+  double m_minScore;
+};
+
+} // namespace
+
+bool MatchModels(const UnifiedModel &a, const UnifiedModel &b,
+                 ModelCorrespondence &out, const MatchOptions &options,
+                 std::string *errorMessage) {
+  double tolerance = 0.0;
+  if (!TryGetGeometryCompareTolerance(a.unit, tolerance)) {
+    return Fail(errorMessage, "MatchModels: unsupported unit in model A");
+  }
+  double scaleB = 1.0;
+  if (!TryGetUnitConversionFactor(b.unit, a.unit, scaleB)) {
+    return Fail(errorMessage, "MatchModels: unsupported unit in model B");
+  }
+  const double lengthQuantum =
+      options.lengthQuantum > 0.0 ? options.lengthQuantum : tolerance * 10.0;
+  const double angleQuantum = options.angleQuantum > 0.0 ? options.angleQuantum
+                                                         : 1e-2;
+
+  std::vector<Signature> sigA =
+      BuildSignatures(a, 1.0, lengthQuantum, angleQuantum);
+  std::vector<Signature> sigB =
+      BuildSignatures(b, scaleB, lengthQuantum, angleQuantum);
+  std::vector<bool> usedA(sigA.size(), false);
+  std::vector<bool> usedB(sigB.size(), false);
+  std::vector<FeatureMatch> matches;
+  std::vector<std::size_t> matchA;
+  Assigner assigner(sigA, sigB, usedA, usedB, matches, matchA,
+                    options.minScore);
+
+  auto scorePair = [&](std::size_t i, std::size_t j) {
+    return Candidate{i, j, Score(sigA[i], sigB[j], lengthQuantum, angleQuantum)};
+  };
+
+  // 阶段 1、2：哈希分桶后桶内打分。
+  auto bucketPass = [&](std::uint64_t Signature::*key, MatchStage stage) {
+    std::unordered_map<std::uint64_t, std::vector<std::size_t>> bucketsB;
+    for (std::size_t j = 0; j < sigB.size(); ++j) {
+      if (!usedB[j]) {
+        bucketsB[sigB[j].*key].push_back(j);
+      }
+    }
+    std::vector<Candidate> candidates;
+    for (std::size_t i = 0; i < sigA.size(); ++i) {
+      if (usedA[i]) {
+        continue;
+      }
+      auto it = bucketsB.find(sigA[i].*key);
+      if (it == bucketsB.end()) {
+        continue;
+      }
+      for (std::size_t j : it->second) {
+        if (sigA[i].feature->featureType == sigB[j].feature->featureType) {
+          candidates.push_back(scorePair(i, j));
+        }
+      }
+    }
+    assigner.Assign(candidates, stage);
+  };
+  bucketPass(&Signature::fullKey, MatchStage::ExactSignature);
+  bucketPass(&Signature::paramKey, MatchStage::ParameterSignature);
+
+  // 阶段 3：同类型剩余特征按锚点 x 坐标排序，窗口内打分。
+  {
+    std::map<FeatureType, std::vector<std::size_t>> restA;
+    std::map<FeatureType, std::vector<std::size_t>> restB;
+    for (std::size_t i = 0; i < sigA.size(); ++i) {
+      if (!usedA[i]) {
+        restA[sigA[i].feature->featureType].push_back(i);
+      }
+    }
+    for (std::size_t j = 0; j < sigB.size(); ++j) {
+      if (!usedB[j]) {
+        restB[sigB[j].feature->featureType].push_back(j);
+      }
+    }
+    const std::size_t half = std::max<std::size_t>(options.window / 2, 1);
+    std::vector<Candidate> candidates;
+    for (auto &[type, listA] : restA) {
+      auto itB = restB.find(type);
+      if (itB == restB.end()) {
+        continue;
+      }
+      auto &listB = itB->second;
+      std::sort(listB.begin(), listB.end(), [&](std::size_t x, std::size_t y) {
+        return sigB[x].Anchor().x < sigB[y].Anchor().x;
+      });
+      for (std::size_t i : listA) {
+        const double x = sigA[i].Anchor().x;
+        auto pos = std::lower_bound(
+            listB.begin(), listB.end(), x,
+            [&](std::size_t j, double value) { return sigB[j].Anchor().x < value; });
+        const std::size_t center = static_cast<std::size_t>(pos - listB.begin());
+        const std::size_t begin = center > half ? center - half : 0;
+        const std::size_t end = std::min(listB.size(), center + half);
+        for (std::size_t k = begin; k < end; ++k) {
+          candidates.push_back(scorePair(i, listB[k]));
+        }
+      }
+    }
+    assigner.Assign(candidates, MatchStage::Proximity);
+  }
+
+  // 按 A 中顺序输出。
+  std::vector<std::size_t> order(matches.size());
+  for (std::size_t k = 0; k < order.size(); ++k) {
+    order[k] = k;
+  }
+  std::sort(order.begin(), order.end(), [&](std::size_t x, std::size_t y) {
+    return matchA[x] < matchA[y];
+  });
+  out.matches.clear();
+  out.matches.reserve(matches.size());
+  for (std::size_t k : order) {
+    out.matches.push_back(std::move(matches[k]));
+  }
+  out.unmatchedA.clear();
+  out.unmatchedB.clear();
+  for (std::size_t i = 0; i < sigA.size(); ++i) {
+    if (!usedA[i]) {
+      out.unmatchedA.push_back(sigA[i].feature->featureID);
+    }
+  }
+  for (std::size_t j = 0; j < sigB.size(); ++j) {
+    if (!usedB[j]) {
+      out.unmatchedB.push_back(sigB[j].feature->featureID);
+    }
+  }
+  out.RebuildIndex();
+  return true;
+}
+
+} // namespace Geometry
+} // namespace CADExchange
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "../../core/UnifiedModel.h"
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CADExchange {
+namespace Geometry {
+
+/**
+ * @brief 特征对应关系的产生阶段（越靠前越可靠）。
+ */
+enum class MatchStage {
+  ExactSignature,     ///< 参数与几何指纹量化后完全一致
+  ParameterSignature, ///< 仅参数签名（长度、角度、计数）量化后一致
+  Proximity           ///< 同类型特征按几何锚点邻近窗口打分
+};
+
+struct FeatureMatch {
+  std::string featureA;
+  std::string featureB;
+  FeatureType featureType = FeatureType::Unknown;
+  double score = 0.0;      ///< 签名相似度 [0, 1]
+  double confidence = 0.0; ///< score 乘以与次优候选的区分度
+  MatchStage stage = MatchStage::ExactSignature;
+};
+
+/**
+ * @brief 两个模型之间的特征对应表。
+ */
+struct ModelCorrespondence {
+  std::vector<FeatureMatch> matches; ///< 按模型 A 中的特征顺序排列
+  std::vector<std::string> unmatchedA;
+  std::vector<std::string> unmatchedB;
+
+  const FeatureMatch *FindByA(const std::string &featureID) const {
+    auto it = m_indexByA.find(featureID);
+    return it == m_indexByA.end() ? nullptr : &matches[it->second];
+  }
+
+  const FeatureMatch *FindByB(const std::string &featureID) const {
+    auto it = m_indexByB.find(featureID);
+    return it == m_indexByB.end() ? nullptr : &matches[it->second];
+  }
+
+  void RebuildIndex() {
+    m_indexByA.clear();
+    m_indexByB.clear();
+    for (std::size_t i = 0; i < matches.size(); ++i) {
+      m_indexByA.emplace(matches[i].featureA, i);
+      m_indexByB.emplace(matches[i].featureB, i);
+    }
+  }
+
+private:
+  std::unordered_map<std::string, std::size_t> m_indexByA;
+  std::unordered_map<std::string, std::size_t> m_indexByB;
+};
+
+struct MatchOptions {
+  double lengthQuantum = 0.0; ///< 长度/坐标量化步长，0 取 10 倍比较容差
+  double angleQuantum = 1e-2; ///< 角度/方向分量量化步长（弧度）
+  double minScore = 0.5;      ///< 低于该相似度的候选不配对
+  std::size_t window = 16;    ///< 邻近阶段每个特征检查的候选数
+};
+
+/**
+ * @brief 按内容（而非 ID）建立两个模型的特征对应关系。
+ *
+ * 每个特征提取与 ID 无关的签名：类型、长度、角度、计数/枚举，以及
+ * VisitFeatureGeometry 报告的引用指纹与草图局部坐标。模型 B 的长度
+ * 先换算到模型 A 的单位。配对分三个阶段，每一阶段只处理前一阶段剩余
+ * 的特征：
+ *   1. 完整签名量化后的哈希分桶，桶内打分配对；
+ *   2. 仅参数签名的哈希分桶（容忍引用指纹差异），桶内打分配对；
+ *   3. 同类型特征按几何锚点排序，每个特征只与窗口内的候选打分。
+ * 桶内与窗口内按得分贪心一对一分配，总体复杂度接近 O(n log n)。
+ *
+ * @return 单位不受支持时返回 false。
+ */
+bool MatchModels(const UnifiedModel &a, const UnifiedModel &b,
+                 ModelCorrespondence &out, const MatchOptions &options = {},
+                 std::string *errorMessage = nullptr);
+
+} // namespace Geometry
+} // namespace CADExchange
@@ -0,0 +1,527 @@
+#include "PatternExpander.h"
+#include "../../core/ModelGeometryVisitor.h"
+#include "GeometryCompareHelpers.h"
+#include "../../core/detail/IoHelpers.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace CADExchange {
+namespace Geometry {
+
+namespace {
+
+constexpr double kTwoPi = 6.283185307179586476925286766559;
+
+using CADExchange::detail::Fail;
+using CADExchange::detail::Fnv1a;
+
+/**
+ * @brief 阵列参数的规范化字节序列，既用于哈希也用于缓存命中校验。
+ */
+class KeyWriter {
+public:
+  void Tag(char tag) { m_bytes.push_back(tag); }
+
+  void Int(std::int64_t value) { Append(&value, sizeof(value)); }
+
+  void Double(double value) {
+    if (value == 0.0) {
+      value = 0.0; // -0.0 与 0.0 视为相同
+    }
+    Append(&value, sizeof(value));
+  }
+
+  void Point(const CPoint3D &p) {
+    Double(p.x);
+    Double(p.y);
+    Double(p.z);
+  }
+
+  void Vector(const CVector3D &v) {
+    Double(v.x);
+    Double(v.y);
+    Double(v.z);
+  }
+
+  const std::string &Bytes() const { return m_bytes; }
+
+private:
+  void Append(const void *data, std::size_t size) {
+    m_bytes.append(static_cast<const char *>(data), size);
+  }
+
+  std::string m_bytes;
+};
+
+CVector3D Unit(const CVector3D &v) {
+  CVector3D unit = v;
+  unit.Normalize();
+  return unit;
+}
+
+bool IsZero(const CVector3D &v) {
+  return std::sqrt(v.Dot(v)) <= GeoUtils::EPSILON;
+}
+
+double LinearStep(const CLinearPatternDir &dir) {
+  if (dir.spacingType == PatternSpacingType::SPAN_AND_COUNT) {
+    return dir.count > 1 ? dir.spacing / (dir.count - 1) : 0.0;
+  }
+  return dir.spacing;
+}
+
+double AngularStep(const CCircularPatternDir &dir) {
+  if (dir.spacingType == PatternSpacingType::SPAN_AND_COUNT) {
+    if (std::abs(dir.angle - kTwoPi) <= 1e-9) {
+      return dir.count > 0 ? dir.angle / dir.count : 0.0;
+    }
+    return dir.count > 1 ? dir.angle / (dir.count - 1) : 0.0;
+  }
+  return dir.angle;
+}
+
+CPoint3D ResolveAxisOrigin(const std::shared_ptr<CRefEntityBase> &ref) {
+  if (auto axis = std::dynamic_pointer_cast<CRefAxis>(ref)) {
+    return axis->origin;
+  }
+  if (auto edge = std::dynamic_pointer_cast<CRefEdge>(ref)) {
+    CPoint3D center;
+    double radius = 0.0;
+    if (edge->curveType == CGeoCurveType::CIRCLE &&
+        ComputeCircumcenter(edge->startPoint, edge->midPoint, edge->endPoint,
+                            center, radius)) {
+      return center;
+    }
+    return edge->startPoint;
+  }
+  return {};
+}
+
+bool ResolveMirrorPlane(const std::shared_ptr<CRefEntityBase> &ref,
+                        CPoint3D &origin, CVector3D &normal) {
+  if (auto plane = std::dynamic_pointer_cast<CRefPlane>(ref)) {
+    origin = plane->origin;
+    normal = plane->normal;
+  } else if (auto face = std::dynamic_pointer_cast<CRefFace>(ref)) {
+    if (face->surfaceType != CGeoSurfaceType::PLANE) {
+      return false;
+    }
+    origin = face->centroid;
+    normal = face->normal;
+  } else {
+    return false;
+  }
+  if (IsZero(normal)) {
+    return false;
+  }
+  normal.Normalize();
+  return true;
+}
+
+CMatrix4 Reflection(const CPoint3D &origin, const CVector3D &n) {
+  // p' = p - 2((p - o)·n)n
+  const double d = origin.x * n.x + origin.y * n.y + origin.z * n.z;
+  const double nv[3] = {n.x, n.y, n.z};
+  CMatrix4 result;
+  for (int r = 0; r < 3; ++r) {
+    for (int c = 0; c < 3; ++c) {
+      result.m[r][c] = (r == c ? 1.0 : 0.0) - 2.0 * nv[r] * nv[c];
+    }
+    result.m[r][3] = 2.0 * d * nv[r];
+  }
+  return result;
+}
+
+double Determinant3(const CMatrix4 &matrix) {
+  const auto &m = matrix.m;
+  return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+         m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+         m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+}
+
+void WriteLinearDir(KeyWriter &key, const CLinearPatternDir &dir) {
+  key.Vector(Unit(dir.direction));
+  key.Int(static_cast<std::int64_t>(dir.spacingType));
+  key.Double(dir.spacing);
+  key.Int(dir.count);
+}
+
+void WriteGrid(KeyWriter &key, bool seedOnly,
+               const std::vector<CPatternIndex> &skipped) {
+  key.Int(seedOnly ? 1 : 0);
+  std::vector<std::pair<int, int>> sorted;
+  sorted.reserve(skipped.size());
+  for (const auto &index : skipped) {
+    sorted.emplace_back(index.dir2Index, index.dir1Index);
+  }
+  std::sort(sorted.begin(), sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+  key.Int(static_cast<std::int64_t>(sorted.size()));
+  for (const auto &cell : sorted) {
+    key.Int(cell.first);
+    key.Int(cell.second);
+  }
+}
+
+/**
+ * @brief 生成规范键；非阵列特征返回 false。
+ */
+bool BuildKey(const CFeatureBase &feature, KeyWriter &key) {
+  switch (feature.featureType) {
+  case FeatureType::LinearPattern: {
+    const auto &pattern = static_cast<const CLinearPattern &>(feature);
+    key.Tag('L');
+    WriteLinearDir(key, pattern.dir1);
+    key.Int(pattern.dir2 ? 1 : 0);
+    if (pattern.dir2) {
+      WriteLinearDir(key, *pattern.dir2);
+    }
+    WriteGrid(key, pattern.patternSeedOnly, pattern.skippedInstances);
+    return true;
+  }
+  case FeatureType::CircularPattern: {
+    const auto &pattern = static_cast<const CCircularPattern &>(feature);
+    key.Tag('C');
+    key.Point(ResolveAxisOrigin(pattern.dir1.axisRef));
+    key.Vector(Unit(pattern.dir1.direction));
+    key.Int(static_cast<std::int64_t>(pattern.dir1.spacingType));
+    key.Double(pattern.dir1.angle);
+    key.Int(pattern.dir1.count);
+    key.Int(pattern.dir2 ? 1 : 0);
+    if (pattern.dir2) {
+      WriteLinearDir(key, *pattern.dir2);
+    }
+    WriteGrid(key, pattern.patternSeedOnly, pattern.skippedInstances);
+    return true;
+  }
+  case FeatureType::MirrorPattern: {
+    const auto &pattern = static_cast<const CMirrorPattern &>(feature);
+    key.Tag('M');
+    CPoint3D origin;
+    CVector3D normal;
+    const bool resolved =
+        ResolveMirrorPlane(pattern.mirrorPlaneRef, origin, normal);
+    key.Int(resolved ? 1 : 0);
+    if (resolved) {
+      key.Point(origin);
+      key.Vector(normal);
+    }
+    return true;
+  }
+  default:
+    return false;
+  }
+}
+
+/**
+ * @brief 初始化网格与跳过位图，并按 (dir2, dir1) 行优先生成实例。
+ */
+template <typename TransformFn>
+void FillGrid(PatternInstances &result, int count1, int count2, bool seedOnly,
+              const std::vector<CPatternIndex> &skipped, TransformFn &&fn) {
+  result.count1 = std::max(count1, 1);
+  result.count2 = std::max(count2, 1);
+  result.seedOnly = seedOnly;
+  const std::size_t cells = static_cast<std::size_t>(result.count1) *
+                            static_cast<std::size_t>(result.count2);
+  result.skippedBits.assign((cells + 63) / 64, 0);
+  for (const auto &index : skipped) {
+    if (!result.InGrid(index.dir1Index, index.dir2Index) ||
+        (index.dir1Index == 0 && index.dir2Index == 0)) {
+      continue; // 种子实例不可跳过
+    }
+    const std::size_t bit = result.Cell(index.dir1Index, index.dir2Index);
+    result.skippedBits[bit >> 6] |= std::uint64_t{1} << (bit & 63);
+  }
+
+  result.indices.reserve(cells);
+  result.transforms.reserve(cells);
+  for (int j = 0; j < result.count2; ++j) {
+    for (int i = 0; i < result.count1; ++i) {
+      if (!result.HasInstance(i, j)) {
+        continue;
+      }
+      result.indices.push_back({i, j});
+      result.transforms.push_back(fn(i, j));
+    }
+  }
+}
+
+bool ExpandLinear(const CLinearPattern &pattern, PatternInstances &result,
+                  std::string *errorMessage) {
+  const int count2 = pattern.dir2 ? pattern.dir2->count : 1;
+  if ((pattern.dir1.count > 1 && IsZero(pattern.dir1.direction)) ||
+      (count2 > 1 && IsZero(pattern.dir2->direction))) {
+    return Fail(errorMessage, "Linear pattern direction must be non-zero: " +
+                                  pattern.featureID);
+  }
+  const CVector3D dir1 = Unit(pattern.dir1.direction);
+  const double step1 = LinearStep(pattern.dir1);
+  const CVector3D dir2 = pattern.dir2 ? Unit(pattern.dir2->direction)
+                                      : CVector3D{0, 0, 0};
+  const double step2 = pattern.dir2 ? LinearStep(*pattern.dir2) : 0.0;
+
+  FillGrid(result, pattern.dir1.count, count2, pattern.patternSeedOnly,
+           pattern.skippedInstances, [&](int i, int j) {
+             const double a = i * step1;
+             const double b = j * step2;
+             return CMatrix4::Translation({a * dir1.x + b * dir2.x,
+                                           a * dir1.y + b * dir2.y,
+                                           a * dir1.z + b * dir2.z});
+           });
+  return true;
+}
+
+bool ExpandCircular(const CCircularPattern &pattern, PatternInstances &result,
+                    std::string *errorMessage) {
+  const int count2 = pattern.dir2 ? pattern.dir2->count : 1;
+  if ((pattern.dir1.count > 1 && IsZero(pattern.dir1.direction)) ||
+      (count2 > 1 && IsZero(pattern.dir2->direction))) {
+    return Fail(errorMessage, "Circular pattern axis must be non-zero: " +
+                                  pattern.featureID);
+  }
+  const CVector3D axis = Unit(pattern.dir1.direction);
+  const CPoint3D origin = ResolveAxisOrigin(pattern.dir1.axisRef);
+  const double angleStep = AngularStep(pattern.dir1);
+  const CVector3D radial = pattern.dir2 ? Unit(pattern.dir2->direction)
+                                        : CVector3D{0, 0, 0};
+  const double radialStep = pattern.dir2 ? LinearStep(*pattern.dir2) : 0.0;
+
+  FillGrid(result, pattern.dir1.count, count2, pattern.patternSeedOnly,
+           pattern.skippedInstances, [&](int i, int j) {
+             const double offset = j * radialStep;
+             return CMatrix4::Rotation(axis, i * angleStep, origin) *
+                    CMatrix4::Translation({offset * radial.x,
+                                           offset * radial.y,
+                                           offset * radial.z});
+           });
+  return true;
+}
+
+bool ExpandMirror(const CMirrorPattern &pattern, PatternInstances &result,
+                  std::string *errorMessage) {
+  CPoint3D origin;
+  CVector3D normal;
+  if (!ResolveMirrorPlane(pattern.mirrorPlaneRef, origin, normal)) {
+    return Fail(errorMessage,
+                "Mirror pattern plane must be a datum plane or planar face "
+                "with a non-zero normal: " +
+                    pattern.featureID);
+  }
+  const CMatrix4 reflection = Reflection(origin, normal);
+  FillGrid(result, 2, 1, false, {}, [&](int i, int) {
+    return i == 0 ? CMatrix4::Identity() : reflection;
+  });
+  return true;
+}
+
+/**
+ * @brief 收集种子几何中的点与方向（按遍历顺序）。
+ */
+class SeedGather : public GeometryVisitorBase {
+public:
+  void Point(CPoint3D &p) { points.Push(p); }
+  void Direction(CVector3D &v) { directions.Push(v); }
+  bool Segment(std::shared_ptr<CSketchSeg> &) { return false; }
+
+  CPointBlock points;
+  CPointBlock directions;
+};
+
+/**
+ * @brief 按与 SeedGather 相同的顺序把实例几何写回副本。
+ *
+ * 引用槽位在进入时替换为副本；同一实例内重复出现的种子复用同一副本。
+ */
+class InstanceScatter : public GeometryVisitorBase {
+public:
+  InstanceScatter(const CPointBlock &points, std::size_t pointOffset,
+                  const CPointBlock &directions, std::size_t directionOffset)
+      : m_points(points), m_directions(directions), m_pointIndex(pointOffset),
+        m_directionIndex(directionOffset) {}
+
+  void Point(CPoint3D &p) { p = m_points.PointAt(m_pointIndex++); }
+  void Direction(CVector3D &v) {
+    v = m_directions.VectorAt(m_directionIndex++);
+  }
+  bool Segment(std::shared_ptr<CSketchSeg> &) { return false; }
+
+  template <typename R> bool Ref(std::shared_ptr<R> &slot) {
+    if (!slot) {
+      return false;
+    }
+    auto it = m_clones.find(slot.get());
+    if (it != m_clones.end()) {
+      slot = std::static_pointer_cast<R>(it->second);
+      return false;
+    }
+    auto clone = CloneRefEntity(*slot);
+    m_clones.emplace(slot.get(), clone);
+    slot = std::static_pointer_cast<R>(clone);
+    return true;
+  }
+
+private:
+  const CPointBlock &m_points;
+  const CPointBlock &m_directions;
+  std::size_t m_pointIndex;
+  std::size_t m_directionIndex;
+  std::unordered_map<const CRefEntityBase *, std::shared_ptr<CRefEntityBase>>
+      m_clones;
+};
+
+} // namespace
+
+std::shared_ptr<const PatternInstances>
+PatternExpander::Expand(const CFeatureBase &pattern,
+                        std::string *errorMessage) {
+  KeyWriter key;
+  if (!BuildKey(pattern, key)) {
+    Fail(errorMessage, "Feature is not a pattern: " + pattern.featureID);
+    return nullptr;
+  }
+  const std::uint64_t hash = Fnv1a(key.Bytes());
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_cache.find(hash);
+    if (it != m_cache.end() && it->second.key == key.Bytes()) {
+      if (errorMessage) {
+        errorMessage->clear();
+      }
+      return it->second.instances;
+    }
+  }
+
+  auto result = std::make_shared<PatternInstances>();
+  bool ok = false;
+  switch (pattern.featureType) {
+  case FeatureType::LinearPattern:
+    ok = ExpandLinear(static_cast<const CLinearPattern &>(pattern), *result,
+                      errorMessage);
+    break;
+  case FeatureType::CircularPattern:
+    ok = ExpandCircular(static_cast<const CCircularPattern &>(pattern),
+                        *result, errorMessage);
+    break;
+  case FeatureType::MirrorPattern:
+    ok = ExpandMirror(static_cast<const CMirrorPattern &>(pattern), *result,
+                      errorMessage);
+    break;
+  default:
+    break;
+  }
+  if (!ok) {
+    return nullptr;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_cache.size() >= m_maxCacheEntries) {
+      m_cache.clear();
+    }
+    if (m_maxCacheEntries > 0) {
+      m_cache[hash] = CacheEntry{key.Bytes(), result};
+    }
+  }
+  if (errorMessage) {
+    errorMessage->clear();
+  }
+  return result;
+}
+
+std::uint64_t PatternExpander::ContentHash(const CFeatureBase &pattern) {
+  KeyWriter key;
+  if (!BuildKey(pattern, key)) {
+    return 0;
+  }
+  return Fnv1a(key.Bytes());
+}
+
+std::size_t PatternExpander::CacheSize() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_cache.size();
+}
+
+void PatternExpander::ClearCache() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_cache.clear();
+}
+
+CPointBlock PatternExpander::TransformPoints(const PatternInstances &instances,
+                                             const CPointBlock &seeds) {
+  CPointBlock out;
+  out.Resize(instances.Size() * seeds.Size());
+  for (std::size_t k = 0; k < instances.Size(); ++k) {
+    TransformPointBlock(instances.transforms[k], seeds, out, k * seeds.Size());
+  }
+  return out;
+}
+
+CPointBlock
+PatternExpander::TransformDirections(const PatternInstances &instances,
+                                     const CPointBlock &seeds) {
+  CPointBlock out;
+  out.Resize(instances.Size() * seeds.Size());
+  for (std::size_t k = 0; k < instances.Size(); ++k) {
+    TransformVectorBlock(instances.transforms[k], seeds, out,
+                         k * seeds.Size());
+  }
+  return out;
+}
+
+std::vector<std::shared_ptr<CRefEntityBase>>
+PatternExpander::InstantiateReferences(
+    const PatternInstances &instances,
+    const std::vector<std::shared_ptr<CRefEntityBase>> &seeds) {
+  SeedGather gather;
+  auto gatherSlots = seeds;
+  GeometryVisit::Refs(gatherSlots, gather);
+
+  const CPointBlock points = TransformPoints(instances, gather.points);
+  const CPointBlock directions =
+      TransformDirections(instances, gather.directions);
+
+  std::vector<std::shared_ptr<CRefEntityBase>> result;
+  result.reserve(instances.Size() * seeds.size());
+  for (std::size_t k = 0; k < instances.Size(); ++k) {
+    InstanceScatter scatter(points, k * gather.points.Size(), directions,
+                            k * gather.directions.Size());
+    const std::size_t begin = result.size();
+    result.insert(result.end(), seeds.begin(), seeds.end());
+    for (std::size_t n = begin; n < result.size(); ++n) {
+      GeometryVisit::Ref(result[n], scatter);
+    }
+  }
+  return result;
+}
+
+std::vector<std::shared_ptr<CSketch>>
+PatternExpander::InstantiateSketch(const PatternInstances &instances,
+                                   const CSketch &seed) {
+  SeedGather gather;
+  CSketch gatherCopy = seed;
+  GeometryVisit::Sketch(gatherCopy, gather);
+
+  const CPointBlock points = TransformPoints(instances, gather.points);
+  const CPointBlock directions =
+      TransformDirections(instances, gather.directions);
+
+  std::vector<std::shared_ptr<CSketch>> result;
+  result.reserve(instances.Size());
+  for (std::size_t k = 0; k < instances.Size(); ++k) {
+    auto sketch = std::make_shared<CSketch>(seed);
+    InstanceScatter scatter(points, k * gather.points.Size(), directions,
+                            k * gather.directions.Size());
+    GeometryVisit::Sketch(*sketch, scatter);
+    if (Determinant3(instances.transforms[k]) < 0.0) {
+      sketch->sketchCSys.zDir =
+          Cross(sketch->sketchCSys.xDir, sketch->sketchCSys.yDir);
+    }
+    result.push_back(std::move(sketch));
+  }
+  return result;
+}
+
+} // namespace Geometry
+} // namespace CADExchange
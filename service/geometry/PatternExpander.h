@@ -0,0 +1,157 @@
+#pragma once
+
+#include "../../core/ModelTransform.h"
+#include "../../core/UnifiedModel.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CADExchange {
+namespace Geometry {
+
+/**
+ * @brief 一个阵列特征展开后的实例集合。
+ *
+ * 只保存实际生成的实例（种子实例 (0,0) 恒为第一个，变换为单位阵）；
+ * 被 skippedInstances 抑制的网格位置记录在位图中，按
+ * dir2Index * count1 + dir1Index 编址。镜像阵列为 1x2 网格。
+ */
+struct PatternInstances {
+  int count1 = 1; ///< 方向 1 实例数（含种子）
+  int count2 = 1; ///< 方向 2 实例数（含种子）
+  bool seedOnly = false; ///< 方向 2 是否只阵列种子
+  std::vector<CPatternIndex> indices; ///< 生成实例的网格坐标
+  std::vector<CMatrix4> transforms;   ///< 与 indices 一一对应的实例变换
+  std::vector<std::uint64_t> skippedBits;
+
+  std::size_t Size() const { return transforms.size(); }
+
+  /**
+   * @brief 网格位置是否被 skippedInstances 显式跳过。越界返回 false。
+   */
+  bool IsSkipped(int dir1Index, int dir2Index) const {
+    if (!InGrid(dir1Index, dir2Index)) {
+      return false;
+    }
+    const std::size_t bit = Cell(dir1Index, dir2Index);
+    return (skippedBits[bit >> 6] >> (bit & 63)) & 1u;
+  }
+
+  /**
+   * @brief 网格位置是否生成实例（在网格内、未跳过、满足 seedOnly 规则）。
+   */
+  bool HasInstance(int dir1Index, int dir2Index) const {
+    if (!InGrid(dir1Index, dir2Index) || IsSkipped(dir1Index, dir2Index)) {
+      return false;
+    }
+    return !(seedOnly && dir1Index > 0 && dir2Index > 0);
+  }
+
+  bool InGrid(int dir1Index, int dir2Index) const {
+    return dir1Index >= 0 && dir2Index >= 0 && dir1Index < count1 &&
+           dir2Index < count2;
+  }
+
+  std::size_t Cell(int dir1Index, int dir2Index) const {
+    return static_cast<std::size_t>(dir2Index) *
+               static_cast<std::size_t>(count1) +
+           static_cast<std::size_t>(dir1Index);
+  }
+};
+
+/**
+ * @brief 阵列实例展开器。
+ *
+ * 把 CLinearPattern / CCircularPattern / CMirrorPattern 的参数展开为实例
+ * 变换数组，并可把变换批量作用到种子几何（SoA 点集、引用指纹、草图）。
+ *
+ * 展开结果按阵列参数的内容哈希缓存（特征 ID、名称不参与哈希），
+ * 参数相同的阵列共享同一份只读结果。本类线程安全。
+ *
+ * 几何约定：
+ *   - 线性阵列：实例 (i, j) 平移 i·step1·dir1 + j·step2·dir2；
+ *     SPAN_AND_COUNT 时 step = spacing / (count - 1)。
+ *   - 圆周阵列：先沿 dir2 径向平移，再绕轴旋转 i·stepAngle；轴原点取自
+ *     axisRef（基准轴原点 / 直线边起点 / 圆弧边圆心），无法解析时取世界原点。
+ *     SPAN_AND_COUNT 且总角为 2π 时 stepAngle = 2π / count，否则
+ *     stepAngle = angle / (count - 1)。
+ *   - 镜像阵列：种子 + 关于 mirrorPlaneRef（基准面或平面）的反射。
+ */
+class PatternExpander {
+public:
+  explicit PatternExpander(std::size_t maxCacheEntries = 256)
+      : m_maxCacheEntries(maxCacheEntries) {}
+
+  PatternExpander(const PatternExpander &) = delete;
+  PatternExpander &operator=(const PatternExpander &) = delete;
+
+  /**
+   * @brief 展开阵列特征。
+   *
+   * @param pattern 线性、圆周或镜像阵列特征。
+   * @param errorMessage 可选的错误输出。
+   * @return 失败（非阵列特征、镜像面无法解析等）时返回空指针。
+   */
+  std::shared_ptr<const PatternInstances>
+  Expand(const CFeatureBase &pattern, std::string *errorMessage = nullptr);
+
+  /**
+   * @brief 阵列参数的内容哈希（FNV-1a 64）。非阵列特征返回 0。
+   */
+  static std::uint64_t ContentHash(const CFeatureBase &pattern);
+
+  std::size_t CacheSize() const;
+  void ClearCache();
+
+  /**
+   * @brief 把种子点批量变换到每个实例。
+   *
+   * @return 实例优先排列的点集：第 k 个实例的第 n 个点位于
+   *         k * seeds.Size() + n。
+   */
+  static CPointBlock TransformPoints(const PatternInstances &instances,
+                                     const CPointBlock &seeds);
+
+  /**
+   * @brief 同 TransformPoints，但作用于方向/法向（不含平移）。
+   */
+  static CPointBlock TransformDirections(const PatternInstances &instances,
+                                         const CPointBlock &seeds);
+
+  /**
+   * @brief 为每个实例生成种子引用指纹的变换副本。
+   *
+   * @return 实例优先排列，大小为 instances.Size() * seeds.size()；
+   *         空种子对应位置为空指针。同一实例内共享的种子保持共享。
+   */
+  static std::vector<std::shared_ptr<CRefEntityBase>> InstantiateReferences(
+      const PatternInstances &instances,
+      const std::vector<std::shared_ptr<CRefEntityBase>> &seeds);
+
+  /**
+   * @brief 为每个实例生成种子草图的副本。
+   *
+   * 草图段为局部坐标，只需变换 sketchCSys、参考平面与外部约束引用；
+   * 段对象与种子共享。镜像实例的 zDir 重新取 xDir × yDir 以保持右手系，
+   * 局部坐标因此无需翻转。
+   */
+  static std::vector<std::shared_ptr<CSketch>>
+  InstantiateSketch(const PatternInstances &instances, const CSketch &seed);
+
+private:
+  struct CacheEntry {
+    std::string key;
+    std::shared_ptr<const PatternInstances> instances;
+  };
+
+  std::size_t m_maxCacheEntries;
+  mutable std::mutex m_mutex;
+  std::unordered_map<std::uint64_t, CacheEntry> m_cache;
+};
+
+} // namespace Geometry
+} // namespace CADExchange
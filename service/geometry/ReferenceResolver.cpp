@@ -0,0 +1,360 @@
+#include "ReferenceResolver.h"
+#include "ReferenceSlots.h"
+#include "VectorMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace CADExchange {
+namespace Geometry {
+
+namespace {
+
+/// 同一引用的解析结果只需在得分上区分 0 与极小值，避免除零。
+constexpr double kScoreEpsilon = 1e-12;
+
+using detail::Distance;
+
+bool IsTopologyRef(const CRefEntityBase &ref) {
+  return ref.refType == RefType::TOPO_FACE ||
+         ref.refType == RefType::TOPO_EDGE ||
+         ref.refType == RefType::TOPO_VERTEX;
+}
+
+CVector3D UnitOrZero(const CVector3D &v) {
+  if (std::sqrt(v.Dot(v)) <= GeoUtils::EPSILON) {
+    return {};
+  }
+  CVector3D unit = v;
+  unit.Normalize();
+  return unit;
+}
+
+struct Scored {
+  int index = -1;
+  double score = 0.0;
+  double deviation = 0.0;
+};
+
+/**
+ * @brief 由容差内候选（未排序）生成解析结果。
+ */
+ReferenceResolution Summarize(std::vector<Scored> &accepted) {
+  ReferenceResolution result;
+  if (accepted.empty()) {
+    result.status = ResolveStatus::Unresolved;
+    return result;
+  }
+  std::sort(accepted.begin(), accepted.end(),
+            [](const Scored &a, const Scored &b) {
+              return a.score != b.score ? a.score < b.score : a.index < b.index;
+            });
+  const Scored &best = accepted.front();
+  result.candidate = best.index;
+  result.deviation = best.deviation;
+
+  double separation = 1.0;
+  if (accepted.size() > 1) {
+    const double second = accepted[1].score;
+    separation = second > kScoreEpsilon ? (second - best.score) / second : 0.0;
+    result.status = ResolveStatus::Ambiguous;
+    result.ambiguities.reserve(accepted.size() - 1);
+    for (std::size_t i = 1; i < accepted.size(); ++i) {
+      result.ambiguities.push_back(accepted[i].index);
+    }
+  } else {
+    result.status = ResolveStatus::Resolved;
+  }
+  result.confidence = (1.0 - 0.5 * best.score) * separation;
+  return result;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// 哈希网格：单元边长等于容差，半径不超过容差的查询只需检查 3x3x3 单元。
+// ---------------------------------------------------------------------------
+
+class ReferenceResolver::PointGrid {
+public:
+  explicit PointGrid(double cellSize) : m_inverseCell(1.0 / cellSize) {}
+
+  void Insert(const CPoint3D &p, int index) {
+    m_cells[KeyOf(Cell(p.x), Cell(p.y), Cell(p.z))].push_back(index);
+  }
+
+  template <typename Fn> void ForEachNear(const CPoint3D &p, Fn &&fn) const {
+    const std::int64_t cx = Cell(p.x);
+    const std::int64_t cy = Cell(p.y);
+    const std::int64_t cz = Cell(p.z);
+    for (std::int64_t dx = -1; dx <= 1; ++dx) {
+      for (std::int64_t dy = -1; dy <= 1; ++dy) {
+        for (std::int64_t dz = -1; dz <= 1; ++dz) {
+          auto it = m_cells.find(KeyOf(cx + dx, cy + dy, cz + dz));
+          if (it == m_cells.end()) {
+            continue;
+          }
+          for (int index : it->second) {
+            fn(index);
+          }
+        }
+      }
+    }
+  }
+
+private:
+  std::int64_t Cell(double v) const {
+    return static_cast<std::int64_t>(std::floor(v * m_inverseCell));
+  }
+
+  /// 每轴取低 21 位拼成 63 位键；相距 2^21 个单元的点会落入同一桶，
+  /// 只影响性能，候选仍会逐一做距离判断。
+  static std::uint64_t KeyOf(std::int64_t x, std::int64_t y, std::int64_t z) {
+    constexpr std::uint64_t mask = (1ull << 21) - 1;
+    return (static_cast<std::uint64_t>(x) & mask) |
+           ((static_cast<std::uint64_t>(y) & mask) << 21) |
+           ((static_cast<std::uint64_t>(z) & mask) << 42);
+  }
+
+  double m_inverseCell;
+  std::unordered_map<std::uint64_t, std::vector<int>> m_cells;
+};
+
+// ---------------------------------------------------------------------------
+// 构造
+// ---------------------------------------------------------------------------
+
+ReferenceResolver::ReferenceResolver(CandidateTopology topology, UnitType unit,
+                                     const ResolveOptions &options)
+    : m_topology(std::move(topology)), m_options(options) {
+  if (options.tolerance > 0.0) {
+    m_tolerance = options.tolerance;
+  } else if (!TryGetGeometryCompareTolerance(unit, m_tolerance)) {
+    throw std::invalid_argument(
+        "ReferenceResolver: unsupported unit for geometry compare tolerance");
+  }
+
+  m_faceGrid = std::make_unique<PointGrid>(m_tolerance);
+  m_edgeGrid = std::make_unique<PointGrid>(m_tolerance);
+  m_vertexGrid = std::make_unique<PointGrid>(m_tolerance);
+
+  m_faceNormals.reserve(m_topology.faces.size());
+  for (std::size_t i = 0; i < m_topology.faces.size(); ++i) {
+    m_faceNormals.push_back(UnitOrZero(m_topology.faces[i].normal));
+    m_faceGrid->Insert(m_topology.faces[i].centroid, static_cast<int>(i));
+  }
+  for (std::size_t i = 0; i < m_topology.edges.size(); ++i) {
+    m_edgeGrid->Insert(m_topology.edges[i].midPoint, static_cast<int>(i));
+  }
+
+  if (m_topology.vertices.empty()) {
+    // 由边端点生成顶点：容差内的端点合并为一个。
+    auto addUnique = [&](const CPoint3D &p) {
+      bool found = false;
+      m_vertexGrid->ForEachNear(p, [&](int index) {
+        found = found || Distance(m_topology.vertices[index], p) <= m_tolerance;
+      });
+      if (!found) {
+        m_vertexGrid->Insert(p, static_cast<int>(m_topology.vertices.size()));
+        m_topology.vertices.push_back(p);
+      }
+    };
+    for (const auto &edge : m_topology.edges) {
+      addUnique(edge.startPoint);
+      addUnique(edge.endPoint);
+    }
+  } else {
+    for (std::size_t i = 0; i < m_topology.vertices.size(); ++i) {
+      m_vertexGrid->Insert(m_topology.vertices[i], static_cast<int>(i));
+    }
+  }
+}
+
+ReferenceResolver::~ReferenceResolver() = default;
+
+// ---------------------------------------------------------------------------
+// 单个引用
+// ---------------------------------------------------------------------------
+
+ReferenceResolution
+ReferenceResolver::Resolve(const std::shared_ptr<CRefEntityBase> &ref) const {
+  ReferenceResolution result;
+  if (ref) {
+    if (auto face = std::dynamic_pointer_cast<CRefFace>(ref)) {
+      result = ResolveFace(*face);
+    } else if (auto edge = std::dynamic_pointer_cast<CRefEdge>(ref)) {
+      result = ResolveEdge(*edge);
+    } else if (auto vertex = std::dynamic_pointer_cast<CRefVertex>(ref)) {
+      result = ResolveVertex(*vertex);
+    } else {
+      result.status = ResolveStatus::Unsupported;
+    }
+  } else {
+    result.status = ResolveStatus::Unsupported;
+  }
+  result.slot.ref = ref;
+  return result;
+}
+
+ReferenceResolution ReferenceResolver::ResolveFace(const CRefFace &face) const {
+  const CVector3D normal = UnitOrZero(face.normal);
+  const bool hasNormal = normal.Dot(normal) > 0.5;
+  const double maxAngle = m_options.maxNormalAngle;
+
+  std::vector<Scored> accepted;
+  m_faceGrid->ForEachNear(face.centroid, [&](int index) {
+    const CandidateFace &candidate = m_topology.faces[index];
+    if (face.surfaceType != CGeoSurfaceType::UNKNOWN &&
+        candidate.surfaceType != CGeoSurfaceType::UNKNOWN &&
+        face.surfaceType != candidate.surfaceType) {
+      return;
+    }
+    const double distance = Distance(face.centroid, candidate.centroid);
+    if (distance > m_tolerance) {
+      return;
+    }
+    double score = distance / m_tolerance;
+    const CVector3D &candidateNormal = m_faceNormals[index];
+    if (hasNormal && candidateNormal.Dot(candidateNormal) > 0.5) {
+      const double cosine = std::clamp(normal.Dot(candidateNormal), -1.0, 1.0);
+      const double angle = std::acos(cosine);
+      if (angle > maxAngle) {
+        return;
+      }
+      score = std::max(score, maxAngle > 0.0 ? angle / maxAngle : 0.0);
+    }
+    accepted.push_back({index, score, distance});
+  });
+  return Summarize(accepted);
+}
+
+ReferenceResolution ReferenceResolver::ResolveEdge(const CRefEdge &edge) const {
+  std::vector<Scored> accepted;
+  m_edgeGrid->ForEachNear(edge.midPoint, [&](int index) {
+    const CRefEdge &candidate = m_topology.edges[index];
+    if (edge.curveType != CGeoCurveType::UNKNOWN &&
+        candidate.curveType != CGeoCurveType::UNKNOWN &&
+        edge.curveType != candidate.curveType) {
+      return;
+    }
+    const double mid = Distance(edge.midPoint, candidate.midPoint);
+    if (mid > m_tolerance) {
+      return;
+    }
+    const double forward =
+        std::max(Distance(edge.startPoint, candidate.startPoint),
+                 Distance(edge.endPoint, candidate.endPoint));
+    const double reverse =
+        std::max(Distance(edge.startPoint, candidate.endPoint),
+                 Distance(edge.endPoint, candidate.startPoint));
+    const double deviation = std::max(mid, std::min(forward, reverse));
+    if (deviation > m_tolerance) {
+      return;
+    }
+    accepted.push_back({index, deviation / m_tolerance, deviation});
+  });
+  return Summarize(accepted);
+}
+
+ReferenceResolution
+ReferenceResolver::ResolveVertex(const CRefVertex &vertex) const {
+  std::vector<Scored> accepted;
+  m_vertexGrid->ForEachNear(vertex.pos, [&](int index) {
+    const double distance = Distance(vertex.pos, m_topology.vertices[index]);
+    if (distance <= m_tolerance) {
+      accepted.push_back({index, distance / m_tolerance, distance});
+    }
+  });
+  return Summarize(accepted);
+}
+
+// ---------------------------------------------------------------------------
+// 特征与批量
+// ---------------------------------------------------------------------------
+
+std::vector<ReferenceResolution>
+ReferenceResolver::ResolveFeature(const CFeatureBase &feature) const {
+  std::vector<ReferenceResolution> results;
+  const auto refs = detail::CollectReferenceSlots(feature);
+  for (std::size_t ordinal = 0; ordinal < refs.size(); ++ordinal) {
+    const auto &ref = refs[ordinal];
+    if (!IsTopologyRef(*ref)) {
+      continue;
+    }
+    ReferenceResolution resolution = Resolve(ref);
+    resolution.slot = {feature.featureID, ordinal, ref};
+    results.push_back(std::move(resolution));
+  }
+  return results;
+}
+
+std::vector<ReferenceResolution> ReferenceResolver::ResolveFeatures(
+    const std::vector<std::shared_ptr<CFeatureBase>> &features) const {
+  // 1. 串行采集槽位，并为共享引用去重。
+  std::vector<ReferenceSlot> slots;
+  std::vector<std::size_t> uniqueOf;
+  std::vector<std::shared_ptr<CRefEntityBase>> unique;
+  std::unordered_map<const CRefEntityBase *, std::size_t> uniqueIndex;
+  for (const auto &feature : features) {
+    if (!feature) {
+      continue;
+    }
+    const auto refs = detail::CollectReferenceSlots(*feature);
+    for (std::size_t ordinal = 0; ordinal < refs.size(); ++ordinal) {
+      const auto &ref = refs[ordinal];
+      if (!IsTopologyRef(*ref)) {
+        continue;
+      }
+      auto [it, inserted] = uniqueIndex.emplace(ref.get(), unique.size());
+      if (inserted) {
+        unique.push_back(ref);
+      }
+      slots.push_back({feature->featureID, ordinal, ref});
+      uniqueOf.push_back(it->second);
+    }
+  }
+
+  // 2. 按连续区间分给工作线程；各线程只写自己的结果区间。
+  std::vector<ReferenceResolution> resolved(unique.size());
+  unsigned threadCount = m_options.threadCount;
+  if (threadCount == 0) {
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+  constexpr std::size_t kMinRefsPerThread = 64;
+  threadCount = static_cast<unsigned>(std::min<std::size_t>(
+      threadCount, (unique.size() + kMinRefsPerThread - 1) / kMinRefsPerThread));
+  auto work = [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      resolved[i] = Resolve(unique[i]);
+    }
+  };
+  if (threadCount <= 1) {
+    work(0, unique.size());
+  } else {
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount);
+    const std::size_t chunk = (unique.size() + threadCount - 1) / threadCount;
+    for (std::size_t begin = 0; begin < unique.size(); begin += chunk) {
+      workers.emplace_back(work, begin, std::min(begin + chunk, unique.size()));
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+
+  // 3. 展开回槽位顺序。
+  std::vector<ReferenceResolution> results;
+  results.reserve(slots.size());
+  for (std::size_t i = 0; i < slots.size(); ++i) {
+    ReferenceResolution resolution = resolved[uniqueOf[i]];
+    resolution.slot = std::move(slots[i]);
+    results.push_back(std::move(resolution));
+  }
+  return results;
+}
+
+} // namespace Geometry
+} // namespace CADExchange
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "../../core/UnifiedModel.h"
+#include "GeometryCollectorBase.h"
+#include "ReferenceSpatialIndex.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace CADExchange {
+namespace Geometry {
+
+/**
+ * @brief 目标实体当前拓扑中的一个面（由写入桥接端采集）。
+ *
+ * centroid 的取法需与 CRefFace::centroid 一致（面上采样点）。
+ */
+struct CandidateFace {
+  CPoint3D centroid;
+  CVector3D normal;
+  CGeoSurfaceType surfaceType = CGeoSurfaceType::UNKNOWN;
+};
+
+/**
+ * @brief 候选拓扑。vertices 为空时由 edges 的端点按容差去重生成。
+ */
+struct CandidateTopology {
+  std::vector<CRefEdge> edges;
+  std::vector<CandidateFace> faces;
+  std::vector<CPoint3D> vertices;
+};
+
+enum class ResolveStatus {
+  Resolved,    ///< 唯一候选落在容差内
+  Ambiguous,   ///< 多个候选落在容差内，candidate 为得分最好者
+  Unresolved,  ///< 没有候选落在容差内
+  Unsupported  ///< 不是面/边/顶点引用
+};
+
+struct ResolveOptions {
+  double tolerance = 0.0;       ///< > 0 时覆盖按单位取得的比较容差
+  double maxNormalAngle = 1e-3; ///< 面法向允许的最大夹角（弧度）
+  unsigned threadCount = 0;     ///< 批量解析的线程数，0 取硬件并发数
+};
+
+/**
+ * @brief 单个引用的解析结果。
+ *
+ * candidate 与 ambiguities 是对应候选数组（面 → faces、边 → edges、
+ * 顶点 → vertices）中的下标。偏差按容差归一化为得分 s ∈ [0, 1]：
+ * 面取 max(质心距离 / tol, 法向夹角 / maxNormalAngle)，边取三点（允许
+ * 反向）最大距离 / tol，顶点取距离 / tol。
+ *
+ * confidence = (1 - s/2) · separation，其中唯一匹配时 separation 为 1，
+ * 有歧义时为 (s₂ - s) / s₂（s₂ 为次优得分），两者等同时为 0。
+ */
+struct ReferenceResolution {
+  ReferenceSlot slot;
+  ResolveStatus status = ResolveStatus::Unresolved;
+  int candidate = -1;
+  double deviation = 0.0; ///< 最佳候选的指纹偏差（长度单位，面含法向项时取距离）
+  double confidence = 0.0;
+  std::vector<int> ambiguities; ///< 其余容差内候选，按得分升序
+};
+
+/**
+ * @brief 引用批量解析器：把特征中的 CRefFace / CRefEdge / CRefVertex 按
+ *        几何指纹匹配到目标实体的当前拓扑。
+ *
+ * 构造时一次性为候选面质心、边中点与顶点建立哈希网格（单元边长为容差），
+ * 每个引用只检查相邻 27 个单元。边允许反向匹配；曲线/曲面类型两侧都
+ * 已知且不同时不匹配。
+ *
+ * 构造后只读，所有解析函数可并发调用。
+ */
+class ReferenceResolver {
+public:
+  /**
+   * @throws std::invalid_argument 当 options.tolerance 未指定且单位不受
+   *         TryGetGeometryCompareTolerance 支持时。
+   */
+  ReferenceResolver(CandidateTopology topology, UnitType unit,
+                    const ResolveOptions &options = {});
+
+  /**
+   * @brief 以采集器的边作为候选边，faces 作为候选面。
+   */
+  template <typename Derived>
+  ReferenceResolver(const GeometryCollectorBase<Derived, CRefEdge> &collector,
+                    std::vector<CandidateFace> faces, UnitType unit,
+                    const ResolveOptions &options = {})
+      : ReferenceResolver(
+            CandidateTopology{collector.GetEdges(), std::move(faces), {}},
+            unit, options) {}
+
+  ~ReferenceResolver();
+
+  ReferenceResolver(const ReferenceResolver &) = delete;
+  ReferenceResolver &operator=(const ReferenceResolver &) = delete;
+
+  double GetTolerance() const { return m_tolerance; }
+  const CandidateTopology &GetTopology() const { return m_topology; }
+
+  /**
+   * @brief 解析单个引用；结果的 slot 只填写 ref。
+   */
+  ReferenceResolution Resolve(const std::shared_ptr<CRefEntityBase> &ref) const;
+
+  /**
+   * @brief 解析特征中全部面/边/顶点引用槽位。
+   *
+   * 槽位序号与 ReferenceSpatialIndex 一致（VisitFeatureGeometry 遍历
+   * 顺序，所有非空引用都计数），其他类型的引用不出现在结果中。
+   */
+  std::vector<ReferenceResolution> ResolveFeature(const CFeatureBase &feature) const;
+
+  /**
+   * @brief 多线程解析一批特征，结果按特征、槽位顺序排列。
+   *
+   * 被多个槽位共享的引用只解析一次。
+   */
+  std::vector<ReferenceResolution>
+  ResolveFeatures(const std::vector<std::shared_ptr<CFeatureBase>> &features) const;
+
+private:
+  class PointGrid;
+
+  ReferenceResolution ResolveFace(const CRefFace &face) const;
+  ReferenceResolution ResolveEdge(const CRefEdge &edge) const;
+  ReferenceResolution ResolveVertex(const CRefVertex &vertex) const;
+
+  CandidateTopology m_topology;
+  ResolveOptions m_options;
+  double m_tolerance = 0.0;
+  std::vector<CVector3D> m_faceNormals; ///< 归一化后的候选面法向
+  std::unique_ptr<PointGrid> m_faceGrid;
+  std::unique_ptr<PointGrid> m_edgeGrid;
+  std::unique_ptr<PointGrid> m_vertexGrid;
+};
+
+} // namespace Geometry
+} // namespace CADExchange
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "../../core/ModelGeometryVisitor.h"
+
+#include <memory>
+#include <vector>
+
+/**
+ * @file ReferenceSlots.h
+ * @brief 特征引用槽位的统一采集，保证 ReferenceSpatialIndex 与
+ *        ReferenceResolver 的槽位序号一致。
+ *
+ * 仅供 service/geometry 下的 .cpp 实现文件使用，不属于公开接口。
+ */
+
+namespace CADExchange {
+namespace Geometry {
+namespace detail {
+
+/**
+ * @brief 只读采集特征中的引用槽位（不进入引用内部，也不遍历草图段）。
+ */
+class SlotCollector : public GeometryVisitorBase {
+public:
+  template <typename R> bool Ref(std::shared_ptr<R> &slot) {
+    if (slot) {
+      refs.push_back(slot);
+    }
+    return false;
+  }
+
+  bool Segment(std::shared_ptr<CSketchSeg> &) { return false; }
+
+  std::vector<std::shared_ptr<CRefEntityBase>> refs;
+};
+
+/**
+ * @brief 按访问顺序返回特征的非空引用槽位；下标即槽位序号。
+ */
+inline std::vector<std::shared_ptr<CRefEntityBase>>
+CollectReferenceSlots(const CFeatureBase &feature) {
+  // 采集器只读取槽位指针，不修改特征。
+  SlotCollector collector;
+  VisitFeatureGeometry(const_cast<CFeatureBase &>(feature), collector);
+  return std::move(collector.refs);
+}
+
+} // namespace detail
+} // namespace Geometry
+} // namespace CADExchange
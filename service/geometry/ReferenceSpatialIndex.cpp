@@ -0,0 +1,637 @@
+#include "ReferenceSpatialIndex.h"
+#include "ReferenceSlots.h"
+#include "VectorMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+
+namespace CADExchange {
+namespace Geometry {
+
+namespace {
+
+using detail::Distance;
+
+/// 立方体面分桶的半角：桶内任意法向与桶主轴夹角不超过 acos(1/√3)。
+constexpr double kNormalBinHalfAngle = 0.9553166181245093;
+
+const CVector3D kBinAxes[6] = {{1, 0, 0},  {-1, 0, 0}, {0, 1, 0},
+                               {0, -1, 0}, {0, 0, 1},  {0, 0, -1}};
+
+double Dot3(const CVector3D &a, const CVector3D &b) { return a.Dot(b); }
+
+CPoint3D Lerp(const CPoint3D &a, const CPoint3D &b, double t) {
+  return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t,
+          a.z + (b.z - a.z) * t};
+}
+
+/// 点到线段的最近点。
+CPoint3D ClosestOnSegment(const CPoint3D &p, const CPoint3D &a,
+                          const CPoint3D &b) {
+  const CVector3D ab = b - a;
+  const double len2 = Dot3(ab, ab);
+  if (len2 <= GeoUtils::EPSILON * GeoUtils::EPSILON) {
+    return a;
+  }
+  const double t = std::clamp(Dot3(p - a, ab) / len2, 0.0, 1.0);
+  return Lerp(a, b, t);
+}
+
+/**
+ * @brief 射线 (t >= 0，方向为单位向量) 与线段最近点对。
+ *
+ * @param rayT 输出射线参数。
+ * @return 线段上的最近点。
+ */
+CPoint3D ClosestRaySegment(const CPoint3D &origin, const CVector3D &dir,
+                           const CPoint3D &a, const CPoint3D &b,
+                           double &rayT) {
+  const CVector3D d2 = b - a;
+  const CVector3D r = origin - a;
+  const double e = Dot3(d2, d2);
+  const double c = Dot3(dir, r);
+  if (e <= GeoUtils::EPSILON * GeoUtils::EPSILON) {
+    rayT = std::max(0.0, -c);
+    return a;
+  }
+  const double f = Dot3(d2, r);
+  const double bdot = Dot3(dir, d2);
+  const double denom = e - bdot * bdot;
+  double t = denom > GeoUtils::EPSILON ? std::max(0.0, (bdot * f - c * e) / denom)
+                                       : 0.0;
+  double s = (bdot * t + f) / e;
+  if (s < 0.0) {
+    s = 0.0;
+    t = std::max(0.0, -c);
+  } else if (s > 1.0) {
+    s = 1.0;
+    t = std::max(0.0, bdot - c);
+  }
+  rayT = t;
+  return Lerp(a, b, s);
+}
+
+CPoint3D RayPoint(const CPoint3D &origin, const CVector3D &dir, double t) {
+  return {origin.x + dir.x * t, origin.y + dir.y * t, origin.z + dir.z * t};
+}
+
+std::size_t NormalBin(const CVector3D &n) {
+  const double ax = std::abs(n.x), ay = std::abs(n.y), az = std::abs(n.z);
+  if (ax >= ay && ax >= az) {
+    return n.x >= 0 ? 0 : 1;
+  }
+  if (ay >= az) {
+    return n.y >= 0 ? 2 : 3;
+  }
+  return n.z >= 0 ? 4 : 5;
+}
+
+double AngleBetween(const CVector3D &unitA, const CVector3D &unitB) {
+  return std::acos(std::clamp(Dot3(unitA, unitB), -1.0, 1.0));
+}
+
+std::optional<CVector3D> UnitOrNull(const CVector3D &v) {
+  if (std::sqrt(Dot3(v, v)) <= GeoUtils::EPSILON) {
+    return std::nullopt;
+  }
+  CVector3D unit = v;
+  unit.Normalize();
+  return unit;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// 构建与维护
+// ---------------------------------------------------------------------------
+
+void ReferenceSpatialIndex::Clear() {
+  m_slots.clear();
+  m_featureSlots.clear();
+  m_featureOrder.clear();
+  m_primitives.clear();
+  m_bvhOrder.clear();
+  m_nodes.clear();
+  m_pending.clear();
+  for (auto &bin : m_normalBins) {
+    bin.clear();
+  }
+  m_deadSlots = 0;
+}
+
+void ReferenceSpatialIndex::Build(const UnifiedModel &model) {
+  Clear();
+  for (const auto &feature : model.GetFeatures()) {
+    if (feature) {
+      CollectFeature(*feature);
+      m_featureOrder.push_back({feature, feature->featureID});
+    }
+  }
+  RebuildTree();
+}
+
+bool ReferenceSpatialIndex::Update(const UnifiedModel &model) {
+  std::vector<const std::shared_ptr<CFeatureBase> *> current;
+  current.reserve(model.GetFeatures().size());
+  for (const auto &feature : model.GetFeatures()) {
+    if (feature) {
+      current.push_back(&feature);
+    }
+  }
+  // 仍存活的同一对象才算未变化：已释放特征的 weak_ptr 失效，地址复用不会误判。
+  bool appendOnly = current.size() >= m_featureOrder.size();
+  for (std::size_t i = 0; appendOnly && i < m_featureOrder.size(); ++i) {
+    const auto &entry = m_featureOrder[i];
+    const auto known = entry.feature.lock();
+    appendOnly = known && known == *current[i] &&
+                 entry.featureID == (*current[i])->featureID;
+  }
+  if (!appendOnly) {
+    Build(model);
+    return false;
+  }
+  for (std::size_t i = m_featureOrder.size(); i < current.size(); ++i) {
+    const auto &feature = *current[i];
+    CollectFeature(*feature);
+    m_featureOrder.push_back({feature, feature->featureID});
+  }
+  MaybeRebuild();
+  return true;
+}
+
+void ReferenceSpatialIndex::AddFeature(const CFeatureBase &feature) {
+  CollectFeature(feature);
+  m_featureOrder.push_back({{}, feature.featureID});
+  MaybeRebuild();
+}
+
+void ReferenceSpatialIndex::RemoveFeature(const std::string &featureID) {
+  DropFeatureSlots(featureID);
+  m_featureOrder.erase(
+      std::remove_if(m_featureOrder.begin(), m_featureOrder.end(),
+                     [&](const auto &entry) { return entry.featureID == featureID; }),
+      m_featureOrder.end());
+  MaybeRebuild();
+}
+
+void ReferenceSpatialIndex::RefreshFeature(const CFeatureBase &feature) {
+  DropFeatureSlots(feature.featureID);
+  CollectFeature(feature);
+  MaybeRebuild();
+}
+
+void ReferenceSpatialIndex::DropFeatureSlots(const std::string &featureID) {
+  auto it = m_featureSlots.find(featureID);
+  if (it == m_featureSlots.end()) {
+    return;
+  }
+  for (std::uint32_t slot : it->second) {
+    if (m_slots[slot].alive) {
+      m_slots[slot].alive = false;
+      ++m_deadSlots;
+    }
+  }
+  m_featureSlots.erase(it);
+}
+
+void ReferenceSpatialIndex::CollectFeature(const CFeatureBase &feature) {
+  const auto refs = detail::CollectReferenceSlots(feature);
+
+  auto &owned = m_featureSlots[feature.featureID];
+  for (std::size_t ordinal = 0; ordinal < refs.size(); ++ordinal) {
+    const auto &ref = refs[ordinal];
+    const auto slotIndex = static_cast<std::uint32_t>(m_slots.size());
+    SlotRecord record;
+    record.slot = {feature.featureID, ordinal, ref};
+    record.refType = ref->refType;
+
+    std::vector<Primitive> primitives;
+    if (auto face = std::dynamic_pointer_cast<CRefFace>(ref)) {
+      primitives.push_back({face->centroid, face->centroid, slotIndex});
+      record.normal = UnitOrNull(face->normal);
+    } else if (auto edge = std::dynamic_pointer_cast<CRefEdge>(ref)) {
+      primitives.push_back({edge->startPoint, edge->midPoint, slotIndex});
+      primitives.push_back({edge->midPoint, edge->endPoint, slotIndex});
+    } else if (auto vertex = std::dynamic_pointer_cast<CRefVertex>(ref)) {
+      primitives.push_back({vertex->pos, vertex->pos, slotIndex});
+    } else if (auto plane = std::dynamic_pointer_cast<CRefPlane>(ref)) {
+      primitives.push_back({plane->origin, plane->origin, slotIndex});
+      record.normal = UnitOrNull(plane->normal);
+    } else if (auto axis = std::dynamic_pointer_cast<CRefAxis>(ref)) {
+      primitives.push_back({axis->origin, axis->origin, slotIndex});
+    } else if (auto point = std::dynamic_pointer_cast<CRefPoint>(ref)) {
+      primitives.push_back({point->position, point->position, slotIndex});
+    }
+    if (primitives.empty()) {
+      continue; // 草图、草图段等没有几何指纹的引用不入索引
+    }
+
+    if (record.normal) {
+      m_normalBins[NormalBin(*record.normal)].push_back(slotIndex);
+    }
+    for (const auto &primitive : primitives) {
+      m_pending.push_back(static_cast<std::uint32_t>(m_primitives.size()));
+      m_primitives.push_back(primitive);
+    }
+    m_slots.push_back(std::move(record));
+    owned.push_back(slotIndex);
+  }
+}
+
+void ReferenceSpatialIndex::MaybeRebuild() {
+  const std::size_t inTree = m_bvhOrder.size();
+  const bool tooManyPending =
+      m_pending.size() > 32 && m_pending.size() * 4 > inTree;
+  const bool tooManyDead = m_deadSlots > 0 && m_deadSlots * 2 > m_slots.size();
+  if (tooManyPending || tooManyDead) {
+    RebuildTree();
+  }
+}
+
+void ReferenceSpatialIndex::RebuildTree() {
+  // 压缩：丢弃墓碑槽位并重映射图元、分桶与特征归属。
+  if (m_deadSlots > 0) {
+    std::vector<std::uint32_t> remap(m_slots.size(),
+                                     std::numeric_limits<std::uint32_t>::max());
+    std::vector<SlotRecord> slots;
+    slots.reserve(m_slots.size() - m_deadSlots);
+    for (std::size_t i = 0; i < m_slots.size(); ++i) {
+      if (m_slots[i].alive) {
+        remap[i] = static_cast<std::uint32_t>(slots.size());
+        slots.push_back(std::move(m_slots[i]));
+      }
+    }
+    std::vector<Primitive> primitives;
+    primitives.reserve(m_primitives.size());
+    for (const auto &primitive : m_primitives) {
+      const std::uint32_t slot = remap[primitive.slot];
+      if (slot != std::numeric_limits<std::uint32_t>::max()) {
+        primitives.push_back({primitive.a, primitive.b, slot});
+      }
+    }
+    m_slots = std::move(slots);
+    m_primitives = std::move(primitives);
+    m_deadSlots = 0;
+
+    m_featureSlots.clear();
+    for (auto &bin : m_normalBins) {
+      bin.clear();
+    }
+    for (std::size_t i = 0; i < m_slots.size(); ++i) {
+      const auto index = static_cast<std::uint32_t>(i);
+      m_featureSlots[m_slots[i].slot.featureID].push_back(index);
+      if (m_slots[i].normal) {
+        m_normalBins[NormalBin(*m_slots[i].normal)].push_back(index);
+      }
+    }
+  }
+
+  m_pending.clear();
+  m_nodes.clear();
+  m_bvhOrder.resize(m_primitives.size());
+  for (std::size_t i = 0; i < m_primitives.size(); ++i) {
+    m_bvhOrder[i] = static_cast<std::uint32_t>(i);
+  }
+  if (!m_bvhOrder.empty()) {
+    m_nodes.reserve(2 * m_bvhOrder.size() / kLeafSize + 1);
+    BuildNode(0, static_cast<std::uint32_t>(m_bvhOrder.size()));
+  }
+}
+
+std::uint32_t ReferenceSpatialIndex::BuildNode(std::uint32_t begin,
+                                               std::uint32_t end) {
+  const auto index = static_cast<std::uint32_t>(m_nodes.size());
+  m_nodes.emplace_back();
+
+  Node node;
+  double cmin[3], cmax[3];
+  for (int axis = 0; axis < 3; ++axis) {
+    node.min[axis] = cmin[axis] = std::numeric_limits<double>::infinity();
+    node.max[axis] = cmax[axis] = -std::numeric_limits<double>::infinity();
+  }
+  for (std::uint32_t i = begin; i < end; ++i) {
+    const Primitive &p = m_primitives[m_bvhOrder[i]];
+    const double a[3] = {p.a.x, p.a.y, p.a.z};
+    const double b[3] = {p.b.x, p.b.y, p.b.z};
+    for (int axis = 0; axis < 3; ++axis) {
+      node.min[axis] = std::min({node.min[axis], a[axis], b[axis]});
+      node.max[axis] = std::max({node.max[axis], a[axis], b[axis]});
+      const double c = 0.5 * (a[axis] + b[axis]);
+      cmin[axis] = std::min(cmin[axis], c);
+      cmax[axis] = std::max(cmax[axis], c);
+    }
+  }
+
+  if (end - begin <= kLeafSize) {
+    node.first = begin;
+    node.count = end - begin;
+    m_nodes[index] = node;
+    return index;
+  }
+
+  int splitAxis = 0;
+  for (int axis = 1; axis < 3; ++axis) {
+    if (cmax[axis] - cmin[axis] > cmax[splitAxis] - cmin[splitAxis]) {
+      splitAxis = axis;
+    }
+  }
+  const std::uint32_t mid = begin + (end - begin) / 2;
+  auto centroid = [&](std::uint32_t primitive) {
+    const Primitive &p = m_primitives[primitive];
+    const double a[3] = {p.a.x, p.a.y, p.a.z};
+    const double b[3] = {p.b.x, p.b.y, p.b.z};
+    return a[splitAxis] + b[splitAxis];
+  };
+  std::nth_element(m_bvhOrder.begin() + begin, m_bvhOrder.begin() + mid,
+                   m_bvhOrder.begin() + end,
+                   [&](std::uint32_t lhs, std::uint32_t rhs) {
+                     return centroid(lhs) < centroid(rhs);
+                   });
+
+  node.left = BuildNode(begin, mid);
+  node.right = BuildNode(mid, end);
+  m_nodes[index] = node;
+  return index;
+}
+
+// ---------------------------------------------------------------------------
+// 查询
+// ---------------------------------------------------------------------------
+
+bool ReferenceSpatialIndex::Accept(const SlotRecord &record,
+                                   const ReferenceQueryFilter &filter) const {
+  if (!record.alive) {
+    return false;
+  }
+  if (filter.refType && record.refType != *filter.refType) {
+    return false;
+  }
+  if (filter.normal) {
+    const auto wanted = UnitOrNull(*filter.normal);
+    if (!wanted || !record.normal ||
+        AngleBetween(*wanted, *record.normal) > filter.maxNormalAngle) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename NodeFn, typename PrimitiveFn>
+void ReferenceSpatialIndex::Traverse(NodeFn &&nodeOverlaps,
+                                     PrimitiveFn &&visit) const {
+  if (!m_nodes.empty()) {
+    std::vector<std::uint32_t> stack{0};
+    while (!stack.empty()) {
+      const Node &node = m_nodes[stack.back()];
+      stack.pop_back();
+      if (!nodeOverlaps(node)) {
+        continue;
+      }
+      if (node.count > 0) {
+        for (std::uint32_t i = node.first; i < node.first + node.count; ++i) {
+          visit(m_bvhOrder[i]);
+        }
+      } else {
+        stack.push_back(node.left);
+        stack.push_back(node.right);
+      }
+    }
+  }
+  for (std::uint32_t primitive : m_pending) {
+    visit(primitive);
+  }
+}
+
+namespace {
+
+double PointBoxDistance(const CPoint3D &p, const double *min,
+                        const double *max) {
+  const double v[3] = {p.x, p.y, p.z};
+  double sum = 0.0;
+  for (int axis = 0; axis < 3; ++axis) {
+    const double d = std::max({min[axis] - v[axis], 0.0, v[axis] - max[axis]});
+    sum += d * d;
+  }
+  return std::sqrt(sum);
+}
+
+bool RayHitsExpandedBox(const CPoint3D &origin, const CVector3D &dir,
+                        double expand, const double *min, const double *max) {
+  const double o[3] = {origin.x, origin.y, origin.z};
+  const double d[3] = {dir.x, dir.y, dir.z};
+  double tmin = 0.0;
+  double tmax = std::numeric_limits<double>::infinity();
+  for (int axis = 0; axis < 3; ++axis) {
+    const double lo = min[axis] - expand;
+    const double hi = max[axis] + expand;
+    if (std::abs(d[axis]) < 1e-15) {
+      if (o[axis] < lo || o[axis] > hi) {
+        return false;
+      }
+      continue;
+    }
+    double t1 = (lo - o[axis]) / d[axis];
+    double t2 = (hi - o[axis]) / d[axis];
+    if (t1 > t2) {
+      std::swap(t1, t2);
+    }
+    tmin = std::max(tmin, t1);
+    tmax = std::min(tmax, t2);
+    if (tmin > tmax) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+std::vector<ReferenceHit>
+ReferenceSpatialIndex::QueryRadius(const CPoint3D &center, double radius,
+                                   const ReferenceQueryFilter &filter) const {
+  std::unordered_map<std::uint32_t, ReferenceHit> best;
+  Traverse(
+      [&](const Node &node) {
+        return PointBoxDistance(center, node.min, node.max) <= radius;
+      },
+      [&](std::uint32_t index) {
+        const Primitive &p = m_primitives[index];
+        const SlotRecord &record = m_slots[p.slot];
+        if (!Accept(record, filter)) {
+          return;
+        }
+        const CPoint3D closest = ClosestOnSegment(center, p.a, p.b);
+        const double distance = Distance(center, closest);
+        if (distance > radius) {
+          return;
+        }
+        auto it = best.find(p.slot);
+        if (it == best.end()) {
+          best.emplace(p.slot, ReferenceHit{record.slot, distance, 0.0, closest});
+        } else if (distance < it->second.distance) {
+          it->second.distance = distance;
+          it->second.closestPoint = closest;
+        }
+      });
+
+  std::vector<ReferenceHit> hits;
+  hits.reserve(best.size());
+  for (auto &entry : best) {
+    hits.push_back(std::move(entry.second));
+  }
+  std::sort(hits.begin(), hits.end(),
+            [](const ReferenceHit &a, const ReferenceHit &b) {
+              return a.distance < b.distance;
+            });
+  return hits;
+}
+
+std::vector<ReferenceHit>
+ReferenceSpatialIndex::QueryNearest(const CPoint3D &center, std::size_t k,
+                                    const ReferenceQueryFilter &filter) const {
+  std::vector<ReferenceHit> hits;
+  if (k == 0) {
+    return hits;
+  }
+
+  // 最优优先遍历：节点按包围盒距离、图元按真实距离进入同一小顶堆，
+  // 图元出堆时即为其槽位的最近距离。
+  struct Entry {
+    double distance;
+    bool isNode;
+    std::uint32_t index;
+    bool operator>(const Entry &other) const {
+      return distance > other.distance;
+    }
+  };
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  auto pushPrimitive = [&](std::uint32_t index) {
+    const Primitive &p = m_primitives[index];
+    if (Accept(m_slots[p.slot], filter)) {
+      queue.push({Distance(center, ClosestOnSegment(center, p.a, p.b)), false,
+                  index});
+    }
+  };
+  if (!m_nodes.empty()) {
+    queue.push({PointBoxDistance(center, m_nodes[0].min, m_nodes[0].max), true,
+                0});
+  }
+  for (std::uint32_t primitive : m_pending) {
+    pushPrimitive(primitive);
+  }
+
+  std::vector<bool> taken(m_slots.size(), false);
+  while (!queue.empty() && hits.size() < k) {
+    const Entry entry = queue.top();
+    queue.pop();
+    if (entry.isNode) {
+      const Node &node = m_nodes[entry.index];
+      if (node.count > 0) {
+        for (std::uint32_t i = node.first; i < node.first + node.count; ++i) {
+          pushPrimitive(m_bvhOrder[i]);
+        }
+      } else {
+        for (std::uint32_t child : {node.left, node.right}) {
+          queue.push({PointBoxDistance(center, m_nodes[child].min,
+                                       m_nodes[child].max),
+                      true, child});
+        }
+      }
+      continue;
+    }
+    const Primitive &p = m_primitives[entry.index];
+    if (taken[p.slot]) {
+      continue;
+    }
+    taken[p.slot] = true;
+    hits.push_back({m_slots[p.slot].slot, entry.distance, 0.0,
+                    ClosestOnSegment(center, p.a, p.b)});
+  }
+  return hits;
+}
+
+std::vector<ReferenceHit>
+ReferenceSpatialIndex::QueryRay(const CPoint3D &origin,
+                                const CVector3D &direction, double maxDistance,
+                                const ReferenceQueryFilter &filter) const {
+  std::vector<ReferenceHit> hits;
+  const auto dir = UnitOrNull(direction);
+  if (!dir) {
+    return hits;
+  }
+
+  std::unordered_map<std::uint32_t, ReferenceHit> best;
+  Traverse(
+      [&](const Node &node) {
+        return RayHitsExpandedBox(origin, *dir, maxDistance, node.min,
+                                  node.max);
+      },
+      [&](std::uint32_t index) {
+        const Primitive &p = m_primitives[index];
+        const SlotRecord &record = m_slots[p.slot];
+        if (!Accept(record, filter)) {
+          return;
+        }
+        double t = 0.0;
+        const CPoint3D closest = ClosestRaySegment(origin, *dir, p.a, p.b, t);
+        const double distance = Distance(RayPoint(origin, *dir, t), closest);
+        if (distance > maxDistance) {
+          return;
+        }
+        auto it = best.find(p.slot);
+        if (it == best.end()) {
+          best.emplace(p.slot, ReferenceHit{record.slot, distance, t, closest});
+        } else if (distance < it->second.distance) {
+          it->second = ReferenceHit{record.slot, distance, t, closest};
+        }
+      });
+
+  hits.reserve(best.size());
+  for (auto &entry : best) {
+    hits.push_back(std::move(entry.second));
+  }
+  std::sort(hits.begin(), hits.end(),
+            [](const ReferenceHit &a, const ReferenceHit &b) {
+              return a.rayParameter < b.rayParameter;
+            });
+  return hits;
+}
+
+std::vector<ReferenceHit>
+ReferenceSpatialIndex::QueryNormal(const CVector3D &normal,
+                                   double maxAngle) const {
+  std::vector<ReferenceHit> hits;
+  const auto wanted = UnitOrNull(normal);
+  if (!wanted) {
+    return hits;
+  }
+  for (std::size_t bin = 0; bin < kNormalBins; ++bin) {
+    if (AngleBetween(*wanted, kBinAxes[bin]) >
+        maxAngle + kNormalBinHalfAngle) {
+      continue;
+    }
+    for (std::uint32_t slot : m_normalBins[bin]) {
+      const SlotRecord &record = m_slots[slot];
+      if (!record.alive) {
+        continue;
+      }
+      const double angle = AngleBetween(*wanted, *record.normal);
+      if (angle <= maxAngle) {
+        ReferenceHit hit;
+        hit.slot = record.slot;
+        hit.distance = angle;
+        hits.push_back(std::move(hit));
+      }
+    }
+  }
+  std::sort(hits.begin(), hits.end(),
+            [](const ReferenceHit &a, const ReferenceHit &b) {
+              return a.distance < b.distance;
+            });
+  return hits;
+}
+
+} // namespace Geometry
+} // namespace CADExchange
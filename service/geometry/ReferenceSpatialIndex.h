@@ -0,0 +1,181 @@
+#pragma once
+
+#include "../../core/UnifiedModel.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace CADExchange {
+namespace Geometry {
+
+/**
+ * @brief 被索引的一个引用槽位：某特征中按遍历顺序的第 slotIndex 个引用。
+ *
+ * 遍历顺序与 VisitFeatureGeometry 一致，因此 (featureID, slotIndex) 在
+ * 特征内容不变时是稳定的。被多个特征共享的引用会以不同槽位出现多次。
+ */
+struct ReferenceSlot {
+  std::string featureID;
+  std::size_t slotIndex = 0;
+  std::shared_ptr<CRefEntityBase> ref;
+};
+
+/**
+ * @brief 查询结果：每个槽位最多出现一次，取其几何指纹中的最近图元。
+ */
+struct ReferenceHit {
+  ReferenceSlot slot;
+  double distance = 0.0;     ///< 到查询点（或射线）的最短距离
+  double rayParameter = 0.0; ///< 仅射线查询：最近点在射线上的参数
+  CPoint3D closestPoint;     ///< 指纹上的最近点
+};
+
+/**
+ * @brief 查询过滤条件。
+ */
+struct ReferenceQueryFilter {
+  std::optional<RefType> refType; ///< 只返回该类型的引用
+  std::optional<CVector3D> normal; ///< 只返回法向与之夹角不超过 maxNormalAngle 的引用
+  double maxNormalAngle = 0.0;     ///< 弧度
+};
+
+/**
+ * @brief 模型级引用几何指纹空间索引。
+ *
+ * 把各特征引用实体的指纹（面 centroid、边 start/mid/end 折线、顶点、
+ * 基准面/轴原点、基准点）组织为 BVH，并按法向主轴做 6 向分桶，
+ * 支持半径、k 近邻、射线邻近与法向匹配查询，结果给出所属特征与槽位。
+ *
+ * 增量维护：新增特征先进入待合并列表（查询时线性扫描），移除特征只做
+ * 墓碑标记；两者超过阈值时自动重建 BVH。Update() 能识别“只在末尾追加”
+ * 的模型变化并增量处理，其他变化整体重建。已采集特征以 weak_ptr 记录，
+ * 特征被释放后即使新特征复用了同一地址也不会被误认为未变化；经
+ * AddFeature 按引用加入的特征没有所有权信息，下一次 Update() 会整体重建。
+ * 原地修改特征几何后应调用 RefreshFeature()。
+ *
+ * const 查询可并发执行；修改操作需由调用方串行化。
+ */
+class ReferenceSpatialIndex {
+public:
+  ReferenceSpatialIndex() = default;
+  explicit ReferenceSpatialIndex(const UnifiedModel &model) { Build(model); }
+
+  /**
+   * @brief 丢弃现有内容并按模型重新建立索引。
+   */
+  void Build(const UnifiedModel &model);
+
+  /**
+   * @brief 与模型同步。
+   *
+   * @return 以增量方式完成时返回 true；需要整体重建时返回 false（已重建）。
+   */
+  bool Update(const UnifiedModel &model);
+
+  void AddFeature(const CFeatureBase &feature);
+  void RemoveFeature(const std::string &featureID);
+
+  /**
+   * @brief 重新采集单个特征（原地修改几何后调用）。
+   */
+  void RefreshFeature(const CFeatureBase &feature);
+
+  /**
+   * @brief 当前有效的槽位数。
+   */
+  std::size_t SlotCount() const { return m_slots.size() - m_deadSlots; }
+
+  /**
+   * @brief 指纹距 center 不超过 radius 的槽位，按距离升序。
+   */
+  std::vector<ReferenceHit>
+  QueryRadius(const CPoint3D &center, double radius,
+              const ReferenceQueryFilter &filter = {}) const;
+
+  /**
+   * @brief 距 center 最近的 k 个槽位，按距离升序。
+   */
+  std::vector<ReferenceHit>
+  QueryNearest(const CPoint3D &center, std::size_t k,
+               const ReferenceQueryFilter &filter = {}) const;
+
+  /**
+   * @brief 与射线 origin + t·direction (t >= 0) 距离不超过 maxDistance 的
+   *        槽位，按 rayParameter 升序（SelectByRay 风格的重绑定）。
+   */
+  std::vector<ReferenceHit>
+  QueryRay(const CPoint3D &origin, const CVector3D &direction,
+           double maxDistance, const ReferenceQueryFilter &filter = {}) const;
+
+  /**
+   * @brief 法向与 normal 夹角不超过 maxAngle 的槽位（面、基准面），
+   *        按夹角升序；distance 字段为夹角（弧度）。
+   */
+  std::vector<ReferenceHit> QueryNormal(const CVector3D &normal,
+                                        double maxAngle) const;
+
+private:
+  /// 单个几何图元：点（a == b）或线段 a-b。
+  struct Primitive {
+    CPoint3D a;
+    CPoint3D b;
+    std::uint32_t slot = 0;
+  };
+
+  struct Node {
+    double min[3];
+    double max[3];
+    std::uint32_t left = 0;  ///< 内部节点：左子节点
+    std::uint32_t right = 0; ///< 内部节点：右子节点
+    std::uint32_t first = 0; ///< 叶节点：m_bvhOrder 起始下标
+    std::uint32_t count = 0; ///< 叶节点图元数，0 表示内部节点
+  };
+
+  struct SlotRecord {
+    ReferenceSlot slot;
+    RefType refType = RefType::UNKNOWN;
+    std::optional<CVector3D> normal; ///< 单位法向
+    bool alive = true;
+  };
+
+  static constexpr std::size_t kNormalBins = 6;
+  static constexpr std::uint32_t kLeafSize = 4;
+
+  void Clear();
+  void CollectFeature(const CFeatureBase &feature);
+  void DropFeatureSlots(const std::string &featureID);
+  void RebuildTree();
+  void MaybeRebuild();
+  std::uint32_t BuildNode(std::uint32_t begin, std::uint32_t end);
+  bool Accept(const SlotRecord &record,
+              const ReferenceQueryFilter &filter) const;
+
+  template <typename NodeFn, typename PrimitiveFn>
+  void Traverse(NodeFn &&nodeOverlaps, PrimitiveFn &&visit) const;
+
+  std::vector<SlotRecord> m_slots;
+  std::unordered_map<std::string, std::vector<std::uint32_t>> m_featureSlots;
+  struct FeatureEntry {
+    std::weak_ptr<const CFeatureBase> feature; ///< 按引用加入时为空
+    std::string featureID;
+  };
+
+  /// 已采集特征的顺序，Update() 用于识别追加。
+  std::vector<FeatureEntry> m_featureOrder;
+
+  std::vector<Primitive> m_primitives;
+  std::vector<std::uint32_t> m_bvhOrder; ///< BVH 叶节点引用的图元下标
+  std::vector<Node> m_nodes;
+  std::vector<std::uint32_t> m_pending; ///< 尚未并入 BVH 的图元
+  std::array<std::vector<std::uint32_t>, kNormalBins> m_normalBins;
+  std::size_t m_deadSlots = 0;
+};
+
+} // namespace Geometry
+} // namespace CADExchange
@@ -0,0 +1,610 @@
+#include "SketchLoopExtractor.h"
+#include "../../core/detail/IoHelpers.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace CADExchange {
+namespace Geometry {
+
+namespace {
+
+using CADExchange::detail::Fnv1aHasher;
+
+constexpr double kTwoPi = 2.0 * GeoUtils::PI;
+
+/// 圆弧离散为折线时每段的最大圆心角（仅用于包含判断）。
+constexpr double kTessellationStep = GeoUtils::PI / 16.0;
+
+/**
+ * @brief 图中的一条边：非构造的线段或圆弧，坐标为草图局部 XY。
+ */
+struct Curve {
+  std::size_t segment = 0;
+  bool isArc = false;
+  CPoint3D start;
+  CPoint3D end;
+  CPoint3D center;
+  double radius = 0.0;
+  double startAngle = 0.0;
+  double sweep = 0.0; ///< 带符号圆心角，逆时针为正
+  int u = -1;         ///< 起点顶点
+  int v = -1;         ///< 终点顶点
+};
+
+double Distance2D(const CPoint3D &a, const CPoint3D &b) {
+  return std::hypot(a.x - b.x, a.y - b.y);
+}
+
+CPoint3D ArcPoint(const CPoint3D &center, double radius, double angle) {
+  return {center.x + radius * std::cos(angle),
+          center.y + radius * std::sin(angle), 0.0};
+}
+
+/**
+ * @brief 圆弧的带符号圆心角：逆时针取 (0, 2π]，顺时针取其相反数。
+ */
+double ArcSweep(const CSketchArc &arc) {
+  double sweep = arc.isClockwise ? arc.startAngle - arc.endAngle
+                                 : arc.endAngle - arc.startAngle;
+  sweep = std::fmod(sweep, kTwoPi);
+  if (sweep <= 1e-12) {
+    sweep += kTwoPi;
+  }
+  return arc.isClockwise ? -sweep : sweep;
+}
+
+/**
+ * @brief 哈希网格顶点吸附：容差内的端点合并为同一顶点。
+ */
+class VertexSnapper {
+public:
+  explicit VertexSnapper(double tolerance)
+      : m_tolerance(tolerance), m_inverseCell(1.0 / tolerance) {}
+
+  int Snap(const CPoint3D &p) {
+    const std::int64_t cx = Cell(p.x);
+    const std::int64_t cy = Cell(p.y);
+    int best = -1;
+    double bestDistance = m_tolerance;
+    for (std::int64_t dx = -1; dx <= 1; ++dx) {
+      for (std::int64_t dy = -1; dy <= 1; ++dy) {
+        auto it = m_cells.find(KeyOf(cx + dx, cy + dy));
+        if (it == m_cells.end()) {
+          continue;
+        }
+        for (int index : it->second) {
+          const double d = Distance2D(vertices[index], p);
+          if (d <= bestDistance) {
+            best = index;
+            bestDistance = d;
+          }
+        }
+      }
+    }
+    if (best >= 0) {
+      return best;
+    }
+    const int index = static_cast<int>(vertices.size());
+    vertices.push_back({p.x, p.y, 0.0});
+    m_cells[KeyOf(cx, cy)].push_back(index);
+    return index;
+  }
+
+  std::vector<CPoint3D> vertices;
+
+private:
+  std::int64_t Cell(double v) const {
+    return static_cast<std::int64_t>(std::floor(v * m_inverseCell));
+  }
+
+  static std::uint64_t KeyOf(std::int64_t x, std::int64_t y) {
+    return (static_cast<std::uint64_t>(x) << 32) ^
+           (static_cast<std::uint64_t>(y) & 0xffffffffull);
+  }
+
+  double m_tolerance;
+  double m_inverseCell;
+  std::unordered_map<std::uint64_t, std::vector<int>> m_cells;
+};
+
+/**
+ * @brief 半边 h 对应 curves[h / 2]；偶数为正向，奇数为反向。
+ */
+struct HalfEdgeInfo {
+  double angle = 0.0;     ///< 出射切向角
+  double curvature = 0.0; ///< 左转为正
+};
+
+HalfEdgeInfo Departure(const Curve &curve, bool forward) {
+  HalfEdgeInfo info;
+  if (!curve.isArc) {
+    const CPoint3D &from = forward ? curve.start : curve.end;
+    const CPoint3D &to = forward ? curve.end : curve.start;
+    info.angle = std::atan2(to.y - from.y, to.x - from.x);
+    return info;
+  }
+  const double sign = curve.sweep > 0.0 ? 1.0 : -1.0;
+  const double at = forward ? curve.startAngle : curve.startAngle + curve.sweep;
+  const double direction = forward ? sign : -sign;
+  info.angle = std::atan2(direction * std::cos(at), -direction * std::sin(at));
+  info.curvature = direction / curve.radius;
+  return info;
+}
+
+/**
+ * @brief 边沿走向的带符号面积贡献（弦的鞋带项 + 弓形面积）。
+ */
+double AreaTerm(const Curve &curve, bool forward) {
+  const CPoint3D &a = forward ? curve.start : curve.end;
+  const CPoint3D &b = forward ? curve.end : curve.start;
+  double area = 0.5 * (a.x * b.y - b.x * a.y);
+  if (curve.isArc) {
+    const double sweep = forward ? curve.sweep : -curve.sweep;
+    area += 0.5 * curve.radius * curve.radius * (sweep - std::sin(sweep));
+  }
+  return area;
+}
+
+void ExpandBox(CPoint3D &boxMin, CPoint3D &boxMax, const CPoint3D &p) {
+  boxMin.x = std::min(boxMin.x, p.x);
+  boxMin.y = std::min(boxMin.y, p.y);
+  boxMax.x = std::max(boxMax.x, p.x);
+  boxMax.y = std::max(boxMax.y, p.y);
+}
+
+/**
+ * @brief 把边按走向追加到折线（不含终点），并扩展精确包围盒。
+ */
+void AppendCurve(const Curve &curve, bool forward, std::vector<CPoint3D> &poly,
+                 CPoint3D &boxMin, CPoint3D &boxMax) {
+  const CPoint3D &from = forward ? curve.start : curve.end;
+  poly.push_back(from);
+  ExpandBox(boxMin, boxMax, from);
+  if (!curve.isArc) {
+    return;
+  }
+  const double sweep = forward ? curve.sweep : -curve.sweep;
+  const double begin = forward ? curve.startAngle : curve.startAngle + curve.sweep;
+  const int steps =
+      std::max(2, static_cast<int>(std::ceil(std::abs(sweep) / kTessellationStep)));
+  for (int i = 1; i < steps; ++i) {
+    poly.push_back(ArcPoint(curve.center, curve.radius,
+                            begin + sweep * static_cast<double>(i) / steps));
+  }
+  // 圆弧跨过的坐标轴极值点。
+  const double lo = std::min(begin, begin + sweep);
+  const double hi = std::max(begin, begin + sweep);
+  for (int k = static_cast<int>(std::ceil(lo / (GeoUtils::PI / 2)));
+       k * (GeoUtils::PI / 2) <= hi; ++k) {
+    ExpandBox(boxMin, boxMax, ArcPoint(curve.center, curve.radius, k * (GeoUtils::PI / 2)));
+  }
+  ExpandBox(boxMin, boxMax, forward ? curve.end : curve.start);
+}
+
+bool PointInPolygon(const std::vector<CPoint3D> &poly, const CPoint3D &p) {
+  bool inside = false;
+  for (std::size_t i = 0, j = poly.size() - 1; i < poly.size(); j = i++) {
+    const CPoint3D &a = poly[i];
+    const CPoint3D &b = poly[j];
+    if ((a.y > p.y) != (b.y > p.y) &&
+        p.x < (b.x - a.x) * (p.y - a.y) / (b.y - a.y) + a.x) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+struct LoopWork {
+  SketchLoop loop;
+  std::vector<CPoint3D> polygon;
+  int component = -1;
+};
+
+int FindRoot(std::vector<int> &parent, int x) {
+  while (parent[x] != x) {
+    parent[x] = parent[parent[x]];
+    x = parent[x];
+  }
+  return x;
+}
+
+/**
+ * @brief 为环建立嵌套关系并统一走向（外环逆时针、孔顺时针）。
+ *
+ * 只有不同连通分量的环之间可能互相包含。候选父环通过包围盒网格
+ * 检索，避免对大量小孔做两两判断。
+ */
+void ResolveNesting(std::vector<LoopWork> &work) {
+  std::sort(work.begin(), work.end(), [](const LoopWork &a, const LoopWork &b) {
+    return std::abs(a.loop.signedArea) > std::abs(b.loop.signedArea);
+  });
+  if (work.empty()) {
+    return;
+  }
+
+  CPoint3D worldMin = work.front().loop.boxMin;
+  CPoint3D worldMax = work.front().loop.boxMax;
+  for (const auto &item : work) {
+    ExpandBox(worldMin, worldMax, item.loop.boxMin);
+    ExpandBox(worldMin, worldMax, item.loop.boxMax);
+  }
+  const int grid = std::max(
+      1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(work.size())))));
+  const double cellX = std::max((worldMax.x - worldMin.x) / grid, 1e-300);
+  const double cellY = std::max((worldMax.y - worldMin.y) / grid, 1e-300);
+  auto cellOf = [&](double v, double origin, double size) {
+    const double cell = std::floor((v - origin) / size);
+    return static_cast<int>(std::clamp(cell, 0.0, static_cast<double>(grid - 1)));
+  };
+  std::vector<std::vector<int>> cells(static_cast<std::size_t>(grid) * grid);
+
+  for (std::size_t i = 0; i < work.size(); ++i) {
+    SketchLoop &loop = work[i].loop;
+    const CPoint3D &sample = work[i].polygon.front();
+    const int sx = cellOf(sample.x, worldMin.x, cellX);
+    const int sy = cellOf(sample.y, worldMin.y, cellY);
+    // 已插入网格的环面积都不小于当前环；取满足包含条件的面积最小者。
+    for (int candidate : cells[static_cast<std::size_t>(sy) * grid + sx]) {
+      const LoopWork &other = work[candidate];
+      if (other.component == work[i].component ||
+          (loop.parent >= 0 && std::abs(other.loop.signedArea) >=
+                                   std::abs(work[loop.parent].loop.signedArea))) {
+        continue;
+      }
+      if (sample.x < other.loop.boxMin.x || sample.x > other.loop.boxMax.x ||
+          sample.y < other.loop.boxMin.y || sample.y > other.loop.boxMax.y) {
+        continue;
+      }
+      if (PointInPolygon(other.polygon, sample)) {
+        loop.parent = candidate;
+      }
+    }
+    loop.depth = loop.parent >= 0 ? work[loop.parent].loop.depth + 1 : 0;
+
+    const int x0 = cellOf(loop.boxMin.x, worldMin.x, cellX);
+    const int x1 = cellOf(loop.boxMax.x, worldMin.x, cellX);
+    const int y0 = cellOf(loop.boxMin.y, worldMin.y, cellY);
+    const int y1 = cellOf(loop.boxMax.y, worldMin.y, cellY);
+    for (int y = y0; y <= y1; ++y) {
+      for (int x = x0; x <= x1; ++x) {
+        cells[static_cast<std::size_t>(y) * grid + x].push_back(
+            static_cast<int>(i));
+      }
+    }
+  }
+
+  for (auto &item : work) {
+    SketchLoop &loop = item.loop;
+    const bool wantCcw = loop.IsOuter();
+    if (loop.IsCounterClockwise() != wantCcw) {
+      std::reverse(loop.edges.begin(), loop.edges.end());
+      for (auto &edge : loop.edges) {
+        edge.reversed = !edge.reversed;
+      }
+      loop.signedArea = -loop.signedArea;
+    }
+  }
+}
+
+/// 校验哈希的第二个独立种子（标准 FNV-1a 偏移基之外）。
+constexpr std::uint64_t kCheckSeed = 0x9e3779b97f4a7c15ull;
+
+class ContentHasher {
+public:
+  explicit ContentHasher(std::uint64_t seed) : m_hasher(seed) {}
+
+  void Bytes(const void *data, std::size_t size) { m_hasher.Mix(data, size); }
+
+  void Double(double value) {
+    if (value == 0.0) {
+      value = 0.0; // 归一化 -0.0
+    }
+    Bytes(&value, sizeof(value));
+  }
+
+  void Point(const CPoint3D &p) {
+    Double(p.x);
+    Double(p.y);
+  }
+
+  void Int(std::uint64_t value) { Bytes(&value, sizeof(value)); }
+
+  std::uint64_t Value() const { return m_hasher.Value(); }
+
+private:
+  Fnv1aHasher m_hasher;
+};
+
+std::uint64_t HashSketch(const CSketch &sketch, double tolerance,
+                         std::uint64_t seed = Fnv1aHasher::kOffsetBasis) {
+  ContentHasher hasher(seed);
+  hasher.Double(tolerance);
+  hasher.Int(sketch.segments.size());
+  for (const auto &seg : sketch.segments) {
+    if (!seg) {
+      hasher.Int(~0ull);
+      continue;
+    }
+    hasher.Int(static_cast<std::uint64_t>(seg->type));
+    hasher.Int(seg->isConstruction ? 1 : 0);
+    if (auto *line = dynamic_cast<const CSketchLine *>(seg.get())) {
+      hasher.Point(line->startPos);
+      hasher.Point(line->endPos);
+    } else if (auto *arc = dynamic_cast<const CSketchArc *>(seg.get())) {
+      hasher.Point(arc->center);
+      hasher.Double(arc->radius);
+      hasher.Double(arc->startAngle);
+      hasher.Double(arc->endAngle);
+      hasher.Int(arc->isClockwise ? 1 : 0);
+    } else if (auto *circle = dynamic_cast<const CSketchCircle *>(seg.get())) {
+      hasher.Point(circle->center);
+      hasher.Double(circle->radius);
+    }
+  }
+  return hasher.Value();
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// 环提取
+// ---------------------------------------------------------------------------
+
+SketchLoopResult SketchLoopExtractor::Compute(const CSketch &sketch,
+                                              double tolerance) {
+  SketchLoopResult result;
+  std::vector<LoopWork> work;
+  std::vector<bool> inLoop(sketch.segments.size(), false);
+  std::vector<bool> candidate(sketch.segments.size(), false);
+  std::vector<Curve> curves;
+  VertexSnapper snapper(tolerance);
+  int nextComponent = 0;
+
+  auto addSingleEdgeLoop = [&](std::size_t index, const CPoint3D &center,
+                               double radius) {
+    LoopWork item;
+    item.component = nextComponent++;
+    item.loop.edges.push_back({index, false});
+    item.loop.signedArea = GeoUtils::PI * radius * radius;
+    item.loop.boxMin = {center.x - radius, center.y - radius, 0.0};
+    item.loop.boxMax = {center.x + radius, center.y + radius, 0.0};
+    for (int i = 0; i < 32; ++i) {
+      item.polygon.push_back(ArcPoint(center, radius, kTwoPi * i / 32));
+    }
+    inLoop[index] = true;
+    work.push_back(std::move(item));
+  };
+
+  for (std::size_t i = 0; i < sketch.segments.size(); ++i) {
+    const auto &seg = sketch.segments[i];
+    if (!seg || seg->isConstruction || seg->type == CSketchSeg::SegType::POINT) {
+      continue;
+    }
+    candidate[i] = true;
+    if (auto *circle = dynamic_cast<const CSketchCircle *>(seg.get())) {
+      if (circle->radius > tolerance) {
+        addSingleEdgeLoop(i, circle->center, circle->radius);
+      }
+      continue;
+    }
+    Curve curve;
+    curve.segment = i;
+    if (auto *line = dynamic_cast<const CSketchLine *>(seg.get())) {
+      curve.start = {line->startPos.x, line->startPos.y, 0.0};
+      curve.end = {line->endPos.x, line->endPos.y, 0.0};
+    } else if (auto *arc = dynamic_cast<const CSketchArc *>(seg.get())) {
+      curve.isArc = true;
+      curve.center = {arc->center.x, arc->center.y, 0.0};
+      curve.radius = arc->radius;
+      curve.startAngle = arc->startAngle;
+      curve.sweep = ArcSweep(*arc);
+      curve.start = ArcPoint(curve.center, curve.radius, curve.startAngle);
+      curve.end = ArcPoint(curve.center, curve.radius,
+                           curve.startAngle + curve.sweep);
+      if (arc->radius <= tolerance) {
+        continue;
+      }
+    } else {
+      continue; // 样条等无法解析端点的段
+    }
+    curve.u = snapper.Snap(curve.start);
+    curve.v = snapper.Snap(curve.end);
+    if (curve.u == curve.v) {
+      // 端点重合：整圆弧单独成环，退化段忽略。
+      if (curve.isArc && std::abs(curve.sweep) > GeoUtils::PI) {
+        addSingleEdgeLoop(i, curve.center, curve.radius);
+      }
+      continue;
+    }
+    curves.push_back(curve);
+  }
+
+  // 1. 顶点出射半边表，逐层剪除悬挂边。
+  const std::size_t vertexCount = snapper.vertices.size();
+  std::vector<std::vector<int>> outgoing(vertexCount);
+  for (std::size_t c = 0; c < curves.size(); ++c) {
+    outgoing[curves[c].u].push_back(static_cast<int>(2 * c));
+    outgoing[curves[c].v].push_back(static_cast<int>(2 * c + 1));
+  }
+  auto origin = [&](int h) {
+    const Curve &c = curves[h / 2];
+    return h % 2 == 0 ? c.u : c.v;
+  };
+  auto head = [&](int h) {
+    const Curve &c = curves[h / 2];
+    return h % 2 == 0 ? c.v : c.u;
+  };
+
+  std::vector<bool> alive(curves.size(), true);
+  std::vector<int> degree(vertexCount, 0);
+  for (std::size_t v = 0; v < vertexCount; ++v) {
+    degree[v] = static_cast<int>(outgoing[v].size());
+  }
+  std::vector<int> queue;
+  for (std::size_t v = 0; v < vertexCount; ++v) {
+    if (degree[v] == 1) {
+      queue.push_back(static_cast<int>(v));
+    }
+  }
+  while (!queue.empty()) {
+    const int v = queue.back();
+    queue.pop_back();
+    if (degree[v] != 1) {
+      continue;
+    }
+    for (int h : outgoing[v]) {
+      if (!alive[h / 2]) {
+        continue;
+      }
+      alive[h / 2] = false;
+      --degree[v];
+      const int other = head(h);
+      if (--degree[other] == 1) {
+        queue.push_back(other);
+      }
+      break;
+    }
+  }
+
+  // 2. 每个顶点的存活半边按出射切向逆时针排序。
+  std::vector<HalfEdgeInfo> info(2 * curves.size());
+  for (std::size_t c = 0; c < curves.size(); ++c) {
+    info[2 * c] = Departure(curves[c], true);
+    info[2 * c + 1] = Departure(curves[c], false);
+  }
+  std::vector<int> positionInVertex(2 * curves.size(), -1);
+  for (auto &list : outgoing) {
+    list.erase(std::remove_if(list.begin(), list.end(),
+                              [&](int h) { return !alive[h / 2]; }),
+               list.end());
+    std::sort(list.begin(), list.end(), [&](int a, int b) {
+      if (info[a].angle != info[b].angle) {
+        return info[a].angle < info[b].angle;
+      }
+      return info[a].curvature < info[b].curvature;
+    });
+    for (std::size_t k = 0; k < list.size(); ++k) {
+      positionInVertex[list[k]] = static_cast<int>(k);
+    }
+  }
+
+  // 3. 连通分量（用于嵌套判断）。
+  std::vector<int> unionParent(vertexCount);
+  std::iota(unionParent.begin(), unionParent.end(), 0);
+  for (std::size_t c = 0; c < curves.size(); ++c) {
+    if (alive[c]) {
+      unionParent[FindRoot(unionParent, curves[c].u)] =
+          FindRoot(unionParent, curves[c].v);
+    }
+  }
+  const int componentBase = nextComponent;
+
+  // 4. 追踪面：next(h) 为 head(h) 处紧邻 twin(h) 顺时针一侧的出射半边。
+  const double minArea = tolerance * tolerance;
+  std::vector<bool> visited(2 * curves.size(), false);
+  for (std::size_t start = 0; start < visited.size(); ++start) {
+    if (visited[start] || !alive[start / 2]) {
+      continue;
+    }
+    std::vector<int> cycle;
+    int h = static_cast<int>(start);
+    while (!visited[h]) {
+      visited[h] = true;
+      cycle.push_back(h);
+      const auto &list = outgoing[head(h)];
+      const int twin = h ^ 1;
+      const int pos = positionInVertex[twin];
+      h = list[(pos + static_cast<int>(list.size()) - 1) % list.size()];
+    }
+    if (h != static_cast<int>(start)) {
+      continue; // 非法拓扑（理论上不会出现）
+    }
+
+    double area = 0.0;
+    for (int e : cycle) {
+      area += AreaTerm(curves[e / 2], e % 2 == 0);
+    }
+    if (area <= minArea) {
+      continue; // 分量外边界或零面积环
+    }
+    LoopWork item;
+    item.component = componentBase + FindRoot(unionParent, origin(cycle.front()));
+    item.loop.signedArea = area;
+    item.loop.boxMin = item.loop.boxMax = curves[cycle.front() / 2].start;
+    for (int e : cycle) {
+      const Curve &curve = curves[e / 2];
+      item.loop.edges.push_back({curve.segment, e % 2 != 0});
+      AppendCurve(curve, e % 2 == 0, item.polygon, item.loop.boxMin,
+                  item.loop.boxMax);
+      inLoop[curve.segment] = true;
+    }
+    work.push_back(std::move(item));
+  }
+
+  // 5. 嵌套与走向。
+  ResolveNesting(work);
+  result.loops.reserve(work.size());
+  for (auto &item : work) {
+    result.loops.push_back(std::move(item.loop));
+  }
+  for (std::size_t i = 0; i < sketch.segments.size(); ++i) {
+    if (candidate[i] && !inLoop[i]) {
+      result.danglingSegments.push_back(i);
+    }
+  }
+  return result;
+}
+
+// ---------------------------------------------------------------------------
+// 缓存
+// ---------------------------------------------------------------------------
+
+SketchLoopExtractor::SketchLoopExtractor(UnitType unit,
+                                         std::size_t maxCacheEntries)
+    : m_tolerance(0.0), m_maxCacheEntries(maxCacheEntries) {
+  if (!TryGetGeometryCompareTolerance(unit, m_tolerance)) {
+    throw std::invalid_argument(
+        "SketchLoopExtractor: unsupported unit for geometry compare tolerance");
+  }
+}
+
+std::shared_ptr<const SketchLoopResult>
+SketchLoopExtractor::Extract(const CSketch &sketch) {
+  const std::uint64_t hash = HashSketch(sketch, m_tolerance);
+  const std::uint64_t check = HashSketch(sketch, m_tolerance, kCheckSeed);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_cache.find(hash);
+    if (it != m_cache.end() && it->second.check == check) {
+      return it->second.result;
+    }
+  }
+
+  auto result = std::make_shared<const SketchLoopResult>(Compute(sketch, m_tolerance));
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_cache.size() >= m_maxCacheEntries) {
+      m_cache.clear();
+    }
+    if (m_maxCacheEntries > 0) {
+      m_cache[hash] = CacheEntry{check, result};
+    }
+  }
+  return result;
+}
+
+std::size_t SketchLoopExtractor::CacheSize() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_cache.size();
+}
+
+void SketchLoopExtractor::ClearCache() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_cache.clear();
+}
+
+} // namespace Geometry
+} // namespace CADExchange
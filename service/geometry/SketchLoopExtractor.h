@@ -0,0 +1,111 @@
+#pragma once
+
+#include "../../core/UnifiedModel.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CADExchange {
+namespace Geometry {
+
+/**
+ * @brief 环上的一条边：草图段下标（CSketch::segments）与走向。
+ */
+struct LoopEdge {
+  std::size_t segment = 0;
+  bool reversed = false; ///< true 表示从段终点走向起点
+};
+
+/**
+ * @brief 草图局部 XY 平面内的一个封闭环。
+ *
+ * 外环（depth 为偶数）逆时针、孔（depth 为奇数）顺时针，signedArea 的
+ * 符号与走向一致。整圆以单边环表示。
+ */
+struct SketchLoop {
+  std::vector<LoopEdge> edges; ///< 首尾相接的有序边
+  double signedArea = 0.0;     ///< 逆时针为正
+  int parent = -1;             ///< 直接包含本环的环下标，-1 表示顶层
+  int depth = 0;               ///< 嵌套深度：0 外边界、1 孔、2 孔中岛……
+  CPoint3D boxMin;             ///< 局部坐标包围盒（z 恒为 0）
+  CPoint3D boxMax;
+
+  bool IsOuter() const { return depth % 2 == 0; }
+  bool IsCounterClockwise() const { return signedArea > 0.0; }
+};
+
+/**
+ * @brief 一个草图的环提取结果。
+ */
+struct SketchLoopResult {
+  std::vector<SketchLoop> loops;
+  /// 不属于任何封闭区域的非构造段（悬挂链、样条等无法解析的段）。
+  std::vector<std::size_t> danglingSegments;
+};
+
+/**
+ * @brief 草图轮廓环提取器。
+ *
+ * 跳过构造几何与草图点，把线段、圆弧端点按容差哈希网格吸附为顶点，
+ * 建立平面半边图：悬挂边逐层剪除，其余半边在每个顶点按出射切向
+ * （同切向时按曲率）逆时针排序后追踪有界面，得到最小封闭区域。
+ * 不同连通分量之间按面积与包含关系建立嵌套层次。
+ *
+ * 约定段只在端点处相接（不计算段与段的交点）。
+ *
+ * 结果按草图内容哈希缓存（段几何、构造标记与容差参与哈希），原地
+ * 修改草图后再次提取会自动重新计算。本类线程安全。
+ */
+class SketchLoopExtractor {
+public:
+  /**
+   * @param tolerance 端点吸附容差（草图局部长度单位）。
+   */
+  explicit SketchLoopExtractor(double tolerance,
+                               std::size_t maxCacheEntries = 256)
+      : m_tolerance(tolerance), m_maxCacheEntries(maxCacheEntries) {}
+
+  /**
+   * @brief 以 TryGetGeometryCompareTolerance(unit) 为吸附容差。
+   *
+   * @throws std::invalid_argument 当单位不受支持时。
+   */
+  explicit SketchLoopExtractor(UnitType unit,
+                               std::size_t maxCacheEntries = 256);
+
+  SketchLoopExtractor(const SketchLoopExtractor &) = delete;
+  SketchLoopExtractor &operator=(const SketchLoopExtractor &) = delete;
+
+  double GetTolerance() const { return m_tolerance; }
+
+  /**
+   * @brief 获取草图的环（首次调用时计算并缓存）。
+   */
+  std::shared_ptr<const SketchLoopResult> Extract(const CSketch &sketch);
+
+  /**
+   * @brief 不经缓存直接计算。
+   */
+  static SketchLoopResult Compute(const CSketch &sketch, double tolerance);
+
+  std::size_t CacheSize() const;
+  void ClearCache();
+
+private:
+  struct CacheEntry {
+    std::uint64_t check = 0; ///< 第二个独立种子的内容哈希，用于确认命中
+    std::shared_ptr<const SketchLoopResult> result;
+  };
+
+  double m_tolerance;
+  std::size_t m_maxCacheEntries;
+  mutable std::mutex m_mutex;
+  std::unordered_map<std::uint64_t, CacheEntry> m_cache;
+};
+
+} // namespace Geometry
+} // namespace CADExchange
@@ -0,0 +1,170 @@
+#include "SketchProjection.h"
+#include "VectorMath.h"
+
+#include <cmath>
+
+namespace CADExchange {
+namespace Geometry {
+
+namespace {
+
+using detail::Normalized;
+
+struct Frame {
+  CPoint3D origin;
+  CVector3D x{1, 0, 0};
+  CVector3D y{0, 1, 0};
+  CVector3D z{0, 0, 1};
+};
+
+Frame MakeFrame(const CSketchCSys &csys) {
+  Frame frame;
+  CVector3D xDir, yDir, zDir;
+  if (!csys.valid || !Normalized(csys.xDir, xDir) ||
+      !Normalized(csys.yDir, yDir)) {
+    return frame;
+  }
+  if (!Normalized(csys.zDir, zDir) && !Normalized(Cross(xDir, yDir), zDir)) {
+    return frame;
+  }
+  frame.origin = csys.origin;
+  frame.x = xDir;
+  frame.y = yDir;
+  frame.z = zDir;
+  return frame;
+}
+
+void PushLocal(SketchWorldPoints &out, std::uint32_t segment,
+               SketchConstraintSubEntity role, double u, double v, double w) {
+  out.points.Push(u, v, w);
+  out.segmentIndex.push_back(segment);
+  out.roles.push_back(role);
+}
+
+} // namespace
+
+void SketchWorldPoints::Clear() {
+  points.x.clear();
+  points.y.clear();
+  points.z.clear();
+  segmentIndex.clear();
+  roles.clear();
+  segmentOffsets.clear();
+  chiralityFlipped = false;
+}
+
+CMatrix4 SketchToWorldMatrix(const CSketchCSys &csys) {
+  const Frame f = MakeFrame(csys);
+  CMatrix4 matrix;
+  auto &m = matrix.m;
+  m[0][0] = f.x.x; m[0][1] = f.y.x; m[0][2] = f.z.x; m[0][3] = f.origin.x;
+  m[1][0] = f.x.y; m[1][1] = f.y.y; m[1][2] = f.z.y; m[1][3] = f.origin.y;
+  m[2][0] = f.x.z; m[2][1] = f.y.z; m[2][2] = f.z.z; m[2][3] = f.origin.z;
+  return matrix;
+}
+
+CMatrix4 WorldToSketchMatrix(const CSketchCSys &csys) {
+  const CMatrix4 forward = SketchToWorldMatrix(csys);
+  const auto &a = forward.m;
+  const double det = a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+                     a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+                     a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+  CMatrix4 inverse;
+  if (std::abs(det) < GeoUtils::EPSILON) {
+    return inverse;
+  }
+  // 3x3 伴随矩阵 / det；平移取 -R⁻¹·t。
+  auto &r = inverse.m;
+  const double s = 1.0 / det;
+  r[0][0] = (a[1][1] * a[2][2] - a[1][2] * a[2][1]) * s;
+  r[0][1] = (a[0][2] * a[2][1] - a[0][1] * a[2][2]) * s;
+  r[0][2] = (a[0][1] * a[1][2] - a[0][2] * a[1][1]) * s;
+  r[1][0] = (a[1][2] * a[2][0] - a[1][0] * a[2][2]) * s;
+  r[1][1] = (a[0][0] * a[2][2] - a[0][2] * a[2][0]) * s;
+  r[1][2] = (a[0][2] * a[1][0] - a[0][0] * a[1][2]) * s;
+  r[2][0] = (a[1][0] * a[2][1] - a[1][1] * a[2][0]) * s;
+  r[2][1] = (a[0][1] * a[2][0] - a[0][0] * a[2][1]) * s;
+  r[2][2] = (a[0][0] * a[1][1] - a[0][1] * a[1][0]) * s;
+  for (int row = 0; row < 3; ++row) {
+    r[row][3] = -(r[row][0] * a[0][3] + r[row][1] * a[1][3] +
+                  r[row][2] * a[2][3]);
+  }
+  return inverse;
+}
+
+void ProjectSketchToWorld(const CSketch &sketch, SketchWorldPoints &out) {
+  out.Clear();
+  out.points.Reserve(sketch.segments.size() * 2);
+  out.segmentOffsets.reserve(sketch.segments.size() + 1);
+
+  using Role = SketchConstraintSubEntity;
+  for (std::size_t i = 0; i < sketch.segments.size(); ++i) {
+    const auto segment = static_cast<std::uint32_t>(i);
+    out.segmentOffsets.push_back(static_cast<std::uint32_t>(out.Size()));
+    const CSketchSeg *seg = sketch.segments[i].get();
+    if (!seg) {
+      continue;
+    }
+    switch (seg->type) {
+    case CSketchSeg::SegType::LINE: {
+      const auto &line = static_cast<const CSketchLine &>(*seg);
+      PushLocal(out, segment, Role::Start, line.startPos.x, line.startPos.y,
+                line.startPos.z);
+      PushLocal(out, segment, Role::End, line.endPos.x, line.endPos.y,
+                line.endPos.z);
+      break;
+    }
+    case CSketchSeg::SegType::ARC: {
+      const auto &arc = static_cast<const CSketchArc &>(*seg);
+      const CPoint3D &c = arc.center;
+      PushLocal(out, segment, Role::Center, c.x, c.y, c.z);
+      PushLocal(out, segment, Role::Start,
+                c.x + arc.radius * std::cos(arc.startAngle),
+                c.y + arc.radius * std::sin(arc.startAngle), c.z);
+      PushLocal(out, segment, Role::End,
+                c.x + arc.radius * std::cos(arc.endAngle),
+                c.y + arc.radius * std::sin(arc.endAngle), c.z);
+      break;
+    }
+    case CSketchSeg::SegType::CIRCLE: {
+      const auto &circle = static_cast<const CSketchCircle &>(*seg);
+      PushLocal(out, segment, Role::Center, circle.center.x, circle.center.y,
+                circle.center.z);
+      break;
+    }
+    case CSketchSeg::SegType::POINT: {
+      const auto &point = static_cast<const CSketchPoint &>(*seg);
+      PushLocal(out, segment, Role::Whole, point.position.x, point.position.y,
+                point.position.z);
+      break;
+    }
+    default:
+      break;
+    }
+  }
+  out.segmentOffsets.push_back(static_cast<std::uint32_t>(out.Size()));
+
+  const Frame frame = MakeFrame(sketch.sketchCSys);
+  out.chiralityFlipped = Cross(frame.x, frame.y).Dot(frame.z) < 0.0;
+  TransformPointBlock(SketchToWorldMatrix(sketch.sketchCSys), out.points,
+                      out.points);
+}
+
+void ProjectSketchToWorld(const CSketchCSys &csys, const CPointBlock &local,
+                          CPointBlock &world) {
+  if (&world != &local) {
+    world.Resize(local.Size());
+  }
+  TransformPointBlock(SketchToWorldMatrix(csys), local, world);
+}
+
+void ProjectWorldToSketch(const CSketchCSys &csys, const CPointBlock &world,
+                          CPointBlock &local) {
+  if (&world != &local) {
+    local.Resize(world.Size());
+  }
+  TransformPointBlock(WorldToSketchMatrix(csys), world, local);
+}
+
+} // namespace Geometry
+} // namespace CADExchange
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../../core/ModelTransform.h"
+#include "../../core/UnifiedModel.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace CADExchange {
+namespace Geometry {
+
+/**
+ * @brief 草图特征点的世界坐标批量结果。
+ *
+ * points 为连续的 SoA 缓冲区，按段顺序排列：
+ *   - 直线：Start、End；
+ *   - 圆弧：Center、Start（startAngle 处）、End（endAngle 处）；
+ *   - 圆：Center；
+ *   - 点：Whole。
+ * 样条等无特征点的段不产生条目。第 i 个段的点位于
+ * [segmentOffsets[i], segmentOffsets[i + 1])。
+ */
+struct SketchWorldPoints {
+  CPointBlock points;
+  std::vector<std::uint32_t> segmentIndex;      ///< 每个点所属的段下标
+  std::vector<SketchConstraintSubEntity> roles; ///< 每个点在段内的角色
+  std::vector<std::uint32_t> segmentOffsets;    ///< 大小为段数 + 1
+
+  /**
+   * @brief zDir 与 xDir × yDir 反向（左手系）。
+   *
+   * 此时相对 zDir 观察的圆弧绕向与 isClockwise 相反，跨系统重建圆弧时
+   * 需据此翻转绕向。
+   */
+  bool chiralityFlipped = false;
+
+  std::size_t Size() const { return points.Size(); }
+
+  void Clear();
+};
+
+/**
+ * @brief 草图局部 → 世界的仿射矩阵（列为 xDir/yDir/zDir，平移为 origin）。
+ *
+ * 轴向量先归一化；sketchCSys 无效或 xDir/yDir 退化时返回单位阵（局部即
+ * 世界），zDir 退化时取 xDir × yDir。
+ */
+CMatrix4 SketchToWorldMatrix(const CSketchCSys &csys);
+
+/**
+ * @brief SketchToWorldMatrix 的逆矩阵。坐标轴非正交时按一般逆矩阵计算。
+ */
+CMatrix4 WorldToSketchMatrix(const CSketchCSys &csys);
+
+/**
+ * @brief 一次收集草图全部特征点并批量映射到世界坐标。
+ *
+ * 各段的局部坐标先按段顺序写入 out.points，随后整块经 TransformPointBlock
+ * 原地变换，不再逐点读取 sketchCSys。out 原有内容被清空，容量复用。
+ */
+void ProjectSketchToWorld(const CSketch &sketch, SketchWorldPoints &out);
+
+/**
+ * @brief 按 csys 将局部点集批量映射到世界坐标（world 可与 local 为同一对象）。
+ */
+void ProjectSketchToWorld(const CSketchCSys &csys, const CPointBlock &local,
+                          CPointBlock &world);
+
+/**
+ * @brief ProjectSketchToWorld 的逆变换：世界点集映射回草图局部坐标。
+ *
+ * 平面内的点变换后 z 分量为 0（在容差内）。
+ */
+void ProjectWorldToSketch(const CSketchCSys &csys, const CPointBlock &world,
+                          CPointBlock &local);
+
+} // namespace Geometry
+} // namespace CADExchange
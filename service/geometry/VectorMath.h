@@ -0,0 +1,52 @@
+#pragma once
+
+#include "../../core/UnifiedTypes.h"
+
+#include <cmath>
+
+/**
+ * @file VectorMath.h
+ * @brief 几何服务内部共用的小型向量运算。
+ *
+ * 仅供 service/geometry 下的 .cpp 实现文件使用，不属于公开接口。
+ */
+
+namespace CADExchange {
+namespace Geometry {
+namespace detail {
+
+/**
+ * @brief 向量按标量缩放。
+ */
+inline CVector3D Scaled(const CVector3D &v, double s) {
+  return {v.x * s, v.y * s, v.z * s};
+}
+
+/**
+ * @brief 向量长度。
+ */
+inline double Length(const CVector3D &v) { return std::sqrt(v.Dot(v)); }
+
+/**
+ * @brief 两点间欧氏距离。
+ */
+inline double Distance(const CPoint3D &a, const CPoint3D &b) {
+  return Length(b - a);
+}
+
+/**
+ * @brief 单位化 v 写入 out；长度小于 minLength 时返回 false 且不修改 out。
+ */
+inline bool Normalized(const CVector3D &v, CVector3D &out,
+                       double minLength = GeoUtils::EPSILON) {
+  const double len = Length(v);
+  if (len < minLength) {
+    return false;
+  }
+  out = Scaled(v, 1.0 / len);
+  return true;
+}
+
+} // namespace detail
+} // namespace Geometry
+} // namespace CADExchange
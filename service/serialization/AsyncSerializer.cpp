@@ -0,0 +1,306 @@
+#include "AsyncSerializer.h"
+#include "../../core/ModelTransform.h"
+#include "../../core/detail/IoHelpers.h"
+
+#include <array>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace CADExchange {
+
+namespace {
+
+using detail::Fail;
+using detail::ReadFile;
+
+#ifdef _WIN32
+
+bool WriteAndReplace(const std::filesystem::path &target,
+                     const std::filesystem::path &temp, std::string_view data,
+                     bool syncToDisk, std::string *errorMessage) {
+  FILE *file = _wfopen(temp.c_str(), L"wb");
+  if (!file) {
+    return Fail(errorMessage, "Could not open temporary file: " + temp.string());
+  }
+  const bool written =
+      std::fwrite(data.data(), 1, data.size(), file) == data.size() &&
+      std::fflush(file) == 0 && (!syncToDisk || _commit(_fileno(file)) == 0);
+  std::fclose(file);
+  if (!written) {
+    return Fail(errorMessage, "Failed to write temporary file: " + temp.string());
+  }
+  DWORD flags = MOVEFILE_REPLACE_EXISTING;
+  if (syncToDisk) {
+    flags |= MOVEFILE_WRITE_THROUGH;
+  }
+  if (!MoveFileExW(temp.c_str(), target.c_str(), flags)) {
+    return Fail(errorMessage, "Failed to replace " + target.string());
+  }
+  return true;
+}
+
+#else
+
+bool WriteAll(int fd, const char *data, std::size_t size) {
+  while (size > 0) {
+    const ssize_t n = ::write(fd, data, size);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += n;
+    size -= static_cast<std::size_t>(n);
+  }
+  return true;
+}
+
+bool WriteAndReplace(const std::filesystem::path &target,
+                     const std::filesystem::path &temp, std::string_view data,
+                     bool syncToDisk, std::string *errorMessage) {
+  const int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                        0644);
+  if (fd < 0) {
+    return Fail(errorMessage, "Could not open temporary file: " + temp.string() +
+                                  ": " + std::strerror(errno));
+  }
+  bool written = WriteAll(fd, data.data(), data.size());
+  if (written && syncToDisk) {
+    written = ::fsync(fd) == 0;
+  }
+  const int writeErrno = errno;
+  written = (::close(fd) == 0) && written;
+  if (!written) {
+    return Fail(errorMessage, "Failed to write temporary file: " +
+                                  temp.string() + ": " +
+                                  std::strerror(writeErrno));
+  }
+  if (::rename(temp.c_str(), target.c_str()) != 0) {
+    return Fail(errorMessage, "Failed to replace " + target.string() + ": " +
+                                  std::strerror(errno));
+  }
+  if (syncToDisk) {
+    // 重命名本身记录在目录项中，需同步目录才能在掉电后保留。
+    const auto dir = target.has_parent_path() ? target.parent_path()
+                                              : std::filesystem::path(".");
+    const int dirFd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd >= 0) {
+      ::fsync(dirFd);
+      ::close(dirFd);
+    }
+  }
+  return true;
+}
+
+#endif
+
+struct SaveJob {
+  UnifiedModel snapshot;
+  std::filesystem::path path;
+  AsyncSaveOptions options;
+  std::promise<AsyncSaveResult> promise;
+};
+
+/**
+ * 两级保存流水线：序列化线程 → 写盘线程，两块缓冲区在两级之间轮转。
+ *
+ * 缓冲区通过空闲表转移所有权，任一时刻只被一个线程访问。两级各自 FIFO，
+ * 因此保存按提交顺序落盘。
+ */
+class SavePipeline {
+public:
+  static SavePipeline &Instance() {
+    static SavePipeline pipeline;
+    return pipeline;
+  }
+
+  std::future<AsyncSaveResult> Submit(std::unique_ptr<SaveJob> job) {
+    auto future = job->promise.get_future();
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_serializeQueue.push_back(std::move(job));
+    }
+    m_cv.notify_all();
+    return future;
+  }
+
+  ~SavePipeline() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopping = true;
+    }
+    m_cv.notify_all();
+    m_serializer.join();
+    m_writer.join();
+  }
+
+  SavePipeline(const SavePipeline &) = delete;
+  SavePipeline &operator=(const SavePipeline &) = delete;
+
+private:
+  /// 超过此容量的缓冲区在写盘后释放，避免一次大模型保存长期占用内存。
+  static constexpr std::size_t kMaxRetainedBufferBytes = 64u << 20;
+
+  struct PendingWrite {
+    std::unique_ptr<SaveJob> job;
+    std::size_t buffer = 0;
+  };
+
+  SavePipeline()
+      : m_freeBuffers{0, 1}, m_serializer([this] { SerializeLoop(); }),
+        m_writer([this] { WriteLoop(); }) {}
+
+  void ReleaseBuffer(std::size_t index) {
+    if (m_buffers[index].capacity() > kMaxRetainedBufferBytes) {
+      std::string().swap(m_buffers[index]);
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_freeBuffers.push_back(index);
+    }
+    m_cv.notify_all();
+  }
+
+  void SerializeLoop() {
+    for (;;) {
+      std::unique_ptr<SaveJob> job;
+      std::size_t buffer = 0;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] {
+          return (m_stopping && m_serializeQueue.empty()) ||
+                 (!m_serializeQueue.empty() && !m_freeBuffers.empty());
+        });
+        if (m_serializeQueue.empty()) {
+          m_serializerDone = true;
+          break;
+        }
+        job = std::move(m_serializeQueue.front());
+        m_serializeQueue.pop_front();
+        buffer = m_freeBuffers.back();
+        m_freeBuffers.pop_back();
+      }
+
+      std::string error;
+      if (!SaveModelToBuffer(job->snapshot, m_buffers[buffer], &error,
+                             job->options.format,
+                             job->options.skipValidation)) {
+        job->promise.set_value({false, std::move(error), 0});
+        ReleaseBuffer(buffer);
+        continue;
+      }
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_writeQueue.push_back({std::move(job), buffer});
+      }
+      m_cv.notify_all();
+    }
+    m_cv.notify_all();
+  }
+
+  void WriteLoop() {
+    for (;;) {
+      PendingWrite pending;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] {
+          return !m_writeQueue.empty() || m_serializerDone;
+        });
+        if (m_writeQueue.empty()) {
+          break;
+        }
+        pending = std::move(m_writeQueue.front());
+        m_writeQueue.pop_front();
+      }
+
+      const std::string &data = m_buffers[pending.buffer];
+      AsyncSaveResult result;
+      result.ok = WriteFileAtomically(pending.job->path, data,
+                                      pending.job->options.syncToDisk,
+                                      &result.errorMessage);
+      result.bytesWritten = result.ok ? data.size() : 0;
+      ReleaseBuffer(pending.buffer);
+      pending.job->promise.set_value(std::move(result));
+    }
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<std::unique_ptr<SaveJob>> m_serializeQueue;
+  std::deque<PendingWrite> m_writeQueue;
+  std::array<std::string, 2> m_buffers;
+  std::vector<std::size_t> m_freeBuffers;
+  bool m_stopping = false;
+  bool m_serializerDone = false;
+  std::thread m_serializer;
+  std::thread m_writer;
+};
+
+} // namespace
+
+bool WriteFileAtomically(const std::filesystem::path &target,
+                         std::string_view data, bool syncToDisk,
+                         std::string *errorMessage) {
+  std::filesystem::path temp = target;
+  temp += ".tmp";
+  if (WriteAndReplace(target, temp, data, syncToDisk, errorMessage)) {
+    return true;
+  }
+  std::error_code ec;
+  std::filesystem::remove(temp, ec);
+  return false;
+}
+
+std::future<AsyncSaveResult>
+SaveModelAsync(std::shared_ptr<const UnifiedModel> model,
+               const std::filesystem::path &filePath,
+               const AsyncSaveOptions &options) {
+  if (!model) {
+    std::promise<AsyncSaveResult> failed;
+    failed.set_value({false, "SaveModelAsync: model is null.", 0});
+    return failed.get_future();
+  }
+  // 深拷贝：序列化线程只读私有副本，调用方随后原地修改特征也不会竞争。
+  auto job = std::make_unique<SaveJob>();
+  job->snapshot = CloneModelDeep(*model);
+  job->path = filePath;
+  job->options = options;
+  return SavePipeline::Instance().Submit(std::move(job));
+}
+
+std::future<AsyncLoadResult> LoadModelAsync(const std::filesystem::path &filePath,
+                                            SerializationFormat format) {
+  return std::async(std::launch::async, [filePath, format] {
+    AsyncLoadResult result;
+    std::string data;
+    if (!ReadFile(filePath, data)) {
+      result.errorMessage = "Could not read input file: " + filePath.string();
+      return result;
+    }
+    auto model = std::make_shared<UnifiedModel>();
+    result.ok =
+        LoadModelFromBuffer(*model, data, &result.errorMessage, format);
+    if (result.ok) {
+      result.model = std::move(model);
+    }
+    return result;
+  });
+}
+
+} // namespace CADExchange
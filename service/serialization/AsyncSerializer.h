@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CADSerializer.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace CADExchange {
+
+/**
+ * @file AsyncSerializer.h
+ * @brief SaveModel/LoadModel 的异步版本：后台校验、序列化与落盘。
+ *
+ * 保存经过进程内的两级流水线：序列化线程把模型写入两块可复用缓冲区之一，
+ * 写盘线程把另一块写入临时文件、按需 fsync，再原子重命名到目标路径。
+ * 两级并行，因此连续保存时下一次序列化与上一次写盘重叠。所有保存按提交
+ * 顺序完成，同一路径的后一次保存总是覆盖前一次。
+ */
+
+/**
+ * @brief SaveModelAsync 的选项。
+ */
+struct AsyncSaveOptions {
+  SerializationFormat format = SerializationFormat::TINYXML;
+  bool skipValidation = false; ///< 同 SaveModel 的 skipValidation
+  /// 重命名前 fsync 数据文件，重命名后 fsync 所在目录（POSIX），保证掉电后
+  /// 目标文件要么是旧版本、要么是完整的新版本。关闭后只保证原子替换。
+  bool syncToDisk = true;
+};
+
+/**
+ * @brief 异步保存结果。
+ */
+struct AsyncSaveResult {
+  bool ok = false;
+  std::string errorMessage;
+  std::size_t bytesWritten = 0;
+};
+
+/**
+ * @brief 异步加载结果；失败时 model 为空。
+ */
+struct AsyncLoadResult {
+  bool ok = false;
+  std::string errorMessage;
+  std::shared_ptr<UnifiedModel> model;
+};
+
+/**
+ * @brief 同步地把 data 写入 target.tmp，按需 fsync，再原子替换 target。
+ *
+ * SaveModelAsync 的写盘步骤，也供需要原子落盘的其他持久化组件复用。
+ * 失败时删除临时文件，target 保持原样。
+ */
+bool WriteFileAtomically(const std::filesystem::path &target,
+                         std::string_view data, bool syncToDisk,
+                         std::string *errorMessage = nullptr);
+
+/**
+ * @brief 在后台保存模型，立即返回 future。
+ *
+ * 调用线程在返回前用 CloneModelDeep 拍下模型快照（特征、引用实体与草图段
+ * 均为新对象），之后调用方可以增删特征或原地修改字段而不影响本次保存。
+ * 快照的时间与内存开销与模型大小成正比，由调用线程承担。
+ *
+ * 写入先落到同目录的临时文件，成功后原子重命名；失败时目标文件保持原样，
+ * 临时文件被删除。
+ *
+ * @param model 要保存的模型；为空时 future 直接给出失败结果。
+ * @param filePath 目标路径。
+ * @param options 格式、校验与 fsync 选项。
+ */
+std::future<AsyncSaveResult>
+SaveModelAsync(std::shared_ptr<const UnifiedModel> model,
+               const std::filesystem::path &filePath,
+               const AsyncSaveOptions &options = {});
+
+/**
+ * @brief 在后台读取并解析模型（用于预取），加载后同样执行 Validate()。
+ *
+ * 文件先整体读入内存再经 LoadModelFromBuffer 解析，与保存流水线互不阻塞。
+ */
+std::future<AsyncLoadResult>
+LoadModelAsync(const std::filesystem::path &filePath,
+               SerializationFormat format = SerializationFormat::TINYXML);
+
+} // namespace CADExchange
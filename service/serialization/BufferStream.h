@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+namespace CADExchange {
+
+/**
+ * @file BufferStream.h
+ * @brief 内存缓冲区与 std::iostream 之间的零拷贝适配。
+ *
+ * 供各序列化器的内存读写接口使用：写出时直接追加到调用方提供的
+ * std::string（容量可跨次复用），读取时直接在调用方的字节区间上取字符，
+ * 不经临时文件，也不复制输入。
+ */
+
+/**
+ * @class StringSinkBuf
+ * @brief 追加写入到外部 std::string 的 streambuf。
+ *
+ * 构造时不清空目标；需要覆盖写入时由调用方先 clear()（保留容量）。
+ */
+class StringSinkBuf : public std::streambuf {
+public:
+  explicit StringSinkBuf(std::string &target) : m_target(target) {}
+
+protected:
+  int_type overflow(int_type ch) override {
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+      m_target.push_back(traits_type::to_char_type(ch));
+    }
+    return traits_type::not_eof(ch);
+  }
+
+  std::streamsize xsputn(const char *data, std::streamsize count) override {
+    m_target.append(data, static_cast<std::size_t>(count));
+    return count;
+  }
+
+private:
+  std::string &m_target;
+};
+
+/**
+ * @class MemorySourceBuf
+ * @brief 只读地暴露一段外部字节区间的 streambuf（区间须在读取期间有效）。
+ */
+class MemorySourceBuf : public std::streambuf {
+public:
+  explicit MemorySourceBuf(std::string_view data) {
+    char *begin = const_cast<char *>(data.data());
+    setg(begin, begin, begin + data.size());
+  }
+
+protected:
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                   std::ios_base::openmode which) override {
+    if (!(which & std::ios_base::in)) {
+      return pos_type(off_type(-1));
+    }
+    char *base = dir == std::ios_base::beg   ? eback()
+                 : dir == std::ios_base::cur ? gptr()
+                                             : egptr();
+    char *target = base + off;
+    if (target < eback() || target > egptr()) {
+      return pos_type(off_type(-1));
+    }
+    setg(eback(), target, egptr());
+    return pos_type(target - eback());
+  }
+
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+  }
+};
+
+} // namespace CADExchange
@@ -1,11 +1,17 @@
 ﻿#pragma once
 
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <string_view>
 
 #include "../../core/UnifiedModel.h"
+#include "BufferStream.h"
+#include "CerealJsonSerializer.h"
+#include "LoadPipeline.h"
+#include "SerializerContext.h"
 #include "TinyXMLSerializer.h"
 
 // Only include cereal when actually needed (not when using TINYXML)
@@ -23,7 +29,13 @@
 namespace CADExchange {
 void RegisterSerializationTypes();
 
-enum class SerializationFormat { CEREAL, TINYXML };
+/**
+ * @brief 序列化格式。
+ *
+ * CEREAL 为 cereal XML 档案（需 ENABLE_CEREAL_SERIALIZATION）；TINYXML 为
+ * tinyxml2 XML；CEREAL_JSON 为 cereal JSON 档案，加载时流式解析。
+ */
+enum class SerializationFormat { CEREAL, TINYXML, CEREAL_JSON };
 
 } // namespace CADExchange
 /**
@@ -33,6 +45,84 @@ enum class SerializationFormat { CEREAL, TINYXML };
 
 namespace CADExchange {
 
+namespace detail {
+
+inline bool ValidateBeforeSave(const UnifiedModel &model,
+                               std::string *errorMessage) {
+  const auto report = model.Validate();
+  if (!report.isValid) {
+    if (errorMessage) {
+      std::string msg = "Model validation failed before saving:";
+      for (const auto &e : report.errors) {
+        msg += "\n  " + e;
+      }
+      *errorMessage = msg;
+    }
+    return false;
+  }
+  // warnings 写入 stderr（不阻断）
+  for (const auto &w : report.warnings) {
+    std::cerr << "[CADSerializer][WARN] " << w << "\n";
+  }
+  return true;
+}
+
+inline bool ValidateAfterLoad(const UnifiedModel &model,
+                              std::string *errorMessage) {
+  return ReportLoadValidation(model.Validate(), errorMessage);
+}
+
+inline bool SaveCerealXml(const UnifiedModel &model, std::ostream &output,
+                          std::string *errorMessage) {
+#ifdef ENABLE_CEREAL_SERIALIZATION
+  RegisterSerializationTypes();
+  try {
+    cereal::XMLOutputArchive archive(output);
+    // Use the save function defined in UnifiedSerialization.h
+    save(archive, model);
+  } catch (const std::exception &ex) {
+    if (errorMessage) {
+      *errorMessage = ex.what();
+    }
+    return false;
+  }
+  return true;
+#else
+  (void)model;
+  (void)output;
+  if (errorMessage) {
+    *errorMessage = "CEREAL serialization not enabled. Please compile with ENABLE_CEREAL_SERIALIZATION flag.";
+  }
+  return false;
+#endif
+}
+
+inline bool LoadCerealXml(UnifiedModel &model, std::istream &input,
+                          std::string *errorMessage) {
+#ifdef ENABLE_CEREAL_SERIALIZATION
+  RegisterSerializationTypes();
+  try {
+    cereal::XMLInputArchive archive(input);
+    load(archive, model);
+  } catch (const std::exception &ex) {
+    if (errorMessage) {
+      *errorMessage = ex.what();
+    }
+    return false;
+  }
+  return true;
+#else
+  (void)model;
+  (void)input;
+  if (errorMessage) {
+    *errorMessage = "CEREAL serialization not enabled. Please compile with ENABLE_CEREAL_SERIALIZATION flag.";
+  }
+  return false;
+#endif
+}
+
+} // namespace detail
+
 /**
  * @brief 将 UnifiedModel 序列化为 XML 文件。
  *
@@ -44,37 +134,26 @@ namespace CADExchange {
  * @param errorMessage 可选的错误消息输出地址。
  * @param format 序列化格式 (默认 CEREAL)。
  * @param skipValidation 为 true 时跳过 Validate()（debug 用途）。
+ * @param context 可选，TINYXML 保存复用其中的文档与缓冲区；其余格式忽略。
  * @return 保存成功返回 true，否则返回 false。
  */
 inline bool
 SaveModel(const UnifiedModel &model, const std::filesystem::path &filePath,
           std::string *errorMessage = nullptr,
           SerializationFormat format = SerializationFormat::CEREAL,
-          bool skipValidation = false) {
-  if (!skipValidation) {
-    const auto report = model.Validate();
-    if (!report.isValid) {
-      if (errorMessage) {
-        std::string msg = "Model validation failed before saving:";
-        for (const auto &e : report.errors) {
-          msg += "\n  " + e;
-        }
-        *errorMessage = msg;
-      }
-      return false;
-    }
-    // warnings 写入 stderr（不阻断）
-    for (const auto &w : report.warnings) {
-      std::cerr << "[CADSerializer][WARN] " << w << "\n";
-    }
+          bool skipValidation = false, SerializerContext *context = nullptr) {
+  if (!skipValidation && !detail::ValidateBeforeSave(model, errorMessage)) {
+    return false;
   }
 
   if (format == SerializationFormat::TINYXML) {
-    return TinyXMLSerializer::Save(model, filePath, errorMessage);
+    return TinyXMLSerializer::Save(model, filePath, errorMessage, context);
+  }
+  if (format == SerializationFormat::CEREAL_JSON) {
+    return CerealJsonSerializer::Save(model, filePath, errorMessage);
   }
 
 #ifdef ENABLE_CEREAL_SERIALIZATION
-  RegisterSerializationTypes();
   std::ofstream output(filePath, std::ios::binary);
   if (!output) {
     if (errorMessage) {
@@ -82,51 +161,87 @@ SaveModel(const UnifiedModel &model, const std::filesystem::path &filePath,
     }
     return false;
   }
+#else
+  std::ostream output(nullptr);
+#endif
+  return detail::SaveCerealXml(model, output, errorMessage);
+}
 
-  try {
-    cereal::XMLOutputArchive archive(output);
-    // Use the save function defined in UnifiedSerialization.h
-    save(archive, model);
-  } catch (const std::exception &ex) {
-    if (errorMessage) {
-      *errorMessage = ex.what();
-    }
+/**
+ * @brief 将 UnifiedModel 序列化到输出流，行为与文件版本一致。
+ *
+ * 适用于管道、socket 等场景，不产生临时文件。
+ */
+inline bool SaveModel(const UnifiedModel &model, std::ostream &output,
+                      std::string *errorMessage = nullptr,
+                      SerializationFormat format = SerializationFormat::CEREAL,
+                      bool skipValidation = false,
+                      SerializerContext *context = nullptr) {
+  if (!skipValidation && !detail::ValidateBeforeSave(model, errorMessage)) {
     return false;
   }
-
-  return true;
-#else
-  if (errorMessage) {
-    *errorMessage = "CEREAL serialization not enabled. Please compile with ENABLE_CEREAL_SERIALIZATION flag.";
+  switch (format) {
+  case SerializationFormat::TINYXML:
+    return TinyXMLSerializer::Save(model, output, errorMessage, context);
+  case SerializationFormat::CEREAL_JSON:
+    return CerealJsonSerializer::Save(model, output, errorMessage);
+  default:
+    return detail::SaveCerealXml(model, output, errorMessage);
   }
-  return false;
-#endif
 }
 
 /**
- * @brief 从 XML 文件加载 UnifiedModel，加载后自动执行 Validate()。
+ * @brief 将 UnifiedModel 序列化到调用方提供的缓冲区。
  *
- * 加载完成后自动执行 Validate()：有 error 则返回 false 并写入 errorMessage，
- * warnings 输出到 stderr。
+ * buffer 先被清空再写入，已分配的容量被复用；对同一缓冲区反复调用
+ * 不会重复分配，适合缓存与转换服务。
+ */
+inline bool
+SaveModelToBuffer(const UnifiedModel &model, std::string &buffer,
+                  std::string *errorMessage = nullptr,
+                  SerializationFormat format = SerializationFormat::CEREAL,
+                  bool skipValidation = false,
+                  SerializerContext *context = nullptr) {
+  if (!skipValidation && !detail::ValidateBeforeSave(model, errorMessage)) {
+    return false;
+  }
+  switch (format) {
+  case SerializationFormat::TINYXML:
+    return TinyXMLSerializer::SaveToBuffer(model, buffer, errorMessage, context);
+  case SerializationFormat::CEREAL_JSON:
+    return CerealJsonSerializer::SaveToBuffer(model, buffer, errorMessage);
+  default: {
+    buffer.clear();
+    StringSinkBuf sink(buffer);
+    std::ostream output(&sink);
+    return detail::SaveCerealXml(model, output, errorMessage);
+  }
+  }
+}
+
+/**
+ * @brief 按 LoadOptions 从文件加载 UnifiedModel。
  *
- * @param model 用于接收数据的模型对象引用。
- * @param filePath 源文件路径。
- * @param errorMessage 可选错误文本输出。
- * @param format 序列化格式 (默认 CEREAL)。
- * @return 加载且验证均成功返回 true，否则返回 false。
+ * 结果与诊断同“LoadModel 后接 ConvertModelUnit”一致，但校验与单位换算
+ * 在一次特征遍历中完成：TINYXML 在每个特征解码后立即处理，其余格式在
+ * 加载完成后逐特征处理。
  */
 inline bool
 LoadModel(UnifiedModel &model, const std::filesystem::path &filePath,
-          std::string *errorMessage = nullptr,
+          const LoadOptions &options, std::string *errorMessage = nullptr,
           SerializationFormat format = SerializationFormat::CEREAL) {
-  bool loadOk = false;
+  LoadPipeline pipeline(options);
   if (format == SerializationFormat::TINYXML) {
-    loadOk = TinyXMLSerializer::Load(model, filePath, errorMessage);
+    return TinyXMLSerializer::Load(model, filePath, errorMessage, &pipeline,
+                                   options.context) &&
+           pipeline.Finish(model, errorMessage);
   }
 
+  bool loadOk = false;
+  if (format == SerializationFormat::CEREAL_JSON) {
+    loadOk = CerealJsonSerializer::Load(model, filePath, errorMessage);
+  } else {
 #ifdef ENABLE_CEREAL_SERIALIZATION
-  else {
-    RegisterSerializationTypes();
     std::ifstream input(filePath, std::ios::binary);
     if (!input) {
       if (errorMessage) {
@@ -134,46 +249,116 @@ LoadModel(UnifiedModel &model, const std::filesystem::path &filePath,
       }
       return false;
     }
-    try {
-      cereal::XMLInputArchive archive(input);
-      load(archive, model);
-      loadOk = true;
-    } catch (const std::exception &ex) {
-      if (errorMessage) {
-        *errorMessage = ex.what();
-      }
-      return false;
-    }
-  }
 #else
-  else {
-    if (errorMessage) {
-      *errorMessage = "CEREAL serialization not enabled. Please compile with ENABLE_CEREAL_SERIALIZATION flag.";
-    }
-    return false;
-  }
+    std::istream input(nullptr);
 #endif
+    loadOk = detail::LoadCerealXml(model, input, errorMessage);
+  }
+  return loadOk && pipeline.Run(model, errorMessage);
+}
 
-  if (!loadOk) {
-    return false;
+/**
+ * @brief 按 LoadOptions 从输入流加载 UnifiedModel，行为与文件版本一致。
+ */
+inline bool LoadModel(UnifiedModel &model, std::istream &input,
+                      const LoadOptions &options,
+                      std::string *errorMessage = nullptr,
+                      SerializationFormat format = SerializationFormat::CEREAL) {
+  LoadPipeline pipeline(options);
+  bool loadOk = false;
+  switch (format) {
+  case SerializationFormat::TINYXML:
+    return TinyXMLSerializer::Load(model, input, errorMessage, &pipeline,
+                                   options.context) &&
+           pipeline.Finish(model, errorMessage);
+  case SerializationFormat::CEREAL_JSON:
+    loadOk = CerealJsonSerializer::Load(model, input, errorMessage);
+    break;
+  default:
+    loadOk = detail::LoadCerealXml(model, input, errorMessage);
+    break;
   }
+  return loadOk && pipeline.Run(model, errorMessage);
+}
 
-  // 加载完成后自动校验
-  const auto report = model.Validate();
-  for (const auto &w : report.warnings) {
-    std::cerr << "[CADSerializer][WARN] " << w << "\n";
+/**
+ * @brief 按 LoadOptions 从内存缓冲区加载 UnifiedModel，行为与文件版本一致。
+ */
+inline bool
+LoadModelFromBuffer(UnifiedModel &model, std::string_view data,
+                    const LoadOptions &options,
+                    std::string *errorMessage = nullptr,
+                    SerializationFormat format = SerializationFormat::CEREAL) {
+  LoadPipeline pipeline(options);
+  bool loadOk = false;
+  switch (format) {
+  case SerializationFormat::TINYXML:
+    return TinyXMLSerializer::LoadFromBuffer(model, data, errorMessage, &pipeline,
+                                             options.context) &&
+           pipeline.Finish(model, errorMessage);
+  case SerializationFormat::CEREAL_JSON:
+    loadOk = CerealJsonSerializer::LoadFromBuffer(model, data, errorMessage);
+    break;
+  default: {
+    MemorySourceBuf source(data);
+    std::istream input(&source);
+    loadOk = detail::LoadCerealXml(model, input, errorMessage);
+    break;
   }
-  if (!report.isValid) {
-    if (errorMessage) {
-      std::string msg = "Model validation failed after loading:";
-      for (const auto &e : report.errors) {
-        msg += "\n  " + e;
-      }
-      *errorMessage = msg;
-    }
-    return false;
   }
-  return true;
+  return loadOk && pipeline.Run(model, errorMessage);
+}
+
+/**
+ * @brief 从 XML 文件加载 UnifiedModel，加载后自动执行 Validate()。
+ *
+ * 加载完成后自动执行 Validate()：有 error 则返回 false 并写入 errorMessage，
+ * warnings 输出到 stderr。
+ *
+ * @param model 用于接收数据的模型对象引用。
+ * @param filePath 源文件路径。
+ * @param errorMessage 可选错误文本输出。
+ * @param format 序列化格式 (默认 CEREAL)。
+ * @return 加载且验证均成功返回 true，否则返回 false。
+ */
+inline bool
+LoadModel(UnifiedModel &model, const std::filesystem::path &filePath,
+          std::string *errorMessage = nullptr,
+          SerializationFormat format = SerializationFormat::CEREAL) {
+  return LoadModel(model, filePath, LoadOptions{}, errorMessage, format);
+}
+
+/**
+ * @brief 从输入流加载 UnifiedModel，加载后自动执行 Validate()。
+ */
+inline bool LoadModel(UnifiedModel &model, std::istream &input,
+                      std::string *errorMessage = nullptr,
+                      SerializationFormat format = SerializationFormat::CEREAL) {
+  return LoadModel(model, input, LoadOptions{}, errorMessage, format);
+}
+
+/**
+ * @brief 直接从内存缓冲区加载 UnifiedModel，加载后自动执行 Validate()。
+ *
+ * 缓冲区只在调用期间被读取，不会被复制到临时文件。
+ */
+inline bool
+LoadModelFromBuffer(UnifiedModel &model, std::string_view data,
+                    std::string *errorMessage = nullptr,
+                    SerializationFormat format = SerializationFormat::CEREAL) {
+  return LoadModelFromBuffer(model, data, LoadOptions{}, errorMessage, format);
+}
+
+/**
+ * @brief 字节区间版本的 LoadModelFromBuffer（例如接收自 socket 的原始字节）。
+ */
+inline bool
+LoadModelFromBuffer(UnifiedModel &model, const std::byte *data,
+                    std::size_t size, std::string *errorMessage = nullptr,
+                    SerializationFormat format = SerializationFormat::CEREAL) {
+  return LoadModelFromBuffer(
+      model, std::string_view(reinterpret_cast<const char *>(data), size),
+      errorMessage, format);
 }
 
 } // namespace CADExchange
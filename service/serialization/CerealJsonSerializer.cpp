@@ -0,0 +1,83 @@
+#include "CerealPrelude.h"
+#include "JsonStreamArchive.h"
+#include "CerealJsonSerializer.h"
+#include "BufferStream.h"
+#include "../../core/detail/IoHelpers.h"
+
+#include <fstream>
+
+namespace CADExchange {
+
+namespace {
+
+using detail::Fail;
+
+} // namespace
+
+bool CerealJsonSerializer::Save(const UnifiedModel &model,
+                                const std::filesystem::path &filePath,
+                                std::string *errorMessage) {
+  std::ofstream output(filePath, std::ios::binary);
+  if (!output) {
+    return Fail(errorMessage, "Could not open output file.");
+  }
+  return Save(model, output, errorMessage);
+}
+
+bool CerealJsonSerializer::Save(const UnifiedModel &model, std::ostream &output,
+                                std::string *errorMessage) {
+  RegisterSerializationTypes();
+  try {
+    // 档案析构时写出根对象的结束括号，需在检查流状态前结束作用域。
+    cereal::JSONOutputArchive archive(
+        output, cereal::JSONOutputArchive::Options::NoIndent());
+    save(archive, model);
+  } catch (const std::exception &ex) {
+    return Fail(errorMessage, ex.what());
+  }
+  if (!output.flush()) {
+    return Fail(errorMessage, "Failed to write output stream.");
+  }
+  return true;
+}
+
+bool CerealJsonSerializer::SaveToBuffer(const UnifiedModel &model,
+                                        std::string &buffer,
+                                        std::string *errorMessage) {
+  buffer.clear();
+  StringSinkBuf sink(buffer);
+  std::ostream output(&sink);
+  return Save(model, output, errorMessage);
+}
+
+bool CerealJsonSerializer::Load(UnifiedModel &model,
+                                const std::filesystem::path &filePath,
+                                std::string *errorMessage) {
+  std::ifstream input(filePath, std::ios::binary);
+  if (!input) {
+    return Fail(errorMessage, "Could not open input file.");
+  }
+  return Load(model, input, errorMessage);
+}
+
+bool CerealJsonSerializer::Load(UnifiedModel &model, std::istream &input,
+                                std::string *errorMessage) {
+  RegisterSerializationTypes();
+  try {
+    JsonStreamInputArchive archive(input);
+    load(archive, model);
+  } catch (const std::exception &ex) {
+    return Fail(errorMessage, ex.what());
+  }
+  return true;
+}
+
+bool CerealJsonSerializer::LoadFromBuffer(UnifiedModel &model,
+                                          std::string_view json,
+                                          std::string *errorMessage) {
+  MemorySourceBuf source(json);
+  std::istream input(&source);
+  return Load(model, input, errorMessage);
+}
+
+} // namespace CADExchange
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../../core/UnifiedModel.h"
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace CADExchange {
+
+/**
+ * @file CerealJsonSerializer.h
+ * @brief 基于 cereal JSON 档案的 UnifiedModel 读写接口声明。
+ *
+ * 本头文件不引入 cereal，调用方无需开启 ENABLE_CEREAL_SERIALIZATION；
+ * 序列化规则复用 UnifiedSerialization.h，多态类型在
+ * SerializationRegistry.cpp 中注册。
+ */
+
+/**
+ * @class CerealJsonSerializer
+ * @brief 提供静态方法以读写 `UnifiedModel` 到 JSON 文件。
+ *
+ * 保存使用 cereal::JSONOutputArchive（紧凑格式）；加载使用
+ * JsonStreamInputArchive，以 rapidjson Reader 逐 token 流式解析，
+ * 不构建完整 DOM，多态类型名每个文件只解析一次。
+ */
+class CerealJsonSerializer {
+public:
+  /**
+   * @brief 将 `UnifiedModel` 保存为 JSON 文件。
+   *
+   * @param model 要保存的模型。
+   * @param filePath 目标文件路径。
+   * @param errorMessage 若非空，出错时写入错误描述。
+   * @return 成功返回 true。
+   */
+  static bool Save(const UnifiedModel &model,
+                   const std::filesystem::path &filePath,
+                   std::string *errorMessage = nullptr);
+
+  /**
+   * @brief 从 JSON 文件流式加载 `UnifiedModel`。
+   *
+   * @param model 输出参数；失败时内容未定义。
+   * @param filePath 源文件路径。
+   * @param errorMessage 若非空，出错时写入错误描述（含解析偏移）。
+   * @return 成功返回 true。
+   */
+  static bool Load(UnifiedModel &model, const std::filesystem::path &filePath,
+                   std::string *errorMessage = nullptr);
+
+  /**
+   * @brief 将 `UnifiedModel` 以 JSON 写入输出流。
+   */
+  static bool Save(const UnifiedModel &model, std::ostream &output,
+                   std::string *errorMessage = nullptr);
+
+  /**
+   * @brief 将 `UnifiedModel` 以 JSON 写入调用方缓冲区（先清空，复用容量）。
+   */
+  static bool SaveToBuffer(const UnifiedModel &model, std::string &buffer,
+                           std::string *errorMessage = nullptr);
+
+  /**
+   * @brief 从输入流流式加载 `UnifiedModel`。
+   */
+  static bool Load(UnifiedModel &model, std::istream &input,
+                   std::string *errorMessage = nullptr);
+
+  /**
+   * @brief 直接在内存中的 JSON 文本上流式加载，不复制输入。
+   */
+  static bool LoadFromBuffer(UnifiedModel &model, std::string_view json,
+                             std::string *errorMessage = nullptr);
+};
+
+} // namespace CADExchange
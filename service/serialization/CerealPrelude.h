@@ -0,0 +1,13 @@
+#pragma once
+
+/**
+ * @file CerealPrelude.h
+ * @brief 使用 cereal 档案的实现文件的首个 include。
+ *
+ * UnifiedFeatures.h 在未引入 cereal 时会定义 CEREAL_NVP 占位宏，因此 cereal
+ * 头文件必须先于任何核心模型头文件引入；本头文件按此顺序引入 cereal 与
+ * UnifiedSerialization.h，并带上 RegisterSerializationTypes 的声明。
+ */
+
+#include "UnifiedSerialization.h"
+#include "CADSerializer.h"
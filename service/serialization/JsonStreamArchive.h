@@ -0,0 +1,491 @@
+#pragma once
+
+#include "../../thirdParty/cereal/archives/json.hpp"
+#include "../../thirdParty/cereal/types/memory.hpp"
+#include "../../thirdParty/cereal/types/polymorphic.hpp"
+#include "../../thirdParty/cereal/types/vector.hpp"
+#include "../../thirdParty/cereal/external/rapidjson/error/en.h"
+
+#include <cstdint>
+#include <istream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file JsonStreamArchive.h
+ * @brief 以 rapidjson Reader 逐 token 拉取的 cereal JSON 输入档案。
+ */
+
+namespace CADExchange {
+
+/**
+ * @class JsonStreamInputArchive
+ * @brief 读取 cereal::JSONOutputArchive 输出的流式输入档案。
+ *
+ * 与 cereal::JSONInputArchive 不同，本档案不构建 rapidjson::Document，
+ * 而是用 Reader 的迭代解析接口每次拉取一个 token（保留一个前瞻 token），
+ * 内存占用只与嵌套深度和最长字符串相关。
+ *
+ * 约束：
+ *   - 成员按写出顺序读取；NVP 名称不匹配时向后跳过未知成员，但不回溯；
+ *   - std::vector 读到数组结束为止（流式下无法预知元素个数），其他带
+ *     SizeTag 的容器不受支持；
+ *   - 多态指针的类型绑定按 polymorphic_id 在本档案内解析一次，之后同一
+ *     类型的对象直接命中缓存，不再做类型名查找。
+ */
+class JsonStreamInputArchive
+    : public cereal::InputArchive<JsonStreamInputArchive>,
+      public cereal::traits::TextArchive {
+  using Reader = CEREAL_RAPIDJSON_NAMESPACE::Reader;
+  using ReadStream = CEREAL_RAPIDJSON_NAMESPACE::IStreamWrapper;
+  using Bindings =
+      cereal::detail::InputBindingMap<JsonStreamInputArchive>::Serializers;
+
+public:
+  explicit JsonStreamInputArchive(std::istream &stream)
+      : cereal::InputArchive<JsonStreamInputArchive>(this),
+        m_buffer(kBufferSize), m_stream(stream, m_buffer.data(), kBufferSize) {
+    m_reader.IterativeParseInit();
+    Expect(Take(), Kind::StartObject, "root object");
+    m_frames.push_back(Frame::Object);
+  }
+
+  JsonStreamInputArchive(const JsonStreamInputArchive &) = delete;
+  JsonStreamInputArchive &operator=(const JsonStreamInputArchive &) = delete;
+
+  // --- cereal 档案接口 ---
+
+  void startNode() {
+    Search();
+    const Token &token = Take();
+    if (token.kind == Kind::StartObject) {
+      m_frames.push_back(Frame::Object);
+    } else if (token.kind == Kind::StartArray) {
+      m_frames.push_back(Frame::Array);
+    } else {
+      throw cereal::Exception("JsonStreamInputArchive: expected object or array");
+    }
+  }
+
+  /// 跳过当前节点内未读取的成员并消费结束 token。
+  void finishNode() {
+    while (!IsEnd(Peek().kind)) {
+      if (m_frames.back() == Frame::Object) {
+        Expect(Take(), Kind::Key, "member name");
+      }
+      SkipValue();
+    }
+    Take();
+    m_frames.pop_back();
+  }
+
+  void setNextName(const char *name) { m_nextName = name; }
+
+  template <class T,
+            cereal::traits::EnableIf<std::is_arithmetic<T>::value,
+                                     !std::is_same<T, bool>::value> =
+                cereal::traits::sfinae>
+  void loadValue(T &value) {
+    Search();
+    const Token &token = Take();
+    switch (token.kind) {
+    case Kind::Int64:
+      value = static_cast<T>(token.i64);
+      break;
+    case Kind::Uint64:
+      value = static_cast<T>(token.u64);
+      break;
+    case Kind::Double:
+      value = static_cast<T>(token.number);
+      break;
+    case Kind::String: {
+      // cereal 以字符串写出 long double 等超出 JSON 数值范围的类型。
+      std::istringstream in(token.text);
+      in >> value;
+      if (!in) {
+        throw cereal::Exception("JsonStreamInputArchive: invalid number '" +
+                                token.text + "'");
+      }
+      break;
+    }
+    default:
+      throw cereal::Exception("JsonStreamInputArchive: expected number");
+    }
+  }
+
+  void loadValue(bool &value) {
+    Search();
+    value = Expect(Take(), Kind::Bool, "boolean").boolean;
+  }
+
+  void loadValue(std::string &value) {
+    Search();
+    value = Expect(Take(), Kind::String, "string").text;
+  }
+
+  void loadValue(std::nullptr_t &) {
+    Search();
+    Expect(Take(), Kind::Null, "null");
+  }
+
+  void loadSize(cereal::size_type &) {
+    throw cereal::Exception(
+        "JsonStreamInputArchive: size-prefixed containers are not supported");
+  }
+
+  // --- 扩展接口 ---
+
+  /// 当前数组节点是否还有未读取的元素。
+  bool HasMoreElements() { return Peek().kind != Kind::EndArray; }
+
+  /**
+   * @brief 解析多态类型绑定：首次出现的 id 读取 polymorphic_name 并查表，
+   *        之后按 id 直接返回缓存的绑定。
+   */
+  const Bindings &ResolvePolymorphicBinding(std::uint32_t nameid) {
+    const std::uint32_t id = nameid & ~cereal::detail::msb_32bit;
+    if (nameid & cereal::detail::msb_32bit) {
+      std::string name;
+      (*this)(cereal::make_nvp("polymorphic_name", name));
+      const auto &map = cereal::detail::StaticObject<
+          cereal::detail::InputBindingMap<JsonStreamInputArchive>>::getInstance()
+                            .map;
+      auto it = map.find(name);
+      if (it == map.end()) {
+        throw cereal::Exception(
+            "JsonStreamInputArchive: unregistered polymorphic type " + name);
+      }
+      m_bindings[id] = &it->second;
+    }
+    auto it = m_bindings.find(id);
+    if (it == m_bindings.end()) {
+      throw cereal::Exception(
+          "JsonStreamInputArchive: unknown polymorphic type id " +
+          std::to_string(id));
+    }
+    return *it->second;
+  }
+
+  /// 本档案内已解析的多态类型数。
+  std::size_t ResolvedTypeCount() const { return m_bindings.size(); }
+
+private:
+  static constexpr std::size_t kBufferSize = 64 * 1024;
+
+  enum class Frame { Object, Array };
+
+  enum class Kind {
+    None,
+    Null,
+    Bool,
+    Int64,
+    Uint64,
+    Double,
+    String,
+    Key,
+    StartObject,
+    EndObject,
+    StartArray,
+    EndArray
+  };
+
+  struct Token {
+    Kind kind = Kind::None;
+    bool boolean = false;
+    std::int64_t i64 = 0;
+    std::uint64_t u64 = 0;
+    double number = 0.0;
+    std::string text;
+  };
+
+  /// rapidjson SAX 处理器：每次 IterativeParseNext 恰好写入一个 token。
+  struct Handler {
+    Token *token;
+
+    bool Set(Kind kind) {
+      token->kind = kind;
+      return true;
+    }
+    bool Null() { return Set(Kind::Null); }
+    bool Bool(bool b) {
+      token->boolean = b;
+      return Set(Kind::Bool);
+    }
+    bool Int(int i) { return Int64(i); }
+    bool Uint(unsigned u) { return Uint64(u); }
+    bool Int64(std::int64_t i) {
+      token->i64 = i;
+      return Set(Kind::Int64);
+    }
+    bool Uint64(std::uint64_t u) {
+      token->u64 = u;
+      return Set(Kind::Uint64);
+    }
+    bool Double(double d) {
+      token->number = d;
+      return Set(Kind::Double);
+    }
+    bool RawNumber(const char *, CEREAL_RAPIDJSON_NAMESPACE::SizeType, bool) {
+      return false;
+    }
+    bool String(const char *s, CEREAL_RAPIDJSON_NAMESPACE::SizeType length,
+                bool) {
+      token->text.assign(s, length);
+      return Set(Kind::String);
+    }
+    bool Key(const char *s, CEREAL_RAPIDJSON_NAMESPACE::SizeType length, bool) {
+      token->text.assign(s, length);
+      return Set(Kind::Key);
+    }
+    bool StartObject() { return Set(Kind::StartObject); }
+    bool EndObject(CEREAL_RAPIDJSON_NAMESPACE::SizeType) {
+      return Set(Kind::EndObject);
+    }
+    bool StartArray() { return Set(Kind::StartArray); }
+    bool EndArray(CEREAL_RAPIDJSON_NAMESPACE::SizeType) {
+      return Set(Kind::EndArray);
+    }
+  };
+
+  static bool IsEnd(Kind kind) {
+    return kind == Kind::EndObject || kind == Kind::EndArray;
+  }
+
+  const Token &Peek() {
+    if (!m_hasToken) {
+      m_token.kind = Kind::None;
+      Handler handler{&m_token};
+      if (!m_reader.IterativeParseNext<CEREAL_RAPIDJSON_NAMESPACE::kParseDefaultFlags>(
+              m_stream, handler) ||
+          m_token.kind == Kind::None) {
+        const auto code = m_reader.HasParseError()
+                              ? m_reader.GetParseErrorCode()
+                              : CEREAL_RAPIDJSON_NAMESPACE::kParseErrorDocumentEmpty;
+        throw cereal::Exception(
+            std::string("JsonStreamInputArchive: parse error: ") +
+            CEREAL_RAPIDJSON_NAMESPACE::GetParseError_En(code) + " (offset " +
+            std::to_string(m_reader.GetErrorOffset()) + ")");
+      }
+      m_hasToken = true;
+    }
+    return m_token;
+  }
+
+  const Token &Take() {
+    Peek();
+    m_hasToken = false;
+    return m_token;
+  }
+
+  static const Token &Expect(const Token &token, Kind kind, const char *what) {
+    if (token.kind != kind) {
+      throw cereal::Exception(std::string("JsonStreamInputArchive: expected ") +
+                              what);
+    }
+    return token;
+  }
+
+  /// 跳过一个完整的值（标量或整个对象/数组）。
+  void SkipValue() {
+    int depth = 0;
+    do {
+      const Kind kind = Take().kind;
+      if (kind == Kind::StartObject || kind == Kind::StartArray) {
+        ++depth;
+      } else if (IsEnd(kind)) {
+        --depth;
+      }
+    } while (depth > 0);
+  }
+
+  /**
+   * @brief 定位到下一个值：对象内读取成员名，给定 NVP 名称时向后跳过
+   *        不匹配的成员。
+   */
+  void Search() {
+    const char *name = m_nextName;
+    m_nextName = nullptr;
+    if (m_frames.back() == Frame::Array) {
+      if (Peek().kind == Kind::EndArray) {
+        throw cereal::Exception("JsonStreamInputArchive: no more array elements");
+      }
+      return;
+    }
+    while (true) {
+      const Token &token = Peek();
+      if (token.kind == Kind::EndObject) {
+        throw cereal::Exception(
+            std::string("JsonStreamInputArchive: member ") +
+            (name ? std::string("(") + name + ") " : std::string()) +
+            "not found");
+      }
+      Expect(token, Kind::Key, "member name");
+      const bool match = !name || token.text == name;
+      Take();
+      if (match) {
+        return;
+      }
+      SkipValue();
+    }
+  }
+
+  std::vector<char> m_buffer;
+  ReadStream m_stream;
+  Reader m_reader;
+  Token m_token;
+  bool m_hasToken = false;
+  const char *m_nextName = nullptr;
+  std::vector<Frame> m_frames;
+  std::unordered_map<std::uint32_t, const Bindings *> m_bindings;
+};
+
+// ---------------------------------------------------------------------------
+// prologue / epilogue（与 cereal::JSONInputArchive 一致）
+// ---------------------------------------------------------------------------
+
+template <class T>
+void prologue(JsonStreamInputArchive &, cereal::NameValuePair<T> const &) {}
+template <class T>
+void epilogue(JsonStreamInputArchive &, cereal::NameValuePair<T> const &) {}
+
+template <class T>
+void prologue(JsonStreamInputArchive &, cereal::DeferredData<T> const &) {}
+template <class T>
+void epilogue(JsonStreamInputArchive &, cereal::DeferredData<T> const &) {}
+
+template <class T>
+void prologue(JsonStreamInputArchive &, cereal::SizeTag<T> const &) {}
+template <class T>
+void epilogue(JsonStreamInputArchive &, cereal::SizeTag<T> const &) {}
+
+template <class T,
+          cereal::traits::EnableIf<
+              !std::is_arithmetic<T>::value,
+              !cereal::traits::has_minimal_base_class_serialization<
+                  T, cereal::traits::has_minimal_input_serialization,
+                  JsonStreamInputArchive>::value,
+              !cereal::traits::has_minimal_input_serialization<
+                  T, JsonStreamInputArchive>::value> = cereal::traits::sfinae>
+void prologue(JsonStreamInputArchive &ar, T const &) {
+  ar.startNode();
+}
+
+template <class T,
+          cereal::traits::EnableIf<
+              !std::is_arithmetic<T>::value,
+              !cereal::traits::has_minimal_base_class_serialization<
+                  T, cereal::traits::has_minimal_input_serialization,
+                  JsonStreamInputArchive>::value,
+              !cereal::traits::has_minimal_input_serialization<
+                  T, JsonStreamInputArchive>::value> = cereal::traits::sfinae>
+void epilogue(JsonStreamInputArchive &ar, T const &) {
+  ar.finishNode();
+}
+
+inline void prologue(JsonStreamInputArchive &, std::nullptr_t const &) {}
+inline void epilogue(JsonStreamInputArchive &, std::nullptr_t const &) {}
+
+template <class T, cereal::traits::EnableIf<std::is_arithmetic<T>::value> =
+                       cereal::traits::sfinae>
+void prologue(JsonStreamInputArchive &, T const &) {}
+template <class T, cereal::traits::EnableIf<std::is_arithmetic<T>::value> =
+                       cereal::traits::sfinae>
+void epilogue(JsonStreamInputArchive &, T const &) {}
+
+template <class CharT, class Traits, class Alloc>
+void prologue(JsonStreamInputArchive &,
+              std::basic_string<CharT, Traits, Alloc> const &) {}
+template <class CharT, class Traits, class Alloc>
+void epilogue(JsonStreamInputArchive &,
+              std::basic_string<CharT, Traits, Alloc> const &) {}
+
+// ---------------------------------------------------------------------------
+// load
+// ---------------------------------------------------------------------------
+
+template <class T>
+void CEREAL_LOAD_FUNCTION_NAME(JsonStreamInputArchive &ar,
+                               cereal::NameValuePair<T> &t) {
+  ar.setNextName(t.name);
+  ar(t.value);
+}
+
+inline void CEREAL_LOAD_FUNCTION_NAME(JsonStreamInputArchive &ar,
+                                      std::nullptr_t &t) {
+  ar.loadValue(t);
+}
+
+template <class T, cereal::traits::EnableIf<std::is_arithmetic<T>::value> =
+                       cereal::traits::sfinae>
+void CEREAL_LOAD_FUNCTION_NAME(JsonStreamInputArchive &ar, T &t) {
+  ar.loadValue(t);
+}
+
+template <class CharT, class Traits, class Alloc>
+void CEREAL_LOAD_FUNCTION_NAME(JsonStreamInputArchive &ar,
+                               std::basic_string<CharT, Traits, Alloc> &str) {
+  ar.loadValue(str);
+}
+
+template <class T>
+void CEREAL_LOAD_FUNCTION_NAME(JsonStreamInputArchive &ar,
+                               cereal::SizeTag<T> &st) {
+  ar.loadSize(st.size);
+}
+
+/// 流式读取 vector：逐个追加元素直到数组结束。
+template <class T, class A>
+void CEREAL_LOAD_FUNCTION_NAME(JsonStreamInputArchive &ar,
+                               std::vector<T, A> &vector) {
+  vector.clear();
+  while (ar.HasMoreElements()) {
+    vector.emplace_back();
+    ar(vector.back());
+  }
+}
+
+template <class A>
+void CEREAL_LOAD_FUNCTION_NAME(JsonStreamInputArchive &ar,
+                               std::vector<bool, A> &vector) {
+  vector.clear();
+  while (ar.HasMoreElements()) {
+    bool value = false;
+    ar(value);
+    vector.push_back(value);
+  }
+}
+
+/// 多态 shared_ptr：类型绑定经 ResolvePolymorphicBinding 按 id 缓存。
+template <class T>
+typename std::enable_if<std::is_polymorphic<T>::value, void>::type
+CEREAL_LOAD_FUNCTION_NAME(JsonStreamInputArchive &ar, std::shared_ptr<T> &ptr) {
+  std::uint32_t nameid = 0;
+  ar(cereal::make_nvp("polymorphic_id", nameid));
+  if (nameid == 0) {
+    ptr.reset();
+    return;
+  }
+  if (cereal::polymorphic_detail::serialize_wrapper(ar, ptr, nameid)) {
+    return;
+  }
+  std::shared_ptr<void> result;
+  ar.ResolvePolymorphicBinding(nameid).shared_ptr(&ar, result, typeid(T));
+  ptr = std::static_pointer_cast<T>(result);
+}
+
+} // namespace CADExchange
+
+namespace cereal {
+namespace traits {
+namespace detail {
+// 只登记输入 → 输出方向；JSONOutputArchive 的反向映射仍指向 JSONInputArchive。
+template <> struct get_output_from_input<CADExchange::JsonStreamInputArchive> {
+  using type = JSONOutputArchive;
+};
+} // namespace detail
+} // namespace traits
+} // namespace cereal
+
+CEREAL_REGISTER_ARCHIVE(CADExchange::JsonStreamInputArchive)
@@ -0,0 +1,82 @@
+#include "LoadPipeline.h"
+
+#include <iostream>
+
+namespace CADExchange {
+
+bool ReportLoadValidation(const ValidationReport &report, std::string *errorMessage) {
+  for (const auto &w : report.warnings) {
+    std::cerr << "[CADSerializer][WARN] " << w << "\n";
+  }
+  if (!report.isValid) {
+    if (errorMessage) {
+      std::string msg = "Model validation failed after loading:";
+      for (const auto &e : report.errors) {
+        msg += "\n  " + e;
+      }
+      *errorMessage = msg;
+    }
+    return false;
+  }
+  return true;
+}
+
+LoadPipeline::LoadPipeline(const LoadOptions &options) : m_options(options) {}
+
+LoadPipeline::~LoadPipeline() = default;
+
+void LoadPipeline::Begin(UnitType sourceUnit) {
+  if (m_options.validate) {
+    m_session = std::make_unique<ValidationSession>(sourceUnit);
+  }
+  m_scaler.reset();
+  double factor = 1.0;
+  if (m_options.targetUnit && *m_options.targetUnit != sourceUnit &&
+      TryGetUnitConversionFactor(sourceUnit, *m_options.targetUnit, factor)) {
+    m_scaler = std::make_unique<FeatureUnitScaler>(factor);
+  }
+}
+
+void LoadPipeline::Accept(const std::shared_ptr<CFeatureBase> &feature) {
+  if (!feature) {
+    return;
+  }
+  if (m_session) {
+    m_session->Check(feature);
+  }
+  if (m_scaler) {
+    m_scaler->Scale(*feature);
+  }
+}
+
+bool LoadPipeline::Finish(UnifiedModel &model, std::string *errorMessage) {
+  std::optional<ValidationReport> report;
+  if (m_session) {
+    report = m_session->Finish();
+    m_session.reset();
+  }
+  if (m_scaler) {
+    // 校验结束后才缩放共享引用，失败时模型同样已完整换算。
+    m_scaler->Flush();
+    m_scaler.reset();
+    model.unit = *m_options.targetUnit;
+  }
+  if (report && !ReportLoadValidation(*report, errorMessage)) {
+    return false;
+  }
+  if (m_options.targetUnit) {
+    // 已逐特征换算时这里只清空 errorMessage；单位不受支持时由它报告同样的错误。
+    return ConvertModelUnit(model, *m_options.targetUnit, errorMessage);
+  }
+  return true;
+}
+
+bool LoadPipeline::Run(UnifiedModel &model, std::string *errorMessage) {
+  Begin(model.unit);
+  for (const auto &feature : model.GetFeatures()) {
+    Accept(feature);
+  }
+  return Finish(model, errorMessage);
+}
+
+} // namespace CADExchange
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../../core/UnifiedModel.h"
+#include "../validation/ModelValidator.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace CADExchange {
+
+class SerializerContext;
+
+/**
+ * @file LoadPipeline.h
+ * @brief 融合的加载流水线：解码、加载后校验与单位换算在一次特征遍历中完成。
+ */
+
+/**
+ * @brief LoadModel 的加载选项。
+ */
+struct LoadOptions {
+  /// 设置后结果换算到该单位，等价于加载成功后调用 ConvertModelUnit。
+  std::optional<UnitType> targetUnit;
+  /// 等价于 LoadModel 的加载后 Validate()；规则按文件中的原始单位执行。
+  bool validate = true;
+  /// 可选，TINYXML 加载复用其中的文档与缓冲区；其余格式忽略。
+  SerializerContext *context = nullptr;
+};
+
+/**
+ * @brief 输出加载后校验报告：warning 写入 stderr，有 error 时返回 false 并
+ *        写入 errorMessage。LoadModel 的各条路径共用同一格式。
+ */
+bool ReportLoadValidation(const ValidationReport &report, std::string *errorMessage);
+
+/**
+ * @class LoadPipeline
+ * @brief 逐特征执行加载后处理。
+ *
+ * 解码器在读到模型单位后调用 Begin()，每解码出一个特征（已加入模型）调用
+ * Accept()：先以原始单位执行该特征的校验规则，再缩放其点与长度，特征数据
+ * 只被访问一次。引用实体可能被多个特征共享（cereal 格式保留共享），整个
+ * 流水线共用一个 FeatureUnitScaler：每个引用只缩放一次，且推迟到 Finish()，
+ * 使后续特征仍以原始单位校验。Finish() 汇总校验报告并设置目标单位。
+ *
+ * 结果与报告同“LoadModel → ConvertModelUnit”分步执行一致；校验失败时模型
+ * 已换算到目标单位（unit 同步更新），内容仍自洽。
+ */
+class LoadPipeline {
+public:
+  explicit LoadPipeline(const LoadOptions &options);
+  ~LoadPipeline();
+
+  LoadPipeline(const LoadPipeline &) = delete;
+  LoadPipeline &operator=(const LoadPipeline &) = delete;
+
+  void Begin(UnitType sourceUnit);
+  void Accept(const std::shared_ptr<CFeatureBase> &feature);
+  bool Finish(UnifiedModel &model, std::string *errorMessage);
+
+  /// 对已完整加载的模型执行同样的处理（没有逐特征解码回调的格式使用）。
+  bool Run(UnifiedModel &model, std::string *errorMessage);
+
+private:
+  LoadOptions m_options;
+  std::unique_ptr<ValidationSession> m_session;
+  /// 源单位与目标单位不同且可换算时存在；不可换算时由 Finish() 报告。
+  std::unique_ptr<FeatureUnitScaler> m_scaler;
+};
+
+} // namespace CADExchange
@@ -0,0 +1,428 @@
+#include "CerealPrelude.h"
+#include "../../thirdParty/cereal/archives/portable_binary.hpp"
+#include "ModelCache.h"
+#include "AsyncSerializer.h"
+#include "BufferStream.h"
+#include "../../core/detail/IoHelpers.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+namespace CADExchange {
+
+namespace {
+
+constexpr char kMagic[4] = {'C', 'X', 'C', '1'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kHeaderBytes = 4 + 4 + 4 + 8 + 8;
+
+using detail::Fail;
+using detail::Fnv1a;
+using detail::PutLE;
+using detail::GetLE;
+using detail::ReadFile;
+
+/// 快照：magic | u32 version | u32 源格式 | u64 源字节数 | u64 源哈希 | 二进制模型。
+bool ReadSnapshot(const std::filesystem::path &path, SerializationFormat format,
+                  std::uint64_t sourceSize, std::uint64_t sourceHash,
+                  UnifiedModel &model) {
+  std::string data;
+  if (!ReadFile(path, data) || data.size() < kHeaderBytes ||
+      data.compare(0, 4, kMagic, 4) != 0 ||
+      GetLE<std::uint32_t>(data.data() + 4) != kVersion ||
+      GetLE<std::uint32_t>(data.data() + 8) != static_cast<std::uint32_t>(format) ||
+      GetLE<std::uint64_t>(data.data() + 12) != sourceSize ||
+      GetLE<std::uint64_t>(data.data() + 20) != sourceHash) {
+    return false;
+  }
+  RegisterSerializationTypes();
+  try {
+    MemorySourceBuf source(std::string_view(data).substr(kHeaderBytes));
+    std::istream input(&source);
+    cereal::PortableBinaryInputArchive archive(input);
+    load(archive, model);
+  } catch (const std::exception &ex) {
+    std::cerr << "[ModelCache][WARN] Ignoring unreadable snapshot "
+              << path.string() << ": " << ex.what() << "\n";
+    model.Clear();
+    return false;
+  }
+  return true;
+}
+
+void WriteSnapshot(const std::filesystem::path &path, SerializationFormat format,
+                   std::uint64_t sourceSize, std::uint64_t sourceHash,
+                   const UnifiedModel &model) {
+  std::string data;
+  data.append(kMagic, 4);
+  PutLE(data, kVersion);
+  PutLE(data, static_cast<std::uint32_t>(format));
+  PutLE(data, sourceSize);
+  PutLE(data, sourceHash);
+  RegisterSerializationTypes();
+  try {
+    StringSinkBuf sink(data);
+    std::ostream output(&sink);
+    cereal::PortableBinaryOutputArchive archive(output);
+    save(archive, model);
+  } catch (const std::exception &ex) {
+    std::cerr << "[ModelCache][WARN] Failed to encode snapshot: " << ex.what()
+              << "\n";
+    return;
+  }
+  // 快照只是加速手段：写不进去（只读目录等）时照常返回模型。
+  std::string error;
+  if (!WriteFileAtomically(path, data, false, &error)) {
+    std::cerr << "[ModelCache][WARN] " << error << "\n";
+  }
+}
+
+} // namespace
+
+#ifdef _WIN32
+
+namespace {
+bool StatFile(const std::string &path, std::uint64_t &size, std::int64_t &mtimeNs) {
+  std::error_code ec;
+  const std::filesystem::path p = std::filesystem::u8path(path);
+  size = std::filesystem::file_size(p, ec);
+  if (ec) {
+    return false;
+  }
+  const auto time = std::filesystem::last_write_time(p, ec);
+  if (ec) {
+    return false;
+  }
+  mtimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                time.time_since_epoch())
+                .count();
+  return true;
+}
+} // namespace
+
+#else
+
+namespace {
+bool StatFile(const std::string &path, std::uint64_t &size, std::int64_t &mtimeNs) {
+  struct stat st;
+  if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+    return false;
+  }
+  size = static_cast<std::uint64_t>(st.st_size);
+#ifdef __APPLE__
+  mtimeNs = static_cast<std::int64_t>(st.st_mtimespec.tv_sec) * 1000000000 +
+            st.st_mtimespec.tv_nsec;
+#else
+  mtimeNs = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 +
+            st.st_mtim.tv_nsec;
+#endif
+  return true;
+}
+} // namespace
+
+#endif
+
+ModelCache::ModelCache(ModelCacheOptions options) : m_options(options) {}
+
+ModelCache::~ModelCache() { CloseWatches(); }
+
+ModelCache &ModelCache::Instance() {
+  static ModelCache cache;
+  return cache;
+}
+
+std::filesystem::path ModelCache::SnapshotPathFor(const std::filesystem::path &filePath) {
+  std::filesystem::path snapshot = filePath;
+  snapshot += ".cxcache";
+  return snapshot;
+}
+
+std::string ModelCache::CanonicalKey(const std::filesystem::path &filePath) const {
+  // 规范化需逐级访问目录；已缓存条目的路径写法直接复用映射。
+  auto it = m_canonical.find(filePath.string());
+  if (it != m_canonical.end()) {
+    return it->second;
+  }
+  std::error_code ec;
+  auto canonical = std::filesystem::weakly_canonical(filePath, ec);
+  if (ec) {
+    canonical = std::filesystem::absolute(filePath, ec).lexically_normal();
+  }
+  return canonical.string();
+}
+
+void ModelCache::RememberAlias(EntryList::iterator it, std::string raw) {
+  if (m_canonical.emplace(raw, it->key).second) {
+    it->aliases.push_back(std::move(raw));
+  }
+}
+
+void ModelCache::Touch(EntryList::iterator it) {
+  m_lru.splice(m_lru.begin(), m_lru, it);
+}
+
+void ModelCache::Erase(EntryList::iterator it) {
+  // 条目移除后映射随之失效，符号链接改指向后下次加载会重新规范化。
+  for (const auto &alias : it->aliases) {
+    m_canonical.erase(alias);
+  }
+  m_bytes -= it->bytes;
+  m_index.erase(it->key);
+  m_lru.erase(it);
+}
+
+void ModelCache::EvictToBudget() {
+  while (m_bytes > m_options.byteBudget && !m_lru.empty()) {
+    Erase(std::prev(m_lru.end()));
+    ++m_stats.evictions;
+  }
+}
+
+std::shared_ptr<const UnifiedModel>
+ModelCache::Load(const std::filesystem::path &filePath, std::string *errorMessage,
+                 SerializationFormat format) {
+  std::string key;
+  ModelCacheOptions options;
+  std::shared_ptr<const UnifiedModel> stale;
+  std::uint64_t staleHash = 0;
+  bool watched = false;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    DrainEvents();
+    key = CanonicalKey(filePath);
+    options = m_options;
+    auto found = m_index.find(key);
+    if (found != m_index.end() && found->second->format == format) {
+      Entry &entry = *found->second;
+      FileStamp stamp;
+      // 受 inotify 监视的条目在事件到来前一直有效，无需 stat。
+      if ((entry.watched && m_inotifyFd >= 0) ||
+          (StatFile(key, stamp.size, stamp.mtimeNs) && stamp == entry.stamp)) {
+        RememberAlias(found->second, filePath.string());
+        Touch(found->second);
+        ++m_stats.hits;
+        return entry.model;
+      }
+      if (entry.hasHash) {
+        stale = entry.model;
+        staleHash = entry.contentHash;
+      }
+    }
+    // 先建立监视再读取文件，读取之后的修改一定会产生事件。
+    if (options.watchFiles) {
+      watched = WatchDirectory(key);
+    }
+  }
+
+  FileStamp stamp;
+  std::string data;
+  if (!StatFile(key, stamp.size, stamp.mtimeNs) || !ReadFile(key, data)) {
+    Fail(errorMessage, "Could not open input file.");
+    return nullptr;
+  }
+  const bool hashed = options.verifyContentHash || options.useSnapshots;
+  const std::uint64_t hash = hashed ? Fnv1a(data) : 0;
+
+  std::shared_ptr<const UnifiedModel> model;
+  bool fromSnapshot = false;
+  const bool unchanged = stale && options.verifyContentHash && hash == staleHash;
+  if (unchanged) {
+    model = stale; // 仅状态变化（touch、原样复制），内容未变
+  } else {
+    auto loaded = std::make_shared<UnifiedModel>();
+    const auto snapshotPath = SnapshotPathFor(std::filesystem::u8path(key));
+    if (options.useSnapshots &&
+        ReadSnapshot(snapshotPath, format, data.size(), hash, *loaded)) {
+      fromSnapshot = true;
+    } else {
+      if (!LoadModelFromBuffer(*loaded, data, errorMessage, format)) {
+        return nullptr;
+      }
+      if (options.useSnapshots) {
+        WriteSnapshot(snapshotPath, format, data.size(), hash, *loaded);
+      }
+    }
+    model = std::move(loaded);
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto found = m_index.find(key);
+  if (found != m_index.end()) {
+    if (found->second->model != model) {
+      ++m_stats.invalidations;
+    }
+    Erase(found->second);
+  }
+  if (fromSnapshot) {
+    ++m_stats.snapshotLoads;
+  }
+  if (unchanged) {
+    ++m_stats.hits;
+  } else {
+    ++m_stats.misses;
+  }
+  if (data.size() <= m_options.byteBudget) {
+    Entry entry;
+    entry.key = key;
+    entry.format = format;
+    entry.stamp = stamp;
+    entry.contentHash = hash;
+    entry.hasHash = hashed;
+    entry.watched = watched && m_inotifyFd >= 0;
+    entry.bytes = data.size();
+    entry.model = model;
+    m_lru.push_front(std::move(entry));
+    m_index[key] = m_lru.begin();
+    RememberAlias(m_lru.begin(), filePath.string());
+    m_bytes += data.size();
+    EvictToBudget();
+  }
+  return model;
+}
+
+void ModelCache::Invalidate(const std::filesystem::path &filePath) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto found = m_index.find(CanonicalKey(filePath));
+  if (found != m_index.end()) {
+    Erase(found->second);
+  }
+}
+
+void ModelCache::Clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_lru.clear();
+  m_index.clear();
+  m_canonical.clear();
+  m_bytes = 0;
+}
+
+void ModelCache::SetOptions(const ModelCacheOptions &options) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_options = options;
+  if (!options.watchFiles) {
+    CloseWatches();
+    for (auto &entry : m_lru) {
+      entry.watched = false;
+    }
+  }
+  EvictToBudget();
+}
+
+ModelCacheOptions ModelCache::GetOptions() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_options;
+}
+
+ModelCacheStats ModelCache::GetStats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ModelCacheStats stats = m_stats;
+  stats.entries = m_lru.size();
+  stats.bytes = m_bytes;
+  return stats;
+}
+
+#ifdef __linux__
+
+bool ModelCache::WatchDirectory(const std::string &key) {
+  const std::string dir = std::filesystem::path(key).parent_path().string();
+  if (m_dirWatches.count(dir)) {
+    return true;
+  }
+  if (m_inotifyFd < 0) {
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd < 0) {
+      return false;
+    }
+  }
+  // 监视目录而非文件：原子重命名替换文件时文件级监视会失效。
+  const int wd = inotify_add_watch(m_inotifyFd, dir.c_str(),
+                                   IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE |
+                                       IN_MOVED_TO | IN_MOVED_FROM |
+                                       IN_CREATE | IN_DELETE);
+  if (wd < 0) {
+    return false;
+  }
+  m_watchDirs[wd] = dir;
+  m_dirWatches[dir] = wd;
+  return true;
+}
+
+void ModelCache::DrainEvents() {
+  if (m_inotifyFd < 0) {
+    return;
+  }
+  alignas(inotify_event) char buffer[4096];
+  for (;;) {
+    const ssize_t n = ::read(m_inotifyFd, buffer, sizeof(buffer));
+    if (n <= 0) {
+      break;
+    }
+    for (ssize_t offset = 0; offset < n;) {
+      const auto *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+      offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+      if (event->mask & IN_Q_OVERFLOW) {
+        // 事件丢失：无法判断哪些文件变化，全部作废。
+        m_stats.invalidations += m_lru.size();
+        m_lru.clear();
+        m_index.clear();
+        m_canonical.clear();
+        m_bytes = 0;
+        continue;
+      }
+      auto dir = m_watchDirs.find(event->wd);
+      if (dir == m_watchDirs.end()) {
+        continue;
+      }
+      if (event->mask & IN_IGNORED) {
+        // 目录被删除或卸载：其下条目退回 stat 校验。
+        for (auto &entry : m_lru) {
+          if (std::filesystem::path(entry.key).parent_path() == dir->second) {
+            entry.watched = false;
+          }
+        }
+        m_dirWatches.erase(dir->second);
+        m_watchDirs.erase(dir);
+        continue;
+      }
+      if (event->len == 0) {
+        continue;
+      }
+      const auto changed =
+          (std::filesystem::path(dir->second) / event->name).string();
+      auto found = m_index.find(changed);
+      if (found != m_index.end()) {
+        Erase(found->second);
+        ++m_stats.invalidations;
+      }
+    }
+  }
+}
+
+void ModelCache::CloseWatches() {
+  if (m_inotifyFd >= 0) {
+    ::close(m_inotifyFd);
+    m_inotifyFd = -1;
+  }
+  m_watchDirs.clear();
+  m_dirWatches.clear();
+}
+
+#else
+
+bool ModelCache::WatchDirectory(const std::string &) { return false; }
+void ModelCache::DrainEvents() {}
+void ModelCache::CloseWatches() {}
+
+#endif
+
+} // namespace CADExchange
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "CADSerializer.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CADExchange {
+
+/**
+ * @file ModelCache.h
+ * @brief 进程级已加载模型缓存：按路径 + 文件状态复用解析结果。
+ *
+ * 条目以规范化路径为键，以 (字节数, 修改时间) 判断文件是否变化；可选地
+ * 在状态变化时比较内容哈希（只被 touch 的文件不会重新解析）。命中时直接
+ * 返回共享的只读模型，不再解析与校验。
+ *
+ * 可选的磁盘快照 `<file>.cxcache` 保存 cereal 可移植二进制编码的模型，
+ * 头部记录源文件字节数与 FNV-1a 哈希；冷启动时哈希一致即跳过源文件解析
+ * 与校验（快照只由校验通过的模型生成）。
+ */
+
+/**
+ * @brief ModelCache 的选项。
+ */
+struct ModelCacheOptions {
+  /// 缓存条目的总字节预算（以源文件字节数估算），超出时淘汰最久未用的条目。
+  std::size_t byteBudget = 256u << 20;
+  /// 文件状态变化时比较内容哈希，内容未变则继续使用缓存的模型。
+  bool verifyContentHash = false;
+  /// 读写 `<file>.cxcache` 二进制快照。
+  bool useSnapshots = false;
+  /// Linux 下用 inotify 监视所在目录，命中时不再 stat；其他平台忽略。
+  bool watchFiles = false;
+};
+
+/**
+ * @brief 缓存统计。
+ */
+struct ModelCacheStats {
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+  std::size_t snapshotLoads = 0; ///< 由二进制快照满足的未命中
+  std::size_t evictions = 0;
+  std::size_t invalidations = 0; ///< 因文件变化（stat 或 inotify）丢弃的条目
+  std::size_t entries = 0;
+  std::size_t bytes = 0;
+};
+
+/**
+ * @class ModelCache
+ * @brief LRU + 字节预算的模型缓存，线程安全。
+ *
+ * 返回的模型被所有调用方共享，必须视为只读。未命中时的读取与解析在锁外
+ * 进行；同一文件被并发首次加载时可能解析多次，以最后插入者为准。
+ */
+class ModelCache {
+public:
+  explicit ModelCache(ModelCacheOptions options = {});
+  ~ModelCache();
+
+  ModelCache(const ModelCache &) = delete;
+  ModelCache &operator=(const ModelCache &) = delete;
+
+  /// 进程级实例（默认选项，可通过 SetOptions 调整）。
+  static ModelCache &Instance();
+
+  /// 快照路径：`<file>.cxcache`。
+  static std::filesystem::path SnapshotPathFor(const std::filesystem::path &filePath);
+
+  /**
+   * @brief 返回 filePath 对应的模型，文件未变化时复用缓存。
+   *
+   * 未命中时按 LoadModelFromBuffer 的规则解析并校验。
+   *
+   * @return 失败时返回空指针并写入 errorMessage。
+   */
+  std::shared_ptr<const UnifiedModel>
+  Load(const std::filesystem::path &filePath, std::string *errorMessage = nullptr,
+       SerializationFormat format = SerializationFormat::TINYXML);
+
+  /// 丢弃单个文件的条目（不删除快照）。
+  void Invalidate(const std::filesystem::path &filePath);
+  void Clear();
+
+  /// 调整选项；预算变小时立即淘汰，关闭 watchFiles 时移除全部监视。
+  void SetOptions(const ModelCacheOptions &options);
+  ModelCacheOptions GetOptions() const;
+  ModelCacheStats GetStats() const;
+
+private:
+  struct FileStamp {
+    std::uint64_t size = 0;
+    std::int64_t mtimeNs = 0;
+    bool operator==(const FileStamp &other) const {
+      return size == other.size && mtimeNs == other.mtimeNs;
+    }
+  };
+
+  struct Entry {
+    std::string key;
+    SerializationFormat format = SerializationFormat::TINYXML;
+    FileStamp stamp;
+    std::uint64_t contentHash = 0;
+    bool hasHash = false;
+    bool watched = false; ///< 所在目录处于 inotify 监视下
+    std::size_t bytes = 0;
+    std::shared_ptr<const UnifiedModel> model;
+    std::vector<std::string> aliases; ///< 指向本条目的 m_canonical 原始路径
+  };
+
+  using EntryList = std::list<Entry>;
+
+  std::string CanonicalKey(const std::filesystem::path &filePath) const;
+  void RememberAlias(EntryList::iterator it, std::string raw);
+  void Touch(EntryList::iterator it);
+  void Erase(EntryList::iterator it);
+  void EvictToBudget();
+  bool WatchDirectory(const std::string &key);
+  void DrainEvents();
+  void CloseWatches();
+
+  mutable std::mutex m_mutex;
+  ModelCacheOptions m_options;
+  EntryList m_lru; ///< 头部为最近使用
+  std::unordered_map<std::string, EntryList::iterator> m_index;
+  /// 原始路径 → 规范化键；只保留仍有条目的映射，随条目移除而失效。
+  std::unordered_map<std::string, std::string> m_canonical;
+  std::size_t m_bytes = 0;
+  ModelCacheStats m_stats;
+
+  int m_inotifyFd = -1;
+  std::unordered_map<int, std::string> m_watchDirs; ///< wd → 目录
+  std::unordered_map<std::string, int> m_dirWatches;
+};
+
+} // namespace CADExchange
@@ -0,0 +1,347 @@
+#include "CerealPrelude.h"
+#include "../../thirdParty/cereal/archives/portable_binary.hpp"
+#include "ModelImage.h"
+#include "BufferStream.h"
+#include "../../core/detail/IoHelpers.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+
+namespace CADExchange {
+
+namespace {
+
+constexpr char kMagic[4] = {'C', 'X', 'M', 'I'};
+constexpr std::uint32_t kVersion = 1;
+
+struct Header {
+  char magic[4];
+  std::uint32_t version;
+  std::uint32_t unit;
+  std::uint32_t featureCount;
+  std::uint64_t imageBytes;
+  std::uint64_t recordsOffset;
+  std::uint64_t idIndexOffset;
+  std::uint64_t modelNameOffset;
+  std::uint32_t modelNameLength;
+  std::uint32_t reserved;
+};
+static_assert(sizeof(Header) == 56, "ModelImage header layout changed");
+
+using detail::Fail;
+
+std::size_t AlignUp(std::size_t value) { return (value + 7) & ~std::size_t(7); }
+
+template <typename T> void Store(std::string &image, std::size_t offset, const T &value) {
+  std::memcpy(image.data() + offset, &value, sizeof(T));
+}
+
+template <typename T> T Load(const char *data) {
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+bool InRange(std::uint64_t offset, std::uint64_t length, std::uint64_t size) {
+  return offset <= size && length <= size - offset;
+}
+
+std::shared_ptr<CFeatureBase> DecodePayload(std::string_view payload) {
+  RegisterSerializationTypes();
+  std::shared_ptr<CFeatureBase> feature;
+  try {
+    MemorySourceBuf source(payload);
+    std::istream input(&source);
+    cereal::PortableBinaryInputArchive archive(input);
+    archive(cereal::make_nvp("Feature", feature));
+  } catch (const std::exception &ex) {
+    std::cerr << "[ModelImage][WARN] Failed to decode feature: " << ex.what() << "\n";
+    return nullptr;
+  }
+  return feature;
+}
+
+} // namespace
+
+struct ModelImageView::Record {
+  std::uint64_t idOffset;
+  std::uint64_t nameOffset;
+  std::uint64_t payloadOffset;
+  std::uint32_t idLength;
+  std::uint32_t nameLength;
+  std::uint32_t payloadLength;
+  std::uint16_t featureType;
+  std::uint8_t suppressed;
+  std::uint8_t reserved;
+};
+
+bool BuildModelImage(const UnifiedModel &model, std::string &image,
+                     std::string *errorMessage) {
+  using Record = ModelImageView::Record;
+  static_assert(sizeof(Record) == 40, "ModelImage record layout changed");
+  const auto &features = model.GetFeatures();
+  const std::size_t count = features.size();
+  if (count > UINT32_MAX) {
+    return Fail(errorMessage, "Model has too many features for an image.");
+  }
+
+  const std::size_t recordsOffset = sizeof(Header);
+  const std::size_t idIndexOffset = recordsOffset + count * sizeof(Record);
+  std::size_t stringsOffset = AlignUp(idIndexOffset + count * sizeof(std::uint32_t));
+  std::size_t stringBytes = model.modelName.size();
+  for (const auto &feature : features) {
+    if (!feature) {
+      return Fail(errorMessage, "Model contains a null feature.");
+    }
+    stringBytes += feature->featureID.size() + feature->featureName.size();
+  }
+
+  image.clear();
+  image.resize(AlignUp(stringsOffset + stringBytes));
+
+  Header header{};
+  std::memcpy(header.magic, kMagic, 4);
+  header.version = kVersion;
+  header.unit = static_cast<std::uint32_t>(model.unit);
+  header.featureCount = static_cast<std::uint32_t>(count);
+  header.recordsOffset = recordsOffset;
+  header.idIndexOffset = idIndexOffset;
+
+  std::size_t cursor = stringsOffset;
+  auto putString = [&](const std::string &value) {
+    std::memcpy(image.data() + cursor, value.data(), value.size());
+    const std::size_t offset = cursor;
+    cursor += value.size();
+    return offset;
+  };
+  header.modelNameOffset = putString(model.modelName);
+  header.modelNameLength = static_cast<std::uint32_t>(model.modelName.size());
+
+  std::vector<Record> records(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto &feature = features[i];
+    Record &record = records[i];
+    record = Record{};
+    record.idOffset = putString(feature->featureID);
+    record.idLength = static_cast<std::uint32_t>(feature->featureID.size());
+    record.nameOffset = putString(feature->featureName);
+    record.nameLength = static_cast<std::uint32_t>(feature->featureName.size());
+    record.featureType = static_cast<std::uint16_t>(feature->featureType);
+    record.suppressed = feature->isSuppressed ? 1 : 0;
+  }
+
+  // 负载直接追加在镜像尾部，省去中间缓冲。
+  RegisterSerializationTypes();
+  try {
+    StringSinkBuf sink(image);
+    std::ostream output(&sink);
+    for (std::size_t i = 0; i < count; ++i) {
+      const std::size_t begin = image.size();
+      {
+        cereal::PortableBinaryOutputArchive archive(output);
+        archive(cereal::make_nvp("Feature", features[i]));
+      }
+      output.flush();
+      if (image.size() - begin > UINT32_MAX) {
+        return Fail(errorMessage, "Feature " + features[i]->featureID +
+                                      " is too large for an image.");
+      }
+      records[i].payloadOffset = begin;
+      records[i].payloadLength = static_cast<std::uint32_t>(image.size() - begin);
+    }
+  } catch (const std::exception &ex) {
+    return Fail(errorMessage, std::string("Failed to encode model image: ") + ex.what());
+  }
+
+  std::vector<std::uint32_t> order(count);
+  std::iota(order.begin(), order.end(), 0u);
+  std::sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+    return features[a]->featureID < features[b]->featureID;
+  });
+
+  header.imageBytes = image.size();
+  Store(image, 0, header);
+  if (count > 0) {
+    std::memcpy(image.data() + recordsOffset, records.data(), count * sizeof(Record));
+    std::memcpy(image.data() + idIndexOffset, order.data(),
+                count * sizeof(std::uint32_t));
+  }
+  return true;
+}
+
+std::shared_ptr<const ModelImageView>
+ModelImageView::Open(std::string_view image, std::string *errorMessage,
+                     std::shared_ptr<const void> keepAlive) {
+  auto fail = [&](const std::string &message) {
+    Fail(errorMessage, message);
+    return std::shared_ptr<const ModelImageView>();
+  };
+  if (image.size() < sizeof(Header)) {
+    return fail("Model image is truncated.");
+  }
+  const auto header = Load<Header>(image.data());
+  if (std::memcmp(header.magic, kMagic, 4) != 0) {
+    return fail("Not a model image.");
+  }
+  if (header.version != kVersion) {
+    return fail("Unsupported model image version " + std::to_string(header.version) +
+                ".");
+  }
+  const std::uint64_t size = image.size();
+  const std::uint64_t count = header.featureCount;
+  if (header.imageBytes != size ||
+      !InRange(header.recordsOffset, count * sizeof(Record), size) ||
+      !InRange(header.idIndexOffset, count * sizeof(std::uint32_t), size) ||
+      !InRange(header.modelNameOffset, header.modelNameLength, size)) {
+    return fail("Model image is corrupt.");
+  }
+
+  std::shared_ptr<ModelImageView> view(new ModelImageView());
+  view->m_image = image;
+  view->m_keepAlive = std::move(keepAlive);
+  view->m_unit = static_cast<UnitType>(header.unit);
+  view->m_featureCount = header.featureCount;
+  view->m_records = image.data() + header.recordsOffset;
+  view->m_idIndex = image.data() + header.idIndexOffset;
+  view->m_nameOffset = header.modelNameOffset;
+  view->m_nameLength = header.modelNameLength;
+
+  // 一次性检查所有偏移，之后的访问不再做边界判断。
+  for (std::uint32_t i = 0; i < header.featureCount; ++i) {
+    const Record record = view->RecordAt(static_cast<int>(i));
+    const auto slot =
+        Load<std::uint32_t>(view->m_idIndex + i * sizeof(std::uint32_t));
+    if (!InRange(record.idOffset, record.idLength, size) ||
+        !InRange(record.nameOffset, record.nameLength, size) ||
+        !InRange(record.payloadOffset, record.payloadLength, size) ||
+        slot >= header.featureCount) {
+      return fail("Model image is corrupt.");
+    }
+  }
+  view->m_decoded.resize(header.featureCount);
+  return view;
+}
+
+ModelImageView::Record ModelImageView::RecordAt(int index) const {
+  return Load<Record>(m_records + static_cast<std::size_t>(index) * sizeof(Record));
+}
+
+std::string_view ModelImageView::StringAt(std::uint64_t offset,
+                                          std::uint32_t length) const {
+  return m_image.substr(static_cast<std::size_t>(offset), length);
+}
+
+std::string_view ModelImageView::ModelName() const {
+  return StringAt(m_nameOffset, m_nameLength);
+}
+
+std::string_view ModelImageView::FeatureID(int index) const {
+  const Record record = RecordAt(index);
+  return StringAt(record.idOffset, record.idLength);
+}
+
+std::string_view ModelImageView::FeatureName(int index) const {
+  const Record record = RecordAt(index);
+  return StringAt(record.nameOffset, record.nameLength);
+}
+
+FeatureType ModelImageView::GetFeatureType(int index) const {
+  return static_cast<FeatureType>(RecordAt(index).featureType);
+}
+
+bool ModelImageView::IsSuppressed(int index) const {
+  return RecordAt(index).suppressed != 0;
+}
+
+int ModelImageView::FindFeature(std::string_view featureID) const {
+  std::uint32_t lo = 0;
+  std::uint32_t hi = m_featureCount;
+  while (lo < hi) {
+    const std::uint32_t mid = lo + (hi - lo) / 2;
+    const auto slot = Load<std::uint32_t>(m_idIndex + mid * sizeof(std::uint32_t));
+    const int cmp = FeatureID(static_cast<int>(slot)).compare(featureID);
+    if (cmp == 0) {
+      return static_cast<int>(slot);
+    }
+    if (cmp < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return -1;
+}
+
+std::shared_ptr<const CFeatureBase> ModelImageView::DecodeFeature(int index) const {
+  if (index < 0 || index >= GetFeatureCount()) {
+    return nullptr;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_decodeMutex);
+    if (m_decoded[index]) {
+      return m_decoded[index];
+    }
+  }
+  const Record record = RecordAt(index);
+  std::shared_ptr<const CFeatureBase> feature =
+      DecodePayload(StringAt(record.payloadOffset, record.payloadLength));
+  if (!feature) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(m_decodeMutex);
+  if (!m_decoded[index]) {
+    m_decoded[index] = std::move(feature);
+  }
+  return m_decoded[index];
+}
+
+std::shared_ptr<Accessor::FeatureAccessorBase>
+ModelImageView::GetFeature(int index) const {
+  auto feature = DecodeFeature(index);
+  if (!feature) {
+    return nullptr;
+  }
+  return std::make_shared<Accessor::FeatureAccessorBase>(std::move(feature));
+}
+
+std::shared_ptr<Accessor::FeatureAccessorBase>
+ModelImageView::GetFeatureByID(const std::string &featureID) const {
+  const int index = FindFeature(featureID);
+  return index < 0 ? nullptr : GetFeature(index);
+}
+
+std::vector<std::shared_ptr<Accessor::FeatureAccessorBase>>
+ModelImageView::GetAllFeatures() const {
+  std::vector<std::shared_ptr<Accessor::FeatureAccessorBase>> result;
+  result.reserve(m_featureCount);
+  for (int i = 0; i < GetFeatureCount(); ++i) {
+    if (auto feature = GetFeature(i)) {
+      result.push_back(std::move(feature));
+    }
+  }
+  return result;
+}
+
+bool ModelImageView::ToModel(UnifiedModel &model, std::string *errorMessage) const {
+  // 独立解码而非复用缓存，调用方可以自由修改结果。
+  std::vector<std::shared_ptr<CFeatureBase>> features;
+  features.reserve(m_featureCount);
+  for (int i = 0; i < GetFeatureCount(); ++i) {
+    const Record record = RecordAt(i);
+    auto feature = DecodePayload(StringAt(record.payloadOffset, record.payloadLength));
+    if (!feature) {
+      return Fail(errorMessage,
+                  "Failed to decode feature " + std::string(FeatureID(i)) + ".");
+    }
+    features.push_back(std::move(feature));
+  }
+  model.Clear();
+  model.unit = m_unit;
+  model.modelName = std::string(ModelName());
+  model.AddFeatures(features);
+  return true;
+}
+
+} // namespace CADExchange
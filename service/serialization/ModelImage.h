@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../../core/UnifiedModel.h"
+#include "../accessors/FeatureAccessorBase.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CADExchange {
+
+/**
+ * @file ModelImage.h
+ * @brief 可重定位的扁平模型镜像：一整块连续字节，内部只用相对偏移。
+ *
+ * 镜像可以被原样复制到任意地址（共享内存、文件映射、网络缓冲区）后直接
+ * 读取。布局（本机字节序，仅用于本机进程间交换）：
+ *
+ *   头部 | 特征记录表 | 按 ID 排序的索引 | 字符串区 | 特征负载区
+ *
+ * 单位、模型名以及每个特征的 ID、名称、类型、抑制状态可以零拷贝读取；
+ * 特征的完整内容以 cereal 可移植二进制逐个编码，只在首次访问该特征时解码。
+ */
+
+/**
+ * @brief 把模型编码为扁平镜像，覆盖 image 原有内容（保留容量）。
+ */
+bool BuildModelImage(const UnifiedModel &model, std::string &image,
+                     std::string *errorMessage = nullptr);
+
+/**
+ * @class ModelImageView
+ * @brief 扁平镜像上的只读视图，接口与 Accessor::ModelAccessor 对齐。
+ *
+ * Open() 只做一次 O(n) 的边界检查，不分配特征对象；其后的元数据查询都直接
+ * 读取镜像字节。GetFeature 系列在首次访问时解码对应特征并缓存，线程安全。
+ *
+ * 视图不拥有镜像字节：调用方通过 keepAlive 保证其生命周期（例如共享内存
+ * 映射与读者计数）。
+ */
+class ModelImageView {
+public:
+  /**
+   * @brief 校验镜像并创建视图。
+   *
+   * @return 镜像损坏或版本不符时返回空指针并写入 errorMessage。
+   */
+  static std::shared_ptr<const ModelImageView>
+  Open(std::string_view image, std::string *errorMessage = nullptr,
+       std::shared_ptr<const void> keepAlive = nullptr);
+
+  UnitType Unit() const { return m_unit; }
+  std::string_view ModelName() const;
+  std::string_view Bytes() const { return m_image; }
+
+  // --- 与 ModelAccessor 一致的访问入口 ---
+  bool IsValid() const { return m_featureCount > 0; }
+  int GetFeatureCount() const { return static_cast<int>(m_featureCount); }
+  std::shared_ptr<Accessor::FeatureAccessorBase> GetFeature(int index) const;
+  std::shared_ptr<Accessor::FeatureAccessorBase>
+  GetFeatureByID(const std::string &featureID) const;
+  std::vector<std::shared_ptr<Accessor::FeatureAccessorBase>> GetAllFeatures() const;
+
+  // --- 零拷贝元数据（index 须在 [0, GetFeatureCount()) 内） ---
+  std::string_view FeatureID(int index) const;
+  std::string_view FeatureName(int index) const;
+  FeatureType GetFeatureType(int index) const;
+  bool IsSuppressed(int index) const;
+
+  /// 按 ID 二分查找特征下标，找不到返回 -1。
+  int FindFeature(std::string_view featureID) const;
+
+  /// 解码（或取缓存的）单个特征；负载损坏时返回空指针。
+  std::shared_ptr<const CFeatureBase> DecodeFeature(int index) const;
+
+  /// 解码全部特征，得到可修改的独立模型。
+  bool ToModel(UnifiedModel &model, std::string *errorMessage = nullptr) const;
+
+private:
+  struct Record;
+  friend bool BuildModelImage(const UnifiedModel &, std::string &, std::string *);
+
+  ModelImageView() = default;
+  Record RecordAt(int index) const;
+  std::string_view StringAt(std::uint64_t offset, std::uint32_t length) const;
+
+  std::string_view m_image;
+  std::shared_ptr<const void> m_keepAlive;
+  UnitType m_unit = UnitType::MILLIMETER;
+  std::uint32_t m_featureCount = 0;
+  std::uint64_t m_nameOffset = 0;
+  std::uint32_t m_nameLength = 0;
+  const char *m_records = nullptr;
+  const char *m_idIndex = nullptr;
+
+  mutable std::mutex m_decodeMutex;
+  mutable std::vector<std::shared_ptr<const CFeatureBase>> m_decoded;
+};
+
+} // namespace CADExchange
@@ -0,0 +1,342 @@
+#include "ModelJournal.h"
+#include "AsyncSerializer.h"
+#include "BufferStream.h"
+#include "../../core/detail/IoHelpers.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace CADExchange {
+
+namespace {
+
+constexpr char kMagic[4] = {'C', 'X', 'J', '1'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kHeaderBytes = 4 + 4 + 8 + 8;
+constexpr std::size_t kRecordHeaderBytes = 4 + 4 + 1;
+constexpr std::uint8_t kUpsert = 1;
+constexpr std::uint8_t kRemove = 2;
+
+using detail::Fail;
+using detail::Fnv1a;
+using detail::PutLE;
+using detail::GetLE;
+using detail::ReadFile;
+
+constexpr std::array<std::uint32_t, 256> MakeCrcTable() {
+  std::array<std::uint32_t, 256> table{};
+  for (std::uint32_t i = 0; i < 256; ++i) {
+    std::uint32_t c = i;
+    for (int k = 0; k < 8; ++k) {
+      c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+    }
+    table[i] = c;
+  }
+  return table;
+}
+
+constexpr auto kCrcTable = MakeCrcTable();
+
+std::uint32_t Crc32(std::uint8_t type, const char *data, std::size_t size) {
+  std::uint32_t crc = 0xFFFFFFFFu;
+  crc = kCrcTable[(crc ^ type) & 0xFFu] ^ (crc >> 8);
+  for (std::size_t i = 0; i < size; ++i) {
+    crc = kCrcTable[(crc ^ static_cast<unsigned char>(data[i])) & 0xFFu] ^
+          (crc >> 8);
+  }
+  return crc ^ 0xFFFFFFFFu;
+}
+
+bool SyncFile(std::FILE *file) {
+#ifdef _WIN32
+  return _commit(_fileno(file)) == 0;
+#else
+  return ::fsync(fileno(file)) == 0;
+#endif
+}
+
+bool DecodeSnapshot(SerializationFormat format, std::string_view data,
+                    UnifiedModel &model, std::string *errorMessage) {
+  switch (format) {
+  case SerializationFormat::TINYXML:
+    return TinyXMLSerializer::LoadFromBuffer(model, data, errorMessage);
+  case SerializationFormat::CEREAL_JSON:
+    return CerealJsonSerializer::LoadFromBuffer(model, data, errorMessage);
+  default: {
+    MemorySourceBuf source(data);
+    std::istream input(&source);
+    return detail::LoadCerealXml(model, input, errorMessage);
+  }
+  }
+}
+
+/// 回放期间的特征表：upsert 原位替换或追加，remove 置空，最后一次性写回。
+class ReplayState {
+public:
+  explicit ReplayState(const UnifiedModel &model)
+      : m_features(model.GetFeatures()) {
+    m_index.reserve(m_features.size());
+    for (std::size_t i = 0; i < m_features.size(); ++i) {
+      m_index[m_features[i]->featureID] = i;
+    }
+  }
+
+  void Upsert(const std::shared_ptr<CFeatureBase> &feature) {
+    auto [it, inserted] =
+        m_index.emplace(feature->featureID, m_features.size());
+    if (inserted) {
+      m_features.push_back(feature);
+    } else {
+      m_features[it->second] = feature;
+    }
+  }
+
+  void Remove(const std::string &featureID) {
+    if (auto it = m_index.find(featureID); it != m_index.end()) {
+      m_features[it->second] = nullptr;
+      m_index.erase(it);
+    }
+  }
+
+  void ApplyTo(UnifiedModel &model) const {
+    model.Clear();
+    model.AddFeatures(m_features);
+  }
+
+private:
+  std::vector<std::shared_ptr<CFeatureBase>> m_features;
+  std::unordered_map<std::string, std::size_t> m_index;
+};
+
+} // namespace
+
+ModelJournal::ModelJournal(std::filesystem::path snapshotPath,
+                           ModelJournalOptions options)
+    : m_snapshotPath(std::move(snapshotPath)),
+      m_journalPath(JournalPathFor(m_snapshotPath)), m_options(options) {}
+
+ModelJournal::~ModelJournal() { CloseJournal(); }
+
+std::filesystem::path
+ModelJournal::JournalPathFor(const std::filesystem::path &snapshotPath) {
+  std::filesystem::path journal = snapshotPath;
+  journal += ".journal";
+  return journal;
+}
+
+void ModelJournal::CloseJournal() {
+  if (m_file) {
+    std::fclose(m_file);
+    m_file = nullptr;
+  }
+}
+
+bool ModelJournal::Open(UnifiedModel &model, std::string *errorMessage) {
+  CloseJournal();
+  m_journalBytes = 0;
+  m_replayedRecords = 0;
+  m_discardedBytes = 0;
+
+  std::string snapshot;
+  if (std::filesystem::exists(m_snapshotPath)) {
+    if (!ReadFile(m_snapshotPath, snapshot)) {
+      return Fail(errorMessage, "Could not read snapshot: " + m_snapshotPath.string());
+    }
+    if (!DecodeSnapshot(m_options.snapshotFormat, snapshot, model, errorMessage)) {
+      return false;
+    }
+  } else {
+    model.Clear();
+  }
+  m_snapshotBytes = snapshot.size();
+  m_snapshotHash = Fnv1a(snapshot);
+
+  std::string journal;
+  bool reuseJournal = false;
+  std::size_t goodBytes = 0;
+  if (std::filesystem::exists(m_journalPath)) {
+    if (!ReadFile(m_journalPath, journal)) {
+      return Fail(errorMessage, "Could not read journal: " + m_journalPath.string());
+    }
+    const char *data = journal.data();
+    const bool headerOk =
+        journal.size() >= kHeaderBytes &&
+        std::equal(kMagic, kMagic + 4, data) &&
+        GetLE<std::uint32_t>(data + 4) == kVersion;
+    if (!headerOk) {
+      std::cerr << "[ModelJournal][WARN] Invalid journal header, discarding "
+                << m_journalPath.string() << "\n";
+    } else if (GetLE<std::uint64_t>(data + 8) != m_snapshotBytes ||
+               GetLE<std::uint64_t>(data + 16) != m_snapshotHash) {
+      std::cerr << "[ModelJournal][WARN] Journal does not match snapshot "
+                   "(already compacted), discarding "
+                << m_journalPath.string() << "\n";
+    } else {
+      reuseJournal = true;
+    }
+  }
+
+  if (reuseJournal) {
+    ReplayState state(model);
+    std::size_t offset = kHeaderBytes;
+    while (offset + kRecordHeaderBytes <= journal.size()) {
+      const char *record = journal.data() + offset;
+      const auto length = GetLE<std::uint32_t>(record);
+      const auto crc = GetLE<std::uint32_t>(record + 4);
+      const auto type = static_cast<std::uint8_t>(record[8]);
+      if (length > journal.size() - offset - kRecordHeaderBytes) {
+        break; // 尾部记录被截断
+      }
+      const char *payload = record + kRecordHeaderBytes;
+      if (Crc32(type, payload, length) != crc) {
+        break; // 写入中断或损坏
+      }
+      if (type == kUpsert) {
+        UnifiedModel single;
+        std::string featureError;
+        if (!CerealJsonSerializer::LoadFromBuffer(
+                single, std::string_view(payload, length), &featureError) ||
+            single.GetFeatures().size() != 1) {
+          return Fail(errorMessage, "Journal record at offset " +
+                                        std::to_string(offset) +
+                                        " could not be decoded: " + featureError);
+        }
+        state.Upsert(single.GetFeatures().front());
+      } else if (type == kRemove) {
+        state.Remove(std::string(payload, length));
+      } else {
+        return Fail(errorMessage, "Journal record at offset " +
+                                      std::to_string(offset) +
+                                      " has unknown type " + std::to_string(type));
+      }
+      offset += kRecordHeaderBytes + length;
+      ++m_replayedRecords;
+    }
+    goodBytes = offset;
+    if (m_replayedRecords > 0) {
+      state.ApplyTo(model);
+    }
+    if (goodBytes < journal.size()) {
+      m_discardedBytes = journal.size() - goodBytes;
+      std::cerr << "[ModelJournal][WARN] Truncating " << m_discardedBytes
+                << " bytes of incomplete journal tail.\n";
+      std::error_code ec;
+      std::filesystem::resize_file(m_journalPath, goodBytes, ec);
+      if (ec) {
+        return Fail(errorMessage, "Could not truncate journal: " + ec.message());
+      }
+    }
+    m_file = std::fopen(m_journalPath.string().c_str(), "ab");
+    if (!m_file) {
+      return Fail(errorMessage, "Could not open journal: " + m_journalPath.string());
+    }
+    m_journalBytes = goodBytes;
+  } else if (!ResetJournal(errorMessage)) {
+    return false;
+  }
+
+  // 回放后统一校验，规则同 LoadModel。
+  if (!detail::ValidateAfterLoad(model, errorMessage)) {
+    CloseJournal();
+    return false;
+  }
+  return true;
+}
+
+bool ModelJournal::ResetJournal(std::string *errorMessage) {
+  CloseJournal();
+  m_file = std::fopen(m_journalPath.string().c_str(), "wb");
+  if (!m_file) {
+    return Fail(errorMessage, "Could not create journal: " + m_journalPath.string());
+  }
+  std::string header(kMagic, 4);
+  PutLE<std::uint32_t>(header, kVersion);
+  PutLE<std::uint64_t>(header, m_snapshotBytes);
+  PutLE<std::uint64_t>(header, m_snapshotHash);
+  if (std::fwrite(header.data(), 1, header.size(), m_file) != header.size() ||
+      std::fflush(m_file) != 0 ||
+      (m_options.syncEachRecord && !SyncFile(m_file))) {
+    CloseJournal();
+    return Fail(errorMessage, "Failed to write journal header.");
+  }
+  m_journalBytes = header.size();
+  return true;
+}
+
+bool ModelJournal::AppendRecord(std::uint8_t type, const std::string &payload,
+                                std::string *errorMessage) {
+  if (!m_file) {
+    return Fail(errorMessage, "Journal is not open.");
+  }
+  std::string header;
+  PutLE<std::uint32_t>(header, static_cast<std::uint32_t>(payload.size()));
+  PutLE<std::uint32_t>(header, Crc32(type, payload.data(), payload.size()));
+  header.push_back(static_cast<char>(type));
+  if (std::fwrite(header.data(), 1, header.size(), m_file) != header.size() ||
+      std::fwrite(payload.data(), 1, payload.size(), m_file) != payload.size() ||
+      std::fflush(m_file) != 0 ||
+      (m_options.syncEachRecord && !SyncFile(m_file))) {
+    return Fail(errorMessage, "Failed to append journal record.");
+  }
+  m_journalBytes += header.size() + payload.size();
+  return true;
+}
+
+bool ModelJournal::RecordUpsert(const std::shared_ptr<CFeatureBase> &feature,
+                                std::string *errorMessage) {
+  if (!feature) {
+    return Fail(errorMessage, "RecordUpsert: feature is null.");
+  }
+  UnifiedModel single;
+  single.AddFeature(feature);
+  if (!CerealJsonSerializer::SaveToBuffer(single, m_scratch, errorMessage)) {
+    return false;
+  }
+  return AppendRecord(kUpsert, m_scratch, errorMessage);
+}
+
+bool ModelJournal::RecordRemove(const std::string &featureID,
+                                std::string *errorMessage) {
+  return AppendRecord(kRemove, featureID, errorMessage);
+}
+
+bool ModelJournal::NeedsCompaction() const {
+  const std::uint64_t records = m_journalBytes > kHeaderBytes
+                                    ? m_journalBytes - kHeaderBytes
+                                    : 0;
+  return records >= m_options.minCompactionBytes &&
+         static_cast<double>(records) >
+             static_cast<double>(m_snapshotBytes) * m_options.compactionRatio;
+}
+
+bool ModelJournal::Compact(const UnifiedModel &model, std::string *errorMessage) {
+  if (!SaveModelToBuffer(model, m_scratch, errorMessage,
+                         m_options.snapshotFormat)) {
+    return false;
+  }
+  if (!WriteFileAtomically(m_snapshotPath, m_scratch, true, errorMessage)) {
+    return false;
+  }
+  // 快照已替换：即使此后崩溃，旧日志也会因指纹不匹配而被忽略。
+  m_snapshotBytes = m_scratch.size();
+  m_snapshotHash = Fnv1a(m_scratch);
+  return ResetJournal(errorMessage);
+}
+
+bool ModelJournal::CompactIfNeeded(const UnifiedModel &model,
+                                   std::string *errorMessage) {
+  return !NeedsCompaction() || Compact(model, errorMessage);
+}
+
+} // namespace CADExchange
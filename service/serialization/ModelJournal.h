@@ -0,0 +1,126 @@
+#pragma once
+
+#include "CADSerializer.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace CADExchange {
+
+/**
+ * @file ModelJournal.h
+ * @brief 快照 + 追加式变更日志的增量模型持久化。
+ *
+ * 快照为任一 SerializationFormat 的完整模型文件；同目录的
+ * `<snapshot>.journal` 追加记录特征级变更，每次变更写一条记录并立即
+ * flush，无需重写整个快照。
+ *
+ * 日志文件格式（整数均为小端）：
+ *   头部：magic "CXJ1" | u32 version | u64 快照字节数 | u64 快照 FNV-1a 哈希
+ *   记录：u32 payload 长度 | u32 CRC32(type + payload) | u8 type | payload
+ * type 为 1（upsert，payload 为仅含该特征的 CEREAL_JSON 模型）或
+ * 2（remove，payload 为特征 ID）。
+ *
+ * 头部记录日志所基于的快照指纹；快照被替换而日志未被截断时（例如压缩
+ * 中途崩溃），指纹不匹配的日志被整体忽略。尾部记录不完整或校验失败时
+ * 视为写入中断，回放到最后一条完整记录并截掉其余部分。
+ */
+
+/**
+ * @brief ModelJournal 的选项。
+ */
+struct ModelJournalOptions {
+  SerializationFormat snapshotFormat = SerializationFormat::TINYXML;
+  /// 每条记录 flush 后再 fsync；关闭时只保证进程崩溃不丢记录。
+  bool syncEachRecord = false;
+  /// 日志字节数超过 快照字节数 × compactionRatio 时建议压缩。
+  double compactionRatio = 0.5;
+  /// 日志小于此字节数时不建议压缩（避免小模型频繁重写快照）。
+  std::uint64_t minCompactionBytes = 1u << 20;
+};
+
+/**
+ * @class ModelJournal
+ * @brief 管理一个快照文件及其变更日志。
+ *
+ * 典型流程：Open() 读取快照并回放日志 → 每次编辑后 RecordUpsert /
+ * RecordRemove → NeedsCompaction() 为真时 Compact(model)。
+ * Upsert 对已存在的 ID 原位替换，否则追加到末尾；remove 删除该 ID。
+ * 本类不是线程安全的。
+ */
+class ModelJournal {
+public:
+  explicit ModelJournal(std::filesystem::path snapshotPath,
+                        ModelJournalOptions options = {});
+  ~ModelJournal();
+
+  ModelJournal(const ModelJournal &) = delete;
+  ModelJournal &operator=(const ModelJournal &) = delete;
+
+  /// 快照对应的日志路径：`<snapshot>.journal`。
+  static std::filesystem::path JournalPathFor(const std::filesystem::path &snapshotPath);
+
+  /**
+   * @brief 加载快照并回放日志到 model，随后打开日志以追加记录。
+   *
+   * 快照不存在时从空模型开始（日志仍被回放）。回放后统一执行 Validate()，
+   * 规则同 LoadModel。
+   *
+   * @return 成功返回 true；失败时日志未打开，Record* 调用将失败。
+   */
+  bool Open(UnifiedModel &model, std::string *errorMessage = nullptr);
+
+  /// 追加一条 upsert 记录（特征的完整当前状态）。
+  bool RecordUpsert(const std::shared_ptr<CFeatureBase> &feature,
+                    std::string *errorMessage = nullptr);
+
+  /// 追加一条 remove 记录。
+  bool RecordRemove(const std::string &featureID,
+                    std::string *errorMessage = nullptr);
+
+  /// 日志是否已超过压缩阈值。
+  bool NeedsCompaction() const;
+
+  /**
+   * @brief 将 model 原子写为新快照并清空日志。
+   *
+   * model 应为 Open 得到的模型加上已记录的全部变更。快照先经
+   * WriteFileAtomically 替换，再以新指纹重建日志头。
+   */
+  bool Compact(const UnifiedModel &model, std::string *errorMessage = nullptr);
+
+  /// NeedsCompaction() 为真时执行 Compact，否则直接返回 true。
+  bool CompactIfNeeded(const UnifiedModel &model,
+                       std::string *errorMessage = nullptr);
+
+  bool IsOpen() const { return m_file != nullptr; }
+  std::uint64_t JournalBytes() const { return m_journalBytes; }
+  std::uint64_t SnapshotBytes() const { return m_snapshotBytes; }
+  /// 最近一次 Open 回放的记录数。
+  std::size_t ReplayedRecords() const { return m_replayedRecords; }
+  /// 最近一次 Open 截掉的损坏尾部字节数。
+  std::uint64_t DiscardedBytes() const { return m_discardedBytes; }
+  const std::filesystem::path &SnapshotPath() const { return m_snapshotPath; }
+
+private:
+  bool AppendRecord(std::uint8_t type, const std::string &payload,
+                    std::string *errorMessage);
+  bool ResetJournal(std::string *errorMessage);
+  void CloseJournal();
+
+  std::filesystem::path m_snapshotPath;
+  std::filesystem::path m_journalPath;
+  ModelJournalOptions m_options;
+  std::FILE *m_file = nullptr;
+  std::uint64_t m_snapshotBytes = 0;
+  std::uint64_t m_snapshotHash = 0;
+  std::uint64_t m_journalBytes = 0;
+  std::size_t m_replayedRecords = 0;
+  std::uint64_t m_discardedBytes = 0;
+  std::string m_scratch; ///< 记录编码缓冲区，跨调用复用容量
+};
+
+} // namespace CADExchange
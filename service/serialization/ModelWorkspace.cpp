@@ -0,0 +1,327 @@
+#include "CerealPrelude.h"
+#include "JsonStreamArchive.h"
+#include "ModelWorkspace.h"
+#include "BufferStream.h"
+#include "ModelGeometryVisitor.h"
+#include "../../core/ModelTransform.h"
+#include "../../core/detail/IoHelpers.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace CADExchange {
+
+namespace {
+
+using detail::Fnv1a;
+
+/// 以多态 shared_ptr 形式写出紧凑 JSON，作为内容键（含动态类型名）。
+template <typename T>
+void EncodeContent(const std::shared_ptr<T> &object, std::string &out) {
+  out.clear();
+  StringSinkBuf sink(out);
+  std::ostream stream(&sink);
+  cereal::JSONOutputArchive archive(
+      stream, cereal::JSONOutputArchive::Options::NoIndent());
+  archive(cereal::make_nvp("v", object));
+}
+
+/// 把特征中的每个引用槽位替换为池内实例。
+class ReferencePooler : public GeometryVisitorBase {
+public:
+  ReferencePooler(ModelWorkspace &workspace) : m_workspace(workspace) {}
+
+  template <typename R> bool Ref(std::shared_ptr<R> &slot) {
+    if (!slot) {
+      return false;
+    }
+    auto it = m_replaced.find(slot.get());
+    if (it == m_replaced.end()) {
+      auto pooled = m_workspace.InternReference(
+          std::static_pointer_cast<CRefEntityBase>(slot));
+      it = m_replaced.emplace(slot.get(), std::move(pooled)).first;
+    }
+    if (auto typed = std::dynamic_pointer_cast<R>(it->second)) {
+      slot = std::move(typed);
+    }
+    return false; // 不进入引用几何
+  }
+
+  bool Segment(std::shared_ptr<CSketchSeg> &) { return false; }
+
+private:
+  ModelWorkspace &m_workspace;
+  std::unordered_map<const void *, std::shared_ptr<CRefEntityBase>> m_replaced;
+};
+
+/// 统计特征中的引用槽位（含重复）与不同对象。
+class ReferenceCounter : public GeometryVisitorBase {
+public:
+  template <typename R> bool Ref(std::shared_ptr<R> &slot) {
+    if (slot) {
+      ++slots;
+      unique.insert(slot.get());
+    }
+    return false;
+  }
+
+  bool Segment(std::shared_ptr<CSketchSeg> &) { return false; }
+
+  std::size_t slots = 0;
+  std::unordered_set<const void *> unique;
+};
+
+} // namespace
+
+std::string_view StringInterner::Intern(std::string_view text) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_index.find(text);
+  if (it != m_index.end()) {
+    return *it;
+  }
+  const std::string &stored = m_storage.emplace_back(text);
+  return *m_index.insert(stored).first;
+}
+
+std::size_t StringInterner::Size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_storage.size();
+}
+
+template <typename T>
+std::shared_ptr<T>
+ModelWorkspace::Pool<T>::Intern(std::uint64_t hash,
+                                const std::shared_ptr<T> &object,
+                                std::string &encoded) {
+  auto &bucket = buckets[hash];
+  bucket.erase(std::remove_if(bucket.begin(), bucket.end(),
+                              [](const Entry &e) { return e.object.expired(); }),
+               bucket.end());
+  for (const auto &entry : bucket) {
+    if (entry.encoded != encoded) {
+      continue;
+    }
+    if (auto candidate = entry.object.lock()) {
+      return candidate;
+    }
+  }
+  bucket.push_back({object, std::move(encoded)});
+  return object;
+}
+
+std::shared_ptr<CRefEntityBase>
+ModelWorkspace::InternReference(const std::shared_ptr<CRefEntityBase> &ref) {
+  if (!ref) {
+    return ref;
+  }
+  // 池中只登记工作区自有的对象，调用方之后修改 ref 不会影响已入池实例。
+  std::string scratch;
+  return InternReference(CloneRefEntity(*ref), scratch);
+}
+
+std::shared_ptr<CRefEntityBase>
+ModelWorkspace::InternReference(const std::shared_ptr<CRefEntityBase> &ref,
+                                std::string &scratch) {
+  if (!ref) {
+    return ref;
+  }
+  RegisterSerializationTypes();
+  EncodeContent(ref, scratch);
+  const std::uint64_t hash = Fnv1a(scratch);
+  std::lock_guard<std::mutex> lock(m_poolMutex);
+  return m_references.Intern(hash, ref, scratch);
+}
+
+std::shared_ptr<CFeatureBase>
+ModelWorkspace::InternFeature(const std::shared_ptr<CFeatureBase> &feature,
+                              std::string &scratch) {
+  if (!feature) {
+    return feature;
+  }
+  EncodeContent(feature, scratch);
+  const std::uint64_t hash = Fnv1a(scratch);
+  std::lock_guard<std::mutex> lock(m_poolMutex);
+  return m_features.Intern(hash, feature, scratch);
+}
+
+void ModelWorkspace::Deduplicate(UnifiedModel &model, std::string &scratch) {
+  RegisterSerializationTypes();
+  // 先合并引用，使引用相同的特征编码一致，再按内容合并特征。
+  ReferencePooler pooler(*this);
+  std::vector<std::shared_ptr<CFeatureBase>> features;
+  features.reserve(model.GetFeatures().size());
+  for (const auto &feature : model.GetFeatures()) {
+    if (feature) {
+      VisitFeatureGeometry(*feature, pooler);
+    }
+    features.push_back(InternFeature(feature, scratch));
+  }
+  model.Clear();
+  model.AddFeatures(features);
+}
+
+std::shared_ptr<const UnifiedModel>
+ModelWorkspace::Insert(std::string_view name, UnifiedModel model) {
+  Part part;
+  part.model = std::make_shared<const UnifiedModel>(std::move(model));
+  for (const auto &feature : part.model->GetFeatures()) {
+    if (feature && !feature->featureName.empty()) {
+      part.names.emplace_back(m_strings.Intern(feature->featureName),
+                              m_strings.Intern(feature->featureID));
+    }
+  }
+  const std::string_view key = m_strings.Intern(name);
+  std::lock_guard<std::mutex> lock(m_partMutex);
+  auto &slot = m_parts[key];
+  slot = std::move(part);
+  return slot.model;
+}
+
+std::shared_ptr<const UnifiedModel>
+ModelWorkspace::AddPart(std::string_view name, const UnifiedModel &model) {
+  // 深拷贝后再去重：池与零件只持有工作区自有的对象，调用方可继续原地修改
+  // 自己的模型而不影响任何零件。
+  UnifiedModel owned = CloneModelDeep(model);
+  std::string scratch;
+  Deduplicate(owned, scratch);
+  return Insert(name, std::move(owned));
+}
+
+bool ModelWorkspace::LoadPart(std::string_view name,
+                              const std::filesystem::path &filePath,
+                              std::string *errorMessage,
+                              SerializationFormat format) {
+  UnifiedModel model;
+  if (!LoadModel(model, filePath, errorMessage, format)) {
+    return false;
+  }
+  // 刚加载的模型只被本函数持有，无需再拷贝。
+  std::string scratch;
+  Deduplicate(model, scratch);
+  Insert(name, std::move(model));
+  return true;
+}
+
+std::size_t ModelWorkspace::LoadParts(const std::vector<PartSource> &sources,
+                                      SerializationFormat format,
+                                      unsigned threadCount,
+                                      std::vector<std::string> *errors) {
+  std::vector<std::string> messages(sources.size());
+  std::vector<char> loaded(sources.size(), 0);
+
+  if (threadCount == 0) {
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+  threadCount = static_cast<unsigned>(
+      std::min<std::size_t>(threadCount, sources.size()));
+  // 各线程只写自己区间内的 messages/loaded；池与零件表由锁保护。
+  auto work = [&](std::size_t begin, std::size_t end) {
+    std::string scratch;
+    for (std::size_t i = begin; i < end; ++i) {
+      UnifiedModel model;
+      if (!LoadModel(model, sources[i].path, &messages[i], format)) {
+        if (messages[i].empty()) {
+          messages[i] = "Failed to load " + sources[i].path.string();
+        }
+        continue;
+      }
+      Deduplicate(model, scratch);
+      Insert(sources[i].name, std::move(model));
+      loaded[i] = 1;
+    }
+  };
+  if (threadCount <= 1) {
+    work(0, sources.size());
+  } else {
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount);
+    const std::size_t chunk = (sources.size() + threadCount - 1) / threadCount;
+    for (std::size_t begin = 0; begin < sources.size(); begin += chunk) {
+      workers.emplace_back(work, begin, std::min(begin + chunk, sources.size()));
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+
+  if (errors) {
+    *errors = std::move(messages);
+  }
+  return static_cast<std::size_t>(std::count(loaded.begin(), loaded.end(), 1));
+}
+
+std::shared_ptr<const UnifiedModel>
+ModelWorkspace::GetPart(std::string_view name) const {
+  std::lock_guard<std::mutex> lock(m_partMutex);
+  auto it = m_parts.find(name);
+  return it == m_parts.end() ? nullptr : it->second.model;
+}
+
+bool ModelWorkspace::RemovePart(std::string_view name) {
+  std::lock_guard<std::mutex> lock(m_partMutex);
+  auto it = m_parts.find(name);
+  if (it == m_parts.end()) {
+    return false;
+  }
+  m_parts.erase(it);
+  return true;
+}
+
+std::vector<std::string_view> ModelWorkspace::PartNames() const {
+  std::lock_guard<std::mutex> lock(m_partMutex);
+  std::vector<std::string_view> names;
+  names.reserve(m_parts.size());
+  for (const auto &[name, part] : m_parts) {
+    names.push_back(name);
+  }
+  return names;
+}
+
+std::size_t ModelWorkspace::PartCount() const {
+  std::lock_guard<std::mutex> lock(m_partMutex);
+  return m_parts.size();
+}
+
+std::vector<std::pair<std::string_view, std::string_view>>
+ModelWorkspace::FindFeaturesByName(std::string_view featureName) const {
+  std::vector<std::pair<std::string_view, std::string_view>> result;
+  std::lock_guard<std::mutex> lock(m_partMutex);
+  for (const auto &[partName, part] : m_parts) {
+    for (const auto &[name, id] : part.names) {
+      if (name == featureName) {
+        result.emplace_back(partName, id);
+      }
+    }
+  }
+  return result;
+}
+
+WorkspaceStats ModelWorkspace::GetStats() const {
+  WorkspaceStats stats;
+  std::unordered_set<const CFeatureBase *> uniqueFeatures;
+  ReferenceCounter counter;
+  {
+    std::lock_guard<std::mutex> lock(m_partMutex);
+    stats.parts = m_parts.size();
+    for (const auto &[name, part] : m_parts) {
+      for (const auto &feature : part.model->GetFeatures()) {
+        if (!feature) {
+          continue;
+        }
+        ++stats.features;
+        if (uniqueFeatures.insert(feature.get()).second) {
+          // 共享特征只统计一次；其引用槽位按特征对象计数。
+          VisitFeatureGeometry(*feature, counter);
+        }
+      }
+    }
+  }
+  stats.uniqueFeatures = uniqueFeatures.size();
+  stats.references = counter.slots;
+  stats.uniqueReferences = counter.unique.size();
+  stats.internedStrings = m_strings.Size();
+  return stats;
+}
+
+} // namespace CADExchange
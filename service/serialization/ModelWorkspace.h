@@ -0,0 +1,176 @@
+#pragma once
+
+#include "CADSerializer.h"
+
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace CADExchange {
+
+/**
+ * @file ModelWorkspace.h
+ * @brief 多零件工作区：在多个 UnifiedModel 之间共享字符串、引用实体与特征。
+ */
+
+/**
+ * @class StringInterner
+ * @brief 线程安全的字符串驻留池。
+ *
+ * 返回的 string_view 指向池内存储，在池销毁前一直有效；相同内容只存一份。
+ */
+class StringInterner {
+public:
+  std::string_view Intern(std::string_view text);
+  std::size_t Size() const;
+
+private:
+  mutable std::mutex m_mutex;
+  std::deque<std::string> m_storage; ///< deque 追加不移动已有元素
+  std::unordered_set<std::string_view> m_index;
+};
+
+/**
+ * @brief 工作区去重统计。
+ */
+struct WorkspaceStats {
+  std::size_t parts = 0;
+  std::size_t features = 0;         ///< 所有零件的特征槽位数
+  std::size_t uniqueFeatures = 0;   ///< 去重后的特征对象数
+  std::size_t references = 0;       ///< 所有特征中的引用槽位数
+  std::size_t uniqueReferences = 0; ///< 去重后的引用对象数
+  std::size_t internedStrings = 0;
+};
+
+/**
+ * @class ModelWorkspace
+ * @brief 持有多个零件模型，并对其内容做跨零件去重。
+ *
+ * 加入工作区的模型经过两步共享：
+ *   1. 引用享元：每个引用实体按内容（cereal JSON 紧凑编码的哈希，命中后
+ *      逐字节确认）映射到池中唯一实例，例如各零件里由 Ref::XY() 生成的
+ *      标准基准面最终只剩一个对象；
+ *   2. 特征去重：引用替换后，内容完全相同的特征（含 ID，例如重复加载的
+ *      标准件）在零件之间共享同一对象。
+ * 零件名与特征名通过 StringInterner 驻留，供按名查找。
+ *
+ * 由于引用与特征可能被多个零件共享，零件只以 shared_ptr<const UnifiedModel>
+ * 暴露；需要修改时应复制模型并替换特征对象，不要原地修改。池只保存
+ * weak_ptr，移除零件后无人引用的对象随之释放。本类线程安全。
+ */
+class ModelWorkspace {
+public:
+  struct PartSource {
+    std::string name;
+    std::filesystem::path path;
+  };
+
+  ModelWorkspace() = default;
+  ModelWorkspace(const ModelWorkspace &) = delete;
+  ModelWorkspace &operator=(const ModelWorkspace &) = delete;
+
+  /**
+   * @brief 将模型的深拷贝去重后加入工作区；同名零件被替换。
+   *
+   * 工作区不持有 model 中的任何对象，调用方之后原地修改自己的模型
+   * （例如 ConvertModelUnit）不会影响工作区中的零件。
+   *
+   * @return 工作区中的只读模型。
+   */
+  std::shared_ptr<const UnifiedModel> AddPart(std::string_view name,
+                                              const UnifiedModel &model);
+
+  /**
+   * @brief 通过 LoadModel 加载单个零件并加入工作区。
+   */
+  bool LoadPart(std::string_view name, const std::filesystem::path &filePath,
+                std::string *errorMessage = nullptr,
+                SerializationFormat format = SerializationFormat::TINYXML);
+
+  /**
+   * @brief 并行加载多个零件。
+   *
+   * 解析、校验与去重编码在工作线程中完成，池查询在锁内进行。
+   *
+   * @param threadCount 0 表示 hardware_concurrency。
+   * @param errors 若非空，写入与 sources 等长的错误信息（成功项为空串）。
+   * @return 成功加载的零件数。
+   */
+  std::size_t LoadParts(const std::vector<PartSource> &sources,
+                        SerializationFormat format = SerializationFormat::TINYXML,
+                        unsigned threadCount = 0,
+                        std::vector<std::string> *errors = nullptr);
+
+  std::shared_ptr<const UnifiedModel> GetPart(std::string_view name) const;
+  bool RemovePart(std::string_view name);
+  std::vector<std::string_view> PartNames() const;
+  std::size_t PartCount() const;
+
+  /**
+   * @brief 按特征名查找 (零件名, 特征 ID)，顺序为零件名字典序。
+   */
+  std::vector<std::pair<std::string_view, std::string_view>>
+  FindFeaturesByName(std::string_view featureName) const;
+
+  /**
+   * @brief 返回与 ref 内容相同的池内实例（不存在时登记 ref 的副本）。
+   *
+   * 池按登记时的编码比较，返回的实例不可原地修改。
+   */
+  std::shared_ptr<CRefEntityBase>
+  InternReference(const std::shared_ptr<CRefEntityBase> &ref);
+
+  StringInterner &Strings() { return m_strings; }
+  WorkspaceStats GetStats() const;
+
+private:
+  /// 内容池：登记时保存编码，命中判断只做字节比较（池内对象视为不可变）。
+  template <typename T> struct Pool {
+    struct Entry {
+      std::weak_ptr<T> object;
+      std::string encoded;
+    };
+
+    /**
+     * @brief 返回与 encoded 内容相同的存活实例；不存在时登记 object，
+     *        并把 encoded 移入条目。调用方持锁。
+     */
+    std::shared_ptr<T> Intern(std::uint64_t hash,
+                              const std::shared_ptr<T> &object,
+                              std::string &encoded);
+
+    std::unordered_map<std::uint64_t, std::vector<Entry>> buckets;
+  };
+
+  struct Part {
+    std::shared_ptr<const UnifiedModel> model;
+    std::vector<std::pair<std::string_view, std::string_view>> names; ///< (名称, ID)
+  };
+
+  void Deduplicate(UnifiedModel &model, std::string &scratch);
+  std::shared_ptr<CFeatureBase>
+  InternFeature(const std::shared_ptr<CFeatureBase> &feature,
+                std::string &scratch);
+  std::shared_ptr<CRefEntityBase>
+  InternReference(const std::shared_ptr<CRefEntityBase> &ref,
+                  std::string &scratch);
+  std::shared_ptr<const UnifiedModel> Insert(std::string_view name,
+                                             UnifiedModel model);
+
+  StringInterner m_strings;
+  mutable std::mutex m_poolMutex;
+  Pool<CRefEntityBase> m_references;
+  Pool<CFeatureBase> m_features;
+  mutable std::mutex m_partMutex;
+  std::map<std::string_view, Part> m_parts;
+};
+
+} // namespace CADExchange
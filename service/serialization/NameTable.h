@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+namespace CADExchange {
+
+/**
+ * @file NameTable.h
+ * @brief 编译期名称表：名称 → 值的完美哈希查找与值 → 名称的反查。
+ *
+ * 表在编译期搜索一个哈希种子，使所有名称落在互不冲突的桶中；查找只需
+ * 一次哈希、一次桶访问与一次比较，不分配内存。找不到无冲突种子（通常是
+ * 名称重复）时编译失败。大小写不敏感的表在哈希与比较时按 ASCII 折叠，
+ * 用于兼容历史文件中大小写不一致的枚举文本。
+ */
+
+enum class NameCase { Sensitive, Insensitive };
+
+template <typename T> struct NameEntry {
+  std::string_view name; ///< 必须来自字符串字面量（NameOf 返回其 data()）
+  T value{};
+};
+
+namespace NameTableDetail {
+
+constexpr char Fold(char c, NameCase nameCase) {
+  return (nameCase == NameCase::Insensitive && c >= 'A' && c <= 'Z')
+             ? static_cast<char>(c - 'A' + 'a')
+             : c;
+}
+
+constexpr std::uint32_t Hash(std::string_view text, std::uint32_t seed,
+                             NameCase nameCase) {
+  std::uint32_t hash = 2166136261u ^ (seed * 0x9E3779B9u);
+  for (char c : text) {
+    hash ^= static_cast<unsigned char>(Fold(c, nameCase));
+    hash *= 16777619u;
+  }
+  return hash ^ (hash >> 15);
+}
+
+constexpr bool Equal(std::string_view a, std::string_view b, NameCase nameCase) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    if (Fold(a[i], nameCase) != Fold(b[i], nameCase)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+constexpr std::size_t BucketCount(std::size_t entries) {
+  std::size_t buckets = 4;
+  while (buckets < 2 * entries) {
+    buckets <<= 1;
+  }
+  return buckets;
+}
+
+} // namespace NameTableDetail
+
+/**
+ * @class NameTable
+ * @brief N 个名称的静态完美哈希表；通过 MakeNameTable 构造为 constexpr 常量。
+ *
+ * 同一个值可以有多个名称：排在最前面的是规范名（NameOf 返回它），其余为
+ * 只用于读取的别名。
+ */
+template <typename T, std::size_t N, NameCase Case> class NameTable {
+  static_assert(N > 0 && N < 255, "NameTable supports 1..254 entries");
+
+public:
+  static constexpr std::size_t kBuckets = NameTableDetail::BucketCount(N);
+
+  constexpr explicit NameTable(const NameEntry<T> (&entries)[N]) {
+    for (std::size_t i = 0; i < N; ++i) {
+      m_entries[i] = entries[i];
+    }
+    for (std::uint32_t seed = 1; seed < 0x10000 && m_seed == 0; ++seed) {
+      if (TrySeed(seed)) {
+        m_seed = seed;
+      }
+    }
+    if (m_seed == 0) {
+      // 常量求值时到达此处即编译失败：名称重复或表过于拥挤。
+      throw std::logic_error("NameTable: no collision-free seed");
+    }
+  }
+
+  /// 按名称查找，找不到返回空指针。
+  constexpr const T *Find(std::string_view name) const {
+    const std::uint8_t slot =
+        m_slots[NameTableDetail::Hash(name, m_seed, Case) & (kBuckets - 1)];
+    if (slot == 0 || !NameTableDetail::Equal(m_entries[slot - 1].name, name, Case)) {
+      return nullptr;
+    }
+    return &m_entries[slot - 1].value;
+  }
+
+  /// 解析 XML 属性文本；text 为空或不是已知名称时返回 nullopt。
+  std::optional<T> Parse(const char *text) const {
+    if (!text) {
+      return std::nullopt;
+    }
+    if (const T *value = Find(text)) {
+      return *value;
+    }
+    return std::nullopt;
+  }
+
+  /// 值的规范名；表中没有该值时返回 fallback。
+  constexpr const char *NameOf(T value, const char *fallback) const {
+    for (const auto &entry : m_entries) {
+      if (entry.value == value) {
+        return entry.name.data();
+      }
+    }
+    return fallback;
+  }
+
+private:
+  constexpr bool TrySeed(std::uint32_t seed) {
+    std::array<std::uint8_t, kBuckets> slots{};
+    for (std::size_t i = 0; i < N; ++i) {
+      const std::size_t bucket =
+          NameTableDetail::Hash(m_entries[i].name, seed, Case) & (kBuckets - 1);
+      if (slots[bucket] != 0) {
+        return false;
+      }
+      slots[bucket] = static_cast<std::uint8_t>(i + 1);
+    }
+    m_slots = slots;
+    return true;
+  }
+
+  std::array<NameEntry<T>, N> m_entries{};
+  std::array<std::uint8_t, kBuckets> m_slots{}; ///< 条目下标 + 1，0 表示空桶
+  std::uint32_t m_seed = 0;
+};
+
+/**
+ * @brief 构造名称表，用法：
+ *   constexpr auto kUnitNames = MakeNameTable<UnitType>({{"Meter", UnitType::METER}, ...});
+ */
+template <typename T, NameCase Case = NameCase::Insensitive, std::size_t N>
+constexpr NameTable<T, N, Case> MakeNameTable(const NameEntry<T> (&entries)[N]) {
+  return NameTable<T, N, Case>(entries);
+}
+
+} // namespace CADExchange
@@ -1,5 +1,7 @@
 #include "UnifiedSerialization.h"
 #include "../../thirdParty/cereal/archives/json.hpp"
+#include "JsonStreamArchive.h"
+#include "../../thirdParty/cereal/archives/portable_binary.hpp"
 #include "../../thirdParty/cereal/types/polymorphic.hpp"
 
 using namespace CADExchange;
@@ -0,0 +1,58 @@
+#include "SerializerContext.h"
+
+namespace CADExchange {
+
+namespace {
+
+void TrimBuffer(std::string &buffer, std::size_t limit) {
+  buffer.clear();
+  if (buffer.capacity() > limit) {
+    std::string().swap(buffer);
+  }
+}
+
+} // namespace
+
+SerializerContext::SerializerContext(std::size_t retainBytes)
+    : m_retainBytes(retainBytes),
+      m_document(std::make_unique<tinyxml2::XMLDocument>()) {}
+
+SerializerContext::~SerializerContext() = default;
+
+void SerializerContext::ResetDocument() {
+  if (m_documentBytes > m_retainBytes) {
+    // 内存池不支持收缩，超大文档之后整体替换文档。
+    m_document = std::make_unique<tinyxml2::XMLDocument>();
+  } else {
+    m_document->Clear();
+  }
+  m_documentBytes = 0;
+}
+
+void SerializerContext::Reset() {
+  ResetDocument();
+  TrimBuffer(m_readBuffer, m_retainBytes);
+  TrimBuffer(m_writeBuffer, m_retainBytes);
+}
+
+std::size_t SerializerContext::RetainedBufferBytes() const {
+  return m_readBuffer.capacity() + m_writeBuffer.capacity();
+}
+
+tinyxml2::XMLDocument &SerializerContext::AcquireDocument(std::size_t documentBytes) {
+  ResetDocument();
+  m_documentBytes = documentBytes;
+  return *m_document;
+}
+
+std::string &SerializerContext::AcquireReadBuffer() {
+  TrimBuffer(m_readBuffer, m_retainBytes);
+  return m_readBuffer;
+}
+
+std::string &SerializerContext::AcquireWriteBuffer() {
+  TrimBuffer(m_writeBuffer, m_retainBytes);
+  return m_writeBuffer;
+}
+
+} // namespace CADExchange
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../../thirdParty/tinyxml2/tinyxml2.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace CADExchange {
+
+/**
+ * @file SerializerContext.h
+ * @brief 可跨调用复用的 TinyXML 序列化上下文，用于批量加载/保存大量文件。
+ */
+
+/**
+ * @class SerializerContext
+ * @brief 在多次 Load/Save 之间保留 XML 文档（及其节点内存池）、读缓冲区与
+ *        写出分块缓冲区，使稳定状态下每个文件几乎不再分配这些内存。
+ *
+ * 每次使用前自动清空文档但保留内存池；若上一份文档或缓冲区超过
+ * retainBytes，则释放它们，避免一个超大文件让上下文长期占用内存。
+ *
+ * 上下文不是线程安全的，每个线程持有自己的实例。
+ */
+class SerializerContext {
+public:
+  static constexpr std::size_t kDefaultRetainBytes = 16u << 20;
+
+  explicit SerializerContext(std::size_t retainBytes = kDefaultRetainBytes);
+  ~SerializerContext();
+
+  SerializerContext(const SerializerContext &) = delete;
+  SerializerContext &operator=(const SerializerContext &) = delete;
+
+  /// 清空文档与缓冲区；超过保留上限的部分被释放。
+  void Reset();
+
+  /// 当前保留的缓冲区容量（字节），不含文档内存池。
+  std::size_t RetainedBufferBytes() const;
+
+  std::size_t RetainLimit() const { return m_retainBytes; }
+
+private:
+  friend class TinyXMLSerializer;
+
+  /// 清空并返回复用的文档；documentBytes 为本次文档的大致文本字节数。
+  tinyxml2::XMLDocument &AcquireDocument(std::size_t documentBytes);
+  /// 在事先无法得知大小时（如写文件后）补记本次文档的文本字节数。
+  void NoteDocumentBytes(std::size_t documentBytes) { m_documentBytes = documentBytes; }
+  /// 清空并返回读缓冲区（流加载时累积输入）。
+  std::string &AcquireReadBuffer();
+  /// 清空并返回写出分块缓冲区（流保存时使用）。
+  std::string &AcquireWriteBuffer();
+  void ResetDocument();
+
+  std::size_t m_retainBytes;
+  std::unique_ptr<tinyxml2::XMLDocument> m_document;
+  std::size_t m_documentBytes = 0;
+  std::string m_readBuffer;
+  std::string m_writeBuffer;
+};
+
+} // namespace CADExchange
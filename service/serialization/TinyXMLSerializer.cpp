@@ -1,7 +1,11 @@
 #include "TinyXMLSerializer.h"
+#include "LoadPipeline.h"
+#include "NameTable.h"
+#include "SerializerContext.h"
 #include <algorithm>
+#include <array>
 #include <cctype>
-#include <functional>
+#include <cstdarg>
 #include <optional>
 #include <cstdio>
 #include <sstream>
@@ -24,17 +28,20 @@ double CleanupZero(double value) {
   return value;
 }
 
-// Format one component with %.6g: strips trailing zeros per-component.
-// e.g. 1.0->"1", 0.5->"0.5", 3.141593->"3.14159"
-std::string FormatDouble(double v) {
-  char buf[32];
-  std::snprintf(buf, sizeof(buf), "%.6g", CleanupZero(v));
-  return buf;
-}
+// Formatted "(x,y,z)" text kept on the stack, so writing a point does not
+// allocate; call sites use c_str() exactly as they did with std::string.
+struct TripleText {
+  char text[96];
+  const char *c_str() const { return text; }
+};
 
-// Format a (x,y,z) triple; each component formatted independently.
-std::string FormatTriple(double x, double y, double z) {
-  return "(" + FormatDouble(x) + "," + FormatDouble(y) + "," + FormatDouble(z) + ")";
+// Format a (x,y,z) triple; each component with %.6g, which strips trailing
+// zeros per-component. e.g. 1.0->"1", 0.5->"0.5", 3.141593->"3.14159"
+TripleText FormatTriple(double x, double y, double z) {
+  TripleText out;
+  std::snprintf(out.text, sizeof(out.text), "(%.6g,%.6g,%.6g)", CleanupZero(x),
+                CleanupZero(y), CleanupZero(z));
+  return out;
 }
 
 bool TryParseTriple(const char *text, double &x, double &y, double &z) {
@@ -61,683 +68,404 @@ bool TryParseTriple(const char *text, double &x, double &y, double &z) {
   return true;
 }
 
-std::string ToLower(std::string str) {
-  std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) {
-    return static_cast<char>(std::tolower(c));
-  });
-  return str;
+// ─── Enum ↔ string tables ───────────────────────────────────────────────────
+// 每个枚举一张编译期名称表：首个名称为写出用的规范名，其后为只读兼容别名。
+// 读取时大小写不敏感（历史文件存在大小写混用）。
+
+constexpr auto kUnitNames = MakeNameTable<UnitType>({
+    {"Meter", UnitType::METER},
+    {"Centimeter", UnitType::CENTIMETER},
+    {"Millimeter", UnitType::MILLIMETER},
+    {"Inch", UnitType::INCH},
+    {"Foot", UnitType::FOOT},
+});
+
+constexpr auto kBooleanOpNames = MakeNameTable<BooleanOp>({
+    {"BOSS", BooleanOp::BOSS},
+    {"Cut", BooleanOp::CUT},
+    {"Merge", BooleanOp::MERGE},
+});
+
+constexpr auto kCurveTypeNames = MakeNameTable<CGeoCurveType>({
+    {"Line", CGeoCurveType::LINE},
+    {"Circle", CGeoCurveType::CIRCLE},
+    {"Ellipse", CGeoCurveType::ELLIPSE},
+    {"Intersection", CGeoCurveType::INTERSECTION},
+    {"BCurve", CGeoCurveType::BCURVE},
+    {"SPCurve", CGeoCurveType::SPCURVE},
+    {"ConstParam", CGeoCurveType::CONSTPARAM},
+    {"Trimmed", CGeoCurveType::TRIMMED},
+    {"Unknown", CGeoCurveType::UNKNOWN},
+});
+
+constexpr auto kSurfaceTypeNames = MakeNameTable<CGeoSurfaceType>({
+    {"Plane", CGeoSurfaceType::PLANE},
+    {"Cylinder", CGeoSurfaceType::CYLINDER},
+    {"Cone", CGeoSurfaceType::CONE},
+    {"Sphere", CGeoSurfaceType::SPHERE},
+    {"Torus", CGeoSurfaceType::TORUS},
+    {"BSurface", CGeoSurfaceType::BSURFACE},
+    {"Unknown", CGeoSurfaceType::UNKNOWN},
+});
+
+constexpr auto kSegTypeNames = MakeNameTable<CSketchSeg::SegType>({
+    {"Line", CSketchSeg::SegType::LINE},
+    {"Circle", CSketchSeg::SegType::CIRCLE},
+    {"Arc", CSketchSeg::SegType::ARC},
+    {"Spline", CSketchSeg::SegType::SPLINE},
+    {"Point", CSketchSeg::SegType::POINT},
+});
+
+constexpr auto kSweepExtentTypeNames = MakeNameTable<SweepExtent::Type>({
+    {"Value", SweepExtent::Type::VALUE},
+    {"Symmetric", SweepExtent::Type::SYMMETRIC},
+    {"ThroughAll", SweepExtent::Type::THROUGH_ALL},
+    {"ThroughAllBothSides", SweepExtent::Type::THROUGH_ALL_BOTH_SIDES},
+    {"UpToNext", SweepExtent::Type::UP_TO_NEXT},
+    {"UpToEntity", SweepExtent::Type::UP_TO_ENTITY},
+    {"UpToExtended", SweepExtent::Type::UP_TO_EXTENDED},
+    {"ThruPoint", SweepExtent::Type::THRU_POINT},
+    {"Blind", SweepExtent::Type::VALUE},
+    {"UpToFace", SweepExtent::Type::UP_TO_ENTITY},
+    {"UpToVertex", SweepExtent::Type::UP_TO_ENTITY},
+});
+
+constexpr auto kSweepPathOrientationNames = MakeNameTable<SweepPathOrientation>({
+    {"FollowPath", SweepPathOrientation::FollowPath},
+    {"KeepProfileNormal", SweepPathOrientation::KeepProfileNormal},
+});
+
+constexpr auto kSweepProfileKindNames = MakeNameTable<SweepProfileKind>({
+    {"SketchReference", SweepProfileKind::SketchReference},
+    {"EmbeddedSketch", SweepProfileKind::EmbeddedSketch},
+    {"Circular", SweepProfileKind::Circular},
+    {"Sketch", SweepProfileKind::SketchReference},
+    {"Embedded", SweepProfileKind::EmbeddedSketch},
+});
+
+constexpr auto kChamferModeNames = MakeNameTable<ChamferMode>({
+    {"EqualDistance", ChamferMode::EQUAL_DISTANCE},
+    {"TwoDistances", ChamferMode::TWO_DISTANCES},
+    {"TwoOffsets", ChamferMode::TWO_OFFSETS},
+    {"DistanceAngle", ChamferMode::DISTANCE_ANGLE},
+    {"Vertex3Distances", ChamferMode::VERTEX_3DISTANCES},
+});
+
+constexpr auto kFilletModeNames = MakeNameTable<FilletMode>({
+    {"Constant", FilletMode::CONSTANT_RADIUS},
+    {"Variable", FilletMode::VARIABLE_RADIUS},
+    {"FaceFillet", FilletMode::FACE_FILLET},
+    {"FullRound", FilletMode::FULL_ROUND},
+    {"Chordal", FilletMode::CHORDAL},
+    {"Unknown", FilletMode::UNKNOWN},
+    {"ConstantRadius", FilletMode::CONSTANT_RADIUS},
+    {"VariableRadius", FilletMode::VARIABLE_RADIUS},
+});
+
+constexpr auto kFilletCrossSectionNames = MakeNameTable<FilletCrossSection>({
+    {"Circular", FilletCrossSection::CIRCULAR},
+    {"Conic", FilletCrossSection::CONIC},
+    {"CurvatureContinuous", FilletCrossSection::CURVATURE_CONTINUOUS},
+    {"Unknown", FilletCrossSection::UNKNOWN},
+});
+
+constexpr auto kFilletReferenceModeNames = MakeNameTable<FilletReferenceMode>({
+    {"EdgeChain", FilletReferenceMode::EDGE_CHAIN},
+    {"FaceFace", FilletReferenceMode::FACE_FACE},
+    {"FullRoundThreeFaces", FilletReferenceMode::FULL_ROUND_THREE_FACES},
+    {"Unknown", FilletReferenceMode::UNKNOWN},
+});
+
+constexpr auto kFilletConicValueModeNames = MakeNameTable<FilletConicValueMode>({
+    {"Rho", FilletConicValueMode::RHO},
+    {"Radius", FilletConicValueMode::RADIUS},
+    {"GenericValue", FilletConicValueMode::GENERIC_VALUE},
+    {"None", FilletConicValueMode::NONE},
+});
+
+constexpr auto kFilletDriveTypeNames = MakeNameTable<FilletDriveType>({
+    {"Radius", FilletDriveType::RADIUS},
+    {"Distances", FilletDriveType::SINGLE_DISTANCE},
+    {"SingleDistance", FilletDriveType::SINGLE_DISTANCE},
+    {"TwoDistances", FilletDriveType::TWO_DISTANCES},
+    {"Unknown", FilletDriveType::UNKNOWN},
+});
+
+constexpr auto kSweepSectionPlacementNames = MakeNameTable<SweepSectionPlacement>({
+    {"ExistingProfilePlane", SweepSectionPlacement::ExistingProfilePlane},
+    {"PathNormalAtStart", SweepSectionPlacement::PathNormalAtStart},
+    {"Existing", SweepSectionPlacement::ExistingProfilePlane},
+    {"PathNormal", SweepSectionPlacement::PathNormalAtStart},
+});
+
+constexpr auto kPlaneMethodNames = MakeNameTable<PlaneMethod>({
+    {"Offset", PlaneMethod::OFFSET},
+    {"Fixed", PlaneMethod::FIXED},
+    {"Angle", PlaneMethod::ANGLE},
+    {"Parallel", PlaneMethod::PARALLEL},
+    {"Perpendicular", PlaneMethod::PERPENDICULAR},
+    {"MidPlane", PlaneMethod::MID_PLANE},
+    {"ThreePoints", PlaneMethod::THREE_POINTS},
+    {"Line", PlaneMethod::LINE},
+    {"Tangent", PlaneMethod::TANGENT},
+});
+
+constexpr auto kPlaneConstraintTypeNames = MakeNameTable<PlaneConstraintType>({
+    {"Parallel", PlaneConstraintType::PARALLEL},
+    {"Perpendicular", PlaneConstraintType::PERPENDICULAR},
+    {"Coincident", PlaneConstraintType::COINCIDENT},
+    {"Distance", PlaneConstraintType::DISTANCE},
+    {"Angle", PlaneConstraintType::ANGLE},
+    {"Symmetric", PlaneConstraintType::SYMMETRIC},
+    {"Tangent", PlaneConstraintType::TANGENT},
+    {"Projection", PlaneConstraintType::PROJECTION},
+});
+
+const char *UnitTypeToString(UnitType type) {
+  return kUnitNames.NameOf(type, "Unknown");
 }
 
-std::string UnitTypeToString(UnitType type) {
-  switch (type) {
-  case UnitType::METER:
-    return "Meter";
-  case UnitType::CENTIMETER:
-    return "Centimeter";
-  case UnitType::MILLIMETER:
-    return "Millimeter";
-  case UnitType::INCH:
-    return "Inch";
-  case UnitType::FOOT:
-    return "Foot";
-  }
-  return "Unknown";
+std::optional<UnitType> UnitTypeFromString(const char *text) {
+  return kUnitNames.Parse(text);
 }
 
-std::optional<UnitType> UnitTypeFromString(const char *text) {
-  if (!text)
-    return std::nullopt;
-  std::string value = ToLower(text);
-  if (value == "meter")
-    return UnitType::METER;
-  if (value == "centimeter")
-    return UnitType::CENTIMETER;
-  if (value == "millimeter")
-    return UnitType::MILLIMETER;
-  if (value == "inch")
-    return UnitType::INCH;
-  if (value == "foot")
-    return UnitType::FOOT;
-  return std::nullopt;
-}
-
-std::string BooleanOpToString(BooleanOp op) {
-  switch (op) {
-  case BooleanOp::BOSS:
-    return "BOSS";
-  case BooleanOp::CUT:
-    return "Cut";
-  case BooleanOp::MERGE:
-    return "Merge";
-  }
-  return "Unknown";
+const char *BooleanOpToString(BooleanOp op) {
+  return kBooleanOpNames.NameOf(op, "Unknown");
 }
 
 std::optional<BooleanOp> BooleanOpFromString(const char *text) {
-  if (!text)
-    return std::nullopt;
-  std::string value = ToLower(text);
-  if (value == "boss")
-    return BooleanOp::BOSS;
-  if (value == "cut")
-    return BooleanOp::CUT;
-  if (value == "merge")
-    return BooleanOp::MERGE;
-  return std::nullopt;
-}
-
-std::string CurveTypeToString(CGeoCurveType type) {
-  switch (type) {
-  case CGeoCurveType::LINE:
-    return "Line";
-  case CGeoCurveType::CIRCLE:
-    return "Circle";
-  case CGeoCurveType::ELLIPSE:
-    return "Ellipse";
-  case CGeoCurveType::INTERSECTION:
-    return "Intersection";
-  case CGeoCurveType::BCURVE:
-    return "BCurve";
-  case CGeoCurveType::SPCURVE:
-    return "SPCurve";
-  case CGeoCurveType::CONSTPARAM:
-    return "ConstParam";
-  case CGeoCurveType::TRIMMED:
-    return "Trimmed";
-  case CGeoCurveType::UNKNOWN:
-  default:
-    return "Unknown";
-  }
+  return kBooleanOpNames.Parse(text);
+}
+
+const char *CurveTypeToString(CGeoCurveType type) {
+  return kCurveTypeNames.NameOf(type, "Unknown");
 }
 
 std::optional<CGeoCurveType> CurveTypeFromString(const char *text) {
-  if (!text) {
-    return std::nullopt;
-  }
-  const std::string value = ToLower(text);
-  if (value == "line")
-    return CGeoCurveType::LINE;
-  if (value == "circle")
-    return CGeoCurveType::CIRCLE;
-  if (value == "ellipse")
-    return CGeoCurveType::ELLIPSE;
-  if (value == "intersection")
-    return CGeoCurveType::INTERSECTION;
-  if (value == "bcurve")
-    return CGeoCurveType::BCURVE;
-  if (value == "spcurve")
-    return CGeoCurveType::SPCURVE;
-  if (value == "constparam")
-    return CGeoCurveType::CONSTPARAM;
-  if (value == "trimmed")
-    return CGeoCurveType::TRIMMED;
-  if (value == "unknown")
-    return CGeoCurveType::UNKNOWN;
-  return std::nullopt;
-}
-
-std::string SurfaceTypeToString(CGeoSurfaceType type) {
-  switch (type) {
-  case CGeoSurfaceType::PLANE:
-    return "Plane";
-  case CGeoSurfaceType::CYLINDER:
-    return "Cylinder";
-  case CGeoSurfaceType::CONE:
-    return "Cone";
-  case CGeoSurfaceType::SPHERE:
-    return "Sphere";
-  case CGeoSurfaceType::TORUS:
-    return "Torus";
-  case CGeoSurfaceType::BSURFACE:
-    return "BSurface";
-  case CGeoSurfaceType::UNKNOWN:
-  default:
-    return "Unknown";
-  }
+  return kCurveTypeNames.Parse(text);
+}
+
+const char *SurfaceTypeToString(CGeoSurfaceType type) {
+  return kSurfaceTypeNames.NameOf(type, "Unknown");
 }
 
 std::optional<CGeoSurfaceType> SurfaceTypeFromString(const char *text) {
-  if (!text) {
-    return std::nullopt;
-  }
-  const std::string value = ToLower(text);
-  if (value == "plane")
-    return CGeoSurfaceType::PLANE;
-  if (value == "cylinder")
-    return CGeoSurfaceType::CYLINDER;
-  if (value == "cone")
-    return CGeoSurfaceType::CONE;
-  if (value == "sphere")
-    return CGeoSurfaceType::SPHERE;
-  if (value == "torus")
-    return CGeoSurfaceType::TORUS;
-  if (value == "bsurface")
-    return CGeoSurfaceType::BSURFACE;
-  if (value == "unknown")
-    return CGeoSurfaceType::UNKNOWN;
-  return std::nullopt;
-}
-
-std::string SegTypeToString(CSketchSeg::SegType type) {
-  switch (type) {
-  case CSketchSeg::SegType::LINE:
-    return "Line";
-  case CSketchSeg::SegType::CIRCLE:
-    return "Circle";
-  case CSketchSeg::SegType::ARC:
-    return "Arc";
-  case CSketchSeg::SegType::SPLINE:
-    return "Spline";
-  case CSketchSeg::SegType::POINT:
-    return "Point";
-  }
-  return "Unknown";
+  return kSurfaceTypeNames.Parse(text);
+}
+
+const char *SegTypeToString(CSketchSeg::SegType type) {
+  return kSegTypeNames.NameOf(type, "Unknown");
 }
 
 CSketchSeg::SegType SegTypeFromString(const char *text) {
-  if (!text)
-    return CSketchSeg::SegType::LINE; // Default
-  std::string value = ToLower(text);
-  if (value == "line")
-    return CSketchSeg::SegType::LINE;
-  if (value == "circle")
-    return CSketchSeg::SegType::CIRCLE;
-  if (value == "arc")
-    return CSketchSeg::SegType::ARC;
-  if (value == "spline")
-    return CSketchSeg::SegType::SPLINE;
-  if (value == "point")
-    return CSketchSeg::SegType::POINT;
-  return CSketchSeg::SegType::LINE; // Default
-}
-
-std::string SweepExtentTypeToString(SweepExtent::Type type) {
-  switch (type) {
-  case SweepExtent::Type::VALUE:
-    return "Value";
-  case SweepExtent::Type::SYMMETRIC:
-    return "Symmetric";
-  case SweepExtent::Type::THROUGH_ALL:
-    return "ThroughAll";
-  case SweepExtent::Type::THROUGH_ALL_BOTH_SIDES:
-    return "ThroughAllBothSides";
-  case SweepExtent::Type::UP_TO_NEXT:
-    return "UpToNext";
-  case SweepExtent::Type::UP_TO_ENTITY:
-    return "UpToEntity";
-  case SweepExtent::Type::UP_TO_EXTENDED:
-    return "UpToExtended";
-  case SweepExtent::Type::THRU_POINT:
-    return "ThruPoint";
-  case SweepExtent::Type::UNKNOWN:
-    return "Unknown";
-  }
-  return "Unknown";
+  return kSegTypeNames.Parse(text).value_or(CSketchSeg::SegType::LINE);
+}
+
+const char *SweepExtentTypeToString(SweepExtent::Type type) {
+  return kSweepExtentTypeNames.NameOf(type, "Unknown");
 }
 
 std::optional<SweepExtent::Type>
 SweepExtentTypeFromString(const char *text) {
-  if (!text)
-    return std::nullopt;
-  std::string value = ToLower(text);
-  if (value == "value" || value == "blind")
-    return SweepExtent::Type::VALUE;
-  if (value == "symmetric")
-    return SweepExtent::Type::SYMMETRIC;
-  if (value == "throughall")
-    return SweepExtent::Type::THROUGH_ALL;
-  if (value == "throughallbothsides")
-    return SweepExtent::Type::THROUGH_ALL_BOTH_SIDES;
-  if (value == "uptonext")
-    return SweepExtent::Type::UP_TO_NEXT;
-  if (value == "uptoentity" || value == "uptoface" || value == "uptovertex")
-    return SweepExtent::Type::UP_TO_ENTITY;
-  if (value == "uptoextended")
-    return SweepExtent::Type::UP_TO_EXTENDED;
-  if (value == "thrupoint")
-    return SweepExtent::Type::THRU_POINT;
-  return std::nullopt;
-}
-
-std::string SweepPathOrientationToString(SweepPathOrientation orientation) {
-  switch (orientation) {
-  case SweepPathOrientation::FollowPath:
-    return "FollowPath";
-  case SweepPathOrientation::KeepProfileNormal:
-    return "KeepProfileNormal";
-  }
-  return "FollowPath";
+  return kSweepExtentTypeNames.Parse(text);
+}
+
+const char *SweepPathOrientationToString(SweepPathOrientation orientation) {
+  return kSweepPathOrientationNames.NameOf(orientation, "FollowPath");
 }
 
 std::optional<SweepPathOrientation>
 SweepPathOrientationFromString(const char *text) {
-  if (!text) {
-    return std::nullopt;
-  }
-  std::string value = ToLower(text);
-  if (value == "followpath") {
-    return SweepPathOrientation::FollowPath;
-  }
-  if (value == "keepprofilenormal") {
-    return SweepPathOrientation::KeepProfileNormal;
-  }
-  return std::nullopt;
+  return kSweepPathOrientationNames.Parse(text);
 }
 
-std::string SweepProfileKindToString(SweepProfileKind kind) {
-  switch (kind) {
-  case SweepProfileKind::SketchReference:
-    return "SketchReference";
-  case SweepProfileKind::EmbeddedSketch:
-    return "EmbeddedSketch";
-  case SweepProfileKind::Circular:
-    return "Circular";
-  }
-  return "SketchReference";
+const char *SweepProfileKindToString(SweepProfileKind kind) {
+  return kSweepProfileKindNames.NameOf(kind, "SketchReference");
 }
 
 std::optional<SweepProfileKind> SweepProfileKindFromString(const char *text) {
-  if (!text) {
-    return std::nullopt;
-  }
-  std::string value = ToLower(text);
-  if (value == "sketchreference" || value == "sketch") {
-    return SweepProfileKind::SketchReference;
-  }
-  if (value == "embeddedsketch" || value == "embedded") {
-    return SweepProfileKind::EmbeddedSketch;
-  }
-  if (value == "circular") {
-    return SweepProfileKind::Circular;
-  }
-  return std::nullopt;
+  return kSweepProfileKindNames.Parse(text);
 }
 
-std::string ChamferModeToString(ChamferMode mode) {
-  switch (mode) {
-  case ChamferMode::EQUAL_DISTANCE:
-    return "EqualDistance";
-  case ChamferMode::TWO_DISTANCES:
-    return "TwoDistances";
-  case ChamferMode::TWO_OFFSETS:
-    return "TwoOffsets";
-  case ChamferMode::DISTANCE_ANGLE:
-    return "DistanceAngle";
-  case ChamferMode::VERTEX_3DISTANCES:
-    return "Vertex3Distances";
-  case ChamferMode::UNKNOWN:
-    return "Unknown";
-  }
-  return "Unknown";
+const char *ChamferModeToString(ChamferMode mode) {
+  return kChamferModeNames.NameOf(mode, "Unknown");
 }
 
 std::optional<ChamferMode> ChamferModeFromString(const char *text) {
-  if (!text) {
-    return std::nullopt;
-  }
-  const std::string value = ToLower(text);
-  if (value == "equaldistance") {
-    return ChamferMode::EQUAL_DISTANCE;
-  }
-  if (value == "twodistances") {
-    return ChamferMode::TWO_DISTANCES;
-  }
-  if (value == "twooffsets") {
-    return ChamferMode::TWO_OFFSETS;
-  }
-  if (value == "distanceangle") {
-    return ChamferMode::DISTANCE_ANGLE;
-  }
-  if (value == "vertex3distances") {
-    return ChamferMode::VERTEX_3DISTANCES;
-  }
-  return std::nullopt;
+  return kChamferModeNames.Parse(text);
 }
 
-
-
-std::string FilletModeToString(FilletMode mode) {
-  switch (mode) {
-  case FilletMode::CONSTANT_RADIUS:
-    return "Constant";
-  case FilletMode::VARIABLE_RADIUS:
-    return "Variable";
-  case FilletMode::FACE_FILLET:
-    return "FaceFillet";
-  case FilletMode::FULL_ROUND:
-    return "FullRound";
-  case FilletMode::CHORDAL:
-    return "Chordal";
-  case FilletMode::UNKNOWN:
-    return "Unknown";
-  }
-  return "Unknown";
+const char *FilletModeToString(FilletMode mode) {
+  return kFilletModeNames.NameOf(mode, "Unknown");
 }
 
 std::optional<FilletMode> FilletModeFromString(const char *text) {
-  if (!text) {
-    return std::nullopt;
-  }
-  const std::string value = ToLower(text);
-  if (value == "constant") {
-    return FilletMode::CONSTANT_RADIUS;
-  }
-  if (value == "constantradius") {
-    return FilletMode::CONSTANT_RADIUS;
-  }
-  if (value == "variable") {
-    return FilletMode::VARIABLE_RADIUS;
-  }
-  if (value == "variableradius") {
-    return FilletMode::VARIABLE_RADIUS;
-  }
-  if (value == "facefillet") {
-    return FilletMode::FACE_FILLET;
-  }
-  if (value == "fullround") {
-    return FilletMode::FULL_ROUND;
-  }
-  if (value == "chordal") {
-    return FilletMode::CHORDAL;
-  }
-  if (value == "unknown") {
-    return FilletMode::UNKNOWN;
-  }
-  return std::nullopt;
+  return kFilletModeNames.Parse(text);
 }
 
-std::string FilletCrossSectionToString(FilletCrossSection crossSection) {
-  switch (crossSection) {
-  case FilletCrossSection::CIRCULAR:
-    return "Circular";
-  case FilletCrossSection::CONIC:
-    return "Conic";
-  case FilletCrossSection::CURVATURE_CONTINUOUS:
-    return "CurvatureContinuous";
-  case FilletCrossSection::UNKNOWN:
-    return "Unknown";
-  }
-  return "Unknown";
+const char *FilletCrossSectionToString(FilletCrossSection crossSection) {
+  return kFilletCrossSectionNames.NameOf(crossSection, "Unknown");
 }
 
 std::optional<FilletCrossSection>
 FilletCrossSectionFromString(const char *text) {
-  if (!text) {
-    return std::nullopt;
-  }
-  const std::string value = ToLower(text);
-  if (value == "circular") {
-    return FilletCrossSection::CIRCULAR;
-  }
-  if (value == "conic") {
-    return FilletCrossSection::CONIC;
-  }
-  if (value == "curvaturecontinuous") {
-    return FilletCrossSection::CURVATURE_CONTINUOUS;
-  }
-  if (value == "unknown") {
-    return FilletCrossSection::UNKNOWN;
-  }
-  return std::nullopt;
+  return kFilletCrossSectionNames.Parse(text);
 }
 
-std::string FilletReferenceModeToString(FilletReferenceMode referenceMode) {
-  switch (referenceMode) {
-  case FilletReferenceMode::EDGE_CHAIN:
-    return "EdgeChain";
-  case FilletReferenceMode::FACE_FACE:
-    return "FaceFace";
-  case FilletReferenceMode::FULL_ROUND_THREE_FACES:
-    return "FullRoundThreeFaces";
-  case FilletReferenceMode::UNKNOWN:
-    return "Unknown";
-  }
-  return "Unknown";
+const char *FilletReferenceModeToString(FilletReferenceMode referenceMode) {
+  return kFilletReferenceModeNames.NameOf(referenceMode, "Unknown");
 }
 
 std::optional<FilletReferenceMode>
 FilletReferenceModeFromString(const char *text) {
-  if (!text) {
-    return std::nullopt;
-  }
-  const std::string value = ToLower(text);
-  if (value == "edgechain") {
-    return FilletReferenceMode::EDGE_CHAIN;
-  }
-  if (value == "faceface") {
-    return FilletReferenceMode::FACE_FACE;
-  }
-  if (value == "fullroundthreefaces") {
-    return FilletReferenceMode::FULL_ROUND_THREE_FACES;
-  }
-  if (value == "unknown") {
-    return FilletReferenceMode::UNKNOWN;
-  }
-  return std::nullopt;
+  return kFilletReferenceModeNames.Parse(text);
 }
 
-std::string FilletConicValueModeToString(FilletConicValueMode mode) {
-  switch (mode) {
-  case FilletConicValueMode::RHO:
-    return "Rho";
-  case FilletConicValueMode::RADIUS:
-    return "Radius";
-  case FilletConicValueMode::GENERIC_VALUE:
-    return "GenericValue";
-  case FilletConicValueMode::NONE:
-    return "None";
-  }
-  return "None";
+const char *FilletConicValueModeToString(FilletConicValueMode mode) {
+  return kFilletConicValueModeNames.NameOf(mode, "None");
 }
 
 std::optional<FilletConicValueMode>
 FilletConicValueModeFromString(const char *text) {
-  if (!text) {
-    return std::nullopt;
-  }
-  const std::string value = ToLower(text);
-  if (value == "rho") {
-    return FilletConicValueMode::RHO;
-  }
-  if (value == "radius") {
-    return FilletConicValueMode::RADIUS;
-  }
-  if (value == "genericvalue") {
-    return FilletConicValueMode::GENERIC_VALUE;
-  }
-  if (value == "none") {
-    return FilletConicValueMode::NONE;
-  }
-  return std::nullopt;
+  return kFilletConicValueModeNames.Parse(text);
 }
 
-std::string FilletDriveTypeToString(FilletDriveType driveType) {
-  switch (driveType) {
-  case FilletDriveType::RADIUS:
-    return "Radius";
-  case FilletDriveType::SINGLE_DISTANCE:
-  case FilletDriveType::TWO_DISTANCES:
+const char *FilletDriveTypeToString(FilletDriveType driveType) {
+  // 两种距离驱动都写作 "Distances"，规范名之外的写法不能走 NameOf。
+  if (driveType == FilletDriveType::TWO_DISTANCES) {
     return "Distances";
-  case FilletDriveType::UNKNOWN:
-    return "Unknown";
   }
-  return "Unknown";
+  return kFilletDriveTypeNames.NameOf(driveType, "Unknown");
 }
 
 std::optional<FilletDriveType> FilletDriveTypeFromString(const char *text) {
-  if (!text) {
-    return std::nullopt;
-  }
-  const std::string value = ToLower(text);
-  if (value == "radius") {
-    return FilletDriveType::RADIUS;
-  }
-  if (value == "distances") {
-    return FilletDriveType::SINGLE_DISTANCE;
-  }
-  if (value == "singledistance") {
-    return FilletDriveType::SINGLE_DISTANCE;
-  }
-  if (value == "twodistances") {
-    return FilletDriveType::TWO_DISTANCES;
-  }
-  if (value == "unknown") {
-    return FilletDriveType::UNKNOWN;
-  }
-  return std::nullopt;
+  return kFilletDriveTypeNames.Parse(text);
 }
 
-std::string SweepSectionPlacementToString(SweepSectionPlacement placement) {
-  switch (placement) {
-  case SweepSectionPlacement::ExistingProfilePlane:
-    return "ExistingProfilePlane";
-  case SweepSectionPlacement::PathNormalAtStart:
-    return "PathNormalAtStart";
-  }
-  return "ExistingProfilePlane";
+const char *SweepSectionPlacementToString(SweepSectionPlacement placement) {
+  return kSweepSectionPlacementNames.NameOf(placement, "ExistingProfilePlane");
 }
 
 std::optional<SweepSectionPlacement>
 SweepSectionPlacementFromString(const char *text) {
-  if (!text) {
-    return std::nullopt;
-  }
-  std::string value = ToLower(text);
-  if (value == "existingprofileplane" || value == "existing") {
-    return SweepSectionPlacement::ExistingProfilePlane;
-  }
-  if (value == "pathnormalatstart" || value == "pathnormal") {
-    return SweepSectionPlacement::PathNormalAtStart;
-  }
-  return std::nullopt;
-}
-
-std::string PlaneMethodToString(PlaneMethod method) {
-  switch (method) {
-  case PlaneMethod::OFFSET:
-    return "Offset";
-  case PlaneMethod::FIXED:
-    return "Fixed";
-  case PlaneMethod::ANGLE:
-    return "Angle";
-  case PlaneMethod::PARALLEL:
-    return "Parallel";
-  case PlaneMethod::PERPENDICULAR:
-    return "Perpendicular";
-  case PlaneMethod::MID_PLANE:
-    return "MidPlane";
-  case PlaneMethod::THREE_POINTS:
-    return "ThreePoints";
-  case PlaneMethod::LINE:
-    return "Line";
-  case PlaneMethod::TANGENT:
-    return "Tangent";
-  case PlaneMethod::UNKNOWN:
-  default:
-    return "Unknown";
-  }
+  return kSweepSectionPlacementNames.Parse(text);
+}
+
+const char *PlaneMethodToString(PlaneMethod method) {
+  return kPlaneMethodNames.NameOf(method, "Unknown");
 }
 
 std::optional<PlaneMethod> PlaneMethodFromString(const char *text) {
-  if (!text)
-    return std::nullopt;
-  std::string value = ToLower(text);
-  if (value == "offset")
-    return PlaneMethod::OFFSET;
-  if (value == "fixed")
-    return PlaneMethod::FIXED;
-  if (value == "angle")
-    return PlaneMethod::ANGLE;
-  if (value == "parallel")
-    return PlaneMethod::PARALLEL;
-  if (value == "perpendicular")
-    return PlaneMethod::PERPENDICULAR;
-  if (value == "midplane")
-    return PlaneMethod::MID_PLANE;
-  if (value == "threepoints")
-    return PlaneMethod::THREE_POINTS;
-  if (value == "line")
-    return PlaneMethod::LINE;
-  if (value == "tangent")
-    return PlaneMethod::TANGENT;
-  return std::nullopt;
-}
-
-std::string PlaneConstraintTypeToString(PlaneConstraintType type) {
-  switch (type) {
-  case PlaneConstraintType::PARALLEL:
-    return "Parallel";
-  case PlaneConstraintType::PERPENDICULAR:
-    return "Perpendicular";
-  case PlaneConstraintType::COINCIDENT:
-    return "Coincident";
-  case PlaneConstraintType::DISTANCE:
-    return "Distance";
-  case PlaneConstraintType::ANGLE:
-    return "Angle";
-  case PlaneConstraintType::SYMMETRIC:
-    return "Symmetric";
-  case PlaneConstraintType::TANGENT:
-    return "Tangent";
-  case PlaneConstraintType::PROJECTION:
-    return "Projection";
-  case PlaneConstraintType::UNKNOWN:
-  default:
-    return "Unknown";
-  }
+  return kPlaneMethodNames.Parse(text);
+}
+
+const char *PlaneConstraintTypeToString(PlaneConstraintType type) {
+  return kPlaneConstraintTypeNames.NameOf(type, "Unknown");
 }
 
 std::optional<PlaneConstraintType>
 PlaneConstraintTypeFromString(const char *text) {
-  if (!text)
-    return std::nullopt;
-  std::string value = ToLower(text);
-  if (value == "parallel")
-    return PlaneConstraintType::PARALLEL;
-  if (value == "perpendicular")
-    return PlaneConstraintType::PERPENDICULAR;
-  if (value == "coincident")
-    return PlaneConstraintType::COINCIDENT;
-  if (value == "distance")
-    return PlaneConstraintType::DISTANCE;
-  if (value == "angle")
-    return PlaneConstraintType::ANGLE;
-  if (value == "symmetric")
-    return PlaneConstraintType::SYMMETRIC;
-  if (value == "tangent")
-    return PlaneConstraintType::TANGENT;
-  if (value == "projection")
-    return PlaneConstraintType::PROJECTION;
-  return std::nullopt;
+  return kPlaneConstraintTypeNames.Parse(text);
 }
 
 // ─── Internal helpers moved into anon-ns; not exported ──────────────────────
-std::string FormatPoint(const CPoint3D &pt) {
+TripleText FormatPoint(const CPoint3D &pt) {
   return FormatTriple(pt.x, pt.y, pt.z);
 }
 
-std::string FormatVector(const CVector3D &vec) {
+TripleText FormatVector(const CVector3D &vec) {
   return FormatTriple(vec.x, vec.y, vec.z);
 }
 
-CPoint3D ParsePointAttribute(XMLElement *element, const char *name) {
+CPoint3D ParsePointText(const char *text) {
   CPoint3D pt;
   double x, y, z;
-  if (TryParseTriple(element->Attribute(name), x, y, z)) {
+  if (TryParseTriple(text, x, y, z)) {
     pt.x = x; pt.y = y; pt.z = z;
   }
   return pt;
 }
 
-CVector3D ParseVectorAttribute(XMLElement *element, const char *name) {
+CVector3D ParseVectorText(const char *text) {
   CVector3D vec;
   double x, y, z;
-  if (TryParseTriple(element->Attribute(name), x, y, z)) {
+  if (TryParseTriple(text, x, y, z)) {
     vec.x = x; vec.y = y; vec.z = z;
   }
   return vec;
 }
 
+CPoint3D ParsePointAttribute(XMLElement *element, const char *name) {
+  return ParsePointText(element->Attribute(name));
+}
+
+CVector3D ParseVectorAttribute(XMLElement *element, const char *name) {
+  return ParseVectorText(element->Attribute(name));
+}
+
+// ─── Single-pass attribute scanning ─────────────────────────────────────────
+// XMLElement::Attribute() 每次都从头线性比较属性名；属性多的元素（Fillet 参数、
+// 拓扑引用）逐个查询会变成属性数的平方。AttributeSlots 只遍历一次属性链表，
+// 用该元素种类的名称表（属性名 → 槽位，大小写敏感，与 Attribute() 一致）把
+// 每个属性放进对应槽位，之后按槽位取值。历史别名各占独立槽位，取值的先后与
+// 回退顺序仍由调用处决定。
+
+/**
+ * @brief 一个元素的属性槽位。Slot 是以 Count 结尾的 enum class。
+ *
+ * 同名属性只保留第一个，与 XMLElement::Attribute() 的语义相同；Query* 在属性
+ * 缺失或无法解析时不修改输出值，与 XMLElement::Query*Attribute() 相同。
+ */
+template <typename Slot> class AttributeSlots {
+public:
+  template <typename Table>
+  AttributeSlots(const XMLElement *element, const Table &table) {
+    for (const XMLAttribute *attr = element->FirstAttribute(); attr != nullptr;
+         attr = attr->Next()) {
+      if (const Slot *slot = table.Find(attr->Name())) {
+        const XMLAttribute *&target = m_attrs[static_cast<std::size_t>(*slot)];
+        if (!target) {
+          target = attr;
+        }
+      }
+    }
+  }
+
+  bool Has(Slot slot) const { return At(slot) != nullptr; }
+
+  const char *Text(Slot slot) const {
+    const XMLAttribute *attr = At(slot);
+    return attr ? attr->Value() : nullptr;
+  }
+
+  bool QueryInt(Slot slot, int *value) const {
+    const XMLAttribute *attr = At(slot);
+    return attr && attr->QueryIntValue(value) == XML_SUCCESS;
+  }
+
+  bool QueryDouble(Slot slot, double *value) const {
+    const XMLAttribute *attr = At(slot);
+    return attr && attr->QueryDoubleValue(value) == XML_SUCCESS;
+  }
+
+  bool QueryBool(Slot slot, bool *value) const {
+    const XMLAttribute *attr = At(slot);
+    return attr && attr->QueryBoolValue(value) == XML_SUCCESS;
+  }
+
+private:
+  const XMLAttribute *At(Slot slot) const {
+    return m_attrs[static_cast<std::size_t>(slot)];
+  }
+
+  std::array<const XMLAttribute *, static_cast<std::size_t>(Slot::Count)> m_attrs{};
+};
+
+template <typename Slot, std::size_t N>
+constexpr auto MakeAttributeTable(const NameEntry<Slot> (&entries)[N]) {
+  return MakeNameTable<Slot, NameCase::Sensitive>(entries);
+}
+
 std::shared_ptr<CRefFeature> LoadFeatureReference(XMLElement *element, RefType refType) {
   auto reference = std::make_shared<CRefFeature>(refType);
   if (const char *tid = element->Attribute("TargetFeatureID"))
@@ -757,53 +485,48 @@ CVector3D ComputePlaneYAxis(const CVector3D &normal, const CVector3D &xDir) {
 }
 
 // ConstraintType <-> string (human-readable; integer fallback for old files).
+constexpr auto kConstraintTypeNames = MakeNameTable<CSketchConstraint::ConstraintType>({
+    {"Coincident", CSketchConstraint::ConstraintType::COINCIDENT},
+    {"UseEdge", CSketchConstraint::ConstraintType::USEEDGE},
+    {"Horizontal", CSketchConstraint::ConstraintType::HORIZONTAL},
+    {"Vertical", CSketchConstraint::ConstraintType::VERTICAL},
+    {"Parallel", CSketchConstraint::ConstraintType::PARALLEL},
+    {"Perpendicular", CSketchConstraint::ConstraintType::PERPENDICULAR},
+    {"Tangent", CSketchConstraint::ConstraintType::TANGENT},
+    {"Concentric", CSketchConstraint::ConstraintType::CONCENTRIC},
+    {"Equal", CSketchConstraint::ConstraintType::EQUAL},
+    {"Distance", CSketchConstraint::ConstraintType::DISTANCE},
+    {"Angle", CSketchConstraint::ConstraintType::ANGLE},
+    {"Radius", CSketchConstraint::ConstraintType::RADIUS},
+    {"Diameter", CSketchConstraint::ConstraintType::DIAMETER},
+    {"Symmetric", CSketchConstraint::ConstraintType::SYMMETRIC},
+    {"Midpoint", CSketchConstraint::ConstraintType::MIDPOINT},
+    {"Collinear", CSketchConstraint::ConstraintType::COLLINEAR},
+    {"Fixed", CSketchConstraint::ConstraintType::FIXED},
+    {"Unknown", CSketchConstraint::ConstraintType::UNKNOWN},
+    {"Dimensional", CSketchConstraint::ConstraintType::DISTANCE},
+});
+
+constexpr auto kConstraintRefKindNames = MakeNameTable<SketchConstraintRefKind>({
+    {"SketchEntity", SketchConstraintRefKind::SketchEntity},
+    {"ExternalReference", SketchConstraintRefKind::ExternalReference},
+});
+
+constexpr auto kConstraintSubEntityNames = MakeNameTable<SketchConstraintSubEntity>({
+    {"Whole", SketchConstraintSubEntity::Whole},
+    {"Start", SketchConstraintSubEntity::Start},
+    {"End", SketchConstraintSubEntity::End},
+    {"Center", SketchConstraintSubEntity::Center},
+    {"Midpoint", SketchConstraintSubEntity::Midpoint},
+});
+
 const char *ConstraintTypeToString(CSketchConstraint::ConstraintType t) {
-  switch (t) {
-  case CSketchConstraint::ConstraintType::COINCIDENT:    return "Coincident";
-  case CSketchConstraint::ConstraintType::USEEDGE:       return "UseEdge";
-  case CSketchConstraint::ConstraintType::HORIZONTAL:    return "Horizontal";
-  case CSketchConstraint::ConstraintType::VERTICAL:      return "Vertical";
-  case CSketchConstraint::ConstraintType::PARALLEL:      return "Parallel";
-  case CSketchConstraint::ConstraintType::PERPENDICULAR: return "Perpendicular";
-  case CSketchConstraint::ConstraintType::TANGENT:       return "Tangent";
-  case CSketchConstraint::ConstraintType::CONCENTRIC:    return "Concentric";
-  case CSketchConstraint::ConstraintType::EQUAL:         return "Equal";
-  case CSketchConstraint::ConstraintType::DISTANCE:      return "Distance";
-  case CSketchConstraint::ConstraintType::ANGLE:         return "Angle";
-  case CSketchConstraint::ConstraintType::RADIUS:        return "Radius";
-  case CSketchConstraint::ConstraintType::DIAMETER:      return "Diameter";
-  case CSketchConstraint::ConstraintType::SYMMETRIC:     return "Symmetric";
-  case CSketchConstraint::ConstraintType::MIDPOINT:      return "Midpoint";
-  case CSketchConstraint::ConstraintType::COLLINEAR:     return "Collinear";
-  case CSketchConstraint::ConstraintType::FIXED:         return "Fixed";
-  case CSketchConstraint::ConstraintType::UNKNOWN:       return "Unknown";
-  default:                                               return "Unknown";
-  }
+  return kConstraintTypeNames.NameOf(t, "Unknown");
 }
 
 CSketchConstraint::ConstraintType ConstraintTypeFromString(const char *text) {
   if (!text) return CSketchConstraint::ConstraintType::UNKNOWN;
-  std::string v = ToLower(text);
-  if (v == "coincident")    return CSketchConstraint::ConstraintType::COINCIDENT;
-  if (v == "useedge")       return CSketchConstraint::ConstraintType::USEEDGE;
-  if (v == "horizontal")    return CSketchConstraint::ConstraintType::HORIZONTAL;
-  if (v == "vertical")      return CSketchConstraint::ConstraintType::VERTICAL;
-  if (v == "parallel")      return CSketchConstraint::ConstraintType::PARALLEL;
-  if (v == "perpendicular") return CSketchConstraint::ConstraintType::PERPENDICULAR;
-  if (v == "tangent")       return CSketchConstraint::ConstraintType::TANGENT;
-  if (v == "concentric")    return CSketchConstraint::ConstraintType::CONCENTRIC;
-  if (v == "equal")         return CSketchConstraint::ConstraintType::EQUAL;
-  if (v == "distance" || v == "dimensional") {
-    return CSketchConstraint::ConstraintType::DISTANCE;
-  }
-  if (v == "angle")         return CSketchConstraint::ConstraintType::ANGLE;
-  if (v == "radius")        return CSketchConstraint::ConstraintType::RADIUS;
-  if (v == "diameter")      return CSketchConstraint::ConstraintType::DIAMETER;
-  if (v == "symmetric")     return CSketchConstraint::ConstraintType::SYMMETRIC;
-  if (v == "midpoint")      return CSketchConstraint::ConstraintType::MIDPOINT;
-  if (v == "collinear")     return CSketchConstraint::ConstraintType::COLLINEAR;
-  if (v == "fixed")         return CSketchConstraint::ConstraintType::FIXED;
-  if (v == "unknown")       return CSketchConstraint::ConstraintType::UNKNOWN;
+  if (auto type = kConstraintTypeNames.Find(text)) return *type;
   // Backward-compat: integer fallback for files written by older versions.
   try { return static_cast<CSketchConstraint::ConstraintType>(std::stoi(text)); }
   catch (...) {}
@@ -811,39 +534,96 @@ CSketchConstraint::ConstraintType ConstraintTypeFromString(const char *text) {
 }
 
 const char *SketchConstraintRefKindToString(SketchConstraintRefKind kind) {
-  switch (kind) {
-  case SketchConstraintRefKind::SketchEntity:      return "SketchEntity";
-  case SketchConstraintRefKind::ExternalReference: return "ExternalReference";
-  default:                                         return "SketchEntity";
-  }
+  return kConstraintRefKindNames.NameOf(kind, "SketchEntity");
 }
 
 SketchConstraintRefKind SketchConstraintRefKindFromString(const char *text) {
-  if (!text) return SketchConstraintRefKind::SketchEntity;
-  return ToLower(text) == "externalreference"
-             ? SketchConstraintRefKind::ExternalReference
-             : SketchConstraintRefKind::SketchEntity;
+  return kConstraintRefKindNames.Parse(text).value_or(
+      SketchConstraintRefKind::SketchEntity);
 }
 
 const char *SketchConstraintSubEntityToString(SketchConstraintSubEntity sub) {
-  switch (sub) {
-  case SketchConstraintSubEntity::Whole:    return "Whole";
-  case SketchConstraintSubEntity::Start:    return "Start";
-  case SketchConstraintSubEntity::End:      return "End";
-  case SketchConstraintSubEntity::Center:   return "Center";
-  case SketchConstraintSubEntity::Midpoint: return "Midpoint";
-  default:                                  return "Whole";
-  }
+  return kConstraintSubEntityNames.NameOf(sub, "Whole");
 }
 
 SketchConstraintSubEntity SketchConstraintSubEntityFromString(const char *text) {
-  if (!text) return SketchConstraintSubEntity::Whole;
-  std::string v = ToLower(text);
-  if (v == "start") return SketchConstraintSubEntity::Start;
-  if (v == "end") return SketchConstraintSubEntity::End;
-  if (v == "center") return SketchConstraintSubEntity::Center;
-  if (v == "midpoint") return SketchConstraintSubEntity::Midpoint;
-  return SketchConstraintSubEntity::Whole;
+  return kConstraintSubEntityNames.Parse(text).value_or(
+      SketchConstraintSubEntity::Whole);
+}
+
+// XMLPrinter that appends to a caller-owned std::string instead of its internal
+// DynArray or a FILE*. With a stream attached, the string acts as a chunk buffer
+// that is flushed whenever it grows past kFlushThreshold.
+class BufferPrinter : public XMLPrinter {
+public:
+  explicit BufferPrinter(std::string &out, std::ostream *stream = nullptr)
+      : XMLPrinter(nullptr, false), m_out(out), m_stream(stream) {}
+
+  void Flush() {
+    if (m_stream && !m_out.empty()) {
+      m_stream->write(m_out.data(), static_cast<std::streamsize>(m_out.size()));
+      m_flushed += m_out.size();
+      m_out.clear();
+    }
+  }
+
+  // Total bytes printed, including chunks already flushed to the stream.
+  std::size_t Written() const { return m_flushed + m_out.size(); }
+
+protected:
+  void Print(const char *format, ...) override {
+    char local[128];
+    va_list va;
+    va_start(va, format);
+    const int len = std::vsnprintf(local, sizeof(local), format, va);
+    va_end(va);
+    if (len < 0) {
+      return;
+    }
+    if (static_cast<std::size_t>(len) < sizeof(local)) {
+      Append(local, static_cast<std::size_t>(len));
+      return;
+    }
+    const std::size_t offset = m_out.size();
+    m_out.resize(offset + static_cast<std::size_t>(len) + 1);
+    va_start(va, format);
+    std::vsnprintf(&m_out[offset], static_cast<std::size_t>(len) + 1, format, va);
+    va_end(va);
+    m_out.pop_back();
+    MaybeFlush();
+  }
+
+  void Write(const char *data, size_t size) override { Append(data, size); }
+
+  void Putc(char ch) override {
+    m_out.push_back(ch);
+    MaybeFlush();
+  }
+
+private:
+  static constexpr std::size_t kFlushThreshold = 64 * 1024;
+
+  void Append(const char *data, std::size_t size) {
+    m_out.append(data, size);
+    MaybeFlush();
+  }
+
+  void MaybeFlush() {
+    if (m_stream && m_out.size() >= kFlushThreshold) {
+      Flush();
+    }
+  }
+
+  std::string &m_out;
+  std::ostream *m_stream;
+  std::size_t m_flushed = 0;
+};
+
+// File size, only used for SerializerContext's retain limit; 0 when unknown.
+std::size_t FileBytes(const std::filesystem::path &path) {
+  std::error_code ec;
+  const auto bytes = std::filesystem::file_size(path, ec);
+  return ec ? 0 : static_cast<std::size_t>(bytes);
 }
 } // namespace
 
@@ -851,11 +631,8 @@ SketchConstraintSubEntity SketchConstraintSubEntityFromString(const char *text)
 // Save Implementation
 // =================================================================================================
 
-bool TinyXMLSerializer::Save(const UnifiedModel &model,
-                             const std::filesystem::path &filePath,
-                             std::string *errorMessage) {
-  XMLDocument doc;
-
+void TinyXMLSerializer::BuildDocument(const UnifiedModel &model,
+                                      XMLDocument &doc) {
   // Declaration
   doc.InsertFirstChild(doc.NewDeclaration());
 
@@ -864,7 +641,7 @@ bool TinyXMLSerializer::Save(const UnifiedModel &model,
   doc.InsertEndChild(root);
 
   // Attributes
-  root->SetAttribute("UnitSystem", UnitTypeToString(model.unit).c_str());
+  root->SetAttribute("UnitSystem", UnitTypeToString(model.unit));
   root->SetAttribute("ModelName", model.modelName.c_str());
   root->SetAttribute("FeatureCount",
                      static_cast<int64_t>(model.GetFeatures().size()));
@@ -874,6 +651,15 @@ bool TinyXMLSerializer::Save(const UnifiedModel &model,
   for (const auto &feature : model.GetFeatures()) {
     SaveFeature(doc, root, feature);
   }
+}
+
+bool TinyXMLSerializer::Save(const UnifiedModel &model,
+                             const std::filesystem::path &filePath,
+                             std::string *errorMessage,
+                             SerializerContext *context) {
+  std::optional<XMLDocument> local;
+  XMLDocument &doc = context ? context->AcquireDocument(0) : local.emplace();
+  BuildDocument(model, doc);
 
   XMLError result = doc.SaveFile(filePath.string().c_str());
   if (result != XML_SUCCESS) {
@@ -881,32 +667,115 @@ bool TinyXMLSerializer::Save(const UnifiedModel &model,
       *errorMessage = doc.ErrorStr();
     return false;
   }
+  if (context) {
+    context->NoteDocumentBytes(FileBytes(filePath));
+  }
+  return true;
+}
+
+bool TinyXMLSerializer::Save(const UnifiedModel &model, std::ostream &output,
+                             std::string *errorMessage,
+                             SerializerContext *context) {
+  std::optional<XMLDocument> local;
+  XMLDocument &doc = context ? context->AcquireDocument(0) : local.emplace();
+  BuildDocument(model, doc);
+
+  std::string localChunk;
+  std::string &chunk = context ? context->AcquireWriteBuffer() : localChunk;
+  BufferPrinter printer(chunk, &output);
+  doc.Print(&printer);
+  printer.Flush();
+  if (context) {
+    context->NoteDocumentBytes(printer.Written());
+  }
+  if (!output) {
+    if (errorMessage)
+      *errorMessage = "Failed to write XML to output stream.";
+    return false;
+  }
+  return true;
+}
+
+bool TinyXMLSerializer::SaveToBuffer(const UnifiedModel &model,
+                                     std::string &buffer,
+                                     std::string *errorMessage,
+                                     SerializerContext *context) {
+  (void)errorMessage;
+  std::optional<XMLDocument> local;
+  XMLDocument &doc = context ? context->AcquireDocument(0) : local.emplace();
+  BuildDocument(model, doc);
+
+  buffer.clear();
+  BufferPrinter printer(buffer);
+  doc.Print(&printer);
+  if (context) {
+    context->NoteDocumentBytes(buffer.size());
+  }
   return true;
 }
 
 void TinyXMLSerializer::SavePoint3D(XMLElement *element, const char *name,
                                     const CPoint3D &pt) {
-  std::string value = FormatTriple(pt.x, pt.y, pt.z);
+  const TripleText value = FormatTriple(pt.x, pt.y, pt.z);
   element->SetAttribute(name, value.c_str());
 }
 
 void TinyXMLSerializer::SaveVector3D(XMLElement *element, const char *name,
                                      const CVector3D &vec) {
-  std::string value = FormatTriple(vec.x, vec.y, vec.z);
+  const TripleText value = FormatTriple(vec.x, vec.y, vec.z);
   element->SetAttribute(name, value.c_str());
 }
 
 
 
+// 引用实体的属性槽位：引用是模型中数量最多的元素，按槽位单次扫描。
+enum class PlaneRefAttr : std::uint8_t { TargetFeatureID, Origin, XDir, YDir, Normal, Count };
+enum class FaceRefAttr : std::uint8_t {
+  ParentFeatureID, TopologyIndex, U, V, Normal, Center, SurfaceType, Count
+};
+enum class EdgeRefAttr : std::uint8_t {
+  ParentFeatureID, TopologyIndex, StartPoint, EndPoint, MidPoint, CurveType, Count
+};
+enum class VertexRefAttr : std::uint8_t { ParentFeatureID, TopologyIndex, Position, Count };
+
+constexpr auto kPlaneRefAttrs = MakeAttributeTable<PlaneRefAttr>({
+    {"TargetFeatureID", PlaneRefAttr::TargetFeatureID},
+    {"Origin", PlaneRefAttr::Origin},
+    {"XDir", PlaneRefAttr::XDir},
+    {"YDir", PlaneRefAttr::YDir},
+    {"Normal", PlaneRefAttr::Normal},
+});
+
+constexpr auto kFaceRefAttrs = MakeAttributeTable<FaceRefAttr>({
+    {"ParentFeatureID", FaceRefAttr::ParentFeatureID},
+    {"TopologyIndex", FaceRefAttr::TopologyIndex},
+    {"U", FaceRefAttr::U},
+    {"V", FaceRefAttr::V},
+    {"Normal", FaceRefAttr::Normal},
+    {"Center", FaceRefAttr::Center},
+    {"SurfaceType", FaceRefAttr::SurfaceType},
+});
+
+constexpr auto kEdgeRefAttrs = MakeAttributeTable<EdgeRefAttr>({
+    {"ParentFeatureID", EdgeRefAttr::ParentFeatureID},
+    {"TopologyIndex", EdgeRefAttr::TopologyIndex},
+    {"StartPoint", EdgeRefAttr::StartPoint},
+    {"EndPoint", EdgeRefAttr::EndPoint},
+    {"MidPoint", EdgeRefAttr::MidPoint},
+    {"CurveType", EdgeRefAttr::CurveType},
+});
+
+constexpr auto kVertexRefAttrs = MakeAttributeTable<VertexRefAttr>({
+    {"ParentFeatureID", VertexRefAttr::ParentFeatureID},
+    {"TopologyIndex", VertexRefAttr::TopologyIndex},
+    {"Position", VertexRefAttr::Position},
+});
+
 struct RefSerializerEntry {
-  using RefSaveFn = std::function<void(
-      XMLElement *, const std::shared_ptr<CRefEntityBase> &)>;
-  using RefLoadFn =
-      std::function<std::shared_ptr<CRefEntityBase>(XMLElement *)>;
+  using RefSaveFn = void (*)(XMLElement *, const std::shared_ptr<CRefEntityBase> &);
+  using RefLoadFn = std::shared_ptr<CRefEntityBase> (*)(XMLElement *);
 
   RefType type;
-  const char *name;
-  const char *lowerName;
   RefSaveFn save;
   RefLoadFn load;
 };
@@ -915,7 +784,7 @@ struct RefSerializerEntry {
  * 通过 RefType 注册对应的序列化函数。
  */
 static const RefSerializerEntry kRefSerializerEntries[] = {
-    {RefType::FEATURE_DATUM_PLANE, "Plane", "plane",
+    {RefType::FEATURE_DATUM_PLANE,
      [](XMLElement *element, const std::shared_ptr<CRefEntityBase> &ref) {
        if (auto plane = std::dynamic_pointer_cast<CRefPlane>(ref)) {
          element->SetAttribute("TargetFeatureID",
@@ -926,21 +795,22 @@ static const RefSerializerEntry kRefSerializerEntries[] = {
          element->SetAttribute("Normal", FormatVector(plane->normal).c_str());
        }
      },
-     [](XMLElement *element) {
+     [](XMLElement *element) -> std::shared_ptr<CRefEntityBase> {
        auto plane = std::make_shared<CRefPlane>();
-       if (const char *tid = element->Attribute("TargetFeatureID"))
+       const AttributeSlots<PlaneRefAttr> attrs(element, kPlaneRefAttrs);
+       if (const char *tid = attrs.Text(PlaneRefAttr::TargetFeatureID))
          plane->targetFeatureID = tid;
-       plane->origin = ParsePointAttribute(element, "Origin");
-       plane->xDir = ParseVectorAttribute(element, "XDir");
-       plane->normal = ParseVectorAttribute(element, "Normal");
-       if (element->Attribute("YDir")) {
-         plane->yDir = ParseVectorAttribute(element, "YDir");
+       plane->origin = ParsePointText(attrs.Text(PlaneRefAttr::Origin));
+       plane->xDir = ParseVectorText(attrs.Text(PlaneRefAttr::XDir));
+       plane->normal = ParseVectorText(attrs.Text(PlaneRefAttr::Normal));
+       if (attrs.Has(PlaneRefAttr::YDir)) {
+         plane->yDir = ParseVectorText(attrs.Text(PlaneRefAttr::YDir));
        } else {
          plane->yDir = ComputePlaneYAxis(plane->normal, plane->xDir);
        }
        return plane;
      }},
-    {RefType::FEATURE_DATUM_AXIS, "Axis", "axis",
+    {RefType::FEATURE_DATUM_AXIS,
      [](XMLElement *element, const std::shared_ptr<CRefEntityBase> &ref) {
        if (auto axis = std::dynamic_pointer_cast<CRefAxis>(ref)) {
          element->SetAttribute("TargetFeatureID", axis->targetFeatureID.c_str());
@@ -948,7 +818,7 @@ static const RefSerializerEntry kRefSerializerEntries[] = {
          element->SetAttribute("Direction", FormatVector(axis->direction).c_str());
        }
      },
-     [](XMLElement *element) {
+     [](XMLElement *element) -> std::shared_ptr<CRefEntityBase> {
        auto axis = std::make_shared<CRefAxis>();
        if (const char *tid = element->Attribute("TargetFeatureID"))
          axis->targetFeatureID = tid;
@@ -956,34 +826,34 @@ static const RefSerializerEntry kRefSerializerEntries[] = {
        axis->direction = ParseVectorAttribute(element, "Direction");
        return axis;
      }},
-    {RefType::FEATURE_DATUM_POINT, "Point", "point",
+    {RefType::FEATURE_DATUM_POINT,
      [](XMLElement *element, const std::shared_ptr<CRefEntityBase> &ref) {
        if (auto pt = std::dynamic_pointer_cast<CRefPoint>(ref)) {
          element->SetAttribute("TargetFeatureID", pt->targetFeatureID.c_str());
          element->SetAttribute("Position", FormatPoint(pt->position).c_str());
        }
      },
-     [](XMLElement *element) {
+     [](XMLElement *element) -> std::shared_ptr<CRefEntityBase> {
        auto pt = std::make_shared<CRefPoint>();
        if (const char *tid = element->Attribute("TargetFeatureID"))
          pt->targetFeatureID = tid;
        pt->position = ParsePointAttribute(element, "Position");
        return pt;
      }},
-    {RefType::FEATURE_WHOLE_SKETCH, "Sketch", "sketch",
+    {RefType::FEATURE_WHOLE_SKETCH,
      [](XMLElement *element, const std::shared_ptr<CRefEntityBase> &ref) {
        if (auto sketch = std::dynamic_pointer_cast<CRefSketch>(ref)) {
          element->SetAttribute("TargetFeatureID",
                                sketch->targetFeatureID.c_str());
        }
      },
-     [](XMLElement *element) {
+     [](XMLElement *element) -> std::shared_ptr<CRefEntityBase> {
        auto sketch = std::make_shared<CRefSketch>();
        if (const char *tid = element->Attribute("TargetFeatureID"))
          sketch->targetFeatureID = tid;
        return sketch;
      }},
-    {RefType::TOPO_FACE, "Face", "face",
+    {RefType::TOPO_FACE,
       [](XMLElement *element, const std::shared_ptr<CRefEntityBase> &ref) {
         if (auto face = std::dynamic_pointer_cast<CRefFace>(ref)) {
           // Legacy compatibility only: TopologyIndex is preserved for old data
@@ -998,22 +868,23 @@ static const RefSerializerEntry kRefSerializerEntries[] = {
          element->SetAttribute("V", FormatVector(face->vDir).c_str());
          element->SetAttribute("Normal", FormatVector(face->normal).c_str());
          element->SetAttribute("Center", FormatPoint(face->centroid).c_str());
-         element->SetAttribute("SurfaceType", SurfaceTypeToString(face->surfaceType).c_str());
+         element->SetAttribute("SurfaceType", SurfaceTypeToString(face->surfaceType));
        }
      },
-     [](XMLElement *element) {
+     [](XMLElement *element) -> std::shared_ptr<CRefEntityBase> {
         auto face = std::make_shared<CRefFace>();
-        if (const char *parent = element->Attribute("ParentFeatureID"))
+        const AttributeSlots<FaceRefAttr> attrs(element, kFaceRefAttrs);
+        if (const char *parent = attrs.Text(FaceRefAttr::ParentFeatureID))
           face->parentFeatureID = parent;
 #ifdef _MSC_VER
 #pragma warning(suppress : 4996)
 #endif
-        element->QueryIntAttribute("TopologyIndex", &face->topologyIndex);
-       face->uDir = ParseVectorAttribute(element, "U");
-       face->vDir = ParseVectorAttribute(element, "V");
-       face->normal = ParseVectorAttribute(element, "Normal");
-       face->centroid = ParsePointAttribute(element, "Center");
-       if (const char *surfaceTypeText = element->Attribute("SurfaceType")) {
+        attrs.QueryInt(FaceRefAttr::TopologyIndex, &face->topologyIndex);
+       face->uDir = ParseVectorText(attrs.Text(FaceRefAttr::U));
+       face->vDir = ParseVectorText(attrs.Text(FaceRefAttr::V));
+       face->normal = ParseVectorText(attrs.Text(FaceRefAttr::Normal));
+       face->centroid = ParsePointText(attrs.Text(FaceRefAttr::Center));
+       if (const char *surfaceTypeText = attrs.Text(FaceRefAttr::SurfaceType)) {
          if (auto mapped = SurfaceTypeFromString(surfaceTypeText)) {
            face->surfaceType = *mapped;
          } else {
@@ -1026,7 +897,7 @@ static const RefSerializerEntry kRefSerializerEntries[] = {
        }
        return face;
      }},
-    {RefType::TOPO_EDGE, "Edge", "edge",
+    {RefType::TOPO_EDGE,
       [](XMLElement *element, const std::shared_ptr<CRefEntityBase> &ref) {
         if (auto edge = std::dynamic_pointer_cast<CRefEdge>(ref)) {
           // Legacy compatibility only: TopologyIndex is preserved for old data
@@ -1041,21 +912,22 @@ static const RefSerializerEntry kRefSerializerEntries[] = {
           element->SetAttribute("EndPoint", FormatPoint(edge->endPoint).c_str());
           element->SetAttribute("MidPoint", FormatPoint(edge->midPoint).c_str());
           element->SetAttribute("CurveType",
-                                CurveTypeToString(edge->curveType).c_str());
+                                CurveTypeToString(edge->curveType));
         }
       },
-      [](XMLElement *element) {
+      [](XMLElement *element) -> std::shared_ptr<CRefEntityBase> {
         auto edge = std::make_shared<CRefEdge>();
-        if (const char *parent = element->Attribute("ParentFeatureID"))
+        const AttributeSlots<EdgeRefAttr> attrs(element, kEdgeRefAttrs);
+        if (const char *parent = attrs.Text(EdgeRefAttr::ParentFeatureID))
           edge->parentFeatureID = parent;
 #ifdef _MSC_VER
 #pragma warning(suppress : 4996)
 #endif
-        element->QueryIntAttribute("TopologyIndex", &edge->topologyIndex);
-        edge->startPoint = ParsePointAttribute(element, "StartPoint");
-        edge->endPoint = ParsePointAttribute(element, "EndPoint");
-        edge->midPoint = ParsePointAttribute(element, "MidPoint");
-        if (const char *curveTypeText = element->Attribute("CurveType")) {
+        attrs.QueryInt(EdgeRefAttr::TopologyIndex, &edge->topologyIndex);
+        edge->startPoint = ParsePointText(attrs.Text(EdgeRefAttr::StartPoint));
+        edge->endPoint = ParsePointText(attrs.Text(EdgeRefAttr::EndPoint));
+        edge->midPoint = ParsePointText(attrs.Text(EdgeRefAttr::MidPoint));
+        if (const char *curveTypeText = attrs.Text(EdgeRefAttr::CurveType)) {
           if (auto mapped = CurveTypeFromString(curveTypeText)) {
             edge->curveType = *mapped;
           } else {
@@ -1068,7 +940,7 @@ static const RefSerializerEntry kRefSerializerEntries[] = {
         }
         return edge;
       }},
-    {RefType::TOPO_VERTEX, "Vertex", "vertex",
+    {RefType::TOPO_VERTEX,
       [](XMLElement *element, const std::shared_ptr<CRefEntityBase> &ref) {
         if (auto vertex = std::dynamic_pointer_cast<CRefVertex>(ref)) {
           // Legacy compatibility only: TopologyIndex is preserved for old data
@@ -1082,18 +954,19 @@ static const RefSerializerEntry kRefSerializerEntries[] = {
          element->SetAttribute("Position", FormatPoint(vertex->pos).c_str());
        }
      },
-     [](XMLElement *element) {
+     [](XMLElement *element) -> std::shared_ptr<CRefEntityBase> {
         auto vertex = std::make_shared<CRefVertex>();
-        if (const char *parent = element->Attribute("ParentFeatureID"))
+        const AttributeSlots<VertexRefAttr> attrs(element, kVertexRefAttrs);
+        if (const char *parent = attrs.Text(VertexRefAttr::ParentFeatureID))
           vertex->parentFeatureID = parent;
 #ifdef _MSC_VER
 #pragma warning(suppress : 4996)
 #endif
-        element->QueryIntAttribute("TopologyIndex", &vertex->topologyIndex);
-       vertex->pos = ParsePointAttribute(element, "Position");
+        attrs.QueryInt(VertexRefAttr::TopologyIndex, &vertex->topologyIndex);
+       vertex->pos = ParsePointText(attrs.Text(VertexRefAttr::Position));
        return vertex;
      }},
-    {RefType::TOPO_SKETCH_SEG, "SketchSeg", "sketchseg",
+    {RefType::TOPO_SKETCH_SEG,
       [](XMLElement *element, const std::shared_ptr<CRefEntityBase> &ref) {
         if (auto seg = std::dynamic_pointer_cast<CRefSketchSeg>(ref)) {
           // Legacy compatibility only: TopologyIndex is preserved for old data
@@ -1107,7 +980,7 @@ static const RefSerializerEntry kRefSerializerEntries[] = {
            element->SetAttribute("SegmentLocalID", seg->segmentLocalID.c_str());
        }
      },
-     [](XMLElement *element) {
+     [](XMLElement *element) -> std::shared_ptr<CRefEntityBase> {
         auto seg = std::make_shared<CRefSketchSeg>();
         if (const char *parent = element->Attribute("ParentFeatureID"))
           seg->parentFeatureID = parent;
@@ -1128,29 +1001,30 @@ const RefSerializerEntry *FindRefEntry(RefType type) {
   return nullptr;
 }
 
-const RefSerializerEntry *FindRefEntryByName(const std::string &value) {
-  for (const auto &entry : kRefSerializerEntries) {
-    if (value == entry.lowerName)
-      return &entry;
-  }
-  return nullptr;
-}
+constexpr auto kRefTypeNames = MakeNameTable<RefType>({
+    {"Plane", RefType::FEATURE_DATUM_PLANE},
+    {"Axis", RefType::FEATURE_DATUM_AXIS},
+    {"Point", RefType::FEATURE_DATUM_POINT},
+    {"Sketch", RefType::FEATURE_WHOLE_SKETCH},
+    {"Face", RefType::TOPO_FACE},
+    {"Edge", RefType::TOPO_EDGE},
+    {"Vertex", RefType::TOPO_VERTEX},
+    {"SketchSeg", RefType::TOPO_SKETCH_SEG},
+});
+
+// 旧版文件中的泛化特征引用，只读取不写出。
+constexpr auto kLegacyFeatureRefNames = MakeNameTable<RefType>({
+    {"Feature", RefType::FEATURE_DATUM_PLANE},
+    {"FeatureRef", RefType::UNKNOWN},
+});
 
-std::string RefTypeToString(RefType type) {
-  if (auto entry = FindRefEntry(type))
-    return entry->name;
-  if (type == RefType::UNKNOWN)
-    return "FeatureRef";
-  return "Unknown";
+const char *RefTypeToString(RefType type) {
+  return kRefTypeNames.NameOf(type,
+                              type == RefType::UNKNOWN ? "FeatureRef" : "Unknown");
 }
 
 std::optional<RefType> RefTypeFromString(const char *text) {
-  if (!text)
-    return std::nullopt;
-  std::string value = ToLower(text);
-  if (auto entry = FindRefEntryByName(value))
-    return entry->type;
-  return std::nullopt;
+  return kRefTypeNames.Parse(text);
 }
 
 void TinyXMLSerializer::SaveRefEntity(
@@ -1164,66 +1038,40 @@ void TinyXMLSerializer::SaveRefEntity(
 
   if (auto entry = FindRefEntry(ref->refType)) {
     entry->save(refElem, ref);
-    refElem->SetAttribute("Type", entry->name);
   } else {
     SaveFeatureReference(refElem, ref);
-    refElem->SetAttribute("Type", RefTypeToString(ref->refType).c_str());
   }
+  refElem->SetAttribute("Type", RefTypeToString(ref->refType));
 }
 
 // ---------------------------------------------------------------------------
 // ShellThicknessDirection enum ↔ string
 // ---------------------------------------------------------------------------
-std::string ShellThicknessDirectionToString(ShellThicknessDirection direction) {
-  switch (direction) {
-  case ShellThicknessDirection::Inward:
-    return "Inward";
-  case ShellThicknessDirection::Outward:
-    return "Outward";
-  case ShellThicknessDirection::Unknown:
-    return "Unknown";
-  }
-  return "Unknown";
+constexpr auto kShellThicknessDirectionNames = MakeNameTable<ShellThicknessDirection>({
+    {"Inward", ShellThicknessDirection::Inward},
+    {"Outward", ShellThicknessDirection::Outward},
+});
+
+const char *ShellThicknessDirectionToString(ShellThicknessDirection direction) {
+  return kShellThicknessDirectionNames.NameOf(direction, "Unknown");
 }
 
 std::optional<ShellThicknessDirection>
 ShellThicknessDirectionFromString(const char *text) {
-  if (!text) {
-    return std::nullopt;
-  }
-  const std::string value = ToLower(text);
-  if (value == "inward") {
-    return ShellThicknessDirection::Inward;
-  }
-  if (value == "outward") {
-    return ShellThicknessDirection::Outward;
-  }
-  return std::nullopt;
+  return kShellThicknessDirectionNames.Parse(text);
 }
 
-std::string DraftTypeToString(DraftType type) {
-  switch (type) {
-  case DraftType::NeutralPlane:
-    return "NeutralPlane";
-  case DraftType::PartingLine:
-    return "PartingLine";
-  default:
-    return "Unknown";
-  }
+constexpr auto kDraftTypeNames = MakeNameTable<DraftType>({
+    {"NeutralPlane", DraftType::NeutralPlane},
+    {"PartingLine", DraftType::PartingLine},
+});
+
+const char *DraftTypeToString(DraftType type) {
+  return kDraftTypeNames.NameOf(type, "Unknown");
 }
 
 std::optional<DraftType> DraftTypeFromString(const char *text) {
-  if (!text) {
-    return std::nullopt;
-  }
-  const std::string value = ToLower(text);
-  if (value == "neutralplane") {
-    return DraftType::NeutralPlane;
-  }
-  if (value == "partingline") {
-    return DraftType::PartingLine;
-  }
-  return std::nullopt;
+  return kDraftTypeNames.Parse(text);
 }
 
 void TinyXMLSerializer::SaveFeature(
@@ -1340,7 +1188,7 @@ void TinyXMLSerializer::SaveSketchSeg(XMLDocument &doc, XMLElement *parent,
   parent->InsertEndChild(segElem);
 
   segElem->SetAttribute("LocalID", seg->localID.c_str());
-  segElem->SetAttribute("Type", SegTypeToString(seg->type).c_str());
+  segElem->SetAttribute("Type", SegTypeToString(seg->type));
 
   if (seg->type != CSketchSeg::SegType::POINT) {
     segElem->SetAttribute("Construction", seg->isConstruction);
@@ -1398,12 +1246,12 @@ void TinyXMLSerializer::SaveExtrude(XMLDocument &doc, XMLElement *element,
   element->InsertEndChild(directionElem);
 
   element->SetAttribute("Operation",
-                        BooleanOpToString(extrude->operation).c_str());
+                        BooleanOpToString(extrude->operation));
 
   // 统一写 extent 结构，保持 Extrude/Revolve 的共享语义。
   auto saveExtent = [&](const char *tag, const SweepExtent &extent) {
     XMLElement *elem = doc.NewElement(tag);
-    elem->SetAttribute("Type", SweepExtentTypeToString(extent.type).c_str());
+    elem->SetAttribute("Type", SweepExtentTypeToString(extent.type));
     elem->SetAttribute("Value", extent.value);
     elem->SetAttribute("Offset", extent.offset);
     elem->SetAttribute("HasOffset", extent.hasOffset);
@@ -1438,11 +1286,11 @@ void TinyXMLSerializer::SaveRevolve(XMLDocument &doc, XMLElement *element,
   if (!revolve->profileSketchID.empty())
     element->SetAttribute("ProfileSketchID", revolve->profileSketchID.c_str());
   element->SetAttribute("Operation",
-                        BooleanOpToString(revolve->operation).c_str());
+                        BooleanOpToString(revolve->operation));
 
   auto saveExtent = [&](const char *tag, const SweepExtent &extent) {
     XMLElement *elem = doc.NewElement(tag);
-    elem->SetAttribute("Type", SweepExtentTypeToString(extent.type).c_str());
+    elem->SetAttribute("Type", SweepExtentTypeToString(extent.type));
     elem->SetAttribute("Value", extent.value);
     elem->SetAttribute("Offset", extent.offset);
     elem->SetAttribute("HasOffset", extent.hasOffset);
@@ -1503,19 +1351,19 @@ void TinyXMLSerializer::SaveSweep(XMLDocument &doc, XMLElement *element,
     element->SetAttribute("ProfileSketchID", sweep->profileSketchID.c_str());
   }
   element->SetAttribute("Operation",
-                        BooleanOpToString(sweep->operation).c_str());
+                        BooleanOpToString(sweep->operation));
   element->SetAttribute(
-      "Orientation", SweepPathOrientationToString(sweep->orientation).c_str());
+      "Orientation", SweepPathOrientationToString(sweep->orientation));
   element->SetAttribute(
       "SectionPlacement",
-      SweepSectionPlacementToString(sweep->sectionPlacement).c_str());
+      SweepSectionPlacementToString(sweep->sectionPlacement));
   if (sweep->profilePathAngleCos) {
     element->SetAttribute("ProfilePathAngleCos", *sweep->profilePathAngleCos);
   }
 
   XMLElement *profileElem = doc.NewElement("Profile");
   profileElem->SetAttribute("Kind",
-                            SweepProfileKindToString(sweep->profile.kind).c_str());
+                            SweepProfileKindToString(sweep->profile.kind));
   switch (sweep->profile.kind) {
   case SweepProfileKind::SketchReference:
     profileElem->SetAttribute("SketchID",
@@ -1596,7 +1444,7 @@ void TinyXMLSerializer::SaveSweep(XMLDocument &doc, XMLElement *element,
 void TinyXMLSerializer::SaveDatumPlane(
     XMLDocument &doc, XMLElement *element,
     const std::shared_ptr<CDatumPlane> &datumPlane) {
-  element->SetAttribute("Method", PlaneMethodToString(datumPlane->method).c_str());
+  element->SetAttribute("Method", PlaneMethodToString(datumPlane->method));
   if (datumPlane->projectedOrigin.has_value()) {
     element->SetAttribute(
         "ProjectedOrigin",
@@ -1623,7 +1471,7 @@ void TinyXMLSerializer::SaveDatumPlane(
   for (const auto &constraint : datumPlane->constraints) {
     XMLElement *constraintElem = doc.NewElement("Constraint");
     constraintElem->SetAttribute(
-        "Type", PlaneConstraintTypeToString(constraint.type).c_str());
+        "Type", PlaneConstraintTypeToString(constraint.type));
     constraintElem->SetAttribute("Ref", constraint.ref);
     constraintElem->SetAttribute("Value", constraint.value);
     constraintElem->SetAttribute("Reversed", constraint.reversed);
@@ -1636,7 +1484,7 @@ void TinyXMLSerializer::SaveDatumPlane(
 
 void TinyXMLSerializer::SaveChamfer(XMLDocument &doc, XMLElement *element,
                                     const std::shared_ptr<CChamfer> &chamfer) {
-  element->SetAttribute("Mode", ChamferModeToString(chamfer->mode).c_str());
+  element->SetAttribute("Mode", ChamferModeToString(chamfer->mode));
   if (chamfer->firstEndFaceMarker.has_value()) {
     SavePoint3D(element, "FirstEndFaceMarker", *chamfer->firstEndFaceMarker);
   }
@@ -1741,7 +1589,7 @@ void TinyXMLSerializer::SaveShell(XMLDocument &doc, XMLElement *element,
                                    const std::shared_ptr<CShell> &shell) {
   element->SetAttribute("Thickness", shell->thickness);
   element->SetAttribute("Direction",
-                        ShellThicknessDirectionToString(shell->direction).c_str());
+                        ShellThicknessDirectionToString(shell->direction));
 
   // FacesToRemove
   if (!shell->facesToRemove.empty()) {
@@ -1783,7 +1631,7 @@ void TinyXMLSerializer::SaveShell(XMLDocument &doc, XMLElement *element,
 
 void TinyXMLSerializer::SaveDraft(XMLDocument &doc, XMLElement *element,
                                   const std::shared_ptr<CDraft> &draft) {
-  element->SetAttribute("DraftType", DraftTypeToString(draft->draftType).c_str());
+  element->SetAttribute("DraftType", DraftTypeToString(draft->draftType));
   element->SetAttribute("ReversePullDirection", draft->reversePullDirection);
   element->SetAttribute("DraftAngle", draft->draftAngle);
   element->SetAttribute("IsTwoSided", draft->isTwoSided);
@@ -1841,12 +1689,12 @@ void TinyXMLSerializer::SaveFillet(XMLDocument &doc, XMLElement *element,
                fillet->featureID.c_str(), static_cast<int>(fillet->mode),
                static_cast<int>(fillet->referenceMode), fillet->references.size(),
                fillet->params.radiusPoints.size());
-  element->SetAttribute("Mode", FilletModeToString(fillet->mode).c_str());
+  element->SetAttribute("Mode", FilletModeToString(fillet->mode));
   if (fillet->referenceMode != FilletReferenceMode::UNKNOWN &&
       fillet->referenceMode != FilletReferenceMode::EDGE_CHAIN) {
     element->SetAttribute(
         "ReferenceMode",
-        FilletReferenceModeToString(fillet->referenceMode).c_str());
+        FilletReferenceModeToString(fillet->referenceMode));
   }
   if (fillet->params.secondValue.has_value() &&
       fillet->firstEndFaceMarker.has_value()) {
@@ -1857,7 +1705,7 @@ void TinyXMLSerializer::SaveFillet(XMLDocument &doc, XMLElement *element,
 
   XMLElement *paramsElem = doc.NewElement("Parameters");
   paramsElem->SetAttribute("DriveType",
-                           FilletDriveTypeToString(fillet->params.driveType).c_str());
+                           FilletDriveTypeToString(fillet->params.driveType));
   if (fillet->params.primaryValue.has_value()) {
     paramsElem->SetAttribute("PrimaryValue", *fillet->params.primaryValue);
   }
@@ -1867,7 +1715,7 @@ void TinyXMLSerializer::SaveFillet(XMLDocument &doc, XMLElement *element,
   if (fillet->params.crossSection != FilletCrossSection::UNKNOWN) {
     paramsElem->SetAttribute(
         "CrossSection",
-        FilletCrossSectionToString(fillet->params.crossSection).c_str());
+        FilletCrossSectionToString(fillet->params.crossSection));
   }
   paramsElem->SetAttribute("TangentPropagation", fillet->params.tangentPropagation);
   const bool emitConicValue =
@@ -1878,7 +1726,7 @@ void TinyXMLSerializer::SaveFillet(XMLDocument &doc, XMLElement *element,
       fillet->params.conicValueMode != FilletConicValueMode::NONE) {
     paramsElem->SetAttribute(
         "ConicValueMode",
-        FilletConicValueModeToString(fillet->params.conicValueMode).c_str());
+        FilletConicValueModeToString(fillet->params.conicValueMode));
   }
   if (emitConicValue && fillet->params.conicValue.has_value()) {
     paramsElem->SetAttribute("ConicValue", *fillet->params.conicValue);
@@ -1962,15 +1810,57 @@ void TinyXMLSerializer::SaveFillet(XMLDocument &doc, XMLElement *element,
 
 bool TinyXMLSerializer::Load(UnifiedModel &model,
                              const std::filesystem::path &filePath,
-                             std::string *errorMessage) {
-  XMLDocument doc;
+                             std::string *errorMessage, LoadPipeline *pipeline,
+                             SerializerContext *context) {
+  std::optional<XMLDocument> local;
+  XMLDocument &doc =
+      context ? context->AcquireDocument(FileBytes(filePath)) : local.emplace();
   XMLError result = doc.LoadFile(filePath.string().c_str());
   if (result != XML_SUCCESS) {
     if (errorMessage)
       *errorMessage = doc.ErrorStr();
     return false;
   }
+  return ReadDocument(doc, model, errorMessage, pipeline);
+}
+
+bool TinyXMLSerializer::Load(UnifiedModel &model, std::istream &input,
+                             std::string *errorMessage, LoadPipeline *pipeline,
+                             SerializerContext *context) {
+  std::string localXml;
+  std::string &xml = context ? context->AcquireReadBuffer() : localXml;
+  char chunk[64 * 1024];
+  while (input.read(chunk, sizeof(chunk)) || input.gcount() > 0) {
+    xml.append(chunk, static_cast<std::size_t>(input.gcount()));
+  }
+  if (input.bad()) {
+    if (errorMessage)
+      *errorMessage = "Failed to read XML from input stream.";
+    return false;
+  }
+  return LoadFromBuffer(model, xml, errorMessage, pipeline, context);
+}
+
+bool TinyXMLSerializer::LoadFromBuffer(UnifiedModel &model,
+                                       std::string_view xml,
+                                       std::string *errorMessage,
+                                       LoadPipeline *pipeline,
+                                       SerializerContext *context) {
+  std::optional<XMLDocument> local;
+  XMLDocument &doc =
+      context ? context->AcquireDocument(xml.size()) : local.emplace();
+  XMLError result = doc.Parse(xml.data(), xml.size());
+  if (result != XML_SUCCESS) {
+    if (errorMessage)
+      *errorMessage = doc.ErrorStr();
+    return false;
+  }
+  return ReadDocument(doc, model, errorMessage, pipeline);
+}
 
+bool TinyXMLSerializer::ReadDocument(XMLDocument &doc, UnifiedModel &model,
+                                     std::string *errorMessage,
+                                     LoadPipeline *pipeline) {
   XMLElement *root = doc.FirstChildElement("UnifiedModel");
   if (!root) {
     if (errorMessage)
@@ -1998,12 +1888,16 @@ bool TinyXMLSerializer::Load(UnifiedModel &model,
     model.modelName = name;
 
   model.Clear();
+  if (pipeline)
+    pipeline->Begin(model.unit);
 
   XMLElement *featElem = root->FirstChildElement("Feature");
   while (featElem) {
     auto feature = LoadFeature(featElem);
     if (feature) {
       model.AddFeature(feature);
+      if (pipeline)
+        pipeline->Accept(feature);
     } else {
       // 严格模式：记录跳过原因（Type 未知或 ID 缺失）
       const char *typeStr = featElem->Attribute("Type");
@@ -2050,7 +1944,6 @@ TinyXMLSerializer::LoadRefEntity(XMLElement *element) {
   const char *typeStr = element->Attribute("Type");
   if (!typeStr)
     return nullptr;
-  std::string normalizedType = ToLower(typeStr);
   std::shared_ptr<CRefEntityBase> ref;
   std::optional<RefType> resolvedType = RefTypeFromString(typeStr);
 
@@ -2063,96 +1956,81 @@ TinyXMLSerializer::LoadRefEntity(XMLElement *element) {
     }
   }
 
-  if (!ref && normalizedType == "feature")
-    ref = LoadFeatureReference(element, RefType::FEATURE_DATUM_PLANE);
-
-  if (!ref && normalizedType == "featureref")
-    ref = LoadFeatureReference(element, RefType::UNKNOWN);
+  if (!ref) {
+    if (auto legacyType = kLegacyFeatureRefNames.Find(typeStr))
+      ref = LoadFeatureReference(element, *legacyType);
+  }
 
   if (ref && resolvedType)
     ref->refType = *resolvedType;
   return ref;
 }
 
+namespace {
+
+using FeatureLoadFn = std::shared_ptr<CFeatureBase> (*)(XMLElement *);
+
+template <typename T, void (*Load)(XMLElement *, std::shared_ptr<T> &)>
+std::shared_ptr<CFeatureBase> LoadFeatureAs(XMLElement *element) {
+  auto feature = std::make_shared<T>();
+  Load(element, feature);
+  return feature;
+}
+
+enum class FeatureAttr : std::uint8_t { Type, ID, Name, Suppressed, Count };
+
+constexpr auto kFeatureAttrs = MakeAttributeTable<FeatureAttr>({
+    {"Type", FeatureAttr::Type},
+    {"ID", FeatureAttr::ID},
+    {"Name", FeatureAttr::Name},
+    {"Suppressed", FeatureAttr::Suppressed},
+});
+
+} // namespace
+
 std::shared_ptr<CFeatureBase>
 TinyXMLSerializer::LoadFeature(XMLElement *element) {
-  const char *typeStr = element->Attribute("Type");
-  if (!typeStr)
+  // Feature 的 Type 一直按原样比较（大小写敏感）。
+  static constexpr auto kFeatureLoaders = MakeNameTable<FeatureLoadFn, NameCase::Sensitive>({
+      {"Sketch", &LoadFeatureAs<CSketch, &LoadSketch>},
+      {"Extrude", &LoadFeatureAs<CExtrude, &LoadExtrude>},
+      {"Revolve", &LoadFeatureAs<CRevolve, &LoadRevolve>},
+      {"Sweep", &LoadFeatureAs<CSweep, &LoadSweep>},
+      {"Fillet", &LoadFeatureAs<CFillet, &LoadFillet>},
+      {"Chamfer", &LoadFeatureAs<CChamfer, &LoadChamfer>},
+      {"Rib", &LoadFeatureAs<CRib, &LoadRib>},
+      {"Shell", &LoadFeatureAs<CShell, &LoadShell>},
+      {"Draft", &LoadFeatureAs<CDraft, &LoadDraft>},
+      {"DatumPlane", &LoadFeatureAs<CDatumPlane, &LoadDatumPlane>},
+      {"LinearPattern", &LoadFeatureAs<CLinearPattern, &LoadLinearPattern>},
+      {"CircularPattern", &LoadFeatureAs<CCircularPattern, &LoadCircularPattern>},
+      {"MirrorPattern", &LoadFeatureAs<CMirrorPattern, &LoadMirrorPattern>},
+  });
+
+  const AttributeSlots<FeatureAttr> attrs(element, kFeatureAttrs);
+  const char *type = attrs.Text(FeatureAttr::Type);
+  if (!type)
     return nullptr; // 无 Type，调用方会打印 warn
-  std::string type = typeStr;
-
-  std::shared_ptr<CFeatureBase> feature;
-
-  if (type == "Sketch") {
-    auto sketch = std::make_shared<CSketch>();
-    LoadSketch(element, sketch);
-    feature = sketch;
-  } else if (type == "Extrude") {
-    auto extrude = std::make_shared<CExtrude>();
-    LoadExtrude(element, extrude);
-    feature = extrude;
-  } else if (type == "Revolve") {
-    auto revolve = std::make_shared<CRevolve>();
-    LoadRevolve(element, revolve);
-    feature = revolve;
-  } else if (type == "Sweep") {
-    auto sweep = std::make_shared<CSweep>();
-    LoadSweep(element, sweep);
-    feature = sweep;
-  } else if (type == "Fillet") {
-    auto fillet = std::make_shared<CFillet>();
-    LoadFillet(element, fillet);
-    feature = fillet;
-  } else if (type == "Chamfer") {
-    auto chamfer = std::make_shared<CChamfer>();
-    LoadChamfer(element, chamfer);
-    feature = chamfer;
-  } else if (type == "Rib") {
-    auto rib = std::make_shared<CRib>();
-    LoadRib(element, rib);
-    feature = rib;
-  } else if (type == "Shell") {
-    auto shell = std::make_shared<CShell>();
-    LoadShell(element, shell);
-    feature = shell;
-  } else if (type == "Draft") {
-    auto draft = std::make_shared<CDraft>();
-    LoadDraft(element, draft);
-    feature = draft;
-  } else if (type == "DatumPlane") {
-    auto datumPlane = std::make_shared<CDatumPlane>();
-    LoadDatumPlane(element, datumPlane);
-    feature = datumPlane;
-  } else if (type == "LinearPattern") {
-    auto linearPattern = std::make_shared<CLinearPattern>();
-    LoadLinearPattern(element, linearPattern);
-    feature = linearPattern;
-  } else if (type == "CircularPattern") {
-    auto circularPattern = std::make_shared<CCircularPattern>();
-    LoadCircularPattern(element, circularPattern);
-    feature = circularPattern;
-  } else if (type == "MirrorPattern") {
-    auto mirrorPattern = std::make_shared<CMirrorPattern>();
-    LoadMirrorPattern(element, mirrorPattern);
-    feature = mirrorPattern;
-  } else {
+  const FeatureLoadFn *load = kFeatureLoaders.Find(type);
+  if (!load)
     return nullptr; // 未知 Type，调用方会打印 warn
-  }
+
+  std::shared_ptr<CFeatureBase> feature = (*load)(element);
 
   if (feature) {
-    const char *id = element->Attribute("ID");
-    if (!id || std::string(id).empty()) {
+    const char *id = attrs.Text(FeatureAttr::ID);
+    if (!id || *id == '\0') {
       // 严格模式：ID 缺失或为空，丢弃该特征
       std::cerr << "[TinyXMLSerializer][WARN] Feature Type=" << type
                 << " has missing or empty ID — skipped.\n";
       return nullptr;
     }
     feature->featureID = id;
-    const char *name = element->Attribute("Name");
+    const char *name = attrs.Text(FeatureAttr::Name);
     if (name)
       feature->featureName = name;
     bool suppressed = false;
-    element->QueryBoolAttribute("Suppressed", &suppressed);
+    attrs.QueryBool(FeatureAttr::Suppressed, &suppressed);
     feature->isSuppressed = suppressed;
   }
   return feature;
@@ -2202,23 +2080,36 @@ void TinyXMLSerializer::LoadSketch(XMLElement *element,
 
 std::shared_ptr<CSketchSeg>
 TinyXMLSerializer::LoadSketchSeg(XMLElement *element) {
+  // Segment 的 Type 按原样比较（大小写敏感），样条段尚无读取实现。
+  static constexpr auto kSegKinds =
+      MakeNameTable<CSketchSeg::SegType, NameCase::Sensitive>({
+          {"Line", CSketchSeg::SegType::LINE},
+          {"Circle", CSketchSeg::SegType::CIRCLE},
+          {"Arc", CSketchSeg::SegType::ARC},
+          {"Point", CSketchSeg::SegType::POINT},
+      });
   const char *typeStr = element->Attribute("Type");
-  if (!typeStr)
+  const CSketchSeg::SegType *kind = typeStr ? kSegKinds.Find(typeStr) : nullptr;
+  if (!kind)
     return nullptr;
-  std::string type = typeStr;
 
   std::shared_ptr<CSketchSeg> seg;
-  if (type == "Line") {
+  switch (*kind) {
+  case CSketchSeg::SegType::LINE: {
     auto line = std::make_shared<CSketchLine>();
     line->startPos = LoadPoint3D(element, "Start");
     line->endPos = LoadPoint3D(element, "End");
     seg = line;
-  } else if (type == "Circle") {
+    break;
+  }
+  case CSketchSeg::SegType::CIRCLE: {
     auto circle = std::make_shared<CSketchCircle>();
     circle->center = LoadPoint3D(element, "Center");
     element->QueryDoubleAttribute("Radius", &circle->radius);
     seg = circle;
-  } else if(type == "Arc") {
+    break;
+  }
+  case CSketchSeg::SegType::ARC: {
     auto arc = std::make_shared<CSketchArc>();
     arc->center = LoadPoint3D(element, "Center");
     element->QueryDoubleAttribute("Radius", &arc->radius);
@@ -2228,12 +2119,17 @@ TinyXMLSerializer::LoadSketchSeg(XMLElement *element) {
     element->QueryBoolAttribute("Clockwise", &clockwise);
     arc->isClockwise = clockwise;
     seg = arc;
-  } else if (type == "Point") {
+    break;
+  }
+  case CSketchSeg::SegType::POINT: {
     auto pt = std::make_shared<CSketchPoint>();
     pt->position = LoadPoint3D(element, "Position");
     seg = pt;
+    break;
+  }
+  default:
+    break;
   }
-  // ... others
 
   if (seg) {
     const char *lid = element->Attribute("LocalID");
@@ -2427,38 +2323,65 @@ void TinyXMLSerializer::LoadRevolve(XMLElement *element,
   }
 }
 
+namespace {
+
+enum class SweepAttr : std::uint8_t {
+  ProfileSketchID, Operation, Orientation, SectionPlacement, ProfilePathAngleCos, Count
+};
+enum class SweepProfileAttr : std::uint8_t { Kind, SketchID, OuterRadius, InnerRadius, Count };
+
+constexpr auto kSweepAttrs = MakeAttributeTable<SweepAttr>({
+    {"ProfileSketchID", SweepAttr::ProfileSketchID},
+    {"Operation", SweepAttr::Operation},
+    {"Orientation", SweepAttr::Orientation},
+    {"SectionPlacement", SweepAttr::SectionPlacement},
+    {"ProfilePathAngleCos", SweepAttr::ProfilePathAngleCos},
+});
+
+constexpr auto kSweepProfileAttrs = MakeAttributeTable<SweepProfileAttr>({
+    {"Kind", SweepProfileAttr::Kind},
+    {"SketchID", SweepProfileAttr::SketchID},
+    {"OuterRadius", SweepProfileAttr::OuterRadius},
+    {"InnerRadius", SweepProfileAttr::InnerRadius},
+});
+
+} // namespace
+
 void TinyXMLSerializer::LoadSweep(XMLElement *element,
                                   std::shared_ptr<CSweep> &sweep) {
-  if (const char *v = element->Attribute("ProfileSketchID")) {
+  const AttributeSlots<SweepAttr> attrs(element, kSweepAttrs);
+  if (const char *v = attrs.Text(SweepAttr::ProfileSketchID)) {
     sweep->profileSketchID = v;
     sweep->profile.kind = SweepProfileKind::SketchReference;
     sweep->profile.sketchID = v;
   }
 
-  if (auto opOpt = BooleanOpFromString(element->Attribute("Operation"))) {
+  if (auto opOpt = BooleanOpFromString(attrs.Text(SweepAttr::Operation))) {
     sweep->operation = *opOpt;
   }
   if (auto orientation =
-          SweepPathOrientationFromString(element->Attribute("Orientation"))) {
+          SweepPathOrientationFromString(attrs.Text(SweepAttr::Orientation))) {
     sweep->orientation = *orientation;
   }
   if (auto placement =
-          SweepSectionPlacementFromString(element->Attribute("SectionPlacement"))) {
+          SweepSectionPlacementFromString(attrs.Text(SweepAttr::SectionPlacement))) {
     sweep->sectionPlacement = *placement;
   }
   double angleCos = 0.0;
-  if (element->QueryDoubleAttribute("ProfilePathAngleCos", &angleCos) ==
-      XML_SUCCESS) {
+  if (attrs.QueryDouble(SweepAttr::ProfilePathAngleCos, &angleCos)) {
     sweep->profilePathAngleCos = angleCos;
   }
 
   if (auto *profileElem = element->FirstChildElement("Profile")) {
-    if (auto kind = SweepProfileKindFromString(profileElem->Attribute("Kind"))) {
+    const AttributeSlots<SweepProfileAttr> profileAttrs(profileElem,
+                                                        kSweepProfileAttrs);
+    if (auto kind =
+            SweepProfileKindFromString(profileAttrs.Text(SweepProfileAttr::Kind))) {
       sweep->profile.kind = *kind;
     }
     switch (sweep->profile.kind) {
     case SweepProfileKind::SketchReference:
-      if (const char *id = profileElem->Attribute("SketchID")) {
+      if (const char *id = profileAttrs.Text(SweepProfileAttr::SketchID)) {
         sweep->profile.sketchID = id;
         sweep->profileSketchID = id;
       }
@@ -2474,8 +2397,8 @@ void TinyXMLSerializer::LoadSweep(XMLElement *element,
       break;
     case SweepProfileKind::Circular: {
       CSweepCircularProfile circular;
-      profileElem->QueryDoubleAttribute("OuterRadius", &circular.outerRadius);
-      profileElem->QueryDoubleAttribute("InnerRadius", &circular.innerRadius);
+      profileAttrs.QueryDouble(SweepProfileAttr::OuterRadius, &circular.outerRadius);
+      profileAttrs.QueryDouble(SweepProfileAttr::InnerRadius, &circular.innerRadius);
       sweep->profile.circular = circular;
       break;
     }
@@ -2807,84 +2730,142 @@ void TinyXMLSerializer::LoadDraft(XMLElement *element,
 }
 
 
+namespace {
+
+enum class FilletAttr : std::uint8_t { Mode, ReferenceMode, FirstEndFaceMarker, Count };
+
+// Default*、CurvatureContinuous 以及参数上的 ReferenceMode 是历史写法。
+enum class FilletParamAttr : std::uint8_t {
+  DriveType, CrossSection, TangentPropagation, ConicValueMode, PrimaryValue,
+  SecondValue, DefaultRadius, DefaultDistance, DefaultDistance2, DefaultRadius2,
+  ConicValue, ReferenceMode, CurvatureContinuous, Count
+};
+
+// Radius*、Distance* 是 RadiusItem 时代的别名。
+enum class FilletPointAttr : std::uint8_t {
+  Position, PrimaryValue, SecondValue, Radius1, Radius, Distance1, Distance,
+  Distance2, Radius2, EdgeMidPoint, Count
+};
+
+enum class FilletVendorAttr : std::uint8_t {
+  SwKeepFeatures, SwOverflowType, CreoAttachType, CreoConicDepOption, Count
+};
+
+constexpr auto kFilletAttrs = MakeAttributeTable<FilletAttr>({
+    {"Mode", FilletAttr::Mode},
+    {"ReferenceMode", FilletAttr::ReferenceMode},
+    {"FirstEndFaceMarker", FilletAttr::FirstEndFaceMarker},
+});
+
+constexpr auto kFilletParamAttrs = MakeAttributeTable<FilletParamAttr>({
+    {"DriveType", FilletParamAttr::DriveType},
+    {"CrossSection", FilletParamAttr::CrossSection},
+    {"TangentPropagation", FilletParamAttr::TangentPropagation},
+    {"ConicValueMode", FilletParamAttr::ConicValueMode},
+    {"PrimaryValue", FilletParamAttr::PrimaryValue},
+    {"SecondValue", FilletParamAttr::SecondValue},
+    {"DefaultRadius", FilletParamAttr::DefaultRadius},
+    {"DefaultDistance", FilletParamAttr::DefaultDistance},
+    {"DefaultDistance2", FilletParamAttr::DefaultDistance2},
+    {"DefaultRadius2", FilletParamAttr::DefaultRadius2},
+    {"ConicValue", FilletParamAttr::ConicValue},
+    {"ReferenceMode", FilletParamAttr::ReferenceMode},
+    {"CurvatureContinuous", FilletParamAttr::CurvatureContinuous},
+});
+
+constexpr auto kFilletPointAttrs = MakeAttributeTable<FilletPointAttr>({
+    {"Position", FilletPointAttr::Position},
+    {"PrimaryValue", FilletPointAttr::PrimaryValue},
+    {"SecondValue", FilletPointAttr::SecondValue},
+    {"Radius1", FilletPointAttr::Radius1},
+    {"Radius", FilletPointAttr::Radius},
+    {"Distance1", FilletPointAttr::Distance1},
+    {"Distance", FilletPointAttr::Distance},
+    {"Distance2", FilletPointAttr::Distance2},
+    {"Radius2", FilletPointAttr::Radius2},
+    {"EdgeMidPoint", FilletPointAttr::EdgeMidPoint},
+});
+
+constexpr auto kFilletVendorAttrs = MakeAttributeTable<FilletVendorAttr>({
+    {"SwKeepFeatures", FilletVendorAttr::SwKeepFeatures},
+    {"SwOverflowType", FilletVendorAttr::SwOverflowType},
+    {"CreoAttachType", FilletVendorAttr::CreoAttachType},
+    {"CreoConicDepOption", FilletVendorAttr::CreoConicDepOption},
+});
+
+} // namespace
+
 void TinyXMLSerializer::LoadFillet(XMLElement *element,
                                    std::shared_ptr<CFillet> &fillet) {
+  const AttributeSlots<FilletAttr> attrs(element, kFilletAttrs);
   int intValue = 0;
-  if (auto mode = FilletModeFromString(element->Attribute("Mode"))) {
+  if (auto mode = FilletModeFromString(attrs.Text(FilletAttr::Mode))) {
     fillet->mode = *mode;
-  } else if (element->QueryIntAttribute("Mode", &intValue) == XML_SUCCESS) {
+  } else if (attrs.QueryInt(FilletAttr::Mode, &intValue)) {
     fillet->mode = static_cast<FilletMode>(intValue);
   }
   if (auto referenceMode =
-          FilletReferenceModeFromString(element->Attribute("ReferenceMode"))) {
+          FilletReferenceModeFromString(attrs.Text(FilletAttr::ReferenceMode))) {
     fillet->referenceMode = *referenceMode;
-  } else if (element->QueryIntAttribute("ReferenceMode", &intValue) ==
-             XML_SUCCESS) {
+  } else if (attrs.QueryInt(FilletAttr::ReferenceMode, &intValue)) {
     fillet->referenceMode = static_cast<FilletReferenceMode>(intValue);
   }
-  if (element->Attribute("FirstEndFaceMarker")) {
+  if (attrs.Has(FilletAttr::FirstEndFaceMarker)) {
     fillet->firstEndFaceMarker =
-        LoadPoint3D(element, "FirstEndFaceMarker");
+        ParsePointText(attrs.Text(FilletAttr::FirstEndFaceMarker));
   }
 
   if (XMLElement *paramsElem = element->FirstChildElement("Parameters")) {
+    const AttributeSlots<FilletParamAttr> params(paramsElem, kFilletParamAttrs);
     if (auto driveType =
-            FilletDriveTypeFromString(paramsElem->Attribute("DriveType"))) {
+            FilletDriveTypeFromString(params.Text(FilletParamAttr::DriveType))) {
       fillet->params.driveType = *driveType;
     } else if (fillet->mode == FilletMode::CHORDAL) {
       fillet->params.driveType = FilletDriveType::SINGLE_DISTANCE;
     }
     if (auto crossSection =
-            FilletCrossSectionFromString(paramsElem->Attribute("CrossSection"))) {
+            FilletCrossSectionFromString(params.Text(FilletParamAttr::CrossSection))) {
       fillet->params.crossSection = *crossSection;
-    } else if (paramsElem->QueryIntAttribute("CrossSection", &intValue) ==
-               XML_SUCCESS) {
+    } else if (params.QueryInt(FilletParamAttr::CrossSection, &intValue)) {
       fillet->params.crossSection = static_cast<FilletCrossSection>(intValue);
     }
-    paramsElem->QueryBoolAttribute("TangentPropagation",
-                                   &fillet->params.tangentPropagation);
-    if (auto conicValueMode =
-            FilletConicValueModeFromString(paramsElem->Attribute("ConicValueMode"))) {
+    params.QueryBool(FilletParamAttr::TangentPropagation,
+                     &fillet->params.tangentPropagation);
+    if (auto conicValueMode = FilletConicValueModeFromString(
+            params.Text(FilletParamAttr::ConicValueMode))) {
       fillet->params.conicValueMode = *conicValueMode;
-    } else if (paramsElem->QueryIntAttribute("ConicValueMode", &intValue) ==
-               XML_SUCCESS) {
+    } else if (params.QueryInt(FilletParamAttr::ConicValueMode, &intValue)) {
       fillet->params.conicValueMode =
           static_cast<FilletConicValueMode>(intValue);
     }
     double doubleValue = 0.0;
-    if (paramsElem->QueryDoubleAttribute("PrimaryValue", &doubleValue) ==
-        XML_SUCCESS) {
+    if (params.QueryDouble(FilletParamAttr::PrimaryValue, &doubleValue)) {
       fillet->params.primaryValue = doubleValue;
     }
-    if (paramsElem->QueryDoubleAttribute("SecondValue", &doubleValue) ==
-        XML_SUCCESS) {
+    if (params.QueryDouble(FilletParamAttr::SecondValue, &doubleValue)) {
       fillet->params.secondValue = doubleValue;
       if (fillet->params.driveType == FilletDriveType::SINGLE_DISTANCE) {
         fillet->params.driveType = FilletDriveType::TWO_DISTANCES;
       }
     }
-    if (paramsElem->QueryDoubleAttribute("DefaultRadius", &doubleValue) ==
-        XML_SUCCESS) {
+    if (params.QueryDouble(FilletParamAttr::DefaultRadius, &doubleValue)) {
       if (!fillet->params.primaryValue.has_value()) {
         fillet->params.primaryValue = doubleValue;
       }
     }
-    if (paramsElem->QueryDoubleAttribute("DefaultDistance", &doubleValue) ==
-        XML_SUCCESS) {
+    if (params.QueryDouble(FilletParamAttr::DefaultDistance, &doubleValue)) {
       if (!fillet->params.primaryValue.has_value()) {
         fillet->params.primaryValue = doubleValue;
       }
     }
-    if (paramsElem->QueryDoubleAttribute("DefaultDistance2", &doubleValue) ==
-        XML_SUCCESS) {
+    if (params.QueryDouble(FilletParamAttr::DefaultDistance2, &doubleValue)) {
       if (!fillet->params.secondValue.has_value()) {
         fillet->params.secondValue = doubleValue;
       }
       if (fillet->params.driveType == FilletDriveType::SINGLE_DISTANCE) {
         fillet->params.driveType = FilletDriveType::TWO_DISTANCES;
       }
-    } else if (paramsElem->QueryDoubleAttribute("DefaultRadius2", &doubleValue) ==
-               XML_SUCCESS) {
+    } else if (params.QueryDouble(FilletParamAttr::DefaultRadius2, &doubleValue)) {
       if (!fillet->params.secondValue.has_value()) {
         fillet->params.secondValue = doubleValue;
       }
@@ -2899,22 +2880,20 @@ void TinyXMLSerializer::LoadFillet(XMLElement *element,
         fillet->params.driveType = FilletDriveType::SINGLE_DISTANCE;
       }
     }
-    if (paramsElem->QueryDoubleAttribute("ConicValue", &doubleValue) ==
-        XML_SUCCESS) {
+    if (params.QueryDouble(FilletParamAttr::ConicValue, &doubleValue)) {
       fillet->params.conicValue = doubleValue;
     }
     if (fillet->referenceMode == FilletReferenceMode::UNKNOWN) {
       if (auto legacyReferenceMode = FilletReferenceModeFromString(
-              paramsElem->Attribute("ReferenceMode"))) {
+              params.Text(FilletParamAttr::ReferenceMode))) {
         fillet->referenceMode = *legacyReferenceMode;
-      } else if (paramsElem->QueryIntAttribute("ReferenceMode", &intValue) ==
-                 XML_SUCCESS) {
+      } else if (params.QueryInt(FilletParamAttr::ReferenceMode, &intValue)) {
         fillet->referenceMode = static_cast<FilletReferenceMode>(intValue);
       }
     }
     bool curvatureContinuous = false;
-    if (paramsElem->QueryBoolAttribute("CurvatureContinuous",
-                                       &curvatureContinuous) == XML_SUCCESS &&
+    if (params.QueryBool(FilletParamAttr::CurvatureContinuous,
+                         &curvatureContinuous) &&
         curvatureContinuous) {
       fillet->params.crossSection =
           FilletCrossSection::CURVATURE_CONTINUOUS;
@@ -2945,50 +2924,43 @@ void TinyXMLSerializer::LoadFillet(XMLElement *element,
          pointElem != nullptr;
          pointElem = pointElem->NextSiblingElement(pointTag)) {
       CFilletRadiusPoint point;
+      const AttributeSlots<FilletPointAttr> pointAttrs(pointElem, kFilletPointAttrs);
       double doubleValue = 0.0;
-      if (pointElem->QueryDoubleAttribute("Position", &doubleValue) ==
-          XML_SUCCESS) {
+      if (pointAttrs.QueryDouble(FilletPointAttr::Position, &doubleValue)) {
         point.position = doubleValue;
       }
-      if (pointElem->QueryDoubleAttribute("PrimaryValue", &doubleValue) ==
-          XML_SUCCESS) {
+      if (pointAttrs.QueryDouble(FilletPointAttr::PrimaryValue, &doubleValue)) {
         point.primaryValue = doubleValue;
       }
-      if (pointElem->QueryDoubleAttribute("SecondValue", &doubleValue) ==
-          XML_SUCCESS) {
+      if (pointAttrs.QueryDouble(FilletPointAttr::SecondValue, &doubleValue)) {
         point.secondValue = doubleValue;
       }
-      if (pointElem->QueryDoubleAttribute("Radius1", &doubleValue) ==
-          XML_SUCCESS) {
+      if (pointAttrs.QueryDouble(FilletPointAttr::Radius1, &doubleValue)) {
         point.primaryValue = doubleValue;
       }
-      if (pointElem->QueryDoubleAttribute("Radius", &doubleValue) ==
-          XML_SUCCESS) {
+      if (pointAttrs.QueryDouble(FilletPointAttr::Radius, &doubleValue)) {
         point.primaryValue = doubleValue;
       }
-      if (pointElem->QueryDoubleAttribute("Distance1", &doubleValue) ==
-          XML_SUCCESS) {
+      if (pointAttrs.QueryDouble(FilletPointAttr::Distance1, &doubleValue)) {
         point.primaryValue = doubleValue;
       }
-      if (pointElem->QueryDoubleAttribute("Distance", &doubleValue) ==
-          XML_SUCCESS) {
+      if (pointAttrs.QueryDouble(FilletPointAttr::Distance, &doubleValue)) {
         if (!point.primaryValue.has_value()) {
           point.primaryValue = doubleValue;
         }
       }
-      if (pointElem->QueryDoubleAttribute("Distance2", &doubleValue) ==
-          XML_SUCCESS) {
+      if (pointAttrs.QueryDouble(FilletPointAttr::Distance2, &doubleValue)) {
         if (!point.secondValue.has_value()) {
           point.secondValue = doubleValue;
         }
-      } else if (pointElem->QueryDoubleAttribute("Radius2", &doubleValue) ==
-          XML_SUCCESS) {
+      } else if (pointAttrs.QueryDouble(FilletPointAttr::Radius2, &doubleValue)) {
         if (!point.secondValue.has_value()) {
           point.secondValue = doubleValue;
         }
       }
-      if (pointElem->Attribute("EdgeMidPoint")) {
-        point.edgeMidPoint = LoadPoint3D(pointElem, "EdgeMidPoint");
+      if (pointAttrs.Has(FilletPointAttr::EdgeMidPoint)) {
+        point.edgeMidPoint =
+            ParsePointText(pointAttrs.Text(FilletPointAttr::EdgeMidPoint));
       } else if (auto *edgeElem = pointElem->FirstChildElement("ReferenceEntity")) {
         if (auto edgeRef =
                 std::dynamic_pointer_cast<CRefEdge>(LoadRefEntity(edgeElem))) {
@@ -3026,15 +2998,15 @@ void TinyXMLSerializer::LoadFillet(XMLElement *element,
   loadFaceGroup("CenterFaces", fillet->centerFaces);
 
   if (XMLElement *extElem = element->FirstChildElement("VendorExtensions")) {
-    extElem->QueryBoolAttribute("SwKeepFeatures", &fillet->swKeepFeatures);
-    if (const char *text = extElem->Attribute("SwOverflowType")) {
+    const AttributeSlots<FilletVendorAttr> vendor(extElem, kFilletVendorAttrs);
+    vendor.QueryBool(FilletVendorAttr::SwKeepFeatures, &fillet->swKeepFeatures);
+    if (const char *text = vendor.Text(FilletVendorAttr::SwOverflowType)) {
       fillet->swOverflowType = text;
     }
-    if (extElem->QueryIntAttribute("CreoAttachType", &intValue) == XML_SUCCESS) {
+    if (vendor.QueryInt(FilletVendorAttr::CreoAttachType, &intValue)) {
       fillet->creoAttachType = intValue;
     }
-    if (extElem->QueryIntAttribute("CreoConicDepOption", &intValue) ==
-        XML_SUCCESS) {
+    if (vendor.QueryInt(FilletVendorAttr::CreoConicDepOption, &intValue)) {
       fillet->creoConicDepOption = intValue;
     }
   }
@@ -3043,38 +3015,33 @@ void TinyXMLSerializer::LoadFillet(XMLElement *element,
 // ---------------------------------------------------------------------------
 // Pattern Enums ↔ String Converters
 // ---------------------------------------------------------------------------
-static std::string PatternScopeToString(PatternScope scope) {
-  switch (scope) {
-    case PatternScope::FEATURES: return "FEATURES";
-    case PatternScope::FACES: return "FACES";
-    case PatternScope::BODIES: return "BODIES";
-    default: return "FEATURES";
-  }
+// 阵列枚举沿用全大写写法，读取时大小写敏感。
+constexpr auto kPatternScopeNames = MakeNameTable<PatternScope, NameCase::Sensitive>({
+    {"FEATURES", PatternScope::FEATURES},
+    {"FACES", PatternScope::FACES},
+    {"BODIES", PatternScope::BODIES},
+});
+
+constexpr auto kPatternSpacingTypeNames =
+    MakeNameTable<PatternSpacingType, NameCase::Sensitive>({
+        {"PITCH_AND_COUNT", PatternSpacingType::PITCH_AND_COUNT},
+        {"SPAN_AND_COUNT", PatternSpacingType::SPAN_AND_COUNT},
+    });
+
+static const char *PatternScopeToString(PatternScope scope) {
+  return kPatternScopeNames.NameOf(scope, "FEATURES");
 }
 
 static PatternScope PatternScopeFromString(const char* str) {
-  if (!str) return PatternScope::FEATURES;
-  std::string s(str);
-  if (s == "FEATURES") return PatternScope::FEATURES;
-  if (s == "FACES") return PatternScope::FACES;
-  if (s == "BODIES") return PatternScope::BODIES;
-  return PatternScope::FEATURES;
+  return kPatternScopeNames.Parse(str).value_or(PatternScope::FEATURES);
 }
 
-static std::string PatternSpacingTypeToString(PatternSpacingType type) {
-  switch (type) {
-    case PatternSpacingType::PITCH_AND_COUNT: return "PITCH_AND_COUNT";
-    case PatternSpacingType::SPAN_AND_COUNT: return "SPAN_AND_COUNT";
-    default: return "PITCH_AND_COUNT";
-  }
+static const char *PatternSpacingTypeToString(PatternSpacingType type) {
+  return kPatternSpacingTypeNames.NameOf(type, "PITCH_AND_COUNT");
 }
 
 static PatternSpacingType PatternSpacingTypeFromString(const char* str) {
-  if (!str) return PatternSpacingType::PITCH_AND_COUNT;
-  std::string s(str);
-  if (s == "PITCH_AND_COUNT") return PatternSpacingType::PITCH_AND_COUNT;
-  if (s == "SPAN_AND_COUNT") return PatternSpacingType::SPAN_AND_COUNT;
-  return PatternSpacingType::PITCH_AND_COUNT;
+  return kPatternSpacingTypeNames.Parse(str).value_or(PatternSpacingType::PITCH_AND_COUNT);
 }
 
 // ---------------------------------------------------------------------------
@@ -3084,12 +3051,12 @@ void TinyXMLSerializer::SaveLinearPattern(XMLDocument &doc, XMLElement *element,
                                           const std::shared_ptr<CLinearPattern> &pattern) {
   element->SetAttribute("PatternSeedOnly", pattern->patternSeedOnly);
   element->SetAttribute("GeometryPattern", pattern->geometryPattern);
-  element->SetAttribute("Scope", PatternScopeToString(pattern->scope).c_str());
+  element->SetAttribute("Scope", PatternScopeToString(pattern->scope));
 
   // Dir1
   XMLElement *dir1Elem = doc.NewElement("Dir1");
   dir1Elem->SetAttribute("Direction", FormatVector(pattern->dir1.direction).c_str());
-  dir1Elem->SetAttribute("SpacingType", PatternSpacingTypeToString(pattern->dir1.spacingType).c_str());
+  dir1Elem->SetAttribute("SpacingType", PatternSpacingTypeToString(pattern->dir1.spacingType));
   dir1Elem->SetAttribute("Spacing", pattern->dir1.spacing);
   dir1Elem->SetAttribute("Count", pattern->dir1.count);
   SaveRefEntity(doc, dir1Elem, "DirectionReference", pattern->dir1.directionRef);
@@ -3099,7 +3066,7 @@ void TinyXMLSerializer::SaveLinearPattern(XMLDocument &doc, XMLElement *element,
   if (pattern->dir2) {
     XMLElement *dir2Elem = doc.NewElement("Dir2");
     dir2Elem->SetAttribute("Direction", FormatVector(pattern->dir2->direction).c_str());
-    dir2Elem->SetAttribute("SpacingType", PatternSpacingTypeToString(pattern->dir2->spacingType).c_str());
+    dir2Elem->SetAttribute("SpacingType", PatternSpacingTypeToString(pattern->dir2->spacingType));
     dir2Elem->SetAttribute("Spacing", pattern->dir2->spacing);
     dir2Elem->SetAttribute("Count", pattern->dir2->count);
     SaveRefEntity(doc, dir2Elem, "DirectionReference", pattern->dir2->directionRef);
@@ -3130,12 +3097,12 @@ void TinyXMLSerializer::SaveCircularPattern(XMLDocument &doc, XMLElement *elemen
                                             const std::shared_ptr<CCircularPattern> &pattern) {
   element->SetAttribute("PatternSeedOnly", pattern->patternSeedOnly);
   element->SetAttribute("GeometryPattern", pattern->geometryPattern);
-  element->SetAttribute("Scope", PatternScopeToString(pattern->scope).c_str());
+  element->SetAttribute("Scope", PatternScopeToString(pattern->scope));
 
   // Dir1
   XMLElement *dir1Elem = doc.NewElement("Dir1");
   dir1Elem->SetAttribute("Direction", FormatVector(pattern->dir1.direction).c_str());
-  dir1Elem->SetAttribute("SpacingType", PatternSpacingTypeToString(pattern->dir1.spacingType).c_str());
+  dir1Elem->SetAttribute("SpacingType", PatternSpacingTypeToString(pattern->dir1.spacingType));
   dir1Elem->SetAttribute("Angle", pattern->dir1.angle);
   dir1Elem->SetAttribute("Count", pattern->dir1.count);
   SaveRefEntity(doc, dir1Elem, "AxisReference", pattern->dir1.axisRef);
@@ -3145,7 +3112,7 @@ void TinyXMLSerializer::SaveCircularPattern(XMLDocument &doc, XMLElement *elemen
   if (pattern->dir2) {
     XMLElement *dir2Elem = doc.NewElement("Dir2");
     dir2Elem->SetAttribute("Direction", FormatVector(pattern->dir2->direction).c_str());
-    dir2Elem->SetAttribute("SpacingType", PatternSpacingTypeToString(pattern->dir2->spacingType).c_str());
+    dir2Elem->SetAttribute("SpacingType", PatternSpacingTypeToString(pattern->dir2->spacingType));
     dir2Elem->SetAttribute("Spacing", pattern->dir2->spacing);
     dir2Elem->SetAttribute("Count", pattern->dir2->count);
     SaveRefEntity(doc, dir2Elem, "DirectionReference", pattern->dir2->directionRef);
@@ -3175,7 +3142,7 @@ void TinyXMLSerializer::SaveCircularPattern(XMLDocument &doc, XMLElement *elemen
 void TinyXMLSerializer::SaveMirrorPattern(XMLDocument &doc, XMLElement *element,
                                           const std::shared_ptr<CMirrorPattern> &pattern) {
   element->SetAttribute("GeometryPattern", pattern->geometryPattern);
-  element->SetAttribute("Scope", PatternScopeToString(pattern->scope).c_str());
+  element->SetAttribute("Scope", PatternScopeToString(pattern->scope));
   SaveRefEntity(doc, element, "MirrorPlaneReference", pattern->mirrorPlaneRef);
 
   // SeedObjects
@@ -5,15 +5,21 @@
 #include "../../core/UnifiedModel.h"
 #include <filesystem>
 #include <iostream>
+#include <string>
+#include <string_view>
 namespace CADExchange {
 
+class LoadPipeline;
+class SerializerContext;
+
 /**
  * @file TinyXMLSerializer.h
  * @brief 使用 tinyxml2 将 UnifiedModel 序列化 / 反序列化为 XML 的接口声明。
  *
  * 本文件声明了 `TinyXMLSerializer`，它负责把内存中的 `UnifiedModel`
  * 导出为轻量的 XML 表示（Save），以及从磁盘上的 XML 重新构建
- * `UnifiedModel`（Load）。序列化格式面向人类可读，
+ * `UnifiedModel`（Load）。文件、流与内存缓冲区三种入口共享同一套 DOM
+ * 构建/解析逻辑，输出内容逐字节一致。序列化格式面向人类可读，
  * 主要用于测试、导入导出以及简单持久化场景。
  */
 
@@ -22,6 +28,8 @@ namespace CADExchange {
  * @brief 提供静态方法以读写 `UnifiedModel` 到 XML 文件。
  *
  * 所有方法均为静态，类无状态；内部实现使用 tinyxml2 操作 DOM。
+ * 各入口可选接收 `SerializerContext`，批量处理时复用文档内存池与缓冲区；
+ * 不传时每次调用使用局部文档，行为与输出完全相同。
  */
 class TinyXMLSerializer {
 public:
@@ -36,7 +44,8 @@ public:
    */
   static bool Save(const UnifiedModel &model,
                    const std::filesystem::path &filePath,
-                   std::string *errorMessage = nullptr);
+                   std::string *errorMessage = nullptr,
+                   SerializerContext *context = nullptr);
 
   /**
    * @brief 从 XML 文件加载 `UnifiedModel` 并填充到传入的 model。
@@ -45,13 +54,62 @@ public:
    * 输出参数，函数返回时包含加载得到的要素（若加载失败则保持未定义或已清空）。
    * @param filePath 要加载的 XML 文件路径。
    * @param errorMessage 若非空，出错时会写入错误描述。
+   * @param pipeline 可选，每个特征解码后立即交给它校验与换算单位；
+   * 调用方负责在成功后调用其 Finish()。
+   * @param context 可选，复用其中的文档与缓冲区（见 SerializerContext）。
    * @return 成功返回 true，失败返回 false 并在 `errorMessage`
    * 中返回原因（若提供）。
    */
   static bool Load(UnifiedModel &model, const std::filesystem::path &filePath,
-                   std::string *errorMessage = nullptr);
+                   std::string *errorMessage = nullptr,
+                   LoadPipeline *pipeline = nullptr,
+                   SerializerContext *context = nullptr);
+
+  /**
+   * @brief 将 `UnifiedModel` 以 XML 写入输出流（不经临时文件）。
+   *
+   * 输出按块写入流；流进入错误状态时返回 false。
+   */
+  static bool Save(const UnifiedModel &model, std::ostream &output,
+                   std::string *errorMessage = nullptr,
+                   SerializerContext *context = nullptr);
+
+  /**
+   * @brief 将 `UnifiedModel` 以 XML 写入调用方提供的缓冲区。
+   *
+   * buffer 先被清空再写入，已有容量被复用；服务端可为每个连接持有一个
+   * 缓冲区反复调用以避免重复分配。
+   */
+  static bool SaveToBuffer(const UnifiedModel &model, std::string &buffer,
+                           std::string *errorMessage = nullptr,
+                           SerializerContext *context = nullptr);
+
+  /**
+   * @brief 从输入流读取 XML 并加载 `UnifiedModel`。
+   *
+   * tinyxml2 需要完整输入，流内容会被一次性读入内存后解析。
+   */
+  static bool Load(UnifiedModel &model, std::istream &input,
+                   std::string *errorMessage = nullptr,
+                   LoadPipeline *pipeline = nullptr,
+                   SerializerContext *context = nullptr);
+
+  /**
+   * @brief 直接从内存中的 XML 文本加载 `UnifiedModel`。
+   *
+   * @param xml XML 文本（不要求以 NUL 结尾）。
+   */
+  static bool LoadFromBuffer(UnifiedModel &model, std::string_view xml,
+                             std::string *errorMessage = nullptr,
+                             LoadPipeline *pipeline = nullptr,
+                             SerializerContext *context = nullptr);
 
 private:
+  static void BuildDocument(const UnifiedModel &model,
+                            tinyxml2::XMLDocument &doc);
+  static bool ReadDocument(tinyxml2::XMLDocument &doc, UnifiedModel &model,
+                           std::string *errorMessage, LoadPipeline *pipeline);
+
   // Helpers for Save
   /**
    * @brief 将单个特征写入到父 XML 元素下（Feature 节点）。
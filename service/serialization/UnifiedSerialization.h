@@ -557,7 +557,9 @@ template <class Archive> void serialize(Archive &ar, CMirrorPattern &pat) {
 }
 
 template <class Archive> void save(Archive &ar, const UnifiedModel &model) {
-  ar(cereal::make_nvp("UnitSystem", model.unit),
+  // UnifiedModel 可由 UnitType 隐式构造，直接写枚举会与本函数产生重载歧义。
+  const auto unit = static_cast<int>(model.unit);
+  ar(cereal::make_nvp("UnitSystem", unit),
      cereal::make_nvp("ModelName", model.modelName));
 
   // 记录特征数量
@@ -574,8 +576,10 @@ template <class Archive> void save(Archive &ar, const UnifiedModel &model) {
  * @brief 反序列化 UnifiedModel，重建单位、名称与特征集合。
  */
 template <class Archive> void load(Archive &ar, UnifiedModel &model) {
-  ar(cereal::make_nvp("UnitSystem", model.unit),
+  int unit = 0;
+  ar(cereal::make_nvp("UnitSystem", unit),
      cereal::make_nvp("ModelName", model.modelName));
+  model.unit = static_cast<UnitType>(unit);
 
   size_t count = 0;
   ar(cereal::make_nvp("FeatureCount", count));
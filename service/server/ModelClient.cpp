@@ -0,0 +1,306 @@
+#include "ModelClient.h"
+#include "../serialization/CerealJsonSerializer.h"
+#include "../../core/detail/IoHelpers.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace CADExchange {
+namespace Server {
+
+namespace {
+
+using detail::Fail;
+
+std::string AbsolutePath(const std::filesystem::path &path) {
+  std::error_code ec;
+  auto absolute = std::filesystem::absolute(path, ec);
+  return (ec ? path : absolute).string();
+}
+
+bool Malformed(std::string *errorMessage) {
+  return Fail(errorMessage, "Malformed response from server.");
+}
+
+} // namespace
+
+ModelClient::~ModelClient() { Close(); }
+
+#ifdef _WIN32
+
+bool ModelClient::Connect(const std::filesystem::path &, std::string *errorMessage) {
+  return Fail(errorMessage, "ModelClient requires Unix domain sockets.");
+}
+
+void ModelClient::Close() {}
+
+bool ModelClient::Call(Opcode, const std::string &, std::string &,
+                       std::string *errorMessage) {
+  return Fail(errorMessage, "ModelClient requires Unix domain sockets.");
+}
+
+#else
+
+namespace {
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+bool SendAll(int fd, const std::string &data) {
+  std::size_t sent = 0;
+  while (sent < data.size()) {
+    const ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, kSendFlags);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    sent += static_cast<std::size_t>(n);
+  }
+  return true;
+}
+
+bool RecvAll(int fd, char *data, std::size_t size) {
+  while (size > 0) {
+    const ssize_t n = ::recv(fd, data, size, 0);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    data += n;
+    size -= static_cast<std::size_t>(n);
+  }
+  return true;
+}
+
+} // namespace
+
+bool ModelClient::Connect(const std::filesystem::path &socketPath,
+                          std::string *errorMessage) {
+  Close();
+  const std::string native = socketPath.string();
+  sockaddr_un addr;
+  if (native.empty() || native.size() >= sizeof(addr.sun_path)) {
+    return Fail(errorMessage, "Invalid socket path: " + native);
+  }
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  std::memcpy(addr.sun_path, native.c_str(), native.size() + 1);
+
+  m_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (m_fd < 0 ||
+      ::connect(m_fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0) {
+    const std::string reason = std::strerror(errno);
+    Close();
+    return Fail(errorMessage, "Could not connect to " + native + ": " + reason);
+  }
+  ::fcntl(m_fd, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+  const int one = 1;
+  ::setsockopt(m_fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+  return true;
+}
+
+void ModelClient::Close() {
+  if (m_fd >= 0) {
+    ::close(m_fd);
+    m_fd = -1;
+  }
+}
+
+bool ModelClient::Call(Opcode opcode, const std::string &request,
+                       std::string &response, std::string *errorMessage) {
+  if (m_fd < 0) {
+    return Fail(errorMessage, "ModelClient is not connected.");
+  }
+  m_frame.clear();
+  AppendFrameHeader(m_frame, {static_cast<std::uint32_t>(request.size()), opcode,
+                              Status::Ok});
+  m_frame += request;
+  if (!SendAll(m_fd, m_frame)) {
+    Close();
+    return Fail(errorMessage, "Failed to send request to server.");
+  }
+
+  m_frame.resize(kFrameHeaderBytes);
+  FrameHeader header;
+  if (!RecvAll(m_fd, m_frame.data(), kFrameHeaderBytes) ||
+      !ParseFrameHeader(m_frame, header) || header.opcode != opcode ||
+      header.payloadBytes > kMaxPayloadBytes) {
+    Close();
+    return Fail(errorMessage, "Connection to server lost.");
+  }
+  response.resize(header.payloadBytes);
+  if (!RecvAll(m_fd, response.data(), response.size())) {
+    Close();
+    return Fail(errorMessage, "Connection to server lost.");
+  }
+  if (header.status != Status::Ok) {
+    WireReader reader(response);
+    const std::string message = reader.Str();
+    return Fail(errorMessage, reader.Ok() ? message : "Server returned an error.");
+  }
+  return true;
+}
+
+#endif
+
+bool ModelClient::Ping(std::string *errorMessage) {
+  std::string response;
+  return Call(Opcode::Ping, {}, response, errorMessage);
+}
+
+bool ModelClient::Load(const std::filesystem::path &filePath, ModelSummary &summary,
+                       std::string *errorMessage, SerializationFormat format) {
+  std::string request;
+  WireWriter out(request);
+  out.Str(AbsolutePath(filePath));
+  out.U8(static_cast<std::uint8_t>(format));
+  std::string response;
+  if (!Call(Opcode::Load, request, response, errorMessage)) {
+    return false;
+  }
+  WireReader in(response);
+  summary.unit = static_cast<UnitType>(in.U32());
+  summary.modelName = in.Str();
+  summary.featureCount = in.U64();
+  return in.Ok() || Malformed(errorMessage);
+}
+
+bool ModelClient::ListFeatures(const std::filesystem::path &filePath,
+                               std::vector<FeatureSummary> &features,
+                               std::string *errorMessage,
+                               SerializationFormat format) {
+  std::string request;
+  WireWriter out(request);
+  out.Str(AbsolutePath(filePath));
+  out.U8(static_cast<std::uint8_t>(format));
+  std::string response;
+  if (!Call(Opcode::ListFeatures, request, response, errorMessage)) {
+    return false;
+  }
+  WireReader in(response);
+  const std::uint32_t count = in.U32();
+  features.clear();
+  for (std::uint32_t i = 0; i < count && in.Ok(); ++i) {
+    FeatureSummary summary;
+    summary.featureID = in.Str();
+    summary.featureName = in.Str();
+    summary.featureType = static_cast<FeatureType>(in.U16());
+    features.push_back(std::move(summary));
+  }
+  return in.Ok() || Malformed(errorMessage);
+}
+
+bool ModelClient::GetFeature(const std::filesystem::path &filePath,
+                             const std::string &featureID,
+                             std::shared_ptr<CFeatureBase> &feature,
+                             std::string *errorMessage,
+                             SerializationFormat format) {
+  std::string request;
+  WireWriter out(request);
+  out.Str(AbsolutePath(filePath));
+  out.U8(static_cast<std::uint8_t>(format));
+  out.Str(featureID);
+  std::string response;
+  if (!Call(Opcode::GetFeature, request, response, errorMessage)) {
+    return false;
+  }
+  WireReader in(response);
+  const std::string json = in.Str();
+  if (!in.Ok()) {
+    return Malformed(errorMessage);
+  }
+  // 单特征模型可能引用不在其中的特征，只解码不校验。
+  UnifiedModel single;
+  if (!CerealJsonSerializer::LoadFromBuffer(single, json, errorMessage) ||
+      single.GetFeatures().size() != 1) {
+    return Malformed(errorMessage);
+  }
+  feature = single.GetFeatures().front();
+  return true;
+}
+
+bool ModelClient::Validate(const std::filesystem::path &filePath,
+                           ValidationReport &report, std::string *errorMessage,
+                           SerializationFormat format) {
+  std::string request;
+  WireWriter out(request);
+  out.Str(AbsolutePath(filePath));
+  out.U8(static_cast<std::uint8_t>(format));
+  std::string response;
+  if (!Call(Opcode::Validate, request, response, errorMessage)) {
+    return false;
+  }
+  WireReader in(response);
+  report.isValid = in.U8() != 0;
+  report.errors = in.Strs();
+  report.warnings = in.Strs();
+  return in.Ok() || Malformed(errorMessage);
+}
+
+bool ModelClient::ConvertUnit(const std::filesystem::path &filePath,
+                              UnitType targetUnit,
+                              const std::filesystem::path &outPath,
+                              std::string *errorMessage,
+                              SerializationFormat format,
+                              SerializationFormat outFormat) {
+  std::string request;
+  WireWriter out(request);
+  out.Str(AbsolutePath(filePath));
+  out.U8(static_cast<std::uint8_t>(format));
+  out.U32(static_cast<std::uint32_t>(targetUnit));
+  out.Str(AbsolutePath(outPath));
+  out.U8(static_cast<std::uint8_t>(outFormat));
+  std::string response;
+  return Call(Opcode::ConvertUnit, request, response, errorMessage);
+}
+
+bool ModelClient::Save(const std::filesystem::path &filePath,
+                       const std::filesystem::path &outPath,
+                       std::string *errorMessage, SerializationFormat format,
+                       SerializationFormat outFormat) {
+  std::string request;
+  WireWriter out(request);
+  out.Str(AbsolutePath(filePath));
+  out.U8(static_cast<std::uint8_t>(format));
+  out.Str(AbsolutePath(outPath));
+  out.U8(static_cast<std::uint8_t>(outFormat));
+  std::string response;
+  return Call(Opcode::Save, request, response, errorMessage);
+}
+
+bool ModelClient::CompareGeometry(const std::filesystem::path &srcJson,
+                                  const std::filesystem::path &dstJson,
+                                  GeometryCompareSummary &summary,
+                                  std::string *errorMessage, double tol) {
+  std::string request;
+  WireWriter out(request);
+  out.Str(AbsolutePath(srcJson));
+  out.Str(AbsolutePath(dstJson));
+  out.F64(tol);
+  std::string response;
+  if (!Call(Opcode::CompareGeometry, request, response, errorMessage)) {
+    return false;
+  }
+  WireReader in(response);
+  summary.equivalent = in.U8() != 0;
+  summary.diagnostics = in.Strs();
+  return in.Ok() || Malformed(errorMessage);
+}
+
+} // namespace Server
+} // namespace CADExchange
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "ServerProtocol.h"
+#include "../serialization/CADSerializer.h"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CADExchange {
+namespace Server {
+
+/**
+ * @file ModelClient.h
+ * @brief cadex_served 的同步客户端。
+ */
+
+/**
+ * @class ModelClient
+ * @brief 持有一条到 ModelServer 的连接，逐个发送请求并等待响应。
+ *
+ * 所有请求方法失败时返回 false 并写入 errorMessage（服务端错误信息或
+ * 连接错误）；连接错误后连接被关闭，需重新 Connect。路径参数在发送前
+ * 转换为绝对路径。本类不是线程安全的，并发请求请使用多个客户端。
+ */
+class ModelClient {
+public:
+  ModelClient() = default;
+  ~ModelClient();
+
+  ModelClient(const ModelClient &) = delete;
+  ModelClient &operator=(const ModelClient &) = delete;
+
+  bool Connect(const std::filesystem::path &socketPath,
+               std::string *errorMessage = nullptr);
+  void Close();
+  bool IsConnected() const { return m_fd >= 0; }
+
+  bool Ping(std::string *errorMessage = nullptr);
+
+  bool Load(const std::filesystem::path &filePath, ModelSummary &summary,
+            std::string *errorMessage = nullptr,
+            SerializationFormat format = SerializationFormat::TINYXML);
+
+  bool ListFeatures(const std::filesystem::path &filePath,
+                    std::vector<FeatureSummary> &features,
+                    std::string *errorMessage = nullptr,
+                    SerializationFormat format = SerializationFormat::TINYXML);
+
+  /// 取回单个特征的完整内容（服务端以单特征 CEREAL_JSON 模型传输）。
+  bool GetFeature(const std::filesystem::path &filePath,
+                  const std::string &featureID,
+                  std::shared_ptr<CFeatureBase> &feature,
+                  std::string *errorMessage = nullptr,
+                  SerializationFormat format = SerializationFormat::TINYXML);
+
+  bool Validate(const std::filesystem::path &filePath, ValidationReport &report,
+                std::string *errorMessage = nullptr,
+                SerializationFormat format = SerializationFormat::TINYXML);
+
+  /// 在服务端换算单位并写到 outPath；源文件与缓存中的模型不变。
+  bool ConvertUnit(const std::filesystem::path &filePath, UnitType targetUnit,
+                   const std::filesystem::path &outPath,
+                   std::string *errorMessage = nullptr,
+                   SerializationFormat format = SerializationFormat::TINYXML,
+                   SerializationFormat outFormat = SerializationFormat::TINYXML);
+
+  bool Save(const std::filesystem::path &filePath,
+            const std::filesystem::path &outPath,
+            std::string *errorMessage = nullptr,
+            SerializationFormat format = SerializationFormat::TINYXML,
+            SerializationFormat outFormat = SerializationFormat::TINYXML);
+
+  /// 比较两个几何 JSON；tol 为 0 时按源文件单位取默认容差。
+  bool CompareGeometry(const std::filesystem::path &srcJson,
+                       const std::filesystem::path &dstJson,
+                       GeometryCompareSummary &summary,
+                       std::string *errorMessage = nullptr, double tol = 0.0);
+
+private:
+  /// 发送一帧并读取响应 payload；status 非 Ok 时把错误信息写入 errorMessage。
+  bool Call(Opcode opcode, const std::string &request, std::string &response,
+            std::string *errorMessage);
+
+  int m_fd = -1;
+  std::string m_frame; ///< 请求/响应缓冲区，跨调用复用容量
+};
+
+} // namespace Server
+} // namespace CADExchange
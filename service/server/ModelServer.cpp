@@ -0,0 +1,607 @@
+#include "ModelServer.h"
+#include "../geometry/GeometryCollectorBase.h"
+#include "../serialization/AsyncSerializer.h"
+#include "../serialization/CerealJsonSerializer.h"
+#include "../serialization/ModelCache.h"
+#include "../../core/ModelTransform.h"
+#include "../../core/detail/IoHelpers.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace CADExchange {
+namespace Server {
+
+namespace {
+
+using detail::Fail;
+
+Status Reply(std::string &response, Status status, const std::string &message) {
+  response.clear();
+  WireWriter(response).Str(message);
+  return status;
+}
+
+bool DecodeFormat(std::uint8_t value, SerializationFormat &format) {
+  if (value > static_cast<std::uint8_t>(SerializationFormat::CEREAL_JSON)) {
+    return false;
+  }
+  format = static_cast<SerializationFormat>(value);
+  return true;
+}
+
+bool DecodeUnit(std::uint32_t value, UnitType &unit) {
+  if (value > static_cast<std::uint32_t>(UnitType::FOOT)) {
+    return false;
+  }
+  unit = static_cast<UnitType>(value);
+  return true;
+}
+
+/// 与 test_geom 的集合比对一致：半结构分组在全部特征的边上统一提取。
+GeometryCompareSummary CompareGeometrySets(const Geometry::GeometrySet &src,
+                                           const Geometry::GeometrySet &dst,
+                                           double tol) {
+  using Collector = Geometry::GeometryCollectorBaseDummyDerived;
+  GeometryCompareSummary summary;
+  summary.equivalent = true;
+  std::vector<CRefEdge> srcEdges;
+  std::vector<CRefEdge> dstEdges;
+  for (const auto &[id, collector] : src.features) {
+    srcEdges.insert(srcEdges.end(), collector.GetEdges().begin(),
+                    collector.GetEdges().end());
+  }
+  for (const auto &[id, collector] : dst.features) {
+    dstEdges.insert(dstEdges.end(), collector.GetEdges().begin(),
+                    collector.GetEdges().end());
+  }
+  const auto srcGroups = Collector::ExtractHalfStructureGroups(srcEdges, tol);
+  const auto dstGroups = Collector::ExtractHalfStructureGroups(dstEdges, tol);
+  const auto srcLineGroups = Collector::ExtractHalfStructureLineGroups(srcEdges, tol);
+  const auto dstLineGroups = Collector::ExtractHalfStructureLineGroups(dstEdges, tol);
+
+  for (const auto &[id, collector] : src.features) {
+    auto other = dst.features.find(id);
+    if (other == dst.features.end()) {
+      summary.equivalent = false;
+      summary.diagnostics.push_back("missing target feature: " + id);
+      continue;
+    }
+    auto result = collector.CompareDetailed(other->second, tol, &srcGroups,
+                                            &dstGroups, &srcLineGroups,
+                                            &dstLineGroups);
+    if (!result.equivalent) {
+      summary.equivalent = false;
+      summary.diagnostics.push_back("feature mismatch: " + id);
+      for (auto &line : result.diagnostics) {
+        summary.diagnostics.push_back("  " + std::move(line));
+      }
+    }
+  }
+  for (const auto &[id, collector] : dst.features) {
+    if (!src.features.count(id)) {
+      summary.equivalent = false;
+      summary.diagnostics.push_back("unexpected target feature: " + id);
+    }
+  }
+  return summary;
+}
+
+} // namespace
+
+ModelServer::ModelServer(ModelServerOptions options)
+    : m_options(std::move(options)),
+      m_cache(m_options.cache ? m_options.cache : &ModelCache::Instance()) {}
+
+ModelServer::~ModelServer() { Stop(); }
+
+Status ModelServer::Handle(Opcode opcode, std::string_view request,
+                           std::string &response) {
+  response.clear();
+  WireReader in(request);
+  WireWriter out(response);
+  std::string error;
+
+  // 读取 "str path, u8 format" 前缀并经缓存加载。
+  auto loadModel = [&](std::shared_ptr<const UnifiedModel> &model) {
+    const std::string path = in.Str();
+    SerializationFormat format{};
+    if (!DecodeFormat(in.U8(), format) || !in.Ok()) {
+      return Reply(response, Status::BadRequest, "Malformed request.");
+    }
+    model = m_cache->Load(path, &error, format);
+    if (!model) {
+      return Reply(response, Status::Failed,
+                   error.empty() ? "Failed to load " + path : error);
+    }
+    return Status::Ok;
+  };
+  auto saveTo = [&](const UnifiedModel &model, const std::string &outPath,
+                    SerializationFormat format) {
+    std::string buffer;
+    if (!SaveModelToBuffer(model, buffer, &error, format) ||
+        !WriteFileAtomically(outPath, buffer, false, &error)) {
+      return Reply(response, Status::Failed, error);
+    }
+    out.U64(buffer.size());
+    return Status::Ok;
+  };
+
+  std::shared_ptr<const UnifiedModel> model;
+  switch (opcode) {
+  case Opcode::Ping:
+    return in.AtEnd() ? Status::Ok
+                      : Reply(response, Status::BadRequest, "Malformed request.");
+
+  case Opcode::Load: {
+    if (const Status status = loadModel(model); status != Status::Ok) {
+      return status;
+    }
+    out.U32(static_cast<std::uint32_t>(model->unit));
+    out.Str(model->modelName);
+    out.U64(model->GetFeatures().size());
+    return Status::Ok;
+  }
+
+  case Opcode::ListFeatures: {
+    if (const Status status = loadModel(model); status != Status::Ok) {
+      return status;
+    }
+    const auto &features = model->GetFeatures();
+    out.U32(static_cast<std::uint32_t>(features.size()));
+    for (const auto &feature : features) {
+      out.Str(feature->featureID);
+      out.Str(feature->featureName);
+      out.U16(static_cast<std::uint16_t>(feature->featureType));
+    }
+    return Status::Ok;
+  }
+
+  case Opcode::GetFeature: {
+    if (const Status status = loadModel(model); status != Status::Ok) {
+      return status;
+    }
+    const std::string featureID = in.Str();
+    if (!in.Ok()) {
+      return Reply(response, Status::BadRequest, "Malformed request.");
+    }
+    auto feature = model->GetFeature(featureID);
+    if (!feature) {
+      return Reply(response, Status::Failed, "Feature not found: " + featureID);
+    }
+    UnifiedModel single(model->unit, model->modelName);
+    single.AddFeature(feature);
+    std::string json;
+    if (!CerealJsonSerializer::SaveToBuffer(single, json, &error)) {
+      return Reply(response, Status::Failed, error);
+    }
+    out.Str(json);
+    return Status::Ok;
+  }
+
+  case Opcode::Validate: {
+    if (const Status status = loadModel(model); status != Status::Ok) {
+      return status;
+    }
+    const auto report = model->Validate();
+    out.U8(report.isValid ? 1 : 0);
+    out.Strs(report.errors);
+    out.Strs(report.warnings);
+    return Status::Ok;
+  }
+
+  case Opcode::ConvertUnit: {
+    if (const Status status = loadModel(model); status != Status::Ok) {
+      return status;
+    }
+    UnitType unit{};
+    SerializationFormat outFormat{};
+    const bool unitOk = DecodeUnit(in.U32(), unit);
+    const std::string outPath = in.Str();
+    if (!unitOk || !DecodeFormat(in.U8(), outFormat) || !in.Ok()) {
+      return Reply(response, Status::BadRequest, "Malformed request.");
+    }
+    // 缓存中的模型是共享的，先深拷贝得到独立副本再换算（共享引用仍只换算一次）。
+    UnifiedModel copy = CloneModelDeep(*model);
+    if (!ConvertModelUnit(copy, unit, &error)) {
+      return Reply(response, Status::Failed, error);
+    }
+    return saveTo(copy, outPath, outFormat);
+  }
+
+  case Opcode::Save: {
+    if (const Status status = loadModel(model); status != Status::Ok) {
+      return status;
+    }
+    SerializationFormat outFormat{};
+    const std::string outPath = in.Str();
+    if (!DecodeFormat(in.U8(), outFormat) || !in.Ok()) {
+      return Reply(response, Status::BadRequest, "Malformed request.");
+    }
+    return saveTo(*model, outPath, outFormat);
+  }
+
+  case Opcode::CompareGeometry: {
+    const std::string srcPath = in.Str();
+    const std::string dstPath = in.Str();
+    double tol = in.F64();
+    if (!in.Ok()) {
+      return Reply(response, Status::BadRequest, "Malformed request.");
+    }
+    Geometry::GeometrySet src;
+    Geometry::GeometrySet dst;
+    if (!src.LoadFromJson(srcPath, &error) ||
+        !dst.LoadFromJson(dstPath, &error, src.length_unit)) {
+      return Reply(response, Status::Failed, error);
+    }
+    UnitType unit{};
+    if (tol <= 0.0 && !(TryParseUnitType(src.length_unit, unit) &&
+                        TryGetGeometryCompareTolerance(unit, tol))) {
+      tol = 2e-3;
+    }
+    const auto summary = CompareGeometrySets(src, dst, tol);
+    out.U8(summary.equivalent ? 1 : 0);
+    out.Strs(summary.diagnostics);
+    return Status::Ok;
+  }
+  }
+  return Reply(response, Status::BadRequest, "Unknown opcode.");
+}
+
+#ifdef _WIN32
+
+bool ModelServer::Start(std::string *errorMessage) {
+  return Fail(errorMessage, "ModelServer requires Unix domain sockets.");
+}
+
+void ModelServer::Stop() {}
+void ModelServer::EventLoop() {}
+void ModelServer::WorkerLoop() {}
+void ModelServer::Wake() {}
+
+#else
+
+namespace {
+
+bool SetNonBlocking(int fd) {
+  const int flags = ::fcntl(fd, F_GETFL, 0);
+  return flags >= 0 && ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0 &&
+         ::fcntl(fd, F_SETFD, FD_CLOEXEC) == 0;
+}
+
+void DisableSigPipe(int fd) {
+#ifdef SO_NOSIGPIPE
+  const int one = 1;
+  ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#else
+  (void)fd;
+#endif
+}
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+/// 向非阻塞套接字写完整帧；缓冲区满时等待可写，长时间不可写视为失败。
+bool SendAll(int fd, const std::string &data) {
+  constexpr int kWriteTimeoutMs = 5000;
+  std::size_t sent = 0;
+  while (sent < data.size()) {
+    const ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, kSendFlags);
+    if (n > 0) {
+      sent += static_cast<std::size_t>(n);
+      continue;
+    }
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      pollfd pfd{fd, POLLOUT, 0};
+      if (::poll(&pfd, 1, kWriteTimeoutMs) <= 0) {
+        return false;
+      }
+      continue;
+    }
+    return false;
+  }
+  return true;
+}
+
+bool FillAddress(const std::filesystem::path &path, sockaddr_un &addr,
+                 std::string *errorMessage) {
+  const std::string native = path.string();
+  if (native.empty() || native.size() >= sizeof(addr.sun_path)) {
+    return Fail(errorMessage, "Invalid socket path: " + native);
+  }
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  std::memcpy(addr.sun_path, native.c_str(), native.size() + 1);
+  return true;
+}
+
+} // namespace
+
+bool ModelServer::Start(std::string *errorMessage) {
+  if (m_running.load()) {
+    return Fail(errorMessage, "ModelServer is already running.");
+  }
+  sockaddr_un addr;
+  if (!FillAddress(m_options.socketPath, addr, errorMessage)) {
+    return false;
+  }
+
+  // 路径上已有套接字：能连上说明另一个服务在监听，否则是残留文件。
+  struct stat st;
+  if (::lstat(addr.sun_path, &st) == 0) {
+    if (!S_ISSOCK(st.st_mode)) {
+      return Fail(errorMessage, "Socket path exists and is not a socket: " +
+                                    m_options.socketPath.string());
+    }
+    const int probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    const bool live =
+        probe >= 0 &&
+        ::connect(probe, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) == 0;
+    if (probe >= 0) {
+      ::close(probe);
+    }
+    if (live) {
+      return Fail(errorMessage, "Another server is listening on " +
+                                    m_options.socketPath.string());
+    }
+    ::unlink(addr.sun_path);
+  }
+
+  m_listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (m_listenFd < 0 ||
+      ::bind(m_listenFd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0 ||
+      ::chmod(addr.sun_path, 0600) != 0 || ::listen(m_listenFd, SOMAXCONN) != 0 ||
+      !SetNonBlocking(m_listenFd)) {
+    const std::string reason = std::strerror(errno);
+    if (m_listenFd >= 0) {
+      ::close(m_listenFd);
+      m_listenFd = -1;
+    }
+    return Fail(errorMessage, "Failed to listen on " +
+                                  m_options.socketPath.string() + ": " + reason);
+  }
+  int pipeFds[2];
+  if (::pipe(pipeFds) != 0 || !SetNonBlocking(pipeFds[0]) ||
+      !SetNonBlocking(pipeFds[1])) {
+    ::close(m_listenFd);
+    m_listenFd = -1;
+    ::unlink(addr.sun_path);
+    return Fail(errorMessage, "Failed to create wake pipe.");
+  }
+  m_wakeRead = pipeFds[0];
+  m_wakeWrite = pipeFds[1];
+
+  m_stopping = false;
+  m_loopExit = false;
+  m_jobs.clear();
+  m_completions.clear();
+  unsigned threads = m_options.workerThreads;
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  m_running = true;
+  for (unsigned i = 0; i < threads; ++i) {
+    m_workers.emplace_back([this] { WorkerLoop(); });
+  }
+  m_loop = std::thread([this] { EventLoop(); });
+  return true;
+}
+
+void ModelServer::Stop() {
+  if (!m_running.exchange(false)) {
+    return;
+  }
+  // 先停工作线程（完成手头请求），再停事件循环，保证关闭连接时无人写入。
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_cv.notify_all();
+  for (auto &worker : m_workers) {
+    worker.join();
+  }
+  m_workers.clear();
+  m_loopExit = true;
+  Wake();
+  m_loop.join();
+
+  ::close(m_listenFd);
+  ::close(m_wakeRead);
+  ::close(m_wakeWrite);
+  m_listenFd = m_wakeRead = m_wakeWrite = -1;
+  ::unlink(m_options.socketPath.c_str());
+}
+
+void ModelServer::Wake() {
+  const char byte = 1;
+  // 管道满时已有未处理的唤醒，忽略 EAGAIN。
+  [[maybe_unused]] const ssize_t n = ::write(m_wakeWrite, &byte, 1);
+}
+
+void ModelServer::WorkerLoop() {
+  for (;;) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+      if (m_stopping) {
+        return;
+      }
+      job = std::move(m_jobs.front());
+      m_jobs.pop_front();
+    }
+
+    std::string payload;
+    Status status = Status::Ok;
+    try {
+      status = Handle(job.opcode, job.payload, payload);
+    } catch (const std::exception &ex) {
+      status = Reply(payload, Status::Failed, ex.what());
+    }
+    std::string frame;
+    frame.reserve(kFrameHeaderBytes + payload.size());
+    AppendFrameHeader(frame, {static_cast<std::uint32_t>(payload.size()),
+                              job.opcode, status});
+    frame += payload;
+    const bool ok = SendAll(job.fd, frame);
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_completions.push_back({job.fd, ok});
+    }
+    Wake();
+  }
+}
+
+void ModelServer::EventLoop() {
+  struct Connection {
+    std::string input;
+    bool busy = false;   ///< 有请求在工作线程中处理
+    bool closed = false; ///< 对端已关闭，处理完当前请求后释放
+  };
+  std::unordered_map<int, Connection> connections;
+  std::vector<pollfd> pollFds;
+
+  auto release = [&](int fd) {
+    ::close(fd);
+    connections.erase(fd);
+  };
+  // 缓冲区中有完整帧时交给工作线程；帧头非法时返回 false。
+  auto dispatch = [&](int fd, Connection &connection) {
+    FrameHeader header;
+    if (connection.busy || !ParseFrameHeader(connection.input, header)) {
+      return true;
+    }
+    if (header.payloadBytes > kMaxPayloadBytes || header.status != Status::Ok) {
+      return false;
+    }
+    if (connection.input.size() < kFrameHeaderBytes + header.payloadBytes) {
+      return true;
+    }
+    Job job{fd, header.opcode,
+            connection.input.substr(kFrameHeaderBytes, header.payloadBytes)};
+    connection.input.erase(0, kFrameHeaderBytes + header.payloadBytes);
+    connection.busy = true;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_jobs.push_back(std::move(job));
+    }
+    m_cv.notify_one();
+    return true;
+  };
+
+  char buffer[64 * 1024];
+  while (!m_loopExit.load()) {
+    pollFds.clear();
+    pollFds.push_back({m_listenFd, POLLIN, 0});
+    pollFds.push_back({m_wakeRead, POLLIN, 0});
+    for (const auto &[fd, connection] : connections) {
+      if (!connection.busy) {
+        pollFds.push_back({fd, POLLIN, 0});
+      }
+    }
+    if (::poll(pollFds.data(), pollFds.size(), -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+
+    if (pollFds[1].revents & POLLIN) {
+      while (::read(m_wakeRead, buffer, sizeof(buffer)) > 0) {
+      }
+      std::vector<Completion> completions;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        completions.swap(m_completions);
+      }
+      for (const auto &completion : completions) {
+        auto it = connections.find(completion.fd);
+        if (it == connections.end()) {
+          continue;
+        }
+        it->second.busy = false;
+        if (!completion.ok || it->second.closed ||
+            !dispatch(completion.fd, it->second)) {
+          if (!it->second.busy) {
+            release(completion.fd);
+          }
+        }
+      }
+    }
+
+    if (pollFds[0].revents & POLLIN) {
+      for (;;) {
+        const int fd = ::accept(m_listenFd, nullptr, nullptr);
+        if (fd < 0) {
+          break;
+        }
+        if (connections.size() >= m_options.maxConnections || !SetNonBlocking(fd)) {
+          ::close(fd);
+          continue;
+        }
+        DisableSigPipe(fd);
+        connections.emplace(fd, Connection{});
+      }
+    }
+
+    for (std::size_t i = 2; i < pollFds.size(); ++i) {
+      if (!pollFds[i].revents) {
+        continue;
+      }
+      const int fd = pollFds[i].fd;
+      auto it = connections.find(fd);
+      if (it == connections.end()) {
+        continue;
+      }
+      Connection &connection = it->second;
+      for (;;) {
+        const ssize_t n = ::read(fd, buffer, sizeof(buffer));
+        if (n > 0) {
+          connection.input.append(buffer, static_cast<std::size_t>(n));
+          continue;
+        }
+        if (n < 0 && errno == EINTR) {
+          continue;
+        }
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+          connection.closed = true;
+        }
+        break;
+      }
+      const bool valid = dispatch(fd, connection);
+      if ((!valid || connection.closed) && !connection.busy) {
+        release(fd);
+      } else if (!valid) {
+        connection.closed = true;
+      }
+    }
+  }
+
+  // 工作线程已全部退出，可以安全关闭所有连接。
+  for (const auto &[fd, connection] : connections) {
+    ::close(fd);
+  }
+}
+
+#endif
+
+} // namespace Server
+} // namespace CADExchange
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "ServerProtocol.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace CADExchange {
+
+class ModelCache;
+
+namespace Server {
+
+/**
+ * @file ModelServer.h
+ * @brief 常驻模型服务：经 Unix 域套接字提供加载、查询、校验、单位换算、
+ *        保存与几何比对，模型通过 ModelCache 常驻内存。
+ */
+
+/**
+ * @brief ModelServer 的选项。
+ */
+struct ModelServerOptions {
+  std::filesystem::path socketPath;
+  unsigned workerThreads = 0;       ///< 0 表示 hardware_concurrency
+  std::size_t maxConnections = 256; ///< 超出时新连接被立即关闭
+  ModelCache *cache = nullptr;      ///< 为空时使用 ModelCache::Instance()
+};
+
+/**
+ * @class ModelServer
+ * @brief 单事件循环 + 工作线程池的本地模型服务。
+ *
+ * 事件循环线程用 poll() 接受连接、读取完整帧并把请求交给工作线程；
+ * 工作线程执行请求并直接写回响应。每个连接同一时刻只有一个请求在处理，
+ * 因此响应顺序与请求顺序一致，客户端无需请求 ID。
+ *
+ * 套接字文件以 0600 权限创建，只接受本机同一用户的连接。启动时若路径上
+ * 残留无人监听的旧套接字则替换，有服务在监听则启动失败。
+ *
+ * 请求中的路径由服务进程解析，客户端应传绝对路径（ModelClient 会自动转换）。
+ * Windows 下 Start() 返回 false。
+ */
+class ModelServer {
+public:
+  explicit ModelServer(ModelServerOptions options);
+  ~ModelServer();
+
+  ModelServer(const ModelServer &) = delete;
+  ModelServer &operator=(const ModelServer &) = delete;
+
+  /// 绑定套接字并启动事件循环与工作线程。
+  bool Start(std::string *errorMessage = nullptr);
+
+  /// 停止服务、关闭全部连接并删除套接字文件；可重复调用。
+  void Stop();
+
+  bool IsRunning() const { return m_running.load(); }
+  const std::filesystem::path &SocketPath() const { return m_options.socketPath; }
+
+  /**
+   * @brief 执行一个请求并生成响应 payload（不含帧头）。
+   *
+   * 供工作线程与进程内调用共用，不涉及套接字。
+   */
+  Status Handle(Opcode opcode, std::string_view request, std::string &response);
+
+private:
+  struct Job {
+    int fd = -1;
+    Opcode opcode = Opcode::Ping;
+    std::string payload;
+  };
+
+  struct Completion {
+    int fd = -1;
+    bool ok = false;
+  };
+
+  void EventLoop();
+  void WorkerLoop();
+  void Wake();
+
+  ModelServerOptions m_options;
+  ModelCache *m_cache = nullptr;
+  std::atomic<bool> m_running{false};
+  std::atomic<bool> m_loopExit{false}; ///< 工作线程退出后才置位
+  int m_listenFd = -1;
+  int m_wakeRead = -1;
+  int m_wakeWrite = -1;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<Job> m_jobs;
+  std::vector<Completion> m_completions;
+  bool m_stopping = false;
+
+  std::thread m_loop;
+  std::vector<std::thread> m_workers;
+};
+
+} // namespace Server
+} // namespace CADExchange
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "../../core/UnifiedModel.h"
+#include "../../core/detail/IoHelpers.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CADExchange {
+namespace Server {
+
+/**
+ * @file ServerProtocol.h
+ * @brief cadex_served 的二进制帧格式与请求/响应编码。
+ *
+ * 每个请求与响应都是一帧：
+ *   帧头（8 字节，小端）：u32 payload 字节数 | u16 opcode | u16 status
+ *   payload：按 WireWriter 规则顺序编码的字段
+ * 请求的 status 恒为 0；响应回传请求的 opcode，status 非 Ok 时 payload
+ * 为一个错误信息字符串。同一连接上的请求按顺序逐个处理。
+ *
+ * 各 opcode 的字段（→ 之后为成功响应）：
+ *   Ping            : (空) → (空)
+ *   Load            : str path, u8 format → u32 unit, str modelName, u64 featureCount
+ *   ListFeatures    : str path, u8 format → u32 n, n × {str id, str name, u16 type}
+ *   GetFeature      : str path, u8 format, str featureID → str 单特征 CEREAL_JSON 模型
+ *   Validate        : str path, u8 format → u8 isValid, strs errors, strs warnings
+ *   ConvertUnit     : str path, u8 format, u32 targetUnit, str outPath, u8 outFormat → u64 bytes
+ *   Save            : str path, u8 format, str outPath, u8 outFormat → u64 bytes
+ *   CompareGeometry : str srcJson, str dstJson, f64 tol(0=按源单位取默认) → u8 equivalent, strs diagnostics
+ * 其中 str 为 u32 长度 + 字节，strs 为 u32 个数 + 逐个 str。
+ */
+
+constexpr std::size_t kFrameHeaderBytes = 8;
+/// 单帧 payload 上限；超出时服务端直接断开连接。
+constexpr std::uint32_t kMaxPayloadBytes = 64u << 20;
+
+enum class Opcode : std::uint16_t {
+  Ping = 1,
+  Load = 2,
+  ListFeatures = 3,
+  GetFeature = 4,
+  Validate = 5,
+  ConvertUnit = 6,
+  Save = 7,
+  CompareGeometry = 8,
+};
+
+enum class Status : std::uint16_t {
+  Ok = 0,
+  BadRequest = 1, ///< payload 无法解码或 opcode 未知
+  Failed = 2,     ///< 请求合法但执行失败（文件不存在、校验失败等）
+};
+
+struct FrameHeader {
+  std::uint32_t payloadBytes = 0;
+  Opcode opcode = Opcode::Ping;
+  Status status = Status::Ok;
+};
+
+/**
+ * @brief Load 的响应。
+ */
+struct ModelSummary {
+  UnitType unit = UnitType::METER;
+  std::string modelName;
+  std::uint64_t featureCount = 0;
+};
+
+/**
+ * @brief ListFeatures 的单项。
+ */
+struct FeatureSummary {
+  std::string featureID;
+  std::string featureName;
+  FeatureType featureType = FeatureType::Unknown;
+};
+
+/**
+ * @brief CompareGeometry 的响应。
+ */
+struct GeometryCompareSummary {
+  bool equivalent = false;
+  std::vector<std::string> diagnostics;
+};
+
+/**
+ * @brief 顺序写入小端字段。
+ */
+class WireWriter {
+public:
+  explicit WireWriter(std::string &out) : m_out(out) {}
+
+  void U8(std::uint8_t value) { m_out.push_back(static_cast<char>(value)); }
+  void U16(std::uint16_t value) { Put(value); }
+  void U32(std::uint32_t value) { Put(value); }
+  void U64(std::uint64_t value) { Put(value); }
+  void F64(double value) {
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    Put(bits);
+  }
+  void Str(std::string_view value) {
+    U32(static_cast<std::uint32_t>(value.size()));
+    m_out.append(value.data(), value.size());
+  }
+  void Strs(const std::vector<std::string> &values) {
+    U32(static_cast<std::uint32_t>(values.size()));
+    for (const auto &value : values) {
+      Str(value);
+    }
+  }
+
+private:
+  template <typename T> void Put(T value) { detail::PutLE(m_out, value); }
+
+  std::string &m_out;
+};
+
+/**
+ * @brief 顺序读取小端字段；越界后 Ok() 为 false，后续读取返回零值。
+ */
+class WireReader {
+public:
+  explicit WireReader(std::string_view data) : m_data(data) {}
+
+  bool Ok() const { return m_ok; }
+  bool AtEnd() const { return m_pos == m_data.size(); }
+
+  std::uint8_t U8() { return Get<std::uint8_t>(); }
+  std::uint16_t U16() { return Get<std::uint16_t>(); }
+  std::uint32_t U32() { return Get<std::uint32_t>(); }
+  std::uint64_t U64() { return Get<std::uint64_t>(); }
+  double F64() {
+    const std::uint64_t bits = Get<std::uint64_t>();
+    double value = 0.0;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+  std::string Str() {
+    const std::uint32_t size = U32();
+    if (!m_ok || m_data.size() - m_pos < size) {
+      m_ok = false;
+      return {};
+    }
+    std::string value(m_data.substr(m_pos, size));
+    m_pos += size;
+    return value;
+  }
+  std::vector<std::string> Strs() {
+    const std::uint32_t count = U32();
+    std::vector<std::string> values;
+    // 每项至少 4 字节长度前缀，据此拒绝伪造的超大计数。
+    if (!m_ok || (m_data.size() - m_pos) / 4 < count) {
+      m_ok = false;
+      return values;
+    }
+    values.reserve(count);
+    for (std::uint32_t i = 0; i < count && m_ok; ++i) {
+      values.push_back(Str());
+    }
+    return values;
+  }
+
+private:
+  template <typename T> T Get() {
+    if (!m_ok || m_data.size() - m_pos < sizeof(T)) {
+      m_ok = false;
+      return 0;
+    }
+    const T value = detail::GetLE<T>(m_data.data() + m_pos);
+    m_pos += sizeof(T);
+    return value;
+  }
+
+  std::string_view m_data;
+  std::size_t m_pos = 0;
+  bool m_ok = true;
+};
+
+/// 把帧头写到 out 末尾。
+inline void AppendFrameHeader(std::string &out, const FrameHeader &header) {
+  WireWriter writer(out);
+  writer.U32(header.payloadBytes);
+  writer.U16(static_cast<std::uint16_t>(header.opcode));
+  writer.U16(static_cast<std::uint16_t>(header.status));
+}
+
+/// 解析 data 开头的帧头；data 不足 kFrameHeaderBytes 时返回 false。
+inline bool ParseFrameHeader(std::string_view data, FrameHeader &header) {
+  if (data.size() < kFrameHeaderBytes) {
+    return false;
+  }
+  WireReader reader(data.substr(0, kFrameHeaderBytes));
+  header.payloadBytes = reader.U32();
+  header.opcode = static_cast<Opcode>(reader.U16());
+  header.status = static_cast<Status>(reader.U16());
+  return true;
+}
+
+} // namespace Server
+} // namespace CADExchange
@@ -0,0 +1,340 @@
+#include "SharedModelChannel.h"
+#include "../../core/detail/IoHelpers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace CADExchange {
+namespace Server {
+
+namespace {
+
+using detail::Fail;
+
+} // namespace
+
+#ifdef _WIN32
+
+struct SharedModelChannel::Segment {};
+
+SharedModelChannel::~SharedModelChannel() = default;
+
+bool SharedModelChannel::Create(const std::string &, const SharedModelChannelOptions &,
+                                std::string *errorMessage) {
+  return Fail(errorMessage, "SharedModelChannel requires POSIX shared memory.");
+}
+
+bool SharedModelChannel::Open(const std::string &, std::string *errorMessage) {
+  return Fail(errorMessage, "SharedModelChannel requires POSIX shared memory.");
+}
+
+void SharedModelChannel::Close() { m_segment.reset(); }
+
+bool SharedModelChannel::Remove(const std::string &) { return false; }
+
+bool SharedModelChannel::Publish(const UnifiedModel &, std::string *errorMessage,
+                                 std::uint64_t *) {
+  return Fail(errorMessage, "SharedModelChannel requires POSIX shared memory.");
+}
+
+std::shared_ptr<const ModelImageView>
+SharedModelChannel::Acquire(std::string *errorMessage, std::uint64_t *) {
+  Fail(errorMessage, "SharedModelChannel requires POSIX shared memory.");
+  return nullptr;
+}
+
+std::uint64_t SharedModelChannel::LatestGeneration() const { return 0; }
+
+#else
+
+namespace {
+
+constexpr char kMagic[4] = {'C', 'X', 'S', 'M'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint32_t kMaxSlots = 0xFFFF;
+constexpr int kAcquireAttempts = 16;
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free &&
+                  std::atomic<std::uint32_t>::is_always_lock_free,
+              "Shared-memory counters must be lock-free");
+
+/// 段头；latest 打包为 (代数 << 16) | 槽号，0 表示尚未发布。
+struct alignas(64) SegmentHeader {
+  char magic[4];
+  std::uint32_t version;
+  std::uint32_t slotCount;
+  std::uint32_t reserved;
+  std::uint64_t slotBytes;
+  std::uint64_t totalBytes;
+  std::atomic<std::uint64_t> publishSeq;
+  std::atomic<std::uint64_t> latest;
+};
+
+/// 槽头；generation 为 2 * 代数，写入期间为奇数，0 表示从未写入。
+struct alignas(64) SlotHeader {
+  std::atomic<std::uint64_t> generation;
+  std::atomic<std::uint32_t> readers;
+  std::uint32_t reserved;
+  std::uint64_t imageBytes;
+};
+
+std::size_t AlignUp(std::size_t value) { return (value + 63) & ~std::size_t(63); }
+
+std::size_t SlotStride(std::uint64_t slotBytes) {
+  return sizeof(SlotHeader) + AlignUp(static_cast<std::size_t>(slotBytes));
+}
+
+std::string ShmName(const std::string &name) {
+  return (!name.empty() && name.front() == '/') ? name : "/" + name;
+}
+
+} // namespace
+
+struct SharedModelChannel::Segment {
+  char *base = nullptr;
+  std::size_t size = 0;
+
+  ~Segment() {
+    if (base) {
+      ::munmap(base, size);
+    }
+  }
+
+  SegmentHeader *Header() const { return reinterpret_cast<SegmentHeader *>(base); }
+
+  SlotHeader *Slot(std::uint32_t index) const {
+    return reinterpret_cast<SlotHeader *>(
+        base + sizeof(SegmentHeader) + index * SlotStride(Header()->slotBytes));
+  }
+
+  char *SlotData(std::uint32_t index) const {
+    return reinterpret_cast<char *>(Slot(index)) + sizeof(SlotHeader);
+  }
+};
+
+namespace {
+
+/// 视图存活期间持有段映射与槽的读者计数。
+struct SlotPin {
+  std::shared_ptr<const void> segment;
+  SlotHeader *slot = nullptr;
+  ~SlotPin() { slot->readers.fetch_sub(1); }
+};
+
+} // namespace
+
+SharedModelChannel::~SharedModelChannel() { Close(); }
+
+bool SharedModelChannel::Create(const std::string &name,
+                                const SharedModelChannelOptions &options,
+                                std::string *errorMessage) {
+  Close();
+  if (options.slotCount == 0 || options.slotCount > kMaxSlots || options.slotBytes == 0) {
+    return Fail(errorMessage, "Invalid shared-memory channel options.");
+  }
+  const std::string shmName = ShmName(name);
+  const std::size_t total =
+      sizeof(SegmentHeader) + options.slotCount * SlotStride(options.slotBytes);
+
+  // 先删除旧段再独占创建：仍映射旧段的消费者继续读取旧内容，不会看到截断。
+  ::shm_unlink(shmName.c_str());
+  const int fd = ::shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    return Fail(errorMessage,
+                "Failed to create shared memory " + shmName + ": " + std::strerror(errno));
+  }
+  void *base = MAP_FAILED;
+  if (::ftruncate(fd, static_cast<off_t>(total)) == 0) {
+    base = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  const std::string reason = std::strerror(errno);
+  ::close(fd);
+  if (base == MAP_FAILED) {
+    ::shm_unlink(shmName.c_str());
+    return Fail(errorMessage, "Failed to map shared memory " + shmName + ": " + reason);
+  }
+
+  auto segment = std::make_shared<Segment>();
+  segment->base = static_cast<char *>(base);
+  segment->size = total;
+  auto *header = new (base) SegmentHeader();
+  header->version = kVersion;
+  header->slotCount = options.slotCount;
+  header->slotBytes = options.slotBytes;
+  header->totalBytes = total;
+  header->publishSeq.store(0);
+  header->latest.store(0);
+  for (std::uint32_t i = 0; i < options.slotCount; ++i) {
+    auto *slot = new (segment->Slot(i)) SlotHeader();
+    slot->generation.store(0);
+    slot->readers.store(0);
+    slot->imageBytes = 0;
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(header->magic, kMagic, 4);
+  m_segment = std::move(segment);
+  return true;
+}
+
+bool SharedModelChannel::Open(const std::string &name, std::string *errorMessage) {
+  Close();
+  const std::string shmName = ShmName(name);
+  const int fd = ::shm_open(shmName.c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    return Fail(errorMessage,
+                "Failed to open shared memory " + shmName + ": " + std::strerror(errno));
+  }
+  struct stat info;
+  if (::fstat(fd, &info) != 0 ||
+      static_cast<std::size_t>(info.st_size) < sizeof(SegmentHeader)) {
+    ::close(fd);
+    return Fail(errorMessage, "Shared memory " + shmName + " is not a model channel.");
+  }
+  const std::size_t size = static_cast<std::size_t>(info.st_size);
+  void *base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (base == MAP_FAILED) {
+    return Fail(errorMessage, "Failed to map shared memory " + shmName + ": " +
+                                  std::strerror(errno));
+  }
+
+  auto segment = std::make_shared<Segment>();
+  segment->base = static_cast<char *>(base);
+  segment->size = size;
+  const SegmentHeader *header = segment->Header();
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (std::memcmp(header->magic, kMagic, 4) != 0 || header->version != kVersion ||
+      header->slotCount == 0 || header->slotCount > kMaxSlots ||
+      header->totalBytes != size ||
+      sizeof(SegmentHeader) + header->slotCount * SlotStride(header->slotBytes) != size) {
+    return Fail(errorMessage, "Shared memory " + shmName + " is not a model channel.");
+  }
+  m_segment = std::move(segment);
+  return true;
+}
+
+void SharedModelChannel::Close() { m_segment.reset(); }
+
+bool SharedModelChannel::Remove(const std::string &name) {
+  return ::shm_unlink(ShmName(name).c_str()) == 0;
+}
+
+bool SharedModelChannel::Publish(const UnifiedModel &model, std::string *errorMessage,
+                                 std::uint64_t *generation) {
+  if (!m_segment) {
+    return Fail(errorMessage, "SharedModelChannel is not open.");
+  }
+  if (!BuildModelImage(model, m_scratch, errorMessage)) {
+    return false;
+  }
+  SegmentHeader *header = m_segment->Header();
+  if (m_scratch.size() > header->slotBytes) {
+    return Fail(errorMessage, "Model image (" + std::to_string(m_scratch.size()) +
+                                  " bytes) exceeds the channel slot size.");
+  }
+
+  const std::uint64_t seq = header->publishSeq.fetch_add(1) + 1;
+  const std::uint64_t latest = header->latest.load();
+  const std::uint32_t slotCount = header->slotCount;
+
+  // 优先覆盖最旧的槽；槽数大于 1 时保留当前最新槽，避免消费者扑空。
+  std::vector<std::pair<std::uint64_t, std::uint32_t>> order(slotCount);
+  for (std::uint32_t i = 0; i < slotCount; ++i) {
+    order[i] = {m_segment->Slot(i)->generation.load(), i};
+  }
+  std::sort(order.begin(), order.end());
+  for (const auto &candidate : order) {
+    const std::uint32_t index = candidate.second;
+    if (slotCount > 1 && latest != 0 && index == (latest & kMaxSlots)) {
+      continue;
+    }
+    SlotHeader *slot = m_segment->Slot(index);
+    std::uint64_t current = slot->generation.load();
+    if ((current & 1) != 0 || slot->readers.load() != 0 ||
+        !slot->generation.compare_exchange_strong(current, 2 * seq + 1)) {
+      continue;
+    }
+    // 与 Acquire 的“先加读者再读代数”配对：两边都用顺序一致原子操作，
+    // 至少有一方能看到对方，因此不会覆盖已被固定的槽。
+    if (slot->readers.load() != 0) {
+      slot->generation.store(current);
+      continue;
+    }
+    std::memcpy(m_segment->SlotData(index), m_scratch.data(), m_scratch.size());
+    slot->imageBytes = m_scratch.size();
+    slot->generation.store(2 * seq);
+
+    const std::uint64_t packed = (seq << 16) | index;
+    std::uint64_t previous = header->latest.load();
+    while ((previous >> 16) < seq &&
+           !header->latest.compare_exchange_weak(previous, packed)) {
+    }
+    if (generation) {
+      *generation = seq;
+    }
+    return true;
+  }
+  return Fail(errorMessage, "All shared-memory slots are in use by readers.");
+}
+
+std::shared_ptr<const ModelImageView>
+SharedModelChannel::Acquire(std::string *errorMessage, std::uint64_t *generation) {
+  if (!m_segment) {
+    Fail(errorMessage, "SharedModelChannel is not open.");
+    return nullptr;
+  }
+  SegmentHeader *header = m_segment->Header();
+  for (int attempt = 0; attempt < kAcquireAttempts; ++attempt) {
+    const std::uint64_t latest = header->latest.load();
+    if (latest == 0) {
+      Fail(errorMessage, "Nothing has been published on this channel.");
+      return nullptr;
+    }
+    const std::uint32_t index = static_cast<std::uint32_t>(latest & kMaxSlots);
+    const std::uint64_t seq = latest >> 16;
+    if (index >= header->slotCount) {
+      break;
+    }
+    SlotHeader *slot = m_segment->Slot(index);
+    slot->readers.fetch_add(1);
+    auto pin = std::make_shared<SlotPin>();
+    pin->segment = m_segment;
+    pin->slot = slot;
+    if (slot->generation.load() != 2 * seq) {
+      continue; // 槽已被复用，pin 析构时归还读者计数
+    }
+    if (slot->imageBytes > header->slotBytes) {
+      break;
+    }
+    auto view = ModelImageView::Open(
+        std::string_view(m_segment->SlotData(index), static_cast<std::size_t>(slot->imageBytes)),
+        errorMessage, std::move(pin));
+    if (view && generation) {
+      *generation = seq;
+    }
+    return view;
+  }
+  Fail(errorMessage, "Shared-memory channel is corrupt or too busy.");
+  return nullptr;
+}
+
+std::uint64_t SharedModelChannel::LatestGeneration() const {
+  return m_segment ? m_segment->Header()->latest.load() >> 16 : 0;
+}
+
+#endif
+
+} // namespace Server
+} // namespace CADExchange
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../serialization/ModelImage.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace CADExchange {
+namespace Server {
+
+/**
+ * @file SharedModelChannel.h
+ * @brief 基于 POSIX 共享内存的本机模型交换：生产者发布扁平模型镜像，
+ *        消费者直接在映射内存上读取，不经过磁盘与解析。
+ *
+ * 段布局：段头 | 槽 0 | 槽 1 | ...，每个槽是固定容量的镜像缓冲区，
+ * 槽头记录代数（generation）与读者计数。发布写入一个无人读取的旧槽，
+ * 完成后把“最新槽”指向它；消费者固定（pin）最新槽并得到零拷贝视图，
+ * 视图存活期间该槽不会被覆盖。
+ */
+
+/**
+ * @brief 创建通道时的段参数。
+ */
+struct SharedModelChannelOptions {
+  std::uint32_t slotCount = 4;          ///< 环形槽数量，至少 2 才能在读取时继续发布
+  std::size_t slotBytes = 64u << 20;    ///< 单个槽可容纳的最大镜像字节数
+};
+
+/**
+ * @class SharedModelChannel
+ * @brief 一个命名共享内存段上的发布/获取端点，生产者与消费者使用同一个类。
+ *
+ * 名称遵循 shm_open 规则（不以 '/' 开头时自动补上）。允许多个生产者与
+ * 多个消费者并发使用；槽的占用通过段内原子计数协调，不依赖任何锁。
+ *
+ * 消费者进程异常退出时其持有的读者计数不会归还，对应槽将一直视为占用，
+ * 直到生产者重新 Create() 该通道。仅支持 POSIX 平台，其他平台上
+ * Create()/Open() 返回 false。
+ */
+class SharedModelChannel {
+public:
+  SharedModelChannel() = default;
+  ~SharedModelChannel();
+
+  SharedModelChannel(const SharedModelChannel &) = delete;
+  SharedModelChannel &operator=(const SharedModelChannel &) = delete;
+
+  /// 创建（或替换同名的）共享内存段；已映射旧段的消费者不受影响。
+  bool Create(const std::string &name, const SharedModelChannelOptions &options = {},
+              std::string *errorMessage = nullptr);
+
+  /// 映射已有的共享内存段。
+  bool Open(const std::string &name, std::string *errorMessage = nullptr);
+
+  /// 解除本端映射；已获取的视图继续有效。
+  void Close();
+  bool IsOpen() const { return m_segment != nullptr; }
+
+  /// 删除命名段（已映射的进程不受影响）。
+  static bool Remove(const std::string &name);
+
+  /**
+   * @brief 编码并发布模型。
+   *
+   * @param generation 可选，输出本次发布的代数（单调递增）。
+   * @return 镜像超出槽容量或所有候选槽都被读者占用时返回 false。
+   */
+  bool Publish(const UnifiedModel &model, std::string *errorMessage = nullptr,
+               std::uint64_t *generation = nullptr);
+
+  /**
+   * @brief 获取最新发布的模型视图。
+   *
+   * 视图直接引用共享内存，存活期间对应槽保持占用；请在用完后尽快释放。
+   *
+   * @return 尚未发布或段已损坏时返回空指针并写入 errorMessage。
+   */
+  std::shared_ptr<const ModelImageView> Acquire(std::string *errorMessage = nullptr,
+                                                std::uint64_t *generation = nullptr);
+
+  /// 最新发布的代数，尚未发布时为 0。
+  std::uint64_t LatestGeneration() const;
+
+private:
+  struct Segment;
+
+  std::shared_ptr<Segment> m_segment;
+  std::string m_scratch; ///< 编码缓冲区，跨 Publish 复用容量
+};
+
+} // namespace Server
+} // namespace CADExchange
@@ -0,0 +1,89 @@
+/**
+ * @file cadex_served.cpp
+ * @brief 常驻模型服务进程：在 Unix 域套接字上运行 ModelServer，直到收到
+ *        SIGINT/SIGTERM。
+ *
+ * 用法：cadex_served --socket <path> [--threads <n>] [--cache-mb <n>]
+ *                    [--snapshots] [--watch]
+ */
+
+#include "ModelServer.h"
+#include "../serialization/ModelCache.h"
+
+#include <csignal>
+#include <iostream>
+#include <pthread.h>
+#include <signal.h>
+#include <string>
+
+namespace {
+
+struct ServeOptions {
+  CADExchange::Server::ModelServerOptions server;
+  CADExchange::ModelCacheOptions cache;
+};
+
+bool ParseArgs(int argc, char *argv[], ServeOptions &out, std::string &errorMessage) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    try {
+      if (arg == "--socket" && i + 1 < argc) {
+        out.server.socketPath = argv[++i];
+      } else if (arg == "--threads" && i + 1 < argc) {
+        out.server.workerThreads = static_cast<unsigned>(std::stoul(argv[++i]));
+      } else if (arg == "--cache-mb" && i + 1 < argc) {
+        out.cache.byteBudget = static_cast<std::size_t>(std::stoul(argv[++i])) << 20;
+      } else if (arg == "--snapshots") {
+        out.cache.useSnapshots = true;
+      } else if (arg == "--watch") {
+        out.cache.watchFiles = true;
+      } else {
+        errorMessage = "unknown argument: " + arg;
+        return false;
+      }
+    } catch (const std::exception &) {
+      errorMessage = "invalid value for " + arg;
+      return false;
+    }
+  }
+  if (out.server.socketPath.empty()) {
+    errorMessage = "missing --socket";
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  ServeOptions options;
+  std::string error;
+  if (!ParseArgs(argc, argv, options, error)) {
+    std::cerr << "cadex_served: " << error << "\n"
+              << "usage: cadex_served --socket <path> [--threads <n>]"
+                 " [--cache-mb <n>] [--snapshots] [--watch]\n";
+    return 2;
+  }
+
+  // 在启动任何线程前屏蔽信号，由主线程同步等待。
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+  std::signal(SIGPIPE, SIG_IGN);
+
+  CADExchange::ModelCache::Instance().SetOptions(options.cache);
+  CADExchange::Server::ModelServer server(options.server);
+  if (!server.Start(&error)) {
+    std::cerr << "cadex_served: " << error << "\n";
+    return 1;
+  }
+  std::cerr << "cadex_served: listening on " << server.SocketPath().string() << "\n";
+
+  int received = 0;
+  sigwait(&signals, &received);
+  std::cerr << "cadex_served: shutting down\n";
+  server.Stop();
+  return 0;
+}
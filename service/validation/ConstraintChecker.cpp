@@ -0,0 +1,654 @@
+// clang-format off
+#include "ConstraintChecker.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+// clang-format on
+
+namespace CADExchange {
+
+namespace {
+
+using ConstraintType = CSketchConstraint::ConstraintType;
+using SubEntity = SketchConstraintSubEntity;
+
+const char *TypeName(ConstraintType type) {
+  switch (type) {
+  case ConstraintType::COINCIDENT: return "COINCIDENT";
+  case ConstraintType::USEEDGE: return "USEEDGE";
+  case ConstraintType::HORIZONTAL: return "HORIZONTAL";
+  case ConstraintType::VERTICAL: return "VERTICAL";
+  case ConstraintType::PARALLEL: return "PARALLEL";
+  case ConstraintType::PERPENDICULAR: return "PERPENDICULAR";
+  case ConstraintType::TANGENT: return "TANGENT";
+  case ConstraintType::CONCENTRIC: return "CONCENTRIC";
+  case ConstraintType::EQUAL: return "EQUAL";
+  case ConstraintType::DISTANCE: return "DISTANCE";
+  case ConstraintType::ANGLE: return "ANGLE";
+  case ConstraintType::RADIUS: return "RADIUS";
+  case ConstraintType::DIAMETER: return "DIAMETER";
+  case ConstraintType::SYMMETRIC: return "SYMMETRIC";
+  case ConstraintType::MIDPOINT: return "MIDPOINT";
+  case ConstraintType::COLLINEAR: return "COLLINEAR";
+  case ConstraintType::FIXED: return "FIXED";
+  default: return "UNKNOWN";
+  }
+}
+
+// ---------------------------------------------------------------------------
+// Resolved operands
+// ---------------------------------------------------------------------------
+
+struct Operand {
+  enum class Shape { Point, Line, Circle } shape = Shape::Point;
+  double x = 0.0, y = 0.0;   ///< Point, line start or circle center.
+  double x2 = 0.0, y2 = 0.0; ///< Line end.
+  double radius = 0.0;
+
+  double Length() const { return std::hypot(x2 - x, y2 - y); }
+};
+
+enum class ResolveResult { Ok, External, Missing };
+
+CPoint3D ArcPointAt(const CSketchArc &arc, double angle) {
+  return {arc.center.x + arc.radius * std::cos(angle),
+          arc.center.y + arc.radius * std::sin(angle), 0.0};
+}
+
+double ArcMidAngle(const CSketchArc &arc) {
+  double sweep = arc.isClockwise ? arc.startAngle - arc.endAngle
+                                 : arc.endAngle - arc.startAngle;
+  sweep = std::fmod(sweep, 2.0 * GeoUtils::PI);
+  if (sweep <= 0.0) {
+    sweep += 2.0 * GeoUtils::PI;
+  }
+  return arc.startAngle + (arc.isClockwise ? -sweep : sweep) * 0.5;
+}
+
+bool MakePoint(const CPoint3D &p, Operand &out) {
+  out.shape = Operand::Shape::Point;
+  out.x = p.x;
+  out.y = p.y;
+  return true;
+}
+
+bool ResolveSegment(const CSketchSeg &seg, SubEntity sub, Operand &out) {
+  switch (seg.type) {
+  case CSketchSeg::SegType::LINE: {
+    const auto *line = dynamic_cast<const CSketchLine *>(&seg);
+    if (!line) {
+      return false;
+    }
+    switch (sub) {
+    case SubEntity::Whole:
+      out.shape = Operand::Shape::Line;
+      out.x = line->startPos.x;
+      out.y = line->startPos.y;
+      out.x2 = line->endPos.x;
+      out.y2 = line->endPos.y;
+      return true;
+    case SubEntity::Start:
+      return MakePoint(line->startPos, out);
+    case SubEntity::End:
+      return MakePoint(line->endPos, out);
+    case SubEntity::Midpoint:
+      return MakePoint({(line->startPos.x + line->endPos.x) * 0.5,
+                        (line->startPos.y + line->endPos.y) * 0.5, 0.0},
+                       out);
+    default:
+      return false;
+    }
+  }
+  case CSketchSeg::SegType::CIRCLE: {
+    const auto *circle = dynamic_cast<const CSketchCircle *>(&seg);
+    if (!circle) {
+      return false;
+    }
+    if (sub == SubEntity::Center) {
+      return MakePoint(circle->center, out);
+    }
+    if (sub != SubEntity::Whole) {
+      return false;
+    }
+    out.shape = Operand::Shape::Circle;
+    out.x = circle->center.x;
+    out.y = circle->center.y;
+    out.radius = circle->radius;
+    return true;
+  }
+  case CSketchSeg::SegType::ARC: {
+    const auto *arc = dynamic_cast<const CSketchArc *>(&seg);
+    if (!arc) {
+      return false;
+    }
+    switch (sub) {
+    case SubEntity::Whole:
+      out.shape = Operand::Shape::Circle;
+      out.x = arc->center.x;
+      out.y = arc->center.y;
+      out.radius = arc->radius;
+      return true;
+    case SubEntity::Center:
+      return MakePoint(arc->center, out);
+    case SubEntity::Start:
+      return MakePoint(ArcPointAt(*arc, arc->startAngle), out);
+    case SubEntity::End:
+      return MakePoint(ArcPointAt(*arc, arc->endAngle), out);
+    case SubEntity::Midpoint:
+      return MakePoint(ArcPointAt(*arc, ArcMidAngle(*arc)), out);
+    }
+    return false;
+  }
+  case CSketchSeg::SegType::POINT: {
+    const auto *point = dynamic_cast<const CSketchPoint *>(&seg);
+    if (!point || (sub != SubEntity::Whole && sub != SubEntity::Center)) {
+      return false;
+    }
+    return MakePoint(point->position, out);
+  }
+  default:
+    return false;
+  }
+}
+
+// ---------------------------------------------------------------------------
+// SoA kernels
+// ---------------------------------------------------------------------------
+
+/// |‖a − b‖ − target|
+struct PointPointBatch {
+  std::vector<double> ax, ay, bx, by, target;
+  std::vector<std::uint32_t> owner;
+
+  void Push(std::uint32_t row, double pax, double pay, double pbx, double pby,
+            double t) {
+    ax.push_back(pax);
+    ay.push_back(pay);
+    bx.push_back(pbx);
+    by.push_back(pby);
+    target.push_back(t);
+    owner.push_back(row);
+  }
+
+  void Evaluate(std::vector<double> &out) const {
+    out.resize(owner.size());
+    const std::size_t n = owner.size();
+    for (std::size_t i = 0; i < n; ++i) {
+      const double dx = ax[i] - bx[i];
+      const double dy = ay[i] - by[i];
+      out[i] = std::abs(std::sqrt(dx * dx + dy * dy) - target[i]);
+    }
+  }
+};
+
+/// |dist(p, line through o with unit direction d) − target|
+struct PointLineBatch {
+  std::vector<double> px, py, ox, oy, dx, dy, target;
+  std::vector<std::uint32_t> owner;
+
+  void Push(std::uint32_t row, double ppx, double ppy, const Operand &line,
+            double t) {
+    const double len = line.Length();
+    px.push_back(ppx);
+    py.push_back(ppy);
+    ox.push_back(line.x);
+    oy.push_back(line.y);
+    dx.push_back((line.x2 - line.x) / len);
+    dy.push_back((line.y2 - line.y) / len);
+    target.push_back(t);
+    owner.push_back(row);
+  }
+
+  void Evaluate(std::vector<double> &out) const {
+    out.resize(owner.size());
+    const std::size_t n = owner.size();
+    for (std::size_t i = 0; i < n; ++i) {
+      const double cross = (px[i] - ox[i]) * dy[i] - (py[i] - oy[i]) * dx[i];
+      out[i] = std::abs(std::abs(cross) - target[i]);
+    }
+  }
+};
+
+/// Angle between undirected unit directions u and v versus target, in [0, π].
+struct DirectionBatch {
+  std::vector<double> ux, uy, vx, vy, target;
+  std::vector<std::uint32_t> owner;
+
+  void Push(std::uint32_t row, double pux, double puy, double pvx, double pvy,
+            double t) {
+    ux.push_back(pux);
+    uy.push_back(puy);
+    vx.push_back(pvx);
+    vy.push_back(pvy);
+    target.push_back(t);
+    owner.push_back(row);
+  }
+
+  void Evaluate(std::vector<double> &out) const {
+    out.resize(owner.size());
+    const std::size_t n = owner.size();
+    for (std::size_t i = 0; i < n; ++i) {
+      const double cross = ux[i] * vy[i] - uy[i] * vx[i];
+      const double dot = ux[i] * vx[i] + uy[i] * vy[i];
+      const double angle = std::atan2(std::abs(cross), dot);
+      out[i] = std::min(std::abs(angle - target[i]),
+                        std::abs(GeoUtils::PI - angle - target[i]));
+    }
+  }
+};
+
+/// |value − target|
+struct ScalarBatch {
+  std::vector<double> value, target;
+  std::vector<std::uint32_t> owner;
+
+  void Push(std::uint32_t row, double v, double t) {
+    value.push_back(v);
+    target.push_back(t);
+    owner.push_back(row);
+  }
+
+  void Evaluate(std::vector<double> &out) const {
+    out.resize(owner.size());
+    const std::size_t n = owner.size();
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = std::abs(value[i] - target[i]);
+    }
+  }
+};
+
+struct Batches {
+  PointPointBatch pointPoint;
+  PointLineBatch pointLine;
+  DirectionBatch direction;
+  ScalarBatch scalar;
+};
+
+enum class Lowering { Ok, Unresolved, Unchecked };
+
+using Shape = Operand::Shape;
+
+bool Is(const std::vector<Operand> &ops, std::initializer_list<Shape> shapes) {
+  if (ops.size() != shapes.size()) {
+    return false;
+  }
+  std::size_t i = 0;
+  for (Shape shape : shapes) {
+    if (ops[i++].shape != shape) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Lowers one constraint into kernel rows tagged with `row`.
+ *
+ * Operand pairs are accepted in either order where the meaning is symmetric.
+ */
+Lowering Lower(const CSketchConstraint &constraint, std::vector<Operand> ops,
+               std::uint32_t row, double lengthTolerance, Batches &b) {
+  const double value = constraint.value.value_or(0.0);
+  auto degenerate = [&](const Operand &op) {
+    return op.shape == Shape::Line && op.Length() <= lengthTolerance;
+  };
+  for (const auto &op : ops) {
+    if (degenerate(op)) {
+      return Lowering::Unresolved;
+    }
+  }
+  // Put points before lines before circles so each case lists one order.
+  std::stable_sort(ops.begin(), ops.end(), [](const Operand &l, const Operand &r) {
+    return static_cast<int>(l.shape) < static_cast<int>(r.shape);
+  });
+  auto unit = [](const Operand &line, double &ux, double &uy) {
+    const double len = line.Length();
+    ux = (line.x2 - line.x) / len;
+    uy = (line.y2 - line.y) / len;
+  };
+  double ux = 0.0, uy = 0.0, vx = 0.0, vy = 0.0;
+
+  switch (constraint.type) {
+  case ConstraintType::COINCIDENT:
+    if (Is(ops, {Shape::Point, Shape::Point})) {
+      b.pointPoint.Push(row, ops[0].x, ops[0].y, ops[1].x, ops[1].y, 0.0);
+    } else if (Is(ops, {Shape::Point, Shape::Line})) {
+      b.pointLine.Push(row, ops[0].x, ops[0].y, ops[1], 0.0);
+    } else if (Is(ops, {Shape::Point, Shape::Circle})) {
+      b.pointPoint.Push(row, ops[0].x, ops[0].y, ops[1].x, ops[1].y,
+                        ops[1].radius);
+    } else if (Is(ops, {Shape::Line, Shape::Line})) {
+      b.pointLine.Push(row, ops[1].x, ops[1].y, ops[0], 0.0);
+      b.pointLine.Push(row, ops[1].x2, ops[1].y2, ops[0], 0.0);
+    } else if (Is(ops, {Shape::Circle, Shape::Circle})) {
+      b.pointPoint.Push(row, ops[0].x, ops[0].y, ops[1].x, ops[1].y, 0.0);
+      b.scalar.Push(row, ops[0].radius, ops[1].radius);
+    } else {
+      return Lowering::Unchecked;
+    }
+    return Lowering::Ok;
+
+  case ConstraintType::HORIZONTAL:
+  case ConstraintType::VERTICAL: {
+    const bool horizontal = constraint.type == ConstraintType::HORIZONTAL;
+    if (Is(ops, {Shape::Line})) {
+      unit(ops[0], ux, uy);
+      b.direction.Push(row, ux, uy, 1.0, 0.0,
+                       horizontal ? 0.0 : GeoUtils::PI / 2);
+    } else if (Is(ops, {Shape::Point, Shape::Point})) {
+      b.scalar.Push(row, horizontal ? ops[0].y : ops[0].x,
+                    horizontal ? ops[1].y : ops[1].x);
+    } else {
+      return Lowering::Unchecked;
+    }
+    return Lowering::Ok;
+  }
+
+  case ConstraintType::PARALLEL:
+  case ConstraintType::PERPENDICULAR:
+    if (!Is(ops, {Shape::Line, Shape::Line})) {
+      return Lowering::Unchecked;
+    }
+    unit(ops[0], ux, uy);
+    unit(ops[1], vx, vy);
+    b.direction.Push(row, ux, uy, vx, vy,
+                     constraint.type == ConstraintType::PARALLEL
+                         ? 0.0
+                         : GeoUtils::PI / 2);
+    return Lowering::Ok;
+
+  case ConstraintType::TANGENT:
+    if (Is(ops, {Shape::Line, Shape::Circle})) {
+      b.pointLine.Push(row, ops[1].x, ops[1].y, ops[0], ops[1].radius);
+    } else if (Is(ops, {Shape::Circle, Shape::Circle})) {
+      // External or internal tangency: compare against the nearer target.
+      const double d = std::hypot(ops[0].x - ops[1].x, ops[0].y - ops[1].y);
+      const double outer = ops[0].radius + ops[1].radius;
+      const double inner = std::abs(ops[0].radius - ops[1].radius);
+      b.pointPoint.Push(row, ops[0].x, ops[0].y, ops[1].x, ops[1].y,
+                        std::abs(d - outer) < std::abs(d - inner) ? outer
+                                                                  : inner);
+    } else {
+      return Lowering::Unchecked;
+    }
+    return Lowering::Ok;
+
+  case ConstraintType::CONCENTRIC:
+    if (ops.size() != 2 || ops[0].shape == Shape::Line ||
+        ops[1].shape == Shape::Line) {
+      return Lowering::Unchecked;
+    }
+    b.pointPoint.Push(row, ops[0].x, ops[0].y, ops[1].x, ops[1].y, 0.0);
+    return Lowering::Ok;
+
+  case ConstraintType::EQUAL:
+    if (Is(ops, {Shape::Line, Shape::Line})) {
+      b.scalar.Push(row, ops[0].Length(), ops[1].Length());
+    } else if (Is(ops, {Shape::Circle, Shape::Circle})) {
+      b.scalar.Push(row, ops[0].radius, ops[1].radius);
+    } else {
+      return Lowering::Unchecked;
+    }
+    return Lowering::Ok;
+
+  case ConstraintType::DISTANCE:
+    if (!constraint.value) {
+      return Lowering::Unresolved;
+    }
+    if (Is(ops, {Shape::Point, Shape::Point})) {
+      b.pointPoint.Push(row, ops[0].x, ops[0].y, ops[1].x, ops[1].y, value);
+    } else if (Is(ops, {Shape::Point, Shape::Line})) {
+      b.pointLine.Push(row, ops[0].x, ops[0].y, ops[1], value);
+    } else if (Is(ops, {Shape::Line, Shape::Line})) {
+      b.pointLine.Push(row, (ops[1].x + ops[1].x2) * 0.5,
+                       (ops[1].y + ops[1].y2) * 0.5, ops[0], value);
+    } else if (Is(ops, {Shape::Line})) {
+      b.scalar.Push(row, ops[0].Length(), value);
+    } else if (Is(ops, {Shape::Point, Shape::Circle}) ||
+               Is(ops, {Shape::Circle, Shape::Circle})) {
+      b.pointPoint.Push(row, ops[0].x, ops[0].y, ops[1].x, ops[1].y, value);
+    } else {
+      return Lowering::Unchecked;
+    }
+    return Lowering::Ok;
+
+  case ConstraintType::ANGLE:
+    if (!constraint.value) {
+      return Lowering::Unresolved;
+    }
+    if (Is(ops, {Shape::Line, Shape::Line})) {
+      unit(ops[0], ux, uy);
+      unit(ops[1], vx, vy);
+      b.direction.Push(row, ux, uy, vx, vy, value);
+    } else if (Is(ops, {Shape::Line})) {
+      unit(ops[0], ux, uy);
+      b.direction.Push(row, ux, uy, 1.0, 0.0, value);
+    } else {
+      return Lowering::Unchecked;
+    }
+    return Lowering::Ok;
+
+  case ConstraintType::RADIUS:
+  case ConstraintType::DIAMETER:
+    if (!constraint.value) {
+      return Lowering::Unresolved;
+    }
+    if (!Is(ops, {Shape::Circle})) {
+      return Lowering::Unchecked;
+    }
+    b.scalar.Push(row,
+                  constraint.type == ConstraintType::RADIUS ? ops[0].radius
+                                                            : 2.0 * ops[0].radius,
+                  value);
+    return Lowering::Ok;
+
+  case ConstraintType::SYMMETRIC: {
+    if (!Is(ops, {Shape::Point, Shape::Point, Shape::Line})) {
+      return Lowering::Unchecked;
+    }
+    // Midpoint on the axis, and the connecting segment perpendicular to it.
+    unit(ops[2], ux, uy);
+    b.pointLine.Push(row, (ops[0].x + ops[1].x) * 0.5,
+                     (ops[0].y + ops[1].y) * 0.5, ops[2], 0.0);
+    b.scalar.Push(row, (ops[1].x - ops[0].x) * ux + (ops[1].y - ops[0].y) * uy,
+                  0.0);
+    return Lowering::Ok;
+  }
+
+  case ConstraintType::MIDPOINT:
+    if (!Is(ops, {Shape::Point, Shape::Line})) {
+      return Lowering::Unchecked;
+    }
+    b.pointPoint.Push(row, ops[0].x, ops[0].y, (ops[1].x + ops[1].x2) * 0.5,
+                      (ops[1].y + ops[1].y2) * 0.5, 0.0);
+    return Lowering::Ok;
+
+  case ConstraintType::COLLINEAR:
+    if (!Is(ops, {Shape::Line, Shape::Line})) {
+      return Lowering::Unchecked;
+    }
+    b.pointLine.Push(row, ops[1].x, ops[1].y, ops[0], 0.0);
+    b.pointLine.Push(row, ops[1].x2, ops[1].y2, ops[0], 0.0);
+    return Lowering::Ok;
+
+  default:
+    return Lowering::Unchecked;
+  }
+}
+
+struct RowResult {
+  double ratio = -1.0; ///< Worst residual / tolerance; < 0 means no rows.
+  double residual = 0.0;
+  bool angular = false;
+};
+
+template <typename BatchT>
+void Reduce(const BatchT &batch, std::vector<double> &scratch, double tolerance,
+            bool angular, std::vector<RowResult> &rows) {
+  batch.Evaluate(scratch);
+  for (std::size_t i = 0; i < scratch.size(); ++i) {
+    RowResult &row = rows[batch.owner[i]];
+    const double ratio = scratch[i] / tolerance;
+    if (ratio > row.ratio) {
+      row.ratio = ratio;
+      row.residual = scratch[i];
+      row.angular = angular;
+    }
+  }
+}
+
+} // namespace
+
+std::size_t ConstraintCheckReport::ViolationCount() const {
+  return static_cast<std::size_t>(
+      std::count_if(diagnostics.begin(), diagnostics.end(), [](const auto &d) {
+        return d.status == ConstraintCheckStatus::Violated;
+      }));
+}
+
+void ConstraintCheckReport::AppendTo(ValidationReport &report) const {
+  for (const auto &d : diagnostics) {
+    if (d.status == ConstraintCheckStatus::Violated) {
+      report.warnings.push_back("[SKETCH_008] " + d.message);
+    } else if (d.status == ConstraintCheckStatus::Unresolved) {
+      report.warnings.push_back("[SKETCH_009] " + d.message);
+    }
+  }
+}
+
+ConstraintCheckReport
+ConstraintChecker::Check(const CSketch &sketch,
+                         const ConstraintCheckOptions &options) {
+  ConstraintCheckOptions effective = options;
+  if (effective.lengthTolerance <= 0.0) {
+    effective.lengthTolerance = GeoUtils::EPSILON;
+  }
+  ConstraintCheckReport report;
+  CheckInto(sketch, effective, report);
+  return report;
+}
+
+bool ConstraintChecker::Check(const UnifiedModel &model,
+                              ConstraintCheckReport &report,
+                              const ConstraintCheckOptions &options,
+                              std::string *errorMessage) {
+  ConstraintCheckOptions effective = options;
+  if (effective.lengthTolerance <= 0.0 &&
+      !TryGetGeometryCompareTolerance(model.unit, effective.lengthTolerance)) {
+    if (errorMessage) {
+      *errorMessage = "ConstraintChecker: unsupported model unit";
+    }
+    return false;
+  }
+  report = ConstraintCheckReport{};
+  for (const auto &feature : model.GetFeatures()) {
+    if (feature && feature->featureType == FeatureType::Sketch) {
+      CheckInto(static_cast<const CSketch &>(*feature), effective, report);
+    }
+  }
+  return true;
+}
+
+void ConstraintChecker::CheckInto(const CSketch &sketch,
+                                  const ConstraintCheckOptions &options,
+                                  ConstraintCheckReport &report) {
+  const auto &constraints = sketch.constraints;
+  std::unordered_map<std::string, const CSketchSeg *> byLocalID;
+  byLocalID.reserve(sketch.segments.size());
+  for (const auto &seg : sketch.segments) {
+    if (seg && !seg->localID.empty()) {
+      byLocalID.emplace(seg->localID, seg.get());
+    }
+  }
+
+  auto diagnose = [&](std::size_t index, ConstraintCheckStatus status,
+                      const std::string &what) {
+    ConstraintDiagnostic d;
+    d.sketchID = sketch.featureID;
+    d.constraintIndex = index;
+    d.type = constraints[index].type;
+    d.status = status;
+    d.message = "Sketch '" + sketch.featureID + "' constraint[" +
+                std::to_string(index) + "] " + TypeName(d.type) + " " + what;
+    return d;
+  };
+
+  // 1. Resolve refs and lower every constraint into kernel rows.
+  Batches batches;
+  std::vector<Operand> ops;
+  for (std::size_t i = 0; i < constraints.size(); ++i) {
+    const auto &constraint = constraints[i];
+    ops.clear();
+    ResolveResult resolve = ResolveResult::Ok;
+    for (const auto &ref : constraint.refs) {
+      if (ref.kind == SketchConstraintRefKind::ExternalReference) {
+        resolve = ResolveResult::External;
+        break;
+      }
+      auto it = byLocalID.find(ref.sketchEntityLocalID);
+      Operand op;
+      if (it == byLocalID.end() ||
+          !ResolveSegment(*it->second, ref.subEntity, op)) {
+        resolve = ResolveResult::Missing;
+        break;
+      }
+      ops.push_back(op);
+    }
+
+    Lowering lowering = Lowering::Unchecked;
+    if (resolve == ResolveResult::Ok && !ops.empty()) {
+      lowering = Lower(constraint, ops, static_cast<std::uint32_t>(i),
+                       options.lengthTolerance, batches);
+    } else if (resolve == ResolveResult::Missing) {
+      lowering = Lowering::Unresolved;
+    }
+
+    if (lowering == Lowering::Unresolved) {
+      report.diagnostics.push_back(diagnose(
+          i, ConstraintCheckStatus::Unresolved,
+          "refs cannot be resolved to usable sketch geometry."));
+    } else if (lowering == Lowering::Unchecked) {
+      ++report.uncheckedCount;
+      if (options.reportUnchecked) {
+        report.diagnostics.push_back(diagnose(
+            i, ConstraintCheckStatus::Unchecked, "was not evaluated."));
+      }
+    }
+  }
+
+  // 2. Evaluate each batch in one pass and reduce to per-constraint worst rows.
+  std::vector<RowResult> rows(constraints.size());
+  std::vector<double> scratch;
+  Reduce(batches.pointPoint, scratch, options.lengthTolerance, false, rows);
+  Reduce(batches.pointLine, scratch, options.lengthTolerance, false, rows);
+  Reduce(batches.direction, scratch, options.angleTolerance, true, rows);
+  Reduce(batches.scalar, scratch, options.lengthTolerance, false, rows);
+
+  // 3. Report violations.
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    const RowResult &row = rows[i];
+    if (row.ratio < 0.0) {
+      continue;
+    }
+    ++report.checkedCount;
+    if (row.ratio <= 1.0) {
+      ++report.satisfiedCount;
+      continue;
+    }
+    const double tolerance =
+        row.angular ? options.angleTolerance : options.lengthTolerance;
+    ConstraintDiagnostic d = diagnose(
+        i, ConstraintCheckStatus::Violated,
+        "residual " + std::to_string(row.residual) +
+            (row.angular ? " rad" : "") + " exceeds tolerance " +
+            std::to_string(tolerance) + ".");
+    d.residual = row.residual;
+    d.tolerance = tolerance;
+    d.angular = row.angular;
+    report.diagnostics.push_back(std::move(d));
+  }
+}
+
+} // namespace CADExchange
@@ -0,0 +1,101 @@
+#pragma once
+// clang-format off
+#include "../../core/UnifiedModel.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+// clang-format on
+
+namespace CADExchange {
+
+enum class ConstraintCheckStatus {
+  Violated,   ///< Residual exceeds tolerance (rule SKETCH_008).
+  Unresolved, ///< Refs missing, of the wrong shape or degenerate (SKETCH_009).
+  Unchecked   ///< Not evaluated: external refs, FIXED/USEEDGE/UNKNOWN, or an
+              ///< unsupported combination of ref shapes.
+};
+
+/**
+ * @brief One constraint that failed (or could not be) checked.
+ *
+ * For Violated entries, residual/tolerance belong to the worst term of the
+ * constraint. Angular terms are in radians; all others are sketch lengths.
+ */
+struct ConstraintDiagnostic {
+  std::string sketchID;
+  std::size_t constraintIndex = 0;
+  CSketchConstraint::ConstraintType type =
+      CSketchConstraint::ConstraintType::UNKNOWN;
+  ConstraintCheckStatus status = ConstraintCheckStatus::Violated;
+  double residual = 0.0;
+  double tolerance = 0.0;
+  bool angular = false;
+  std::string message;
+};
+
+struct ConstraintCheckReport {
+  std::size_t checkedCount = 0;   ///< Constraints whose residual was evaluated.
+  std::size_t satisfiedCount = 0; ///< Evaluated and within tolerance.
+  std::size_t uncheckedCount = 0;
+  /// Violated and Unresolved entries, plus Unchecked ones when requested.
+  std::vector<ConstraintDiagnostic> diagnostics;
+
+  std::size_t ViolationCount() const;
+
+  /**
+   * @brief Appends Violated/Unresolved entries to a validation report as
+   *        "[SKETCH_008]" / "[SKETCH_009]" warnings.
+   */
+  void AppendTo(ValidationReport &report) const;
+};
+
+struct ConstraintCheckOptions {
+  double lengthTolerance = 0.0; ///< <= 0: TryGetGeometryCompareTolerance(unit)
+  double angleTolerance = 1e-6; ///< Radians.
+  bool reportUnchecked = false;
+};
+
+/**
+ * @brief Checks that stored sketch geometry satisfies its constraints.
+ *
+ * Constraint refs are resolved through a localID index to points, lines or
+ * circles (subEntity selects start/end/center/midpoint). Every checkable
+ * constraint is then lowered into rows of four typed kernels stored as
+ * structure-of-arrays batches:
+ *   - point–point distance versus a target;
+ *   - point–line distance versus a target;
+ *   - angle between two directions versus a target;
+ *   - scalar difference (lengths, radii).
+ * Each batch is evaluated in one tight loop, and a constraint's residual is
+ * the worst of its rows relative to the row tolerance.
+ *
+ * Only sketch-local geometry is checked; constraints involving external
+ * references are reported as Unchecked. ANGLE values are radians, and
+ * undirected lines treat a and pi - a as equivalent.
+ */
+class ConstraintChecker {
+public:
+  /**
+   * @brief Checks a single sketch. A sketch carries no unit, so a
+   *        non-positive lengthTolerance falls back to GeoUtils::EPSILON.
+   */
+  static ConstraintCheckReport Check(const CSketch &sketch,
+                                     const ConstraintCheckOptions &options);
+
+  /**
+   * @brief Checks every sketch in the model.
+   *
+   * @return false when the model unit has no compare tolerance and no
+   *         explicit lengthTolerance was given.
+   */
+  static bool Check(const UnifiedModel &model, ConstraintCheckReport &report,
+                    const ConstraintCheckOptions &options = {},
+                    std::string *errorMessage = nullptr);
+
+private:
+  static void CheckInto(const CSketch &sketch,
+                        const ConstraintCheckOptions &options,
+                        ConstraintCheckReport &report);
+};
+
+} // namespace CADExchange
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <string>
 #include <unordered_set>
+#include <vector>
 // clang-format on
 
 namespace CADExchange {
@@ -25,34 +26,93 @@ ValidationReport UnifiedModel::Validate() const {
 }
 
 ValidationReport ModelValidator::Validate(const UnifiedModel &model) {
+  ValidationSession session(model.unit);
+  for (const auto &feature : model.GetFeatures()) {
+    session.Check(feature);
+  }
+  return session.Finish();
+}
+
+struct ValidationSession::State {
+  /// 是否被引用要看完全部特征才知道的草图规则（SKETCH_001/GEOM_003）。
+  struct PendingSketch {
+    std::string featureID;
+    bool noSegments = false;
+    bool invalidCSys = false;
+    size_t errorMark = 0;   ///< 原本应插入的 errors 下标
+    size_t warningMark = 0; ///< 原本应插入的 warnings 下标
+  };
+
+  UnitType unit = UnitType::METER;
   ValidationReport report;
+  std::unordered_set<std::string> referencedSketchIDs;
+  std::unordered_set<std::string> seen;
+  std::unordered_set<std::string> seenIDs;
+  std::vector<PendingSketch> pendingSketches;
+};
+
+ValidationSession::ValidationSession(UnitType unit)
+    : m_state(std::make_unique<State>()) {
+  m_state->unit = unit;
+}
+
+ValidationSession::~ValidationSession() = default;
+
+ValidationReport ValidationSession::Finish() {
+  ValidationReport report = std::move(m_state->report);
+  // 倒序插入：先插后面的位置，前面记录的下标不受影响。
+  const auto &pending = m_state->pendingSketches;
+  for (auto it = pending.rbegin(); it != pending.rend(); ++it) {
+    if (!m_state->referencedSketchIDs.count(it->featureID)) {
+      continue;
+    }
+    if (it->noSegments) {
+      report.warnings.insert(
+          report.warnings.begin() + static_cast<std::ptrdiff_t>(it->warningMark),
+          "[SKETCH_001] Sketch '" + it->featureID +
+              "' is referenced by a profiled feature but has no segments.");
+    }
+    if (it->invalidCSys) {
+      report.isValid = false;
+      report.errors.insert(
+          report.errors.begin() + static_cast<std::ptrdiff_t>(it->errorMark),
+          "[GEOM_003] Sketch '" + it->featureID + "' sketchCSys is not orthogonal.");
+    }
+  }
+  const UnitType unit = m_state->unit;
+  m_state = std::make_unique<State>();
+  m_state->unit = unit;
+  return report;
+}
+
+void ValidationSession::Check(const std::shared_ptr<CFeatureBase> &feature) {
+  ValidationReport &report = m_state->report;
+  std::unordered_set<std::string> &referencedSketchIDs = m_state->referencedSketchIDs;
+  const UnitType unit = m_state->unit;
 
   // Collect sketchIDs referenced by Extrude/Revolve for SKETCH_001
-  std::unordered_set<std::string> referencedSketchIDs;
-  for (const auto &f : model.GetFeatures()) {
-    if (auto ex = std::dynamic_pointer_cast<CExtrude>(f))
-      if (!ex->profileSketchID.empty())
-        referencedSketchIDs.insert(ex->profileSketchID);
-    if (auto rv = std::dynamic_pointer_cast<CRevolve>(f))
-      if (!rv->profileSketchID.empty())
-        referencedSketchIDs.insert(rv->profileSketchID);
-    if (auto sw = std::dynamic_pointer_cast<CSweep>(f)) {
-      const std::string sketchID = !sw->profile.sketchID.empty()
-                                       ? sw->profile.sketchID
-                                       : sw->profileSketchID;
-      if (sw->profile.kind == SweepProfileKind::SketchReference &&
-          !sketchID.empty()) {
-        referencedSketchIDs.insert(sketchID);
-      }
+  if (auto ex = std::dynamic_pointer_cast<CExtrude>(feature))
+    if (!ex->profileSketchID.empty())
+      referencedSketchIDs.insert(ex->profileSketchID);
+  if (auto rv = std::dynamic_pointer_cast<CRevolve>(feature))
+    if (!rv->profileSketchID.empty())
+      referencedSketchIDs.insert(rv->profileSketchID);
+  if (auto sw = std::dynamic_pointer_cast<CSweep>(feature)) {
+    const std::string sketchID = !sw->profile.sketchID.empty()
+                                     ? sw->profile.sketchID
+                                     : sw->profileSketchID;
+    if (sw->profile.kind == SweepProfileKind::SketchReference &&
+        !sketchID.empty()) {
+      referencedSketchIDs.insert(sketchID);
     }
-    if (auto rib = std::dynamic_pointer_cast<CRib>(f))
-      if (!rib->sketchID.empty())
-        referencedSketchIDs.insert(rib->sketchID);
   }
+  if (auto rib = std::dynamic_pointer_cast<CRib>(feature))
+    if (!rib->sketchID.empty())
+      referencedSketchIDs.insert(rib->sketchID);
 
   // length magnitude threshold (convert to meters)
   auto toMeter = [&](double v) -> double {
-    switch (model.unit) {
+    switch (unit) {
       case UnitType::MILLIMETER:  return v * 1e-3;
       case UnitType::CENTIMETER:  return v * 1e-2;
       case UnitType::INCH:        return v * 0.0254;
@@ -201,16 +261,16 @@ ValidationReport ModelValidator::Validate(const UnifiedModel &model) {
                std::dynamic_pointer_cast<CRefFace>(ref) != nullptr;
       };
 
-  // Main validation loop
-  std::unordered_set<std::string> seen;
-  std::unordered_set<std::string> seenIDs;
+  // Per-feature rules (model order)
+  std::unordered_set<std::string> &seen = m_state->seen;
+  std::unordered_set<std::string> &seenIDs = m_state->seenIDs;
 
-  for (const auto &feature : model.GetFeatures()) {
+  {
     // MODEL_001
     if (feature->featureID.empty()) {
       addError("[MODEL_001] A feature has an empty featureID.");
       seen.insert("");
-      continue;
+      return;
     }
     // MODEL_002
     if (seenIDs.count(feature->featureID)) {
@@ -256,17 +316,14 @@ ValidationReport ModelValidator::Validate(const UnifiedModel &model) {
 
     // ---- CSketch ----
     else if (auto sketch = std::dynamic_pointer_cast<CSketch>(feature)) {
-      // SKETCH_001
-      if (sketch->segments.empty() &&
-          referencedSketchIDs.count(sketch->featureID)) {
-        addWarn("[SKETCH_001] Sketch '" + sketch->featureID +
-                "' is referenced by a profiled feature but has no segments.");
-      }
-      // GEOM_003
-      if (referencedSketchIDs.count(sketch->featureID) &&
-          !sketch->sketchCSys.IsValid()) {
-        addError("[GEOM_003] Sketch '" + sketch->featureID +
-                 "' sketchCSys is not orthogonal.");
+      // SKETCH_001 / GEOM_003：只对被引用的草图生效，引用可能出现在后续特征中，
+      // 先记下位置，由 Finish() 补入。
+      const bool noSegments = sketch->segments.empty();
+      const bool invalidCSys = !sketch->sketchCSys.IsValid();
+      if (noSegments || invalidCSys) {
+        m_state->pendingSketches.push_back({sketch->featureID, noSegments,
+                                            invalidCSys, report.errors.size(),
+                                            report.warnings.size()});
       }
       // REF_003
       if (sketch->referencePlane) {
@@ -1008,8 +1065,6 @@ ValidationReport ModelValidator::Validate(const UnifiedModel &model) {
 
     seen.insert(feature->featureID);
   }
-
-  return report;
 }
 
 } // namespace CADExchange
@@ -1,6 +1,8 @@
 #pragma once
 #include "../../core/UnifiedModel.h"
 
+#include <memory>
+
 namespace CADExchange {
 
 /**
@@ -15,4 +17,29 @@ public:
   static ValidationReport Validate(const UnifiedModel &model);
 };
 
+/**
+ * @brief Incremental form of ModelValidator::Validate().
+ *
+ * Features are checked one at a time in model order, e.g. by a loader right
+ * after each feature is decoded; Finish() returns exactly the report that
+ * Validate() would produce for the same sequence. Rules that depend on later
+ * features (SKETCH_001/GEOM_003) are recorded and merged in by Finish().
+ * The session is reset by Finish() and may then be reused.
+ */
+class ValidationSession {
+public:
+  explicit ValidationSession(UnitType unit);
+  ~ValidationSession();
+
+  ValidationSession(const ValidationSession &) = delete;
+  ValidationSession &operator=(const ValidationSession &) = delete;
+
+  void Check(const std::shared_ptr<CFeatureBase> &feature);
+  ValidationReport Finish();
+
+private:
+  struct State;
+  std::unique_ptr<State> m_state;
+};
+
 } // namespace CADExchange